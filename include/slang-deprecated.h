@@ -941,6 +941,9 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /* Write reflection in the binary format read by `slang-reflection-binary.h`. */
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
@@ -893,6 +893,11 @@ public:
     /// When using D3D12, this will be a D3D12_CPU_DESCRIPTOR_HANDLE.
     /// When using Vulkan, this will be a VkSampler.
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outNativeHandle) = 0;
+
+    /// Returns the value of a `DescriptorHandle<SamplerState>` that refers to this sampler in
+    /// the device's bindless descriptor heap. Returns SLANG_E_NOT_AVAILABLE if the device was not
+    /// created with a bindless heap. See `IDevice::BindlessDesc`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) = 0;
 };
 #define SLANG_UUID_ISamplerState                           \
     {                                                      \
@@ -945,6 +950,12 @@ public:
     /// VkBufferView, VkAccelerationStructure or a VkBuffer depending on the type of the resource
     /// view.
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outNativeHandle) = 0;
+
+    /// Returns the value of a `DescriptorHandle<T>` that refers to this view in the device's
+    /// bindless descriptor heap, for the resource type `T` matching the view. Returns
+    /// SLANG_E_NOT_AVAILABLE if the device was not created with a bindless heap. See
+    /// `IDevice::BindlessDesc`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) = 0;
 };
 #define SLANG_UUID_IResourceView                           \
     {                                                      \
@@ -2433,6 +2444,27 @@ public:
         GfxCount maxEntryCount = 0;
     };
 
+    struct PipelineCacheDesc
+    {
+        // The directory in which the driver's compiled pipelines are kept between runs. If not
+        // set, pipelines are not persisted. Supported by Vulkan (`VkPipelineCache`) and D3D12
+        // (`ID3D12PipelineLibrary`). Each adapter and driver version has its own file.
+        const char* pipelineCachePath = nullptr;
+    };
+
+    struct BindlessDesc
+    {
+        // The number of resource and sampler descriptors in the bindless descriptor heap. If
+        // zero, the device has no heap. With a heap, resource views and samplers can be passed to
+        // shaders as `DescriptorHandle<T>` values from `getDescriptorHandle`, which are written
+        // into the heap once rather than into a descriptor set on every bind. Supported by
+        // Vulkan, and requires descriptor indexing and `VK_EXT_mutable_descriptor_type`, which
+        // matches Slang's default `DescriptorHandle` lowering. Devices that support it have the
+        // "bindless" feature.
+        uint32_t resourceDescriptorCount = 0;
+        uint32_t samplerDescriptorCount = 0;
+    };
+
     struct InteropHandles
     {
         InteropHandle handles[3] = {};
@@ -2461,6 +2493,10 @@ public:
         ShaderCacheDesc shaderCache = {};
         // Configurations for Slang compiler.
         SlangDesc slang = {};
+        // Configurations for the persistent pipeline cache.
+        PipelineCacheDesc pipelineCache = {};
+        // Configurations for the bindless descriptor heap.
+        BindlessDesc bindless = {};
 
         GfxCount extendedDescCount = 0;
         void** extendedDescs = nullptr;
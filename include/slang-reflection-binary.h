@@ -0,0 +1,409 @@
+#ifndef SLANG_REFLECTION_BINARY_H
+#define SLANG_REFLECTION_BINARY_H
+
+/*
+A reader for the binary reflection format written by `spReflection_ToBinary` and
+`slangc -reflection-binary`.
+
+The format is meant to be loaded (or memory mapped) and read where it is, so an application
+can load reflection for a large number of programs without parsing anything. This reader is
+plain C and doesn't depend on the rest of Slang. Opening data only checks that its tables are
+in bounds, and every accessor checks its index, so nothing is allocated or copied and bad
+data gives `NULL` rather than reading out of bounds.
+
+The data is a RIFF file whose root list has the type `SLrf`. The reflection is the payload
+of its `data` chunk:
+
+* A `SlangReflectionBinaryHeader`
+* Tables of fixed size records, each at an offset given in the header
+* A table of NUL-terminated UTF-8 strings
+
+Records refer to each other by index into the table of the referenced record kind, with
+`SLANG_REFLECTION_BINARY_NONE` for no record. Runs of records, such as the fields of a
+struct, are a first index and a count. Strings are byte offsets into the string table, and
+offset 0 is always the empty string.
+
+All values are 32 bit, in the byte order of the machine that wrote the data. The payload
+must be 4 byte aligned to be read in place; the data written by Slang is, as long as the
+start of the RIFF is.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SLANG_REFLECTION_BINARY_VERSION 1
+
+/* An index that doesn't refer to any record. */
+#define SLANG_REFLECTION_BINARY_NONE 0xffffffffu
+
+/* Sizes and counts that aren't a fixed number of units. */
+#define SLANG_REFLECTION_BINARY_SIZE_UNBOUNDED 0xffffffffu
+#define SLANG_REFLECTION_BINARY_SIZE_UNKNOWN 0xfffffffeu
+
+typedef struct SlangReflectionBinaryHeader
+{
+    uint32_t version; /* SLANG_REFLECTION_BINARY_VERSION */
+
+    /* Offsets are in bytes from the start of the header. */
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t typeLayoutsOffset;
+    uint32_t typeLayoutCount;
+    uint32_t varLayoutsOffset;
+    uint32_t varLayoutCount;
+    uint32_t bindingsOffset;
+    uint32_t bindingCount;
+    uint32_t sizesOffset;
+    uint32_t sizeCount;
+    uint32_t entryPointsOffset;
+    uint32_t entryPointCount;
+
+    /* The global parameters of the program, as var layouts. */
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+
+    /* The space used for the bindless resource heap, or -1 if there isn't one. */
+    int32_t bindlessSpaceIndex;
+} SlangReflectionBinaryHeader;
+
+/* The resources of one category used by a variable. */
+typedef struct SlangReflectionBinaryBinding
+{
+    uint32_t category; /* SlangParameterCategory */
+    uint32_t index;    /* The register or binding, or the byte offset for uniform data */
+    uint32_t space;    /* The register space or descriptor set */
+    uint32_t count;    /* How many registers, bindings or bytes are used */
+} SlangReflectionBinaryBinding;
+
+/* The size of a type in the units of one category. */
+typedef struct SlangReflectionBinarySize
+{
+    uint32_t category; /* SlangParameterCategory */
+    uint32_t size;
+} SlangReflectionBinarySize;
+
+typedef struct SlangReflectionBinaryTypeLayout
+{
+    uint32_t name;           /* String */
+    uint32_t kind;           /* SlangTypeKind */
+    uint32_t scalarType;     /* SlangScalarType, of scalars, vectors and matrices */
+    uint32_t resourceShape;  /* SlangResourceShape, of resources */
+    uint32_t resourceAccess; /* SlangResourceAccess, of resources */
+    uint32_t rowCount;       /* Of matrices */
+    uint32_t columnCount;    /* Of matrices */
+    uint32_t elementCount;   /* Of arrays and vectors */
+    uint32_t uniformStride;  /* Of array elements, in bytes */
+    uint32_t uniformAlignment;
+
+    /* The element of arrays, vectors, matrices, buffers and parameter groups. */
+    uint32_t elementTypeLayout;
+    /* Where the element of a parameter group is, relative to the group. */
+    uint32_t elementVarLayout;
+
+    /* Var layouts of the fields of a struct. */
+    uint32_t firstField;
+    uint32_t fieldCount;
+
+    /* The size of the type in each category it uses. */
+    uint32_t firstSize;
+    uint32_t sizeCount;
+} SlangReflectionBinaryTypeLayout;
+
+typedef struct SlangReflectionBinaryVarLayout
+{
+    uint32_t name; /* String */
+    uint32_t typeLayout;
+    uint32_t firstBinding;
+    uint32_t bindingCount;
+    uint32_t semanticName; /* String */
+    uint32_t semanticIndex;
+} SlangReflectionBinaryVarLayout;
+
+typedef struct SlangReflectionBinaryEntryPoint
+{
+    uint32_t name;  /* String */
+    uint32_t stage; /* SlangStage */
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+    uint32_t threadGroupSize[3];
+    uint32_t resultVarLayout;
+} SlangReflectionBinaryEntryPoint;
+
+/* Reflection data opened for reading. */
+typedef struct SlangReflectionBinary
+{
+    const uint8_t* payload;
+    uint32_t payloadSize;
+} SlangReflectionBinary;
+
+/* Check the table at `offset` holding `count` records of `recordSize` fits in the payload. */
+static inline int _slangReflectionBinaryIsTableInBounds(
+    uint32_t payloadSize,
+    uint32_t offset,
+    uint32_t count,
+    size_t recordSize)
+{
+    return (offset & 3) == 0 && offset <= payloadSize &&
+           (uint64_t)count * recordSize <= (uint64_t)(payloadSize - offset);
+}
+
+/* Open the `size` bytes of binary reflection at `data`. Returns non-zero on success. */
+static inline int slangReflectionBinaryOpen(
+    const void* data,
+    size_t size,
+    SlangReflectionBinary* outReflection)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    const SlangReflectionBinaryHeader* header;
+    size_t offset;
+    uint32_t chunkSize;
+
+    memset(outReflection, 0, sizeof(*outReflection));
+
+    /* The RIFF header is the tag, the size and the list type. */
+    if (size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "SLrf", 4) != 0)
+        return 0;
+    memcpy(&chunkSize, bytes + 4, 4);
+    if ((uint64_t)chunkSize + 8 < size)
+        size = (size_t)chunkSize + 8;
+
+    /* Each child chunk starts at the end of the previous one, rounded up to 8 bytes. */
+    for (offset = 12; offset + 8 <= size; offset += ((size_t)chunkSize + 8 + 7) & ~(size_t)7)
+    {
+        memcpy(&chunkSize, bytes + offset + 4, 4);
+        if (chunkSize > size - offset - 8)
+            return 0;
+        if (memcmp(bytes + offset, "data", 4) != 0)
+            continue;
+
+        outReflection->payload = bytes + offset + 8;
+        outReflection->payloadSize = chunkSize;
+        break;
+    }
+    if (!outReflection->payload)
+        return 0;
+
+    header = (const SlangReflectionBinaryHeader*)outReflection->payload;
+    if (((uintptr_t)header & 3) != 0 || chunkSize < sizeof(*header) ||
+        header->version != SLANG_REFLECTION_BINARY_VERSION || header->stringsSize == 0 ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->stringsOffset,
+            header->stringsSize,
+            1) ||
+        outReflection->payload[header->stringsOffset + header->stringsSize - 1] != 0 ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->typeLayoutsOffset,
+            header->typeLayoutCount,
+            sizeof(SlangReflectionBinaryTypeLayout)) ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->varLayoutsOffset,
+            header->varLayoutCount,
+            sizeof(SlangReflectionBinaryVarLayout)) ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->bindingsOffset,
+            header->bindingCount,
+            sizeof(SlangReflectionBinaryBinding)) ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->sizesOffset,
+            header->sizeCount,
+            sizeof(SlangReflectionBinarySize)) ||
+        !_slangReflectionBinaryIsTableInBounds(
+            chunkSize,
+            header->entryPointsOffset,
+            header->entryPointCount,
+            sizeof(SlangReflectionBinaryEntryPoint)))
+    {
+        memset(outReflection, 0, sizeof(*outReflection));
+        return 0;
+    }
+    return 1;
+}
+
+static inline const SlangReflectionBinaryHeader* slangReflectionBinaryGetHeader(
+    const SlangReflectionBinary* reflection)
+{
+    return (const SlangReflectionBinaryHeader*)reflection->payload;
+}
+
+/* Get the string at `offset` in the string table, or "" if it is out of bounds. */
+static inline const char* slangReflectionBinaryGetString(
+    const SlangReflectionBinary* reflection,
+    uint32_t offset)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    if (offset >= header->stringsSize)
+        return "";
+    return (const char*)reflection->payload + header->stringsOffset + offset;
+}
+
+/* Get record `first + index` of the table at `offset`, if `index < count` and it is in the
+   table. */
+static inline const void* _slangReflectionBinaryGetRecord(
+    const SlangReflectionBinary* reflection,
+    uint32_t offset,
+    uint32_t tableCount,
+    size_t recordSize,
+    uint32_t first,
+    uint32_t index,
+    uint32_t count)
+{
+    if (index >= count || first >= tableCount || index >= tableCount - first)
+        return NULL;
+    return reflection->payload + offset + (size_t)(first + index) * recordSize;
+}
+
+static inline const SlangReflectionBinaryTypeLayout* slangReflectionBinaryGetTypeLayout(
+    const SlangReflectionBinary* reflection,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryTypeLayout*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->typeLayoutsOffset,
+        header->typeLayoutCount,
+        sizeof(SlangReflectionBinaryTypeLayout),
+        index,
+        0,
+        1);
+}
+
+static inline const SlangReflectionBinaryVarLayout* slangReflectionBinaryGetVarLayout(
+    const SlangReflectionBinary* reflection,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryVarLayout*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->varLayoutsOffset,
+        header->varLayoutCount,
+        sizeof(SlangReflectionBinaryVarLayout),
+        index,
+        0,
+        1);
+}
+
+static inline const SlangReflectionBinaryEntryPoint* slangReflectionBinaryGetEntryPoint(
+    const SlangReflectionBinary* reflection,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryEntryPoint*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->entryPointsOffset,
+        header->entryPointCount,
+        sizeof(SlangReflectionBinaryEntryPoint),
+        0,
+        index,
+        header->entryPointCount);
+}
+
+/* Get global parameter `index` of the program. */
+static inline const SlangReflectionBinaryVarLayout* slangReflectionBinaryGetParameter(
+    const SlangReflectionBinary* reflection,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryVarLayout*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->varLayoutsOffset,
+        header->varLayoutCount,
+        sizeof(SlangReflectionBinaryVarLayout),
+        header->firstParameter,
+        index,
+        header->parameterCount);
+}
+
+/* Get parameter `index` of `entryPoint`. */
+static inline const SlangReflectionBinaryVarLayout* slangReflectionBinaryGetEntryPointParameter(
+    const SlangReflectionBinary* reflection,
+    const SlangReflectionBinaryEntryPoint* entryPoint,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryVarLayout*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->varLayoutsOffset,
+        header->varLayoutCount,
+        sizeof(SlangReflectionBinaryVarLayout),
+        entryPoint->firstParameter,
+        index,
+        entryPoint->parameterCount);
+}
+
+/* Get field `index` of the struct `typeLayout`. */
+static inline const SlangReflectionBinaryVarLayout* slangReflectionBinaryGetField(
+    const SlangReflectionBinary* reflection,
+    const SlangReflectionBinaryTypeLayout* typeLayout,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryVarLayout*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->varLayoutsOffset,
+        header->varLayoutCount,
+        sizeof(SlangReflectionBinaryVarLayout),
+        typeLayout->firstField,
+        index,
+        typeLayout->fieldCount);
+}
+
+/* Get binding `index` of `varLayout`. */
+static inline const SlangReflectionBinaryBinding* slangReflectionBinaryGetBinding(
+    const SlangReflectionBinary* reflection,
+    const SlangReflectionBinaryVarLayout* varLayout,
+    uint32_t index)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    return (const SlangReflectionBinaryBinding*)_slangReflectionBinaryGetRecord(
+        reflection,
+        header->bindingsOffset,
+        header->bindingCount,
+        sizeof(SlangReflectionBinaryBinding),
+        varLayout->firstBinding,
+        index,
+        varLayout->bindingCount);
+}
+
+/* Get the size of `typeLayout` in units of `category`, which is 0 if it doesn't use any. */
+static inline uint32_t slangReflectionBinaryGetTypeSize(
+    const SlangReflectionBinary* reflection,
+    const SlangReflectionBinaryTypeLayout* typeLayout,
+    uint32_t category)
+{
+    const SlangReflectionBinaryHeader* header = slangReflectionBinaryGetHeader(reflection);
+    uint32_t i;
+    for (i = 0; i < typeLayout->sizeCount; ++i)
+    {
+        const SlangReflectionBinarySize* size =
+            (const SlangReflectionBinarySize*)_slangReflectionBinaryGetRecord(
+                reflection,
+                header->sizesOffset,
+                header->sizeCount,
+                sizeof(SlangReflectionBinarySize),
+                typeLayout->firstSize,
+                i,
+                typeLayout->sizeCount);
+        if (!size)
+            return 0;
+        if (size->category == category)
+            return size->size;
+    }
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
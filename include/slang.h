@@ -946,6 +946,12 @@ typedef uint32_t SlangSizeT;
         SLANG_DIAGNOSTIC_COLOR_NEVER = 2,  // Never use color
     };
 
+    enum SlangCoverageMode
+    {
+        SLANG_COVERAGE_MODE_COUNT = 0, // Atomically add every execution to the counter slot
+        SLANG_COVERAGE_MODE_HIT = 1,   // Store 1 to the counter slot with a plain write
+    };
+
     // All compiler option names supported by Slang.
     //
     // IMPORTANT: ABI STABILITY POLICY FOR CompilerOptionName
@@ -1169,6 +1175,87 @@ typedef uint32_t SlangSizeT;
             146, // intValue0: register index; intValue1: register space — explicit
                  //   binding for the synthesized __slang_coverage buffer
 
+        ShaderCacheDirectory = 147, // stringValue0: directory of the persistent shader-binary cache
+        CodeGenThreadCount = 148,   // intValue0: max threads used for independent code generation
+                                    // jobs of an end-to-end compile (<= 1 means serial)
+        ReportPassStatistics = 149, // stringValue0: path to write per IR pass statistics to
+                                    // as JSON ("-" for stdout)
+        ShareCheckedModules = 150,  // bool, when set, modules checked from source are shared
+                                    // with the other sessions of the global session that set it
+        CheckReachableFunctionsOnly = 151, // bool, only check the bodies of global functions that
+                                           // are reachable from the compiled entry points
+        LowerReachableFunctionsOnly = 152, // bool, only lower the global functions that are
+                                           // referenced by the compiled entry points to IR
+        CompactIR = 153, // bool, move the linked IR into a fresh memory arena between the
+                         // major phases of optimization
+        LoopUnrollBudget = 154, // intValue0: max instructions unrolling one [ForceUnroll] loop
+                                // may add before the rest is left rolled (0 = no limit)
+        AutodiffCheckpointBudget = 155, // intValue0: bytes of primal values per thread that a
+                                        // backward derivative may checkpoint before the rest
+                                        // are recomputed where possible (0 = no limit)
+        CPUVectorizeThreadGroups = 156, // bool, emit the thread loop of C++ compute kernels so
+                                        // that the C++ compiler can vectorize it across threads
+        SPIRVModuleLinking = 157, // bool, precompile the library functions of each module to
+                                  // SPIR-V once and link them into every entry point
+        ReflectionOnly = 158, // bool, check code and compute layouts for reflection without
+                              // generating IR; requests for target code fail
+        EmitReflectionBinary = 159, // stringValue0: path to write binary reflection to
+        SpecializationConstant = 160, // stringValue0: name of a `static const` global to compile
+                                      // as a specialization constant
+        TraceEvents = 161,            // stringValue0: path to write a Chrome trace of the compile
+                                      // timeline to ("-" for stdout)
+        DispatchFrequencyHints = 162, // stringValue0: path to a file of expected call
+                                      // frequencies of interface implementations, used to order
+                                      // the cases of dynamic dispatch functions
+        PackedAnyValueLayout = 163,   // bool, bit-pack bools into shared words when marshalling
+                                      // values to and from `AnyValue`s
+        MinimizeRayPayloads = 164,    // bool, drop ray payload fields that no hit or miss shader
+                                      // in the program accesses
+        ReportRayPayloadRegisters = 165, // bool, report the live fields and payload registers
+                                         // of the payload of each hit and miss shader
+        OptimizeModuleIR = 166, // bool, simplify the IR of each module to a fixed point when
+                                // it is generated, so precompiled modules store it simplified
+        TraceCoverageMode = 167, // intValue0: SlangCoverageMode, how coverage counters record
+                                 // executions
+        ValidateIRChangedOnly = 168, // bool, IR validation skips the code of functions that
+                                     // haven't changed since they last passed it
+        ValidateIRInterval = 169,    // intValue0: validate the IR at only every Nth validation
+                                     // point of code generation (<= 1 means every point)
+        HeuristicInlining = 170,     // bool, inline calls to small functions on targets whose
+                                     // drivers don't inline reliably
+        RecycleRemovedIR = 171,      // bool, reuse the memory of removed IR instructions after
+                                     // each pass of code generation
+        SplitGroupSharedStructArrays = 172, // bool, split groupshared arrays of structs into
+                                            // one array per field
+        NarrowHalfArithmetic = 173, // bool, perform float arithmetic whose result is only used
+                                    // as a half at half precision
+        RemoveUndefinedMeshOutputs = 174, // bool, remove writes of undefined values to mesh
+                                          // shader outputs, and outputs left unwritten
+        RemoveUnreadVaryingOutputs = 175, // bool, remove vertex and mesh shader outputs that no
+                                          // fragment shader in the program reads
+        BranchProfile = 176, // stringValue0: path to a file of execution counts of source
+                             // lines, used to mark strongly biased branches as [branch]
+        ReportFunctionSpecialization = 177, // bool, report the call sites of each function that
+                                            // were specialized and the variants they needed
+        WaterfallNonUniformResourceIndex = 178, // bool, access resources selected with
+                                                // NonUniformResourceIndex in waterfall loops
+        ReportNodeRecords = 179, // bool, report the size of each work graph node input record
+                                 // and the fields the node reads
+        CompileTimeBudget = 180, // intValue0: milliseconds to spend optimizing the IR before
+                                 // falling back to cheaper optimizations
+        UniformityHints = 181, // bool, drop NonUniformResourceIndex on provably
+                               // uniform indices and mark uniform branches
+        InterproceduralConstantPropagation = 182, // bool, clone functions for their
+                                                  // constant arguments and fold them
+        ScheduleForRegisterPressure = 183, // bool, reorder insts within blocks to shorten
+                                           // live ranges
+        ScalarReplacementOfAggregates = 184, // bool, split struct and array locals into one
+                                             // variable per field or element
+        GlobalValueNumbering = 185, // bool, hoist and forward redundant values and loads
+                                    // across blocks for SPIR-V
+        CoalesceByteAddressAccesses = 186, // bool, merge adjacent scalar byte-address buffer
+                                           // accesses into vector accesses for HLSL
+
         CountOf,
     };
 
@@ -1880,6 +1967,147 @@ public:                                                              \
     };
 #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
+    /** Statistics for an IR pass during code generation, added up over all of its invocations */
+    struct SlangPassStatistics
+    {
+        /** The name of the pass */
+        const char* passName;
+        /** The number of times the pass ran */
+        uint64_t invocationCount;
+        /** The wall clock time spent in the pass, in microseconds */
+        uint64_t durationMicroseconds;
+        /** The number of IR instructions the pass created */
+        uint64_t instsCreated;
+        /** The number of IR instructions the pass destroyed */
+        uint64_t instsDestroyed;
+        /** How much the memory arena of the IR module grew during the pass, in bytes */
+        uint64_t arenaBytesGrown;
+    };
+
+    /** Per-pass statistics for the IR passes run during code generation.
+
+    Statistics are collected when `ReportDetailedPerfBenchmark` or `ReportPassStatistics` is
+    enabled, and can be queried from the `ISlangProfiler` returned by
+    `ICompileRequest::getCompileTimeProfile`.
+    */
+    struct ISlangPassProfiler : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(
+            0x2d14b794,
+            0xa4b8,
+            0x43ff,
+            {0x92, 0x8e, 0x88, 0x7c, 0xad, 0xa5, 0x19, 0x8d})
+        /** Get the number of distinct passes that ran. Passes are in the order they first ran. */
+        virtual SLANG_NO_THROW size_t SLANG_MCALL getPassCount() = 0;
+        /** Get the statistics for a pass
+        @param index The index of the pass
+        @param outStatistics Receives the statistics. The pass name remains valid as long as the
+        profiler does.
+        @returns SLANG_OK on success, or SLANG_E_INVALID_ARG if index is out of range */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+        getPassStatistics(uint32_t index, SlangPassStatistics* outStatistics) = 0;
+    };
+#define SLANG_UUID_ISlangPassProfiler ISlangPassProfiler::getTypeGuid()
+
+    /** Timing for a single invocation of a compiler phase on one module */
+    struct SlangPhaseStatistics
+    {
+        /** The name of the phase: "preprocess", "parse", "check", "lower", "link", "optimize",
+        "emit" or "downstream" */
+        const char* phaseName;
+        /** The name of the module the phase ran on, or of the entry point for the phases of
+        code generation */
+        const char* moduleName;
+        /** How many phases enclosed this one. An enclosing phase precedes the phases nested in
+        it. */
+        uint32_t depth;
+        /** The wall clock time spent in the phase, in microseconds */
+        uint64_t durationMicroseconds;
+        /** The time spent in the phase but not in any phase nested in it, in microseconds */
+        uint64_t selfDurationMicroseconds;
+    };
+
+    /** Per-invocation timings for each phase of compilation, tagged by module.
+
+    Timings are collected when `ReportPerfBenchmark` is enabled, and can be queried from the
+    `ISlangProfiler` returned by `ICompileRequest::getCompileTimeProfile`.
+    */
+    struct ISlangPhaseProfiler : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(
+            0x7f38279d,
+            0x0e0c,
+            0x4f1f,
+            {0xb6, 0x07, 0xf0, 0x98, 0xdb, 0x52, 0xf1, 0x4c})
+        /** Get the number of phase invocations, in the order the phases were entered */
+        virtual SLANG_NO_THROW size_t SLANG_MCALL getPhaseInvocationCount() = 0;
+        /** Get the timing for a phase invocation
+        @param index The index of the invocation
+        @param outStatistics Receives the timing. The names remain valid as long as the profiler
+        does.
+        @returns SLANG_OK on success, or SLANG_E_INVALID_ARG if index is out of range */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+        getPhaseInvocation(uint32_t index, SlangPhaseStatistics* outStatistics) = 0;
+    };
+#define SLANG_UUID_ISlangPhaseProfiler ISlangPhaseProfiler::getTypeGuid()
+
+    /** Memory held by the compiler, in bytes, split by what holds it.
+    See `IGlobalSession::getMemoryUsage` and `ISession::getMemoryUsage`. */
+    struct SlangMemoryUsage
+    {
+        /** Syntax trees of modules, held by AST builders */
+        uint64_t astBytes;
+        /** IR of modules and of generated code, held by IR modules */
+        uint64_t irBytes;
+        /** Strings held by string pools */
+        uint64_t stringPoolBytes;
+        /** Blobs cached for reuse, such as checked modules shared between sessions and
+        optimized SPIR-V */
+        uint64_t cachedBlobBytes;
+        /** Memory held by other arenas of the compiler */
+        uint64_t otherBytes;
+    };
+
+    /** A function run by `ISlangJobScheduler` for each job of a batch.
+    @param userData The user data passed to `ISlangJobScheduler::runJobs`
+    @param jobIndex The index of the job in the batch */
+    typedef void (*SlangJobFunc)(void* userData, SlangInt jobIndex);
+
+    /** Runs batches of independent jobs on a pool of threads.
+
+    Every global session owns a scheduler that the compiler uses for all of its parallel work,
+    such as generating code for several targets or entry points at the same time. Applications
+    with a thread pool of their own can replace it with `IGlobalSession::setJobScheduler`, so
+    that the compiler does not compete with the application for cores.
+
+    An implementation must be safe to call from multiple threads, including from inside a job
+    that it is running.
+    */
+    struct ISlangJobScheduler : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(
+            0x2d8533c1,
+            0xbf4e,
+            0x4e06,
+            {0xae, 0x9b, 0x07, 0x57, 0xbc, 0x89, 0xf9, 0x68})
+        /** Get the number of jobs the scheduler can run at the same time */
+        virtual SLANG_NO_THROW SlangInt SLANG_MCALL getThreadCount() = 0;
+        /** Run a batch of jobs and wait for all of them to finish
+        @param jobCount The number of jobs. `func` is called once for each index in
+        `[0, jobCount)`, in any order.
+        @param maxConcurrency The maximum number of jobs of the batch to run at the same time,
+        or 0 for no limit.
+        @param func The function to run for each job. It must not throw.
+        @param userData User data passed to `func` */
+        virtual SLANG_NO_THROW void SLANG_MCALL
+        runJobs(SlangInt jobCount, SlangInt maxConcurrency, SlangJobFunc func, void* userData) = 0;
+        /** Run a single job on another thread, without waiting for it
+        @param func The function to run, with a job index of 0. It must not throw.
+        @param userData User data passed to `func` */
+        virtual SLANG_NO_THROW void SLANG_MCALL submitJob(SlangJobFunc func, void* userData) = 0;
+    };
+#define SLANG_UUID_ISlangJobScheduler ISlangJobScheduler::getTypeGuid()
+
     namespace slang
     {
     struct IGlobalSession;
@@ -3711,6 +3939,14 @@ struct ShaderReflection
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
 
+    /** Write this reflection in the compact binary format that can be read in place with
+     *  the C reader in `slang-reflection-binary.h`.
+     */
+    SlangResult toBinary(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBinary((SlangReflection*)this, outBlob);
+    }
+
     /** Get the descriptor set/space index allocated for the bindless resource heap.
      *  Returns -1 if the program does not use bindless resource heap.
      */
@@ -4137,6 +4373,30 @@ struct IGlobalSession : public ISlangUnknown
         BuiltinModuleName module,
         SlangArchiveType archiveType,
         ISlangBlob** outBlob) = 0;
+
+    /** Set the scheduler that runs the parallel work of this global session and the sessions
+    created from it.
+    @param scheduler The scheduler to use, or null to go back to the built-in one. The built-in
+    scheduler has `SlangGlobalSessionDesc::jobThreadCount` threads.
+
+    Must not be called while any session of this global session is compiling.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL setJobScheduler(ISlangJobScheduler* scheduler) = 0;
+
+    /** Get the scheduler that runs the parallel work of this global session.
+    @param outScheduler Receives the scheduler set with `setJobScheduler`, or the built-in one
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getJobScheduler(ISlangJobScheduler** outScheduler) = 0;
+
+    /** Get how much memory the compiler is holding right now.
+    @param outUsage Receives the bytes held by the memory arenas of every session in the process,
+    by what they hold, plus the bytes of the blobs cached by this global session.
+
+    Compare with `ISession::getMemoryUsage` of each session to find which sessions are keeping
+    memory alive. Safe to call from any thread.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(SlangMemoryUsage* outUsage) = 0;
 };
 
     #define SLANG_UUID_IGlobalSession IGlobalSession::getTypeGuid()
@@ -4278,6 +4538,14 @@ Code loaded and compiled within a session is owned by the session
 and will remain resident in memory until the session is released.
 Applications wishing to control the memory usage for compiled
 and loaded code should use multiple sessions.
+
+A session and the component types created from it may be used from
+several threads at once. Front-end operations (loading modules,
+creating composites, specialization, linking and layout) are
+serialized internally by the session, while back-end code generation
+for linked component types runs concurrently. The global session the
+session was created from must not be used concurrently by other
+threads while this happens.
 */
 struct ISession : public ISlangUnknown
 {
@@ -4493,6 +4761,34 @@ struct ISession : public ISlangUnknown
      */
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     getDeclSourceLocation(slang::DeclReflection* decl, slang::SourceLocation* outLocation) = 0;
+
+    /** Get how much memory this session is holding right now.
+    @param outUsage Receives the bytes held by the AST builder of the session, the IR of the
+    modules it has loaded and its string pool. Blobs are cached by the global session, so
+    `cachedBlobBytes` and `otherBytes` are zero.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(SlangMemoryUsage* outUsage) = 0;
+
+    /** Tell the session that source files have changed on disk, for example so a shader can be
+    hot-reloaded after an edit.
+    @param filePaths The paths of the changed files.
+    @param filePathCount The number of paths in `filePaths`.
+    @param outUnloadedModuleCount Receives the number of loaded modules that were unloaded, if
+    not null.
+
+    Every loaded module that depends on one of the files, directly or through an `import` or
+    `#include`, is unloaded, and the cached contents of the files are dropped. A later
+    `loadModule` of an unloaded module, or of a module that imports one, reads and checks it
+    again, while the modules that don't depend on the files are reused as they are.
+
+    Modules, composite component types and their compiled code that were obtained earlier stay
+    valid and keep the old contents. To pick up the edit, load the affected modules again and
+    compose, link and get code for the programs that use them.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL invalidateChangedFiles(
+        const char* const* filePaths,
+        SlangInt filePathCount,
+        SlangInt* outUnloadedModuleCount) = 0;
 };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -4571,6 +4867,11 @@ struct CoverageBufferInfo
     /// `register`, Vulkan `binding`), or -1 if not assigned for
     /// this target.
     int32_t binding = -1;
+
+    /// How the counter slots record executions. Under
+    /// `SLANG_COVERAGE_MODE_HIT` a slot holds 1 once its statement
+    /// has run and 0 otherwise, rather than an execution count.
+    SlangCoverageMode mode = SLANG_COVERAGE_MODE_COUNT;
 };
 
 struct ICoverageTracingMetadata : public ISlangCastable
@@ -4843,7 +5144,8 @@ struct IComponentType : public ISlangUnknown
      * `getEntryPointMetadata()`.
      *
      * Front-end operations such as loading modules, specialization, and linking
-     * still require external synchronization unless documented otherwise.
+     * may be called concurrently on the same session; they are serialized by the
+     * session and do not run in parallel with one another.
      */
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCode(
         SlangInt entryPointIndex,
@@ -4989,6 +5291,44 @@ struct ITypeConformance : public IComponentType
 };
     #define SLANG_UUID_ITypeConformance ITypeConformance::getTypeGuid()
 
+/** The pending result of `IComponentType2::getEntryPointCodeAsync` or `getTargetCodeAsync`.
+ */
+struct ICodeGenFuture : public ISlangUnknown
+{
+    SLANG_COM_INTERFACE(
+        0x7b41c9e0,
+        0x3d52,
+        0x4f86,
+        {0x9a, 0x1e, 0x64, 0xc2, 0x0b, 0x8f, 0x5d, 0x37})
+
+    /** Returns true once code generation has finished, failed or been cancelled. Never blocks.
+     */
+    virtual SLANG_NO_THROW SlangBool SLANG_MCALL isReady() = 0;
+
+    /** Wait for code generation to finish and get its result.
+    @param outCode        Receives the generated code, or null if code generation failed.
+    @param outDiagnostics Receives the diagnostics of code generation, if there are any.
+    @returns              The result of code generation, or `SLANG_E_ABORT` if it was
+                          cancelled.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getResult(IBlob** outCode, IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Ask for code generation to stop, and return without waiting for it to do so.
+
+    Code generation that hasn't started yet doesn't start. Code generation that is running
+    stops before its next IR pass or downstream compile, but a downstream compile that is
+    already running is allowed to finish. Cancelling a future that is ready has no effect.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL cancel() = 0;
+};
+    #define SLANG_UUID_ICodeGenFuture ICodeGenFuture::getTypeGuid()
+
+/** A function called by a worker thread when an `ICodeGenFuture` becomes ready.
+@param future   The future, which remains valid for the duration of the call.
+@param userData The user data passed along with the callback. */
+typedef void (*CodeGenFutureCallback)(ICodeGenFuture* future, void* userData);
+
 /** IComponentType2 is a component type used for getting separate debug data.
 
 This interface is used for getting separate debug data, introduced here to
@@ -5030,6 +5370,89 @@ struct IComponentType2 : public ISlangUnknown
         int targetIndex,
         ISlangSharedLibrary** outSharedLibrary,
         slang::IBlob** outDiagnostics = 0) = 0;
+
+    /** Generate code for an entry point under many sets of specialization arguments at once.
+
+    Each permutation is this component type specialized with `specializationArgCount`
+    consecutive arguments from `specializationArgs`, so that the array holds
+    `specializationArgCount * permutationCount` arguments in total. All permutations
+    share the modules already loaded and checked for this component type; only
+    specialization and linking are repeated for each of them, after which code
+    generation for the permutations runs in parallel on the job scheduler of the global
+    session (see `ISlangJobScheduler`). At most `CompilerOptionName::CodeGenThreadCount`
+    permutations are compiled at the same time if the session sets that option, and as
+    many as the scheduler allows otherwise.
+
+    @param entryPointIndex        The index of the entry point, in the specialized and
+                                  linked permutations, to get code for.
+    @param targetIndex            The index of the target to get code for.
+    @param specializationArgs     The specialization arguments of all permutations.
+    @param specializationArgCount The number of specialization arguments per permutation.
+    @param permutationCount       The number of permutations.
+    @param outCodes               An array of `permutationCount` blobs that receives the
+                                  code of each permutation, or null for a permutation that
+                                  failed to compile.
+    @param outDiagnostics         The diagnostics of all permutations, in permutation order.
+    @returns                      `SLANG_OK` if every permutation compiled, and a failure
+                                  result otherwise.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        SpecializationArg const* specializationArgs,
+        SlangInt specializationArgCount,
+        SlangInt permutationCount,
+        IBlob** outCodes,
+        IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Start generating code for an entry point on another thread.
+
+    This is the asynchronous form of `IComponentType::getEntryPointCode`. It returns at once,
+    and the code is generated by a job on the job scheduler of the global session (see
+    `ISlangJobScheduler`). The component type and its global session must be kept alive
+    until the returned future is ready.
+
+    @param entryPointIndex The index of the entry point to get code for.
+    @param targetIndex     The index of the target to get code for.
+    @param callback        A function called on the worker thread once the future is ready,
+                           or null.
+    @param userData        User data passed to `callback`.
+    @param outFuture       Receives the future for the code.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        ICodeGenFuture** outFuture) = 0;
+
+    /** Start generating code for a whole program on another thread.
+
+    This is the asynchronous form of `IComponentType::getTargetCode`, see
+    `getEntryPointCodeAsync`.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        ICodeGenFuture** outFuture) = 0;
+
+    /** Compute a 128-bit digest of the program to generate for the chosen `targetIndex`.
+
+    The digest is computed from the linked IR of the program, serialized without source
+    locations, along with the compiler version and the options of the target. Unlike
+    `IComponentType::getEntryPointHash` it doesn't depend on source file paths, search paths
+    or macros, only on the code they produce, so it can be used as a key for caching compiled
+    code outside of the process, across machines and sessions.
+
+    This links the IR of the program, but doesn't optimize it or generate any code.
+
+    @param targetIndex    The index of the target to compute the digest for.
+    @param outHash        Receives a blob holding the 16 bytes of the digest.
+    @param outDiagnostics Receives any diagnostics produced while linking.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getTargetIRHash(SlangInt targetIndex, IBlob** outHash, IBlob** outDiagnostics = nullptr) = 0;
 };
     #define SLANG_UUID_IComponentType2 IComponentType2::getTypeGuid()
 
@@ -5209,8 +5632,12 @@ struct SlangGlobalSessionDesc
     /// Whether to enable GLSL support.
     bool enableGLSL = false;
 
+    /// The number of threads of the built-in job scheduler, or 0 for one per hardware thread.
+    /// See `ISlangJobScheduler`.
+    uint32_t jobThreadCount = 0;
+
     /// Reserved for future use.
-    uint32_t reserved[16] = {};
+    uint32_t reserved[15] = {};
 };
 
 /* Create a blob from binary data.
@@ -5499,6 +5926,19 @@ public:
     /// Set a callback function to print messages from the byte code runner.
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     setPrintCallback(VMPrintFunc callback, void* userData) = 0;
+
+    /// Execute the selected function once for each of `invocationCount` argument records.
+    /// Record `i` starts `i * argumentStride` bytes into `argumentData` and is
+    /// `argumentSize` bytes long. If `outReturnValues` is not null, the return value of
+    /// invocation `i` is written `i * returnValueStride` bytes into it. Stops at the first
+    /// invocation that fails.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL executeBatch(
+        uint32_t invocationCount,
+        const void* argumentData,
+        size_t argumentSize,
+        size_t argumentStride,
+        void* outReturnValues,
+        size_t returnValueStride) = 0;
 };
 
 } // namespace slang
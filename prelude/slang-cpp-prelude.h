@@ -387,4 +387,19 @@ static inline int32_t _slang_atomic_add_i32(int32_t* ptr, int32_t val)
 #define SLANG_UNROLL
 #endif
 
+// Placed on the innermost loop over the threads of a group with
+// -cpu-vectorize-thread-groups. It tells the compiler that the iterations are independent,
+// so the loop can be vectorized across the threads.
+#ifndef SLANG_PRELUDE_THREAD_LOOP
+#if SLANG_CLANG
+#define SLANG_PRELUDE_THREAD_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif SLANG_GCC
+#define SLANG_PRELUDE_THREAD_LOOP _Pragma("GCC ivdep")
+#elif SLANG_VC
+#define SLANG_PRELUDE_THREAD_LOOP __pragma(loop(ivdep))
+#else
+#define SLANG_PRELUDE_THREAD_LOOP
+#endif
+#endif
+
 #endif
@@ -354,6 +354,114 @@ SLANG_INT_VECTOR_OPS(uintptr_t)
 SLANG_FLOAT_VECTOR_OPS(float)
 SLANG_FLOAT_VECTOR_OPS(double)
 
+// SIMD versions of the float vector arithmetic for the sizes that fill a register. They
+// are explicit specializations of the operator templates above, so overload resolution
+// doesn't change, and each lane is computed exactly as the scalar loop computes it.
+// `Vector` keeps its layout, so the values are loaded and stored unaligned.
+#define SLANG_SIMD_VECTOR_BINARY_OP(T, N, op, LOAD, STORE, INTRINSIC) \
+    template<>                                                        \
+    SLANG_FORCE_INLINE Vector<T, N> operator op<N>(                   \
+        const Vector<T, N>& thisVal,                                  \
+        const Vector<T, N>& other)                                    \
+    {                                                                 \
+        Vector<T, N> result;                                          \
+        STORE(&result.x, INTRINSIC(LOAD(&thisVal.x), LOAD(&other.x))); \
+        return result;                                                \
+    }
+#define SLANG_SIMD_VECTOR_NEG_OP(T, N, LOAD, STORE, INTRINSIC)                 \
+    template<>                                                                 \
+    SLANG_FORCE_INLINE Vector<T, N> operator-<N>(const Vector<T, N>& thisVal) \
+    {                                                                          \
+        Vector<T, N> result;                                                   \
+        STORE(&result.x, INTRINSIC(LOAD(&thisVal.x)));                         \
+        return result;                                                         \
+    }
+#define SLANG_SIMD_FLOAT_VECTOR_OPS(T, N, LOAD, STORE, ADD, SUB, MUL, DIV, NEG) \
+    SLANG_SIMD_VECTOR_BINARY_OP(T, N, +, LOAD, STORE, ADD)                     \
+    SLANG_SIMD_VECTOR_BINARY_OP(T, N, -, LOAD, STORE, SUB)                     \
+    SLANG_SIMD_VECTOR_BINARY_OP(T, N, *, LOAD, STORE, MUL)                     \
+    SLANG_SIMD_VECTOR_BINARY_OP(T, N, /, LOAD, STORE, DIV)                     \
+    SLANG_SIMD_VECTOR_NEG_OP(T, N, LOAD, STORE, NEG)
+
+#if SLANG_PRELUDE_SIMD_SSE2
+SLANG_FORCE_INLINE __m128 _slang_simd_neg(__m128 v)
+{
+    return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+}
+SLANG_FORCE_INLINE __m128d _slang_simd_neg(__m128d v)
+{
+    return _mm_xor_pd(v, _mm_set1_pd(-0.0));
+}
+SLANG_SIMD_FLOAT_VECTOR_OPS(
+    float,
+    4,
+    _mm_loadu_ps,
+    _mm_storeu_ps,
+    _mm_add_ps,
+    _mm_sub_ps,
+    _mm_mul_ps,
+    _mm_div_ps,
+    _slang_simd_neg)
+SLANG_SIMD_FLOAT_VECTOR_OPS(
+    double,
+    2,
+    _mm_loadu_pd,
+    _mm_storeu_pd,
+    _mm_add_pd,
+    _mm_sub_pd,
+    _mm_mul_pd,
+    _mm_div_pd,
+    _slang_simd_neg)
+#if SLANG_PRELUDE_SIMD_AVX
+SLANG_FORCE_INLINE __m256d _slang_simd_neg(__m256d v)
+{
+    return _mm256_xor_pd(v, _mm256_set1_pd(-0.0));
+}
+SLANG_SIMD_FLOAT_VECTOR_OPS(
+    double,
+    4,
+    _mm256_loadu_pd,
+    _mm256_storeu_pd,
+    _mm256_add_pd,
+    _mm256_sub_pd,
+    _mm256_mul_pd,
+    _mm256_div_pd,
+    _slang_simd_neg)
+#endif
+#elif SLANG_PRELUDE_SIMD_NEON
+// 32-bit ARM has no NEON division, and no double precision lanes.
+#if SLANG_PRELUDE_SIMD_NEON64
+SLANG_SIMD_FLOAT_VECTOR_OPS(
+    float,
+    4,
+    vld1q_f32,
+    vst1q_f32,
+    vaddq_f32,
+    vsubq_f32,
+    vmulq_f32,
+    vdivq_f32,
+    vnegq_f32)
+SLANG_SIMD_FLOAT_VECTOR_OPS(
+    double,
+    2,
+    vld1q_f64,
+    vst1q_f64,
+    vaddq_f64,
+    vsubq_f64,
+    vmulq_f64,
+    vdivq_f64,
+    vnegq_f64)
+#else
+SLANG_SIMD_VECTOR_BINARY_OP(float, 4, +, vld1q_f32, vst1q_f32, vaddq_f32)
+SLANG_SIMD_VECTOR_BINARY_OP(float, 4, -, vld1q_f32, vst1q_f32, vsubq_f32)
+SLANG_SIMD_VECTOR_BINARY_OP(float, 4, *, vld1q_f32, vst1q_f32, vmulq_f32)
+SLANG_SIMD_VECTOR_NEG_OP(float, 4, vld1q_f32, vst1q_f32, vnegq_f32)
+#endif
+#endif
+#undef SLANG_SIMD_VECTOR_BINARY_OP
+#undef SLANG_SIMD_VECTOR_NEG_OP
+#undef SLANG_SIMD_FLOAT_VECTOR_OPS
+
 #define SLANG_VECTOR_INT_NEG_OP(T)                      \
     template<int N>                                     \
     Vector<T, N> operator-(const Vector<T, N>& thisVal) \
@@ -612,6 +720,18 @@ struct Matrix
         return result;                                          \
     }
 
+// Float matrices do their arithmetic a row at a time, so that they use the SIMD vector
+// operators where there are any.
+#define SLANG_MATRIX_ROW_BINARY_OP(T, op)                                                     \
+    template<int R, int C>                                                                    \
+    Matrix<T, R, C> operator op(const Matrix<T, R, C>& thisVal, const Matrix<T, R, C>& other) \
+    {                                                                                         \
+        Matrix<T, R, C> result;                                                               \
+        for (int i = 0; i < R; i++)                                                           \
+            result.rows[i] = thisVal.rows[i] op other.rows[i];                                \
+        return result;                                                                        \
+    }
+
 #define SLANG_INT_MATRIX_OPS(T)           \
     SLANG_MATRIX_BINARY_OP(T, +)          \
     SLANG_MATRIX_BINARY_OP(T, -)          \
@@ -632,10 +752,10 @@ struct Matrix
     SLANG_MATRIX_UNARY_OP(T, !)           \
     SLANG_MATRIX_UNARY_OP(T, ~)
 #define SLANG_FLOAT_MATRIX_OPS(T)         \
-    SLANG_MATRIX_BINARY_OP(T, +)          \
-    SLANG_MATRIX_BINARY_OP(T, -)          \
-    SLANG_MATRIX_BINARY_OP(T, *)          \
-    SLANG_MATRIX_BINARY_OP(T, /)          \
+    SLANG_MATRIX_ROW_BINARY_OP(T, +)      \
+    SLANG_MATRIX_ROW_BINARY_OP(T, -)      \
+    SLANG_MATRIX_ROW_BINARY_OP(T, *)      \
+    SLANG_MATRIX_ROW_BINARY_OP(T, /)      \
     SLANG_MATRIX_UNARY_OP(T, -)           \
     SLANG_MATRIX_BINARY_COMPARE_OP(T, >)  \
     SLANG_MATRIX_BINARY_COMPARE_OP(T, <)  \
@@ -697,12 +817,84 @@ SLANG_FLOAT_MATRIX_MOD(float)
 SLANG_FLOAT_MATRIX_MOD(double)
 #undef SLANG_FLOAT_MATRIX_MOD
 #undef SLANG_MATRIX_BINARY_OP
+#undef SLANG_MATRIX_ROW_BINARY_OP
 #undef SLANG_MATRIX_UNARY_OP
 #undef SLANG_INT_MATRIX_OPS
 #undef SLANG_FLOAT_MATRIX_OPS
 #undef SLANG_MATRIX_INT_NEG_OP
 #undef SLANG_FLOAT_MATRIX_MOD
 
+// `dot` and `mul` for floating point vectors and matrices, in the same order of operations
+// as the core module's scalar loops. The float and double overloads are written in terms
+// of the vector operators, so they pick up the SIMD specializations.
+template<typename T, int N>
+SLANG_FORCE_INLINE T _slang_vector_dot(const Vector<T, N>& x, const Vector<T, N>& y)
+{
+    T result = T(0);
+    for (int i = 0; i < N; i++)
+        result += x[i] * y[i];
+    return result;
+}
+
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE Vector<T, M> _slang_mul(const Vector<T, N>& left, const Matrix<T, N, M>& right)
+{
+    Vector<T, M> result;
+    for (int j = 0; j < M; j++)
+    {
+        T sum = T(0);
+        for (int i = 0; i < N; i++)
+            sum += left[i] * right.rows[i][j];
+        result[j] = sum;
+    }
+    return result;
+}
+
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE Vector<T, N> _slang_mul(const Matrix<T, N, M>& left, const Vector<T, M>& right)
+{
+    Vector<T, N> result;
+    for (int i = 0; i < N; i++)
+        result[i] = _slang_vector_dot(left.rows[i], right);
+    return result;
+}
+
+template<typename T, int R, int N, int C>
+SLANG_FORCE_INLINE Matrix<T, R, C> _slang_mul(
+    const Matrix<T, R, N>& left,
+    const Matrix<T, N, C>& right)
+{
+    Matrix<T, R, C> result;
+    for (int r = 0; r < R; r++)
+        result.rows[r] = _slang_mul(left.rows[r], right);
+    return result;
+}
+
+#define SLANG_FLOAT_VECTOR_DOT_MUL(T)                                                         \
+    template<int N>                                                                           \
+    SLANG_FORCE_INLINE T _slang_vector_dot(const Vector<T, N>& x, const Vector<T, N>& y)      \
+    {                                                                                         \
+        const Vector<T, N> products = x * y;                                                  \
+        T result = T(0);                                                                      \
+        for (int i = 0; i < N; i++)                                                           \
+            result += products[i];                                                            \
+        return result;                                                                        \
+    }                                                                                         \
+    template<int N, int M>                                                                    \
+    SLANG_FORCE_INLINE Vector<T, M> _slang_mul(                                               \
+        const Vector<T, N>& left,                                                             \
+        const Matrix<T, N, M>& right)                                                         \
+    {                                                                                         \
+        Vector<T, M> result(T(0));                                                            \
+        for (int i = 0; i < N; i++)                                                           \
+            result = result + Vector<T, M>(left[i]) * right.rows[i];                          \
+        return result;                                                                        \
+    }
+
+SLANG_FLOAT_VECTOR_DOT_MUL(float)
+SLANG_FLOAT_VECTOR_DOT_MUL(double)
+#undef SLANG_FLOAT_VECTOR_DOT_MUL
+
 template<typename TResult, typename TInput>
 TResult slang_bit_cast(TInput val)
 {
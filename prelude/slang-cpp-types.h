@@ -1,6 +1,27 @@
 #ifndef SLANG_PRELUDE_CPP_TYPES_H
 #define SLANG_PRELUDE_CPP_TYPES_H
 
+// Pick the instruction set for the SIMD vector operators in slang-cpp-types-core.h.
+// The slang-llvm JIT compiles without system headers, so it keeps the scalar loops, as
+// does any build that defines SLANG_PRELUDE_DISABLE_SIMD. The intrinsic headers must be
+// included outside of the prelude namespace.
+#if !defined(SLANG_PRELUDE_DISABLE_SIMD) && !defined(SLANG_LLVM)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SLANG_PRELUDE_SIMD_SSE2 1
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SLANG_PRELUDE_SIMD_AVX 1
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SLANG_PRELUDE_SIMD_NEON 1
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define SLANG_PRELUDE_SIMD_NEON64 1
+#endif
+#endif
+#endif
+
 #ifdef SLANG_PRELUDE_NAMESPACE
 namespace SLANG_PRELUDE_NAMESPACE
 {
@@ -81,7 +81,7 @@ struct TensorView
 
 
 TensorView make_tensor_view(
-    torch::Tensor val,
+    const torch::Tensor& val,
     const char* name,
     torch::ScalarType targetScalarType,
     bool requireContiguous)
@@ -105,66 +105,31 @@ TensorView make_tensor_view(
     if (requireContiguous && !val.is_contiguous())
         throw std::runtime_error(std::string(name).append(": tensor is not contiguous.").c_str());
 
-    TensorView res = {};
-    res.dimensionCount = val.dim();
-    res.data = nullptr;
-    size_t elementSize = 4;
-
-    switch (val.scalar_type())
-    {
-    case torch::kInt8:
-    case torch::kUInt8:
-        elementSize = 1;
-        res.data = (uint8_t*)val.data_ptr<uint8_t>();
-        break;
-    case torch::kBFloat16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<torch::BFloat16>();
-        break;
-    case torch::kFloat16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<at::Half>();
-        break;
-    case torch::kInt16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<int16_t>();
-        break;
-    case torch::kFloat32:
-        elementSize = 4;
-        res.data = (uint8_t*)val.data_ptr<float>();
-        break;
-    case torch::kInt32:
-        elementSize = 4;
-        res.data = (uint8_t*)val.data_ptr<int32_t>();
-        break;
-    case torch::kFloat64:
-        elementSize = 8;
-        res.data = (uint8_t*)val.data_ptr<double>();
-        break;
-    case torch::kInt64:
-        elementSize = 8;
-        res.data = (uint8_t*)val.data_ptr<int64_t>();
-        break;
-    case torch::kBool:
-        elementSize = 1;
-        res.data = (uint8_t*)val.data_ptr<bool>();
-        break;
-    }
-
-    if (val.dim() > kSlangTorchTensorMaxDim)
+    // This runs for every tensor argument of every kernel launch, so query the tensor as few
+    // times as possible. `dtype()` has been checked above, so the untyped data pointer and
+    // element size don't need the checks the typed `data_ptr<T>()` accessors repeat.
+    const int64_t dimensionCount = val.dim();
+    if (dimensionCount > kSlangTorchTensorMaxDim)
         throw std::runtime_error(std::string(name)
                                      .append(": number of dimensions exceeds limit (")
                                      .append(std::to_string(kSlangTorchTensorMaxDim))
                                      .append(")")
                                      .c_str());
 
+    TensorView res = {};
+    res.dimensionCount = uint32_t(dimensionCount);
+    res.data = (uint8_t*)val.data_ptr();
+    const int64_t elementSize = val.element_size();
+
     // A tensor can have zero elements even if some dimensions are non-zero
     // (e.g. shape (10, 0)). Emptiness must be based on numel().
     bool isEmpty = (val.numel() == 0);
-    for (int i = 0; i < val.dim(); ++i)
+    const auto sizes = val.sizes();
+    const auto strides = val.strides();
+    for (int64_t i = 0; i < dimensionCount; ++i)
     {
-        res.sizes[i] = val.size(i);
-        res.strides[i] = val.stride(i) * elementSize;
+        res.sizes[i] = uint32_t(sizes[i]);
+        res.strides[i] = uint32_t(strides[i] * elementSize);
         if (!isEmpty && res.strides[i] == 0)
             throw std::runtime_error(
                 std::string(name)
@@ -401,6 +401,8 @@ SlangResult ArtifactPostEmitMetadata::getBufferInfo(slang::CoverageBufferInfo* o
         return SLANG_E_INVALID_ARG;
     outInfo->space = m_coverageBufferSpace;
     outInfo->binding = m_coverageBufferBinding;
+    if (outInfo->structSize >= offsetof(slang::CoverageBufferInfo, mode) + sizeof(outInfo->mode))
+        outInfo->mode = m_coverageMode;
     return SLANG_OK;
 }
 
@@ -260,6 +260,7 @@ public:
     List<CoverageTracingEntry> m_coverageEntries;
     int32_t m_coverageBufferSpace = -1;
     int32_t m_coverageBufferBinding = -1;
+    SlangCoverageMode m_coverageMode = SLANG_COVERAGE_MODE_COUNT;
 };
 
 } // namespace Slang
@@ -0,0 +1,53 @@
+// slang-compile-time-budget.cpp
+#include "slang-compile-time-budget.h"
+
+namespace Slang
+{
+
+void CompileTimeBudget::start(Int milliseconds)
+{
+    m_budgetMilliseconds = milliseconds;
+    m_startTime = std::chrono::steady_clock::now();
+    m_maxPassMilliseconds.clear();
+}
+
+double CompileTimeBudget::getElapsedMilliseconds() const
+{
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - m_startTime;
+    return elapsed.count();
+}
+
+bool CompileTimeBudget::isExceeded() const
+{
+    return isEnabled() && getElapsedMilliseconds() >= double(m_budgetMilliseconds);
+}
+
+bool CompileTimeBudget::shouldDegrade(const char* passName) const
+{
+    if (!isEnabled())
+        return false;
+    double expectedMilliseconds = 0;
+    if (auto maxMilliseconds = m_maxPassMilliseconds.tryGetValue(String(passName)))
+        expectedMilliseconds = *maxMilliseconds;
+    return getElapsedMilliseconds() + expectedMilliseconds >= double(m_budgetMilliseconds);
+}
+
+void CompileTimeBudget::notePassDuration(const char* passName, double milliseconds)
+{
+    auto& maxMilliseconds = m_maxPassMilliseconds.getOrAddValue(String(passName), 0.0);
+    if (milliseconds > maxMilliseconds)
+        maxMilliseconds = milliseconds;
+}
+
+void CompileTimeBudget::noteDegraded(UnownedStringSlice optimization)
+{
+    for (auto& degraded : m_degradedOptimizations)
+    {
+        if (degraded == optimization)
+            return;
+    }
+    m_degradedOptimizations.add(String(optimization));
+}
+
+} // namespace Slang
@@ -0,0 +1,63 @@
+// slang-compile-time-budget.h
+#ifndef SLANG_COMPILER_CORE_COMPILE_TIME_BUDGET_H
+#define SLANG_COMPILER_CORE_COMPILE_TIME_BUDGET_H
+
+#include "../core/slang-basic.h"
+
+#include <chrono>
+
+namespace Slang
+{
+
+/// Tracks the time spent optimizing the IR for a target against the budget set with
+/// `-compile-time-budget`, so that expensive optimizations can fall back to cheaper settings
+/// once the budget is spent or is about to be.
+///
+/// The time each pass took the last times it ran is used to predict whether running it again
+/// would go over the budget.
+class CompileTimeBudget
+{
+public:
+    /// Start tracking a budget of `milliseconds`. A budget of 0 disables tracking. The
+    /// optimizations reduced before are still reported, since they affect the same result.
+    void start(Int milliseconds);
+
+    bool isEnabled() const { return m_budgetMilliseconds > 0; }
+
+    Int getBudgetMilliseconds() const { return m_budgetMilliseconds; }
+
+    double getElapsedMilliseconds() const;
+
+    /// Has the whole budget been spent?
+    bool isExceeded() const;
+
+    /// Would running `passName` again, taking as long as it has taken at most so far, go over
+    /// the budget?
+    bool shouldDegrade(const char* passName) const;
+
+    /// Record that `passName` took `milliseconds` to run.
+    void notePassDuration(const char* passName, double milliseconds);
+
+    /// Record that `optimization` was skipped or reduced to stay within the budget.
+    void noteDegraded(UnownedStringSlice optimization);
+
+    /// The optimizations that were skipped or reduced, in the order they first were.
+    List<String> const& getDegradedOptimizations() const { return m_degradedOptimizations; }
+
+    /// Was any optimization reduced? A result that depends on how long compiling took must not
+    /// be cached.
+    bool wasDegraded() const { return m_degradedOptimizations.getCount() != 0; }
+
+private:
+    Int m_budgetMilliseconds = 0;
+    std::chrono::time_point<std::chrono::steady_clock> m_startTime;
+
+    // The longest time each pass has taken so far.
+    Dictionary<String, double> m_maxPassMilliseconds;
+
+    List<String> m_degradedOptimizations;
+};
+
+} // namespace Slang
+
+#endif
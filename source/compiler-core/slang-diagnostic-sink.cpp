@@ -657,6 +657,9 @@ bool DiagnosticSink::diagnoseRichImpl(
         m_errorCount++;
     }
 
+    if (isFlagSet(Flag::CountOnly) && effectiveSeverity < Severity::Fatal)
+        return true;
+
     String message;
     if (isFlagSet(Flag::MachineReadableDiagnostics))
     {
@@ -782,6 +785,25 @@ bool DiagnosticSink::diagnoseImpl(
     return diagnoseImpl(info, messageBuilder.getUnownedSlice());
 }
 
+bool DiagnosticSink::countDiagnostic(SourceLoc const& pos, DiagnosticInfo const& info)
+{
+    const Severity severity = getEffectiveMessageSeverity(info, pos);
+
+    if (severity == Severity::Disable)
+        return false;
+
+    if (severity >= Severity::Error)
+    {
+        m_errorCount++;
+    }
+
+    if (severity >= Severity::Fatal)
+    {
+        SLANG_ABORT_COMPILATION(info.messageFormat);
+    }
+    return true;
+}
+
 void DiagnosticSink::diagnoseRaw(Severity severity, char const* message)
 {
     return diagnoseRaw(severity, UnownedStringSlice(message));
@@ -794,8 +816,12 @@ void DiagnosticSink::diagnoseRaw(Severity severity, const UnownedStringSlice& me
         m_errorCount++;
     }
 
+    // A count-only sink has nothing more to do with the message.
+    if (isFlagSet(Flag::CountOnly))
+    {
+    }
     // Did the client supply a callback for us to use?
-    if (writer)
+    else if (writer)
     {
         // If so, pass the error string along to them.
         writer->write(message.begin(), message.getLength());
@@ -807,7 +833,7 @@ void DiagnosticSink::diagnoseRaw(Severity severity, const UnownedStringSlice& me
         outputBuffer.append(message);
     }
 
-    if (m_parentSink)
+    if (m_parentSink && !isFlagSet(Flag::CountOnly))
     {
         m_parentSink->diagnoseRaw(severity, message);
     }
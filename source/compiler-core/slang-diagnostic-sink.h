@@ -172,6 +172,8 @@ public:
                 0x20, ///< Convert old style diagnostics to the new style
             MachineReadableDiagnostics =
                 0x40, ///< If set will format diagnostics in machine-readable TSV format
+            CountOnly = 0x80, ///< If set diagnostics are only counted. Messages are not
+                              ///< formatted, written to the output or passed to a parent sink
         };
     };
 
@@ -185,6 +187,10 @@ public:
     template<typename P, typename... Args>
     bool diagnose(P const& pos, DiagnosticInfo const& info, Args const&... args)
     {
+        if (isFlagSet(Flag::CountOnly))
+        {
+            return countDiagnostic(getDiagnosticPos(pos), info);
+        }
         // If we want to force generation of rich diagnostics do that here
         if (isFlagSet(Flag::AlwaysGenerateRichDiagnostics))
         {
@@ -201,6 +207,10 @@ public:
     template<typename P>
     bool diagnose(P const& pos, DiagnosticInfo const& info)
     {
+        if (isFlagSet(Flag::CountOnly))
+        {
+            return countDiagnostic(getDiagnosticPos(pos), info);
+        }
         // If we want to force generation of rich diagnostics do that here
         if (isFlagSet(Flag::AlwaysGenerateRichDiagnostics))
         {
@@ -219,6 +229,12 @@ public:
     template<typename D>
     bool diagnose(D const& d)
     {
+        // Only a warning state tracker needs the location, which would mean building the
+        // whole generic diagnostic to find it.
+        if (isFlagSet(Flag::CountOnly) && !m_sourceWarningStateTracker)
+        {
+            return countDiagnostic(SourceLoc(), *D::getInfo());
+        }
         return diagnoseRichImpl(d.toGenericDiagnostic(), D::getInfo());
     }
 
@@ -381,6 +397,10 @@ protected:
         DiagnosticArg const* args);
     bool diagnoseImpl(DiagnosticInfo const& info, const UnownedStringSlice& formattedMessage);
 
+    // Counts a diagnostic without formatting it, for sinks with Flag::CountOnly set.
+    // Returns true if the diagnostic wasn't disabled.
+    bool countDiagnostic(SourceLoc const& pos, DiagnosticInfo const& info);
+
     // Returns true if a diagnostic is written, doesn't return at all if the diagnostic is fatal.
     // The info parameter is used for severity override lookup (e.g., -Wno-xxx flags).
     bool diagnoseRichImpl(const GenericDiagnostic& diagnostic, const DiagnosticInfo* info);
@@ -0,0 +1,269 @@
+#include "slang-document-version.h"
+
+#include "../core/slang-string-util.h"
+
+namespace Slang
+{
+
+void DocumentVersion::setText(const String& newText)
+{
+    text = newText;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    mapUTF16CharIndexToCodePointIndex.clear();
+    mapCodePointIndexToUTF8ByteOffset.clear();
+}
+
+// Find the code point index of each UTF-16 code unit of `line`, and the byte offset of each
+// of its code points.
+static void _calcUTFBoundaries(
+    UnownedStringSlice line,
+    List<Index>& outUTF16Bounds,
+    List<Index>& outUTF8Bounds)
+{
+    Index index = 0;
+    Index codePointIndex = 0;
+    while (index < line.getLength())
+    {
+        auto startIndex = index;
+        const Char32 codePoint = getUnicodePointFromUTF8(
+            [&]() -> Byte
+            {
+                if (index < line.getLength())
+                    return line[index++];
+                else
+                    return '\0';
+            });
+        if (!codePoint)
+            break;
+
+        Char16 buffer[2];
+        int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
+        for (int i = 0; i < count; i++)
+            outUTF16Bounds.add(codePointIndex);
+        outUTF8Bounds.add(startIndex);
+        codePointIndex++;
+    }
+    outUTF16Bounds.add(line.getLength());
+    outUTF8Bounds.add(line.getLength());
+}
+
+void DocumentVersion::replaceText(Index startOffset, Index endOffset, const String& replacement)
+{
+    // Keep the old text alive, the current lines point into it.
+    String oldText = text;
+    auto oldTextSlice = oldText.getUnownedSlice();
+    StringBuilder newTextBuilder;
+    newTextBuilder << oldTextSlice.head(startOffset) << replacement
+                   << oldTextSlice.tail(endOffset);
+    if (lines.getCount() == 0 || newTextBuilder.getLength() == 0)
+    {
+        setText(newTextBuilder.produceString());
+        return;
+    }
+
+    // Only the lines touched by the edit are split again. Scanning starts at the line holding
+    // `startOffset`, or the one before if the edit starts right after a line break, since the
+    // replacement could then join that line break into a CR/LF pair.
+    auto firstLineIter = std::upper_bound(
+        lines.begin(),
+        lines.end(),
+        startOffset,
+        [this](Index offset, UnownedStringSlice line) { return offset < getLineStart(line); });
+    Index firstLine = Index(firstLineIter - lines.begin()) - 1;
+    if (firstLine > 0 && getLineStart(lines[firstLine]) == startOffset)
+        firstLine--;
+
+    List<UnownedStringSlice> oldLines = _Move(lines);
+    const char* oldBegin = oldTextSlice.begin();
+    const Index rescanStart = oldLines[firstLine].begin() - oldBegin;
+    const Index delta = replacement.getLength() - (endOffset - startOffset);
+    const Index replacementEnd = startOffset + replacement.getLength();
+
+    text = newTextBuilder.produceString();
+    const char* newBegin = text.begin();
+    auto moveLine = [&](UnownedStringSlice oldLine, Index offsetDelta)
+    {
+        const char* lineBegin = newBegin + (oldLine.begin() - oldBegin) + offsetDelta;
+        return UnownedStringSlice(lineBegin, oldLine.getLength());
+    };
+    for (Index i = 0; i < firstLine; i++)
+        lines.add(moveLine(oldLines[i], 0));
+
+    // Lines are split as before once a line starts past the replacement at the same place
+    // as one of the old lines, since everything after it is unchanged.
+    Index firstKeptLine = oldLines.getCount();
+    Index oldLineIndex = firstLine + 1;
+    UnownedStringSlice remaining(newBegin + rescanStart, text.end()), line;
+    while (StringUtil::extractLine(remaining, line))
+    {
+        lines.add(line);
+        if (!remaining.begin())
+            break;
+        const Index nextLineStart = remaining.begin() - newBegin;
+        if (nextLineStart < replacementEnd)
+            continue;
+        const Index oldNextLineStart = nextLineStart - delta;
+        while (oldLineIndex < oldLines.getCount() &&
+               oldLines[oldLineIndex].begin() - oldBegin < oldNextLineStart)
+            oldLineIndex++;
+        if (oldLineIndex < oldLines.getCount() &&
+            oldLines[oldLineIndex].begin() - oldBegin == oldNextLineStart)
+        {
+            firstKeptLine = oldLineIndex;
+            break;
+        }
+    }
+    const Index rescanEnd = lines.getCount();
+    for (Index i = firstKeptLine; i < oldLines.getCount(); i++)
+        lines.add(moveLine(oldLines[i], delta));
+
+    // The UTF boundaries of a line are relative to its start, so only those of the lines
+    // split again need to be found again.
+    if (mapUTF16CharIndexToCodePointIndex.getCount() != oldLines.getCount())
+    {
+        mapUTF16CharIndexToCodePointIndex.clear();
+        mapCodePointIndexToUTF8ByteOffset.clear();
+        return;
+    }
+    List<List<Index>> oldUTF16Bounds = _Move(mapUTF16CharIndexToCodePointIndex);
+    List<List<Index>> oldUTF8Bounds = _Move(mapCodePointIndexToUTF8ByteOffset);
+    for (Index i = 0; i < firstLine; i++)
+    {
+        mapUTF16CharIndexToCodePointIndex.add(_Move(oldUTF16Bounds[i]));
+        mapCodePointIndexToUTF8ByteOffset.add(_Move(oldUTF8Bounds[i]));
+    }
+    for (Index i = firstLine; i < rescanEnd; i++)
+    {
+        List<Index> bounds;
+        List<Index> utf8Bounds;
+        _calcUTFBoundaries(lines[i], bounds, utf8Bounds);
+        mapUTF16CharIndexToCodePointIndex.add(_Move(bounds));
+        mapCodePointIndexToUTF8ByteOffset.add(_Move(utf8Bounds));
+    }
+    for (Index i = firstKeptLine; i < oldLines.getCount(); i++)
+    {
+        mapUTF16CharIndexToCodePointIndex.add(_Move(oldUTF16Bounds[i]));
+        mapCodePointIndexToUTF8ByteOffset.add(_Move(oldUTF8Bounds[i]));
+    }
+}
+
+void DocumentVersion::ensureUTFBoundsAvailable()
+{
+    for (auto slice : lines)
+    {
+        List<Index> bounds;
+        List<Index> utf8Bounds;
+        _calcUTFBoundaries(slice, bounds, utf8Bounds);
+        mapUTF16CharIndexToCodePointIndex.add(_Move(bounds));
+        mapCodePointIndexToUTF8ByteOffset.add(_Move(utf8Bounds));
+    }
+}
+
+ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
+{
+    if (!mapUTF16CharIndexToCodePointIndex.getCount())
+    {
+        ensureUTFBoundsAvailable();
+    }
+    return line >= 1 && line <= mapUTF16CharIndexToCodePointIndex.getCount()
+               ? mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView()
+               : ArrayView<Index>();
+}
+
+ArrayView<Index> DocumentVersion::getUTF8Boundaries(Index line)
+{
+    if (!mapCodePointIndexToUTF8ByteOffset.getCount())
+    {
+        ensureUTFBoundsAvailable();
+    }
+    return line >= 1 && line <= mapCodePointIndexToUTF8ByteOffset.getCount()
+               ? mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView()
+               : ArrayView<Index>();
+}
+
+void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
+    Index inLine,
+    Index inCol,
+    int64_t& outLine,
+    int64_t& outCol)
+{
+    if (inLine <= 0)
+    {
+        outLine = 0;
+        outCol = 0;
+    }
+
+    Index rsLine = inLine - 1;
+    auto bounds = getUTF16Boundaries(inLine);
+    outLine = rsLine;
+    if (bounds.getCount() != 0)
+        outCol = std::lower_bound(bounds.begin(), bounds.end(), inCol - 1) - bounds.begin();
+    else
+        outCol = inCol - 1;
+}
+
+void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
+    Index inLine,
+    Index inCol,
+    int32_t& outLine,
+    int32_t& outCol)
+{
+    int64_t ioutLine, ioutCol;
+    oneBasedUTF8LocToZeroBasedUTF16Loc(inLine, inCol, ioutLine, ioutCol);
+    outLine = (int32_t)ioutLine;
+    outCol = (int32_t)ioutCol;
+}
+
+void DocumentVersion::zeroBasedUTF16LocToOneBasedUTF8Loc(
+    Index inLine,
+    Index inCol,
+    Index& outLine,
+    Index& outCol)
+{
+    outLine = inLine + 1;
+    auto bounds = getUTF16Boundaries(inLine + 1);
+    outCol = inCol >= 0 && inCol < bounds.getCount() ? bounds[inCol] + 1 : 0;
+}
+
+static bool _isIdentifierChar(char ch)
+{
+    return ch >= 'a' && ch <= 'z' || ch >= 'A' && ch <= 'Z' || ch >= '0' && ch <= '9' || ch == '_';
+}
+
+UnownedStringSlice DocumentVersion::peekIdentifier(Index& offset)
+{
+    Index start = offset;
+    Index end = offset;
+    if (start >= text.getLength())
+        return UnownedStringSlice("");
+
+    while (start >= 0 && _isIdentifierChar(text[start]))
+        start--;
+    while (end < text.getLength() && _isIdentifierChar(text[end]))
+        end++;
+    offset = start + 1;
+    if (end > offset)
+        return text.getUnownedSlice().subString(start + 1, end - start - 1);
+    return UnownedStringSlice("");
+}
+
+int DocumentVersion::getTokenLength(Index offset)
+{
+    if (offset >= 0)
+    {
+        Index pos = offset;
+        for (; pos < text.getLength() && _isIdentifierChar(text[pos]); ++pos)
+        {
+        }
+        return (int)(pos - offset);
+    }
+    return 0;
+}
+
+int DocumentVersion::getTokenLength(Index line, Index col)
+{
+    auto offset = getOffset(line, col);
+    return getTokenLength(offset);
+}
+
+} // namespace Slang
@@ -0,0 +1,133 @@
+#ifndef SLANG_COMPILER_CORE_DOCUMENT_VERSION_H
+#define SLANG_COMPILER_CORE_DOCUMENT_VERSION_H
+
+#include "../core/slang-basic.h"
+#include "../core/slang-char-encode.h"
+#include "../core/slang-io.h"
+
+#include <algorithm>
+
+namespace Slang
+{
+
+/// The text of a document open in the language server, split into lines, along with the
+/// UTF-8 and UTF-16 boundaries of each line.
+class DocumentVersion : public RefObject
+{
+private:
+    URI uri;
+    String path;
+    String text;
+    List<UnownedStringSlice> lines;
+    List<List<Index>> mapUTF16CharIndexToCodePointIndex;
+    List<List<Index>> mapCodePointIndexToUTF8ByteOffset;
+
+public:
+    void setPath(String filePath)
+    {
+        path = filePath;
+        uri = URI::fromLocalFilePath(path.getUnownedSlice());
+    }
+    URI getURI() { return uri; }
+    String getPath() { return path; }
+    const String& getText() { return text; }
+    void setText(const String& newText);
+    /// Replace the text between the byte offsets `startOffset` and `endOffset` with
+    /// `replacement`. Only the lines around the edit are split again, and the UTF boundaries
+    /// already found for the other lines are kept.
+    void replaceText(Index startOffset, Index endOffset, const String& replacement);
+
+    void ensureUTFBoundsAvailable();
+    ArrayView<Index> getUTF16Boundaries(Index line);
+    ArrayView<Index> getUTF8Boundaries(Index line);
+
+    void oneBasedUTF8LocToZeroBasedUTF16Loc(
+        Index inLine,
+        Index inCol,
+        int64_t& outLine,
+        int64_t& outCol);
+    void oneBasedUTF8LocToZeroBasedUTF16Loc(
+        Index inLine,
+        Index inCol,
+        int32_t& outLine,
+        int32_t& outCol);
+    void zeroBasedUTF16LocToOneBasedUTF8Loc(
+        Index inLine,
+        Index inCol,
+        Index& outLine,
+        Index& outCol);
+
+    // Get starting offset of line.
+    Index getLineStart(UnownedStringSlice line) { return line.begin() - text.begin(); }
+
+    UnownedStringSlice peekIdentifier(Index line, Index col, Index& offset)
+    {
+        offset = getOffset(line, col);
+        return peekIdentifier(offset);
+    }
+
+    UnownedStringSlice peekIdentifier(Index& offset);
+
+    // Get offset from 1-based, utf-8 encoding location.
+    Index getOffset(Index lineIndex, Index colIndex)
+    {
+        if (lineIndex < 0)
+            return -1;
+        if (lineIndex - 1 >= lines.getCount())
+            return -1;
+        if (lines.getCount() == 0)
+            return -1;
+
+        Index lineStart = lineIndex >= 1 ? getLineStart(lines[lineIndex - 1]) : 0;
+        auto boundaries = getUTF8Boundaries(lineIndex);
+        Index byteOffset = 0;
+        if (colIndex > 0 && colIndex <= boundaries.getCount())
+            byteOffset = boundaries[colIndex - 1];
+        return lineStart + byteOffset;
+    }
+
+    // Get 1-based, utf-8 encoding location from offset.
+    void offsetToLineCol(Index offset, Index& line, Index& col)
+    {
+        auto firstGreater = std::upper_bound(
+            lines.begin(),
+            lines.end(),
+            offset,
+            [this](Index first, UnownedStringSlice second)
+            { return first < getLineStart(second); });
+        line = Index(firstGreater - lines.begin());
+        if (firstGreater == lines.begin())
+        {
+            col = offset + 1;
+        }
+        else
+        {
+            col = Index(offset - getLineStart(lines[line - 1])) + 1;
+        }
+        if (line > 0 && line <= lines.getCount())
+            col = UTF8Util::calcCodePointCount(lines[line - 1].head(col - 1)) + 1;
+    }
+
+    Index getLineCount() { return lines.getCount(); }
+
+    // Get line from 1-based index.
+    UnownedStringSlice getLine(Index lineIndex)
+    {
+        if (lineIndex < 0)
+            return UnownedStringSlice();
+        if (lineIndex - 1 >= lines.getCount())
+            return UnownedStringSlice();
+        if (lines.getCount() == 0)
+            return UnownedStringSlice();
+
+        return lineIndex > 0 ? lines[lineIndex - 1] : UnownedStringSlice();
+    }
+
+    // Get length of an identifier token starting at the specified position.
+    int getTokenLength(Index line, Index col);
+    int getTokenLength(Index offset);
+};
+
+} // namespace Slang
+
+#endif
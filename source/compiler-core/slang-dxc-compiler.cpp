@@ -17,6 +17,8 @@
 #include "slang-include-system.h"
 #include "slang-source-loc.h"
 
+#include <mutex>
+
 // Enable DXIL by default unless told not to
 #ifndef SLANG_ENABLE_DXIL_SUPPORT
 #if SLANG_APPLE_FAMILY
@@ -200,6 +202,34 @@ public:
     DXCDownstreamCompiler() {}
 
 protected:
+    /// A compiler and library pair. DXC objects must not be used by more than one thread at a
+    /// time, but creating them is costly compared to compiling a small shader, so the pairs are
+    /// kept in a pool and reused by later compiles rather than being created for each one.
+    struct Instances
+    {
+        ComPtr<IDxcCompiler> compiler;
+        ComPtr<IDxcLibrary> library;
+    };
+
+    /// Holds a pair taken from the pool, and returns it when it goes out of scope.
+    struct ScopedInstances : Instances
+    {
+        ScopedInstances(DXCDownstreamCompiler* owner)
+            : m_owner(owner)
+        {
+        }
+        ~ScopedInstances()
+        {
+            if (compiler && library)
+                m_owner->_releaseInstances(*this);
+        }
+        DXCDownstreamCompiler* m_owner;
+    };
+
+    /// Take a pair from the pool, or create a new one if the pool is empty.
+    SlangResult _acquireInstances(Instances& outInstances);
+    void _releaseInstances(const Instances& instances);
+
     DxcCreateInstanceProc m_createInstance = nullptr;
 
     /// The commit hash associated with the DXC dll used
@@ -209,6 +239,9 @@ protected:
     uint32_t m_commitCount = 0;
 
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
+
+    std::mutex m_instancesMutex;
+    List<Instances> m_freeInstances;
 };
 
 static String _moveTaskMemAllocatedToString(char* chars)
@@ -222,6 +255,35 @@ static String _moveTaskMemAllocatedToString(char* chars)
     return String();
 }
 
+SlangResult DXCDownstreamCompiler::_acquireInstances(Instances& outInstances)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        if (m_freeInstances.getCount())
+        {
+            outInstances = m_freeInstances.getLast();
+            m_freeInstances.removeLast();
+            return SLANG_OK;
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(m_createInstance(
+        CLSID_DxcCompiler,
+        __uuidof(outInstances.compiler),
+        (LPVOID*)outInstances.compiler.writeRef()));
+    SLANG_RETURN_ON_FAIL(m_createInstance(
+        CLSID_DxcLibrary,
+        __uuidof(outInstances.library),
+        (LPVOID*)outInstances.library.writeRef()));
+    return SLANG_OK;
+}
+
+void DXCDownstreamCompiler::_releaseInstances(const Instances& instances)
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    m_freeInstances.add(instances);
+}
+
 SlangResult DXCDownstreamCompiler::init(ISlangSharedLibrary* library)
 {
     m_sharedLibrary = library;
@@ -444,14 +506,10 @@ SlangResult DXCDownstreamCompiler::compile(const CompileOptions& inOptions, IArt
         }
     }
 
-    ComPtr<IDxcCompiler> dxcCompiler;
-    SLANG_RETURN_ON_FAIL(m_createInstance(
-        CLSID_DxcCompiler,
-        __uuidof(dxcCompiler),
-        (LPVOID*)dxcCompiler.writeRef()));
-    ComPtr<IDxcLibrary> dxcLibrary;
-    SLANG_RETURN_ON_FAIL(
-        m_createInstance(CLSID_DxcLibrary, __uuidof(dxcLibrary), (LPVOID*)dxcLibrary.writeRef()));
+    ScopedInstances instances(this);
+    SLANG_RETURN_ON_FAIL(_acquireInstances(instances));
+    IDxcCompiler* dxcCompiler = instances.compiler;
+    IDxcLibrary* dxcLibrary = instances.library;
 
     ComPtr<IDxcBlobEncoding> dxcSourceBlob = nullptr;
     ComPtr<ISlangBlob> sourceBlob;
@@ -810,14 +868,10 @@ SlangResult DXCDownstreamCompiler::convert(
     ComPtr<ISlangBlob> dxilBlob;
     SLANG_RETURN_ON_FAIL(from->loadBlob(ArtifactKeep::No, dxilBlob.writeRef()));
 
-    ComPtr<IDxcCompiler> dxcCompiler;
-    SLANG_RETURN_ON_FAIL(m_createInstance(
-        CLSID_DxcCompiler,
-        __uuidof(dxcCompiler),
-        (LPVOID*)dxcCompiler.writeRef()));
-    ComPtr<IDxcLibrary> dxcLibrary;
-    SLANG_RETURN_ON_FAIL(
-        m_createInstance(CLSID_DxcLibrary, __uuidof(dxcLibrary), (LPVOID*)dxcLibrary.writeRef()));
+    ScopedInstances instances(this);
+    SLANG_RETURN_ON_FAIL(_acquireInstances(instances));
+    IDxcCompiler* dxcCompiler = instances.compiler;
+    IDxcLibrary* dxcLibrary = instances.library;
 
     // Create blob from the input data
     ComPtr<IDxcBlobEncoding> dxcSourceBlob;
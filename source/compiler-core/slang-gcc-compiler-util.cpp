@@ -3,6 +3,7 @@
 
 #include "../core/slang-char-util.h"
 #include "../core/slang-common.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-string-slice-pool.h"
@@ -112,9 +113,40 @@ static const CompilerVersionPattern s_compilerVersionPatterns[] = {
     {"Apple metal version", SLANG_PASS_THROUGH_METAL},
 };
 
-SlangResult GCCDownstreamCompilerUtil::calcVersion(
-    const ExecutableLocation& exe,
-    DownstreamCompilerDesc& outDesc)
+namespace
+{ // anonymous
+
+// Running a compiler to find its version takes a noticeable amount of time, and every global
+// session locates its compilers again. So the result of each probe is kept for the life of the
+// process, keyed by how the executable was located.
+struct CompilerVersionCache
+{
+    struct Entry
+    {
+        SlangResult result;
+        DownstreamCompilerDesc desc;
+    };
+
+    static String getKey(const ExecutableLocation& exe)
+    {
+        StringBuilder key;
+        key << int(exe.m_type) << ":" << exe.m_pathOrName;
+        return key.produceString();
+    }
+
+    std::mutex mutex;
+    Dictionary<String, Entry> entries;
+};
+
+} // namespace
+
+static CompilerVersionCache& _getCompilerVersionCache()
+{
+    static CompilerVersionCache cache;
+    return cache;
+}
+
+static SlangResult _probeVersion(const ExecutableLocation& exe, DownstreamCompilerDesc& outDesc)
 {
     CommandLine cmdLine;
     cmdLine.setExecutableLocation(exe);
@@ -131,7 +163,10 @@ SlangResult GCCDownstreamCompilerUtil::calcVersion(
         outDesc.type = pattern.compilerType;
         UnownedStringSlice prefix(pattern.versionPrefix);
 
-        if (SLANG_SUCCEEDED(parseVersion(exeRes.standardError.getUnownedSlice(), prefix, outDesc)))
+        if (SLANG_SUCCEEDED(GCCDownstreamCompilerUtil::parseVersion(
+                exeRes.standardError.getUnownedSlice(),
+                prefix,
+                outDesc)))
         {
             return SLANG_OK;
         }
@@ -140,6 +175,33 @@ SlangResult GCCDownstreamCompilerUtil::calcVersion(
     return SLANG_FAIL;
 }
 
+SlangResult GCCDownstreamCompilerUtil::calcVersion(
+    const ExecutableLocation& exe,
+    DownstreamCompilerDesc& outDesc)
+{
+    auto& cache = _getCompilerVersionCache();
+    const String key = CompilerVersionCache::getKey(exe);
+
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (auto entry = cache.entries.tryGetValue(key))
+        {
+            outDesc = entry->desc;
+            return entry->result;
+        }
+    }
+
+    // The probe runs without the lock held, so sessions locating different compilers don't
+    // wait on each other. If two race on the same one they get the same answer.
+    CompilerVersionCache::Entry entry;
+    entry.result = _probeVersion(exe, entry.desc);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries[key] = entry;
+    outDesc = entry.desc;
+    return entry.result;
+}
+
 namespace
 { // anonymous
 
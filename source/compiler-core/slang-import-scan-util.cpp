@@ -0,0 +1,106 @@
+#include "slang-import-scan-util.h"
+
+#include "../core/slang-char-util.h"
+
+namespace Slang
+{
+
+/* static */ void ImportScanUtil::scanImportedModuleNames(
+    UnownedStringSlice text,
+    List<String>& outModuleNames)
+{
+    auto isIdentifierChar = [](char c) { return CharUtil::isAlphaOrDigit(c) || c == '_'; };
+
+    const char* cursor = text.begin();
+    const char* end = text.end();
+    auto skipWhitespaceAndComments = [&]()
+    {
+        while (cursor < end)
+        {
+            if (CharUtil::isWhitespace(*cursor))
+                cursor++;
+            else if (end - cursor >= 2 && cursor[0] == '/' && cursor[1] == '/')
+            {
+                while (cursor < end && *cursor != '\n')
+                    cursor++;
+            }
+            else if (end - cursor >= 2 && cursor[0] == '/' && cursor[1] == '*')
+            {
+                cursor += 2;
+                while (end - cursor >= 2 && !(cursor[0] == '*' && cursor[1] == '/'))
+                    cursor++;
+                cursor = end - cursor >= 2 ? cursor + 2 : end;
+            }
+            else
+                break;
+        }
+    };
+    auto readIdentifier = [&]()
+    {
+        const char* start = cursor;
+        while (cursor < end && isIdentifierChar(*cursor))
+            cursor++;
+        return UnownedStringSlice(start, cursor);
+    };
+
+    while (true)
+    {
+        skipWhitespaceAndComments();
+        if (cursor >= end)
+            break;
+
+        char c = *cursor;
+        if (c == '"' || c == '\'')
+        {
+            // Skip the literal.
+            for (cursor++; cursor < end && *cursor != c && *cursor != '\n'; cursor++)
+            {
+                if (*cursor == '\\' && cursor + 1 < end)
+                    cursor++;
+            }
+            if (cursor < end)
+                cursor++;
+            continue;
+        }
+        if (!isIdentifierChar(c))
+        {
+            cursor++;
+            continue;
+        }
+        if (readIdentifier() != toSlice("import"))
+            continue;
+
+        // The module name is either a string, or identifiers separated by dots, in which
+        // case the dots stand for directory separators as they do in the parser.
+        skipWhitespaceAndComments();
+        StringBuilder moduleName;
+        if (cursor < end && *cursor == '"')
+        {
+            const char* start = ++cursor;
+            while (cursor < end && *cursor != '"' && *cursor != '\n' && *cursor != '\\')
+                cursor++;
+            if (cursor >= end || *cursor != '"')
+                continue;
+            moduleName << UnownedStringSlice(start, cursor);
+            cursor++;
+        }
+        else
+        {
+            while (cursor < end && isIdentifierChar(*cursor))
+            {
+                moduleName << readIdentifier();
+                skipWhitespaceAndComments();
+                if (cursor >= end || *cursor != '.')
+                    break;
+                moduleName << "/";
+                cursor++;
+                skipWhitespaceAndComments();
+            }
+        }
+        skipWhitespaceAndComments();
+        if (moduleName.getLength() && cursor < end && *cursor == ';')
+            outModuleNames.add(moduleName.produceString());
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,24 @@
+#ifndef SLANG_COMPILER_CORE_IMPORT_SCAN_UTIL_H
+#define SLANG_COMPILER_CORE_IMPORT_SCAN_UTIL_H
+
+#include "../core/slang-list.h"
+#include "../core/slang-string.h"
+
+namespace Slang
+{
+
+struct ImportScanUtil
+{
+    /// Find the names of the modules imported by `import` declarations in `text`, without
+    /// preprocessing or parsing it. Comments and literals are skipped, but imports in code that
+    /// the preprocessor would leave out are found too. A dotted module name is returned with
+    /// the dots replaced by `/`, as the parser does. Files brought in with `#include` or
+    /// `__include` are not followed.
+    ///
+    /// Doesn't use a name pool, so it can be run on any thread.
+    static void scanImportedModuleNames(UnownedStringSlice text, List<String>& outModuleNames);
+};
+
+} // namespace Slang
+
+#endif
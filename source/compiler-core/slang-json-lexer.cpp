@@ -4,6 +4,8 @@
 #include "../core/slang-char-util.h"
 #include "slang-json-diagnostics.h"
 
+#include <string.h>
+
 /*
 https://www.json.org/json-en.html
 */
@@ -51,6 +53,7 @@ SlangResult JSONLexer::init(SourceView* sourceView, DiagnosticSink* sink)
     SLANG_ASSERT(sourceFile && sourceFile->hasContent());
 
     m_contentStart = sourceFile->getContent().begin();
+    m_contentEnd = sourceFile->getContent().end();
 
     m_startLoc = sourceView->getRange().begin;
 
@@ -356,6 +359,18 @@ const char* JSONLexer::_lexString(const char* cursor)
     // We've skipped the first "
     while (true)
     {
+        // Strings can be very long (the text of a document sent to the language server for
+        // example), and most of their bytes need no handling, so skip eight bytes at a time up
+        // to the first that could be a quote, an escape, or the terminating zero.
+        for (; m_contentEnd - cursor >= 8; cursor += 8)
+        {
+            uint64_t word;
+            memcpy(&word, cursor, sizeof(word));
+            if (CharUtil::wordHasByte(word, '"') | CharUtil::wordHasByte(word, '\\') |
+                CharUtil::wordHasByte(word, 0))
+                break;
+        }
+
         const char c = *cursor++;
 
         switch (c)
@@ -105,6 +105,8 @@ protected:
     const char* m_lexemeStart;
 
     const char* m_contentStart;
+    /// The end of the content, where its terminating zero is
+    const char* m_contentEnd;
 
     SourceLoc m_startLoc;
 
@@ -109,10 +109,8 @@ void JSONRPCConnection::disconnect()
 
 SlangResult JSONRPCConnection::sendRPC(const RttiInfo* rttiInfo, const void* data)
 {
-    auto typeMap = JSONNativeUtil::getTypeFuncsMap();
-
     // Convert to JSON
-    NativeToJSONConverter converter(&m_container, &typeMap, &m_diagnosticSink);
+    NativeToJSONConverter converter(&m_container, &m_typeMap, &m_diagnosticSink);
     JSONValue value;
 
     SLANG_RETURN_ON_FAIL(converter.convert(rttiInfo, data, value));
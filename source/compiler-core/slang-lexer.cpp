@@ -11,6 +11,8 @@
 #include "slang-name.h"
 #include "slang-source-loc.h"
 
+#include <string.h>
+
 namespace Slang
 {
 Token TokenReader::getEndOfFileToken()
@@ -329,10 +331,90 @@ static void _handleNewLine(Lexer* lexer)
     _handleNewLineInner(lexer, c);
 }
 
+// Most of the bytes inside of comments, whitespace and identifiers don't need the careful
+// handling that `_peek()` and `_advance()` give them. Only escaped newlines, line endings,
+// non-ASCII code points and NUL bytes do. The following helpers skip over a run of bytes that
+// need no such handling directly, eight bytes at a time where possible, and leave the cursor
+// at the first byte that has to go through the slower path.
+
+static const uint64_t kLowBitOfEachByte = 0x0101010101010101ull;
+static const uint64_t kHighBitOfEachByte = 0x8080808080808080ull;
+
+static uint64_t _loadWord(const char* cursor)
+{
+    uint64_t word;
+    memcpy(&word, cursor, sizeof(word));
+    return word;
+}
+
+// Returns a non-zero value if any byte of `word` is equal to `byte`.
+static uint64_t _wordHasByte(uint64_t word, unsigned char byte)
+{
+    const uint64_t x = word ^ (kLowBitOfEachByte * byte);
+    return (x - kLowBitOfEachByte) & ~x & kHighBitOfEachByte;
+}
+
+// Skip comment bytes up to the first line ending, backslash, NUL or non-ASCII byte, and also
+// up to the first `*` if `stopAtStar` is set (for block comments).
+static void _skipPlainCommentBytes(Lexer* lexer, bool stopAtStar)
+{
+    const char* cursor = lexer->m_cursor;
+    const char* const end = lexer->m_end;
+
+    for (; end - cursor >= 8; cursor += 8)
+    {
+        const uint64_t word = _loadWord(cursor);
+        uint64_t found = (word & kHighBitOfEachByte) | _wordHasByte(word, '\n') |
+                         _wordHasByte(word, '\r') | _wordHasByte(word, '\\') |
+                         _wordHasByte(word, 0);
+        if (stopAtStar)
+            found |= _wordHasByte(word, '*');
+        if (found)
+            break;
+    }
+    for (; cursor != end; ++cursor)
+    {
+        const char c = *cursor;
+        if (c == '\n' || c == '\r' || c == '\\' || c == 0 || (c & 0x80) ||
+            (stopAtStar && c == '*'))
+            break;
+    }
+    lexer->m_cursor = cursor;
+}
+
+static void _skipPlainHorizontalSpace(Lexer* lexer)
+{
+    const char* cursor = lexer->m_cursor;
+    const char* const end = lexer->m_end;
+
+    // Indentation is often made of runs of spaces.
+    while (end - cursor >= 8 && _loadWord(cursor) == kLowBitOfEachByte * ' ')
+        cursor += 8;
+    while (cursor != end && (*cursor == ' ' || *cursor == '\t'))
+        ++cursor;
+    lexer->m_cursor = cursor;
+}
+
+static bool _isAsciiIdentifierChar(char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') ||
+           c == '_';
+}
+
+static void _skipPlainIdentifierBytes(Lexer* lexer)
+{
+    const char* cursor = lexer->m_cursor;
+    const char* const end = lexer->m_end;
+    while (cursor != end && _isAsciiIdentifierChar(*cursor))
+        ++cursor;
+    lexer->m_cursor = cursor;
+}
+
 static void _lexLineComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainCommentBytes(lexer, false);
         switch (_peek(lexer))
         {
         case '\n':
@@ -351,6 +433,7 @@ static void _lexBlockComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainCommentBytes(lexer, true);
         switch (_peek(lexer))
         {
         case kEOF:
@@ -385,6 +468,7 @@ static void _lexHorizontalSpace(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainHorizontalSpace(lexer);
         switch (_peek(lexer))
         {
         case ' ':
@@ -407,6 +491,7 @@ static void _lexIdentifier(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainIdentifierBytes(lexer);
         int c = _peek(lexer);
         if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
             (c == '_') || isNonAsciiCodePoint((unsigned int)c))
@@ -108,6 +108,8 @@ enum
 {
     kLexerFlag_SuppressDiagnostics = 1
                                      << 2, ///< Suppress errors about invalid/unsupported characters
+    kLexerFlag_HasDiagnostics = 1 << 3, ///< Set once there was something to diagnose, suppressed
+                                        ///< or not
 };
 
 struct Lexer
@@ -144,8 +146,12 @@ struct Lexer
 
     /// Get the diagnostic sink, taking into account flags. Will return null if suppressing
     /// diagnostics.
+    ///
+    /// Only called when there is something to diagnose, so it also notes that the lexed
+    /// tokens came with diagnostics.
     DiagnosticSink* getDiagnosticSink()
     {
+        m_lexerFlags |= kLexerFlag_HasDiagnostics;
         return ((m_lexerFlags & kLexerFlag_SuppressDiagnostics) == 0) ? m_sink : nullptr;
     }
 
@@ -21,29 +21,38 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(UnownedStringSlice text)
+Name* NamePool::_addName(String const& text)
 {
-    RefPtr<Name> name;
-    if (names.tryGetValue(text, name))
-        return name;
-
-    name = new Name();
+    RefPtr<Name> name = new Name();
     name->text = text;
-    names.add(text, name);
+    names.add(name->text, name);
     return name;
 }
 
+Name* NamePool::getName(UnownedStringSlice text)
+{
+    if (auto name = names.tryGetValue(text))
+        return *name;
+    return _addName(String(text));
+}
+
 Name* NamePool::getName(String const& text)
 {
-    return getName(text.getUnownedSlice());
+    if (auto name = names.tryGetValue(text))
+        return *name;
+    return _addName(text);
 }
 
-Name* NamePool::tryGetName(String const& text)
+Name* NamePool::tryGetName(UnownedStringSlice text)
 {
-    RefPtr<Name> name;
-    if (names.tryGetValue(text, name))
-        return name;
+    if (auto name = names.tryGetValue(text))
+        return *name;
     return nullptr;
 }
 
+Name* NamePool::tryGetName(String const& text)
+{
+    return tryGetName(text.getUnownedSlice());
+}
+
 } // namespace Slang
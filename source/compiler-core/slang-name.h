@@ -51,14 +51,22 @@ const char* getCstr(Name* name);
 struct NamePool
 {
     // Find or create the `Name` that represents the given `text`.
+    //
+    // Looking up an existing name doesn't allocate. A new name made from a
+    // `String` shares its text with it.
     Name* getName(UnownedStringSlice text);
     Name* getName(String const& text);
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
+    Name* tryGetName(UnownedStringSlice text);
     Name* tryGetName(String const& text);
 
     // The mapping from text strings to the corresponding name.
+    // Each key shares its text with the name it maps to.
     Dictionary<String, RefPtr<Name>> names;
+
+private:
+    Name* _addName(String const& text);
 };
 
 } // namespace Slang
@@ -6,6 +6,26 @@
 namespace Slang
 {
 
+static UInt32 _perfectHash(const UnownedStringSlice& str, UInt32 salt, UInt32 nBuckets)
+{
+    //
+    // The current getStableHashCode is susceptible to patterns of
+    // collisions causing the search to fail for the SPIR-V opnames; it
+    // performs poorly on short strings, taking over 300000 iterations to
+    // diverge on "Ceil" and "FMix" (and place them in already unoccupied
+    // slots)!
+    //
+    // Use FNV Hash here which seem perform much better on these short inputs
+    // https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+    //
+    // If you change this, don't forget to also sync the version below in
+    // the printing code.
+    UInt32 h = salt;
+    for (const char c : str)
+        h = (h * 0x01000193) ^ c;
+    return h % nBuckets;
+}
+
 // Implemented according to "Hash, displace, and compress"
 // https://cmph.sourceforge.net/papers/esa09.pdf
 HashFindResult minimalPerfectHash(const List<String>& ss, HashParams& hashParams)
@@ -28,24 +48,7 @@ HashFindResult minimalPerfectHash(const List<String>& ss, HashParams& hashParams
     initialBuckets.setCount(nBuckets);
 
     const auto hash = [&](const String& s, const HashCode32 salt = 0) -> UInt32
-    {
-        //
-        // The current getStableHashCode is susceptible to patterns of
-        // collisions causing the search to fail for the SPIR-V opnames; it
-        // performs poorly on short strings, taking over 300000 iterations to
-        // diverge on "Ceil" and "FMix" (and place them in already unoccupied
-        // slots)!
-        //
-        // Use FNV Hash here which seem perform much better on these short inputs
-        // https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
-        //
-        // If you change this, don't forget to also sync the version below in
-        // the printing code.
-        UInt32 h = salt;
-        for (const char c : s)
-            h = (h * 0x01000193) ^ c;
-        return h % nBuckets;
-    };
+    { return _perfectHash(s.getUnownedSlice(), salt, nBuckets); };
 
     // Assign the inputs into their buckets according to the hash without salt.
     // Sort the buckets according to size, so that later we can make these have
@@ -127,6 +130,17 @@ HashFindResult minimalPerfectHash(const List<String>& ss, HashParams& hashParams
     return HashFindResult::Success;
 }
 
+Index perfectHashLookup(const HashParams& hashParams, const UnownedStringSlice& str)
+{
+    const UInt32 nBuckets = UInt32(hashParams.saltTable.getCount());
+    if (nBuckets == 0)
+        return -1;
+
+    const auto salt = hashParams.saltTable[_perfectHash(str, 0, nBuckets)];
+    const auto i = _perfectHash(str, salt, nBuckets);
+    return hashParams.destTable[i] == str ? Index(i) : -1;
+}
+
 String perfectHashToEmbeddableCpp(
     const HashParams& hashParams,
     const UnownedStringSlice& valueType,
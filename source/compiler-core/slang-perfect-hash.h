@@ -22,6 +22,11 @@ enum class HashFindResult
 // Calculate a minimal perfect hash of a list of input strings
 HashFindResult minimalPerfectHash(const List<String>& ss, HashParams& hashParams);
 
+// Find the index of `str` in `hashParams.destTable`, or -1 if it isn't one of the hashed
+// strings. Lets a table of names that is only known at runtime be searched with the same hash
+// as the generated lookup functions.
+Index perfectHashLookup(const HashParams& hashParams, const UnownedStringSlice& str);
+
 String perfectHashToEmbeddableCpp(
     const HashParams& hashParams,
     const UnownedStringSlice& valueType,
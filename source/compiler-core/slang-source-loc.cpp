@@ -2,6 +2,7 @@
 #include "slang-source-loc.h"
 
 #include "../core/slang-char-encode.h"
+#include "../core/slang-char-util.h"
 #include "../core/slang-string-escape-util.h"
 #include "../core/slang-string-util.h"
 #include "slang-artifact-desc-util.h"
@@ -9,6 +10,8 @@
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-util.h"
 
+#include <string.h>
+
 namespace Slang
 {
 
@@ -149,6 +152,15 @@ int SourceView::findEntryIndex(SourceLoc sourceLoc) const
     return int(lo);
 }
 
+int SourceView::calcLineIndexFromOffset(int offset)
+{
+    const int lineIndex = m_sourceFile->calcLineIndexFromOffset(
+        offset,
+        m_lastLineIndex.load(std::memory_order_relaxed));
+    m_lastLineIndex.store(lineIndex, std::memory_order_relaxed);
+    return lineIndex;
+}
+
 void SourceView::addLineDirective(
     SourceLoc directiveLoc,
     StringSlicePool::Handle pathHandle,
@@ -166,7 +178,7 @@ void SourceView::addLineDirective(
     const int offset = m_range.getOffset(directiveLoc);
 
     // Get the line index in the original file
-    const int lineIndex = m_sourceFile->calcLineIndexFromOffset(offset);
+    const int lineIndex = calcLineIndexFromOffset(offset);
 
     Entry entry;
     entry.m_startLoc = directiveLoc;
@@ -263,7 +275,7 @@ static SlangResult _findLocWithSourceMap(
     {
         const auto offset = sourceView->getRange().getOffset(loc);
 
-        const auto lineIndex = sourceFile->calcLineIndexFromOffset(offset);
+        const auto lineIndex = sourceView->calcLineIndexFromOffset(offset);
         const auto colIndex = sourceFile->calcColumnIndex(lineIndex, offset);
 
         // If we are in this function the sourceFile should have a map
@@ -373,7 +385,7 @@ HandleSourceLoc SourceView::getHandleLoc(SourceLoc loc, SourceLocType type)
     const int offset = m_range.getOffset(loc);
 
     // We need the line index from the original source file
-    const int lineIndex = m_sourceFile->calcLineIndexFromOffset(offset);
+    const int lineIndex = calcLineIndexFromOffset(offset);
 
     // TODO:
     // - Tab characters, which should really adjust how we report
@@ -472,6 +484,43 @@ void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
     m_lineBreakOffsets.addRange(offsets, numOffsets);
 }
 
+// Most bytes of a source file aren't line endings, so we look for them eight bytes at a time,
+// and only go byte by byte within a word that contains one.
+
+// Add the offset of the start of each line of `content` to `outOffsets`. Line endings are
+// handled the same way as by `StringUtil::extractLine`, with `\r\n` and `\n\r` each counting
+// as a single line break.
+static void _findLineBreakOffsets(UnownedStringSlice content, List<uint32_t>& outOffsets)
+{
+    const char* const begin = content.begin();
+    const char* const end = content.end();
+    if (!begin)
+        return;
+
+    outOffsets.add(0);
+
+    const char* cursor = begin;
+    for (;;)
+    {
+        for (; end - cursor >= 8; cursor += 8)
+        {
+            uint64_t word;
+            memcpy(&word, cursor, sizeof(word));
+            if (CharUtil::wordHasByte(word, '\n') | CharUtil::wordHasByte(word, '\r'))
+                break;
+        }
+        while (cursor < end && *cursor != '\n' && *cursor != '\r')
+            cursor++;
+        if (cursor == end)
+            break;
+
+        const char c = *cursor++;
+        if (cursor < end && (c ^ *cursor) == ('\r' ^ '\n'))
+            cursor++;
+        outOffsets.add(uint32_t(cursor - begin));
+    }
+}
+
 const List<uint32_t>& SourceFile::getLineBreakOffsets()
 {
     // Multiple threads can race the first line-break scan for the same SourceFile.
@@ -482,12 +531,7 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
     // cache an array of line break locations in the file.
     if (m_lineBreakOffsets.getCount() == 0)
     {
-        UnownedStringSlice content(getContent()), line;
-        char const* contentBegin = content.begin();
-        while (StringUtil::extractLine(content, line))
-        {
-            m_lineBreakOffsets.add(uint32_t(line.begin() - contentBegin));
-        }
+        _findLineBreakOffsets(getContent(), m_lineBreakOffsets);
         // Note that we do *not* treat the end of the file as a line
         // break, because otherwise we would report errors like
         // "end of file inside string literal" with a line number
@@ -547,17 +591,38 @@ bool SourceFile::isOffsetOnLine(uint32_t offset, Index lineIndex)
 }
 
 int SourceFile::calcLineIndexFromOffset(int offset)
+{
+    return calcLineIndexFromOffset(offset, -1);
+}
+
+int SourceFile::calcLineIndexFromOffset(int offset, int lineIndexHint)
 {
     SLANG_ASSERT(UInt(offset) <= getContentSize());
 
     // Make sure we have the line break offsets
     const auto& lineBreakOffsets = getLineBreakOffsets();
+    const Index lineCount = lineBreakOffsets.getCount();
+
+    // Lookups tend to move forward through a file a little at a time, so before searching
+    // we try the hinted line and the one after it.
+    if (lineIndexHint >= 0)
+    {
+        for (Index lineIndex = lineIndexHint;
+             lineIndex < lineCount && lineIndex <= lineIndexHint + 1;
+             lineIndex++)
+        {
+            if (lineBreakOffsets[lineIndex] > uint32_t(offset))
+                break;
+            if (lineIndex + 1 == lineCount || lineBreakOffsets[lineIndex + 1] > uint32_t(offset))
+                return int(lineIndex);
+        }
+    }
 
     // At this point we can assume the `lineBreakOffsets` array has been filled in.
     // We will use a binary search to find the line index that contains our
     // chosen offset.
     Index lo = 0;
-    Index hi = lineBreakOffsets.getCount();
+    Index hi = lineCount;
 
     while (lo + 1 < hi)
     {
@@ -1018,6 +1083,18 @@ void SourceManager::addSourceFileIfNotExist(const String& uniqueIdentity, Source
     m_sourceFileMap.addIfNotExists(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::removeSourceFile(SourceFile* sourceFile)
+{
+    List<String> uniqueIdentities;
+    for (const auto& [uniqueIdentity, file] : m_sourceFileMap)
+    {
+        if (file == sourceFile)
+            uniqueIdentities.add(uniqueIdentity);
+    }
+    for (auto& uniqueIdentity : uniqueIdentities)
+        m_sourceFileMap.remove(uniqueIdentity);
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -11,6 +11,7 @@
 #include "slang-source-map.h"
 #include "slang.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace Slang
@@ -286,6 +287,10 @@ public:
     /// Calculate the line based on the offset
     int calcLineIndexFromOffset(int offset);
 
+    /// Calculate the line based on the offset, checking `lineIndexHint` and the line after it
+    /// before searching. A hint of -1 means there is no hint.
+    int calcLineIndexFromOffset(int offset, int lineIndexHint);
+
     /// Calculate the offset (in bytes) for a line
     int calcColumnOffset(int line, int offset);
 
@@ -540,6 +545,10 @@ public:
         }
     }
 
+    /// Calculate the line in the source file containing `offset`, starting the search from the
+    /// line found by the previous call.
+    int calcLineIndexFromOffset(int offset);
+
 protected:
     /// Get the pathInfo from a string handle. If it's 0, it will return the _getPathInfo
     PathInfo _getPathInfoFromHandle(StringSlicePool::Handle pathHandle) const;
@@ -557,6 +566,7 @@ protected:
                               ///< starting from the start location.
     SourceLoc::RawValue m_absoluteLocationBase = 0; ///< Base of the absolute location mapping.
     List<AbsoluteSegment> m_absSegments;            ///< Segments of absolute location mapping.
+    std::atomic<int> m_lastLineIndex{-1};           ///< Line found by the last line lookup.
 };
 
 struct SourceManager
@@ -625,6 +635,9 @@ struct SourceManager
     /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
     void addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
+    /// Remove the uniqueIdentity mappings to sourceFile, so the find methods no longer return
+    /// it. The manager keeps owning the file, as locations may still refer to it.
+    void removeSourceFile(SourceFile* sourceFile);
 
     // Maps a SourceLoc to an absolute location
     SourceLoc::RawValue getAbsoluteLocation(SourceLoc location) const;
@@ -7,6 +7,8 @@
 #include "../slang-json-value.h"
 #include "../slang-visual-studio-compiler-util.h"
 
+#include <mutex>
+
 #ifdef _WIN32
 #include <shlobj.h>
 #include <windows.h>
@@ -453,8 +455,10 @@ static SlangResult _findVersionsWithRegistery(List<WinVisualStudioUtil::VersionP
     return SLANG_OK;
 }
 
-/* static */ SlangResult WinVisualStudioUtil::find(List<VersionPath>& outVersionPaths)
+static void _findVersions(List<WinVisualStudioUtil::VersionPath>& outVersionPaths)
 {
+    typedef WinVisualStudioUtil::VersionPath VersionPath;
+
     outVersionPaths.clear();
 
     List<VersionPath> regVersions;
@@ -491,6 +495,24 @@ static SlangResult _findVersionsWithRegistery(List<WinVisualStudioUtil::VersionP
     }
     // Sort
     _orderVersions(outVersionPaths);
+}
+
+/* static */ SlangResult WinVisualStudioUtil::find(List<VersionPath>& outVersionPaths)
+{
+    // Running vswhere and reading the registry takes a noticeable amount of time, and every
+    // global session locates its compilers again. The installations won't change while the
+    // process runs, so only search for them once.
+    static std::mutex s_mutex;
+    static bool s_hasFound = false;
+    static List<VersionPath> s_versionPaths;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_hasFound)
+    {
+        _findVersions(s_versionPaths);
+        s_hasFound = true;
+    }
+    outVersionPaths = s_versionPaths;
     return SLANG_OK;
 }
 
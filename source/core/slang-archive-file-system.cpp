@@ -22,7 +22,8 @@ namespace Slang
 SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
-    ComPtr<ISlangFileSystemExt>& outFileSystem)
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    ISlangJobScheduler* jobScheduler)
 {
     ComPtr<ISlangMutableFileSystem> fileSystem;
     if (ZipFileSystem::isArchive(data, dataSizeInBytes))
@@ -33,7 +34,9 @@ SlangResult loadArchiveFileSystem(
     else if (RiffFileSystem::isArchive(data, dataSizeInBytes))
     {
         // It's riff contained (Slang specific)
-        fileSystem = new RiffFileSystem(nullptr);
+        auto riffFileSystem = new RiffFileSystem(nullptr);
+        riffFileSystem->setJobScheduler(jobScheduler);
+        fileSystem = riffFileSystem;
     }
     else
     {
@@ -52,10 +55,35 @@ SlangResult loadArchiveFileSystem(
     return SLANG_OK;
 }
 
+SlangResult loadArchiveFileSystem(
+    ISlangBlob* archiveBlob,
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    ISlangJobScheduler* jobScheduler)
+{
+    const void* data = archiveBlob->getBufferPointer();
+    const size_t dataSizeInBytes = archiveBlob->getBufferSize();
+
+    // Only the riff archive can reference the blob directly
+    if (!RiffFileSystem::isArchive(data, dataSizeInBytes))
+    {
+        return loadArchiveFileSystem(data, dataSizeInBytes, outFileSystem, jobScheduler);
+    }
+
+    auto riffFileSystem = new RiffFileSystem(nullptr);
+    ComPtr<ISlangMutableFileSystem> fileSystem(riffFileSystem);
+    riffFileSystem->setJobScheduler(jobScheduler);
+    SLANG_RETURN_ON_FAIL(riffFileSystem->loadArchiveBlob(archiveBlob));
+
+    outFileSystem = fileSystem;
+    return SLANG_OK;
+}
+
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
-    ComPtr<ISlangMutableFileSystem>& outFileSystem)
+    ComPtr<ISlangMutableFileSystem>& outFileSystem,
+    ISlangJobScheduler* jobScheduler)
 {
+    ICompressionSystem* compressionSystem = nullptr;
     switch (type)
     {
     case SLANG_ARCHIVE_TYPE_ZIP:
@@ -63,23 +91,25 @@ SlangResult createArchiveFileSystem(
             return ZipFileSystem::create(outFileSystem);
         }
     case SLANG_ARCHIVE_TYPE_RIFF:
-        {
-            outFileSystem = new RiffFileSystem(nullptr);
-            return SLANG_OK;
-        }
+        break;
     case SLANG_ARCHIVE_TYPE_RIFF_DEFLATE:
         {
-            outFileSystem = new RiffFileSystem(DeflateCompressionSystem::getSingleton());
-            return SLANG_OK;
+            compressionSystem = DeflateCompressionSystem::getSingleton();
+            break;
         }
     case SLANG_ARCHIVE_TYPE_RIFF_LZ4:
         {
-            outFileSystem = new RiffFileSystem(LZ4CompressionSystem::getSingleton());
-            return SLANG_OK;
+            compressionSystem = LZ4CompressionSystem::getSingleton();
+            break;
         }
+    default:
+        return SLANG_FAIL;
     }
 
-    return SLANG_FAIL;
+    auto riffFileSystem = new RiffFileSystem(compressionSystem);
+    riffFileSystem->setJobScheduler(jobScheduler);
+    outFileSystem = riffFileSystem;
+    return SLANG_OK;
 }
 
 } // namespace Slang
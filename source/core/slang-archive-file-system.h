@@ -28,13 +28,23 @@ class IArchiveFileSystem : public ISlangCastable
     SLANG_NO_THROW virtual void SLANG_MCALL setCompressionStyle(const CompressionStyle& style) = 0;
 };
 
+/// If `jobScheduler` is set, archives that support it compress and decompress files on it
+/// in parallel.
 SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
-    ComPtr<ISlangFileSystemExt>& outFileSystem);
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    ISlangJobScheduler* jobScheduler = nullptr);
+/// As above, but where possible the file system references the contents of `archiveBlob`
+/// in place rather than copying them.
+SlangResult loadArchiveFileSystem(
+    ISlangBlob* archiveBlob,
+    ComPtr<ISlangFileSystemExt>& outFileSystem,
+    ISlangJobScheduler* jobScheduler = nullptr);
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
-    ComPtr<ISlangMutableFileSystem>& outFileSystem);
+    ComPtr<ISlangMutableFileSystem>& outFileSystem,
+    ISlangJobScheduler* jobScheduler = nullptr);
 
 } // namespace Slang
 
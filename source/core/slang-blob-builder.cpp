@@ -97,10 +97,12 @@ Size BlobBuilder::_writeChunksTo(Stream* stream)
         SLANG_ASSERT(paddingSize >= chunkPrefixSize);
         paddingSize -= chunkPrefixSize;
 
-        while (paddingSize--)
+        while (paddingSize)
         {
-            Byte padding = 0;
-            stream->write(&padding, sizeof(padding));
+            static const Byte kPadding[64] = {};
+            Size count = Math::Min(paddingSize, Size(sizeof(kPadding)));
+            stream->write(kPadding, count);
+            paddingSize -= count;
         }
 
         // The `ChunkBuilder::_writeTo()` call will write the
@@ -120,8 +122,18 @@ Size BlobBuilder::_writeChunksTo(Stream* stream)
 
 void BlobBuilder::writeToBlob(ISlangBlob** outBlob)
 {
+    // The size is known before anything is written, so the stream
+    // is allocated once rather than grown (and copied) as the
+    // shards are appended.
+    //
+    Size size = _calcSizeAndSetCachedChunkOffsets();
+
     OwnedMemoryStream stream(FileAccess::Write);
-    writeTo(&stream);
+    stream.reserve(size);
+
+    SLANG_MAYBE_UNUSED
+    Size sizeWritten = _writeChunksTo(&stream);
+    SLANG_ASSERT(size == sizeWritten);
 
     List<uint8_t> data;
     stream.swapContents(data);
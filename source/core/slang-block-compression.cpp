@@ -0,0 +1,259 @@
+#include "slang-block-compression.h"
+
+#include "slang-blob.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang-job-scheduler.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+/// Run `func(index)` for `count` jobs, on `jobScheduler` if there is one.
+template<typename F>
+void _runJobs(ISlangJobScheduler* jobScheduler, Count count, F& func)
+{
+    if (jobScheduler)
+    {
+        runJobs(jobScheduler, count, 0, func);
+    }
+    else
+    {
+        for (Index i = 0; i < count; ++i)
+            func(i);
+    }
+}
+
+/// The parsed header and frame table of a block compressed blob.
+struct BlockLayout
+{
+    size_t blockSize = 0;
+    Count blockCount = 0;
+    const uint32_t* frameEnds = nullptr;
+    const uint8_t* frames = nullptr;
+
+    /// Check `compressed` is a plausible encoding of `decompressedSizeInBytes` bytes.
+    SlangResult init(
+        const void* compressed,
+        size_t compressedSizeInBytes,
+        size_t decompressedSizeInBytes)
+    {
+        typedef BlockCompressionUtil::Header Header;
+        if (compressedSizeInBytes < sizeof(Header))
+        {
+            return SLANG_FAIL;
+        }
+
+        Header header;
+        ::memcpy(&header, compressed, sizeof(header));
+
+        blockSize = header.blockSize;
+        blockCount = Count(header.blockCount);
+
+        const size_t expectedBlockCount =
+            blockSize ? (decompressedSizeInBytes + blockSize - 1) / blockSize : 0;
+        if (blockSize == 0 || size_t(blockCount) != expectedBlockCount)
+        {
+            return SLANG_FAIL;
+        }
+
+        const size_t tableSize = sizeof(uint32_t) * size_t(blockCount);
+        if (compressedSizeInBytes < sizeof(Header) + tableSize)
+        {
+            return SLANG_FAIL;
+        }
+
+        frameEnds = (const uint32_t*)((const uint8_t*)compressed + sizeof(Header));
+        frames = (const uint8_t*)frameEnds + tableSize;
+
+        // Frame ends must be increasing, and the last must be the end of the frame data.
+        const size_t framesSize = compressedSizeInBytes - sizeof(Header) - tableSize;
+        uint32_t prevEnd = 0;
+        for (Index i = 0; i < blockCount; ++i)
+        {
+            if (frameEnds[i] < prevEnd)
+            {
+                return SLANG_FAIL;
+            }
+            prevEnd = frameEnds[i];
+        }
+        if (size_t(prevEnd) != framesSize)
+        {
+            return SLANG_FAIL;
+        }
+        return SLANG_OK;
+    }
+
+    const uint8_t* getFrame(Index i) const { return frames + (i ? frameEnds[i - 1] : 0); }
+    size_t getFrameSize(Index i) const { return frameEnds[i] - (i ? frameEnds[i - 1] : 0); }
+};
+
+} // namespace
+
+/* static */ SlangResult BlockCompressionUtil::compress(
+    ICompressionSystem* system,
+    const CompressionStyle* style,
+    ISlangJobScheduler* jobScheduler,
+    size_t blockSize,
+    const void* src,
+    size_t srcSizeInBytes,
+    ISlangBlob** outBlob)
+{
+    if (blockSize == 0 || blockSize > 0xffffffff)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    const Count blockCount = Count((srcSizeInBytes + blockSize - 1) / blockSize);
+
+    List<ComPtr<ISlangBlob>> frames;
+    List<SlangResult> results;
+    frames.setCount(blockCount);
+    results.setCount(blockCount);
+
+    auto compressBlock = [&](Index i)
+    {
+        const size_t start = size_t(i) * blockSize;
+        const size_t size = Math::Min(blockSize, srcSizeInBytes - start);
+        results[i] = system->compress(
+            style,
+            (const uint8_t*)src + start,
+            size,
+            frames[i].writeRef());
+    };
+    _runJobs(jobScheduler, blockCount, compressBlock);
+
+    size_t framesSize = 0;
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(results[i]);
+        framesSize += frames[i]->getBufferSize();
+    }
+    if (framesSize > 0xffffffff)
+    {
+        return SLANG_FAIL;
+    }
+
+    const size_t tableSize = sizeof(uint32_t) * size_t(blockCount);
+
+    ScopedAllocation alloc;
+    uint8_t* dst = (uint8_t*)alloc.allocate(sizeof(Header) + tableSize + framesSize);
+
+    Header header;
+    header.blockSize = uint32_t(blockSize);
+    header.blockCount = uint32_t(blockCount);
+    ::memcpy(dst, &header, sizeof(header));
+
+    uint32_t* frameEnds = (uint32_t*)(dst + sizeof(Header));
+    uint8_t* dstFrames = dst + sizeof(Header) + tableSize;
+
+    size_t offset = 0;
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        ISlangBlob* frame = frames[i];
+        const size_t frameSize = frame->getBufferSize();
+        ::memcpy(dstFrames + offset, frame->getBufferPointer(), frameSize);
+        offset += frameSize;
+        frameEnds[i] = uint32_t(offset);
+    }
+
+    *outBlob = RawBlob::moveCreate(alloc).detach();
+    return SLANG_OK;
+}
+
+/* static */ SlangResult BlockCompressionUtil::decompress(
+    ICompressionSystem* system,
+    ISlangJobScheduler* jobScheduler,
+    const void* compressed,
+    size_t compressedSizeInBytes,
+    size_t decompressedSizeInBytes,
+    void* outDecompressed)
+{
+    return decompressRange(
+        system,
+        jobScheduler,
+        compressed,
+        compressedSizeInBytes,
+        decompressedSizeInBytes,
+        0,
+        decompressedSizeInBytes,
+        outDecompressed);
+}
+
+/* static */ SlangResult BlockCompressionUtil::decompressRange(
+    ICompressionSystem* system,
+    ISlangJobScheduler* jobScheduler,
+    const void* compressed,
+    size_t compressedSizeInBytes,
+    size_t decompressedSizeInBytes,
+    size_t offset,
+    size_t size,
+    void* outDecompressed)
+{
+    if (offset > decompressedSizeInBytes || size > decompressedSizeInBytes - offset)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    BlockLayout layout;
+    SLANG_RETURN_ON_FAIL(layout.init(compressed, compressedSizeInBytes, decompressedSizeInBytes));
+
+    if (size == 0)
+    {
+        return SLANG_OK;
+    }
+
+    const size_t blockSize = layout.blockSize;
+    const Index firstBlock = Index(offset / blockSize);
+    const Index lastBlock = Index((offset + size - 1) / blockSize);
+    const Count blockCount = lastBlock - firstBlock + 1;
+
+    List<SlangResult> results;
+    results.setCount(blockCount);
+
+    auto decompressBlock = [&](Index jobIndex)
+    {
+        const Index i = firstBlock + jobIndex;
+        const size_t blockStart = size_t(i) * blockSize;
+        const size_t blockEnd = Math::Min(blockStart + blockSize, decompressedSizeInBytes);
+
+        // The part of the block that is in the range
+        const size_t start = Math::Max(blockStart, offset);
+        const size_t end = Math::Min(blockEnd, offset + size);
+        uint8_t* dst = (uint8_t*)outDecompressed + (start - offset);
+
+        if (start == blockStart && end == blockEnd)
+        {
+            // The whole block is wanted, so it can be decompressed in place.
+            results[jobIndex] = system->decompress(
+                layout.getFrame(i),
+                layout.getFrameSize(i),
+                blockEnd - blockStart,
+                dst);
+            return;
+        }
+
+        ScopedAllocation alloc;
+        uint8_t* block = (uint8_t*)alloc.allocate(blockEnd - blockStart);
+        results[jobIndex] = system->decompress(
+            layout.getFrame(i),
+            layout.getFrameSize(i),
+            blockEnd - blockStart,
+            block);
+        if (SLANG_SUCCEEDED(results[jobIndex]))
+        {
+            ::memcpy(dst, block + (start - blockStart), end - start);
+        }
+    };
+    _runJobs(jobScheduler, blockCount, decompressBlock);
+
+    for (auto result : results)
+    {
+        SLANG_RETURN_ON_FAIL(result);
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
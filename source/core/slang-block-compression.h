@@ -0,0 +1,73 @@
+#ifndef SLANG_BLOCK_COMPRESSION_H
+#define SLANG_BLOCK_COMPRESSION_H
+
+#include "slang-basic.h"
+#include "slang-compression-system.h"
+
+namespace Slang
+{
+
+/* Compresses data as a sequence of independently compressed frames, each holding a fixed size
+block of the source data.
+
+Because frames don't depend on each other they can be compressed and decompressed in parallel,
+and a range of the data can be read by only decompressing the frames that overlap it.
+
+The compressed layout is
+
+* A Header
+* `blockCount` uint32_t offsets, each the end of a frame relative to the start of the frame data
+* The frame data
+
+Frame `i` holds the source bytes `[i * blockSize, min((i + 1) * blockSize, size))`.
+*/
+struct BlockCompressionUtil
+{
+    struct Header
+    {
+        uint32_t blockSize;  ///< The uncompressed size of every block but the last
+        uint32_t blockCount; ///< The number of frames
+    };
+
+    /// A block size that keeps the loss in compression ratio small, while still splitting
+    /// large files into enough frames to keep several threads busy.
+    static const size_t kDefaultBlockSize = 1024 * 1024;
+
+    /// Compress `srcSizeInBytes` of `src` into frames of `blockSize` bytes each.
+    /// If `jobScheduler` is set, the frames are compressed on it in parallel.
+    static SlangResult compress(
+        ICompressionSystem* system,
+        const CompressionStyle* style,
+        ISlangJobScheduler* jobScheduler,
+        size_t blockSize,
+        const void* src,
+        size_t srcSizeInBytes,
+        ISlangBlob** outBlob);
+
+    /// Decompress all of `compressed` into `outDecompressed`, which must be
+    /// `decompressedSizeInBytes` in size, exactly the size of the original source.
+    /// If `jobScheduler` is set, the frames are decompressed on it in parallel.
+    static SlangResult decompress(
+        ICompressionSystem* system,
+        ISlangJobScheduler* jobScheduler,
+        const void* compressed,
+        size_t compressedSizeInBytes,
+        size_t decompressedSizeInBytes,
+        void* outDecompressed);
+
+    /// Decompress `size` bytes starting at `offset` of the original source into
+    /// `outDecompressed`. Only frames that overlap the range are decompressed.
+    static SlangResult decompressRange(
+        ICompressionSystem* system,
+        ISlangJobScheduler* jobScheduler,
+        const void* compressed,
+        size_t compressedSizeInBytes,
+        size_t decompressedSizeInBytes,
+        size_t offset,
+        size_t size,
+        void* outDecompressed);
+};
+
+} // namespace Slang
+
+#endif
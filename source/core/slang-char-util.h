@@ -53,6 +53,15 @@ struct CharUtil
     /// True if the character is an octal digit
     SLANG_FORCE_INLINE static bool isOctalDigit(char c) { return c >= '0' && c <= '7'; }
 
+    /// Returns a non-zero value if any of the eight bytes of `word` is equal to `c`. Lets text be
+    /// searched for a character eight bytes at a time.
+    SLANG_FORCE_INLINE static uint64_t wordHasByte(uint64_t word, char c)
+    {
+        const uint64_t lowBits = 0x0101010101010101ull;
+        const uint64_t x = word ^ (lowBits * static_cast<unsigned char>(c));
+        return (x - lowBits) & ~x & (lowBits << 7);
+    }
+
     /// For a given character get the associated flags
     SLANG_FORCE_INLINE static Flags getFlags(char c)
     {
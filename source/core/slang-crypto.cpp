@@ -12,6 +12,15 @@
 
 #include "../core/slang-char-util.h"
 
+#if SLANG_PROCESSOR_X86_64
+#if SLANG_VC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
 namespace Slang
 {
 
@@ -90,45 +99,53 @@ void SHA1::update(const void* data, SlangSizeT len)
     }
 
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    m_bits += uint64_t(len) * 8;
 
-    // Fill up buffer if not full.
-    while (len > 0 && m_index != 0)
+    // Fill up buffer if not empty.
+    if (m_index != 0)
     {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
-    }
+        const size_t count = Math::Min(size_t(len), sizeof(m_buf) - m_index);
+        ::memcpy(m_buf + m_index, ptr, count);
+        m_index += uint32_t(count);
+        ptr += count;
+        len -= count;
 
-    // Process full blocks.
-    while (len >= sizeof(m_buf))
-    {
-        processBlock(ptr);
-        ptr += sizeof(m_buf);
-        len -= sizeof(m_buf);
-        m_bits += sizeof(m_buf) * 8;
+        if (m_index < sizeof(m_buf))
+        {
+            return;
+        }
+        processBlocks(m_buf, 1);
+        m_index = 0;
     }
 
-    // Process remaining bytes.
-    while (len > 0)
-    {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
-    }
+    // Process full blocks directly from the input.
+    const size_t blockCount = size_t(len) / sizeof(m_buf);
+    processBlocks(ptr, blockCount);
+    ptr += blockCount * sizeof(m_buf);
+    len -= blockCount * sizeof(m_buf);
+
+    // Keep the remaining bytes for the next update.
+    ::memcpy(m_buf, ptr, len);
+    m_index = uint32_t(len);
 }
 
 SHA1::Digest SHA1::finalize()
 {
     // Finalize with 0x80, some zero padding and the length in bits.
-    addByte(0x80);
-    while (m_index % 64 != 56)
+    m_buf[m_index++] = 0x80;
+    if (m_index > 56)
     {
-        addByte(0);
+        ::memset(m_buf + m_index, 0, sizeof(m_buf) - m_index);
+        processBlocks(m_buf, 1);
+        m_index = 0;
     }
-    for (int i = 7; i >= 0; --i)
+    ::memset(m_buf + m_index, 0, 56 - m_index);
+    for (int i = 0; i < 8; ++i)
     {
-        addByte(uint8_t(m_bits >> i * 8));
+        m_buf[56 + i] = uint8_t(m_bits >> ((7 - i) * 8));
     }
+    processBlocks(m_buf, 1);
+    m_index = 0;
 
     Digest digest;
     uint8_t* data = reinterpret_cast<uint8_t*>(digest.data);
@@ -143,14 +160,122 @@ SHA1::Digest SHA1::finalize()
     return digest;
 }
 
-void SHA1::addByte(uint8_t byte)
+#if SLANG_PROCESSOR_X86_64
+
+// Returns true if the CPU has the SHA extensions, and the SSSE3 and SSE4.1 instructions used
+// with them.
+static bool _hasSHAExtensions()
 {
-    m_buf[m_index++] = byte;
+    static const bool hasSHAExtensions = []()
+    {
+        unsigned int leaf1[4] = {0};
+        unsigned int leaf7[4] = {0};
+#if SLANG_VC
+        __cpuid(reinterpret_cast<int*>(leaf1), 1);
+        __cpuidex(reinterpret_cast<int*>(leaf7), 7, 0);
+#else
+        if (!__get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]) ||
+            !__get_cpuid_count(7, 0, &leaf7[0], &leaf7[1], &leaf7[2], &leaf7[3]))
+        {
+            return false;
+        }
+#endif
+        const bool hasSSSE3 = (leaf1[2] & (1u << 9)) != 0;
+        const bool hasSSE41 = (leaf1[2] & (1u << 19)) != 0;
+        const bool hasSHA = (leaf7[1] & (1u << 29)) != 0;
+        return hasSSSE3 && hasSSE41 && hasSHA;
+    }();
+    return hasSHAExtensions;
+}
+
+#if SLANG_GCC_FAMILY
+#define SLANG_SHA_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+#else
+#define SLANG_SHA_TARGET
+#endif
 
-    if (m_index >= sizeof(m_buf))
+// The rounds functions take the round group as an immediate.
+SLANG_SHA_TARGET static __m128i _sha1Rounds(__m128i abcd, __m128i e, int group)
+{
+    switch (group)
     {
-        m_index = 0;
-        processBlock(m_buf);
+    case 0:
+        return _mm_sha1rnds4_epu32(abcd, e, 0);
+    case 1:
+        return _mm_sha1rnds4_epu32(abcd, e, 1);
+    case 2:
+        return _mm_sha1rnds4_epu32(abcd, e, 2);
+    default:
+        return _mm_sha1rnds4_epu32(abcd, e, 3);
+    }
+}
+
+// Process blocks with the SHA extensions. Each step does four of the 80 rounds, with the
+// message schedule for the following steps computed from the last four words of it.
+SLANG_SHA_TARGET static void _processBlocksSHA(
+    uint32_t state[5],
+    const uint8_t* ptr,
+    size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ll, 0x08090a0b0c0d0e0fll);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1b);
+    __m128i e = _mm_set_epi32(int(state[4]), 0, 0, 0);
+
+    for (; count > 0; --count, ptr += 64)
+    {
+        const __m128i startAbcd = abcd;
+        const __m128i startE = e;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(ptr + i * 16)), byteSwap);
+        }
+
+        // The first step adds e directly, after that it is derived from the value of abcd
+        // before the previous step.
+        __m128i prevAbcd = abcd;
+        abcd = _sha1Rounds(abcd, _mm_add_epi32(e, w[0]), 0);
+
+        for (int step = 1; step < 20; ++step)
+        {
+            if (step >= 4)
+            {
+                __m128i& next = w[step & 3];
+                next = _mm_sha1msg1_epu32(next, w[(step + 1) & 3]);
+                next = _mm_xor_si128(next, w[(step + 2) & 3]);
+                next = _mm_sha1msg2_epu32(next, w[(step + 3) & 3]);
+            }
+            e = _mm_sha1nexte_epu32(prevAbcd, w[step & 3]);
+            prevAbcd = abcd;
+            abcd = _sha1Rounds(abcd, e, step / 5);
+        }
+
+        e = _mm_sha1nexte_epu32(prevAbcd, startE);
+        abcd = _mm_add_epi32(abcd, startAbcd);
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = uint32_t(_mm_extract_epi32(e, 3));
+}
+
+#undef SLANG_SHA_TARGET
+
+#endif // SLANG_PROCESSOR_X86_64
+
+void SHA1::processBlocks(const uint8_t* ptr, size_t count)
+{
+#if SLANG_PROCESSOR_X86_64
+    if (_hasSHAExtensions())
+    {
+        _processBlocksSHA(m_state, ptr, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i)
+    {
+        processBlock(ptr + i * sizeof(m_buf));
     }
 }
 
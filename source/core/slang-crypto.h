@@ -82,7 +82,9 @@ public:
     static Digest compute(const void* data, SlangInt size);
 
 private:
-    void addByte(uint8_t x);
+    /// Process `count` 64 byte blocks starting at `ptr`. Uses the SHA extensions when the CPU
+    /// has them.
+    void processBlocks(const uint8_t* ptr, size_t count);
     void processBlock(const uint8_t* ptr);
 
     uint32_t m_index;
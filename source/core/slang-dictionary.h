@@ -402,7 +402,11 @@ public:
     bool add(const T& obj) { return dict.addIfNotExists(obj, _DummyClass()); }
     bool add(T&& obj) { return dict.addIfNotExists(_Move(obj), _DummyClass()); }
     void remove(const T& obj) { dict.remove(obj); }
-    bool contains(const T& obj) const { return dict.containsKey(obj); }
+    template<typename K>
+    bool contains(const K& obj) const
+    {
+        return dict.containsKey(obj);
+    }
 };
 template<typename T>
 class HashSet : public HashSetBase<T, Dictionary<T, _DummyClass>>
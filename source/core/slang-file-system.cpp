@@ -202,6 +202,21 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // Large precompiled modules are mapped rather than read, so they are paged in on demand
+    // and shared between processes through the page cache. Source files are always read:
+    // they are edited while tools such as the language server hold on to them, and a mapping
+    // would change under the compiler (or fault, if the file is truncated) on Linux, and keep
+    // editors from saving the file on Windows. Small files are cheaper to just read.
+    if (Path::getPathExt(path) == toSlice("slang-module"))
+    {
+        const size_t kMinMappedFileSize = 64 * 1024;
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::loadAllBytes(path, kMinMappedFileSize, blob));
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
+
     ScopedAllocation alloc;
     SLANG_RETURN_ON_FAIL(File::readAllBytes(path, alloc));
     *outBlob = RawBlob::moveCreate(alloc).detach();
@@ -517,6 +532,18 @@ SlangResult CacheFileSystem::enumeratePathContents(
 }
 
 
+/// The unique identity used by the hash modes, which is a combination of the file name and
+/// the hash of the contents.
+static String _makeHashUniqueIdentity(const String& path, const StableHashCode64& hash)
+{
+    String hashString = Path::getFileName(path);
+    hashString = hashString.toLower();
+
+    hashString.append(':');
+    hashString.append(hash);
+    return hashString;
+}
+
 SlangResult CacheFileSystem::_calcUniqueIdentity(
     const String& path,
     String& outUniqueIdentity,
@@ -560,6 +587,24 @@ SlangResult CacheFileSystem::_calcUniqueIdentity(
                 return SLANG_E_NOT_FOUND;
             }
 
+            // If the digest of this exact version of the file is known from a previous
+            // session, there is no need to load and hash it.
+            PersistentCache::Key digestKey;
+            const bool hasDigestKey =
+                m_digestCache && SLANG_SUCCEEDED(_calcDigestCacheKey(path, digestKey));
+            if (hasDigestKey)
+            {
+                ComPtr<ISlangBlob> digestBlob;
+                if (SLANG_SUCCEEDED(m_digestCache->readEntry(digestKey, digestBlob.writeRef())) &&
+                    digestBlob->getBufferSize() == sizeof(StableHashCode64))
+                {
+                    StableHashCode64 hash;
+                    ::memcpy(&hash, digestBlob->getBufferPointer(), sizeof(hash));
+                    outUniqueIdentity = _makeHashUniqueIdentity(path, hash);
+                    return SLANG_OK;
+                }
+            }
+
             // First attempt to load as a file
             Result res = m_fileSystem->loadFile(path.getBuffer(), outFileContents.writeRef());
 
@@ -596,15 +641,17 @@ SlangResult CacheFileSystem::_calcUniqueIdentity(
                 (const char*)outFileContents->getBufferPointer(),
                 outFileContents->getBufferSize());
 
-            String hashString = Path::getFileName(path);
-            hashString = hashString.toLower();
-
-            hashString.append(':');
-
-            // The uniqueIdentity is a combination of name and hash
-            hashString.append(hash);
+            // The key was calculated before the file was read, so the digest is only stored if
+            // the file didn't change in the meantime. Failing to store it just means hashing
+            // again next time.
+            PersistentCache::Key digestKeyAfterRead;
+            if (hasDigestKey && SLANG_SUCCEEDED(_calcDigestCacheKey(path, digestKeyAfterRead)) &&
+                digestKeyAfterRead == digestKey)
+            {
+                m_digestCache->writeEntry(digestKey, RawBlob::create(&hash, sizeof(hash)));
+            }
 
-            outUniqueIdentity = hashString;
+            outUniqueIdentity = _makeHashUniqueIdentity(path, hash);
             return SLANG_OK;
         }
     }
@@ -612,6 +659,48 @@ SlangResult CacheFileSystem::_calcUniqueIdentity(
     return SLANG_FAIL;
 }
 
+SlangResult CacheFileSystem::_calcDigestCacheKey(const String& path, PersistentCache::Key& outKey)
+{
+    // Work out the path on the operating system file system, if there is one.
+    String osPath;
+    if (m_fileSystem == OSFileSystem::getLoadSingleton() ||
+        m_fileSystem == OSFileSystem::getExtSingleton() ||
+        m_fileSystem == OSFileSystem::getMutableSingleton())
+    {
+        osPath = path;
+    }
+    else if (m_fileSystemExt && m_osPathKind != OSPathKind::None)
+    {
+        ComPtr<ISlangBlob> osPathBlob;
+        SLANG_RETURN_ON_FAIL(m_fileSystemExt->getPath(
+            PathKind::OperatingSystem,
+            path.getBuffer(),
+            osPathBlob.writeRef()));
+        osPath = StringUtil::getString(osPathBlob);
+    }
+    else
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    uint64_t modifiedTime = 0;
+    uint64_t size = 0;
+    SLANG_RETURN_ON_FAIL(File::getModifiedTimeAndSize(osPath, modifiedTime, size));
+
+    // A file modified this recently could be modified again, to the same size, without its
+    // modification time changing, so its content has to be hashed.
+    if (File::isModifiedTimeRecent(modifiedTime))
+        return SLANG_E_NOT_AVAILABLE;
+
+    DigestBuilder<SHA1> builder;
+    builder.append(toSlice("file-digest"));
+    builder.append(Path::simplify(osPath));
+    builder.append(modifiedTime);
+    builder.append(size);
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
 CacheFileSystem::PathInfo* CacheFileSystem::_resolveUniqueIdentityCacheInfo(const String& path)
 {
     // Use the path to produce uniqueIdentity information
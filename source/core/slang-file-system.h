@@ -3,6 +3,7 @@
 
 #include "../core/slang-blob.h"
 #include "../core/slang-dictionary.h"
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-string-util.h"
 #include "slang-com-helper.h"
 #include "slang-com-ptr.h"
@@ -197,6 +198,13 @@ public:
     /// Get the path style
     PathStyle getPathStyle() const { return m_pathStyle; }
 
+    /// Set a persistent cache of content digests, used by the `Hash` unique identity modes.
+    /// A file that maps to the operating system file system is only loaded and hashed when
+    /// its path, modification time and size don't match an entry from a previous session.
+    void setDigestCache(PersistentCache* digestCache) { m_digestCache = digestCache; }
+    /// Get the digest cache. Can be nullptr.
+    PersistentCache* getDigestCache() const { return m_digestCache; }
+
     /// Set the inner file system
     void setInnerFileSystem(
         ISlangFileSystem* fileSystem,
@@ -234,6 +242,11 @@ protected:
         String& outUniqueIdentity,
         ComPtr<ISlangBlob>& outFileContents);
 
+    /// Calculate the key for `path` in the digest cache from its operating system path,
+    /// modification time and size. Fails if the path doesn't map to an operating system file,
+    /// or if the file was modified too recently for its modification time to identify it.
+    SlangResult _calcDigestCacheKey(const String& path, PersistentCache::Key& outKey);
+
     /// For a given path gets a PathInfo. Can return nullptr, if it is not possible to create the
     /// PathInfo for some reason
     PathInfo* _resolvePathCacheInfo(const String& path);
@@ -266,6 +279,8 @@ protected:
                          ///< emulate all the other methods of ISlangFileSystemExt
 
     OSPathKind m_osPathKind = OSPathKind::None; ///< OS path kind
+
+    RefPtr<PersistentCache> m_digestCache; ///< Optional cache of content digests across sessions
 };
 
 class RelativeFileSystem : public ComBaseObject, public ISlangMutableFileSystem
@@ -302,6 +302,10 @@ namespace
 { // anonymous
 
 // Handles binary backoff like sleeping mechanism.
+//
+// A round trip on a connection is typically a few milliseconds, so the interval stays at 1ms for
+// a while before backing off. Backing off straight away would add up to the final interval to
+// the latency of every reply that takes longer than a few polls.
 struct SleepState
 {
     void sleep()
@@ -318,10 +322,13 @@ struct SleepState
     {
         const Int maxIntervalInMs = 32;
         const Int initialCountThreshold = 4;
+        const Int shortIntervalCountThreshold = 256;
 
         ++m_count;
 
-        const Int countThreshold = (m_intervalInMs == 0) ? initialCountThreshold : 1;
+        const Int countThreshold = (m_intervalInMs == 0)   ? initialCountThreshold
+                                   : (m_intervalInMs == 1) ? shortIntervalCountThreshold
+                                                           : 1;
 
         // If we hit the count change the interval
         if (m_count >= countThreshold)
@@ -30,6 +30,7 @@
 #include <fnmatch.h>
 #include <ftw.h> // for nftw
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #endif
 
@@ -65,6 +66,25 @@ namespace Slang
 #endif
 }
 
+/* static */ SlangResult File::rename(const String& fromFileName, const String& toFileName)
+{
+#ifdef _WIN32
+    // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+    if (MoveFileExW(fromFileName.toWString(), toFileName.toWString(), MOVEFILE_REPLACE_EXISTING))
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#else
+    // https://man7.org/linux/man-pages/man2/rename.2.html
+    if (::rename(fromFileName.getBuffer(), toFileName.getBuffer()) == 0)
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#endif
+}
+
 
 #ifdef _WIN32
 /* static */ SlangResult File::generateTemporary(
@@ -194,6 +214,58 @@ bool File::exists(const String& fileName)
 #endif
 }
 
+/* static */ SlangResult File::getModifiedTimeAndSize(
+    const String& fileName,
+    uint64_t& outModifiedTime,
+    uint64_t& outSize)
+{
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(fileName.toWString(), GetFileExInfoStandard, &data) ||
+        (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    outModifiedTime =
+        (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+    outSize = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    return SLANG_OK;
+#else
+    struct stat statVar;
+    if (::stat(fileName.getBuffer(), &statVar) != 0 || !S_ISREG(statVar.st_mode))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+#if SLANG_APPLE_FAMILY
+    const struct timespec& modified = statVar.st_mtimespec;
+#else
+    const struct timespec& modified = statVar.st_mtim;
+#endif
+    outModifiedTime = uint64_t(modified.tv_sec) * 1000000000ull + uint64_t(modified.tv_nsec);
+    outSize = uint64_t(statVar.st_size);
+    return SLANG_OK;
+#endif
+}
+
+/* static */ bool File::isModifiedTimeRecent(uint64_t modifiedTime)
+{
+#ifdef _WIN32
+    // File times count 100 nanosecond intervals.
+    const uint64_t resolution = 2ull * 10000000ull;
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    const uint64_t currentTime = (uint64_t(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+#else
+    const uint64_t resolution = 2ull * 1000000000ull;
+    struct timespec now;
+    if (clock_gettime(CLOCK_REALTIME, &now) != 0)
+        return true;
+    const uint64_t currentTime = uint64_t(now.tv_sec) * 1000000000ull + uint64_t(now.tv_nsec);
+#endif
+    // A time in the future, from a clock that was changed, is treated as recent too.
+    return modifiedTime + resolution > currentTime;
+}
+
 String Path::replaceExt(const String& path, const char* newExt)
 {
     StringBuilder sb(path.getLength() + 10);
@@ -1119,6 +1191,145 @@ SlangResult File::readAllText(const Slang::String& fileName, String& outText)
     return SLANG_OK;
 }
 
+namespace
+{ // anonymous
+
+/// A blob over a read-only memory mapping of a whole file.
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_sizeInBytes; }
+
+    MappedFileBlob(void* data, size_t sizeInBytes)
+        : m_data(data), m_sizeInBytes(sizeInBytes)
+    {
+    }
+
+    ~MappedFileBlob()
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        ::munmap(m_data, m_sizeInBytes);
+#endif
+    }
+
+protected:
+    void* m_data;
+    size_t m_sizeInBytes;
+};
+
+/// Try to map all of `fileName` read-only into memory.
+///
+/// Files smaller than `minSizeInBytes` are not mapped. If `requireTerminator` is set the
+/// file is only mapped if its size isn't a multiple of the page size, so the zero fill at
+/// the end of the last page follows the contents as a terminator.
+bool _tryMapAllBytes(
+    const String& fileName,
+    size_t minSizeInBytes,
+    bool requireTerminator,
+    ComPtr<ISlangBlob>& outBlob)
+{
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    const UInt64 pageSize = systemInfo.dwPageSize;
+
+    HANDLE file = CreateFileW(
+        fileName.toWString(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    void* data = nullptr;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 &&
+        UInt64(fileSize.QuadPart) >= minSizeInBytes &&
+        UInt64(fileSize.QuadPart) <= UInt64(~size_t(0)) &&
+        !(requireTerminator && (UInt64(fileSize.QuadPart) % pageSize) == 0))
+    {
+        // The view keeps the mapping alive, so the handles can be closed straight away.
+        if (HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if (!data)
+        return false;
+
+    outBlob = ComPtr<ISlangBlob>(new MappedFileBlob(data, size_t(fileSize.QuadPart)));
+    return true;
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+    const UInt64 pageSize = UInt64(::sysconf(_SC_PAGESIZE));
+
+    const int fd = ::open(fileName.getBuffer(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    void* data = MAP_FAILED;
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 &&
+        UInt64(fileStat.st_size) >= minSizeInBytes &&
+        UInt64(fileStat.st_size) <= UInt64(~size_t(0)) &&
+        !(requireTerminator && (UInt64(fileStat.st_size) % pageSize) == 0))
+    {
+        data = ::mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping holds its own reference to the file.
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    outBlob = ComPtr<ISlangBlob>(new MappedFileBlob(data, size_t(fileStat.st_size)));
+    return true;
+#else
+    SLANG_UNUSED(fileName);
+    SLANG_UNUSED(minSizeInBytes);
+    SLANG_UNUSED(requireTerminator);
+    SLANG_UNUSED(outBlob);
+    return false;
+#endif
+}
+
+} // namespace
+
+/* static */ SlangResult File::mapAllBytes(const String& fileName, ComPtr<ISlangBlob>& outBlob)
+{
+    if (_tryMapAllBytes(fileName, 0, false, outBlob))
+        return SLANG_OK;
+
+    // Mapping isn't available (or the file is empty), so just read it in
+    ScopedAllocation contents;
+    SLANG_RETURN_ON_FAIL(readAllBytes(fileName, contents));
+    outBlob = RawBlob::moveCreate(contents);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult File::loadAllBytes(
+    const String& fileName,
+    size_t minMappedSizeInBytes,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    if (_tryMapAllBytes(fileName, minMappedSizeInBytes, true, outBlob))
+        return SLANG_OK;
+
+    ScopedAllocation contents;
+    SLANG_RETURN_ON_FAIL(readAllBytes(fileName, contents));
+    outBlob = RawBlob::moveCreate(contents);
+    return SLANG_OK;
+}
+
 SlangResult File::readAllBytes(const Slang::String& path, Slang::List<unsigned char>& out)
 {
     FileStream stream;
@@ -14,11 +14,39 @@ class File
 public:
     static bool exists(const String& fileName);
 
+    /// Get the time a file was last modified and its size in bytes. The time is only
+    /// meaningful when compared with another time from the same file system.
+    static SlangResult getModifiedTimeAndSize(
+        const String& fileName,
+        uint64_t& outModifiedTime,
+        uint64_t& outSize);
+
+    /// Was `modifiedTime`, as returned by `getModifiedTimeAndSize`, so recent that the file
+    /// could be changed again without its modification time changing? File systems record
+    /// modification times with a limited resolution, as coarse as two seconds.
+    static bool isModifiedTimeRecent(uint64_t modifiedTime);
+
     static SlangResult readAllText(const String& fileName, String& outString);
 
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
     static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
 
+    /// Map the contents of a file read-only into memory, without copying.
+    /// Pages are only faulted in as they are touched, and the mapping lives as long as the blob.
+    /// Falls back to reading the whole file if mapping is not available on the platform.
+    /// NOTE! The file should not be truncated or rewritten in place while mapped - replace it
+    /// with `rename` instead.
+    static SlangResult mapAllBytes(const String& fileName, ComPtr<ISlangBlob>& outBlob);
+
+    /// Load the contents of a file into a blob whose contents are followed by a zero byte,
+    /// as with `readAllBytes` into a `ScopedAllocation`. Files of at least
+    /// `minMappedSizeInBytes` are mapped as with `mapAllBytes` when the zero fill of the last
+    /// page can provide the terminator, and read otherwise.
+    static SlangResult loadAllBytes(
+        const String& fileName,
+        size_t minMappedSizeInBytes,
+        ComPtr<ISlangBlob>& outBlob);
+
     static SlangResult writeAllText(const String& fileName, const String& text);
 
     static SlangResult writeAllTextIfChanged(const String& fileName, UnownedStringSlice text);
@@ -30,6 +58,9 @@ public:
 
     static SlangResult remove(const String& fileName);
 
+    /// Rename a file, replacing `toFileName` if it already exists.
+    static SlangResult rename(const String& fromFileName, const String& toFileName);
+
     static SlangResult makeExecutable(const String& fileName);
 
     /// Creates a temporary file typically in some way based on the prefix
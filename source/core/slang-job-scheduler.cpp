@@ -0,0 +1,183 @@
+#include "slang-job-scheduler.h"
+
+#if SLANG_WASM && !defined(__EMSCRIPTEN_PTHREADS__)
+#define SLANG_JOB_SCHEDULER_HAS_THREADS 0
+#else
+#define SLANG_JOB_SCHEDULER_HAS_THREADS 1
+#endif
+
+namespace Slang
+{
+
+JobScheduler::JobScheduler(Count threadCount)
+    : m_pool(std::make_shared<Pool>())
+{
+#if SLANG_JOB_SCHEDULER_HAS_THREADS
+    if (threadCount <= 0)
+        threadCount = Count(std::thread::hardware_concurrency());
+    m_threadCount = threadCount > 0 ? threadCount : 1;
+#else
+    SLANG_UNUSED(threadCount);
+    m_threadCount = 1;
+#endif
+}
+
+JobScheduler::~JobScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        m_pool->shutdown = true;
+    }
+    m_pool->workAvailable.notify_all();
+    for (auto& worker : m_workers)
+    {
+        // A job that releases the last reference to the scheduler does so on a worker,
+        // which can't join itself. It finishes the remaining jobs and exits on its own.
+        if (worker.get_id() == std::this_thread::get_id())
+            worker.detach();
+        else
+            worker.join();
+    }
+}
+
+ISlangUnknown* JobScheduler::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangJobScheduler::getTypeGuid())
+        return static_cast<ISlangJobScheduler*>(this);
+    return nullptr;
+}
+
+void JobScheduler::runJobs(
+    SlangInt jobCount,
+    SlangInt maxConcurrency,
+    SlangJobFunc func,
+    void* userData)
+{
+    if (jobCount <= 0)
+        return;
+
+    // There is nothing to gain from publishing a batch that only one thread may work on.
+    if (jobCount == 1 || maxConcurrency == 1 || m_threadCount == 1)
+    {
+        for (Index ii = 0; ii < jobCount; ++ii)
+            func(userData, ii);
+        return;
+    }
+
+    Batch batch;
+    batch.func = func;
+    batch.userData = userData;
+    batch.jobCount = jobCount;
+    batch.maxConcurrency = maxConcurrency;
+
+    // The calling thread is the first runner of its own batch.
+    batch.runnerCount = 1;
+    _publishBatch(&batch);
+
+    m_pool->runBatch(&batch);
+
+    // A runner only stops after the last job index has been handed out and its own job has
+    // finished, so once there are no runners left every job of the batch is done.
+    std::unique_lock<std::mutex> lock(m_pool->mutex);
+    m_pool->batchFinished.wait(lock, [&]() { return batch.runnerCount == 0; });
+    m_pool->batches.remove(&batch);
+}
+
+void JobScheduler::submitJob(SlangJobFunc func, void* userData)
+{
+#if SLANG_JOB_SCHEDULER_HAS_THREADS
+    auto batch = new Batch();
+    batch->func = func;
+    batch->userData = userData;
+    batch->jobCount = 1;
+    batch->isDetached = true;
+    _publishBatch(batch);
+#else
+    // There is no worker to hand the job to, so it runs before returning.
+    func(userData, 0);
+#endif
+}
+
+void JobScheduler::_publishBatch(Batch* batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        if (m_workers.empty())
+        {
+            // The thread that calls `runJobs` works too, so it is one of the threads counted,
+            // but a submitted job needs a worker even if that leaves none for batches.
+            const Count workerCount = m_threadCount > 1 ? m_threadCount - 1 : 1;
+            for (Index ii = 0; ii < workerCount; ++ii)
+                m_workers.emplace_back([pool = m_pool]() { pool->workerMain(); });
+        }
+        m_pool->batches.add(batch);
+    }
+    m_pool->workAvailable.notify_all();
+}
+
+JobScheduler::Batch* JobScheduler::Pool::findBatch()
+{
+    for (auto batch : batches)
+    {
+        if (batch->nextJobIndex.load() >= batch->jobCount)
+            continue;
+        if (batch->maxConcurrency > 0 && batch->runnerCount >= batch->maxConcurrency)
+            continue;
+        return batch;
+    }
+    return nullptr;
+}
+
+void JobScheduler::Pool::runBatch(Batch* batch)
+{
+    for (;;)
+    {
+        const Index jobIndex = batch->nextJobIndex++;
+        if (jobIndex >= batch->jobCount)
+            break;
+        batch->func(batch->userData, jobIndex);
+    }
+
+    // Once the lock is released the thread waiting in `runJobs` may destroy the batch, so it
+    // must not be touched after that unless nobody is waiting for it.
+    bool isFinishedDetachedBatch = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch->runnerCount--;
+        if (batch->isDetached && batch->runnerCount == 0)
+        {
+            batches.remove(batch);
+            isFinishedDetachedBatch = true;
+        }
+    }
+    if (isFinishedDetachedBatch)
+        delete batch;
+    else
+        batchFinished.notify_all();
+}
+
+void JobScheduler::Pool::workerMain()
+{
+    for (;;)
+    {
+        Batch* batch = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // Jobs that are still published when the scheduler shuts down are run first.
+            workAvailable.wait(
+                lock,
+                [&]()
+                {
+                    batch = findBatch();
+                    return batch != nullptr || shutdown;
+                });
+            if (!batch)
+                return;
+            batch->runnerCount++;
+        }
+        runBatch(batch);
+    }
+}
+
+} // namespace Slang
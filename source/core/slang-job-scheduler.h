@@ -0,0 +1,121 @@
+#ifndef SLANG_CORE_JOB_SCHEDULER_H
+#define SLANG_CORE_JOB_SCHEDULER_H
+
+#include "../core/slang-com-object.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang-list.h"
+#include "slang.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Slang
+{
+
+/// The built-in `ISlangJobScheduler`: a fixed-size pool of worker threads.
+///
+/// A batch passed to `runJobs` is published to all workers, and every thread working on a
+/// batch, including the thread that called `runJobs`, repeatedly takes the next job index
+/// that nobody has taken yet. Idle workers therefore take work from whichever batch still
+/// has jobs left, and since the caller works through its own batch a job may itself run a
+/// batch without the risk of deadlock. A job passed to `submitJob` is a batch of one job
+/// that no caller waits for.
+///
+/// The worker threads are only started when a batch first needs them. On a WebAssembly build
+/// without pthreads there are no threads to start, so everything runs on the calling thread.
+class JobScheduler : public ComBaseObject, public ISlangJobScheduler
+{
+public:
+    // ISlangUnknown
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ISlangJobScheduler
+    SLANG_NO_THROW SlangInt SLANG_MCALL getThreadCount() SLANG_OVERRIDE { return m_threadCount; }
+    SLANG_NO_THROW void SLANG_MCALL runJobs(
+        SlangInt jobCount,
+        SlangInt maxConcurrency,
+        SlangJobFunc func,
+        void* userData) SLANG_OVERRIDE;
+    SLANG_NO_THROW void SLANG_MCALL submitJob(SlangJobFunc func, void* userData) SLANG_OVERRIDE;
+
+    /// Create a scheduler that runs up to `threadCount` jobs at the same time, counting the
+    /// thread that calls `runJobs`. A count of 0 means one per hardware thread.
+    explicit JobScheduler(Count threadCount);
+
+    /// Runs the jobs that were submitted but haven't run yet before returning.
+    ~JobScheduler();
+
+protected:
+    struct Batch
+    {
+        SlangJobFunc func = nullptr;
+        void* userData = nullptr;
+        Index jobCount = 0;
+        Count maxConcurrency = 0;
+
+        /// The next job index to hand out.
+        std::atomic<Index> nextJobIndex{0};
+
+        /// The number of threads working on the batch, guarded by `Pool::mutex`.
+        Count runnerCount = 0;
+
+        /// Set for a batch from `submitJob`, which its last runner deletes.
+        bool isDetached = false;
+    };
+
+    /// The state shared with the worker threads.
+    ///
+    /// The last reference to the scheduler may be released by one of its own jobs, so the
+    /// workers keep this state alive for as long as they run rather than relying on the
+    /// scheduler object.
+    struct Pool
+    {
+        /// Find a published batch that still has jobs to hand out and room for another
+        /// runner. Must be called with `mutex` locked.
+        Batch* findBatch();
+        /// Run jobs of `batch` until none are left, then stop being one of its runners.
+        void runBatch(Batch* batch);
+        void workerMain();
+
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable batchFinished;
+        List<Batch*> batches;
+        bool shutdown = false;
+    };
+
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    /// Publish `batch` to the workers, starting them if needed.
+    void _publishBatch(Batch* batch);
+
+    Count m_threadCount = 1;
+
+    std::shared_ptr<Pool> m_pool;
+    std::vector<std::thread> m_workers;
+};
+
+namespace detail
+{
+template<typename F>
+struct JobFuncAdapter
+{
+    static void invoke(void* userData, SlangInt jobIndex) { (*(F*)userData)(Index(jobIndex)); }
+};
+} // namespace detail
+
+/// Run `func(jobIndex)` for each of `jobCount` jobs on `scheduler`, with at most
+/// `maxConcurrency` of them (or any number, for 0) running at the same time.
+template<typename F>
+void runJobs(ISlangJobScheduler* scheduler, Count jobCount, Count maxConcurrency, F& func)
+{
+    scheduler->runJobs(jobCount, maxConcurrency, &detail::JobFuncAdapter<F>::invoke, &func);
+}
+
+} // namespace Slang
+
+#endif
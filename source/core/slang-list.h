@@ -10,9 +10,45 @@
 #include <new>
 #include <type_traits>
 
+// Build with SLANG_LIST_GROWTH_STATS=1 to count the buffers that all `List`s allocate. See
+// `ListGrowthStats`.
+#ifndef SLANG_LIST_GROWTH_STATS
+#define SLANG_LIST_GROWTH_STATS 0
+#endif
+
+#if SLANG_LIST_GROWTH_STATS
+#include <atomic>
+#endif
 
 namespace Slang
 {
+#if SLANG_LIST_GROWTH_STATS
+// Totals over the buffer allocations of all `List`s in the process. A `grownCount` close to
+// `allocatedCount` points at lists that are built one `add` at a time without a `reserve`, or
+// that are rebuilt from scratch where a pooled list could be reused.
+struct ListGrowthStats
+{
+    std::atomic<uint64_t> allocatedCount{0};     ///< Buffers allocated
+    std::atomic<uint64_t> allocatedByteCount{0}; ///< Total size of the allocated buffers
+    std::atomic<uint64_t> grownCount{0};         ///< Allocations that replaced a non-empty buffer
+    std::atomic<uint64_t> movedByteCount{0};     ///< Bytes moved out of replaced buffers
+
+    static ListGrowthStats& get()
+    {
+        static ListGrowthStats stats;
+        return stats;
+    }
+
+    void reset()
+    {
+        allocatedCount = 0;
+        allocatedByteCount = 0;
+        grownCount = 0;
+        movedByteCount = 0;
+    }
+};
+#endif
+
 // List is container of values of a type held consecutively in memory (much like std::vector)
 //
 // Note that in this implementation, the underlying memory is backed via an allocation of
@@ -241,6 +277,7 @@ public:
                 newBufferCount = newBufferCount << 1;
 
             T* newBuffer = _allocate(newBufferCount);
+            _noteAllocation(newBufferCount, m_capacity ? m_count : 0);
             if (m_capacity)
             {
                 /*if (std::has_trivial_copy_assign<T>::value &&
@@ -370,6 +407,7 @@ public:
         if (UIndex(size) > UIndex(m_capacity))
         {
             T* newBuffer = _allocate(size);
+            _noteAllocation(size, m_capacity ? m_count : 0);
             if (m_capacity)
             {
                 /*if (std::has_trivial_copy_assign<T>::value &&
@@ -428,6 +466,7 @@ public:
         if (m_capacity > m_count && m_count > 0)
         {
             T* newBuffer = _allocate(m_count);
+            _noteAllocation(m_count, m_count);
             // For trivially-constructible T, _allocate returns raw malloc'd
             // memory; use placement-new to construct objects. For non-trivially-
             // constructible T, allocateArray already default-constructed every
@@ -653,6 +692,22 @@ private:
     {
         return AllocateMethod<T, TAllocator>::allocateArray(count);
     }
+    static void _noteAllocation(Index count, Index movedCount)
+    {
+#if SLANG_LIST_GROWTH_STATS
+        auto& stats = ListGrowthStats::get();
+        stats.allocatedCount++;
+        stats.allocatedByteCount += uint64_t(count) * sizeof(T);
+        if (movedCount)
+        {
+            stats.grownCount++;
+            stats.movedByteCount += uint64_t(movedCount) * sizeof(T);
+        }
+#else
+        SLANG_UNUSED(count);
+        SLANG_UNUSED(movedCount);
+#endif
+    }
     static void _free(T* buffer, Index count)
     {
         return AllocateMethod<T, TAllocator>::deallocateArray(buffer, count);
@@ -83,8 +83,10 @@ SlangResult LZ4CompressionSystemImpl::decompress(
         (char*)outDecompressed,
         int(compressedSizeInBytes),
         int(decompressedSizeInBytes));
-    SLANG_UNUSED(decompressedSize);
-    SLANG_ASSERT(size_t(decompressedSize) == decompressedSizeInBytes);
+    if (decompressedSize < 0 || size_t(decompressedSize) != decompressedSizeInBytes)
+    {
+        return SLANG_FAIL;
+    }
     return SLANG_OK;
 }
 
@@ -1,9 +1,45 @@
 
 #include "slang-memory-arena.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
+static std::atomic<size_t> g_totalMemoryAllocated[size_t(MemoryArenaCategory::CountOf)];
+
+/* static */ size_t MemoryArena::getTotalMemoryAllocated(MemoryArenaCategory category)
+{
+    return g_totalMemoryAllocated[size_t(category)].load(std::memory_order_relaxed);
+}
+
+void MemoryArena::_addAllocatedBytes(size_t sizeInBytes)
+{
+    g_totalMemoryAllocated[size_t(m_category)].fetch_add(sizeInBytes, std::memory_order_relaxed);
+}
+
+void MemoryArena::_removeAllocatedBytes(size_t sizeInBytes)
+{
+    g_totalMemoryAllocated[size_t(m_category)].fetch_sub(sizeInBytes, std::memory_order_relaxed);
+}
+
+void MemoryArena::setCategory(MemoryArenaCategory category)
+{
+    if (category == m_category)
+        return;
+
+    const size_t allocated = calcTotalMemoryAllocated();
+    _removeAllocatedBytes(allocated);
+    m_category = category;
+    _addAllocatedBytes(allocated);
+}
+
+void MemoryArena::_freeBlockMemory(Block* block)
+{
+    _removeAllocatedBytes(size_t(block->m_end - block->m_alloc));
+    ::free(block->m_alloc);
+}
+
 MemoryArena::MemoryArena()
 {
     // Mark as invalid so any alloc call will fail
@@ -67,6 +103,17 @@ void MemoryArena::_initialize(size_t blockPayloadSize, size_t alignment)
 
 void MemoryArena::swapWith(ThisType& rhs)
 {
+    // The categories stay with the arenas, so the memory being swapped moves between them.
+    if (m_category != rhs.m_category)
+    {
+        const size_t allocated = calcTotalMemoryAllocated();
+        const size_t rhsAllocated = rhs.calcTotalMemoryAllocated();
+        _removeAllocatedBytes(allocated);
+        rhs._removeAllocatedBytes(rhsAllocated);
+        _addAllocatedBytes(rhsAllocated);
+        rhs._addAllocatedBytes(allocated);
+    }
+
     Swap(m_start, rhs.m_start);
     Swap(m_end, rhs.m_end);
     Swap(m_current, rhs.m_current);
@@ -118,7 +165,7 @@ void MemoryArena::_deallocateBlocksPayload(Block* start)
     while (cur)
     {
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockMemory(cur);
         cur = cur->m_next;
     }
 }
@@ -130,7 +177,7 @@ void MemoryArena::_deallocateBlocks(Block* start)
     {
         Block* next = cur->m_next;
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockMemory(cur);
 
         m_blockFreeList.deallocate(cur);
         cur = next;
@@ -157,7 +204,7 @@ void MemoryArena::_deallocateBlock(Block* block)
     else
     {
         // Must be odd sized so free it
-        ::free(block->m_alloc);
+        _freeBlockMemory(block);
         // Free it in the block list
         m_blockFreeList.deallocate(block);
     }
@@ -276,6 +323,7 @@ MemoryArena::Block* MemoryArena::_newBlock(size_t allocSize, size_t alignment)
     block->m_end = alloc + allocSize;
     block->m_next = nullptr;
 
+    _addAllocatedBytes(allocSize);
     return block;
 }
 
@@ -301,6 +349,9 @@ void MemoryArena::addExternalBlock(void* inData, size_t size)
     block->m_end = alloc + size;
     block->m_next = nullptr;
 
+    // The arena frees the block along with its own, so it counts as held by the arena.
+    _addAllocatedBytes(size);
+
     // We don't want to place at start, if there is any used blocks - as that is the one
     // that is being split from and can be rewound. So we place just behind in that case
     if (m_usedBlocks)
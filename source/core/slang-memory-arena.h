@@ -11,6 +11,17 @@
 namespace Slang
 {
 
+/// What the blocks of a memory arena hold. The bytes held by all the arenas of each category
+/// in the process are tracked, so that it is possible to tell where memory is going.
+enum class MemoryArenaCategory
+{
+    Other,
+    AST,
+    IR,
+    StringPool,
+    CountOf,
+};
+
 /** MemoryArena provides provides very fast allocation of small blocks, by aggregating many small
 allocations over smaller amount of larger blocks. A typical small unaligned allocation is a pointer
 bump.
@@ -154,6 +165,15 @@ public:
     /// Total memory allocated in bytes
     size_t calcTotalMemoryAllocated() const;
 
+    /// Set what this arena holds. Memory the arena has already allocated moves to the new
+    /// category.
+    void setCategory(MemoryArenaCategory category);
+    MemoryArenaCategory getCategory() const { return m_category; }
+
+    /// The bytes held by all the arenas of `category` in the process. Safe to call from any
+    /// thread.
+    static size_t getTotalMemoryAllocated(MemoryArenaCategory category);
+
     /// Get the current allocation cursor (memory address where subsequent allocations will be
     /// placed if space within the current block) The address of an allocated block can be used as a
     /// cursor to rewind to, such that it and all subsequent allocations will be deallocated
@@ -197,6 +217,12 @@ protected:
 
     void _deallocateBlock(Block* block);
 
+    /// Free the backing memory of a block (but not the block itself)
+    void _freeBlockMemory(Block* block);
+    /// Update the tracked total for this arena's category
+    void _addAllocatedBytes(size_t sizeInBytes);
+    void _removeAllocatedBytes(size_t sizeInBytes);
+
     /// Create a new block with regular block alignment
     Block* _newNormalBlock();
     /// Allocates a new block with allocSize and alignment
@@ -238,6 +264,8 @@ protected:
 
     FreeList m_blockFreeList; ///< Holds all of the blocks for fast allocation/free
 
+    MemoryArenaCategory m_category = MemoryArenaCategory::Other;
+
 private:
     // Disable
     MemoryArena(const ThisType& rhs) = delete;
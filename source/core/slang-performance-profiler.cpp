@@ -1,13 +1,69 @@
 #include "slang-performance-profiler.h"
 
 #include "slang-dictionary.h"
+#include "slang-math.h"
+
+#include <atomic>
 
 namespace Slang
 {
+void PassStatistics::add(PassStatisticsInfo const& info)
+{
+    Index index;
+    if (!m_passIndices.tryGetValue(UnownedStringSlice(info.passName), index))
+    {
+        index = m_passes.getCount();
+        m_passIndices.add(UnownedStringSlice(info.passName), index);
+
+        PassStatisticsInfo pass;
+        pass.passName = info.passName;
+        m_passes.add(pass);
+    }
+
+    auto& pass = m_passes[index];
+    pass.invocationCount += info.invocationCount;
+    pass.duration += info.duration;
+    pass.instsCreated += info.instsCreated;
+    pass.instsDestroyed += info.instsDestroyed;
+    pass.arenaBytesGrown += info.arenaBytesGrown;
+}
+
+void PassStatistics::addRange(PassStatistics const& other)
+{
+    for (auto const& info : other.m_passes)
+        add(info);
+}
+
+void PassStatistics::clear()
+{
+    m_passes.clear();
+    m_passIndices.clear();
+}
+
 class PerformanceProfilerImpl : public PerformanceProfiler
 {
 public:
     OrderedDictionary<const char*, FuncProfileInfo> data;
+    PassStatistics passStatistics;
+    List<PhaseInvocationInfo> phaseInvocations;
+
+    struct ActivePhase
+    {
+        Index phaseIndex;
+        std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+        std::chrono::nanoseconds childDuration;
+    };
+    List<ActivePhase> activePhases;
+
+    List<TraceEventInfo> traceEvents;
+    bool tracing = false;
+    uint32_t threadId;
+
+    PerformanceProfilerImpl()
+    {
+        static std::atomic<uint32_t> nextThreadId = 0;
+        threadId = nextThreadId++;
+    }
 
     virtual FuncProfileContext enterFunction(const char* funcName) override
     {
@@ -29,6 +85,9 @@ public:
         auto duration = endTime - ctx.startTime;
         auto entry = data.tryGetValue(ctx.funcName);
         entry->duration += duration;
+
+        if (tracing)
+            addTraceEvent("function", ctx.funcName, String(), ctx.startTime, endTime);
     }
     virtual void getResult(StringBuilder& out) override
     {
@@ -64,11 +123,166 @@ public:
 
             out << buffer;
         }
+
+        _getPhaseResult(out);
     }
 
+    // Phases are summed per phase and module, in the order they were first entered,
+    // and indented by how deeply they were nested at that point.
+    void _getPhaseResult(StringBuilder& out)
+    {
+        struct PhaseTotal
+        {
+            const char* phaseName;
+            String moduleName;
+            Index depth;
+            int invocationCount;
+            std::chrono::nanoseconds duration;
+            std::chrono::nanoseconds selfDuration;
+        };
+        List<PhaseTotal> totals;
+        for (const auto& phase : phaseInvocations)
+        {
+            PhaseTotal* total = nullptr;
+            for (auto& existing : totals)
+            {
+                if (strcmp(existing.phaseName, phase.phaseName) == 0 &&
+                    existing.moduleName == phase.moduleName)
+                {
+                    total = &existing;
+                    break;
+                }
+            }
+            if (!total)
+            {
+                totals.add(PhaseTotal{
+                    phase.phaseName,
+                    phase.moduleName,
+                    phase.depth,
+                    0,
+                    std::chrono::nanoseconds::zero(),
+                    std::chrono::nanoseconds::zero()});
+                total = &totals.getLast();
+            }
+            total->invocationCount++;
+            total->duration += phase.duration;
+            total->selfDuration += phase.selfDuration;
+        }
+
+        if (totals.getCount() == 0)
+            return;
+
+        out << "\nPhases:\n";
+        auto toMilliseconds = [](std::chrono::nanoseconds duration)
+        {
+            auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+            return microseconds.count() / 1000.0;
+        };
+
+        char buffer[512];
+        for (const auto& total : totals)
+        {
+            snprintf(
+                buffer,
+                sizeof(buffer),
+                "[*] %*s%-*s %-30s \t%d \t%8.2fms \t%8.2fms self\n",
+                int(total.depth * 2),
+                "",
+                int(Math::Max(Index(0), 12 - total.depth * 2)),
+                total.phaseName,
+                total.moduleName.getBuffer(),
+                total.invocationCount,
+                toMilliseconds(total.duration),
+                toMilliseconds(total.selfDuration));
+            out << buffer;
+        }
+    }
 
-    virtual void clear() override { data.clear(); }
-    virtual void dispose() override { data = decltype(data)(); }
+
+    virtual PassStatistics& getPassStatistics() override { return passStatistics; }
+
+    virtual Index enterPhase(const char* phaseName, String const& moduleName) override
+    {
+        PhaseInvocationInfo info;
+        info.phaseName = phaseName;
+        info.moduleName = moduleName;
+        info.depth = activePhases.getCount();
+
+        const Index phaseIndex = phaseInvocations.getCount();
+        phaseInvocations.add(info);
+
+        ActivePhase active;
+        active.phaseIndex = phaseIndex;
+        active.childDuration = std::chrono::nanoseconds::zero();
+        active.startTime = std::chrono::high_resolution_clock::now();
+        activePhases.add(active);
+        return phaseIndex;
+    }
+    virtual void exitPhase(Index phaseIndex) override
+    {
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        // The profile may have been cleared while the phase was running, in which case
+        // there is nothing left to record it in.
+        if (activePhases.getCount() == 0 || activePhases.getLast().phaseIndex != phaseIndex)
+            return;
+
+        auto active = activePhases.getLast();
+        activePhases.removeLast();
+
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            endTime - active.startTime);
+        auto& info = phaseInvocations[phaseIndex];
+        info.duration = duration;
+        info.selfDuration = duration - active.childDuration;
+
+        if (activePhases.getCount())
+            activePhases.getLast().childDuration += duration;
+
+        if (tracing)
+            addTraceEvent("phase", info.phaseName, info.moduleName, active.startTime, endTime);
+    }
+    virtual List<PhaseInvocationInfo>& getPhaseInvocations() override { return phaseInvocations; }
+
+    virtual bool isTracing() override { return tracing; }
+    virtual void setTracing(bool value) override { tracing = value; }
+    virtual void addTraceEvent(
+        const char* category,
+        const char* name,
+        String const& detail,
+        std::chrono::time_point<std::chrono::high_resolution_clock> startTime,
+        std::chrono::time_point<std::chrono::high_resolution_clock> endTime) override
+    {
+        if (!tracing)
+            return;
+
+        TraceEventInfo event;
+        event.category = category;
+        event.name = name;
+        event.detail = detail;
+        event.threadId = threadId;
+        event.startTime = startTime;
+        event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+        traceEvents.add(event);
+    }
+    virtual List<TraceEventInfo>& getTraceEvents() override { return traceEvents; }
+
+    virtual void clear() override
+    {
+        data.clear();
+        passStatistics.clear();
+        phaseInvocations.clear();
+        activePhases.clear();
+        traceEvents.clear();
+    }
+    virtual void dispose() override
+    {
+        data = decltype(data)();
+        passStatistics = decltype(passStatistics)();
+        phaseInvocations = decltype(phaseInvocations)();
+        activePhases = decltype(activePhases)();
+        traceEvents = decltype(traceEvents)();
+    }
 };
 
 PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
@@ -100,12 +314,19 @@ SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
         m_profilEntries.insert(index, profileEntry);
         index++;
     }
+
+    m_passStatistics = profilerImpl->passStatistics.getPasses();
+    m_phaseInvocations = profilerImpl->phaseInvocations;
 }
 
 ISlangUnknown* SlangProfiler::getInterface(const Guid& guid)
 {
-    if (guid == SlangProfiler::getTypeGuid())
-        return static_cast<ISlangUnknown*>(this);
+    if (guid == ISlangProfiler::getTypeGuid())
+        return static_cast<ISlangProfiler*>(this);
+    else if (guid == ISlangPassProfiler::getTypeGuid())
+        return static_cast<ISlangPassProfiler*>(this);
+    else if (guid == ISlangPhaseProfiler::getTypeGuid())
+        return static_cast<ISlangPhaseProfiler*>(this);
     else
         return nullptr;
 }
@@ -140,4 +361,47 @@ uint32_t SlangProfiler::getEntryInvocationTimes(uint32_t index)
 
     return m_profilEntries[index].invocationCount;
 }
+
+size_t SlangProfiler::getPassCount()
+{
+    return m_passStatistics.getCount();
+}
+
+SlangResult SlangProfiler::getPassStatistics(uint32_t index, SlangPassStatistics* outStatistics)
+{
+    if (!outStatistics || index >= (uint32_t)m_passStatistics.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    const auto& info = m_passStatistics[index];
+    outStatistics->passName = info.passName;
+    outStatistics->invocationCount = info.invocationCount;
+    outStatistics->durationMicroseconds =
+        (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(info.duration).count();
+    outStatistics->instsCreated = info.instsCreated;
+    outStatistics->instsDestroyed = info.instsDestroyed;
+    outStatistics->arenaBytesGrown = info.arenaBytesGrown;
+    return SLANG_OK;
+}
+
+size_t SlangProfiler::getPhaseInvocationCount()
+{
+    return m_phaseInvocations.getCount();
+}
+
+SlangResult SlangProfiler::getPhaseInvocation(uint32_t index, SlangPhaseStatistics* outStatistics)
+{
+    if (!outStatistics || index >= (uint32_t)m_phaseInvocations.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    const auto& info = m_phaseInvocations[index];
+    outStatistics->phaseName = info.phaseName;
+    outStatistics->moduleName = info.moduleName.getBuffer();
+    outStatistics->depth = uint32_t(info.depth);
+    outStatistics->durationMicroseconds =
+        (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(info.duration).count();
+    outStatistics->selfDurationMicroseconds =
+        (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(info.selfDuration)
+            .count();
+    return SLANG_OK;
+}
 } // namespace Slang
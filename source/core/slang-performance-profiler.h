@@ -1,6 +1,7 @@
 #ifndef SLANG_CORE_PERFORMANCE_PROFILER_H
 #define SLANG_CORE_PERFORMANCE_PROFILER_H
 
+#include "../core/slang-dictionary.h"
 #include "../core/slang-list.h"
 #include "slang-com-helper.h"
 #include "slang-string.h"
@@ -17,6 +18,64 @@ struct FuncProfileInfo
     std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
 };
 
+/// Statistics gathered for the invocations of an IR pass
+struct PassStatisticsInfo
+{
+    /// Name of the pass. Must have static lifetime.
+    const char* passName = nullptr;
+    uint64_t invocationCount = 0;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+    uint64_t instsCreated = 0;
+    uint64_t instsDestroyed = 0;
+    uint64_t arenaBytesGrown = 0;
+};
+
+/// Statistics for each IR pass, in the order the passes first ran. The invocations of a pass
+/// are added up, so there is one entry per pass however often the passes run.
+class PassStatistics
+{
+public:
+    /// Add `info` to the statistics of its pass
+    void add(PassStatisticsInfo const& info);
+    /// Add the statistics of each pass in `other`
+    void addRange(PassStatistics const& other);
+    void clear();
+
+    List<PassStatisticsInfo> const& getPasses() const { return m_passes; }
+
+private:
+    List<PassStatisticsInfo> m_passes;
+    Dictionary<UnownedStringSlice, Index> m_passIndices;
+};
+
+/// Timing for a single invocation of a compiler phase (parse, check, emit, ...) on one module
+struct PhaseInvocationInfo
+{
+    /// Name of the phase. Must have static lifetime.
+    const char* phaseName = nullptr;
+    /// Name of the module, or entry point, the phase ran on
+    String moduleName;
+    /// How many phases enclosed this one when it ran
+    Index depth = 0;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+    /// Duration minus the time spent in nested phases
+    std::chrono::nanoseconds selfDuration = std::chrono::nanoseconds::zero();
+};
+
+/// A span of time recorded for a trace of the compile timeline
+struct TraceEventInfo
+{
+    /// Category and name of the span. Must have static lifetime.
+    const char* category = nullptr;
+    const char* name = nullptr;
+    /// What the span applied to, such as a module name. May be empty.
+    String detail;
+    /// Small integer identifying the thread the span ran on
+    uint32_t threadId = 0;
+    std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+};
+
 struct FuncProfileContext
 {
     const char* funcName = nullptr;
@@ -29,6 +88,27 @@ public:
     virtual FuncProfileContext enterFunction(const char* funcName) = 0;
     virtual void exitFunction(FuncProfileContext context) = 0;
     virtual void getResult(StringBuilder& out) = 0;
+    /// Statistics of the passes run on this thread
+    virtual PassStatistics& getPassStatistics() = 0;
+    /// Start timing a phase nested in any phase already active on this thread.
+    /// Returns the index of its entry in `getPhaseInvocations()`.
+    virtual Index enterPhase(const char* phaseName, String const& moduleName) = 0;
+    /// Finish timing the innermost active phase, which must be `phaseIndex`
+    virtual void exitPhase(Index phaseIndex) = 0;
+    /// Phase invocations in the order they were entered
+    virtual List<PhaseInvocationInfo>& getPhaseInvocations() = 0;
+    /// Whether spans of functions, phases and passes on this thread are recorded as trace events
+    virtual bool isTracing() = 0;
+    virtual void setTracing(bool tracing) = 0;
+    /// Record a span that ran on this thread, if tracing
+    virtual void addTraceEvent(
+        const char* category,
+        const char* name,
+        String const& detail,
+        std::chrono::time_point<std::chrono::high_resolution_clock> startTime,
+        std::chrono::time_point<std::chrono::high_resolution_clock> endTime) = 0;
+    /// Trace events in the order their spans ended
+    virtual List<TraceEventInfo>& getTraceEvents() = 0;
     virtual void clear() = 0;
     virtual void dispose() = 0;
 
@@ -49,7 +129,62 @@ struct PerformanceProfilerFuncRAIIContext
     }
 };
 
-struct SlangProfiler : public ISlangProfiler, public RefObject
+struct PerformanceProfilerPhaseRAIIContext
+{
+    Index phaseIndex = -1;
+    PerformanceProfilerPhaseRAIIContext(
+        bool enabled,
+        const char* phaseName,
+        String const& moduleName)
+    {
+        if (enabled)
+            phaseIndex = PerformanceProfiler::getProfiler()->enterPhase(phaseName, moduleName);
+    }
+    ~PerformanceProfilerPhaseRAIIContext()
+    {
+        if (phaseIndex >= 0)
+            PerformanceProfiler::getProfiler()->exitPhase(phaseIndex);
+    }
+};
+
+struct PerformanceProfilerTraceRAIIContext
+{
+    const char* category;
+    const char* name;
+    String detail;
+    bool tracing;
+    std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    PerformanceProfilerTraceRAIIContext(
+        const char* category,
+        const char* name,
+        String const& detail = String())
+        : category(category), name(name)
+    {
+        tracing = PerformanceProfiler::getProfiler()->isTracing();
+        if (tracing)
+        {
+            this->detail = detail;
+            startTime = std::chrono::high_resolution_clock::now();
+        }
+    }
+    ~PerformanceProfilerTraceRAIIContext()
+    {
+        if (tracing)
+        {
+            PerformanceProfiler::getProfiler()->addTraceEvent(
+                category,
+                name,
+                detail,
+                startTime,
+                std::chrono::high_resolution_clock::now());
+        }
+    }
+};
+
+struct SlangProfiler : public ISlangProfiler,
+                       public ISlangPassProfiler,
+                       public ISlangPhaseProfiler,
+                       public RefObject
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -67,12 +202,28 @@ public:
     virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) override;
     virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) override;
 
+    // ISlangPassProfiler
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getPassCount() override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPassStatistics(uint32_t index, SlangPassStatistics* outStatistics) override;
+
+    // ISlangPhaseProfiler
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getPhaseInvocationCount() override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPhaseInvocation(uint32_t index, SlangPhaseStatistics* outStatistics) override;
+
 private:
     List<ProfileInfo> m_profilEntries;
+    List<PassStatisticsInfo> m_passStatistics;
+    List<PhaseInvocationInfo> m_phaseInvocations;
 };
 
 #define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
 #define SLANG_PROFILE_SECTION(s) PerformanceProfilerFuncRAIIContext _profileContext##s(#s)
+#define SLANG_PROFILE_PHASE(enabled, phaseName, moduleName) \
+    PerformanceProfilerPhaseRAIIContext _phaseContext(enabled, phaseName, moduleName)
+#define SLANG_PROFILE_TRACE(category, name, detail) \
+    PerformanceProfilerTraceRAIIContext _traceContext(category, name, detail)
 
 } // namespace Slang
 
@@ -56,11 +56,24 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
         // Okay lets decompress into a blob
         ScopedAllocation alloc;
         void* dst = alloc.allocateTerminated(entry->m_uncompressedSizeInBytes);
-        SLANG_RETURN_ON_FAIL(m_compressionSystem->decompress(
-            contents->getBufferPointer(),
-            contents->getBufferSize(),
-            entry->m_uncompressedSizeInBytes,
-            dst));
+        if (m_blockSize)
+        {
+            SLANG_RETURN_ON_FAIL(BlockCompressionUtil::decompress(
+                m_compressionSystem,
+                m_jobScheduler,
+                contents->getBufferPointer(),
+                contents->getBufferSize(),
+                entry->m_uncompressedSizeInBytes,
+                dst));
+        }
+        else
+        {
+            SLANG_RETURN_ON_FAIL(m_compressionSystem->decompress(
+                contents->getBufferPointer(),
+                contents->getBufferSize(),
+                entry->m_uncompressedSizeInBytes,
+                dst));
+        }
 
         auto blob = RawBlob::moveCreate(alloc);
 
@@ -76,6 +89,63 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
     }
 }
 
+SlangResult RiffFileSystem::loadFileRange(
+    const char* path,
+    size_t offset,
+    size_t size,
+    ISlangBlob** outBlob)
+{
+    Entry* entry;
+    SLANG_RETURN_ON_FAIL(_loadFile(path, &entry));
+
+    ISlangBlob* contents = entry->m_contents;
+
+    if (offset > entry->m_uncompressedSizeInBytes ||
+        size > entry->m_uncompressedSizeInBytes - offset)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    if (m_compressionSystem && m_blockSize)
+    {
+        ScopedAllocation alloc;
+        void* dst = alloc.allocateTerminated(size);
+        SLANG_RETURN_ON_FAIL(BlockCompressionUtil::decompressRange(
+            m_compressionSystem,
+            m_jobScheduler,
+            contents->getBufferPointer(),
+            contents->getBufferSize(),
+            entry->m_uncompressedSizeInBytes,
+            offset,
+            size,
+            dst));
+
+        auto blob = RawBlob::moveCreate(alloc);
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
+    else if (m_compressionSystem)
+    {
+        // A single block has to be decompressed in full
+        ComPtr<ISlangBlob> fileBlob;
+        SLANG_RETURN_ON_FAIL(loadFile(path, fileBlob.writeRef()));
+        *outBlob = RawBlob::create((const uint8_t*)fileBlob->getBufferPointer() + offset, size)
+                       .detach();
+        return SLANG_OK;
+    }
+    else
+    {
+        // The contents can be referenced in place
+        *outBlob = ScopeBlob::create(
+                       UnownedRawBlob::create(
+                           (const uint8_t*)contents->getBufferPointer() + offset,
+                           size),
+                       contents)
+                       .detach();
+        return SLANG_OK;
+    }
+}
+
 SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t size)
 {
     Entry* entry;
@@ -85,8 +155,25 @@ SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t
     if (m_compressionSystem)
     {
         // Lets try compressing the input
-        SLANG_RETURN_ON_FAIL(
-            m_compressionSystem->compress(&m_compressionStyle, data, size, contents.writeRef()));
+        if (m_blockSize)
+        {
+            SLANG_RETURN_ON_FAIL(BlockCompressionUtil::compress(
+                m_compressionSystem,
+                &m_compressionStyle,
+                m_jobScheduler,
+                m_blockSize,
+                data,
+                size,
+                contents.writeRef()));
+        }
+        else
+        {
+            SLANG_RETURN_ON_FAIL(m_compressionSystem->compress(
+                &m_compressionStyle,
+                data,
+                size,
+                contents.writeRef()));
+        }
     }
     else
     {
@@ -114,7 +201,43 @@ SlangResult RiffFileSystem::saveFileBlob(const char* path, ISlangBlob* dataBlob)
     }
 }
 
+SlangResult RiffFileSystem::decompressAll()
+{
+    if (!m_compressionSystem)
+    {
+        return SLANG_OK;
+    }
+
+    for (auto& [_, entry] : m_entries)
+    {
+        if (entry.m_type != SLANG_PATH_TYPE_FILE)
+        {
+            continue;
+        }
+
+        ComPtr<ISlangBlob> contents;
+        SLANG_RETURN_ON_FAIL(loadFile(entry.m_canonicalPath.getBuffer(), contents.writeRef()));
+        entry.setContents(entry.m_uncompressedSizeInBytes, contents);
+    }
+
+    m_compressionSystem.setNull();
+    return SLANG_OK;
+}
+
 SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeInBytes)
+{
+    return _loadArchive(archive, archiveSizeInBytes, nullptr);
+}
+
+SlangResult RiffFileSystem::loadArchiveBlob(ISlangBlob* archiveBlob)
+{
+    return _loadArchive(archiveBlob->getBufferPointer(), archiveBlob->getBufferSize(), archiveBlob);
+}
+
+SlangResult RiffFileSystem::_loadArchive(
+    const void* archive,
+    size_t archiveSizeInBytes,
+    ISlangBlob* archiveBlob)
 {
     // Load the riff
     auto rootList = RIFF::RootChunk::getFromBlob(archive, archiveSizeInBytes);
@@ -131,7 +254,17 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
     // Find the header
     auto headerChunk = rootList->findDataChunk(RiffFileSystemBinary::kHeaderFourCC);
 
-    const auto header = headerChunk->readPayloadAs<RiffFileSystemBinary::Header>();
+    if (!headerChunk)
+    {
+        return SLANG_FAIL;
+    }
+
+    // Archives from before block compression only have the compression system type.
+    RiffFileSystemBinary::Header header;
+    header.blockSize = 0;
+    headerChunk->writePayloadInto(
+        &header,
+        Math::Min(sizeof(header), size_t(headerChunk->getPayloadSize())));
 
     CompressionSystemType compressionType = CompressionSystemType(header.compressionSystemType);
     switch (compressionType)
@@ -156,6 +289,9 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
         return SLANG_FAIL;
     }
 
+    // Files saved from now on use the same blocks as the archive.
+    m_blockSize = header.blockSize;
+
     // Read all of the contained data
 
     {
@@ -206,9 +342,21 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
                         return SLANG_FAIL;
                     }
 
-                    // Get the compressed data
-                    dstEntry.m_contents =
-                        RawBlob::create(reader.getRemainingData(), srcEntry.compressedSize);
+                    // Get the compressed data. If we have the archive blob, we can just
+                    // reference the data in place.
+                    if (archiveBlob)
+                    {
+                        dstEntry.m_contents = ScopeBlob::create(
+                            UnownedRawBlob::create(
+                                reader.getRemainingData(),
+                                srcEntry.compressedSize),
+                            archiveBlob);
+                    }
+                    else
+                    {
+                        dstEntry.m_contents =
+                            RawBlob::create(reader.getRemainingData(), srcEntry.compressedSize);
+                    }
                     break;
                 }
             case SLANG_PATH_TYPE_DIRECTORY:
@@ -246,6 +394,7 @@ SlangResult RiffFileSystem::storeArchive(bool blobOwnsContent, ISlangBlob** outB
                                                           ? m_compressionSystem->getSystemType()
                                                           : CompressionSystemType::None;
         header.compressionSystemType = uint32_t(compressionSystemType);
+        header.blockSize = m_compressionSystem ? uint32_t(m_blockSize) : 0;
         cursor.addDataChunk(RiffFileSystemBinary::kHeaderFourCC, &header, sizeof(header));
     }
 
@@ -2,6 +2,7 @@
 #define SLANG_RIFF_FILE_SYSTEM_H
 
 #include "slang-archive-file-system.h"
+#include "slang-block-compression.h"
 #include "slang-memory-file-system.h"
 #include "slang-riff.h"
 
@@ -18,6 +19,8 @@ struct RiffFileSystemBinary
     struct Header
     {
         uint32_t compressionSystemType; /// One of CompressionSystemType
+        uint32_t blockSize; ///< If not 0, file contents are block compressed with this block size.
+                            ///< Archives from before block compression have no such field.
     };
 
     struct Entry
@@ -45,6 +48,10 @@ data is stored uncompressed. When compression is used, files 'contents' blob is
 *compressed* version of the contents. Calling loadFile/saveFile will uncompress/compress as need. If
 there is no compression contents is identical to the file contents.
 
+By default compressed files are split into independently compressed blocks (see
+BlockCompressionUtil). With a job scheduler set, blocks are compressed and decompressed in parallel,
+and loadFileRange only decompresses the blocks a range overlaps.
+
 NOTE:
 * The RIFF chunk IDs are *slang specific*. It conforms to RIFF but is unlikely to be usable with
 other tooling.
@@ -82,6 +89,32 @@ public:
         m_compressionStyle = style;
     }
 
+    /// Load an archive held in `archiveBlob` without copying its file contents.
+    /// Files are views into the blob, which is retained for as long as any of them are.
+    SlangResult loadArchiveBlob(ISlangBlob* archiveBlob);
+
+    /// Load `size` bytes from `offset` in the file at `path`. For a block compressed file only
+    /// the blocks that overlap the range are decompressed.
+    SlangResult loadFileRange(const char* path, size_t offset, size_t size, ISlangBlob** outBlob);
+
+    /// Set the block size used to compress files saved from now on. 0 compresses each file as a
+    /// single block, as archives did before block compression. Loading an archive sets the block
+    /// size to the one the archive was stored with. Whether blocks are used is recorded for the
+    /// archive as a whole, so don't switch between 0 and a block size once files are saved.
+    void setCompressionBlockSize(size_t blockSize) { m_blockSize = blockSize; }
+    size_t getCompressionBlockSize() const { return m_blockSize; }
+
+    /// Set a scheduler to compress and decompress blocks on in parallel. Can be nullptr.
+    void setJobScheduler(ISlangJobScheduler* jobScheduler) { m_jobScheduler = jobScheduler; }
+
+    /// True if file contents are held compressed.
+    bool isCompressed() const { return m_compressionSystem != nullptr; }
+
+    /// Decompress the contents of every file, and hold files uncompressed from now on. A
+    /// subsequently stored archive can then be loaded with `loadArchiveBlob` without
+    /// decompressing anything, its files referencing the archive's memory directly.
+    SlangResult decompressAll();
+
     /// Pass in nullptr, if no compression is wanted.
     explicit RiffFileSystem(ICompressionSystem* compressionSystem);
 
@@ -92,9 +125,19 @@ protected:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+    /// If `archiveBlob` is set, entries reference the archive data rather than copying it.
+    SlangResult _loadArchive(
+        const void* archive,
+        size_t archiveSizeInBytes,
+        ISlangBlob* archiveBlob);
+
     ComPtr<ICompressionSystem> m_compressionSystem;
 
     CompressionStyle m_compressionStyle;
+
+    size_t m_blockSize = BlockCompressionUtil::kDefaultBlockSize;
+
+    ComPtr<ISlangJobScheduler> m_jobScheduler;
 };
 
 } // namespace Slang
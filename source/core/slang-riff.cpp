@@ -3,6 +3,9 @@
 
 #include "slang-blob.h"
 #include "slang-com-helper.h"
+#include "slang-stable-hash.h"
+
+#include <algorithm>
 
 namespace Slang
 {
@@ -880,6 +883,131 @@ void BuildCursor::addUnownedData(void const* data, Size size)
     dataChunk->addUnownedData(data, size);
 }
 
+//
+// RIFF::ChunkIndex
+//
+
+/* static */ UInt32 ChunkIndex::getNameHash(UnownedStringSlice const& name)
+{
+    return getStableHashCode32(name.begin(), name.getLength()).hash;
+}
+
+static bool _isLessThan(ChunkIndex::Entry const& a, ChunkIndex::Entry const& b)
+{
+    if (a.type != b.type)
+        return a.type < b.type;
+    return a.nameHash < b.nameHash;
+}
+
+/* static */ void ChunkIndex::write(DataChunkBuilder* indexChunk, ConstArrayView<Child> children)
+{
+    auto list = indexChunk->getParent();
+    SLANG_ASSERT(list && list->getChildren().getFirst() == indexChunk);
+    SLANG_ASSERT(indexChunk->getType() == kType && !indexChunk->getShards().getFirst());
+
+    // The index goes before the chunks it refers to, so its size has to be
+    // known to work out their offsets. Fortunately, that only depends on
+    // the number of entries.
+    //
+    const Size indexTotalSize = sizeof(DataChunk::Header) + sizeof(Entry) * children.getCount();
+
+    // We lay the children out the same way `_writeTo` will, so that
+    // we know the offset of each of them from the start of the list.
+    //
+    Dictionary<ChunkBuilder const*, UInt32> offsets;
+    Size totalSize = sizeof(ListChunk::Header);
+    for (auto child : list->getChildren())
+    {
+        auto childSize = child == indexChunk ? indexTotalSize : child->_updateCachedTotalSize();
+
+        totalSize = _roundUpToChunkAlignment(totalSize);
+        offsets.add(child, UInt32(totalSize));
+        totalSize += childSize;
+    }
+
+    List<Entry> entries;
+    for (auto const& child : children)
+    {
+        SLANG_ASSERT(child.chunk->getParent() == list);
+
+        Entry entry;
+        entry.type = child.chunk->getType();
+        entry.nameHash = child.nameHash;
+        entry.offset = offsets.getValue(child.chunk);
+        entries.add(entry);
+    }
+    entries.sort([](Entry const& a, Entry const& b) { return _isLessThan(a, b); });
+
+    indexChunk->addData(entries.getBuffer(), sizeof(Entry) * entries.getCount());
+}
+
+/* static */ ConstArrayView<ChunkIndex::Entry> ChunkIndex::getEntries(ListChunk const* list)
+{
+    auto firstChild = list->getFirstChild();
+    auto indexChunk = as<DataChunk>(firstChild.get());
+    if (!indexChunk || indexChunk->getType() != kType)
+        return ConstArrayView<Entry>();
+
+    auto payloadSize = indexChunk->getPayloadSize();
+    if (payloadSize % sizeof(Entry) != 0)
+    {
+        SLANG_UNEXPECTED("invalid RIFF chunk index");
+        UNREACHABLE_RETURN(ConstArrayView<Entry>());
+    }
+
+    return ConstArrayView<Entry>(
+        (Entry const*)indexChunk->getPayload(),
+        Count(payloadSize / sizeof(Entry)));
+}
+
+/* static */ ConstArrayView<ChunkIndex::Entry> ChunkIndex::findEntries(
+    ListChunk const* list,
+    Chunk::Type type,
+    UInt32 nameHash)
+{
+    auto entries = getEntries(list);
+
+    Entry key;
+    key.type = type;
+    key.nameHash = nameHash;
+    key.offset = 0;
+
+    // The entries are sorted, so the matches form a contiguous range.
+    //
+    auto begin = std::lower_bound(entries.begin(), entries.end(), key, _isLessThan);
+    auto end = std::upper_bound(begin, entries.end(), key, _isLessThan);
+    return ConstArrayView<Entry>(begin, Count(end - begin));
+}
+
+/* static */ Chunk const* ChunkIndex::getChild(ListChunk const* list, Entry const& entry)
+{
+    // The offset comes from the file, so we check that it
+    // refers to an aligned chunk inside the list before using it.
+    //
+    Size listSize = list->getTotalSize();
+    Size offset = entry.offset;
+    if (offset < sizeof(ListChunk::Header) || offset != _roundUpToChunkAlignment(offset) ||
+        offset >= listSize)
+    {
+        return nullptr;
+    }
+
+    auto child = (Chunk const*)(offset + (Byte const*)list);
+    auto checkedChild = BoundsCheckedChunkPtr(child, listSize - offset);
+    if (!checkedChild || checkedChild->getType() != entry.type)
+        return nullptr;
+    return checkedChild;
+}
+
+/* static */ ListChunk::ChildList ChunkIndex::getChildren(ListChunk const* list)
+{
+    auto firstChild = list->getFirstChild();
+    auto indexChunk = as<DataChunk>(firstChild.get());
+    if (!indexChunk || indexChunk->getType() != kType)
+        return ListChunk::ChildList(firstChild);
+    return ListChunk::ChildList(firstChild.getNextSibling());
+}
+
 } // namespace RIFF
 
 } // namespace Slang
@@ -15,6 +15,7 @@
 // is needed.
 //
 
+#include "slang-array-view.h"
 #include "slang-basic.h"
 #include "slang-internally-linked-list.h"
 #include "slang-memory-arena.h"
@@ -596,6 +597,7 @@ private:
     Result _writeTo(Stream* stream) const;
 
     friend struct Builder;
+    friend struct ChunkIndex;
 };
 
 class ListChunkBuilder : public ChunkBuilder
@@ -920,6 +922,90 @@ private:
         _scopedRIFFBuilderListChunk,                          \
         __LINE__)(CURSOR, TYPE)
 
+//
+// A list chunk with many children can only be searched by walking
+// them in order. Writers can make this cheaper by giving the list
+// an *index*: a data chunk, which must be the first child of the list,
+// that maps the type and a hash of the name of each indexed child
+// to the offset of that child.
+//
+
+/// Support for an optional index of the children of a list chunk.
+struct ChunkIndex
+{
+public:
+    /// The type of an index data chunk.
+    static const FourCC::RawValue kType = SLANG_FOUR_CC('i', 'n', 'd', 'x');
+
+    /// An entry in an index.
+    ///
+    /// Entries are sorted by `type` and then `nameHash`.
+    ///
+    struct Entry
+    {
+        /// The type of the child chunk.
+        FourCC::RawValue type;
+
+        /// `getNameHash()` of the name of the child chunk.
+        UInt32 nameHash;
+
+        /// The offset of the child chunk from the start of the list chunk.
+        UInt32 offset;
+    };
+
+    /// Get the hash of a name to store in an index entry.
+    static UInt32 getNameHash(UnownedStringSlice const& name);
+
+    //
+    // Writing
+    //
+
+    /// A child chunk to add to an index.
+    struct Child
+    {
+        ChunkBuilder* chunk = nullptr;
+        UInt32 nameHash = 0;
+    };
+
+    /// Write an index of `children` into `indexChunk`.
+    ///
+    /// `indexChunk` must be an empty data chunk of type `kType` that is the
+    /// first child of its list, and `children` must be children of the same list.
+    /// Must be called after all the children of the list have been added, as the
+    /// offsets depend on the size of every chunk before an indexed child.
+    ///
+    static void write(DataChunkBuilder* indexChunk, ConstArrayView<Child> children);
+
+    //
+    // Reading
+    //
+
+    /// Get the entries of the index of `list`.
+    ///
+    /// Returns an empty view if `list` doesn't have an index.
+    ///
+    static ConstArrayView<Entry> getEntries(ListChunk const* list);
+
+    /// Get the entries of the index of `list` with the given `type` and `nameHash`.
+    ///
+    /// More than one child can match, as different names can have the same hash,
+    /// so callers need to check the name of each match.
+    ///
+    static ConstArrayView<Entry> findEntries(
+        ListChunk const* list,
+        Chunk::Type type,
+        UInt32 nameHash);
+
+    /// Get the child of `list` that an index `entry` refers to.
+    ///
+    /// Returns `nullptr` if the entry doesn't refer to a plausible chunk.
+    ///
+    static Chunk const* getChild(ListChunk const* list, Entry const& entry);
+
+    /// Get the children of `list`, not including its index if it has one.
+    static ListChunk::ChildList getChildren(ListChunk const* list);
+};
+
 } // namespace RIFF
 
 /// A simple helper for reading from a blob.
@@ -175,6 +175,14 @@ public:
         _setContents(m_ownedContents.getBuffer(), m_ownedContents.getCount());
     }
 
+    /// Reserve space for `size` bytes of content, so that writes up to
+    /// that size don't reallocate.
+    void reserve(size_t size)
+    {
+        m_ownedContents.reserve(Index(size));
+        m_contents = m_ownedContents.getBuffer();
+    }
+
     void swapContents(List<uint8_t>& rhs)
     {
         rhs.swapWith(m_ownedContents);
@@ -11,12 +11,14 @@ namespace Slang
 StringSlicePool::StringSlicePool(Style style)
     : m_style(style), m_arena(1024)
 {
+    m_arena.setCategory(MemoryArenaCategory::StringPool);
     clear();
 }
 
 StringSlicePool::StringSlicePool(const ThisType& rhs)
     : m_style(rhs.m_style), m_arena(1024)
 {
+    m_arena.setCategory(MemoryArenaCategory::StringPool);
     // Set with rhs
     _set(rhs);
 }
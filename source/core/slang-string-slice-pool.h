@@ -113,6 +113,9 @@ public:
     /// Swap this with rhs
     void swapWith(ThisType& rhs);
 
+    /// Total memory allocated to hold the strings, in bytes
+    size_t calcTotalMemoryAllocated() const { return m_arena.calcTotalMemoryAllocated(); }
+
     /// True if the pools are identical. Same style, same slices in the same order.
     bool operator==(const ThisType& rhs) const;
 
@@ -8,6 +8,7 @@
 #include "slang-stable-hash.h"
 
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <new>
 #include <stdio.h>
@@ -803,6 +804,19 @@ public:
     UnownedStringSlice getUnownedSlice() const { return StringRepresentation::asSlice(m_buffer); }
 };
 
+/// Hashes `String` keys, and slices the same way, so that a `Dictionary` or `HashSet` keyed
+/// by `String` can be searched with a slice or a C string without making a `String` first.
+template<>
+struct Hash<String>
+{
+    using is_avalanching = void;
+    using is_transparent = void;
+
+    HashCode64 operator()(const String& str) const { return str.getHashCode(); }
+    HashCode64 operator()(const UnownedStringSlice& slice) const { return slice.getHashCode(); }
+    HashCode64 operator()(const char* str) const { return UnownedStringSlice(str).getHashCode(); }
+};
+
 class ImmutableHashedString
 {
 public:
@@ -833,7 +847,7 @@ public:
     {
     }
     ImmutableHashedString(String&& str)
-        : slice(_Move(str)), hashCode(str.getHashCode())
+        : slice(_Move(str)), hashCode(slice.getHashCode())
     {
     }
     ImmutableHashedString(const ImmutableHashedString& other) = default;
@@ -960,4 +974,33 @@ float stringToFloat(const String& str);
 
 std::ostream& operator<<(std::ostream& stream, const Slang::String& s);
 
+namespace std
+{
+/// Compares `String` keys with each other and with slices, the counterpart of
+/// `Slang::Hash<Slang::String>` for lookups that don't make a `String`.
+template<>
+struct equal_to<Slang::String>
+{
+    using is_transparent = void;
+
+    bool operator()(const Slang::String& a, const Slang::String& b) const { return a == b; }
+    bool operator()(const Slang::String& a, const Slang::UnownedStringSlice& b) const
+    {
+        return a.getUnownedSlice() == b;
+    }
+    bool operator()(const Slang::UnownedStringSlice& a, const Slang::String& b) const
+    {
+        return a == b.getUnownedSlice();
+    }
+    bool operator()(const Slang::String& a, const char* b) const
+    {
+        return a.getUnownedSlice() == Slang::UnownedStringSlice(b);
+    }
+    bool operator()(const char* a, const Slang::String& b) const
+    {
+        return Slang::UnownedStringSlice(a) == b.getUnownedSlice();
+    }
+};
+} // namespace std
+
 #endif
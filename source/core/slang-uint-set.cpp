@@ -79,13 +79,16 @@ void UIntSet::clearAndDeallocate()
     m_buffer.clearAndDeallocate();
 }
 
+// The bulk operations below loop over the raw element buffers, rather than indexing the
+// lists, so that the compiler can vectorize them.
+
 void UIntSet::unionWith(const UIntSet& set)
 {
     const Index minCount = Math::Min(set.m_buffer.getCount(), m_buffer.getCount());
+    Element* elems = m_buffer.getBuffer();
+    const Element* setElems = set.m_buffer.getBuffer();
     for (Index i = 0; i < minCount; i++)
-    {
-        m_buffer[i] |= set.m_buffer[i];
-    }
+        elems[i] |= setElems[i];
 
     if (set.m_buffer.getCount() > m_buffer.getCount())
         m_buffer.addRange(
@@ -120,30 +123,39 @@ void UIntSet::intersectWith(const UIntSet& set)
             (m_buffer.getCount() - set.m_buffer.getCount()) * sizeof(Element));
 
     const Index minCount = Math::Min(set.m_buffer.getCount(), m_buffer.getCount());
+    Element* elems = m_buffer.getBuffer();
+    const Element* setElems = set.m_buffer.getBuffer();
     for (Index i = 0; i < minCount; i++)
-    {
-        m_buffer[i] &= set.m_buffer[i];
-    }
+        elems[i] &= setElems[i];
 }
 
 void UIntSet::subtractWith(const UIntSet& set)
 {
     const Index minCount = Math::Min(this->m_buffer.getCount(), set.m_buffer.getCount());
+    Element* elems = m_buffer.getBuffer();
+    const Element* setElems = set.m_buffer.getBuffer();
     for (Index i = 0; i < minCount; i++)
-    {
-        this->m_buffer[i] = this->m_buffer[i] & (~set.m_buffer[i]);
-    }
+        elems[i] &= ~setElems[i];
 }
 
 /* static */ void UIntSet::calcUnion(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2)
 {
-    outRs.resizeBackingBufferDirectly(
-        Math::Max(set1.m_buffer.getCount(), set2.m_buffer.getCount()));
-    outRs.unsetAll();
-    for (Index i = 0; i < set1.m_buffer.getCount(); i++)
-        outRs.m_buffer[i] |= set1.m_buffer[i];
-    for (Index i = 0; i < set2.m_buffer.getCount(); i++)
-        outRs.m_buffer[i] |= set2.m_buffer[i];
+    // Make `set1` the longer of the two, so its remaining elements are copied as they are.
+    const UIntSet* longer = &set1;
+    const UIntSet* shorter = &set2;
+    if (longer->m_buffer.getCount() < shorter->m_buffer.getCount())
+        Swap(longer, shorter);
+    const Index longCount = longer->m_buffer.getCount();
+    const Index shortCount = shorter->m_buffer.getCount();
+
+    outRs.m_buffer.setCount(longCount);
+    Element* outElems = outRs.m_buffer.getBuffer();
+    const Element* longElems = longer->m_buffer.getBuffer();
+    const Element* shortElems = shorter->m_buffer.getBuffer();
+    for (Index i = 0; i < shortCount; i++)
+        outElems[i] = longElems[i] | shortElems[i];
+    for (Index i = shortCount; i < longCount; i++)
+        outElems[i] = longElems[i];
 }
 
 /* static */ void UIntSet::calcIntersection(
@@ -152,10 +164,13 @@ void UIntSet::subtractWith(const UIntSet& set)
     const UIntSet& set2)
 {
     const Index minCount = Math::Min(set1.m_buffer.getCount(), set2.m_buffer.getCount());
-    outRs.resizeBackingBufferDirectly(minCount);
+    outRs.m_buffer.setCount(minCount);
 
+    Element* outElems = outRs.m_buffer.getBuffer();
+    const Element* elems1 = set1.m_buffer.getBuffer();
+    const Element* elems2 = set2.m_buffer.getBuffer();
     for (Index i = 0; i < minCount; i++)
-        outRs.m_buffer[i] = set1.m_buffer[i] & set2.m_buffer[i];
+        outElems[i] = elems1[i] & elems2[i];
 }
 
 /* static */ void UIntSet::calcSubtract(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2)
@@ -163,50 +178,38 @@ void UIntSet::subtractWith(const UIntSet& set)
     const auto set1Count = set1.m_buffer.getCount();
     const auto set2Count = set2.m_buffer.getCount();
 
-    outRs.resizeBackingBufferDirectly(set1Count);
+    const auto minCount = Math::Min(set1Count, set2Count);
 
-    for (Index i = 0; i < set1Count; i++)
-    {
-        if (i < set2Count)
-        {
-            outRs.m_buffer[i] = set1.m_buffer[i] & (~set2.m_buffer[i]);
-        }
-        else
-        {
-            // If `set2` is smaller, copy the remaining values from `set1`
-            outRs.m_buffer[i] = set1.m_buffer[i];
-        }
-    }
+    outRs.m_buffer.setCount(set1Count);
+
+    Element* outElems = outRs.m_buffer.getBuffer();
+    const Element* elems1 = set1.m_buffer.getBuffer();
+    const Element* elems2 = set2.m_buffer.getBuffer();
+    for (Index i = 0; i < minCount; i++)
+        outElems[i] = elems1[i] & ~elems2[i];
+
+    // If `set2` is smaller, copy the remaining values from `set1`
+    for (Index i = minCount; i < set1Count; i++)
+        outElems[i] = elems1[i];
 }
 
 /* static */ bool UIntSet::hasIntersection(const UIntSet& set1, const UIntSet& set2)
 {
     const Index minCount = Math::Min(set1.m_buffer.getCount(), set2.m_buffer.getCount());
+    const Element* elems1 = set1.m_buffer.getBuffer();
+    const Element* elems2 = set2.m_buffer.getBuffer();
+
+    Element common = 0;
     for (Index i = 0; i < minCount; i++)
-    {
-        if (set1.m_buffer[i] & set2.m_buffer[i])
-            return true;
-    }
-    return false;
+        common |= elems1[i] & elems2[i];
+    return common != 0;
 }
 
 Index UIntSet::countElements() const
 {
-    // TODO: This can be made faster using SIMD intrinsics to count set bits.
-    uint64_t tmp;
-    constexpr Index loopSize =
-        ((sizeof(Element) / sizeof(tmp)) != 0) ? sizeof(Element) / sizeof(tmp) : 1;
     Index count = 0;
-    for (auto index = 0; index < this->m_buffer.getCount(); index++)
-    {
-        for (auto i = 0; i < loopSize; i++)
-        {
-            tmp = m_buffer[index] >> (sizeof(tmp) * i);
-            tmp = tmp - ((tmp >> 1) & 0x5555555555555555);
-            tmp = (tmp & 0x3333333333333333) + ((tmp >> 2) & 0x3333333333333333);
-            count += ((tmp + (tmp >> 4) & 0xF0F0F0F0F0F0F0F) * 0x101010101010101) >> 56;
-        }
-    }
+    for (auto element : m_buffer)
+        count += bitCount(element);
     return count;
 }
 
@@ -9,6 +9,7 @@
 #if defined(_MSC_VER)
 #include <intrin.h>
 #endif
+#include <bit>
 #include <memory.h>
 
 namespace Slang
@@ -45,6 +46,12 @@ static inline Index bitscanForward(uint64_t in)
 #endif // #if defined(_MSC_VER)
 }
 
+// Count the bits set in `in`
+static inline Index bitCount(uint64_t in)
+{
+    return Index(std::popcount(in));
+}
+
 /* Hold a set of UInt values. Implementation works by storing as a bit per value */
 /// UIntSet is essentially a Element[], where each Element is `b` bits big.
 /// Each index has `b` number of integers. If the bit is 1, we have an element there.
@@ -218,14 +225,12 @@ protected:
 
     static bool _areAllZero(const UIntSet::Element* elems, Index count)
     {
+        // Combine all of the elements rather than stopping at the first non zero one, so the
+        // loop has no branch and can be vectorized.
+        Element combined = 0;
         for (Index i = 0; i < count; ++i)
-        {
-            if (elems[i])
-            {
-                return false;
-            }
-        }
-        return true;
+            combined |= elems[i];
+        return combined == 0;
     }
 
     List<Element> m_buffer;
@@ -252,20 +257,14 @@ inline bool UIntSet::contains(UInt val) const
 // --------------------------------------------------------------------------
 inline bool UIntSet::contains(const UIntSet& set) const
 {
-    for (Index i = 0; i < set.m_buffer.getCount(); i++)
-    {
-        if (i >= m_buffer.getCount())
-        {
-            if (set.m_buffer[i])
-                return false;
-        }
-        else
-        {
-            if ((m_buffer[i] & set.m_buffer[i]) != set.m_buffer[i])
-                return false;
-        }
-    }
-    return true;
+    const Index minCount = Math::Min(m_buffer.getCount(), set.m_buffer.getCount());
+    const Element* elems = m_buffer.getBuffer();
+    const Element* setElems = set.m_buffer.getBuffer();
+
+    Element missing = 0;
+    for (Index i = 0; i < minCount; i++)
+        missing |= setElems[i] & ~elems[i];
+    return missing == 0 && _areAllZero(setElems + minCount, set.m_buffer.getCount() - minCount);
 }
 
 // --------------------------------------------------------------------------
@@ -297,8 +296,10 @@ inline void UIntSet::add(const UIntSet& other)
     if (this->m_buffer.getCount() < otherCount)
         resizeBackingBufferDirectly(otherCount);
 
-    for (auto i = 0; i < otherCount; i++)
-        m_buffer[i] |= other.m_buffer[i];
+    Element* elems = m_buffer.getBuffer();
+    const Element* otherElems = other.m_buffer.getBuffer();
+    for (Index i = 0; i < otherCount; i++)
+        elems[i] |= otherElems[i];
 }
 
 inline void UIntSet::addRange(const List<UInt>& other)
@@ -325,7 +326,7 @@ List<T> UIntSet::getElements() const
     // types.
 
     List<T> elements;
-    elements.reserve(count);
+    elements.reserve(countElements());
     for (Index block = 0; block < count; block++)
     {
         Element n = m_buffer[block];
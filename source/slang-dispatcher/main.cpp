@@ -395,7 +395,13 @@ static int handleHelp(
            "Run 'slang <command> --help' for more information on a command.\n"
            "\n"
            "When invoked without a command, or with a file path as the first\n"
-           "argument, slang delegates to slangi (the Slang interpreter).\n");
+           "argument, slang delegates to slangi (the Slang interpreter).\n"
+           "\n"
+           "'slang compile --server' runs slangc as a compile server, which reads\n"
+           "command lines as JSON-RPC calls on stdin and compiles them all with\n"
+           "one global session, so the core module is only loaded once.\n"
+           "'slang compile --batch <manifest.json>' does the same for the jobs in a\n"
+           "manifest, a JSON array holding the argument array of each job.\n");
     return 0;
 }
 
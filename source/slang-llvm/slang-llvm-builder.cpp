@@ -6,6 +6,7 @@
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DIBuilder.h"
@@ -25,6 +26,7 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/TargetParser/Host.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 
 #include <compiler-core/slang-artifact-associated-impl.h>
 #include <compiler-core/slang-artifact-associated.h>
@@ -32,6 +34,7 @@
 #include <core/slang-blob.h>
 #include <core/slang-com-object.h>
 #include <core/slang-list.h>
+#include <vector>
 
 using namespace slang;
 
@@ -99,9 +102,16 @@ llvm::StringRef charSliceToLLVM(CharSlice slice)
     return llvm::StringRef(slice.begin(), slice.count);
 }
 
+// Splitting a module has a cost of its own, so a JIT partition is only made for
+// at least this many functions.
+static const unsigned kMinFunctionsPerJITPartition = 8;
+
 class LLVMBuilder : public ComBaseObject, public ILLVMBuilder
 {
     LLVMBuilderOptions options;
+    // Copied, since the options only reference the caller's string.
+    std::string jitObjectCacheDirectory;
+    int jitCompileThreadCount;
 
     std::unique_ptr<llvm::LLVMContext> llvmContext;
     std::unique_ptr<llvm::Module> llvmModule;
@@ -158,7 +168,7 @@ class LLVMBuilder : public ComBaseObject, public ILLVMBuilder
 public:
     typedef ComBaseObject Super;
 
-    LLVMBuilder(LLVMBuilderOptions options, IArtifact** outErrorArtifact);
+    LLVMBuilder(LLVMBuilderOptionsV3 options, IArtifact** outErrorArtifact);
     ~LLVMBuilder();
 
     IArtifact* createErrorArtifact(const ArtifactDiagnostic& diagnostic);
@@ -400,8 +410,10 @@ public:
     SLANG_NO_THROW SlangResult SLANG_MCALL generateJITLibrary(IArtifact** outArtifact) override;
 };
 
-LLVMBuilder::LLVMBuilder(LLVMBuilderOptions options, IArtifact** outErrorArtifact)
+LLVMBuilder::LLVMBuilder(LLVMBuilderOptionsV3 options, IArtifact** outErrorArtifact)
     : options(options)
+    , jitObjectCacheDirectory(charSliceToLLVM(options.jitObjectCacheDirectory).str())
+    , jitCompileThreadCount(options.jitCompileThreadCount)
 {
     llvmContext.reset(new llvm::LLVMContext());
     llvmModule.reset(new llvm::Module("module", *llvmContext));
@@ -2294,11 +2306,39 @@ SlangResult LLVMBuilder::generateJITLibrary(IArtifact** outArtifact)
 {
     finalize();
 
+    std::unique_ptr<LLVMPersistentObjectCache> objectCache;
+    if (!jitObjectCacheDirectory.empty())
+    {
+        PersistentCache::Desc cacheDesc;
+        cacheDesc.directory = jitObjectCacheDirectory.c_str();
+        objectCache.reset(new LLVMPersistentObjectCache(new PersistentCache(cacheDesc)));
+    }
+
+    // The JIT generates code for each module it is given as a unit, so a large module
+    // is split into partitions that its compile threads can work on side by side.
+    // Optimization has already run on the whole module, so inlining across the
+    // partitions isn't lost.
+    unsigned partitionCount = 1;
+    if (jitCompileThreadCount > 1)
+    {
+        unsigned definedFunctionCount = 0;
+        for (const auto& func : *llvmModule)
+        {
+            if (!func.isDeclaration())
+                definedFunctionCount++;
+        }
+        partitionCount = std::min(
+            unsigned(jitCompileThreadCount),
+            definedFunctionCount / kMinFunctionsPerJITPartition);
+    }
+
     std::unique_ptr<llvm::orc::LLJIT> jit;
     {
         // Construct the LLJIT with AVX-512 disabled in the JIT TargetMachine;
         // see #11062 and the docstring for createAVX512SafeLLJIT.
-        llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = createAVX512SafeLLJIT();
+        llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = createAVX512SafeLLJIT(
+            objectCache.get(),
+            partitionCount > 1 ? unsigned(jitCompileThreadCount) : 0);
 
         if (!expectJit)
         {
@@ -2323,18 +2363,41 @@ SlangResult LLVMBuilder::generateJITLibrary(IArtifact** outArtifact)
         }
         jit = std::move(*expectJit);
     }
-    llvm::orc::ThreadSafeModule threadSafeModule(std::move(llvmModule), std::move(llvmContext));
+    std::vector<llvm::orc::ThreadSafeModule> threadSafeModules;
+    if (partitionCount > 1)
+    {
+        // Modules that share a context can't be compiled at the same time, so each
+        // partition is moved onto a context of its own.
+        llvm::orc::ThreadSafeContext splitContext(std::move(llvmContext));
+        llvm::SplitModule(
+            *llvmModule,
+            partitionCount,
+            [&](std::unique_ptr<llvm::Module> partition)
+            {
+                llvm::orc::ThreadSafeModule sharedModule(std::move(partition), splitContext);
+                threadSafeModules.push_back(llvm::orc::cloneToNewContext(sharedModule));
+            });
+        llvmModule.reset();
+    }
+    else
+    {
+        threadSafeModules.emplace_back(std::move(llvmModule), std::move(llvmContext));
+    }
 
-    if (auto err = jit->addIRModule(std::move(threadSafeModule)))
+    for (auto& threadSafeModule : threadSafeModules)
     {
-        return SLANG_FAIL;
+        if (auto err = jit->addIRModule(std::move(threadSafeModule)))
+        {
+            return SLANG_FAIL;
+        }
     }
 
     if (auto err = jit->initialize(jit->getMainJITDylib()))
     {
         return SLANG_FAIL;
     }
-    ComPtr<ISlangSharedLibrary> sharedLibrary(new LLVMJITSharedLibrary(std::move(jit)));
+    ComPtr<ISlangSharedLibrary> sharedLibrary(
+        new LLVMJITSharedLibrary(std::move(jit), std::move(objectCache)));
 
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.target);
 
@@ -2349,10 +2412,10 @@ SlangResult LLVMBuilder::generateJITLibrary(IArtifact** outArtifact)
 
 } // namespace slang_llvm
 
-extern "C" SLANG_DLL_EXPORT SlangResult createLLVMBuilder_V2(
+extern "C" SLANG_DLL_EXPORT SlangResult createLLVMBuilder_V3(
     const SlangUUID& intfGuid,
     Slang::ILLVMBuilder** out,
-    Slang::LLVMBuilderOptions options,
+    Slang::LLVMBuilderOptionsV3 options,
     Slang::IArtifact** outErrorArtifact)
 {
     Slang::ComPtr<slang_llvm::LLVMBuilder> builder(
@@ -2367,3 +2430,16 @@ extern "C" SLANG_DLL_EXPORT SlangResult createLLVMBuilder_V2(
 
     return SLANG_E_NO_INTERFACE;
 }
+
+extern "C" SLANG_DLL_EXPORT SlangResult createLLVMBuilder_V2(
+    const SlangUUID& intfGuid,
+    Slang::ILLVMBuilder** out,
+    Slang::LLVMBuilderOptions options,
+    Slang::IArtifact** outErrorArtifact)
+{
+    Slang::LLVMBuilderOptionsV3 optionsV3;
+    static_cast<Slang::LLVMBuilderOptions&>(optionsV3) = options;
+    optionsV3.jitObjectCacheDirectory = Slang::CharSlice();
+    optionsV3.jitCompileThreadCount = 1;
+    return createLLVMBuilder_V3(intfGuid, out, optionsV3, outErrorArtifact);
+}
@@ -73,6 +73,18 @@ struct LLVMBuilderOptions
     Slice<TerminatedCharSlice> llvmArguments;
 };
 
+// Options taken by `createLLVMBuilder_V3`. The V2 options are kept as a base so
+// that a compiler can still drive an older slang-llvm through `createLLVMBuilder_V2`.
+struct LLVMBuilderOptionsV3 : LLVMBuilderOptions
+{
+    // Directory in which JIT-compiled object code is cached across runs.
+    // Leave empty to disable the cache.
+    CharSlice jitObjectCacheDirectory;
+    // Number of threads the JIT may compile on. With more than one, the module
+    // is split into partitions that are compiled in parallel.
+    int jitCompileThreadCount;
+};
+
 enum LLVMAttribute : uint32_t
 {
     SLANG_LLVM_ATTR_NONE = 0,
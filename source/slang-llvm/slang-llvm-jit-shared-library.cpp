@@ -1,10 +1,15 @@
 #include "slang-llvm-jit-shared-library.h"
 
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
 
+#include <core/slang-blob.h>
 #include <core/slang-platform.h>
 #include <core/slang-string.h>
 
@@ -60,13 +65,71 @@ void disableAVX512ForJIT(llvm::orc::LLJITBuilder& jitBuilder)
     jitBuilder.setJITTargetMachineBuilder(std::move(*expectJTMB));
 }
 
-llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> createAVX512SafeLLJIT()
+llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> createAVX512SafeLLJIT(
+    LLVMPersistentObjectCache* objectCache,
+    unsigned compileThreadCount)
 {
     llvm::orc::LLJITBuilder jitBuilder;
     disableAVX512ForJIT(jitBuilder);
+    if (compileThreadCount)
+        jitBuilder.setNumCompileThreads(compileThreadCount);
+    if (objectCache)
+    {
+        // The compiler is created from the final JITTargetMachineBuilder, after the
+        // AVX-512 mitigation has had its say, so the cache key sees the real CPU.
+        jitBuilder.setCompileFunctionCreator(
+            [objectCache](llvm::orc::JITTargetMachineBuilder jtmb)
+                -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>>
+            {
+                std::string desc = jtmb.getTargetTriple().str();
+                desc += "|" + jtmb.getCPU();
+                for (const auto& feature : jtmb.getFeatures().getFeatures())
+                    desc += "|" + feature;
+                objectCache->setTargetDescription(std::move(desc));
+                return std::make_unique<llvm::orc::ConcurrentIRCompiler>(
+                    std::move(jtmb),
+                    objectCache);
+            });
+    }
     return jitBuilder.create();
 }
 
+Slang::PersistentCache::Key LLVMPersistentObjectCache::getKey(const llvm::Module* module)
+{
+    std::string moduleText;
+    llvm::raw_string_ostream moduleStream(moduleText);
+    module->print(moduleStream, nullptr);
+    moduleStream.flush();
+
+    Slang::DigestBuilder<Slang::SHA1> builder;
+    builder.append(Slang::UnownedStringSlice(LLVM_VERSION_STRING));
+    builder.append(Slang::UnownedStringSlice(m_targetDescription.c_str()));
+    builder.append(Slang::UnownedStringSlice(module->getTargetTriple().str().c_str()));
+    builder.append(Slang::UnownedStringSlice(module->getDataLayoutStr().c_str()));
+    builder.append(moduleText.data(), Slang::SlangInt(moduleText.size()));
+    return builder.finalize();
+}
+
+void LLVMPersistentObjectCache::notifyObjectCompiled(
+    const llvm::Module* module,
+    llvm::MemoryBufferRef obj)
+{
+    auto blob = Slang::RawBlob::create(obj.getBufferStart(), obj.getBufferSize());
+    // A failed write only means the next run compiles the module again.
+    m_cache->writeEntry(getKey(module), blob);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> LLVMPersistentObjectCache::getObject(
+    const llvm::Module* module)
+{
+    Slang::ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(m_cache->readEntry(getKey(module), blob.writeRef())))
+        return nullptr;
+    return llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(
+        (const char*)blob->getBufferPointer(),
+        blob->getBufferSize()));
+}
+
 ISlangUnknown* LLVMJITSharedLibrary::getInterface(const SlangUUID& guid)
 {
     if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid() ||
@@ -1,12 +1,18 @@
 #include "slang-com-helper.h"
 
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 
 #include <core/slang-com-object.h>
+#include <core/slang-persistent-cache.h>
+
+#include <string>
 
 namespace slang_llvm
 {
 
+class LLVMPersistentObjectCache;
+
 /// Disable the AVX-512 feature family on the JIT TargetMachine before LLJIT
 /// construction, **only when the SLANG_DISABLE_AVX512 environment variable
 /// is set to "1"**. Default is a no-op so production builds keep AVX-512
@@ -40,7 +46,39 @@ void disableAVX512ForJIT(llvm::orc::LLJITBuilder& jitBuilder);
 /// the environment; otherwise this is a plain `LLJITBuilder().create()`.
 /// Use this from every LLJIT construction site in slang-llvm so the
 /// mitigation can't be forgotten. See #11062.
-llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> createAVX512SafeLLJIT();
+///
+/// If `objectCache` is set, the JIT compiles modules through it, so object
+/// code from an earlier run is loaded instead of being generated again. The
+/// cache must outlive the returned LLJIT. A non-zero `compileThreadCount`
+/// lets the JIT compile separate modules on that many threads.
+llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> createAVX512SafeLLJIT(
+    LLVMPersistentObjectCache* objectCache = nullptr,
+    unsigned compileThreadCount = 0);
+
+/// An LLVM object cache that stores the JIT's object code in a `PersistentCache` on disk.
+/// Entries are keyed on the module's LLVM IR, its target triple and data layout, the JIT's
+/// CPU and features, and the LLVM version, so a stale entry is never picked up.
+class LLVMPersistentObjectCache : public llvm::ObjectCache
+{
+public:
+    LLVMPersistentObjectCache(Slang::PersistentCache* cache)
+        : m_cache(cache)
+    {
+    }
+
+    /// Set the CPU and features of the target machine the JIT compiles for.
+    void setTargetDescription(std::string desc) { m_targetDescription = std::move(desc); }
+
+    // llvm::ObjectCache impl
+    void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) override;
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+protected:
+    Slang::PersistentCache::Key getKey(const llvm::Module* module);
+
+    Slang::RefPtr<Slang::PersistentCache> m_cache;
+    std::string m_targetDescription;
+};
 
 /* This implementation uses atomic ref counting to ensure the shared libraries lifetime can outlive
 the LLVMDownstreamCompileResult and the compilation that created it */
@@ -57,8 +95,10 @@ public:
     virtual SLANG_NO_THROW void* SLANG_MCALL findSymbolAddressByName(char const* name)
         SLANG_OVERRIDE;
 
-    LLVMJITSharedLibrary(std::unique_ptr<llvm::orc::LLJIT> jit)
-        : m_jit(std::move(jit))
+    LLVMJITSharedLibrary(
+        std::unique_ptr<llvm::orc::LLJIT> jit,
+        std::unique_ptr<LLVMPersistentObjectCache> objectCache = nullptr)
+        : m_objectCache(std::move(objectCache)), m_jit(std::move(jit))
     {
     }
 
@@ -66,6 +106,8 @@ protected:
     ISlangUnknown* getInterface(const SlangUUID& uuid);
     void* getObject(const SlangUUID& uuid);
 
+    // Declared before the JIT, so it is destroyed after the JIT that uses it.
+    std::unique_ptr<LLVMPersistentObjectCache> m_objectCache;
     std::unique_ptr<llvm::orc::LLJIT> m_jit;
 };
 
@@ -566,6 +566,64 @@ public:
         REPLAY_UNIMPLEMENTED_X("ComponentTypeProxy::getTargetHostCallable");
     }
 
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        slang::SpecializationArg const* specializationArgs,
+        SlangInt specializationArgCount,
+        SlangInt permutationCount,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) override
+    {
+        SLANG_UNUSED(entryPointIndex);
+        SLANG_UNUSED(targetIndex);
+        SLANG_UNUSED(specializationArgs);
+        SLANG_UNUSED(specializationArgCount);
+        SLANG_UNUSED(permutationCount);
+        SLANG_UNUSED(outCodes);
+        SLANG_UNUSED(outDiagnostics);
+        REPLAY_UNIMPLEMENTED_X("ComponentTypeProxy::compileEntryPointPermutations");
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) override
+    {
+        SLANG_UNUSED(entryPointIndex);
+        SLANG_UNUSED(targetIndex);
+        SLANG_UNUSED(callback);
+        SLANG_UNUSED(userData);
+        SLANG_UNUSED(outFuture);
+        REPLAY_UNIMPLEMENTED_X("ComponentTypeProxy::getEntryPointCodeAsync");
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) override
+    {
+        SLANG_UNUSED(targetIndex);
+        SLANG_UNUSED(callback);
+        SLANG_UNUSED(userData);
+        SLANG_UNUSED(outFuture);
+        REPLAY_UNIMPLEMENTED_X("ComponentTypeProxy::getTargetCodeAsync");
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetIRHash(
+        SlangInt targetIndex,
+        slang::IBlob** outHash,
+        slang::IBlob** outDiagnostics) override
+    {
+        SLANG_UNUSED(targetIndex);
+        SLANG_UNUSED(outHash);
+        SLANG_UNUSED(outDiagnostics);
+        REPLAY_UNIMPLEMENTED_X("ComponentTypeProxy::getTargetIRHash");
+    }
+
     // =========================================================================
     // IModulePrecompileService_Experimental
     // =========================================================================
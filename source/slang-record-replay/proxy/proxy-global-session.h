@@ -397,6 +397,25 @@ public:
         SLANG_UNUSED(outBlob);
         REPLAY_UNIMPLEMENTED_X("GlobalSessionProxy::saveBuiltinModule");
     }
+
+    virtual SLANG_NO_THROW void SLANG_MCALL setJobScheduler(ISlangJobScheduler* scheduler) override
+    {
+        SLANG_UNUSED(scheduler);
+        REPLAY_UNIMPLEMENTED_X("GlobalSessionProxy::setJobScheduler");
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getJobScheduler(ISlangJobScheduler** outScheduler) override
+    {
+        SLANG_UNUSED(outScheduler);
+        REPLAY_UNIMPLEMENTED_X("GlobalSessionProxy::getJobScheduler");
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getMemoryUsage(SlangMemoryUsage* outUsage) override
+    {
+        return getActual<slang::IGlobalSession>()->getMemoryUsage(outUsage);
+    }
 };
 
 } // namespace SlangRecord
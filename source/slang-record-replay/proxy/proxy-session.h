@@ -334,6 +334,23 @@ public:
     {
         return getActual<slang::ISession>()->getDeclSourceLocation(decl, outLocation);
     }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getMemoryUsage(SlangMemoryUsage* outUsage) override
+    {
+        return getActual<slang::ISession>()->getMemoryUsage(outUsage);
+    }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL invalidateChangedFiles(
+        const char* const* filePaths,
+        SlangInt filePathCount,
+        SlangInt* outUnloadedModuleCount) override
+    {
+        return getActual<slang::ISession>()->invalidateChangedFiles(
+            filePaths,
+            filePathCount,
+            outUnloadedModuleCount);
+    }
 };
 
 } // namespace SlangRecord
@@ -577,7 +577,8 @@ void ReplayContext::record(RecordFlag flags, SlangGlobalSessionDesc& value)
     record(flags, value.apiVersion);
     record(flags, value.minLanguageVersion);
     record(flags, value.enableGLSL);
-    for (int i = 0; i < 16; ++i)
+    record(flags, value.jobThreadCount);
+    for (int i = 0; i < 15; ++i)
         record(flags, value.reserved[i]);
 }
 
@@ -13,6 +13,7 @@
 #include <cinttypes>
 #include <cstdio>
 #include <mutex>
+#include <random>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -40,6 +41,40 @@ static bool isRecordLogRequested()
     return false;
 }
 
+static bool isEnvironmentFlagSet(const char* name)
+{
+    Slang::StringBuilder envValue;
+    if (SLANG_SUCCEEDED(Slang::PlatformUtil::getEnvironmentVariable(
+            Slang::UnownedStringSlice(name),
+            envValue)))
+    {
+        return envValue == "1";
+    }
+    return false;
+}
+
+// SLANG_RECORD_SAMPLE_PERCENT=<0-100> makes SLANG_RECORD_LAYER=1 only record that percentage of
+// processes, so recording can be left enabled across a large number of compiles.
+static bool isProcessSampledForRecording()
+{
+    Slang::StringBuilder envValue;
+    if (SLANG_FAILED(Slang::PlatformUtil::getEnvironmentVariable(
+            Slang::UnownedStringSlice("SLANG_RECORD_SAMPLE_PERCENT"),
+            envValue)) ||
+        envValue.getLength() == 0)
+    {
+        return true;
+    }
+    const double percent = Slang::stringToDouble(envValue);
+    if (percent >= 100.0)
+        return true;
+    if (percent <= 0.0)
+        return false;
+    std::random_device device;
+    std::uniform_real_distribution<double> distribution(0.0, 100.0);
+    return distribution(device) < percent;
+}
+
 bool isRecordLayerRequested()
 {
     Slang::StringBuilder envValue;
@@ -164,6 +199,8 @@ ReplayContext::ReplayContext()
     , m_mode(Mode::Idle)
     , m_ttyLogging(isRecordLogRequested())
 {
+    m_captureOptions.asyncWrite = isEnvironmentFlagSet("SLANG_RECORD_ASYNC");
+    m_captureOptions.compress = isEnvironmentFlagSet("SLANG_RECORD_COMPRESS");
     // Don't call setMode() here - CharEncoding may not be initialized yet.
     // The deferred setup will happen on first use via ensureInitialized().
 }
@@ -204,7 +241,7 @@ void ReplayContext::ensureInitialized()
     m_initialized = true;
 
     // Now it's safe to use file system operations (CharEncoding is initialized)
-    if (m_mode == Mode::Idle && isRecordLayerRequested())
+    if (m_mode == Mode::Idle && isRecordLayerRequested() && isProcessSampledForRecording())
     {
         setMode(Mode::Record);
     }
@@ -224,6 +261,7 @@ void ReplayContext::reset()
     m_proxyToImpl.clear();
     m_implToProxy.clear();
     m_currentThisHandle = kNullHandle;
+    m_lastCallSignature = nullptr;
     // Note: m_handlers is intentionally NOT cleared - they're typically registered once
 }
 
@@ -238,6 +276,7 @@ void ReplayContext::switchToPlayback()
     m_proxyToImpl.clear();
     m_implToProxy.clear();
     m_currentThisHandle = kNullHandle;
+    m_lastCallSignature = nullptr;
 
     // Switch stream to reading mode and reset position to 0
     m_stream.setReading(true);
@@ -261,6 +300,7 @@ void ReplayContext::switchToSync()
     m_proxyToImpl.clear();
     m_implToProxy.clear();
     m_currentThisHandle = kNullHandle;
+    m_lastCallSignature = nullptr;
 
     // Reset main stream for new recording that will be verified against reference
     m_stream.reset();
@@ -311,6 +351,11 @@ void ReplayContext::setReplayDirectory(const char* path)
     m_replayDirectory = path ? path : ".slang-replays";
 }
 
+void ReplayContext::setCaptureOptions(const CaptureOptions& options)
+{
+    m_captureOptions = options;
+}
+
 const char* ReplayContext::getReplayDirectory() const
 {
     return m_replayDirectory.getBuffer();
@@ -382,10 +427,18 @@ void ReplayContext::setupRecordingMirror()
     }
 
     // Set up mirror file for main stream
+    const bool isAsync = m_captureOptions.asyncWrite || m_captureOptions.compress;
+    ReplayStreamWriter::Options writerOptions;
+    writerOptions.ringBufferSize = m_captureOptions.ringBufferSize;
+    writerOptions.compress = m_captureOptions.compress;
+
     String streamPath = Path::combine(m_currentReplayPath, "stream.bin");
     try
     {
-        m_stream.setMirrorFile(streamPath.getBuffer());
+        if (isAsync)
+            m_stream.setAsyncMirrorFile(streamPath.getBuffer(), writerOptions);
+        else
+            m_stream.setMirrorFile(streamPath.getBuffer());
     }
     catch (const Slang::Exception&)
     {
@@ -398,7 +451,10 @@ void ReplayContext::setupRecordingMirror()
     String indexPath = Path::combine(m_currentReplayPath, "index.bin");
     try
     {
-        m_indexStream.setMirrorFile(indexPath.getBuffer());
+        if (isAsync)
+            m_indexStream.setAsyncMirrorFile(indexPath.getBuffer(), writerOptions);
+        else
+            m_indexStream.setMirrorFile(indexPath.getBuffer());
     }
     catch (const Slang::Exception&)
     {
@@ -823,7 +879,7 @@ bool ReplayContext::executeNextCall()
         return false;
 
     // Look up the handler
-    PlaybackHandler* handler = m_handlers.tryGetValue(String(signature));
+    PlaybackHandler* handler = m_handlers.tryGetValue(signature);
     if (!handler)
     {
         throw Slang::Exception(String("No handler registered for function: ") + signature);
@@ -843,6 +899,7 @@ bool ReplayContext::executeNextCall()
 
     // Store the current 'this' handle for the handler to use
     m_currentThisHandle = thisHandle;
+    m_lastCallSignature = signature;
 
     // Seek back to the start of the command before calling the handler.
     m_stream.seek(streamPos);
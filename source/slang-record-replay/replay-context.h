@@ -320,6 +320,27 @@ public:
     /// Returns empty string if no replays found.
     SLANG_API static String findLatestReplayFolder(const char* baseDir);
 
+    /// How a recording is written to its folder.
+    struct CaptureOptions
+    {
+        /// If true, the recording is written by a background thread, so recording a call only
+        /// copies its data into a ring buffer. Whatever the writer hasn't reached is lost if the
+        /// process crashes. Can also be enabled with SLANG_RECORD_ASYNC=1.
+        bool asyncWrite = false;
+        /// If true, the recording is LZ4 compressed on the writer thread. Implies `asyncWrite`.
+        /// Can also be enabled with SLANG_RECORD_COMPRESS=1.
+        bool compress = false;
+        /// Size of the ring buffer used when writing asynchronously.
+        size_t ringBufferSize = 4 * 1024 * 1024;
+    };
+
+    /// Set how recordings are written.
+    /// Must be called before enabling recording.
+    SLANG_API void setCaptureOptions(const CaptureOptions& options);
+
+    /// Get how recordings are written.
+    SLANG_API const CaptureOptions& getCaptureOptions() const { return m_captureOptions; }
+
     // =========================================================================
     // Recording
     // =========================================================================
@@ -640,6 +661,10 @@ public:
     /// Check if there are more calls to execute.
     SLANG_API bool hasMoreCalls() const { return !m_stream.atEnd(); }
 
+    /// Get the signature of the call most recently run by executeNextCall(), or nullptr.
+    /// The string is owned by the context's arena, so is only valid until the next reset.
+    SLANG_API const char* getLastCallSignature() const { return m_lastCallSignature; }
+
     /// Get the 'this' handle for the current call being executed.
     /// Only valid within a playback handler.
     SLANG_API uint64_t getCurrentThisHandle() const { return m_currentThisHandle; }
@@ -710,6 +735,7 @@ private:
     // Replay directory management
     String m_replayDirectory = ".slang-replays"; ///< Base directory for replays
     String m_currentReplayPath;                  ///< Current recording session folder
+    CaptureOptions m_captureOptions;             ///< How recordings are written
 
     // TTY logging
     bool m_ttyLogging = false; ///< Whether to log calls to stderr
@@ -722,6 +748,8 @@ private:
 
     // Current 'this' handle during playback execution
     uint64_t m_currentThisHandle = kNullHandle;
+    // Signature of the call most recently started by executeNextCall()
+    const char* m_lastCallSignature = nullptr;
 };
 
 // Template implementations
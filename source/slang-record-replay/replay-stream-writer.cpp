@@ -0,0 +1,238 @@
+#include "replay-stream-writer.h"
+
+#include "../core/slang-compression-system.h"
+#include "../core/slang-lz4-compression-system.h"
+#include "../core/slang-math.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace SlangRecord
+{
+
+using Slang::ComPtr;
+using Slang::FileAccess;
+using Slang::FileMode;
+using Slang::FileShare;
+using Slang::FileStream;
+using Slang::List;
+using Slang::RefPtr;
+using Slang::String;
+
+// A compressed capture file starts with this header, followed by frames of a
+// `CompressedFrameHeader` and the frame's LZ4 data.
+static const char kCompressedMagic[4] = {'S', 'L', 'R', 'Z'};
+static const uint32_t kCompressedVersion = 1;
+
+struct CompressedFrameHeader
+{
+    uint32_t uncompressedSize;
+    uint32_t compressedSize;
+};
+
+// Data is compressed in frames of this size, so each frame compresses well and the
+// uncompressed size can be checked on load.
+static const size_t kFrameSize = 256 * 1024;
+
+SlangResult ReplayStreamWriter::open(const char* path, const Options& options)
+{
+    close();
+
+    RefPtr<FileStream> file = new FileStream();
+    SLANG_RETURN_ON_FAIL(
+        file->init(String(path), FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
+
+    m_compress = options.compress;
+    if (m_compress)
+    {
+        SLANG_RETURN_ON_FAIL(file->write(kCompressedMagic, sizeof(kCompressedMagic)));
+        SLANG_RETURN_ON_FAIL(file->write(&kCompressedVersion, sizeof(kCompressedVersion)));
+        m_frame.reserve(kFrameSize);
+    }
+
+    size_t ringSize = 4096;
+    while (ringSize < options.ringBufferSize)
+        ringSize *= 2;
+    m_ring.setCount(Slang::Index(ringSize));
+    m_ringMask = ringSize - 1;
+    m_writePos.store(0, std::memory_order_relaxed);
+    m_readPos.store(0, std::memory_order_relaxed);
+    m_stop.store(false, std::memory_order_relaxed);
+
+    m_file = file;
+    m_thread = std::thread([this]() { _run(); });
+    return SLANG_OK;
+}
+
+void ReplayStreamWriter::write(const void* data, size_t size)
+{
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    const size_t capacity = m_ringMask + 1;
+    uint64_t writePos = m_writePos.load(std::memory_order_relaxed);
+    while (size > 0)
+    {
+        const size_t used = size_t(writePos - m_readPos.load(std::memory_order_acquire));
+        const size_t available = capacity - used;
+        if (available == 0)
+        {
+            // The writer has fallen behind. Wake it, and wait for it to make room.
+            m_wake.notify_one();
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Copy as much as fits, in at most two pieces if it wraps around the end of the ring.
+        const size_t count = Slang::Math::Min(size, available);
+        const size_t offset = size_t(writePos) & m_ringMask;
+        const size_t firstCount = Slang::Math::Min(count, capacity - offset);
+        std::memcpy(m_ring.getBuffer() + offset, src, firstCount);
+        std::memcpy(m_ring.getBuffer(), src + firstCount, count - firstCount);
+
+        writePos += count;
+        m_writePos.store(writePos, std::memory_order_release);
+        src += count;
+        size -= count;
+    }
+}
+
+void ReplayStreamWriter::close()
+{
+    if (!m_file)
+        return;
+
+    m_stop.store(true, std::memory_order_release);
+    {
+        // Take the lock so the writer can't miss the wake between checking `m_stop` and
+        // waiting.
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    if (m_compress)
+        _writeFrame();
+    m_file->close();
+    m_file = nullptr;
+    m_ring = List<uint8_t>();
+}
+
+void ReplayStreamWriter::_run()
+{
+    const size_t capacity = m_ringMask + 1;
+    for (;;)
+    {
+        const uint64_t readPos = m_readPos.load(std::memory_order_relaxed);
+        const uint64_t writePos = m_writePos.load(std::memory_order_acquire);
+        if (readPos == writePos)
+        {
+            if (m_stop.load(std::memory_order_acquire))
+                break;
+
+            // The ring is empty, so this is a good time to get what has been written so far
+            // to disk, in case the process crashes.
+            m_file->flush();
+
+            // Recording doesn't signal every write, so poll as well as waiting for a wake.
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            if (!m_stop.load(std::memory_order_acquire))
+                m_wake.wait_for(lock, std::chrono::milliseconds(2));
+            continue;
+        }
+
+        const size_t count = size_t(writePos - readPos);
+        const size_t offset = size_t(readPos) & m_ringMask;
+        const size_t firstCount = Slang::Math::Min(count, capacity - offset);
+        _writeToFile(m_ring.getBuffer() + offset, firstCount);
+        _writeToFile(m_ring.getBuffer(), count - firstCount);
+
+        m_readPos.store(writePos, std::memory_order_release);
+    }
+}
+
+void ReplayStreamWriter::_writeToFile(const uint8_t* data, size_t size)
+{
+    if (!m_compress)
+    {
+        if (size)
+            m_file->write(data, size);
+        return;
+    }
+
+    while (size > 0)
+    {
+        const size_t count = Slang::Math::Min(size, kFrameSize - size_t(m_frame.getCount()));
+        m_frame.addRange(data, Slang::Index(count));
+        data += count;
+        size -= count;
+        if (size_t(m_frame.getCount()) == kFrameSize)
+            _writeFrame();
+    }
+}
+
+void ReplayStreamWriter::_writeFrame()
+{
+    if (m_frame.getCount() == 0)
+        return;
+
+    Slang::CompressionStyle style;
+    style.m_type = Slang::CompressionStyle::Type::BestSpeed;
+    ComPtr<ISlangBlob> compressed;
+    if (SLANG_SUCCEEDED(Slang::LZ4CompressionSystem::getSingleton()->compress(
+            &style,
+            m_frame.getBuffer(),
+            size_t(m_frame.getCount()),
+            compressed.writeRef())))
+    {
+        CompressedFrameHeader header;
+        header.uncompressedSize = uint32_t(m_frame.getCount());
+        header.compressedSize = uint32_t(compressed->getBufferSize());
+        m_file->write(&header, sizeof(header));
+        m_file->write(compressed->getBufferPointer(), compressed->getBufferSize());
+    }
+    m_frame.clear();
+}
+
+bool ReplayStreamWriter::isCompressed(const uint8_t* data, size_t size)
+{
+    return size >= sizeof(kCompressedMagic) + sizeof(kCompressedVersion) &&
+           std::memcmp(data, kCompressedMagic, sizeof(kCompressedMagic)) == 0;
+}
+
+SlangResult ReplayStreamWriter::decompress(const uint8_t* data, size_t size, List<uint8_t>& outData)
+{
+    if (!isCompressed(data, size))
+        return SLANG_FAIL;
+
+    uint32_t version = 0;
+    std::memcpy(&version, data + sizeof(kCompressedMagic), sizeof(version));
+    if (version != kCompressedVersion)
+        return SLANG_E_NOT_IMPLEMENTED;
+
+    const uint8_t* cursor = data + sizeof(kCompressedMagic) + sizeof(version);
+    const uint8_t* end = data + size;
+
+    outData.clear();
+    auto compressionSystem = Slang::LZ4CompressionSystem::getSingleton();
+    while (size_t(end - cursor) >= sizeof(CompressedFrameHeader))
+    {
+        CompressedFrameHeader header;
+        std::memcpy(&header, cursor, sizeof(header));
+        cursor += sizeof(header);
+
+        // A capture cut short by a crash can end with a partial frame, which is dropped.
+        if (size_t(end - cursor) < header.compressedSize)
+            break;
+
+        const Slang::Index start = outData.getCount();
+        outData.setCount(start + header.uncompressedSize);
+        SLANG_RETURN_ON_FAIL(compressionSystem->decompress(
+            cursor,
+            header.compressedSize,
+            header.uncompressedSize,
+            outData.getBuffer() + start));
+        cursor += header.compressedSize;
+    }
+    return SLANG_OK;
+}
+
+} // namespace SlangRecord
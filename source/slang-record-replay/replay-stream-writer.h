@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../core/slang-list.h"
+#include "../core/slang-smart-pointer.h"
+#include "../core/slang-stream.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace SlangRecord
+{
+
+/// Writes a capture file on a background thread.
+///
+/// The recording thread copies data into a single-producer single-consumer ring buffer, which
+/// takes no locks, and a writer thread drains the ring to the file. This keeps file I/O, and
+/// compression if enabled, off the thread making API calls.
+///
+/// The ring never drops data, since a missing byte makes the rest of a capture unreadable. If
+/// the writer falls behind far enough to fill the ring, `write` waits for it to catch up.
+///
+/// Writes must be serialized by the caller, which `ReplayContext` does with its mutex.
+class ReplayStreamWriter : public Slang::RefObject
+{
+public:
+    struct Options
+    {
+        /// Size of the ring buffer in bytes, rounded up to a power of 2.
+        size_t ringBufferSize = 4 * 1024 * 1024;
+        /// If true, the file is written as LZ4 compressed frames.
+        bool compress = false;
+    };
+
+    /// Open `path` for writing and start the writer thread.
+    SLANG_API SlangResult open(const char* path, const Options& options);
+
+    /// Queue `size` bytes to be written.
+    SLANG_API void write(const void* data, size_t size);
+
+    /// Write everything that has been queued, stop the writer thread, and close the file.
+    SLANG_API void close();
+
+    bool isOpen() const { return m_file != nullptr; }
+
+    ~ReplayStreamWriter() { close(); }
+
+    /// Returns true if `data` starts with the header of a compressed capture file.
+    SLANG_API static bool isCompressed(const uint8_t* data, size_t size);
+
+    /// Decompress the contents of a compressed capture file.
+    SLANG_API static SlangResult decompress(
+        const uint8_t* data,
+        size_t size,
+        Slang::List<uint8_t>& outData);
+
+private:
+    void _run();
+    /// Called on the writer thread to write data taken from the ring.
+    void _writeToFile(const uint8_t* data, size_t size);
+    /// Compress and write the pending frame.
+    void _writeFrame();
+
+    Slang::List<uint8_t> m_ring;
+    size_t m_ringMask = 0;
+    // Total bytes written to and read from the ring. Only the recording thread advances
+    // `m_writePos` and only the writer thread advances `m_readPos`.
+    std::atomic<uint64_t> m_writePos{0};
+    std::atomic<uint64_t> m_readPos{0};
+    std::atomic<bool> m_stop{false};
+
+    // Only used to sleep the writer thread while the ring is empty.
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::thread m_thread;
+
+    Slang::RefPtr<Slang::FileStream> m_file;
+    bool m_compress = false;
+    Slang::List<uint8_t> m_frame;
+};
+
+} // namespace SlangRecord
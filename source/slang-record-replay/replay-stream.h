@@ -5,6 +5,7 @@
 #include "../core/slang-list.h"
 #include "../core/slang-stream.h"
 #include "../core/slang-string.h"
+#include "replay-stream-writer.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -69,6 +70,19 @@ public:
         if (SLANG_FAILED(result))
             throw Slang::Exception(String("Failed to open file for reading: ") + path);
 
+        // Captures written with compression are decompressed as they are loaded.
+        if (ReplayStreamWriter::isCompressed(contents.getBuffer(), size_t(contents.getCount())))
+        {
+            List<unsigned char> decompressed;
+            result = ReplayStreamWriter::decompress(
+                contents.getBuffer(),
+                size_t(contents.getCount()),
+                decompressed);
+            if (SLANG_FAILED(result))
+                throw Slang::Exception(String("Failed to decompress file: ") + path);
+            contents = Slang::_Move(decompressed);
+        }
+
         ReplayStream stream;
         stream.m_isReading = true;
         stream.m_buffer = Slang::_Move(contents);
@@ -115,7 +129,11 @@ public:
         m_position += size;
 
         // Mirror to file if enabled
-        if (m_mirrorFile)
+        if (m_asyncMirror)
+        {
+            m_asyncMirror->write(data, size);
+        }
+        else if (m_mirrorFile)
         {
             m_mirrorFile->write(data, size);
             m_mirrorFile->flush(); // Ensure data is written immediately
@@ -255,6 +273,27 @@ public:
         }
     }
 
+    /// Set a mirror file that is written on a background thread.
+    /// Writes only copy data into a ring buffer, so they are much cheaper than with
+    /// `setMirrorFile`, at the cost of losing whatever the writer hasn't reached if the
+    /// process crashes.
+    /// @param path Path to the mirror file.
+    /// @param options Ring buffer size, and whether to compress the file.
+    /// @throws Slang::Exception if file cannot be opened.
+    void setAsyncMirrorFile(const char* path, const ReplayStreamWriter::Options& options)
+    {
+        closeMirrorFile();
+
+        RefPtr<ReplayStreamWriter> writer = new ReplayStreamWriter();
+        if (SLANG_FAILED(writer->open(path, options)))
+            throw Slang::Exception(String("Failed to open mirror file: ") + path);
+        m_asyncMirror = writer;
+
+        // Write any existing data to the file
+        if (m_buffer.getCount() > 0)
+            m_asyncMirror->write(m_buffer.getBuffer(), m_buffer.getCount());
+    }
+
     /// Save all data to a file.
     /// @param path Path to the file to write.
     /// @throws Slang::Exception if file cannot be opened or written.
@@ -267,11 +306,17 @@ public:
     }
 
     /// Check if a mirror file is currently active.
-    bool hasMirrorFile() const { return m_mirrorFile != nullptr; }
+    bool hasMirrorFile() const { return m_mirrorFile != nullptr || m_asyncMirror != nullptr; }
 
     /// Close the mirror file (data remains in memory).
+    /// An async mirror file is completely written before this returns.
     void closeMirrorFile()
     {
+        if (m_asyncMirror)
+        {
+            m_asyncMirror->close();
+            m_asyncMirror = nullptr;
+        }
         if (m_mirrorFile)
         {
             m_mirrorFile->close();
@@ -303,6 +348,7 @@ private:
     size_t m_position = 0;
     bool m_isReading = false;
     mutable RefPtr<FileStream> m_mirrorFile;
+    RefPtr<ReplayStreamWriter> m_asyncMirror;
 };
 
 } // namespace SlangRecord
@@ -1,6 +1,7 @@
 #include "slang-rt.h"
 
 #include "../core/slang-basic.h"
+#include "../core/slang-job-scheduler.h"
 #include "../core/slang-shared-library.h"
 
 #if SLANG_WINDOWS_FAMILY
@@ -10,6 +11,19 @@
 using namespace Slang;
 Dictionary<String, ComPtr<ISlangSharedLibrary>> slangRT_loadedLibraries;
 
+// The worker pool for compute dispatches, created by the first dispatch. It is never
+// released, so that unloading the library at exit doesn't wait on its worker threads.
+static ISlangJobScheduler* _getComputeJobScheduler()
+{
+    static ISlangJobScheduler* scheduler = []()
+    {
+        ISlangJobScheduler* created = new JobScheduler(0);
+        created->addRef();
+        return created;
+    }();
+    return scheduler;
+}
+
 extern "C"
 {
     SLANG_RT_API void SLANG_MCALL _slang_rt_abort(Slang::String errorMessage)
@@ -59,4 +73,48 @@ extern "C"
         }
         return (void*)funcPtr;
     }
+
+    SLANG_RT_API void SLANG_MCALL _slang_rt_dispatch_compute(
+        SlangRTComputeFunc func,
+        const uint32_t groupCount[3],
+        void* entryPointParams,
+        void* globalParams,
+        uint32_t grainSize,
+        uint32_t threadCount)
+    {
+        const uint64_t rowSize = groupCount[0];
+        const uint64_t sliceSize = rowSize * groupCount[1];
+        const uint64_t totalGroupCount = sliceSize * groupCount[2];
+        if (totalGroupCount == 0)
+            return;
+
+        ISlangJobScheduler* scheduler = _getComputeJobScheduler();
+        if (grainSize == 0)
+        {
+            // Several jobs per thread let threads that finish early take work from the rest.
+            const uint64_t jobsWanted = uint64_t(scheduler->getThreadCount()) * 4;
+            grainSize = uint32_t(Math::Max<uint64_t>(1, totalGroupCount / jobsWanted));
+        }
+        const uint64_t jobCount = (totalGroupCount + grainSize - 1) / grainSize;
+
+        // A job runs a run of groups in the order of a serial dispatch, x first. The kernel
+        // takes a box of groups, so the run is split where it wraps to a new row.
+        auto runJob = [&](Index jobIndex)
+        {
+            uint64_t index = uint64_t(jobIndex) * grainSize;
+            const uint64_t end = Math::Min<uint64_t>(index + grainSize, totalGroupCount);
+            while (index < end)
+            {
+                const uint32_t x = uint32_t(index % rowSize);
+                const uint32_t y = uint32_t((index / rowSize) % groupCount[1]);
+                const uint32_t z = uint32_t(index / sliceSize);
+                const uint32_t count = uint32_t(Math::Min<uint64_t>(rowSize - x, end - index));
+
+                SlangRTComputeGroupRange range = {{x, y, z}, {x + count, y + 1, z + 1}};
+                func(&range, entryPointParams, globalParams);
+                index += count;
+            }
+        };
+        runJobs(scheduler, Count(jobCount), Count(threadCount), runJob);
+    }
 }
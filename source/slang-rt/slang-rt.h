@@ -22,12 +22,40 @@
 
 #define SLANG_PRELUDE_EXPORT extern "C" SLANG_PRELUDE_SHARED_LIB_EXPORT
 
+/// The range of groups passed to a compute kernel compiled for the CPU. It has the same layout
+/// as `ComputeVaryingInput` in the C++ prelude, and the end of the range is exclusive.
+struct SlangRTComputeGroupRange
+{
+    uint32_t startGroupID[3];
+    uint32_t endGroupID[3];
+};
+
+/// A compute kernel compiled for the CPU, as it is exported from the kernel's library.
+typedef void (*SlangRTComputeFunc)(
+    SlangRTComputeGroupRange* varyingInput,
+    void* entryPointParams,
+    void* globalParams);
+
 extern "C"
 {
     SLANG_RT_API void SLANG_MCALL _slang_rt_abort(Slang::String errorMessage);
     SLANG_RT_API void* SLANG_MCALL _slang_rt_load_dll(Slang::String modulePath);
     SLANG_RT_API void* SLANG_MCALL
     _slang_rt_load_dll_func(void* moduleHandle, Slang::String modulePath, uint32_t argSize);
+
+    /// Run `groupCount` groups of the CPU compute kernel `func`, spread over a pool of worker
+    /// threads that is shared by all dispatches. Each job runs `grainSize` consecutive groups
+    /// (0 picks a size that gives every thread several jobs), and at most `threadCount`
+    /// threads work on the dispatch at a time (0 for no limit). A group always runs all of its
+    /// threads on one worker, in the same order as a serial dispatch. Returns once all groups
+    /// have run.
+    SLANG_RT_API void SLANG_MCALL _slang_rt_dispatch_compute(
+        SlangRTComputeFunc func,
+        const uint32_t groupCount[3],
+        void* entryPointParams,
+        void* globalParams,
+        uint32_t grainSize,
+        uint32_t threadCount);
 }
 
 #endif
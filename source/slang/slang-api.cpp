@@ -2,6 +2,8 @@
 
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-platform.h"
+#include "../core/slang-process.h"
+#include "../core/slang-riff-file-system.h"
 #include "../core/slang-rtti-info.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-signal.h"
@@ -51,19 +53,29 @@ SlangResult tryLoadBuiltinModuleFromCache(
     {
         return SLANG_FAIL;
     }
-    Slang::ScopedAllocation cacheData;
-    SLANG_RETURN_ON_FAIL(Slang::File::readAllBytes(cacheFileName, cacheData));
+    // Map the cache rather than reading it, so that only the parts of the module that are
+    // actually deserialized get paged in.
+    Slang::ComPtr<ISlangBlob> cacheBlob;
+    SLANG_RETURN_ON_FAIL(Slang::File::mapAllBytes(cacheFileName, cacheBlob));
+    auto cacheData = (const uint8_t*)cacheBlob->getBufferPointer();
+    const size_t cacheSize = cacheBlob->getBufferSize();
 
     // The first 8 bytes stores the timestamp of the slang dll that created this core module cache.
-    if (cacheData.getSizeInBytes() < sizeof(uint64_t))
+    if (cacheSize < sizeof(uint64_t))
         return SLANG_FAIL;
-    auto cacheTimestamp = *(uint64_t*)(cacheData.getData());
+    uint64_t cacheTimestamp;
+    memcpy(&cacheTimestamp, cacheData, sizeof(cacheTimestamp));
     if (cacheTimestamp != currentLibTimestamp)
         return SLANG_FAIL;
-    SLANG_RETURN_ON_FAIL(globalSession->loadBuiltinModule(
-        builtinModuleName,
-        (uint8_t*)cacheData.getData() + sizeof(uint64_t),
-        cacheData.getSizeInBytes() - sizeof(uint64_t)));
+
+    // The archive follows the timestamp. The view keeps the mapping alive for as long as the
+    // module references it.
+    auto archiveBlob = Slang::ScopeBlob::create(
+        Slang::UnownedRawBlob::create(cacheData + sizeof(uint64_t), cacheSize - sizeof(uint64_t)),
+        cacheBlob);
+    auto internalSession = Slang::asInternal(globalSession);
+    SLANG_RETURN_ON_FAIL(
+        internalSession->loadBuiltinModuleFromBlob(builtinModuleName, archiveBlob));
     return SLANG_OK;
 }
 
@@ -129,6 +141,32 @@ SlangResult tryLoadBuiltinModuleFromDLL(
     return SLANG_OK;
 }
 
+// Write `archiveBlob` to the builtin module cache file, stamped with `dllTimestamp`.
+static SlangResult _writeBuiltinModuleCache(
+    ISlangBlob* archiveBlob,
+    const Slang::String& cacheFilename,
+    uint64_t dllTimestamp)
+{
+    // Another process may have the current cache mapped, so rather than rewrite it in place
+    // we write a new file and swap it in.
+    Slang::String tempFilename =
+        cacheFilename + "." + Slang::String(Slang::Process::getId()) + ".tmp";
+    {
+        Slang::FileStream fileStream;
+        SLANG_RETURN_ON_FAIL(fileStream.init(tempFilename, Slang::FileMode::Create));
+
+        SLANG_RETURN_ON_FAIL(fileStream.write(&dllTimestamp, sizeof(dllTimestamp)));
+        SLANG_RETURN_ON_FAIL(
+            fileStream.write(archiveBlob->getBufferPointer(), archiveBlob->getBufferSize()))
+    }
+    if (SLANG_FAILED(Slang::File::rename(tempFilename, cacheFilename)))
+    {
+        Slang::File::remove(tempFilename);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
 SlangResult trySaveBuiltinModuleToCache(
     slang::IGlobalSession* globalSession,
     slang::BuiltinModuleName builtinModuleName,
@@ -137,24 +175,73 @@ SlangResult trySaveBuiltinModuleToCache(
 {
     if (dllTimestamp != 0 && cacheFilename.getLength() != 0)
     {
+        // The cache is stored uncompressed, so that when it is mapped the module can be
+        // deserialized directly from the file's pages without first decompressing a copy.
         Slang::ComPtr<ISlangBlob> coreModuleBlobPtr;
         SLANG_RETURN_ON_FAIL(globalSession->saveBuiltinModule(
             builtinModuleName,
-            SLANG_ARCHIVE_TYPE_RIFF_LZ4,
+            SLANG_ARCHIVE_TYPE_RIFF,
             coreModuleBlobPtr.writeRef()));
 
-        Slang::FileStream fileStream;
-        SLANG_RETURN_ON_FAIL(fileStream.init(cacheFilename, Slang::FileMode::Create));
-
-        SLANG_RETURN_ON_FAIL(fileStream.write(&dllTimestamp, sizeof(dllTimestamp)));
-        SLANG_RETURN_ON_FAIL(fileStream.write(
-            coreModuleBlobPtr->getBufferPointer(),
-            coreModuleBlobPtr->getBufferSize()))
+        SLANG_RETURN_ON_FAIL(
+            _writeBuiltinModuleCache(coreModuleBlobPtr, cacheFilename, dllTimestamp));
     }
 
     return SLANG_OK;
 }
 
+// Load an embedded builtin module through the mapped cache file, if the embedded module is
+// compressed.
+//
+// A compressed module has to be decompressed before it can be read, which leaves every process
+// with a private copy of it. The cache holds it uncompressed, so all of the processes mapping
+// it read the module in place from the same shared pages. If there is no up to date cache, one
+// is written from a decompressed copy of the embedded archive, which is much cheaper than
+// serializing the loaded module again.
+SlangResult tryLoadEmbeddedBuiltinModuleFromCache(
+    slang::IGlobalSession* globalSession,
+    slang::BuiltinModuleName builtinModuleName,
+    ISlangBlob* embeddedBlob)
+{
+    const void* data = embeddedBlob->getBufferPointer();
+    const size_t size = embeddedBlob->getBufferSize();
+    if (!Slang::RiffFileSystem::isArchive(data, size))
+        return SLANG_FAIL;
+
+    auto archive = new Slang::RiffFileSystem(nullptr);
+    Slang::ComPtr<ISlangMutableFileSystem> archiveFileSystem(archive);
+    SLANG_RETURN_ON_FAIL(archive->loadArchiveBlob(embeddedBlob));
+    if (!archive->isCompressed())
+    {
+        // The embedded data can already be read in place, and it's shared as part of the image
+        return SLANG_FAIL;
+    }
+
+    Slang::String cacheFilename;
+    uint64_t dllTimestamp = 0;
+    if (SLANG_SUCCEEDED(tryLoadBuiltinModuleFromCache(
+            globalSession,
+            builtinModuleName,
+            cacheFilename,
+            dllTimestamp)))
+    {
+        return SLANG_OK;
+    }
+    if (dllTimestamp == 0)
+        return SLANG_FAIL;
+
+    Slang::ComPtr<ISlangBlob> uncompressedBlob;
+    SLANG_RETURN_ON_FAIL(archive->decompressAll());
+    SLANG_RETURN_ON_FAIL(archive->storeArchive(true, uncompressedBlob.writeRef()));
+    SLANG_RETURN_ON_FAIL(_writeBuiltinModuleCache(uncompressedBlob, cacheFilename, dllTimestamp));
+
+    return tryLoadBuiltinModuleFromCache(
+        globalSession,
+        builtinModuleName,
+        cacheFilename,
+        dllTimestamp);
+}
+
 SLANG_API SlangResult
 slang_createGlobalSession(SlangInt apiVersion, slang::IGlobalSession** outGlobalSession)
 {
@@ -178,14 +265,28 @@ SLANG_API SlangResult slang_createGlobalSessionImpl(
 
     SLANG_RETURN_ON_FAIL(
         slang_createGlobalSessionWithoutCoreModule(desc->apiVersion, globalSession.writeRef()));
+    Slang::asInternal(globalSession)->m_jobThreadCount = desc->jobThreadCount;
 
     // If we have the embedded core module, load from that, else compile it
     ISlangBlob* coreModuleBlob = slang_getEmbeddedCoreModule();
     if (coreModuleBlob)
     {
-        SLANG_RETURN_ON_FAIL(globalSession->loadCoreModule(
-            coreModuleBlob->getBufferPointer(),
-            coreModuleBlob->getBufferSize()));
+        SlangResult loadFromCacheResult = SLANG_FAIL;
+        if (!internalDesc->isBootstrap)
+        {
+            loadFromCacheResult = tryLoadEmbeddedBuiltinModuleFromCache(
+                globalSession,
+                slang::BuiltinModuleName::Core,
+                coreModuleBlob);
+        }
+        if (SLANG_FAILED(loadFromCacheResult))
+        {
+            // The embedded data is static, so the module can reference it without a copy.
+            auto internalSession = Slang::asInternal(globalSession);
+            SLANG_RETURN_ON_FAIL(internalSession->loadBuiltinModuleFromBlob(
+                slang::BuiltinModuleName::Core,
+                coreModuleBlob));
+        }
     }
     else
     {
@@ -1154,6 +1255,8 @@ slang_writeCoverageManifestJson(slang::ICoverageTracingMetadata* metadata, ISlan
         out << ",\n    \"space\": " << (int64_t)bufferInfo.space;
     if (bufferInfo.binding >= 0)
         out << ",\n    \"binding\": " << (int64_t)bufferInfo.binding;
+    out << ",\n    \"mode\": \""
+        << (bufferInfo.mode == SLANG_COVERAGE_MODE_HIT ? "hit" : "count") << "\"";
     out << "\n  },\n";
     out << "  \"entries\": [";
     for (uint32_t i = 0; i < counterCount; ++i)
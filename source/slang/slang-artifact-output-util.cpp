@@ -255,7 +255,7 @@ static SlangResult _requireBlob(
     ComPtr<ISlangBlob> blob;
     SLANG_RETURN_ON_FAIL(_requireBlob(artifact, sink, blob));
 
-    const auto res = writeToFile(artifact, path);
+    const auto res = writeToFile(artifact->getDesc(), blob, path);
     if (SLANG_FAILED(res) && sink)
     {
         sink->diagnose(Diagnostics::CannotWriteOutputFile{.path = path});
@@ -488,6 +488,12 @@ protected:
     Val* defaultResolveImpl();
 
 private:
+    /// The value of `m_resolvedValEpoch` for a val whose resolution holds in every epoch.
+    static const Index kEpochIndependentResolvedValEpoch = -1;
+
+    /// Can no later epoch change what this val, which resolved to itself, resolves to?
+    bool _isResolutionEpochIndependent();
+
     mutable Val* m_resolvedVal = nullptr;
     mutable Index m_resolvedValEpoch = 0;
 };
@@ -212,6 +212,7 @@ ASTBuilder::ASTBuilder(ASTBuilder* parent, String const& debugName)
     : m_parent(parent), m_name(debugName), m_arena(kASTBuilderMemoryArenaBlockSize)
 {
     SLANG_ASSERT(parent);
+    m_arena.setCategory(MemoryArenaCategory::AST);
     auto sharedASTBuilder = parent->getSharedASTBuilder();
     SLANG_ASSERT(sharedASTBuilder);
 
@@ -224,6 +225,7 @@ ASTBuilder::ASTBuilder(ASTBuilder* parent, String const& debugName)
 ASTBuilder::ASTBuilder()
     : m_arena(kASTBuilderMemoryArenaBlockSize)
 {
+    m_arena.setCategory(MemoryArenaCategory::AST);
 }
 
 RootASTBuilder::RootASTBuilder(Session* globalSession)
@@ -425,6 +427,11 @@ Val* ASTBuilder::_getOrCreateValDirectly(ValNodeDesc&& desc)
     //
     auto node = as<Val>(desc.type.createInstance(this));
     SLANG_ASSERT(node);
+
+    // `Val`s are by far the most numerous nodes, and most have only a couple of operands.
+    // Reserving the exact count avoids the default initial capacity of a `List`, which would
+    // otherwise make every operand list many times larger than its contents.
+    node->m_operands.reserve(desc.operands.getCount());
     for (auto& operand : desc.operands)
         node->m_operands.add(operand);
 
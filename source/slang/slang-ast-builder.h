@@ -198,6 +198,34 @@ struct ValKeyEqual
     bool operator()(const Slang::ValNodeDesc& a, const Slang::ValKey& b) const { return b == a; }
 };
 
+/// Identifies the application of a substitution set to a `Val`.
+struct SubstitutionCacheKey
+{
+    Val* val = nullptr;
+    DeclRefBase* substDeclRef = nullptr;
+    int packExpansionIndex = -1;
+
+    HashCode getHashCode() const
+    {
+        return combineHash(
+            Slang::getHashCode(val),
+            Slang::getHashCode(substDeclRef),
+            Slang::getHashCode(packExpansionIndex));
+    }
+    bool operator==(const SubstitutionCacheKey& other) const
+    {
+        return val == other.val && substDeclRef == other.substDeclRef &&
+               packExpansionIndex == other.packExpansionIndex;
+    }
+};
+
+/// The result of applying a substitution set to a `Val`, and whether it changed the `Val`.
+struct SubstitutionCacheEntry
+{
+    Val* result = nullptr;
+    bool changed = false;
+};
+
 class ASTBuilder : public RefObject
 {
     friend class SharedASTBuilder;
@@ -895,6 +923,16 @@ protected:
     /// Cache for CapabilitySet::freeze() to avoid recreating identical CapabilitySetVal objects
     Dictionary<CapabilitySet, CapabilitySetVal*> m_capabilitySetCache;
 
+    /// Cache for `getMangledName()`, keyed on `DeclRef`s owned by this builder or its ancestors
+    Dictionary<DeclRefBase*, String> m_mangledNameCache;
+
+    /// Cache for `Val::substituteImpl()`.
+    ///
+    /// Substitution can resolve the vals it creates, so the entries are only valid for the
+    /// epoch they were created in, which is recorded in `m_substitutionCacheEpoch`.
+    Dictionary<SubstitutionCacheKey, SubstitutionCacheEntry> m_substitutionCache;
+    Index m_substitutionCacheEpoch = -1;
+
     MemoryArena m_arena;
 };
 
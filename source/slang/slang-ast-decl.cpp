@@ -209,6 +209,7 @@ bool ContainerDeclDirectMemberDecls::_areLookupAcceleratorsValid() const
 void ContainerDeclDirectMemberDecls::_invalidateLookupAccelerators() const
 {
     accelerators.declCountWhenLastUpdated = -1;
+    modificationCount++;
 }
 
 void ContainerDeclDirectMemberDecls::_ensureLookupAcceleratorsAreValid() const
@@ -372,6 +373,12 @@ void ContainerDecl::addDirectMemberDecl(Decl* decl)
 
     decl->parentDecl = this;
     _directMemberDecls.decls.add(decl);
+    _directMemberDecls.modificationCount++;
+}
+
+UInt ContainerDecl::getDirectMemberDeclsModificationCount()
+{
+    return _directMemberDecls.getModificationCount();
 }
 
 List<Decl*> const& ContainerDecl::getTransparentDirectMemberDecls()
@@ -48,6 +48,9 @@ public:
 
     List<Decl*> const& getTransparentDecls() const;
 
+    /// Get a count that changes whenever declarations are added, removed, or replaced.
+    UInt getModificationCount() const { return modificationCount; }
+
     bool isUsingOnDemandDeserialization() const;
 
     void _initForOnDemandDeserialization(
@@ -72,6 +75,8 @@ private:
 
     mutable List<Decl*> decls;
 
+    mutable UInt modificationCount = 0;
+
     mutable struct
     {
         Count declCountWhenLastUpdated = 0;
@@ -202,6 +207,14 @@ class ContainerDecl : public Decl
     ///
     void addDirectMemberDecl(Decl* decl);
 
+    /// Get a count that changes whenever direct member declarations are added to, removed
+    /// from, or replaced in this container decl.
+    ///
+    /// Caches of lookup results can record this to detect members synthesized after the
+    /// lookup was performed.
+    ///
+    UInt getDirectMemberDeclsModificationCount();
+
     /// Get the subset of direct member declarations that are "transparent."
     ///
     /// Transparent members will themselves be considered when performing
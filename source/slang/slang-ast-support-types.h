@@ -1541,6 +1541,11 @@ FIDDLE() namespace Slang
         LookupMask mask = LookupMask::Default;
         LookupOptions options = LookupOptions::None;
 
+        // If set, every container decl whose direct members are searched is added to this
+        // list, with its modification count when it was searched, so that a cached result can
+        // be checked against later changes to them.
+        List<KeyValuePair<ContainerDecl*, UInt>>* outSearchedContainers = nullptr;
+
         bool isCompletionRequest() const
         {
             return (options & LookupOptions::Completion) != LookupOptions::None;
@@ -37,13 +37,59 @@ Val* Val::substitute(ASTBuilder* astBuilder, SubstitutionSet subst)
 {
     if (!subst)
         return this;
+
+    // A substitution set that has neither generic arguments nor a `This` type lookup, and
+    // isn't expanding a pack, has nothing to replace, so there is no need to walk the val.
+    if (subst.packExpansionIndex < 0 && !subst.getInnerMostNodeWithSubstInfo())
+        return this;
+
     int diff = 0;
     return substituteImpl(astBuilder, subst, &diff);
 }
 
+static Val* _substituteImpl(Val* val, ASTBuilder* astBuilder, SubstitutionSet subst, int* ioDiff)
+{
+    return ASTNodeDispatcher<Val, Val*>::dispatch(
+        val,
+        [&](auto _this) -> Val*
+        { return _this->_substituteImplOverride(astBuilder, subst, ioDiff); });
+}
+
 Val* Val::substituteImpl(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioDiff)
 {
-    SLANG_AST_NODE_VIRTUAL_CALL(Val, substituteImpl, (astBuilder, subst, ioDiff))
+    if (!astBuilder || !subst)
+        return _substituteImpl(this, astBuilder, subst, ioDiff);
+
+    // Generic code applies the same substitutions to the same vals over and over, so the
+    // results are cached on the AST builder that creates them.
+    auto epoch = astBuilder->getEpoch();
+    if (astBuilder->m_substitutionCacheEpoch != epoch)
+    {
+        astBuilder->m_substitutionCache.clear();
+        astBuilder->m_substitutionCacheEpoch = epoch;
+    }
+
+    SubstitutionCacheKey key;
+    key.val = this;
+    key.substDeclRef = subst.declRef;
+    key.packExpansionIndex = subst.packExpansionIndex;
+    if (auto cached = astBuilder->m_substitutionCache.tryGetValue(key))
+    {
+        if (cached->changed)
+            (*ioDiff)++;
+        return cached->result;
+    }
+
+    int diff = 0;
+    auto result = _substituteImpl(this, astBuilder, subst, &diff);
+    if (diff)
+        (*ioDiff)++;
+
+    SubstitutionCacheEntry entry;
+    entry.result = result;
+    entry.changed = diff != 0;
+    astBuilder->m_substitutionCache[key] = entry;
+    return result;
 }
 
 void Val::toText(StringBuilder& out){SLANG_AST_NODE_VIRTUAL_CALL(Val, toText, (out))}
@@ -58,13 +104,37 @@ Val* Val::resolveImpl()
     SLANG_AST_NODE_VIRTUAL_CALL(Val, resolveImpl, ());
 }
 
+bool Val::_isResolutionEpochIndependent()
+{
+    // The epoch is bumped when new witness tables are created, which only changes the
+    // resolution of vals that look up a requirement through a witness somewhere inside them.
+    // Decl-refs and decl-ref types built only out of direct references, member references and
+    // generic applications whose own operands are epoch independent resolve to themselves
+    // however many witness tables there are.
+    //
+    if (as<DirectDeclRef>(this) || as<ConstantIntVal>(this))
+        return true;
+    if (!as<MemberDeclRef>(this) && !as<GenericAppDeclRef>(this) && !as<DeclRefType>(this))
+        return false;
+    for (auto operand : m_operands)
+    {
+        if (operand.kind != ValNodeOperandKind::ValNode)
+            continue;
+        auto valOperand = as<Val>(operand.values.nodeOperand);
+        if (valOperand && valOperand->m_resolvedValEpoch != kEpochIndependentResolvedValEpoch)
+            return false;
+    }
+    return true;
+}
+
 Val* Val::resolve()
 {
     auto astBuilder = getCurrentASTBuilder();
     // If we are not in a proper checking context, just return the previously resolved val.
     if (!astBuilder)
         return m_resolvedVal ? m_resolvedVal : this;
-    if (m_resolvedVal && m_resolvedValEpoch == astBuilder->getEpoch())
+    if (m_resolvedVal && (m_resolvedValEpoch == astBuilder->getEpoch() ||
+                          m_resolvedValEpoch == kEpochIndependentResolvedValEpoch))
     {
         SLANG_ASSERT(as<Val>(m_resolvedVal));
         return m_resolvedVal;
@@ -79,6 +149,11 @@ Val* Val::resolve()
             "should not be modifying the core module vals outside of the core module checking.");
     }
 #endif
+
+    // A val that resolves to itself in a way that no later epoch can change doesn't need to
+    // be resolved again when the epoch is bumped.
+    if (m_resolvedVal == this && _isResolutionEpochIndependent())
+        m_resolvedValEpoch = kEpochIndependentResolvedValEpoch;
     return m_resolvedVal;
 }
 
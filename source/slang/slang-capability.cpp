@@ -67,6 +67,12 @@ struct CapabilityAtomInfo
 
     /// Canonical representation of atoms in the form of disjoint conjunctions of atoms.
     ArrayView<CapabilityAtomSet*> canonicalRepresentation;
+
+    /// Every atom that this atom is derived from, including itself.
+    ///
+    /// This is the union of the sets in `canonicalRepresentation`, precomputed by the
+    /// capability generator so that derivation tests are a single set lookup.
+    CapabilityAtomSet* impliedAtoms;
 };
 
 #include "slang-generated-capability-defs-impl.h"
@@ -212,13 +218,7 @@ bool isCapabilityDerivedFrom(CapabilityAtom atom, CapabilityAtom base)
     }
 
     const auto& info = kCapabilityNameInfos[Index(atom)];
-    for (auto cur : info.canonicalRepresentation)
-    {
-        if (cur->contains((UInt)base))
-            return true;
-    }
-
-    return false;
+    return info.impliedAtoms && info.impliedAtoms->contains((UInt)base);
 }
 
 // CapabilityAtomSet
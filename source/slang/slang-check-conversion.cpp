@@ -733,6 +733,7 @@ bool SemanticsVisitor::createCtorInvokeExprForAbstractType(
     ctorInvokeExpr->loc = fromInitializerListExpr->loc;
 
     DiagnosticSink tempSink(getSourceManager(), nullptr, getSink());
+    tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
 
     SemanticsVisitor subVisitor(withSink(&tempSink));
     Expr* checkedCtorInvokeExpr = subVisitor.CheckExpr(ctorInvokeExpr);
@@ -888,7 +889,11 @@ bool SemanticsVisitor::createInvokeExprForSynthesizedCtor(
             return false;
     }
 
+    // The messages are only reported for types that aren't C-style, for anything else
+    // the count of errors is enough.
     DiagnosticSink tempSink(getSourceManager(), nullptr, getSink());
+    if (isCStyle)
+        tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
     SemanticsVisitor subVisitor(withSink(&tempSink));
 
     // First make sure the struct is fully checked, otherwise the synthesized constructor may not be
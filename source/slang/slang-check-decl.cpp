@@ -12,6 +12,7 @@
 // logic also orchestrates the overall flow and how
 // and when things get checked.
 
+#include "../core/slang-type-text-util.h"
 #include "slang-ast-forward-declarations.h"
 #include "slang-ast-iterator.h"
 #include "slang-ast-print.h"
@@ -1775,6 +1776,7 @@ QualType getTypeForThisExpr(SemanticsVisitor* visitor, FunctionDeclBase* funcDec
     expr->loc = funcDecl->loc;
 
     DiagnosticSink dummySink;
+    dummySink.setFlag(DiagnosticSink::Flag::CountOnly);
     auto tempVisitor = SemanticsVisitor(visitor->withSink(&dummySink));
 
     auto checkedExpr = tempVisitor.CheckTerm(expr);
@@ -2020,6 +2022,17 @@ void SemanticsVisitor::ensureDecl(Decl* decl, DeclCheckState state, SemanticsCon
 ///
 void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
 {
+    // When only the global functions that are reachable from the entry points get
+    // their bodies checked, it is up to `ensureDecl()` calls on the referenced
+    // declarations to bring them past `DefinitionChecked`.
+    //
+    if (state >= DeclCheckState::DefinitionChecked &&
+        getShared()->shouldDeferGlobalFunctionBodies())
+    {
+        if (getGlobalFunctionWithBody(decl) == decl)
+            return;
+    }
+
     // Ensure `decl` itself first.
     ensureDecl(decl, state);
 
@@ -2108,6 +2121,24 @@ bool doesTypeHaveAnUnusedBitPatternThatCanBeUsedForOptionalRepresentation(Type*
     return false;
 }
 
+FunctionDeclBase* getGlobalFunctionWithBody(Decl* decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    if (!funcDecl || !funcDecl->body)
+        return nullptr;
+
+    Decl* parentDecl = funcDecl->parentDecl;
+    if (auto genericParentDecl = as<GenericDecl>(parentDecl))
+        parentDecl = genericParentDecl->parentDecl;
+    if (!as<ModuleDecl>(parentDecl) && !as<FileDecl>(parentDecl) && !as<NamespaceDecl>(parentDecl))
+        return nullptr;
+
+    return funcDecl;
+}
+
 bool SemanticsVisitor::shouldSkipChecking(Decl* decl, DeclCheckState state)
 {
     if (state < DeclCheckState::DefinitionChecked)
@@ -4910,6 +4941,74 @@ void discoverExtensionDecls(List<ExtensionDecl*>& decls, Decl* parent)
     }
 }
 
+// Turn the `static const` globals named with `-specialization-constant` into
+// specialization constants, whose initializers become their default values.
+//
+// This has to happen before anything that refers to the globals is checked, since
+// checking could otherwise fold their values into the code that uses them.
+//
+static void _applySpecializationConstantOptions(SemanticsVisitor* visitor, ModuleDecl* moduleDecl)
+{
+    auto names = visitor->getOptionSet().getArray(CompilerOptionName::SpecializationConstant);
+    if (names.getCount() == 0 || isFromCoreModule(moduleDecl))
+        return;
+
+    HashSet<String> nameSet;
+    for (auto& name : names)
+        nameSet.add(name.stringValue);
+
+    // A target without specialization constants would lay the global out as an
+    // ordinary uniform parameter, and so lose its initializer.
+    TargetRequest* unsupportedTarget = nullptr;
+    for (auto target : visitor->getLinkage()->targets)
+    {
+        if (!isKhronosTarget(target) && !isMetalTarget(target))
+        {
+            unsupportedTarget = target;
+            break;
+        }
+    }
+
+    auto applyToMembers = [&](ContainerDecl* containerDecl)
+    {
+        for (auto varDecl : containerDecl->getDirectMemberDeclsOfType<VarDecl>())
+        {
+            if (!varDecl->getName() || !nameSet.contains(getText(varDecl->getName())))
+                continue;
+            if (isSpecializationConstant(varDecl))
+                continue;
+
+            auto staticModifier = varDecl->findModifier<HLSLStaticModifier>();
+            if (!staticModifier || !varDecl->hasModifier<ConstModifier>() || !varDecl->initExpr ||
+                varDecl->hasModifier<ExternModifier>() ||
+                varDecl->hasModifier<HLSLExportModifier>())
+            {
+                visitor->getSink()->diagnose(
+                    Diagnostics::SpecializationConstantRequiresStaticConst{.decl = varDecl});
+                continue;
+            }
+            if (unsupportedTarget)
+            {
+                visitor->getSink()->diagnose(
+                    Diagnostics::SpecializationConstantUnsupportedForTarget{
+                        .decl = varDecl,
+                        .target = TypeTextUtil::getCompileTargetName(
+                            SlangCompileTarget(unsupportedTarget->getTarget()))});
+                continue;
+            }
+
+            removeModifier(varDecl, staticModifier);
+            auto specConstAttr =
+                visitor->getASTBuilder()->create<SpecializationConstantAttribute>();
+            specConstAttr->loc = varDecl->loc;
+            addModifier(varDecl, specConstAttr);
+        }
+    };
+    applyToMembers(moduleDecl);
+    for (auto fileDecl : moduleDecl->getDirectMemberDeclsOfType<FileDecl>())
+        applyToMembers(fileDecl);
+}
+
 void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
 {
     // When we are dealing with code from the core modules,
@@ -4995,6 +5094,8 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
             visitIncludeDecls(fileDecl);
     }
 
+    _applySpecializationConstantOptions(this, moduleDecl);
+
     // The entire goal of semantic checking is to get all of the
     // declarations in the module up to `DeclCheckState::DefinitionChecked`.
     //
@@ -7460,6 +7561,7 @@ bool SemanticsVisitor::trySynthesizeMethodRequirementWitness(
     // a temporary diagnostic sink.
     //
     DiagnosticSink tempSink(getSourceManager(), nullptr);
+    tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
     ExprLocalScope localScope;
     SemanticsVisitor subVisitor(withSink(&tempSink)
                                     .withParentFunc(synFuncDecl)
@@ -7834,6 +7936,7 @@ bool SemanticsVisitor::trySynthesizeConstructorRequirementWitness(
         // a temporary diagnostic sink.
         //
         DiagnosticSink tempSink(getSourceManager(), nullptr);
+        tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
         ExprLocalScope localScope;
         SemanticsVisitor subVisitor(
             withSink(&tempSink).withParentFunc(ctorDecl).withExprLocalScope(&localScope));
@@ -7990,6 +8093,7 @@ bool SemanticsVisitor::trySynthesizePropertyRequirementWitness(
     // of diagnostics more easily.
     //
     DiagnosticSink tempSink(getSourceManager(), nullptr);
+    tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
     SemanticsVisitor subVisitor(withSink(&tempSink));
 
     // We need to create a `this` expression to be used in the body
@@ -8200,6 +8304,7 @@ bool SemanticsVisitor::synthesizeAccessorRequirements(
         // of diagnostics more easily.
         //
         DiagnosticSink tempSink(getSourceManager(), nullptr);
+        tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
         SemanticsVisitor subVisitor(withSink(&tempSink));
 
         // The body of the accessor will depend on the class of the accessor
@@ -8378,6 +8483,7 @@ bool SemanticsVisitor::trySynthesizeSubscriptRequirementWitness(
     // in the synthesized subscript accessors.
     //
     DiagnosticSink tempSink(getSourceManager(), nullptr);
+    tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
     SemanticsVisitor subVisitor(withSink(&tempSink));
     Expr* synBaseStorageExpr = nullptr;
     if (lookupResult.isValid())
@@ -15989,6 +16095,8 @@ void SharedSemanticsContext::registerCandidateExtension(Decl* typeDecl, Extensio
                 hasImplicitCastMember = true;
         }
     }
+    if (hasImplicitCastMember && !isFromCoreModule(extDecl))
+        m_hasUserImplicitConversionExtension = true;
 
     // A new extension can affect not only `typeDecl` itself, but also any cached
     // type whose linearized facets reference `typeDecl` transitively. Historically
@@ -16028,10 +16136,22 @@ void SharedSemanticsContext::registerCandidateExtension(Decl* typeDecl, Extensio
 
 void SharedSemanticsContext::_addCandidateExtensionsFromModule(ModuleDecl* moduleDecl)
 {
+    bool isCoreModule = moduleDecl->hasModifier<FromCoreModuleModifier>();
     for (auto& [entryKey, entryValue] : moduleDecl->mapDeclToCandidateExtensions)
     {
         auto& list = _getCandidateExtensionList(entryKey, m_mapDeclToCandidateExtensions);
         list.addRange(entryValue->candidateExtensions);
+
+        if (isCoreModule || m_hasUserImplicitConversionExtension)
+            continue;
+        for (auto extDecl : entryValue->candidateExtensions)
+        {
+            for (auto ctorDecl : extDecl->getDirectMemberDeclsOfType<ConstructorDecl>())
+            {
+                if (ctorDecl->hasModifier<ImplicitConversionModifier>())
+                    m_hasUserImplicitConversionExtension = true;
+            }
+        }
     }
 }
 
@@ -17966,6 +18086,7 @@ bool tryCheckDerivativeOfAttributeImpl(
     const List<Expr*>& imaginaryArgsToOriginal)
 {
     DiagnosticSink tempSink(visitor->getSourceManager(), nullptr);
+    tempSink.setFlag(DiagnosticSink::Flag::CountOnly);
     SemanticsVisitor subVisitor(visitor->withSink(&tempSink));
     checkDerivativeOfAttributeImpl<TDerivativeAttr>(
         &subVisitor,
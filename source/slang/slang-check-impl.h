@@ -269,6 +269,80 @@ struct OperatorOverloadCacheKey
     }
 };
 
+/// Key for memoizing the overload resolution of an ordinary call, such as `lerp(a, b, t)` or
+/// `dot(a, b)`, to a function that is only overloaded in the core module.
+///
+/// Only calls whose every candidate is a core module function found without breadcrumbs are
+/// given a key. Such an overload set is the same wherever it is looked up, so it is identified
+/// by any one of its members together with the number of members.
+struct FunctionOverloadCacheKey
+{
+    static const Index kMaxArgCount = 4;
+
+    Decl* candidateDecl = nullptr;
+    Index candidateCount = 0;
+    Index argCount = 0;
+    bool isGLSLMode = false;
+    BasicTypeKey args[kMaxArgCount];
+
+    bool operator==(FunctionOverloadCacheKey const& key) const
+    {
+        if (candidateDecl != key.candidateDecl || candidateCount != key.candidateCount ||
+            argCount != key.argCount || isGLSLMode != key.isGLSLMode)
+            return false;
+        for (Index i = 0; i < argCount; i++)
+        {
+            if (!(args[i] == key.args[i]))
+                return false;
+        }
+        return true;
+    }
+    HashCode getHashCode() const
+    {
+        HashCode hash = combineHash(
+            Slang::getHashCode(candidateDecl),
+            (HashCode32)candidateCount,
+            (HashCode32)argCount,
+            (HashCode32)isGLSLMode);
+        for (Index i = 0; i < argCount; i++)
+            hash = combineHash(hash, args[i].getRaw());
+        return hash;
+    }
+    bool fromInvokeExpr(InvokeExpr* invokeExpr)
+    {
+        auto overloadedExpr = as<OverloadedExpr>(invokeExpr->functionExpr);
+        if (!overloadedExpr || overloadedExpr->base)
+            return false;
+
+        argCount = invokeExpr->arguments.getCount();
+        if (argCount > kMaxArgCount)
+            return false;
+        for (Index i = 0; i < argCount; i++)
+        {
+            auto arg = invokeExpr->arguments[i];
+            args[i] = makeBasicTypeKey(arg->type, arg);
+            if (args[i].getRaw() == BasicTypeKey::invalid().getRaw())
+                return false;
+        }
+
+        candidateCount = 0;
+        for (auto item : overloadedExpr->lookupResult2)
+        {
+            if (item.breadcrumbs)
+                return false;
+            Decl* decl = item.declRef.getDecl();
+            Decl* funcDecl = decl;
+            if (auto genDecl = as<GenericDecl>(decl))
+                funcDecl = genDecl->inner;
+            if (!as<FuncDecl>(funcDecl) || !isFromCoreModule(decl))
+                return false;
+            candidateDecl = decl;
+            candidateCount++;
+        }
+        return candidateCount != 0;
+    }
+};
+
 struct OverloadCandidate
 {
     enum class Flavor
@@ -343,6 +417,7 @@ struct ResolvedOperatorOverload
 struct TypeCheckingCache : public RefObject
 {
     Dictionary<OperatorOverloadCacheKey, ResolvedOperatorOverload> resolvedOperatorOverloadCache;
+    Dictionary<FunctionOverloadCacheKey, ResolvedOperatorOverload> resolvedFunctionOverloadCache;
     Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
 
     // The version used to invalidate the cached declRefs in ResolvedOperatorOverload entries.
@@ -653,6 +728,23 @@ struct InheritanceInfoCacheEntry
     bool isComputing = false;
 };
 
+/// Inheritance info computed for a core module declaration by one semantic checking context,
+/// which later contexts of the same linkage reuse instead of linearizing the inheritance again.
+///
+/// The info only holds for a context that sees the same candidate extensions for each of the
+/// declarations it depends on, so those are recorded along with it.
+struct SharedInheritanceInfoEntry
+{
+    InheritanceInfo info;
+    List<KeyValuePair<Decl*, List<ExtensionDecl*>>> dependencyExtensions;
+};
+
+/// Inheritance info shared between the semantic checking contexts of a `Linkage`.
+struct InheritanceInfoCache : public RefObject
+{
+    Dictionary<DeclRef<Decl>, SharedInheritanceInfoEntry> entries;
+};
+
 /// Cached subtype query plus the inheritance cache generations it depended on.
 struct SubtypeWitnessCacheEntry
 {
@@ -674,39 +766,116 @@ struct ImplicitCastMethodKey
     Type* fromType; // nullptr means default construct.
     bool isLValue;
     Type* toType;
-    uint64_t constantVal;
+
+    // An integer literal being converted is identified by its bit size and sign rather than its
+    // value, since those are all that the choice of conversion and its cost depend on. This
+    // lets conversions of different literals share an entry.
+    int constantBitCount;
+    bool isConstantNegative;
     bool isConstant;
     HashCode getHashCode() const
     {
         return combineHash(
             Slang::getHashCode(fromType),
             Slang::getHashCode(toType),
-            Slang::getHashCode(constantVal),
+            (HashCode32)constantBitCount,
+            (HashCode32)isConstantNegative,
             (HashCode32)isConstant,
             (HashCode32)isLValue);
     }
     bool operator==(const ImplicitCastMethodKey& other) const
     {
         return fromType == other.fromType && toType == other.toType &&
-               isConstant == other.isConstant && constantVal == other.constantVal &&
-               isLValue == other.isLValue;
+               isConstant == other.isConstant && constantBitCount == other.constantBitCount &&
+               isConstantNegative == other.isConstantNegative && isLValue == other.isLValue;
     }
     ImplicitCastMethodKey() = default;
     ImplicitCastMethodKey(QualType fromType, Type* toType, Expr* fromExpr)
         : fromType(fromType)
+        , isLValue(fromType.isLeftValue)
         , toType(toType)
-        , constantVal(0)
+        , constantBitCount(0)
+        , isConstantNegative(false)
         , isConstant(false)
-        , isLValue(fromType.isLeftValue)
     {
         if (auto constInt = as<IntegerLiteralExpr>(fromExpr))
         {
-            constantVal = constInt->value;
+            constantBitCount = getIntValueBitSize(constInt->value);
+            isConstantNegative = constInt->value < 0;
             isConstant = true;
         }
     }
 };
 
+/// Identifies a member lookup `type.name` for the member lookup cache.
+struct MemberLookupKey
+{
+    Type* type = nullptr;
+    Name* name = nullptr;
+    LookupMask mask = LookupMask::Default;
+    LookupOptions options = LookupOptions::None;
+
+    HashCode getHashCode() const
+    {
+        return combineHash(
+            Slang::getHashCode(type),
+            Slang::getHashCode(name),
+            (HashCode32)mask,
+            (HashCode32)options);
+    }
+    bool operator==(const MemberLookupKey& other) const
+    {
+        return type == other.type && name == other.name && mask == other.mask &&
+               options == other.options;
+    }
+};
+
+/// A container decl searched by a cached member lookup, with the state it was searched in.
+struct MemberLookupDependency
+{
+    ContainerDecl* decl = nullptr;
+    UInt extensionEpoch = 0;
+    UInt modificationCount = 0;
+};
+
+/// Cached member lookup result plus the container decls it was found in.
+///
+/// Registering an extension bumps the extension epoch of the extended declaration, which is
+/// one of the searched containers, and synthesizing a member changes the modification count
+/// of the container it is added to, so either makes the entry stale.
+struct MemberLookupCacheEntry
+{
+    LookupResult result;
+    List<MemberLookupDependency> dependencies;
+};
+
+/// A coarse classification of the type of a parameter or argument, used to rule out
+/// overload candidates for a call without checking them.
+enum class OverloadTypeClass
+{
+    Unknown,
+    Scalar,
+    Vector,
+    Matrix,
+    Texture,
+};
+
+/// What overload resolution needs to know about a candidate declaration to rule it out
+/// for a call before trying to match it against the arguments.
+struct OverloadPruningInfo
+{
+    /// Can the candidate be ruled out using this info? Candidates with parameter packs,
+    /// and anything other than a callable or a generic callable, are always checked.
+    bool isValid = false;
+
+    Count requiredParamCount = 0;
+
+    /// The most arguments the candidate accepts.
+    Count allowedParamCount = 0;
+
+    OverloadTypeClass firstParamClass = OverloadTypeClass::Unknown;
+};
+
 /// Used to track offsets for atomic counter storage qualifiers.
 struct GLSLBindingOffsetTracker
 {
@@ -764,6 +933,8 @@ struct SharedSemanticsContext : public RefObject
     // Key format: "diagnosticId|sourceLocRaw" or "diagnosticId|sourceLocRaw|extraInfo"
     HashSet<String> m_reportedDiagnosticKeys;
 
+    bool m_deferGlobalFunctionBodies = false;
+
 public:
     SharedSemanticsContext(
         Linkage* linkage,
@@ -793,6 +964,12 @@ public:
             return m_linkage->isInLanguageServer();
         return false;
     }
+
+    /// Should `checkModule` leave the bodies of global functions unchecked, so that
+    /// they only get checked if something that is checked refers to them?
+    bool shouldDeferGlobalFunctionBodies() { return m_deferGlobalFunctionBodies; }
+    void setDeferGlobalFunctionBodies(bool value) { m_deferGlobalFunctionBodies = value; }
+
     /// Get the list of extension declarations that appear to apply to `decl` in this context
     List<ExtensionDecl*> const& getCandidateExtensionsForTypeDecl(Decl* decl);
 
@@ -850,6 +1027,20 @@ public:
     /// Try get subtype witness from cache, returns true if cache contains a result for the query.
     bool tryGetSubtypeWitnessFromCache(Type* sub, Type* sup, SubtypeWitness*& outWitness);
     void cacheSubtypeWitness(Type* sub, Type* sup, SubtypeWitness*& outWitness);
+    /// Try get the result of a member lookup from cache, returns true if the cache contains an
+    /// up to date result for the lookup.
+    bool tryGetMemberLookupFromCache(MemberLookupKey const& key, LookupResult& outResult);
+
+    /// Cache the result of a member lookup that searched `searchedContainers`, each paired with
+    /// its modification count when it was searched.
+    void cacheMemberLookup(
+        MemberLookupKey const& key,
+        LookupResult const& result,
+        List<KeyValuePair<ContainerDecl*, UInt>> const& searchedContainers);
+
+    /// Get the number of times inheritance info was used while it was still being computed.
+    UInt getIncompleteInheritanceInfoCount() const { return m_incompleteInheritanceInfoCount; }
+
     ImplicitCastMethod* tryGetImplicitCastMethod(ImplicitCastMethodKey key)
     {
         return m_mapTypePairToImplicitCastMethod.tryGetValue(key);
@@ -859,6 +1050,22 @@ public:
         m_mapTypePairToImplicitCastMethod[key] = candidate;
     }
 
+    OverloadPruningInfo* tryGetOverloadPruningInfo(Decl* decl)
+    {
+        return m_mapDeclToOverloadPruningInfo.tryGetValue(decl);
+    }
+    void cacheOverloadPruningInfo(Decl* decl, OverloadPruningInfo const& info)
+    {
+        m_mapDeclToOverloadPruningInfo[decl] = info;
+    }
+
+    /// Has an extension outside the core module declared an implicit conversion? If so,
+    /// argument types can convert in ways overload pruning doesn't account for.
+    bool hasUserImplicitConversionExtension() const
+    {
+        return m_hasUserImplicitConversionExtension;
+    }
+
     bool* isCStyleType(Type* type) { return m_isCStyleTypeCache.tryGetValue(type); }
 
     void cacheCStyleType(Type* type, bool isCStyle)
@@ -913,6 +1120,11 @@ private:
 
     bool _isInheritanceInfoCacheEntryUpToDate(InheritanceInfoCacheEntry const& entry) const;
 
+    /// Find inheritance info for `declRef` that another context of the linkage computed and
+    /// that still holds for the extensions visible to this context.
+    bool _tryGetSharedInheritanceInfo(DeclRef<Decl> declRef, InheritanceInfo& outInfo);
+    void _addSharedInheritanceInfo(DeclRef<Decl> declRef, InheritanceInfo const& info);
+
     void _collectInheritanceInfoDependencyEpochs(
         Decl* subjectDecl,
         InheritanceInfo const& info,
@@ -1029,8 +1241,15 @@ private:
     Dictionary<TypePair, SubtypeWitnessCacheEntry> m_mapTypePairToSubtypeWitness;
     Dictionary<ImplicitCastMethodKey, ImplicitCastMethod> m_mapTypePairToImplicitCastMethod;
     Dictionary<Type*, bool> m_isCStyleTypeCache;
+    Dictionary<MemberLookupKey, MemberLookupCacheEntry> m_mapMemberLookupToResult;
     Dictionary<Decl*, UInt> m_mapDeclToExtensionEpoch;
+    Dictionary<Decl*, OverloadPruningInfo> m_mapDeclToOverloadPruningInfo;
+    bool m_hasUserImplicitConversionExtension = false;
     UInt m_nextInheritanceInfoCacheGeneration = 1;
+
+    /// The number of times inheritance info was asked for while it was still being computed,
+    /// in which case the info returned was incomplete.
+    UInt m_incompleteInheritanceInfoCount = 0;
 };
 
 /// Local/scoped state of the semantic-checking system
@@ -2907,6 +3126,13 @@ public:
 
         // Full list of all candidates being considered, in the ambiguous case
         List<OverloadCandidate> bestCandidates;
+
+        // Should candidates that can't apply to the arguments, judging by their parameter
+        // count and the class of their first parameter type, be skipped without checking?
+        bool allowCandidatePruning = false;
+
+        // The number of candidates skipped because of `allowCandidatePruning`.
+        Count prunedCandidateCount = 0;
     };
 
     struct ParamCounts
@@ -3189,6 +3415,12 @@ public:
         OverloadResolveContext& context,
         ConversionCost baseCost);
 
+    /// Get the info used to rule out `decl` as an overload candidate without checking it.
+    OverloadPruningInfo getOverloadPruningInfo(Decl* decl);
+
+    /// Can `decl` be ruled out as a candidate for the call in `context` without checking it?
+    bool isOverloadCandidateRuledOut(Decl* decl, OverloadResolveContext& context);
+
     void AddOverloadCandidates(LookupResult const& result, OverloadResolveContext& context);
 
     void AddOverloadCandidates(Expr* funcExpr, OverloadResolveContext& context);
@@ -74,6 +74,63 @@ void SharedSemanticsContext::_collectInheritanceInfoDependencyEpochs(
     }
 }
 
+InheritanceInfoCache* Linkage::getInheritanceInfoCache()
+{
+    if (!m_inheritanceInfoCache)
+        m_inheritanceInfoCache = new InheritanceInfoCache();
+    return static_cast<InheritanceInfoCache*>(m_inheritanceInfoCache.get());
+}
+
+bool SharedSemanticsContext::_tryGetSharedInheritanceInfo(
+    DeclRef<Decl> declRef,
+    InheritanceInfo& outInfo)
+{
+    auto entry = getLinkage()->getInheritanceInfoCache()->entries.tryGetValue(declRef);
+    if (!entry)
+        return false;
+
+    for (auto const& dependency : entry->dependencyExtensions)
+    {
+        auto const& extensions = getCandidateExtensionsForTypeDecl(dependency.key);
+        if (extensions.getArrayView() != dependency.value.getArrayView())
+            return false;
+    }
+
+    outInfo = entry->info;
+    return true;
+}
+
+void SharedSemanticsContext::_addSharedInheritanceInfo(
+    DeclRef<Decl> declRef,
+    InheritanceInfo const& info)
+{
+    SharedInheritanceInfoEntry entry;
+    entry.info = info;
+
+    // The candidate extensions that were consulted are those of the declaration itself and of
+    // the types it inherits from, which are exactly the declarations of its facets.
+    auto addDependency = [&](Decl* decl)
+    {
+        for (auto const& dependency : entry.dependencyExtensions)
+        {
+            if (dependency.key == decl)
+                return;
+        }
+        entry.dependencyExtensions.add(
+            KeyValuePair<Decl*, List<ExtensionDecl*>>(
+                decl,
+                getCandidateExtensionsForTypeDecl(decl)));
+    };
+    addDependency(declRef.getDecl());
+    for (auto facet : info.facets)
+    {
+        if (auto decl = facet->getDeclRef().getDecl())
+            addDependency(decl);
+    }
+
+    getLinkage()->getInheritanceInfoCache()->entries[declRef] = _Move(entry);
+}
+
 UInt SharedSemanticsContext::_getInheritanceInfoCacheGeneration(
     Type* type,
     InheritanceCircularityInfo* circularityInfo)
@@ -136,6 +193,66 @@ void SharedSemanticsContext::cacheSubtypeWitness(Type* sub, Type* sup, SubtypeWi
     m_mapTypePairToSubtypeWitness[pair] = entry;
 }
 
+bool SharedSemanticsContext::tryGetMemberLookupFromCache(
+    MemberLookupKey const& key,
+    LookupResult& outResult)
+{
+    auto entry = m_mapMemberLookupToResult.tryGetValue(key);
+    if (!entry)
+        return false;
+
+    for (auto const& dependency : entry->dependencies)
+    {
+        if (getDeclExtensionEpoch(dependency.decl) != dependency.extensionEpoch ||
+            dependency.decl->getDirectMemberDeclsModificationCount() !=
+                dependency.modificationCount)
+        {
+            m_mapMemberLookupToResult.remove(key);
+            return false;
+        }
+    }
+
+    outResult = entry->result;
+    return true;
+}
+
+void SharedSemanticsContext::cacheMemberLookup(
+    MemberLookupKey const& key,
+    LookupResult const& result,
+    List<KeyValuePair<ContainerDecl*, UInt>> const& searchedContainers)
+{
+    MemberLookupCacheEntry entry;
+    entry.result = result;
+    for (auto const& searched : searchedContainers)
+    {
+        auto decl = searched.key;
+
+        // Lookup can check declarations, which can synthesize members into a container after
+        // it was searched. The result would be stale from the start.
+        if (decl->getDirectMemberDeclsModificationCount() != searched.value)
+            return;
+
+        bool isDuplicate = false;
+        for (auto const& dependency : entry.dependencies)
+        {
+            if (dependency.decl == decl)
+            {
+                isDuplicate = true;
+                break;
+            }
+        }
+        if (isDuplicate)
+            continue;
+
+        MemberLookupDependency dependency;
+        dependency.decl = decl;
+        dependency.extensionEpoch = getDeclExtensionEpoch(decl);
+        dependency.modificationCount = searched.value;
+        entry.dependencies.add(dependency);
+    }
+    m_mapMemberLookupToResult[key] = _Move(entry);
+}
+
 InheritanceInfo SharedSemanticsContext::getInheritanceInfo(
     Type* type,
     InheritanceCircularityInfo* circularityInfo)
@@ -154,7 +271,10 @@ InheritanceInfo SharedSemanticsContext::getInheritanceInfo(
     if (auto found = m_mapTypeToInheritanceInfo.tryGetValue(type))
     {
         if (found->isComputing)
+        {
+            m_incompleteInheritanceInfoCount++;
             return found->info;
+        }
 
         if (_isInheritanceInfoCacheEntryUpToDate(*found))
             return found->info;
@@ -230,23 +350,46 @@ InheritanceInfo SharedSemanticsContext::_getInheritanceInfo(
     if (auto found = m_mapDeclRefToInheritanceInfo.tryGetValue(declRef))
     {
         if (found->isComputing)
+        {
+            m_incompleteInheritanceInfoCount++;
             return found->info;
+        }
 
         if (_isInheritanceInfoCacheEntryUpToDate(*found))
             return found->info;
     }
 
-    // Mark the entry as in-progress before recursing so we can break cycles
-    // during inheritance calculation without re-entering the same work.
+    // Every module that is checked needs the inheritance of the same core module types, such
+    // as `float4` or `Texture2D`, so that is computed once per linkage rather than once per
+    // context, unless this context sees different extensions of the types involved.
+    //
+    const bool isShareable = isFromCoreModule(declRef.getDecl());
+    InheritanceInfo info;
+    if (!isShareable || !_tryGetSharedInheritanceInfo(declRef, info))
     {
-        auto& entry = m_mapDeclRefToInheritanceInfo[declRef];
-        entry.info = InheritanceInfo();
-        entry.dependencyEpochs.clear();
-        entry.generation = 0;
-        entry.isComputing = true;
-    }
+        // Mark the entry as in-progress before recursing so we can break cycles
+        // during inheritance calculation without re-entering the same work.
+        {
+            auto& entry = m_mapDeclRefToInheritanceInfo[declRef];
+            entry.info = InheritanceInfo();
+            entry.dependencyEpochs.clear();
+            entry.generation = 0;
+            entry.isComputing = true;
+        }
+
+        const UInt incompleteInfoCount = m_incompleteInheritanceInfoCount;
+        const Index errorCount = getSink() ? getSink()->getErrorCount() : 0;
 
-    auto info = _calcInheritanceInfo(declRef, selfType, circularityInfo);
+        info = _calcInheritanceInfo(declRef, selfType, circularityInfo);
+
+        // Info that relied on incomplete info for a cycle, or whose calculation reported
+        // errors, is specific to this context.
+        if (isShareable && incompleteInfoCount == m_incompleteInheritanceInfoCount &&
+            errorCount == (getSink() ? getSink()->getErrorCount() : 0))
+        {
+            _addSharedInheritanceInfo(declRef, info);
+        }
+    }
 
     auto& entry = m_mapDeclRefToInheritanceInfo[declRef];
     entry.info = info;
@@ -2825,6 +2825,99 @@ void SemanticsVisitor::AddDeclRefOverloadCandidates(
     }
 }
 
+static OverloadTypeClass _getOverloadTypeClass(Type* type)
+{
+    type = unwrapModifiedType(type);
+    if (as<BasicExpressionType>(type))
+        return OverloadTypeClass::Scalar;
+    if (as<VectorExpressionType>(type))
+        return OverloadTypeClass::Vector;
+    if (as<MatrixExpressionType>(type))
+        return OverloadTypeClass::Matrix;
+    if (as<ResourceType>(type))
+        return OverloadTypeClass::Texture;
+    return OverloadTypeClass::Unknown;
+}
+
+OverloadPruningInfo SemanticsVisitor::getOverloadPruningInfo(Decl* decl)
+{
+    if (auto cachedInfo = getShared()->tryGetOverloadPruningInfo(decl))
+        return *cachedInfo;
+
+    // We check the declaration only as far as adding it as a candidate would, and read
+    // its parameters without substitutions. The classes we sort types into are the same
+    // for any specialization of them.
+    //
+    CallableDecl* callableDecl = nullptr;
+    if (auto genericDecl = as<GenericDecl>(decl))
+    {
+        ensureDecl(genericDecl, DeclCheckState::CanSpecializeGeneric);
+        callableDecl = as<CallableDecl>(genericDecl->inner);
+    }
+    else if (auto funcDecl = as<CallableDecl>(decl))
+    {
+        ensureDecl(funcDecl, DeclCheckState::CanUseFuncSignature);
+        callableDecl = funcDecl;
+    }
+
+    OverloadPruningInfo info;
+    if (!callableDecl || as<FuncAliasDecl>(callableDecl) || callableDecl->funcType.type)
+    {
+        getShared()->cacheOverloadPruningInfo(decl, info);
+        return info;
+    }
+
+    for (auto param : callableDecl->getParameters())
+    {
+        auto paramType = param->getType();
+        if (!paramType)
+        {
+            // The parameter hasn't been checked yet, so we can't tell anything about the
+            // candidate this time around.
+            return OverloadPruningInfo();
+        }
+        if (isPackType(paramType))
+        {
+            getShared()->cacheOverloadPruningInfo(decl, info);
+            return info;
+        }
+        if (info.allowedParamCount == 0)
+            info.firstParamClass = _getOverloadTypeClass(paramType);
+        if (!param->initExpr)
+            info.requiredParamCount++;
+        info.allowedParamCount++;
+    }
+    info.isValid = true;
+    getShared()->cacheOverloadPruningInfo(decl, info);
+    return info;
+}
+
+bool SemanticsVisitor::isOverloadCandidateRuledOut(Decl* decl, OverloadResolveContext& context)
+{
+    auto info = getOverloadPruningInfo(decl);
+    if (!info.isValid)
+        return false;
+
+    // This is the check `TryCheckOverloadCandidateArity` makes, but done before any
+    // generic arguments are inferred.
+    //
+    auto argCount = context.getArgCount();
+    if (argCount < info.requiredParamCount || argCount > info.allowedParamCount)
+        return true;
+
+    // The only classes of type that can never convert to one another are textures and
+    // arithmetic types, and even those could if an extension declared a conversion.
+    //
+    if (argCount == 0 || getShared()->hasUserImplicitConversionExtension())
+        return false;
+    auto argClass = _getOverloadTypeClass(context.getArgType(0));
+    if (argClass == OverloadTypeClass::Unknown ||
+        info.firstParamClass == OverloadTypeClass::Unknown)
+        return false;
+    return (argClass == OverloadTypeClass::Texture) !=
+           (info.firstParamClass == OverloadTypeClass::Texture);
+}
+
 void SemanticsVisitor::AddOverloadCandidates(
     LookupResult const& result,
     OverloadResolveContext& context)
@@ -2833,6 +2926,13 @@ void SemanticsVisitor::AddOverloadCandidates(
     {
         for (auto item : result.items)
         {
+            if (context.allowCandidatePruning &&
+                context.mode == OverloadResolveContext::Mode::JustTrying &&
+                isOverloadCandidateRuledOut(item.declRef.getDecl(), context))
+            {
+                context.prunedCandidateCount++;
+                continue;
+            }
             AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
         }
     }
@@ -3098,6 +3198,37 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
             }
         }
     }
+    // Ordinary calls to functions overloaded in the core module, such as `lerp` or `dot`, are
+    // memoized in the same way when the argument types are concrete.
+    //
+    bool shouldAddToFunctionCache = false;
+    FunctionOverloadCacheKey functionKey;
+    if (!as<OperatorExpr>(expr) && !as<ExplicitCtorInvokeExpr>(expr) &&
+        functionKey.fromInvokeExpr(expr))
+    {
+        functionKey.isGLSLMode = getShared()->glslModuleDecl != nullptr;
+        ResolvedOperatorOverload candidate;
+        if (typeCheckingCache->resolvedFunctionOverloadCache.tryGetValue(functionKey, candidate))
+        {
+            if (candidate.cacheVersion == typeCheckingCache->version ||
+                findNextOuterGeneric(candidate.decl) == nullptr)
+            {
+                context.bestCandidateStorage = candidate.candidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+            }
+            else
+            {
+                LookupResultItem overloadCandidate = {};
+                overloadCandidate.declRef = getOuterGenericOrSelf(candidate.decl);
+                AddDeclRefOverloadCandidates(overloadCandidate, context, 0);
+                shouldAddToFunctionCache = true;
+            }
+        }
+        else
+        {
+            shouldAddToFunctionCache = true;
+        }
+    }
 
     // We run a special case here where an `InvokeExpr`
     // with a single argument where the base/func expression names
@@ -3158,7 +3289,25 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
     }
     if (!context.bestCandidate && !typeOverloadChecked)
     {
+        // Overloads that can't apply to the arguments are skipped at first. If that leaves
+        // nothing applicable we try again with all of them, so that any error is reported
+        // against the same candidates as it would have been without skipping.
+        //
+        context.allowCandidatePruning = true;
         AddOverloadCandidates(funcExpr, context);
+        context.allowCandidatePruning = false;
+
+        bool foundApplicableCandidate =
+            context.bestCandidates.getCount()
+                ? context.bestCandidates[0].status == OverloadCandidate::Status::Applicable
+                : context.bestCandidate &&
+                      context.bestCandidate->status == OverloadCandidate::Status::Applicable;
+        if (context.prunedCandidateCount != 0 && !foundApplicableCandidate)
+        {
+            context.bestCandidate = nullptr;
+            context.bestCandidates.clear();
+            AddOverloadCandidates(funcExpr, context);
+        }
     }
 
     if (context.bestCandidates.getCount() > 0)
@@ -3338,6 +3487,17 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
                 typeCheckingCache->resolvedOperatorOverloadCache[key] = overloadResult;
             }
         }
+        // Only an applicable candidate is remembered for an ordinary call, so that a failed
+        // call is always diagnosed through a full candidate scan.
+        if (shouldAddToFunctionCache &&
+            context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+        {
+            ResolvedOperatorOverload overloadResult;
+            overloadResult.candidate = *context.bestCandidate;
+            overloadResult.decl = context.bestCandidate->item.declRef.getDecl();
+            overloadResult.cacheVersion = typeCheckingCache->version;
+            typeCheckingCache->resolvedFunctionOverloadCache[functionKey] = overloadResult;
+        }
 
         // Now that we have resolved the overload candidate, we need to undo an
         // `openExistential` operation that was applied to `out` arguments.
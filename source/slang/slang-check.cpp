@@ -5,6 +5,7 @@
 // checking that don't cleanly land in one of the more
 // specialized `slang-check-*` files.
 
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 #include "slang-rich-diagnostics.h"
@@ -183,6 +184,10 @@ void checkTranslationUnit(
     LoadedModuleDictionary& loadedModules)
 {
     SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
+    SLANG_PROFILE_PHASE(
+        translationUnit->compileRequest->optionSet.shouldProfilePhases(),
+        "check",
+        getText(translationUnit->moduleName));
 
     SharedSemanticsContext sharedSemanticsContext(
         translationUnit->compileRequest->getLinkage(),
@@ -191,6 +196,9 @@ void checkTranslationUnit(
         &loadedModules,
         translationUnit);
 
+    sharedSemanticsContext.setDeferGlobalFunctionBodies(
+        translationUnit->compileRequest->m_checkReachableFunctionsOnly);
+
     SemanticsDeclVisitorBase visitor((SemanticsContext(&sharedSemanticsContext)));
 
     // Apply the visitor to do the main semantic
@@ -202,6 +210,40 @@ void checkTranslationUnit(
     translationUnit->getModule()->_collectShaderParams(translationUnit->compileRequest->getSink());
 }
 
+void checkReachableFunctions(
+    TranslationUnitRequest* translationUnit,
+    LoadedModuleDictionary& loadedModules)
+{
+    SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
+    SLANG_PROFILE_PHASE(
+        translationUnit->compileRequest->optionSet.shouldProfilePhases(),
+        "check",
+        getText(translationUnit->moduleName));
+
+    SharedSemanticsContext sharedSemanticsContext(
+        translationUnit->compileRequest->getLinkage(),
+        translationUnit->getModule(),
+        translationUnit->compileRequest->getSink(),
+        &loadedModules,
+        translationUnit);
+
+    SemanticsVisitor visitor(&sharedSemanticsContext);
+
+    // Checking the capabilities of a function makes sure that every declaration
+    // referenced from its body is checked up to the same state, so bringing the
+    // entry points up to `CapabilityChecked` checks every function body that is
+    // reachable from them through calls.
+    //
+    // Functions that are only reachable in other ways (for example through the
+    // initializer of a global variable) are checked when IR lowering gets to them.
+    //
+    for (auto entryPoint : translationUnit->getModule()->getEntryPoints())
+    {
+        if (auto funcDecl = entryPoint->getFuncDecl())
+            visitor.ensureDecl(funcDecl, DeclCheckState::CapabilityChecked);
+    }
+}
+
 void SemanticsVisitor::dispatchStmt(Stmt* stmt, SemanticsContext const& context)
 {
     SemanticsStmtVisitor visitor(context);
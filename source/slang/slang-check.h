@@ -23,6 +23,10 @@ constexpr UInt kMaxTypeNestingDepth = 128;
 bool isGlobalShaderParameter(VarDeclBase* decl);
 bool isFromCoreModule(Decl* decl);
 
+/// If `decl` is a function with a body declared at global or namespace scope,
+/// or a generic of such a function, get that function.
+FunctionDeclBase* getGlobalFunctionWithBody(Decl* decl);
+
 void registerBuiltinDecl(SharedASTBuilder* sharedASTBuilder, Decl* decl);
 void registerBuiltinDecl(ASTBuilder* astBuilder, Decl* decl);
 
@@ -2,6 +2,8 @@
 #include "slang-code-gen.h"
 
 #include "../compiler-core/slang-slice-allocator.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-compiler.h"
@@ -350,6 +352,101 @@ static bool _isCPUHostTarget(CodeGenTarget target)
     return desc.style == ArtifactStyle::Host;
 }
 
+/// Get the shader cache and the key for the DXIL or PTX that `compiler` would produce
+/// from `options`, if that result can be cached.
+///
+/// The whole program shader cache is keyed on the Slang input, so any change to the
+/// source misses there, even when the HLSL or CUDA we generate from it is unchanged
+/// (edits to comments, or to code that is never reached from the entry point). Keying
+/// the DXC and NVRTC compiles on the generated source lets those compiles skip the
+/// downstream compiler entirely.
+static PersistentCache* _getDownstreamCacheAndKey(
+    Linkage* linkage,
+    IDownstreamCompiler* compiler,
+    const DownstreamCompileOptions& options,
+    PersistentCache::Key& outKey)
+{
+    typedef DownstreamCompileOptions CompileOptions;
+
+    if (options.sourceArtifacts.count != 1 || options.libraries.count)
+        return nullptr;
+
+    // Linking with libraries makes the result depend on more than the source. For DXIL,
+    // debug info also produces an associated PDB which a cache entry doesn't hold, while
+    // the line info NVRTC produces is part of the PTX itself.
+    const char* cacheKind = nullptr;
+    switch (options.targetType)
+    {
+    case SLANG_DXIL:
+        if (options.debugInfoType != CompileOptions::DebugInfoType::None)
+            return nullptr;
+        cacheKind = "dxc-dxil";
+        break;
+    case SLANG_PTX:
+        cacheKind = "nvrtc-ptx";
+        break;
+    default:
+        return nullptr;
+    }
+
+    auto shaderCache = linkage->getShaderCache();
+    if (!shaderCache)
+        return nullptr;
+
+    ComPtr<ISlangBlob> sourceBlob;
+    if (SLANG_FAILED(
+            options.sourceArtifacts[0]->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef())))
+        return nullptr;
+
+    DigestBuilder<SHA1> builder;
+    builder.append(UnownedStringSlice(cacheKind));
+
+    const auto& desc = compiler->getDesc();
+    builder.append(desc.type);
+    builder.append(desc.version.m_major);
+    builder.append(desc.version.m_minor);
+    builder.append(desc.version.m_patch);
+
+    ComPtr<ISlangBlob> versionString;
+    if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        builder.append(versionString);
+
+    builder.append(sourceBlob);
+    builder.append(asStringSlice(options.entryPointName));
+    builder.append(asStringSlice(options.profileName));
+    builder.append(options.stage);
+    builder.append(options.flags);
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.floatingPointMode);
+    builder.append(options.denormalModeFp16);
+    builder.append(options.denormalModeFp32);
+    builder.append(options.denormalModeFp64);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.enablePAQ);
+
+    for (const auto& arg : options.compilerSpecificArguments)
+        builder.append(asStringSlice(arg));
+    for (const auto& includePath : options.includePaths)
+        builder.append(asStringSlice(includePath));
+    for (const auto& define : options.defines)
+    {
+        builder.append(asStringSlice(define.nameWithSig));
+        builder.append(asStringSlice(define.value));
+    }
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.m_major);
+        builder.append(capabilityVersion.version.m_minor);
+        builder.append(capabilityVersion.version.m_patch);
+    }
+
+    outKey = builder.finalize();
+    return shaderCache;
+}
+
 SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
     outArtifact.setNull();
@@ -969,6 +1066,7 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     }
 
     auto program = getProgram();
+    const auto optionsKey = getDownstreamIROptionsKey();
 
     // Load embedded precompiled libraries from IR into library artifacts
     program->enumerateIRModules(
@@ -980,7 +1078,8 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
                 {
                     if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
                     {
-                        if (inst->getTarget() == CodeGenTarget::DXIL)
+                        if (inst->getTarget() == CodeGenTarget::DXIL &&
+                            inst->matchesOptionsKey(optionsKey))
                         {
                             auto slice = inst->getBlob()->getStringSlice();
                             ArtifactDesc desc =
@@ -1008,18 +1107,53 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     }
 
     // Compile
+    checkCodeGenCancellation();
     ComPtr<IArtifact> artifact;
-    auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-    SlangResult compileResult = compiler->compile(options, artifact.writeRef());
-    auto downstreamElapsedTime =
-        (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-    getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
-    // Extract diagnostics regardless of compile result
-    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+    PersistentCache::Key downstreamCacheKey;
+    PersistentCache* downstreamCache =
+        isPassThroughEnabled()
+            ? nullptr
+            : _getDownstreamCacheAndKey(getLinkage(), compiler, options, downstreamCacheKey);
 
-    // Now check if compile failed
-    SLANG_RETURN_ON_FAIL(compileResult);
+    ComPtr<ISlangBlob> cachedBlob;
+    if (downstreamCache &&
+        SLANG_SUCCEEDED(downstreamCache->readEntry(downstreamCacheKey, cachedBlob.writeRef())))
+    {
+        artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+        artifact->addRepresentationUnknown(cachedBlob);
+    }
+    else
+    {
+        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
+        SlangResult compileResult;
+        {
+            const bool profilePhases = shouldProfilePhases();
+            SLANG_PROFILE_PHASE(
+                profilePhases,
+                "downstream",
+                profilePhases ? getPhaseProfileName() : String());
+            compileResult = compiler->compile(options, artifact.writeRef());
+        }
+        auto downstreamElapsedTime =
+            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() *
+            0.000000001;
+        getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+
+        // Extract diagnostics regardless of compile result
+        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+
+        // Now check if compile failed
+        SLANG_RETURN_ON_FAIL(compileResult);
+
+        if (downstreamCache)
+        {
+            // As with the whole program cache, failing to store is not an error.
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+                downstreamCache->writeEntry(downstreamCacheKey, blob);
+        }
+    }
 
     // Copy over all of the information associated with the source into the output
     if (sourceArtifact)
@@ -1203,6 +1337,11 @@ SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
     CompileTimerRAII recordCompileTime(getSession());
 
+    // Linking, optimization and downstream compilation are profiled as phases
+    // nested in "emit", so its self time is the time spent emitting code.
+    const bool profilePhases = shouldProfilePhases();
+    SLANG_PROFILE_PHASE(profilePhases, "emit", profilePhases ? getPhaseProfileName() : String());
+
     auto target = getTargetFormat();
 
     switch (target)
@@ -1369,6 +1508,31 @@ bool CodeGenContext::shouldDumpIR()
     return getTargetProgram()->getOptionSet().shouldDumpIR();
 }
 
+UInt64 CodeGenContext::getDownstreamIROptionsKey()
+{
+    // Only options that change the code generated for a function are part of the key. Others,
+    // like the library profile forced when precompiling, or the entry points of the final
+    // link, mustn't stop precompiled code being used.
+    auto& optionSet = getTargetProgram()->getOptionSet();
+
+    DigestBuilder<SHA1> builder;
+    builder.append(optionSet.getMatrixLayoutMode());
+    builder.append(optionSet.getIntOption(CompilerOptionName::FloatingPointMode));
+    builder.append(optionSet.getIntOption(CompilerOptionName::DebugInformation));
+    builder.append(optionSet.getIntOption(CompilerOptionName::Optimization));
+    for (const auto& capability : optionSet.getArray(CompilerOptionName::Capability))
+    {
+        builder.append(capability.intValue);
+    }
+    const auto digest = builder.finalize();
+
+    UInt64 key;
+    ::memcpy(&key, digest.data, sizeof(key));
+
+    // 0 stands for code precompiled before keys were recorded
+    return key ? key : 1;
+}
+
 bool CodeGenContext::shouldSkipDownstreamLinking()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(
@@ -1387,6 +1551,23 @@ bool CodeGenContext::shouldReportDynamicDispatchSites()
         CompilerOptionName::ReportDynamicDispatchSites);
 }
 
+bool CodeGenContext::shouldReportRayPayloadRegisters()
+{
+    return getTargetProgram()->getOptionSet().getBoolOption(
+        CompilerOptionName::ReportRayPayloadRegisters);
+}
+
+bool CodeGenContext::shouldReportFunctionSpecialization()
+{
+    return getTargetProgram()->getOptionSet().getBoolOption(
+        CompilerOptionName::ReportFunctionSpecialization);
+}
+
+bool CodeGenContext::shouldReportNodeRecords()
+{
+    return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::ReportNodeRecords);
+}
+
 bool CodeGenContext::shouldTraceCoverage()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::TraceCoverage);
@@ -1402,6 +1583,26 @@ bool CodeGenContext::shouldTrackLiveness()
     return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::TrackLiveness);
 }
 
+bool CodeGenContext::shouldProfilePhases()
+{
+    return getTargetProgram()->getOptionSet().shouldProfilePhases();
+}
+
+String CodeGenContext::getPhaseProfileName()
+{
+    if (getEntryPointCount() == 0)
+        return "(whole program)";
+
+    StringBuilder builder;
+    for (auto entryPointIndex : getEntryPointIndices())
+    {
+        if (builder.getLength())
+            builder << ", ";
+        builder << getText(getEntryPoint(entryPointIndex)->getName());
+    }
+    return builder.produceString();
+}
+
 String CodeGenContext::getIntermediateDumpPrefix()
 {
     return getTargetProgram()->getOptionSet().getStringOption(
@@ -1436,4 +1637,23 @@ SlangResult CodeGenContext::requireTranslationUnitSourceFiles()
     return SLANG_OK;
 }
 
+static thread_local std::atomic<bool> const* gCodeGenCancelFlag = nullptr;
+
+CodeGenCancellationScope::CodeGenCancellationScope(std::atomic<bool> const* cancelFlag)
+    : m_previousCancelFlag(gCodeGenCancelFlag)
+{
+    gCodeGenCancelFlag = cancelFlag;
+}
+
+CodeGenCancellationScope::~CodeGenCancellationScope()
+{
+    gCodeGenCancelFlag = m_previousCancelFlag;
+}
+
+void checkCodeGenCancellation()
+{
+    if (gCodeGenCancelFlag && gCodeGenCancelFlag->load(std::memory_order_relaxed))
+        SLANG_ABORT_COMPILATION("code generation was cancelled");
+}
+
 } // namespace Slang
@@ -12,7 +12,9 @@
 // and seaprate-compilation scenarios.
 //
 
+#include "../compiler-core/slang-compile-time-budget.h"
 #include "slang-entry-point.h"
+#include "slang-ir-validate.h"
 #include "slang-session.h"
 #include "slang-target-program.h"
 
@@ -109,6 +111,10 @@ public:
         EntryPointIndices entryPointIndices;
         DiagnosticSink* sink = nullptr;
         EndToEndCompileRequest* endToEndReq = nullptr;
+
+        // The time left for optimizing the IR, from `-compile-time-budget`. Shared with the
+        // contexts for intermediate targets, so that what they reduced is seen by the caller.
+        CompileTimeBudget compileTimeBudget;
     };
 
     CodeGenContext(Shared* shared)
@@ -178,6 +184,9 @@ public:
     bool shouldDumpIR();
     bool shouldReportCheckpointIntermediates();
     bool shouldReportDynamicDispatchSites();
+    bool shouldReportRayPayloadRegisters();
+    bool shouldReportFunctionSpecialization();
+    bool shouldReportNodeRecords();
     bool shouldTraceCoverage();
 
     bool shouldTrackLiveness();
@@ -185,6 +194,11 @@ public:
     bool shouldDumpIntermediates();
     String getIntermediateDumpPrefix();
 
+    bool shouldProfilePhases();
+    /// The name the profiled phases of this code generation are tagged with: the names of
+    /// its entry points, or "(whole program)" if it has none.
+    String getPhaseProfileName();
+
     bool getUseUnknownImageFormatAsDefault();
 
     bool isSpecializationDisabled();
@@ -205,6 +219,10 @@ public:
     // removed between IR linking and target source generation.
     bool removeAvailableInDownstreamIR = false;
 
+    // A key for the target options that affect the downstream code generated for a
+    // function. Precompiled code is only linked into a program with the same key.
+    UInt64 getDownstreamIROptionsKey();
+
     // Determines if program level compilation like getTargetCode() or getEntryPointCode()
     // should return a fully linked downstream program or just the glue SPIR-V/DXIL that
     // imports and uses the precompiled SPIR-V/DXIL from constituent modules.
@@ -213,6 +231,10 @@ public:
 
     RequiredLoweringPassSet& getRequiredLoweringPassSet() { return m_requiredLoweringPassSet; }
 
+    IRValidationState& getIRValidationState() { return m_irValidationState; }
+
+    CompileTimeBudget& getCompileTimeBudget() { return m_shared->compileTimeBudget; }
+
 protected:
     CodeGenTarget m_targetFormat = CodeGenTarget::Unknown;
     Profile m_targetProfile;
@@ -229,6 +251,8 @@ protected:
     // can be expensive.
     RequiredLoweringPassSet m_requiredLoweringPassSet;
 
+    IRValidationState m_irValidationState;
+
     /// Will output assembly as well as the artifact if appropriate for the artifact type for
     /// assembly output and conversion is possible
     void _dumpIntermediateMaybeWithAssembly(IArtifact* artifact);
@@ -265,4 +289,19 @@ private:
 // TODO: The "artifact" system is a scourge.
 IArtifact* getSeparateDbgArtifact(IArtifact* artifact);
 
+/// While in scope, lets code generation on the current thread be cancelled by setting
+/// `*cancelFlag`, see `checkCodeGenCancellation`.
+struct CodeGenCancellationScope
+{
+    explicit CodeGenCancellationScope(std::atomic<bool> const* cancelFlag);
+    ~CodeGenCancellationScope();
+
+    std::atomic<bool> const* m_previousCancelFlag;
+};
+
+/// Abort compilation if code generation on the current thread has been cancelled.
+///
+/// Called before each IR pass and each downstream compile.
+void checkCodeGenCancellation();
+
 } // namespace Slang
@@ -318,6 +318,9 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
     // the tracker to preserve pragma states within the module.
     getSink()->setSourceWarningStateTracker(nullptr);
 
+    const bool shouldProfilePhases = optionSet.shouldProfilePhases();
+    const String moduleName = getText(translationUnit->moduleName);
+
     for (auto sourceFile : translationUnit->getSourceFiles())
     {
         SourceLanguage sourceLanguage = translationUnit->sourceLanguage;
@@ -326,15 +329,21 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
 
         auto segments = extractSourceSegments(sourceFile, getSourceManager());
 
-        auto preprocessed = preprocessSourceSegments(
-            segments,
-            sourceLanguage,
-            languageVersion,
-            getSink(),
-            &includeSystem,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            &preprocessorHandler);
+        // Lexing happens on demand as the preprocessor pulls tokens, so it
+        // is timed as part of preprocessing.
+        List<PreprocessedSegment> preprocessed;
+        {
+            SLANG_PROFILE_PHASE(shouldProfilePhases, "preprocess", moduleName);
+            preprocessed = preprocessSourceSegments(
+                segments,
+                sourceLanguage,
+                languageVersion,
+                getSink(),
+                &includeSystem,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                &preprocessorHandler);
+        }
 
         translationUnitSyntax->languageVersion = languageVersion;
 
@@ -365,13 +374,16 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
             break;
         }
 
-        parsePreprocessedSegments(
-            preprocessed,
-            astBuilder,
-            translationUnit,
-            getSink(),
-            languageScope,
-            translationUnitSyntax);
+        {
+            SLANG_PROFILE_PHASE(shouldProfilePhases, "parse", moduleName);
+            parsePreprocessedSegments(
+                preprocessed,
+                astBuilder,
+                translationUnit,
+                getSink(),
+                languageScope,
+                translationUnitSyntax);
+        }
 
         if (optionSet.getBoolOption(CompilerOptionName::OutputIncludes))
         {
@@ -409,6 +421,11 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
             }
 #endif
     }
+
+    // The modules imported by this one are loaded one at a time as it is checked, so read
+    // their files ahead of that.
+    if (!optionSet.getBoolOption(CompilerOptionName::PreprocessorOutput))
+        linkage->prefetchImportedModuleSources(translationUnitSyntax);
 }
 
 List<SourceFile*> extractSourceSegments(SourceFile* sourceFile, SourceManager* sourceManager)
@@ -521,6 +538,12 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
         loadedModules.add(translationUnit->moduleName, translationUnit->getModule());
     }
     checkEntryPoints();
+
+    if (m_checkReachableFunctionsOnly)
+    {
+        for (auto& translationUnit : translationUnits)
+            checkReachableFunctions(translationUnit.Ptr(), loadedModules);
+    }
 }
 
 void FrontEndCompileRequest::generateIR()
@@ -598,6 +621,13 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
+    m_checkReachableFunctionsOnly =
+        optionSet.getBoolOption(CompilerOptionName::CheckReachableFunctionsOnly) &&
+        !m_isCoreModuleCode && !getLinkage()->isInLanguageServer();
+    m_lowerReachableFunctionsOnly =
+        optionSet.getBoolOption(CompilerOptionName::LowerReachableFunctionsOnly) &&
+        !m_isCoreModuleCode;
+
     // Perform semantic checking on the whole collection
     {
         SLANG_PROFILE_SECTION(SemanticChecking);
@@ -625,17 +655,16 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
-    // We always generate IR for all the translation units.
-    //
-    // TODO: We may eventually have a mode where we skip
-    // IR codegen and only produce an AST (e.g., for use when
-    // debugging problems in the parser or semantic checking),
-    // but for now there are no cases where not having IR
-    // makes sense.
+    // We generate IR for all the translation units, unless the
+    // caller only wants reflection, which is computed from the AST.
     //
-    generateIR();
-    if (getSink()->getErrorCount() != 0)
-        return SLANG_FAIL;
+    const bool reflectionOnly = getLinkage()->isReflectionOnly();
+    if (!reflectionOnly)
+    {
+        generateIR();
+        if (getSink()->getErrorCount() != 0)
+            return SLANG_FAIL;
+    }
 
     // Do parameter binding generation, for each compilation target.
     //
@@ -643,7 +672,8 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     {
         auto targetProgram = m_globalAndEntryPointsComponentType->getTargetProgram(targetReq);
         targetProgram->getOrCreateLayout(getSink());
-        targetProgram->getOrCreateIRModuleForLayout(getSink());
+        if (!reflectionOnly)
+            targetProgram->getOrCreateIRModuleForLayout(getSink());
     }
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
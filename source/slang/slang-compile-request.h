@@ -197,6 +197,19 @@ public:
     /// Does the code we are compiling represent part of the Slang core module?
     bool m_isCoreModuleCode = false;
 
+    /// Are the bodies of global functions only checked and lowered when they are
+    /// reachable from the entry points of this request?
+    ///
+    /// This is only ever set for requests that compile entry points, and never for the
+    /// requests that load imported modules, since any function of an imported module
+    /// may be used by the modules that import it.
+    bool m_checkReachableFunctionsOnly = false;
+
+    /// Are global functions that are not exported only lowered to IR when they are
+    /// referenced from the entry points of this request? Like the option above,
+    /// this is never set for the requests that load imported modules.
+    bool m_lowerReachableFunctionsOnly = false;
+
     Name* m_defaultModuleName = nullptr;
 
     /// The irDumpOptions
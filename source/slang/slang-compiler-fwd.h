@@ -12,6 +12,7 @@ namespace Slang
 class ASTBuilder;
 class EndToEndCompileRequest;
 class FrontEndCompileRequest;
+struct IncludeFileTokenCache;
 struct IRModule;
 class Linkage;
 class Module;
@@ -19,11 +20,13 @@ struct ModuleChunk;
 class ProgramLayout;
 class Session;
 class SharedASTBuilder;
+class SharedTypeLayoutCache;
 struct SharedSemanticsContext;
 class TargetProgram;
 class TargetRequest;
 class TranslationUnitRequest;
 struct TypeCheckingCache;
+struct InheritanceInfoCache;
 class TypeLayout;
 
 using LoadedModule = Module;
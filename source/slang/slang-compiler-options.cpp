@@ -171,6 +171,13 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
 {
     for (auto& kv : options)
     {
+        // The location of the shader cache and whether checked modules are shared have
+        // no effect on generated code, so they should not change the keys used to look
+        // up entries within those caches.
+        if (kv.key == CompilerOptionName::ShaderCacheDirectory ||
+            kv.key == CompilerOptionName::ShareCheckedModules)
+            continue;
+
         builder.append(kv.key);
         builder.append(kv.value.getCount());
         for (auto& v : kv.value)
@@ -188,6 +195,39 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
     }
 }
 
+void CompilerOptionSet::freeze()
+{
+    List<int> intValues;
+    intValues.setCount(Index(CompilerOptionName::CountOf));
+    for (Index i = 0; i < intValues.getCount(); i++)
+    {
+        auto name = CompilerOptionName(i);
+        if (auto values = options.tryGetValue(name))
+        {
+            // Options with string values are never queried as integers.
+            intValues[i] = values->getCount() != 0 ? (*values)[0].intValue : 0;
+        }
+        else
+        {
+            intValues[i] = getDefault(name).intValue;
+        }
+    }
+
+    DigestBuilder<SHA1> builder;
+    buildHash(builder);
+    m_frozenDigest = builder.finalize();
+    m_frozenIntValues = _Move(intValues);
+}
+
+SHA1::Digest CompilerOptionSet::getDigest()
+{
+    if (isFrozen())
+        return m_frozenDigest;
+    DigestBuilder<SHA1> builder;
+    buildHash(builder);
+    return builder.finalize();
+}
+
 bool CompilerOptionSet::allowDuplicate(CompilerOptionName name)
 {
     switch (name)
@@ -284,8 +324,8 @@ MatrixLayoutMode CompilerOptionSet::getMatrixLayoutMode()
 
 void CompilerOptionSet::setMatrixLayoutMode(MatrixLayoutMode mode)
 {
-    options.remove(CompilerOptionName::MatrixLayoutColumn);
-    options.remove(CompilerOptionName::MatrixLayoutRow);
+    remove(CompilerOptionName::MatrixLayoutColumn);
+    remove(CompilerOptionName::MatrixLayoutRow);
     if (mode == kMatrixLayoutMode_ColumnMajor)
         set(CompilerOptionName::MatrixLayoutColumn, true);
     if (mode == kMatrixLayoutMode_RowMajor)
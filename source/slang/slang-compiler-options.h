@@ -101,8 +101,29 @@ struct CompilerOptionSet
 
     bool hasOption(CompilerOptionName name) { return options.containsKey(name); }
 
+    /// Precompute the integer value of every option, and the digest of the whole set.
+    ///
+    /// Option sets that are final, like the one of a `TargetProgram`, are queried from
+    /// inner loops of code generation. Once frozen, `getBoolOption` and `getIntOption` read
+    /// from a flat array instead of looking up the dictionary. Any later change to the set
+    /// discards the precomputed values.
+    void freeze();
+
+    bool isFrozen() const { return m_frozenIntValues.getCount() != 0; }
+
+    /// Get the digest that `buildHash` produces for this set, without recomputing it if the
+    /// set is frozen.
+    SHA1::Digest getDigest();
+
+    void remove(CompilerOptionName name)
+    {
+        _thaw();
+        options.remove(name);
+    }
+
     void set(CompilerOptionName name, CompilerOptionValue value)
     {
+        _thaw();
         if (auto v = options.tryGetValue(name))
         {
             v->clear();
@@ -114,6 +135,7 @@ struct CompilerOptionSet
 
     void set(CompilerOptionName name, const List<CompilerOptionValue>& value)
     {
+        _thaw();
         if (auto v = options.tryGetValue(name))
         {
             v->clear();
@@ -125,6 +147,7 @@ struct CompilerOptionSet
 
     void add(CompilerOptionName name, CompilerOptionValue value)
     {
+        _thaw();
         if (auto v = options.tryGetValue(name))
         {
             v->add(value);
@@ -138,6 +161,7 @@ struct CompilerOptionSet
         const List<CompilerOptionValue>& value,
         bool replaceDuplicate = true)
     {
+        _thaw();
         if (auto v = options.tryGetValue(name))
         {
             for (auto element : value)
@@ -259,6 +283,8 @@ struct CompilerOptionSet
     static CompilerOptionValue getDefault(CompilerOptionName name);
     bool getBoolOption(CompilerOptionName name)
     {
+        if (isFrozen())
+            return m_frozenIntValues[Index(name)] != 0;
         if (auto result = options.tryGetValue(name))
         {
             SLANG_ASSERT(
@@ -269,6 +295,8 @@ struct CompilerOptionSet
     }
     int getIntOption(CompilerOptionName name)
     {
+        if (isFrozen())
+            return m_frozenIntValues[Index(name)];
         if (auto result = options.tryGetValue(name))
         {
             SLANG_ASSERT(
@@ -356,6 +384,13 @@ struct CompilerOptionSet
 
     bool shouldObfuscateCode() { return getBoolOption(CompilerOptionName::Obfuscate); }
 
+    /// Whether to record per-phase timings for `-report-perf-benchmark` or `-trace-events`.
+    bool shouldProfilePhases()
+    {
+        return getBoolOption(CompilerOptionName::ReportPerfBenchmark) ||
+               hasOption(CompilerOptionName::TraceEvents);
+    }
+
     bool shouldPerformMinimumOptimizations()
     {
         return getBoolOption(CompilerOptionName::MinimumSlangOptimization);
@@ -442,6 +477,14 @@ struct CompilerOptionSet
     List<String> getDownstreamArgs(String downstreamToolName);
 
     void serialize(SerializedOptionsData* outData);
+
+private:
+    void _thaw() { m_frozenIntValues.clear(); }
+
+    // The value `getIntOption` returns for each option, indexed by `CompilerOptionName`,
+    // or empty if the set isn't frozen.
+    List<int> m_frozenIntValues;
+    SHA1::Digest m_frozenDigest;
 };
 
 class DiagnosticSink;
@@ -51,6 +51,58 @@ static bool attemptPrecompiledExport(IRInst* inst)
     return true;
 }
 
+// Does `inst`, or anything nested in it, refer to one of `insts`?
+static bool _refersToAnyOf(IRInst* inst, HashSet<IRInst*> const& insts)
+{
+    if (insts.contains(inst->getFullType()))
+        return true;
+    for (UInt i = 0; i < inst->getOperandCount(); i++)
+    {
+        if (insts.contains(inst->getOperand(i)))
+            return true;
+    }
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        if (_refersToAnyOf(child, insts))
+            return true;
+    }
+    return false;
+}
+
+// Find the global instructions of `module` that depend on a link-time value: an `extern`
+// constant or type that another module may provide, or anything that refers to one, such as
+// an array type sized by it or a function that calls a function using it.
+//
+// Code for these can't be precompiled, since the value is only known once the program is
+// linked. They are left for the final link, which specializes them with the resolved values.
+//
+static void _findLinkTimeDependentInsts(IRModule* module, HashSet<IRInst*>& outInsts)
+{
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (inst->findDecoration<IRUserExternDecoration>())
+            outInsts.add(inst);
+    }
+    if (outInsts.getCount() == 0)
+        return;
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (outInsts.contains(inst))
+                continue;
+            if (_refersToAnyOf(inst, outInsts))
+            {
+                outInsts.add(inst);
+                changed = true;
+            }
+        }
+    }
+}
+
 /*
  * Precompile the module for the given target.
  *
@@ -71,6 +123,8 @@ static bool attemptPrecompiledExport(IRInst* inst)
  * - Functions with no body
  * - Functions marked with unsafeForceInlineDecoration
  * - Functions that define or use generics
+ * - Functions that depend on link-time constants or types, which are
+ *   specialized with the resolved values in the final link instead
  *
  * The functions not rejected up front are marked with
  * DownstreamModuleExportDecoration which indicates functions we're trying to
@@ -89,40 +143,52 @@ static bool attemptPrecompiledExport(IRInst* inst)
  * The original module IR functions matching those are then marked with
  * "AvailableInDownstreamIRDecoration" to indicate to future
  * module users which functions are present in the precompiled blob.
+ *
+ * The blob and the decorations record a key of the target options the code
+ * was generated with (see CodeGenContext::getDownstreamIROptionsKey), and
+ * the code is only linked into programs compiled with the same key. A module
+ * can hold code precompiled for a target with several sets of options.
  */
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics)
 {
-    CodeGenTarget targetEnum = CodeGenTarget(target);
-
-    // Don't precompile twice for the same target
-    for (auto globalInst : getIRModule()->getModuleInst()->getChildren())
-    {
-        if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
-        {
-            if (inst->getTarget() == targetEnum)
-            {
-                return SLANG_OK;
-            }
-        }
-    }
-
-    auto module = getIRModule();
     auto linkage = getLinkage();
-    auto builder = IRBuilder(module);
 
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
-    RefPtr<TargetRequest> targetReq = new TargetRequest(linkage, targetEnum);
+    RefPtr<TargetRequest> targetReq = new TargetRequest(linkage, CodeGenTarget(target));
+
+    SlangResult res = precompileForTargetRequest(targetReq, &sink, true);
+    sink.getBlobIfNeeded(outDiagnostics);
+    return res;
+}
+
+SlangResult Module::precompileForTargetRequest(
+    TargetRequest* targetReq,
+    DiagnosticSink* sink,
+    bool includeEntryPoints)
+{
+    // Precompiling adds instructions and decorations to the module's IR, so two programs
+    // using the module mustn't do it at the same time.
+    std::lock_guard<std::mutex> lock(m_precompileMutex);
+
+    CodeGenTarget targetEnum = targetReq->getTarget();
+
+    auto module = getIRModule();
+    auto linkage = getLinkage();
+    auto builder = IRBuilder(module);
 
     List<RefPtr<ComponentType>> allComponentTypes;
     allComponentTypes.add(this); // Add Module as a component type
 
-    for (auto entryPoint : this->getEntryPoints())
+    if (includeEntryPoints)
     {
-        allComponentTypes.add(entryPoint); // Add the entry point as a component type
+        for (auto entryPoint : this->getEntryPoints())
+        {
+            allComponentTypes.add(entryPoint); // Add the entry point as a component type
+        }
     }
 
     auto composite = CompositeComponentType::create(linkage, allComponentTypes);
@@ -130,8 +196,8 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     composite = fillRequirements(composite);
 
     TargetProgram tp(composite, targetReq);
-    tp.getOrCreateLayout(&sink);
-    Slang::Index const entryPointCount = m_entryPoints.getCount();
+    tp.getOrCreateLayout(sink);
+    Slang::Index const entryPointCount = includeEntryPoints ? m_entryPoints.getCount() : 0;
     tp.getOptionSet().add(CompilerOptionName::GenerateWholeProgram, true);
 
     switch (targetReq->getTarget())
@@ -142,7 +208,10 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     case CodeGenTarget::SPIRV:
         break;
     default:
-        return SLANG_FAIL;
+        // Precompiled code is only of use for targets whose downstream code can be linked
+        // together at the end, which for now is DXIL (through dxc) and SPIR-V (through
+        // spirv-link).
+        return SLANG_E_NOT_AVAILABLE;
     }
 
     tp.getOptionSet().add(CompilerOptionName::EmbedDownstreamIR, true);
@@ -152,18 +221,36 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     entryPointIndices.setCount(entryPointCount);
     for (Index i = 0; i < entryPointCount; i++)
         entryPointIndices[i] = i;
-    CodeGenContext::Shared sharedCodeGenContext(&tp, entryPointIndices, &sink, nullptr);
+    CodeGenContext::Shared sharedCodeGenContext(&tp, entryPointIndices, sink, nullptr);
     CodeGenContext codeGenContext(&sharedCodeGenContext);
 
+    // Don't precompile twice for the same target and options
+    const UInt64 optionsKey = codeGenContext.getDownstreamIROptionsKey();
+    for (auto globalInst : module->getModuleInst()->getChildren())
+    {
+        if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
+        {
+            if (inst->getTarget() == targetEnum && inst->getOptionsKey() == optionsKey)
+            {
+                return SLANG_OK;
+            }
+        }
+    }
+
+    // Precompiling works over the whole module, so it all needs to be read in.
+    module->ensureAllBodiesLoaded();
+
     // Mark all public functions as exported, ensure there's at least one. Store a mapping
     // of function name to IRInst* for later reference. After linking is done, we'll scan
     // the linked result to see which functions survived the pruning and are included in the
     // precompiled blob.
     Dictionary<String, IRInst*> nameToFunction;
+    HashSet<IRInst*> linkTimeDependentInsts;
+    _findLinkTimeDependentInsts(module, linkTimeDependentInsts);
     bool hasAtLeastOneFunction = false;
     for (auto inst : module->getGlobalInsts())
     {
-        if (attemptPrecompiledExport(inst))
+        if (attemptPrecompiledExport(inst) && !linkTimeDependentInsts.contains(inst))
         {
             hasAtLeastOneFunction = true;
             builder.addDecoration(inst, kIROp_DownstreamModuleExportDecoration);
@@ -178,10 +265,13 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
         return SLANG_OK;
     }
 
+    // The new export decorations make these functions link roots, which the linker finds
+    // through the module's lookup tables. Any that are later removed leave a harmless
+    // candidate behind, since linking rechecks the decorations.
+    module->buildMangledNameToGlobalInstMap();
+
     ComPtr<IArtifact> outArtifact;
     SlangResult res = codeGenContext.emitPrecompiledDownstreamIR(outArtifact);
-
-    sink.getBlobIfNeeded(outDiagnostics);
     if (res != SLANG_OK)
     {
         return res;
@@ -199,7 +289,8 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
         builder.addDecoration(
             moduleInst,
             kIROp_AvailableInDownstreamIRDecoration,
-            builder.getIntValue(builder.getIntType(), (int)targetReq->getTarget()));
+            builder.getIntValue(builder.getIntType(), (int)targetReq->getTarget()),
+            builder.getIntValue(builder.getUInt64Type(), IRIntegerValue(optionsKey)));
         auto moduleDec = moduleInst->findDecoration<IRDownstreamModuleExportDecoration>();
         moduleDec->removeAndDeallocate();
     }
@@ -223,7 +314,7 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     // Add the precompiled blob to the module
     builder.setInsertInto(module);
 
-    builder.emitEmbeddedDownstreamIR(targetReq->getTarget(), blob);
+    builder.emitEmbeddedDownstreamIR(targetReq->getTarget(), blob, optionsKey);
     return SLANG_OK;
 }
 
@@ -188,6 +188,13 @@ void checkTranslationUnit(
     TranslationUnitRequest* translationUnit,
     LoadedModuleDictionary& loadedModules);
 
+// Check the bodies of the global functions in `translationUnit` that are
+// reachable from its entry points, when checking them was deferred by
+// `FrontEndCompileRequest::m_checkReachableFunctionsOnly`.
+void checkReachableFunctions(
+    TranslationUnitRequest* translationUnit,
+    LoadedModuleDictionary& loadedModules);
+
 // Look for a module that matches the given name:
 // either one we've loaded already, or one we
 // can find vai the search paths available to us.
@@ -394,6 +394,11 @@ err(
 )
 
 err("null-component-type", 105, "componentTypes[~index:Int] is `nullptr`")
+err(
+    "code-requested-in-reflection-only-mode",
+    106,
+    "cannot generate code for target '~target' in reflection-only mode"
+)
 
 -- Code 99996: moved from 99999 to avoid severity conflict with internal-severity diagnostics at that code.
 standalone_note("note-failed-to-load-dynamic-library", 99996, "failed to load dynamic library '~path'")
@@ -2803,6 +2808,20 @@ err(
     span { loc = "decl:Decl", message = "initializer of static const global '~decl' does not evaluate to a compile-time constant" }
 )
 
+warning(
+    "specialization-constant-requires-static-const",
+    31227,
+    "only static const globals can become specialization constants",
+    span { loc = "decl:Decl", message = "'~decl' is named by '-specialization-constant', but is not a static const global with an initializer" }
+)
+
+warning(
+    "specialization-constant-unsupported-for-target",
+    31228,
+    "target does not support specialization constants",
+    span { loc = "decl:Decl", message = "'~decl' stays a static const, because target '~target' does not support specialization constants" }
+)
+
 -- 3123x - Modifiers and Deprecation (part 2)
 
 err(
@@ -4378,6 +4397,20 @@ err(
     span { loc = "location", message = "loop does not terminate within the limited number of iterations, unrolling is aborted." }
 )
 
+warning(
+    "loop-unroll-budget-exceeded",
+    40021,
+    "loop not fully unrolled",
+    span { loc = "location", message = "loop is left rolled after unrolling ~iterations:Int iterations, because unrolling more would exceed the budget of ~budget:Int instructions set by -loop-unroll-budget" }
+)
+
+warning(
+    "autodiff-checkpoint-budget-exceeded",
+    40022,
+    "checkpoint budget exceeded",
+    span { loc = "location", message = "the backward derivative of '~funcName:IRInst' checkpoints ~bytes:Int bytes per thread, which is over the budget of ~budget:Int bytes set by -autodiff-checkpoint-budget, because the remaining values cannot be recomputed" }
+)
+
 fatal(
     "function-never-returns-fatal",
     40030,
@@ -5173,6 +5206,42 @@ standalone_note(
     "no checkpoint contexts to report"
 )
 
+-- Ray payload liveness reporting notes (-1)
+
+standalone_note(
+    "report-ray-payload-registers",
+    -1,
+    "'~entryPoint:IRInst' accesses ~liveFieldCount:Int of the ~fieldCount:Int fields of ray payload '~payloadType:IRInst', which takes ~registerCount:Int 32-bit payload registers",
+    span { loc = "location" }
+)
+
+standalone_note(
+    "report-function-specialization",
+    -1,
+    "'~function' has ~callCount:Int specialized call sites using ~variantCount:Int specialized functions; ~sharedCount:Int call sites share a function created for another call site",
+    span { loc = "location" }
+)
+
+standalone_note(
+    "report-node-record",
+    -1,
+    "'~entryPoint:IRInst' reads ~readFieldCount:Int of the ~fieldCount:Int fields of node record '~recordType:IRInst', which takes ~size:Int bytes; the fields it reads take ~minimizedSize:Int bytes when ordered by decreasing alignment",
+    span { loc = "location" }
+)
+
+standalone_note(
+    "report-unread-node-record-field",
+    -1,
+    "field '~field:IRInst' of node record '~recordType:IRInst' is never read by '~entryPoint:IRInst'",
+    span { loc = "location" }
+)
+
+standalone_note(
+    "compile-time-budget-degraded",
+    -1,
+    "reduced optimizations to stay within the compile time budget of ~budget:Int ms: ~optimizations"
+)
+
 -- 9xxxx - Documentation generation (90001)
 
 warning(
@@ -1165,8 +1165,14 @@ String CLikeSourceEmitter::_generateUniqueName(const UnownedStringSlice& name)
     // Except that we will "scrub" the name first,
     // and we will omit the underscore if the (scrubbed)
     // name hint already ends with one.
+    //
+    // Names produced here live for the whole emit in `m_mapInstToName`, so
+    // the builder is sized for the name rather than using the default
+    // capacity. The counter key is only copied out of the builder the first
+    // time a name is seen, so that appending the suffix doesn't force the
+    // builder to reallocate.
 
-    StringBuilder sb;
+    StringBuilder sb(name.getLength() + 16);
 
     appendScrubbedName(name, sb);
 
@@ -1176,11 +1182,10 @@ String CLikeSourceEmitter::_generateUniqueName(const UnownedStringSlice& name)
         sb.append("_");
     }
 
-    String key = sb.produceString();
-
-    UInt& countRef = m_uniqueNameCounters.getOrAddValue(key, 0);
-    const UInt count = countRef;
-    countRef = count + 1;
+    UInt* countPtr = m_uniqueNameCounters.tryGetValue(sb.getUnownedSlice());
+    if (!countPtr)
+        countPtr = &m_uniqueNameCounters.getOrAddValue(String(sb.getUnownedSlice()), 0);
+    const UInt count = (*countPtr)++;
 
     sb.append(Int32(count));
     return sb.produceString();
@@ -1271,9 +1276,10 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
     {
         if (ptrType->getAddressSpace() == AddressSpace::UserPointer)
         {
-            StringBuilder sb;
+            String elementName = getName(inst->getOperand(0));
+            StringBuilder sb(elementName.getLength() + 32);
             sb << "BufferPointer_";
-            sb << getName(inst->getOperand(0));
+            sb << elementName;
             sb << "_" << Int32(getID(inst));
             return sb.produceString();
         }
@@ -1281,7 +1287,7 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
 
     // Otherwise fall back to a construct temporary name
     // for the instruction.
-    StringBuilder sb;
+    StringBuilder sb(16);
     sb << "_S";
     sb << Int32(getID(inst));
 
@@ -5413,6 +5419,18 @@ void CLikeSourceEmitter::emitForwardDeclaration(IRInst* inst)
 
 void CLikeSourceEmitter::executeEmitActions(List<EmitAction> const& actions)
 {
+    // Actions are executed one at a time, in order, into the single `m_writer`.
+    //
+    // Emitting a function body is not independent of the other actions. It looks up
+    // and lazily creates names (`m_mapInstToName`, `m_uniqueNameCounters` and
+    // `m_mapIRValueToID`), and the order of those lookups decides the suffix each name
+    // gets. It records preludes and extension requirements, and `ensurePrelude` adds
+    // string literals to the IR module. Emitting bodies into separate buffers on worker
+    // threads would first need every name assigned up front and those side tables made
+    // per-job and merged in order. Until then, the way to use more than one thread for
+    // code generation is `-codegen-threads`, which emits separate entry points and
+    // targets in parallel.
+
     for (auto action : actions)
     {
         switch (action.level)
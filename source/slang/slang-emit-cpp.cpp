@@ -1006,6 +1006,11 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // A vectorized thread loop needs the workhorse inlined into it.
+        //
+        if (m_vectorizeThreadGroups)
+            m_writer->emit("SLANG_FORCE_INLINE ");
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -1155,9 +1160,7 @@ void CPPSourceEmitter::_emitType(IRType* type, DeclaratorInfo* declarator)
     case kIROp_VectorType:
     case kIROp_MatrixType:
         {
-            StringBuilder sb;
-            calcTypeName(type, m_target, sb);
-            m_writer->emit(sb.produceString());
+            m_writer->emit(_getTypeName(type));
             m_writer->emit(" ");
             emitDeclarator(declarator);
             break;
@@ -2171,6 +2174,53 @@ void CPPSourceEmitter::_emitEntryPointGroup(
     }
 }
 
+void CPPSourceEmitter::_emitVectorizedEntryPointGroup(
+    const Int sizeAlongAxis[kThreadGroupAxisCount],
+    const String& funcName)
+{
+    List<AxisWithSize> axes;
+    _calcAxisOrder(sizeAlongAxis, true, axes);
+
+    // The outer axes are looped over as before. The innermost loop gives each thread an
+    // input of its own, so that the iterations share no memory and can become SIMD lanes.
+    StringBuilder builder;
+    for (Index i = 0; i < axes.getCount(); ++i)
+    {
+        const auto& axis = axes[i];
+        const bool isInnermost = i == axes.getCount() - 1;
+        builder.clear();
+        const char elem[2] = {s_xyzwNames[axis.axis], 0};
+        if (isInnermost)
+            builder << "SLANG_PRELUDE_THREAD_LOOP\n";
+        builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++"
+                << elem << ")\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+
+        builder.clear();
+        if (isInnermost)
+        {
+            builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+            builder << "laneInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        else
+        {
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        m_writer->emit(builder);
+    }
+
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit("(&laneInput, entryPointParams, globalParams);\n");
+
+    for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
+    {
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(
     const Int sizeAlongAxis[kThreadGroupAxisCount],
     const String& funcName)
@@ -2275,10 +2325,47 @@ void CPPSourceEmitter::_emitForwardDeclarations(const List<EmitAction>& actions)
     }
 }
 
+// Threads of a group can only run as SIMD lanes if they don't communicate. Group shared
+// memory, barriers and atomics are the ways they can, so a module that uses any of them keeps
+// the serial thread loop.
+static bool _canVectorizeThreadGroups(IRModule* module)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (as<IRGroupSharedRate>(globalInst->getRate()))
+            return false;
+
+        auto func = as<IRFunc>(globalInst);
+        if (!func)
+            continue;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (as<IRAtomicOperation>(inst))
+                    return false;
+                switch (inst->getOp())
+                {
+                case kIROp_GroupMemoryBarrierWithGroupSync:
+                case kIROp_ControlBarrier:
+                    return false;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 {
     SLANG_UNUSED(sink);
 
+    m_vectorizeThreadGroups = getTargetProgram()->getOptionSet().getBoolOption(
+                                  CompilerOptionName::CPUVectorizeThreadGroups) &&
+                              _canVectorizeThreadGroups(module);
+
     List<EmitAction> actions;
     computeEmitActions(module, actions);
 
@@ -2371,7 +2458,10 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    if (m_vectorizeThreadGroups)
+                        _emitVectorizedEntryPointGroup(groupThreadSize, funcName);
+                    else
+                        _emitEntryPointGroup(groupThreadSize, funcName);
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -122,6 +122,9 @@ protected:
     void _emitEntryPointGroup(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
         const String& funcName);
+    void _emitVectorizedEntryPointGroup(
+        const Int sizeAlongAxis[kThreadGroupAxisCount],
+        const String& funcName);
     void _emitEntryPointGroupRange(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
         const String& funcName);
@@ -155,6 +158,9 @@ protected:
     List<IRWitnessTable*> pendingWitnessTableDefinitions;
 
     bool m_hasString = false;
+
+    // Set if the threads of a group are emitted as a loop the C++ compiler can vectorize.
+    bool m_vectorizeThreadGroups = false;
 };
 
 } // namespace Slang
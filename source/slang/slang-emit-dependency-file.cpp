@@ -1,6 +1,7 @@
 // slang-emit-dependency-file.cpp
 #include "slang-emit-dependency-file.h"
 
+#include "../compiler-core/slang-json-parser.h"
 #include "slang-compiler.h"
 
 namespace Slang
@@ -63,50 +64,34 @@ static void _writeDependencyStatement(
     }
 }
 
-// Writes a file with dependency info, with one line in the output file per compile product.
-SlangResult writeDependencyFile(EndToEndCompileRequest* compileRequest)
+// Gathers the path of every compile product, in the order their dependency statements are
+// written.
+static void _gatherOutputPaths(EndToEndCompileRequest* compileRequest, List<String>& outPaths)
 {
-    if (compileRequest->m_dependencyOutputPath.getLength() == 0)
-        return SLANG_OK;
-
-    FileStream stream;
-    SLANG_RETURN_ON_FAIL(stream.init(
-        compileRequest->m_dependencyOutputPath,
-        FileMode::Create,
-        FileAccess::Write,
-        FileShare::ReadWrite));
-
     auto linkage = compileRequest->getLinkage();
     auto program = compileRequest->getSpecializedGlobalAndEntryPointsComponentType();
 
     // Iterate over all the targets and their outputs
     for (const auto& targetReq : linkage->targets)
     {
+        RefPtr<EndToEndCompileRequest::TargetInfo> targetInfo;
+        if (!compileRequest->m_targetInfos.tryGetValue(targetReq, targetInfo))
+            continue;
+
         if (compileRequest->getTargetOptionSet(targetReq).getBoolOption(
                 CompilerOptionName::GenerateWholeProgram))
         {
-            RefPtr<EndToEndCompileRequest::TargetInfo> targetInfo;
-            if (compileRequest->m_targetInfos.tryGetValue(targetReq, targetInfo))
-            {
-                _writeDependencyStatement(
-                    stream,
-                    compileRequest,
-                    targetInfo->wholeTargetOutputPath);
-            }
+            outPaths.add(targetInfo->wholeTargetOutputPath);
         }
         else
         {
             Index entryPointCount = program->getEntryPointCount();
             for (Index entryPointIndex = 0; entryPointIndex < entryPointCount; ++entryPointIndex)
             {
-                RefPtr<EndToEndCompileRequest::TargetInfo> targetInfo;
-                if (compileRequest->m_targetInfos.tryGetValue(targetReq, targetInfo))
+                String outputPath;
+                if (targetInfo->entryPointOutputPaths.tryGetValue(entryPointIndex, outputPath))
                 {
-                    String outputPath;
-                    if (targetInfo->entryPointOutputPaths.tryGetValue(entryPointIndex, outputPath))
-                    {
-                        _writeDependencyStatement(stream, compileRequest, outputPath);
-                    }
+                    outPaths.add(outputPath);
                 }
             }
         }
@@ -116,7 +101,132 @@ SlangResult writeDependencyFile(EndToEndCompileRequest* compileRequest)
     // we need to do their dependencies separately.
     if (compileRequest->m_containerFormat == ContainerFormat::SlangModule)
     {
-        _writeDependencyStatement(stream, compileRequest, compileRequest->m_containerOutputPath);
+        outPaths.add(compileRequest->m_containerOutputPath);
+    }
+}
+
+// `quotedKey` includes its quotes, as `JSONWriter::addQuotedKey` expects.
+static void _writeStringField(
+    JSONWriter& writer,
+    const char* quotedKey,
+    const UnownedStringSlice& value)
+{
+    writer.addQuotedKey(UnownedStringSlice(quotedKey), SourceLoc());
+    writer.addStringValue(value, SourceLoc());
+}
+
+// Writes the dependencies as JSON, recording a digest of everything the outputs were produced
+// from, as well as the paths. This lets a build system tell a change to a dependency that
+// leaves its content as it was (such as a touched file) from one that doesn't.
+//
+//  {
+//      "outputs": [<output-file>...],
+//      "options": <digest of the options for the linkage and every target>,
+//      "files": [{"path": <dependency-file>, "digest": <digest of its content>}...],
+//      "modules": [{"name": <module-name>, "digest": <digest of the module>}...]
+//  }
+//
+// A module's digest covers its own options and the content of every file it depends on, so it
+// changes whenever the module could compile differently.
+static SlangResult _writeJSONDependencyFile(
+    EndToEndCompileRequest* compileRequest,
+    const List<String>& outputPaths)
+{
+    auto linkage = compileRequest->getLinkage();
+    auto program = compileRequest->getFrontEndReq()->getGlobalAndEntryPointsComponentType();
+
+    JSONWriter writer(JSONWriter::IndentationStyle::KNR);
+    writer.startObject(SourceLoc());
+
+    writer.addQuotedKey(UnownedStringSlice("\"outputs\""), SourceLoc());
+    writer.startArray(SourceLoc());
+    for (const auto& outputPath : outputPaths)
+    {
+        if (outputPath.getLength())
+            writer.addStringValue(outputPath.getUnownedSlice(), SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+
+    {
+        DigestBuilder<SHA1> optionsDigest;
+        linkage->m_optionSet.buildHash(optionsDigest);
+        for (const auto& targetReq : linkage->targets)
+        {
+            compileRequest->getTargetOptionSet(targetReq).buildHash(optionsDigest);
+        }
+        _writeStringField(
+            writer,
+            "\"options\"",
+            optionsDigest.finalize().toString().getUnownedSlice());
+    }
+
+    writer.addQuotedKey(UnownedStringSlice("\"files\""), SourceLoc());
+    writer.startArray(SourceLoc());
+    for (auto sourceFile : program->getFileDependencies())
+    {
+        const auto& pathInfo = sourceFile->getPathInfo();
+        writer.startObject(SourceLoc());
+        _writeStringField(
+            writer,
+            "\"path\"",
+            pathInfo.hasFoundPath() ? pathInfo.getMostUniqueIdentity().getUnownedSlice()
+                                    : UnownedStringSlice("unknown"));
+        _writeStringField(
+            writer,
+            "\"digest\"",
+            sourceFile->getDigest().toString().getUnownedSlice());
+        writer.endObject(SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+
+    writer.addQuotedKey(UnownedStringSlice("\"modules\""), SourceLoc());
+    writer.startArray(SourceLoc());
+    for (auto module : program->getModuleDependencies())
+    {
+        const char* name = module->getName();
+        writer.startObject(SourceLoc());
+        _writeStringField(writer, "\"name\"", UnownedStringSlice(name ? name : ""));
+        _writeStringField(
+            writer,
+            "\"digest\"",
+            module->computeDigest().toString().getUnownedSlice());
+        writer.endObject(SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+
+    writer.endObject(SourceLoc());
+    writer.getBuilder().appendChar('\n');
+
+    const auto& content = writer.getBuilder();
+    return File::writeAllBytes(
+        compileRequest->m_dependencyOutputPath,
+        content.getBuffer(),
+        content.getLength());
+}
+
+// Writes a file with dependency info. A path ending in `.json` gets the JSON form with
+// digests, anything else gets a make style file with one line per compile product.
+SlangResult writeDependencyFile(EndToEndCompileRequest* compileRequest)
+{
+    if (compileRequest->m_dependencyOutputPath.getLength() == 0)
+        return SLANG_OK;
+
+    List<String> outputPaths;
+    _gatherOutputPaths(compileRequest, outputPaths);
+
+    if (Path::getPathExt(compileRequest->m_dependencyOutputPath) == "json")
+        return _writeJSONDependencyFile(compileRequest, outputPaths);
+
+    FileStream stream;
+    SLANG_RETURN_ON_FAIL(stream.init(
+        compileRequest->m_dependencyOutputPath,
+        FileMode::Create,
+        FileAccess::Write,
+        FileShare::ReadWrite));
+
+    for (const auto& outputPath : outputPaths)
+    {
+        _writeDependencyStatement(stream, compileRequest, outputPath);
     }
 
     return SLANG_OK;
@@ -694,8 +694,16 @@ struct LLVMEmitter
             Slang::LLVMBuilderOptions options,
             Slang::IArtifact** outErrorArtifact);
 
+        using BuilderFuncV3 = SlangResult (*)(
+            const SlangUUID& intfGuid,
+            Slang::ILLVMBuilder** out,
+            Slang::LLVMBuilderOptionsV3 options,
+            Slang::IArtifact** outErrorArtifact);
+
+        // An older slang-llvm only has the V2 entry point, which can't cache JIT output.
+        auto builderFuncV3 = (BuilderFuncV3)library->findFuncByName("createLLVMBuilder_V3");
         auto builderFunc = (BuilderFuncV2)library->findFuncByName("createLLVMBuilder_V2");
-        if (!builderFunc)
+        if (!builderFuncV3 && !builderFunc)
             return SLANG_FAIL;
 
         auto targetTripleOption =
@@ -711,7 +719,7 @@ struct LLVMEmitter
         getOptions().writeCommandLineArgs(codeGenContext->getSession(), sb);
         auto params = sb.toString();
 
-        LLVMBuilderOptions builderOpt;
+        LLVMBuilderOptionsV3 builderOpt;
         builderOpt.target = asExternal(codeGenContext->getTargetFormat());
         builderOpt.targetTriple = CharSlice();
         // For JIT, we must always use the host target triple
@@ -733,12 +741,38 @@ struct LLVMEmitter
             llvmArguments.add(TerminatedCharSlice(arg.getBuffer()));
         builderOpt.llvmArguments = Slice(llvmArguments.begin(), llvmArguments.getCount());
 
+        // JIT output is cached next to the shader cache, in its own directory so the
+        // two caches don't share an index.
+        String jitCacheDirectory;
+        if (useJIT)
+        {
+            auto shaderCacheDirectory =
+                getOptions().getStringOption(CompilerOptionName::ShaderCacheDirectory);
+            if (shaderCacheDirectory.getLength())
+                jitCacheDirectory = Path::combine(shaderCacheDirectory, "llvm-jit");
+        }
+        builderOpt.jitObjectCacheDirectory =
+            CharSlice(jitCacheDirectory.getBuffer(), jitCacheDirectory.getLength());
+        builderOpt.jitCompileThreadCount =
+            getOptions().getIntOption(CompilerOptionName::CodeGenThreadCount);
+
         ComPtr<IArtifact> errorArtifact;
-        SLANG_RETURN_ON_FAIL(builderFunc(
-            ILLVMBuilder::getTypeGuid(),
-            builder.writeRef(),
-            builderOpt,
-            errorArtifact.writeRef()));
+        if (builderFuncV3)
+        {
+            SLANG_RETURN_ON_FAIL(builderFuncV3(
+                ILLVMBuilder::getTypeGuid(),
+                builder.writeRef(),
+                builderOpt,
+                errorArtifact.writeRef()));
+        }
+        else
+        {
+            SLANG_RETURN_ON_FAIL(builderFunc(
+                ILLVMBuilder::getTypeGuid(),
+                builder.writeRef(),
+                builderOpt,
+                errorArtifact.writeRef()));
+        }
 
         if (errorArtifact)
         {
@@ -64,20 +64,28 @@ void SourceWriter::_emitTextSpan(char const* textBegin, char const* textEnd)
         // at the start of a line, so we will emit the proper
         // amount of indentation to keep things looking nice.
         m_isAtStartOfLine = false;
-        for (Int ii = 0; ii < m_indentLevel; ++ii)
+
+        // Indentation is appended in runs taken from a fixed buffer of spaces,
+        // rather than one level at a time.
+        static const char kSpaces[] = "                                ";
+        const Index kIndentSize = 4;
+        const Index kSpacesCount = SLANG_COUNT_OF(kSpaces) - 1;
+
+        Index remaining = m_indentLevel * kIndentSize;
+        while (remaining > 0)
         {
-            char const* indentString = "    ";
-            size_t indentStringSize = strlen(indentString);
-            emitRawTextSpan(indentString, indentString + indentStringSize);
-
-            // We will also update our tracking location, just in
-            // case other logic needs it.
-            //
-            // TODO: We may need to have a switch that controls whether
-            // we are in "pretty-printing" mode or "follow the locations
-            // in the original code" mode.
-            m_loc.column += indentStringSize;
+            const Index count = Math::Min(remaining, kSpacesCount);
+            emitRawTextSpan(kSpaces, kSpaces + count);
+            remaining -= count;
         }
+
+        // We will also update our tracking location, just in
+        // case other logic needs it.
+        //
+        // TODO: We may need to have a switch that controls whether
+        // we are in "pretty-printing" mode or "follow the locations
+        // in the original code" mode.
+        m_loc.column += m_indentLevel * kIndentSize;
     }
 
     // Emit the raw text
@@ -100,6 +108,12 @@ void SourceWriter::dedent()
 
 void SourceWriter::emitChar(char c)
 {
+    // Only a newline needs the line tracking in `emit`
+    if (c != '\n')
+    {
+        _emitTextSpan(&c, &c + 1);
+        return;
+    }
     emit(&c, &c + 1);
 }
 
@@ -268,25 +282,26 @@ void SourceWriter::emit(double value)
     // separate the mantissa and exponent part, as we want to remove the
     // trailing 0s from the mantissa part. If we selected the fixed format
     // above, the 'exponentStr' will be empty.
-    std::string mantissaStr = str.substr(0, found);
-    std::string exponentStr = str.substr(found, str.length());
+    //
+    // The two parts are emitted directly from `str` rather than copied out.
+    const char* mantissaBegin = str.c_str();
+    const char* mantissaEnd = mantissaBegin + found;
 
     // Remove redundant trailing 0s.
-    if (mantissaStr.end() > mantissaStr.begin())
+    if (mantissaEnd > mantissaBegin)
     {
-        auto lastChar = mantissaStr.end() - 1;
-        while (lastChar > mantissaStr.begin() && *lastChar == '0')
+        auto lastChar = mantissaEnd - 1;
+        while (lastChar > mantissaBegin && *lastChar == '0')
             lastChar--;
         if (*lastChar == '.')
             lastChar++;
-        if (lastChar > mantissaStr.end() - 1)
-            lastChar = mantissaStr.end() - 1;
-        mantissaStr = mantissaStr.substr(0, lastChar - mantissaStr.begin() + 1);
+        if (lastChar > mantissaEnd - 1)
+            lastChar = mantissaEnd - 1;
+        mantissaEnd = lastChar + 1;
     }
 
-    auto finalStr = mantissaStr + exponentStr;
-    auto slice = UnownedStringSlice(finalStr.c_str());
-    emit(slice);
+    emit(mantissaBegin, mantissaEnd);
+    emit(str.c_str() + found, str.c_str() + str.length());
 }
 
 void SourceWriter::advanceToSourceLocationIfValid(const SourceLoc& sourceLocation)
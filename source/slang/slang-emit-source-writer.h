@@ -105,10 +105,12 @@ protected:
     void _calcLocation(Index& outLineIndex, Index& outColumnIndex);
 
     // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+    //
+    // This is kept as one contiguous buffer rather than chunks, because `_calcLocation`
+    // scans the text emitted since the last source map entry, and the buffer is easy
+    // to inspect when debugging. It grows geometrically, so appends are amortized and
+    // the callers in the emitters should append slices directly rather than building
+    // temporary strings.
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
@@ -456,7 +456,7 @@ template<typename T>
 SpvInst* emitOpConstant(IRInst* inst, const T& idResultType, const SpvLiteralBits& value)
 {
     static_assert(isSingular<T>);
-    return emitInst(
+    return emitInstMemoizedWithResultType(
         getSection(SpvLogicalSectionID::ConstantsAndTypes),
         inst,
         SpvOpConstant,
@@ -471,7 +471,7 @@ SpvInst* emitOpConstantComposite(IRInst* inst, const T& idResultType, const Ts&
 {
     static_assert(isSingular<T>);
     static_assert(isPlural<Ts>);
-    return emitInst(
+    return emitInstMemoizedWithResultType(
         getSection(SpvLogicalSectionID::ConstantsAndTypes),
         inst,
         SpvOpConstantComposite,
@@ -1422,7 +1422,13 @@ SpvInst* emitOpConstantComposite(
 {
     static_assert(isSingular<T>);
     static_assert(isPlural<Ts>);
-    return emitInst(parent, inst, SpvOpConstantComposite, idResultType, kResultID, constituents);
+    return emitInstMemoizedWithResultType(
+        parent,
+        inst,
+        SpvOpConstantComposite,
+        idResultType,
+        kResultID,
+        constituents);
 }
 
 // https://registry.khronos.org/SPIR-V/specs/unified1/SPIRV.html#OpCompositeExtract
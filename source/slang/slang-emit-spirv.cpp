@@ -136,8 +136,12 @@ public:
     /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-    /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+    /// Get the number of SPIR-V words that all children, recursively, encode to
+    Count calcWordCount() const;
+
+    /// Dump all children, recursively, as flattened SPIR-V words starting at `dst`,
+    /// which must have room for `calcWordCount()` words. Returns the end of the written words.
+    SpvWord* dumpTo(SpvWord* dst) const;
 
     /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -211,8 +215,14 @@ struct SpvInst : SpvInstParent
     /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-    /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+    /// Get the number of words the instruction (and any children, recursively) encodes to.
+    Count calcWordCount() const
+    {
+        return 1 + Count(operandWordsCount) + SpvInstParent::calcWordCount();
+    }
+
+    /// Dump the instruction (and any children, recursively) as flat SPIR-V words at `dst`.
+    SpvWord* dumpTo(SpvWord* dst) const
     {
         // [2.2: Terms]
         //
@@ -227,11 +237,15 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        *dst++ = wordCount << 16 | opcode;
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        if (operandWordsCount)
+        {
+            ::memcpy(dst, operandWords, sizeof(SpvWord) * operandWordsCount);
+            dst += operandWordsCount;
+        }
 
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -240,7 +254,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        return SpvInstParent::dumpTo(dst);
     }
 
     void removeFromParent()
@@ -310,12 +324,23 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+Count SpvInstParent::calcWordCount() const
+{
+    Count wordCount = 0;
+    for (auto child = m_firstChild; child; child = child->nextSibling)
+    {
+        wordCount += child->calcWordCount();
+    }
+    return wordCount;
+}
+
+SpvWord* SpvInstParent::dumpTo(SpvWord* dst) const
 {
     for (auto child = m_firstChild; child; child = child->nextSibling)
     {
-        child->dumpTo(ioWords);
+        dst = child->dumpTo(dst);
     }
+    return dst;
 }
 
 /// The context for inlining a SPV assembly snippet.
@@ -498,6 +523,33 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     SpvInst* m_nullDwarfExpr = nullptr;
 
+    // The line and scope most recently emitted into `m_debugLocationBlock`.
+    // A line or scope stays in effect until the next one or the end of the
+    // block, so one that repeats the current location is dropped instead of
+    // being emitted again for every instruction of a source line.
+    SpvInstParent* m_debugLocationBlock = nullptr;
+    IRDebugLine* m_currentDebugLine = nullptr;
+    IRDebugScope* m_currentDebugScope = nullptr;
+
+    static bool _isSameDebugLine(IRDebugLine* a, IRDebugLine* b)
+    {
+        return a && b && a->getSource() == b->getSource() &&
+               a->getLineStart() == b->getLineStart() && a->getLineEnd() == b->getLineEnd() &&
+               a->getColStart() == b->getColStart() && a->getColEnd() == b->getColEnd();
+    }
+
+    static bool _isSameDebugScope(IRDebugScope* a, IRDebugScope* b)
+    {
+        return a && b && a->getScope() == b->getScope() && a->getInlinedAt() == b->getInlinedAt();
+    }
+
+    void _resetDebugLocation(SpvInstParent* block)
+    {
+        m_debugLocationBlock = block;
+        m_currentDebugLine = nullptr;
+        m_currentDebugScope = nullptr;
+    }
+
     // A hash set to prevent redecorating the same spv inst.
     HashSet<SpvId> m_decoratedSpvInsts;
 
@@ -526,6 +578,20 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     ///
     void emitPhysicalLayout()
     {
+        // The size of every section is known up front, so `m_words` is allocated once at its
+        // final size and each section is written straight into its part of it, rather than
+        // growing the list an instruction at a time.
+        //
+        static const Count kHeaderWordCount = 5;
+        Count sectionWordCounts[int(SpvLogicalSectionID::Count)];
+        Count wordCount = kHeaderWordCount;
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        {
+            sectionWordCounts[ii] = m_sections[ii].calcWordCount();
+            wordCount += sectionWordCounts[ii];
+        }
+        m_words.reserve(wordCount);
+
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
@@ -558,10 +624,17 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // Once we are done emitting the header, we emit all
         // the instructions in our logical sections.
         //
+        SLANG_ASSERT(m_words.getCount() == kHeaderWordCount);
+        m_words.setCount(wordCount);
+
+        SpvWord* dst = m_words.getBuffer() + kHeaderWordCount;
         for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
         {
-            m_sections[ii].dumpTo(m_words);
+            SpvWord* sectionEnd = m_sections[ii].dumpTo(dst);
+            SLANG_ASSERT(sectionEnd == dst + sectionWordCounts[ii]);
+            dst = sectionEnd;
         }
+        SLANG_UNUSED(dst);
     }
 
     // We will often need to refer to an instrcition by its
@@ -1398,6 +1471,70 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         ResultIDToken resultId,
         const OperandEmitFunc& f,
         List<SpvWord>&& extraKeyData)
+    {
+        SLANG_UNUSED(resultId);
+        return _emitInstMemoized(parent, irInst, opcode, MemoizedResultID::First, f, extraKeyData);
+    }
+
+    template<typename OperandEmitFunc>
+    SpvInst* emitInstMemoizedNoResultIDCustomOperandFunc(
+        SpvInstParent* parent,
+        IRInst* irInst,
+        SpvOp opcode,
+        const OperandEmitFunc& f)
+    {
+        return _emitInstMemoized(
+            parent,
+            irInst,
+            opcode,
+            MemoizedResultID::None,
+            f,
+            List<SpvWord>());
+    }
+
+    // Emits a SPV Inst whose result <id> follows its result type, such as a
+    // constant, with deduplication
+    template<typename T, typename... Operands>
+    SpvInst* emitInstMemoizedWithResultType(
+        SpvInstParent* parent,
+        IRInst* irInst,
+        SpvOp opcode,
+        const T& idResultType,
+        // We take the resultId here explicitly here to make sure we don't try
+        // and memoize its value.
+        ResultIDToken resultId,
+        const Operands&... ops)
+    {
+        SLANG_UNUSED(resultId);
+        return _emitInstMemoized(
+            parent,
+            irInst,
+            opcode,
+            MemoizedResultID::AfterResultType,
+            [&]()
+            {
+                emitOperand(idResultType);
+                (emitOperand(ops), ...);
+            },
+            List<SpvWord>());
+    }
+
+    // Where the result <id> of a memoized instruction goes among its operands
+    enum class MemoizedResultID
+    {
+        None,            // No result <id>, as for a decoration
+        First,           // The first operand, as for a type
+        AfterResultType, // After the result type, as for a constant
+    };
+
+    template<typename OperandEmitFunc>
+    SpvInst* _emitInstMemoized(
+        SpvInstParent* parent,
+        IRInst* irInst,
+        SpvOp opcode,
+        MemoizedResultID resultIDPosition,
+        const OperandEmitFunc& f,
+        List<SpvWord> const& extraKeyData)
     {
         List<SpvWord> ourOperands;
         {
@@ -1409,13 +1546,27 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         }
 
         // Hash the opcode, encoded operands, and any caller-provided key data.
-        SpvInstKey key;
+        // The lookup reuses the storage of a single key, so that finding a
+        // duplicate, which is the common case for types and constants in
+        // heavily specialized programs, doesn't allocate.
+        SpvInstKey& key = m_memoizeLookupKey;
+        key.instWords.clear();
         key.instWords.add(opcode);
         key.instWords.addRange(ourOperands);
-        key.extraKeyData = std::move(extraKeyData);
+        key.extraKeyData.clear();
+        key.extraKeyData.addRange(extraKeyData);
 
-        // If we have seen this before, return the memoized instruction
-        if (SpvInst** memoized = m_memoizedSpvInsts.tryGetValue(key))
+        // If we have seen this before, return the memoized instruction.
+        // A constant that other instructions already refer to by a reserved
+        // <id> needs an instruction of its own to carry that <id>, which is
+        // valid since SPIR-V allows duplicate constants.
+        SpvInst** memoized = m_memoizedSpvInsts.tryGetValue(key);
+        if (memoized && resultIDPosition == MemoizedResultID::AfterResultType && irInst &&
+            m_mapIRInstToSpvID.containsKey(irInst))
+        {
+            memoized = nullptr;
+        }
+        if (memoized)
         {
             // There could be another different slang IR inst that translates to
             // the same spir-v inst.
@@ -1431,56 +1582,25 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // Otherwise, we can construct our instruction and record the result
         InstConstructScope scopeInst(this, opcode, irInst);
         SpvInst* spvInst = scopeInst;
-        m_memoizedSpvInsts[key] = spvInst;
+        m_memoizedSpvInsts.addIfNotExists(key, spvInst);
 
         // Emit our operands, this time with the resultId too
-        emitOperand(resultId);
-        m_operandStack.addRange(ourOperands);
-
-        parent->addInst(spvInst);
-        return spvInst;
-    }
-
-    template<typename OperandEmitFunc>
-    SpvInst* emitInstMemoizedNoResultIDCustomOperandFunc(
-        SpvInstParent* parent,
-        IRInst* irInst,
-        SpvOp opcode,
-        const OperandEmitFunc& f)
-    {
-        List<SpvWord> ourOperands;
-        {
-            auto scopePeek = OperandMemoizeScope(this);
-            f();
-            // Steal our operands back, so we don't have to calculate them
-            // again
-            ourOperands = std::move(m_operandStack);
-        }
-
-        // Hash the opcode and encoded operands.
-        SpvInstKey key;
-        key.instWords.add(opcode);
-        key.instWords.addRange(ourOperands);
-
-        // If we have seen this before, return the memoized instruction
-        if (SpvInst** memoized = m_memoizedSpvInsts.tryGetValue(key))
+        switch (resultIDPosition)
         {
-            // Different Slang IR instructions can produce the same no-result
-            // SPIR-V instruction, so keep the later IR instruction mapped to
-            // the memoized instruction.
-            if (irInst)
-                m_mapIRInstToSpvInst.addIfNotExists(irInst, *memoized);
-            return *memoized;
+        case MemoizedResultID::None:
+            m_operandStack.addRange(ourOperands);
+            break;
+        case MemoizedResultID::First:
+            emitOperand(kResultID);
+            m_operandStack.addRange(ourOperands);
+            break;
+        case MemoizedResultID::AfterResultType:
+            m_operandStack.add(ourOperands[0]);
+            emitOperand(kResultID);
+            m_operandStack.addRange(ourOperands.getBuffer() + 1, ourOperands.getCount() - 1);
+            break;
         }
 
-        // Otherwise, construct our instruction and record it in the memoization table.
-        InstConstructScope scopeInst(this, opcode, irInst);
-        SpvInst* spvInst = scopeInst;
-        m_memoizedSpvInsts[key] = spvInst;
-
-        // Replay operands captured by the memoize scope into the live instruction.
-        m_operandStack.addRange(ourOperands);
-
         parent->addInst(spvInst);
         return spvInst;
     }
@@ -1905,6 +2025,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     Dictionary<SpvInstKey, SpvInst*> m_memoizedSpvInsts;
 
+    // The key used to look up `m_memoizedSpvInsts`, kept to reuse its storage.
+    SpvInstKey m_memoizeLookupKey;
+
     // `IRSizeAndAlignmentDecoration` currently serves two purposes: it caches
     // the result of layout queries on a type, and it is also the closest signal
     // we have for which concrete layout should drive SPIR-V layout emission.
@@ -9893,6 +10016,11 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     SpvInst* emitDebugLine(SpvInstParent* parent, IRDebugLine* debugLine)
     {
+        if (parent != m_debugLocationBlock)
+            _resetDebugLocation(parent);
+        else if (_isSameDebugLine(debugLine, m_currentDebugLine))
+            return nullptr;
+
         // For Minimal (g1), emit standard SPIR-V OpLine for line number tracking only
         auto debugLevel = m_targetProgram->getOptionSet().getDebugInfoLevel();
         if (debugLevel == DebugInfoLevel::Minimal)
@@ -9904,6 +10032,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             // Extract the filename from the IRDebugSource instruction
             // IRDebugSource has: operand 0 = filename, operand 1 = source content
             auto debugSource = as<IRDebugSource>(debugLine->getSource());
+            m_currentDebugLine = debugLine;
             return emitInst(
                 parent,
                 debugLine,
@@ -9918,6 +10047,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         auto scope = findDebugScope(debugLine);
         if (!scope)
             return nullptr;
+        m_currentDebugLine = debugLine;
         return emitOpDebugLine(
             parent,
             debugLine,
@@ -9945,6 +10075,11 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     SpvInst* emitDebugScope(SpvInstParent* parent, IRDebugScope* debugScope)
     {
+        if (parent != m_debugLocationBlock)
+            _resetDebugLocation(parent);
+        else if (_isSameDebugScope(debugScope, m_currentDebugScope))
+            return nullptr;
+
         auto inlinedAt = ensureInst(debugScope->getInlinedAt());
         if (!inlinedAt)
             return nullptr;
@@ -9953,6 +10088,10 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         if (!scope)
             return nullptr;
 
+        // Lines are only merged within a scope, so that a debugger sees the line
+        // again after stepping into or out of inlined code.
+        m_currentDebugScope = debugScope;
+        m_currentDebugLine = nullptr;
         return emitOpDebugScope(
             parent,
             nullptr,
@@ -10019,6 +10158,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     SpvInst* emitDebugNoScope(SpvInstParent* parent)
     {
+        _resetDebugLocation(parent);
         return emitOpDebugNoScope(parent, nullptr, m_voidType, getNonSemanticDebugInfoExtInst());
     }
 
@@ -11350,7 +11490,10 @@ SlangResult emitSPIRVFromIR(
     }
 #endif
 
-    removeAvailableInDownstreamModuleDecorations(irModule, CodeGenTarget::SPIRV);
+    removeAvailableInDownstreamModuleDecorations(
+        irModule,
+        CodeGenTarget::SPIRV,
+        codeGenContext->getDownstreamIROptionsKey());
 
     auto shouldPreserveParams = codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
         CompilerOptionName::PreserveParameters);
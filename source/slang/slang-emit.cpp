@@ -6,6 +6,7 @@
 #include "../compiler-core/slang-artifact-util.h"
 #include "../compiler-core/slang-name.h"
 #include "../core/slang-castable.h"
+#include "../core/slang-io.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-writer.h"
@@ -24,6 +25,7 @@
 #include "slang-emit-wgsl.h"
 #include "slang-ir-any-value-inference.h"
 #include "slang-ir-any-value-marshalling.h"
+#include "slang-ir-apply-branch-profile.h"
 #include "slang-ir-autodiff.h"
 #include "slang-ir-bind-existentials.h"
 #include "slang-ir-byte-address-legalize.h"
@@ -55,9 +57,11 @@
 #include "slang-ir-fuse-satcoop.h"
 #include "slang-ir-glsl-legalize.h"
 #include "slang-ir-glsl-liveness.h"
+#include "slang-ir-groupshared-soa.h"
 #include "slang-ir-hlsl-legalize.h"
 #include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-ipsccp.h"
 #include "slang-ir-late-require-capability.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-legalize-array-return-type.h"
@@ -95,14 +99,19 @@
 #include "slang-ir-metadata.h"
 #include "slang-ir-metal-legalize.h"
 #include "slang-ir-missing-return.h"
+#include "slang-ir-narrow-half-arithmetic.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
 #include "slang-ir-pytorch-cpp-binding.h"
+#include "slang-ir-ray-payload-liveness.h"
 #include "slang-ir-redundancy-removal.h"
+#include "slang-ir-remove-unread-varyings.h"
+#include "slang-ir-report-node-records.h"
 #include "slang-ir-resolve-texture-format.h"
 #include "slang-ir-resolve-varying-input-ref.h"
 #include "slang-ir-restructure-scoping.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-schedule.h"
 #include "slang-ir-simplify-for-emit.h"
 #include "slang-ir-specialize-address-space.h"
 #include "slang-ir-specialize-arrays.h"
@@ -111,6 +120,7 @@
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-specialize-stage-switch.h"
 #include "slang-ir-specialize.h"
+#include "slang-ir-sroa.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-string-hash.h"
@@ -128,6 +138,7 @@
 #include "slang-ir-validate.h"
 #include "slang-ir-variable-scope-correction.h"
 #include "slang-ir-vk-invert-y.h"
+#include "slang-ir-waterfall-non-uniform-resource-index.h"
 #include "slang-ir-wgsl-legalize.h"
 #include "slang-ir-wrap-cbuffer-element.h"
 #include "slang-ir-wrap-structured-buffers.h"
@@ -889,6 +900,39 @@ void removeWeakUseInsts(IRModule* module)
     }
 }
 
+// Move the linked IR into a fresh memory arena (see `IRModule::compact`), and update the
+// instructions that `linkAndOptimizeIR` holds on to between passes.
+//
+static void compactLinkedIR(LinkedIR& linkedIR, List<IRFunc*>& irEntryPoints)
+{
+    auto module = linkedIR.module.Ptr();
+
+    // Everything that is updated below must still be part of the module.
+    auto layout = linkedIR.globalScopeVarLayout;
+    if (layout && layout->getModule() != module)
+        return;
+    for (auto entryPoints : {&linkedIR.entryPoints, &irEntryPoints})
+    {
+        for (auto entryPoint : *entryPoints)
+        {
+            if (entryPoint->getModule() != module)
+                return;
+        }
+    }
+
+    Dictionary<IRInst*, IRInst*> oldToNew;
+    if (!module->compact(oldToNew))
+        return;
+
+    if (layout)
+        linkedIR.globalScopeVarLayout = static_cast<IRVarLayout*>(oldToNew.getValue(layout));
+    for (auto entryPoints : {&linkedIR.entryPoints, &irEntryPoints})
+    {
+        for (auto& entryPoint : *entryPoints)
+            entryPoint = static_cast<IRFunc*>(oldToNew.getValue(entryPoint));
+    }
+}
+
 Result linkAndOptimizeIR(
     CodeGenContext* codeGenContext,
     LinkingAndOptimizationOptions const& options,
@@ -896,6 +940,13 @@ Result linkAndOptimizeIR(
 {
     SLANG_PROFILE;
 
+    // Linking is profiled as a phase nested in "optimize", so the self time of
+    // "optimize" covers just the passes run on the linked IR.
+    const bool shouldProfilePhases = codeGenContext->shouldProfilePhases();
+    const String phaseProfileName =
+        shouldProfilePhases ? codeGenContext->getPhaseProfileName() : String();
+    SLANG_PROFILE_PHASE(shouldProfilePhases, "optimize", phaseProfileName);
+
     // This lambda is here so that we can select the correct overload for our parameters, without it
     // the overload deduction fails for passes which have overloads not taking an IRModule*
 #define SLANG_PASS(passFunc, ...)                                                          \
@@ -913,6 +964,11 @@ Result linkAndOptimizeIR(
     auto targetProgram = codeGenContext->getTargetProgram();
     auto targetCompilerOptions = targetRequest->getOptionSet();
 
+    // The compile time budget covers linking as well as the passes that follow.
+    auto& compileTimeBudget = codeGenContext->getCompileTimeBudget();
+    compileTimeBudget.start(
+        targetCompilerOptions.getIntOption(CompilerOptionName::CompileTimeBudget));
+
     // Get the artifact desc for the target
     const auto artifactDesc = ArtifactDescUtil::makeDescForCompileTarget(asExternal(target));
 
@@ -924,7 +980,13 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(codeGenContext);
+    {
+        PerformanceProfilerPhaseRAIIContext linkPhase(
+            shouldProfilePhases,
+            "link",
+            phaseProfileName);
+        outLinkedIR = linkIR(codeGenContext);
+    }
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
@@ -934,6 +996,11 @@ Result linkAndOptimizeIR(
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
+    // Let later passes reuse the memory of instructions removed by earlier ones. The
+    // removed instructions are handed back after each pass, see `postPassHooks`.
+    irModule->setRecycleRemovedInsts(
+        targetCompilerOptions.getBoolOption(CompilerOptionName::RecycleRemovedIR));
+
     // Create the post-emit metadata object up-front so that IR passes
     // that need to record reportable data (e.g. `instrumentCoverage`'s
     // slot → source mapping) can write into it directly. `collectMetadata`
@@ -1058,12 +1125,30 @@ Result linkAndOptimizeIR(
             codeGenContext->shouldTraceCoverage(),
             explicitBinding,
             explicitSpace,
+            opts.getEnumOption<SlangCoverageMode>(CompilerOptionName::TraceCoverageMode),
             targetRequest,
             outLinkedIR.globalScopeVarLayout,
             *metadata);
         validateIRModuleIfEnabled(codeGenContext, irModule);
     }
 
+    // The branches are matched to the profile by their source lines, so apply it while the
+    // control flow still has the shape of the source.
+    auto branchProfilePath =
+        targetProgram->getOptionSet().getStringOption(CompilerOptionName::BranchProfile);
+    if (branchProfilePath.getLength())
+    {
+        String profileText;
+        if (SLANG_FAILED(File::readAllText(branchProfilePath, profileText)))
+        {
+            sink->diagnose(Diagnostics::CannotOpenFile{.path = branchProfilePath});
+            return SLANG_FAIL;
+        }
+        BranchProfile branchProfile;
+        branchProfile.parse(profileText.getUnownedSlice());
+        SLANG_PASS(applyBranchProfile, sink->getSourceManager(), branchProfile);
+    }
+
     SLANG_PASS(collectGlobalUniformParameters, outLinkedIR.globalScopeVarLayout, target);
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -1168,6 +1253,11 @@ Result linkAndOptimizeIR(
     deadCodeEliminationOptions.useFastAnalysis = fastIRSimplificationOptions.minimalOptimization;
     deadCodeEliminationOptions.keepGlobalParamsAlive =
         targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
+    if (compileTimeBudget.isEnabled())
+    {
+        defaultIRSimplificationOptions.budget = &compileTimeBudget;
+        fastIRSimplificationOptions.budget = &compileTimeBudget;
+    }
 
     SLANG_PASS(simplifyIR, targetProgram, defaultIRSimplificationOptions, sink);
 
@@ -1234,6 +1324,22 @@ Result linkAndOptimizeIR(
         SpecializationOptions specOptions;
         specOptions.lowerWitnessLookups = true;
         specOptions.reportDynamicDispatchSites = codeGenContext->shouldReportDynamicDispatchSites();
+
+        DispatchFrequencyHints dispatchFrequencyHints;
+        auto hintsPath = targetProgram->getOptionSet().getStringOption(
+            CompilerOptionName::DispatchFrequencyHints);
+        if (hintsPath.getLength())
+        {
+            String hintsText;
+            if (SLANG_FAILED(File::readAllText(hintsPath, hintsText)))
+            {
+                sink->diagnose(Diagnostics::CannotOpenFile{.path = hintsPath});
+                return SLANG_FAIL;
+            }
+            dispatchFrequencyHints.parse(hintsText.getUnownedSlice());
+            specOptions.dispatchFrequencyHints = &dispatchFrequencyHints;
+        }
+
         SLANG_PASS(specializeModule, targetProgram, codeGenContext->getSink(), specOptions);
     }
 
@@ -1332,7 +1438,10 @@ Result linkAndOptimizeIR(
 
     if (codeGenContext->removeAvailableInDownstreamIR)
     {
-        SLANG_PASS(removeAvailableInDownstreamModuleDecorations, target);
+        SLANG_PASS(
+            removeAvailableInDownstreamModuleDecorations,
+            target,
+            codeGenContext->getDownstreamIROptionsKey());
     }
 
     if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
@@ -1403,6 +1512,13 @@ Result linkAndOptimizeIR(
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
+    // Specialization and the lowering that follows it remove much of the linked IR, so this
+    // is the first point at which compacting the module pays off.
+    const bool compactIR =
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::CompactIR);
+    if (compactIR)
+        compactLinkedIR(outLinkedIR, irEntryPoints);
+
     // If we have a target that is GPU like we use the string hashing mechanism
     // but for that to work we need to inline such that calls (or returns) of strings
     // boil down into getStringHash(stringLiteral)
@@ -1491,6 +1607,11 @@ Result linkAndOptimizeIR(
     }
     else
     {
+        // Propagate constant arguments into the functions they are passed to, so that
+        // the branches they decide in helper functions can be folded by `simplifyIR`.
+        if (targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::InterproceduralConstantPropagation))
+            SLANG_PASS(applyInterproceduralConstantPropagation, targetProgram, sink);
         SLANG_PASS(simplifyIR, targetProgram, defaultIRSimplificationOptions, sink);
     }
 
@@ -1500,6 +1621,22 @@ Result linkAndOptimizeIR(
         reportCheckpointIntermediates(codeGenContext, sink, irModule);
     }
 
+    // Ray payloads are analyzed while the calls that pass them are still in the form the
+    // core module gives them, before target legalization lowers them.
+    if (isD3DTarget(targetRequest) || isKhronosTarget(targetRequest))
+    {
+        RayPayloadLivenessOptions payloadOptions;
+        payloadOptions.minimizePayloads =
+            targetProgram->getOptionSet().getBoolOption(CompilerOptionName::MinimizeRayPayloads);
+        payloadOptions.reportRegisters = codeGenContext->shouldReportRayPayloadRegisters();
+        if (payloadOptions.minimizePayloads || payloadOptions.reportRegisters)
+            SLANG_PASS(applyRayPayloadLiveness, targetRequest, sink, payloadOptions);
+    }
+
+    // Work graph node records are only supported on SPIR-V.
+    if (isKhronosTarget(targetRequest) && codeGenContext->shouldReportNodeRecords())
+        SLANG_PASS(reportNodeRecords, targetRequest, sink);
+
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // On non-HLSL targets, there isn't an implementation of `AppendStructuredBuffer`
@@ -1680,9 +1817,17 @@ Result linkAndOptimizeIR(
     else
         SLANG_PASS(simplifyIR, targetProgram, fastIRSimplificationOptions, sink);
 
+    // With types legalized, uniform parameters and constant buffer loads are visible,
+    // so we can find the branches and resource indices that are uniform.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::UniformityHints))
+        SLANG_PASS(applyUniformityHints);
+
     if (requiredLoweringPassSet.dynamicResourceHeap)
         SLANG_PASS(lowerDynamicResourceHeap, targetProgram, sink);
 
+    if (compactIR)
+        compactLinkedIR(outLinkedIR, irEntryPoints);
+
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // After type legalization and subsequent SSA cleanup we expect
@@ -1846,6 +1991,13 @@ Result linkAndOptimizeIR(
                         byteAddressBufferOptions.useBitCastFromUInt = true;
                     }
                 }
+
+                // Byte-address buffer accesses in HLSL only need the alignment of their
+                // element type, so adjacent scalar accesses can be merged into one.
+                //
+                if (codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+                        CompilerOptionName::CoalesceByteAddressAccesses))
+                    byteAddressBufferOptions.coalesceScalarLoadStore = true;
             }
             break;
 
@@ -1970,6 +2122,12 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::WGSLSPIRV:
     case CodeGenTarget::WGSLSPIRVAssembly:
         {
+            // Pass structs and arrays to functions by pointer, so that functions read only the
+            // fields they use and pass the pointer on instead of copying the whole value at
+            // every call. WGSL compilers don't remove those copies. This must run before
+            // `legalizeIRForWGSL`, which copies pointer arguments that point into part of a
+            // variable into temporaries.
+            SLANG_PASS(transformParamsToConstRefForWGSL, sink);
             SLANG_PASS(legalizeIRForWGSL, targetProgram, sink);
         }
         break;
@@ -1978,6 +2136,15 @@ Result linkAndOptimizeIR(
         break;
     }
 
+    // Accesses that are moved into waterfall loops no longer need `NonUniformResourceIndex`,
+    // so this runs before it is floated to the accesses. The pass only changes the targets
+    // that benefit from the loops.
+    if (targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::WaterfallNonUniformResourceIndex))
+    {
+        SLANG_PASS(waterfallNonUniformResourceIndices, targetProgram);
+    }
+
     if (!isSPIRV(targetRequest->getTarget()))
     {
         SLANG_PASS(floatNonUniformResourceIndex, NonUniformResourceIndexFloatMode::Textual);
@@ -2215,6 +2382,45 @@ Result linkAndOptimizeIR(
 
     SLANG_PASS(performForceInlining);
 
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::HeuristicInlining))
+    {
+        // Inlining is left to the downstream compiler when there is no time left for it.
+        if (compileTimeBudget.shouldDegrade("performHeuristicInlining"))
+            compileTimeBudget.noteDegraded(toSlice("performHeuristicInlining"));
+        else
+            SLANG_PASS(
+                performHeuristicInlining,
+                HeuristicInliningOptions::getForTarget(targetRequest));
+    }
+
+    // Splitting a groupshared array needs every access to it to be visible, which is only
+    // the case once the functions that take pointers into it have been inlined.
+    if (targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::SplitGroupSharedStructArrays))
+    {
+        SLANG_PASS(splitGroupSharedStructArrays);
+    }
+
+    // Arithmetic is only narrowed within a function, so run this once calls have been
+    // inlined and the conversions to and from `half` around them are in the same function.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::NarrowHalfArithmetic))
+    {
+        SLANG_PASS(narrowArithmeticToHalf);
+    }
+
+    // The outputs of a mesh shader are only split into one global parameter per field by
+    // the entry point legalization for Khronos targets.
+    if (isKhronosTarget(targetRequest) &&
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::RemoveUndefinedMeshOutputs))
+    {
+        SLANG_PASS(removeUndefinedMeshOutputWrites);
+    }
+    if (isKhronosTarget(targetRequest) &&
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::RemoveUnreadVaryingOutputs))
+    {
+        SLANG_PASS(removeUnreadVaryingOutputs);
+    }
+
     if (emitSpirvDirectly)
     {
         SLANG_PASS(performIntrinsicFunctionInlining);
@@ -2224,6 +2430,12 @@ Result linkAndOptimizeIR(
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
+        // Split aggregate locals into one variable per field or element, so that the
+        // simplification below can promote each of them to a separate SSA value.
+        if (targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::ScalarReplacementOfAggregates))
+            SLANG_PASS(applyScalarReplacementOfAggregates);
+
         IRSimplificationOptions simplificationOptions = fastIRSimplificationOptions;
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
         SLANG_PASS(simplifyIR, targetProgram, simplificationOptions, sink);
@@ -2240,6 +2452,14 @@ Result linkAndOptimizeIR(
     //
     SLANG_PASS(legalizeEmptyTypes, targetProgram, sink);
 
+    // Order the insts in each block to shorten live ranges, before phi elimination turns
+    // the block parameters into variables.
+    if (targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ScheduleForRegisterPressure))
+    {
+        SLANG_PASS(scheduleInstsForRegisterPressure, InstSchedulingOptions::getForTarget(target));
+    }
+
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
     // introducing explicit temporaries instead. Doing this at the IR level
@@ -2360,6 +2580,21 @@ Result linkAndOptimizeIR(
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
         SLANG_PASS(checkUnsupportedInst, codeGenContext->getTargetReq(), sink);
 
+    // Report the optimizations that were reduced to stay within the compile time budget.
+    if (compileTimeBudget.wasDegraded())
+    {
+        StringBuilder optimizations;
+        for (auto& optimization : compileTimeBudget.getDegradedOptimizations())
+        {
+            if (optimizations.getLength())
+                optimizations << ", ";
+            optimizations << optimization;
+        }
+        sink->diagnose(Diagnostics::CompileTimeBudgetDegraded{
+            .budget = (int64_t)compileTimeBudget.getBudgetMilliseconds(),
+            .optimizations = optimizations.produceString()});
+    }
+
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 
 #undef SLANG_PASS
@@ -2581,12 +2816,18 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
     // Get the content built so far from the front matter/prelude/preModule
     // By getting in this way, the content is no longer referenced by the sourceWriter.
-    String finalResult = sourceWriter.getContentAndClear();
-
-    // Append the modules output code
+    String frontMatter = sourceWriter.getContentAndClear();
+    String postModule = sourceWriter.getContentAndClear();
+
+    // Stitch the pieces together in a buffer allocated once at its final size, since the
+    // module's code can be large. The blob takes the buffer as is, and downstream compilers
+    // read it in place.
+    StringBuilder finalResult;
+    finalResult.ensureCapacity(
+        frontMatter.getLength() + code.getLength() + postModule.getLength());
+    finalResult.append(frontMatter);
     finalResult.append(code);
-
-    finalResult.append(sourceWriter.getContentAndClear());
+    finalResult.append(postModule);
 
     // Write out the result
 
@@ -2908,6 +3149,34 @@ static bool shouldRunSPIRVValidation(CodeGenContext* codeGenContext)
     return false;
 }
 
+// Get the key under which the result of validating and optimizing `sourceBlob` is cached
+// on the global session. `spirv` is the SPIR-V that validation runs on, which differs from
+// `sourceBlob` when other SPIR-V modules were linked in. The optimizer's version is part of
+// the key, since a different spirv-opt can produce different output for the same input.
+static String getOptimizedSPIRVKey(
+    CodeGenContext* codeGenContext,
+    IDownstreamCompiler* compiler,
+    const List<uint8_t>& spirv,
+    ISlangBlob* sourceBlob,
+    bool shouldValidate)
+{
+    DigestBuilder<SHA1> digestBuilder;
+    digestBuilder.append(String(getBuildTagString()));
+    const auto& compilerDesc = compiler->getDesc();
+    digestBuilder.append(compilerDesc.type);
+    digestBuilder.append(compilerDesc.version.m_major);
+    digestBuilder.append(compilerDesc.version.m_minor);
+    digestBuilder.append(compilerDesc.version.m_patch);
+    ComPtr<ISlangBlob> versionString;
+    if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())))
+        digestBuilder.append(versionString);
+    digestBuilder.append(codeGenContext->getTargetProgram()->getOptionSet().getOptimizationLevel());
+    digestBuilder.append(shouldValidate);
+    digestBuilder.append(spirv.getBuffer(), spirv.getCount());
+    digestBuilder.append(sourceBlob);
+    return digestBuilder.finalize().toString();
+}
+
 // Helper function to create an artifact from IR used internally by
 // emitSPIRVForEntryPointsDirectly.
 static SlangResult createArtifactFromIR(
@@ -2972,6 +3241,7 @@ static SlangResult createArtifactFromIR(
             // contains an embedded downstream ir instruction, add it to the list
             // of spirv files.
             auto program = codeGenContext->getProgram();
+            const auto optionsKey = codeGenContext->getDownstreamIROptionsKey();
 
             program->enumerateIRModules(
                 [&](IRModule* irModule)
@@ -2980,7 +3250,8 @@ static SlangResult createArtifactFromIR(
                     {
                         if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
                         {
-                            if (inst->getTarget() == CodeGenTarget::SPIRV)
+                            if (inst->getTarget() == CodeGenTarget::SPIRV &&
+                                inst->matchesOptionsKey(optionsKey))
                             {
                                 auto slice = inst->getBlob()->getStringSlice();
                                 spirvFiles.add((uint32_t*)slice.begin());
@@ -3012,13 +3283,41 @@ static SlangResult createArtifactFromIR(
             }
         }
 
-        if (shouldRunSPIRVValidation(codeGenContext))
+        // Permutations of a shader often generate identical SPIR-V, so the result of
+        // validating and optimizing it is cached on the global session by its digest.
+        const bool shouldValidate = shouldRunSPIRVValidation(codeGenContext);
+        ComPtr<ISlangBlob> sourceBlob;
+        SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef()));
+        const String optimizedSPIRVKey =
+            getOptimizedSPIRVKey(codeGenContext, compiler, spirv, sourceBlob, shouldValidate);
+        if (auto optimizedSPIRV = codeGenContext->getSession()->findOptimizedSPIRV(
+                optimizedSPIRVKey))
+        {
+            ComPtr<IArtifact> optimizedArtifact =
+                ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+            optimizedArtifact->addRepresentationUnknown(optimizedSPIRV);
+            if (targetCompilerOptions.shouldEmitSeparateDebugInfo())
+            {
+                auto strippedArtifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+                SLANG_RETURN_ON_FAIL(
+                    stripDbgSpirvFromArtifact(optimizedArtifact, strippedArtifact));
+                artifact = _Move(strippedArtifact);
+                dbgArtifact = _Move(optimizedArtifact);
+            }
+            else
+                artifact = _Move(optimizedArtifact);
+            return SLANG_OK;
+        }
+
+        bool isValid = true;
+        if (shouldValidate)
         {
             if (SLANG_FAILED(
                     compiler->validate((uint32_t*)spirv.getBuffer(), int(spirv.getCount() / 4))))
             {
                 compiler->disassemble((uint32_t*)spirv.getBuffer(), int(spirv.getCount() / 4));
                 codeGenContext->getSink()->diagnose(Diagnostics::SpirvValidationFailed{});
+                isValid = false;
             }
         }
 
@@ -3048,8 +3347,28 @@ static SlangResult createArtifactFromIR(
             break;
         }
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
-        {
+        SlangResult optimizeResult;
+        {
+            const bool shouldProfilePhases = codeGenContext->shouldProfilePhases();
+            SLANG_PROFILE_PHASE(
+                shouldProfilePhases,
+                "downstream",
+                shouldProfilePhases ? codeGenContext->getPhaseProfileName() : String());
+            optimizeResult = compiler->compile(downstreamOptions, optimizedArtifact.writeRef());
+        }
+        if (SLANG_SUCCEEDED(optimizeResult))
+        {
+            // Only a clean result is cached, since diagnostics are not replayed from the cache.
+            auto diagnostics =
+                findAssociatedRepresentation<IArtifactDiagnostics>(optimizedArtifact);
+            ComPtr<ISlangBlob> optimizedSPIRV;
+            if (isValid && (!diagnostics || diagnostics->getCount() == 0) &&
+                SLANG_SUCCEEDED(
+                    optimizedArtifact->loadBlob(ArtifactKeep::Yes, optimizedSPIRV.writeRef())))
+            {
+                codeGenContext->getSession()->addOptimizedSPIRV(optimizedSPIRVKey, optimizedSPIRV);
+            }
+
             // Check if we need to output a separate SPIRV file containing debug info. If so
             // then strip all debug instructions from the artifact. The dbgArtifact will still
             // contain all instructions.
@@ -4,11 +4,13 @@
 #include "compiler-core/slang-pretty-writer.h"
 #include "core/slang-memory-file-system.h"
 #include "core/slang-performance-profiler.h"
+#include "core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-emit-dependency-file.h"
 #include "slang-module-library.h"
 #include "slang-options.h"
+#include "slang-reflection-binary-writer.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-rich-diagnostics.h"
@@ -143,6 +145,9 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         target->getOptionSet().inheritFrom(getOptionSet());
     m_frontEndReq->optionSet = getOptionSet();
 
+    // The shader cache directory may only have been set by the options just parsed.
+    getLinkage()->attachFileDigestCache();
+
     // `-pass-through` bypasses the IR pipeline that emits coverage
     // instrumentation, so the two flags are mutually exclusive.
     // The check lives here (not in `OptionsParser::_parse`) so that
@@ -189,12 +194,38 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         return SLANG_OK;
     }
 
+    // A reflection-only compile has no IR to generate code from, so asking for
+    // any output is an error.
+    //
+    const bool reflectionOnly = getLinkage()->isReflectionOnly();
+    if (reflectionOnly)
+    {
+        for (const auto& [targetReq, targetInfo] : m_targetInfos)
+        {
+            if (targetInfo->wholeTargetOutputPath.getLength() ||
+                targetInfo->entryPointOutputPaths.getCount())
+            {
+                getSink()->diagnose(Diagnostics::CodeRequestedInReflectionOnlyMode{
+                    .target = TypeTextUtil::getCompileTargetName(
+                        SlangCompileTarget(targetReq->getTarget()))});
+            }
+        }
+        if (m_containerOutputPath.getLength())
+        {
+            getSink()->diagnose(
+                Diagnostics::CodeRequestedInReflectionOnlyMode{.target = "slang-module"});
+        }
+        if (getSink()->getErrorCount() != 0)
+            return SLANG_FAIL;
+    }
+
     // If requested, attempt to compile the translation unit all the way down to the target
     // language(s) and stash the result blobs in IR.
     for (auto target : getLinkage()->targets)
     {
         SlangCompileTarget targetEnum = SlangCompileTarget(target->getTarget());
-        if (target->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
+        if (!reflectionOnly &&
+            target->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
         {
             auto frontEndReq = getFrontEndReq();
 
@@ -276,6 +307,12 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         m_specializedEntryPoints = getFrontEndReq()->getUnspecializedEntryPoints();
     }
 
+    // The layouts are all that reflection needs.
+    if (reflectionOnly)
+    {
+        return SLANG_OK;
+    }
+
     // Generate output code, in whatever format was requested
     generateOutput();
     if (getSink()->getErrorCount() != 0)
@@ -751,16 +788,181 @@ void EndToEndCompileRequest::generateOutput(ComponentType* program)
     // has specified, and generate code for each of them.
     //
     auto linkage = getLinkage();
+    List<TargetProgram*> targetPrograms;
     for (auto targetReq : linkage->targets)
     {
         if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
             continue;
 
-        auto targetProgram = program->getTargetProgram(targetReq);
+        targetPrograms.add(program->getTargetProgram(targetReq));
+    }
+
+    const Count threadCount = getOptionSet().getIntOption(CompilerOptionName::CodeGenThreadCount);
+    if (threadCount > 1)
+    {
+        _generateOutputInParallel(targetPrograms, threadCount);
+        return;
+    }
+
+    for (auto targetProgram : targetPrograms)
+    {
         generateOutput(targetProgram);
     }
 }
 
+namespace
+{
+/// A single independent unit of back-end work: code generation for
+/// one entry point (or for the whole program) on one target.
+struct CodeGenJob
+{
+    TargetProgram* targetProgram = nullptr;
+
+    /// The entry point to generate code for, or -1 for the whole program.
+    Index entryPointIndex = -1;
+};
+} // namespace
+
+void EndToEndCompileRequest::_generateOutputInParallel(
+    List<TargetProgram*> const& targetPrograms,
+    Count threadCount)
+{
+    // Every `CodeGenContext` links a fresh `IRModule` of its own, and only
+    // reads from the already-checked AST and the IR of the linked modules,
+    // so the jobs below are independent of one another.
+    //
+    List<CodeGenJob> jobs;
+    for (auto targetProgram : targetPrograms)
+    {
+        if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
+        {
+            jobs.add(CodeGenJob{targetProgram, -1});
+        }
+        else
+        {
+            const auto entryPointCount = targetProgram->getProgram()->getEntryPointCount();
+            for (Index ii = 0; ii < entryPointCount; ++ii)
+            {
+                jobs.add(CodeGenJob{targetProgram, ii});
+            }
+        }
+    }
+
+    // A `DiagnosticSink` isn't safe to use from multiple threads, so each
+    // job reports into a buffered sink of its own, set up like the sink
+    // of this request.
+    //
+    auto sink = getSink();
+    List<DiagnosticSink> jobSinks;
+    jobSinks.setCount(jobs.getCount());
+    for (auto& jobSink : jobSinks)
+    {
+        jobSink.init(sink->getSourceManager(), sink->getSourceLocationLexer());
+        jobSink.setFlags(sink->getFlags());
+        jobSink.setSourceLineMaxLength(sink->getSourceLineMaxLength());
+        jobSink.setDiagnosticColorMode(sink->getDiagnosticColorMode());
+        jobSink.setEnableUnicode(sink->getEnableUnicode());
+        jobSink.setSourceWarningStateTracker(sink->getSourceWarningStateTracker());
+        applySettingsToDiagnosticSink(&jobSink, &jobSink, getOptionSet());
+    }
+
+    // The profiler is per-thread, so the pass statistics, phase timings and
+    // trace events each job records are moved out of whichever thread ran it
+    // and merged back in job order below. Trace events keep the id of the
+    // thread that ran them.
+    //
+    List<PassStatistics> jobPassStatistics;
+    jobPassStatistics.setCount(jobs.getCount());
+    List<List<PhaseInvocationInfo>> jobPhaseInvocations;
+    jobPhaseInvocations.setCount(jobs.getCount());
+    List<List<TraceEventInfo>> jobTraceEvents;
+    jobTraceEvents.setCount(jobs.getCount());
+    const bool tracing = PerformanceProfiler::getProfiler()->isTracing();
+
+    auto runJob = [&](Index jobIndex)
+    {
+        auto& job = jobs[jobIndex];
+        auto jobSink = &jobSinks[jobIndex];
+
+        auto& passStatistics = PerformanceProfiler::getProfiler()->getPassStatistics();
+        PassStatistics earlierPassStatistics = passStatistics;
+        passStatistics.clear();
+        auto& phaseInvocations = PerformanceProfiler::getProfiler()->getPhaseInvocations();
+        const Index phaseInvocationStart = phaseInvocations.getCount();
+        auto& traceEvents = PerformanceProfiler::getProfiler()->getTraceEvents();
+        const Index traceEventStart = traceEvents.getCount();
+        const bool wasTracing = PerformanceProfiler::getProfiler()->isTracing();
+        PerformanceProfiler::getProfiler()->setTracing(tracing);
+
+        // Exceptions must not escape a worker thread, so failures are turned
+        // into diagnostics in the same way `compile()` does for a serial compile.
+        try
+        {
+            if (job.entryPointIndex < 0)
+                job.targetProgram->_createWholeProgramResult(jobSink, this);
+            else
+                job.targetProgram->_createEntryPointResult(job.entryPointIndex, jobSink, this);
+        }
+        catch (const AbortCompilationException& e)
+        {
+            if (jobSink->getErrorCount() == 0)
+            {
+                jobSink->diagnose(Diagnostics::CompilationAbortedDueToException{
+                    .exceptionType = typeid(e).name(),
+                    .exceptionMessage = e.Message});
+            }
+        }
+        catch (const Exception& e)
+        {
+            jobSink->diagnose(Diagnostics::CompilationAbortedDueToException{
+                .exceptionType = typeid(e).name(),
+                .exceptionMessage = e.Message});
+        }
+        catch (...)
+        {
+            jobSink->diagnose(Diagnostics::CompilationAborted{});
+        }
+
+        jobPassStatistics[jobIndex] = passStatistics;
+        passStatistics = earlierPassStatistics;
+
+        for (Index ii = phaseInvocationStart; ii < phaseInvocations.getCount(); ++ii)
+            jobPhaseInvocations[jobIndex].add(phaseInvocations[ii]);
+        phaseInvocations.setCount(phaseInvocationStart);
+
+        PerformanceProfiler::getProfiler()->setTracing(wasTracing);
+        for (Index ii = traceEventStart; ii < traceEvents.getCount(); ++ii)
+            jobTraceEvents[jobIndex].add(traceEvents[ii]);
+        traceEvents.setCount(traceEventStart);
+    };
+
+    runJobs(getSession()->getCurrentJobScheduler(), jobs.getCount(), threadCount, runJob);
+
+    // Forward the buffered diagnostics in job order, so that output is
+    // the same as for a serial compile regardless of scheduling.
+    //
+    for (auto& jobSink : jobSinks)
+    {
+        if (jobSink.outputBuffer.getLength() == 0)
+            continue;
+
+        const Severity severity = jobSink.getErrorCount() ? Severity::Error : Severity::Warning;
+        sink->diagnoseRaw(severity, jobSink.outputBuffer.getUnownedSlice());
+    }
+
+    auto& passStatistics = PerformanceProfiler::getProfiler()->getPassStatistics();
+    for (auto& statistics : jobPassStatistics)
+        passStatistics.addRange(statistics);
+
+    auto& phaseInvocations = PerformanceProfiler::getProfiler()->getPhaseInvocations();
+    for (auto& invocations : jobPhaseInvocations)
+        phaseInvocations.addRange(invocations);
+
+    auto& traceEvents = PerformanceProfiler::getProfiler()->getTraceEvents();
+    for (auto& events : jobTraceEvents)
+        traceEvents.addRange(events);
+}
+
 void EndToEndCompileRequest::generateOutput()
 {
     SLANG_PROFILE;
@@ -1491,6 +1693,97 @@ void EndToEndCompileRequest::setAllowGLSLInput(bool value)
     getOptionSet().set(CompilerOptionName::AllowGLSL, value);
 }
 
+/// Write the statistics of each pass as a JSON object of the form
+/// `{"passes": [{"name": ..., "invocations": ..., "timeMicroseconds": ..., ...}, ...]}`.
+static void _emitPassStatisticsJSON(PrettyWriter& writer, List<PassStatisticsInfo> const& passes)
+{
+    writer << "{\n";
+    writer.indent();
+    writer << "\"passes\": [\n";
+    writer.indent();
+
+    for (Index ii = 0; ii < passes.getCount(); ++ii)
+    {
+        auto& pass = passes[ii];
+        if (ii != 0)
+            writer << ",\n";
+
+        const auto microseconds =
+            std::chrono::duration_cast<std::chrono::microseconds>(pass.duration).count();
+
+        writer << "{\"name\": ";
+        writer.writeEscapedString(UnownedStringSlice(pass.passName));
+        writer << ", \"invocations\": " << uint64_t(pass.invocationCount);
+        writer << ", \"timeMicroseconds\": " << uint64_t(microseconds);
+        writer << ", \"instsCreated\": " << uint64_t(pass.instsCreated);
+        writer << ", \"instsDestroyed\": " << uint64_t(pass.instsDestroyed);
+        writer << ", \"arenaBytesGrown\": " << uint64_t(pass.arenaBytesGrown) << "}";
+    }
+
+    writer.dedent();
+    writer << "\n]";
+    writer.dedent();
+    writer << "\n}\n";
+}
+
+/// Write trace events as a JSON object in the Chrome trace event format. Each event is a
+/// complete ("X") event, with times in microseconds since `startTime`.
+static void _emitTraceEventsJSON(
+    PrettyWriter& writer,
+    ArrayView<TraceEventInfo> events,
+    std::chrono::time_point<std::chrono::high_resolution_clock> startTime)
+{
+    auto toMicroseconds = [](std::chrono::nanoseconds duration)
+    { return String(double(duration.count()) / 1000.0, "%.3f"); };
+
+    writer << "{\n";
+    writer.indent();
+    writer << "\"displayTimeUnit\": \"ms\",\n";
+    writer << "\"traceEvents\": [\n";
+    writer.indent();
+
+    for (Index ii = 0; ii < events.getCount(); ++ii)
+    {
+        auto& event = events[ii];
+        if (ii != 0)
+            writer << ",\n";
+
+        writer << "{\"name\": ";
+        writer.writeEscapedString(UnownedStringSlice(event.name));
+        writer << ", \"cat\": ";
+        writer.writeEscapedString(UnownedStringSlice(event.category));
+        writer << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << uint64_t(event.threadId);
+        writer << ", \"ts\": " << toMicroseconds(event.startTime - startTime).getUnownedSlice();
+        writer << ", \"dur\": " << toMicroseconds(event.duration).getUnownedSlice();
+        if (event.detail.getLength())
+        {
+            writer << ", \"args\": {\"detail\": ";
+            writer.writeEscapedString(event.detail.getUnownedSlice());
+            writer << "}";
+        }
+        writer << "}";
+    }
+
+    writer.dedent();
+    writer << "\n]";
+    writer.dedent();
+    writer << "\n}\n";
+}
+
+/// Write a report to `path`, or to stdout if `path` is "-".
+static void _writeReport(DiagnosticSink* sink, String const& path, PrettyWriter& writer)
+{
+    if (path == "-")
+    {
+        auto builder = writer.getBuilder();
+        StdWriters::getOut().write(builder.getBuffer(), builder.getLength());
+    }
+    else if (SLANG_FAILED(File::writeAllText(path, writer.getBuilder())))
+    {
+        sink->diagnose(Diagnostics::UnableToWriteFile{.path = path});
+    }
+}
+
 SlangResult EndToEndCompileRequest::compile()
 {
     SlangResult res = SLANG_FAIL;
@@ -1502,6 +1795,19 @@ SlangResult EndToEndCompileRequest::compile()
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
         PerformanceProfiler::getProfiler()->clear();
     }
+
+    // Only the passes run by this compile go into its pass statistics report, so the
+    // statistics of earlier compiles are set aside until it has been written.
+    PassStatistics earlierPassStatistics = PerformanceProfiler::getProfiler()->getPassStatistics();
+    PerformanceProfiler::getProfiler()->getPassStatistics().clear();
+
+    // Likewise only the spans recorded by this compile go into its trace.
+    auto traceEventsPath = getOptionSet().getStringOption(CompilerOptionName::TraceEvents);
+    const bool wasTracing = PerformanceProfiler::getProfiler()->isTracing();
+    const Index traceEventStart = PerformanceProfiler::getProfiler()->getTraceEvents().getCount();
+    const auto traceStartTime = std::chrono::high_resolution_clock::now();
+    if (traceEventsPath.getLength() != 0)
+        PerformanceProfiler::getProfiler()->setTracing(true);
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -1632,6 +1938,60 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto reflectionBinaryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBinary);
+    if (reflectionBinaryPath.getLength() != 0)
+    {
+        auto reflection = this->getReflection();
+        if (!reflection)
+        {
+            getSink()->diagnose(Diagnostics::CannotEmitReflectionWithoutTarget{});
+            return SLANG_FAIL;
+        }
+        ComPtr<ISlangBlob> blob;
+        auto programReflection = (slang::ShaderReflection*)reflection;
+        if (SLANG_FAILED(writeReflectionBinary(programReflection, blob.writeRef())) ||
+            SLANG_FAILED(File::writeAllBytes(
+                reflectionBinaryPath,
+                blob->getBufferPointer(),
+                blob->getBufferSize())))
+        {
+            getSink()->diagnose(
+                Diagnostics::UnableToWriteFile{.path = String(reflectionBinaryPath)});
+        }
+    }
+
+    auto& passStatistics = PerformanceProfiler::getProfiler()->getPassStatistics();
+    auto passStatisticsPath =
+        getOptionSet().getStringOption(CompilerOptionName::ReportPassStatistics);
+    if (passStatisticsPath.getLength() != 0)
+    {
+        auto writer = PrettyWriter();
+        _emitPassStatisticsJSON(writer, passStatistics.getPasses());
+        _writeReport(getSink(), passStatisticsPath, writer);
+    }
+    earlierPassStatistics.addRange(passStatistics);
+    passStatistics = earlierPassStatistics;
+
+    if (traceEventsPath.getLength() != 0)
+    {
+        PerformanceProfiler::getProfiler()->setTracing(wasTracing);
+
+        auto& traceEvents = PerformanceProfiler::getProfiler()->getTraceEvents();
+        const Index start = Math::Min(traceEventStart, traceEvents.getCount());
+        auto writer = PrettyWriter();
+        _emitTraceEventsJSON(
+            writer,
+            traceEvents.getArrayView(start, traceEvents.getCount() - start),
+            traceStartTime);
+        _writeReport(getSink(), traceEventsPath, writer);
+
+        // The trace has been written, so there is no reason to hold on to its events
+        // unless an enclosing trace is still recording.
+        if (!wasTracing)
+            traceEvents.setCount(start);
+    }
+
     return res;
 }
 
@@ -403,6 +403,10 @@ private:
     void generateOutput(ComponentType* program);
     void generateOutput(TargetProgram* targetProgram);
 
+    /// Generate code for every entry point of every target in `targetPrograms`,
+    /// distributing the work over up to `threadCount` threads.
+    void _generateOutputInParallel(List<TargetProgram*> const& targetPrograms, Count threadCount);
+
     void init();
 
     Session* m_session = nullptr;
@@ -167,6 +167,57 @@ public:
         return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        slang::SpecializationArg const* specializationArgs,
+        SlangInt specializationArgCount,
+        SlangInt permutationCount,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::compileEntryPointPermutations(
+            entryPointIndex,
+            targetIndex,
+            specializationArgs,
+            specializationArgCount,
+            permutationCount,
+            outCodes,
+            outDiagnostics);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodeAsync(
+            entryPointIndex,
+            targetIndex,
+            callback,
+            userData,
+            outFuture);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE
+    {
+        return Super::getTargetCodeAsync(targetIndex, callback, userData, outFuture);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetIRHash(
+        SlangInt targetIndex,
+        slang::IBlob** outHash,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getTargetIRHash(targetIndex, outHash, outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointHostCallable(
         int entryPointIndex,
         int targetIndex,
@@ -133,6 +133,12 @@ void Session::init()
 
 Session::~Session()
 {
+    // A preload job uses the session, so it must finish before anything is destroyed.
+    {
+        std::unique_lock<std::mutex> lock(m_pendingPreloadMutex);
+        m_pendingPreloadCondition.wait(lock, [this] { return m_pendingPreloadCount == 0; });
+    }
+
     // Destroy the array of core (automatically-included) modules.
     //
     // TODO(tfoley): This code didn't have a comment clearly explaining
@@ -326,6 +332,132 @@ TypeCheckingCache* Session::getTypeCheckingCache()
     return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
 }
 
+ComPtr<ISlangBlob> Session::findSharedCheckedModule(String const& key, String& outDiagnostics)
+{
+    return m_sharedCheckedModules.find(key, &outDiagnostics);
+}
+
+void Session::addSharedCheckedModule(
+    String const& key,
+    ISlangBlob* serializedModule,
+    String const& diagnostics)
+{
+    m_sharedCheckedModules.add(key, serializedModule, diagnostics);
+}
+
+ComPtr<ISlangBlob> Session::findOptimizedSPIRV(String const& key)
+{
+    return m_optimizedSPIRV.find(key);
+}
+
+void Session::addOptimizedSPIRV(String const& key, ISlangBlob* optimizedSPIRV)
+{
+    m_optimizedSPIRV.add(key, optimizedSPIRV);
+}
+
+ComPtr<ISlangBlob> SessionBlobCache::find(String const& key, String* outDiagnostics)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto entry = m_entries.tryGetValue(key);
+    if (!entry)
+        return nullptr;
+    entry->lastUse = ++m_useCount;
+    if (outDiagnostics)
+        *outDiagnostics = entry->diagnostics;
+    return entry->blob;
+}
+
+void SessionBlobCache::add(String const& key, ISlangBlob* blob, String const& diagnostics)
+{
+    Entry entry;
+    entry.blob = blob;
+    entry.diagnostics = diagnostics;
+    const size_t size = entry.getSize();
+    // A blob that would take up most of the cache isn't worth evicting everything else for.
+    if (size > m_maxBytes / 4)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto existing = m_entries.tryGetValue(key))
+    {
+        m_totalBytes -= existing->getSize();
+        m_entries.remove(key);
+    }
+    while (m_entries.getCount() && m_totalBytes + size > m_maxBytes)
+        _evictLeastRecentlyUsed();
+
+    entry.lastUse = ++m_useCount;
+    m_entries.add(key, entry);
+    m_totalBytes += size;
+}
+
+void SessionBlobCache::_evictLeastRecentlyUsed()
+{
+    // Evictions only happen once the cache is full, so a linear search is cheap compared to
+    // the work that produced the blob being added.
+    const String* oldestKey = nullptr;
+    UInt64 oldestUse = 0;
+    for (const auto& [key, entry] : m_entries)
+    {
+        if (!oldestKey || entry.lastUse < oldestUse)
+        {
+            oldestKey = &key;
+            oldestUse = entry.lastUse;
+        }
+    }
+    String key = *oldestKey;
+    m_totalBytes -= m_entries[key].getSize();
+    m_entries.remove(key);
+}
+
+size_t SessionBlobCache::getTotalBytes()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_totalBytes;
+}
+
+ComPtr<ISlangJobScheduler> Session::getCurrentJobScheduler()
+{
+    std::lock_guard<std::mutex> lock(m_jobSchedulerMutex);
+    if (!m_jobScheduler)
+        m_jobScheduler = new JobScheduler(m_jobThreadCount);
+    return m_jobScheduler;
+}
+
+SLANG_NO_THROW void SLANG_MCALL Session::setJobScheduler(ISlangJobScheduler* scheduler)
+{
+    std::lock_guard<std::mutex> lock(m_jobSchedulerMutex);
+    m_jobScheduler = scheduler;
+    m_hasApplicationJobScheduler = scheduler != nullptr;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::getMemoryUsage(SlangMemoryUsage* outUsage)
+{
+    if (!outUsage)
+        return SLANG_E_INVALID_ARG;
+
+    auto getArenaBytes = [](MemoryArenaCategory category)
+    { return uint64_t(MemoryArena::getTotalMemoryAllocated(category)); };
+
+    *outUsage = {};
+    outUsage->astBytes = getArenaBytes(MemoryArenaCategory::AST);
+    outUsage->irBytes = getArenaBytes(MemoryArenaCategory::IR);
+    outUsage->stringPoolBytes = getArenaBytes(MemoryArenaCategory::StringPool);
+    outUsage->otherBytes = getArenaBytes(MemoryArenaCategory::Other);
+
+    outUsage->cachedBlobBytes += m_sharedCheckedModules.getTotalBytes();
+    outUsage->cachedBlobBytes += m_optimizedSPIRV.getTotalBytes();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::getJobScheduler(ISlangJobScheduler** outScheduler)
+{
+    if (!outScheduler)
+        return SLANG_E_INVALID_ARG;
+    *outScheduler = getCurrentJobScheduler().detach();
+    return SLANG_OK;
+}
+
 Session::BuiltinModuleInfo Session::getBuiltinModuleInfo(slang::BuiltinModuleName name)
 {
     Session::BuiltinModuleInfo result;
@@ -450,7 +582,34 @@ SlangResult Session::loadBuiltinModule(
 {
     SLANG_PROFILE;
 
+    // Make a file system to read it from
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(
+        moduleData,
+        sizeInBytes,
+        fileSystem,
+        getCurrentJobScheduler()));
+
+    return _loadBuiltinModule(moduleName, fileSystem);
+}
 
+SlangResult Session::loadBuiltinModuleFromBlob(
+    slang::BuiltinModuleName moduleName,
+    ISlangBlob* moduleBlob)
+{
+    SLANG_PROFILE;
+
+    // The file system references the blob's contents, rather than taking a copy
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleBlob, fileSystem, getCurrentJobScheduler()));
+
+    return _loadBuiltinModule(moduleName, fileSystem);
+}
+
+SlangResult Session::_loadBuiltinModule(
+    slang::BuiltinModuleName moduleName,
+    ISlangFileSystemExt* fileSystem)
+{
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
     BuiltinModuleInfo builtinModuleInfo = getBuiltinModuleInfo(moduleName);
@@ -461,10 +620,6 @@ SlangResult Session::loadBuiltinModule(
         return SLANG_FAIL;
     }
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleData, sizeInBytes, fileSystem));
-
     // Let's try loading serialized modules and adding them
     Module* module = nullptr;
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(
@@ -531,7 +686,8 @@ SlangResult Session::saveBuiltinModule(
     // to represent that archive.
     //
     ComPtr<ISlangMutableFileSystem> fileSystem;
-    SLANG_RETURN_ON_FAIL(createArchiveFileSystem(archiveType, fileSystem));
+    SLANG_RETURN_ON_FAIL(
+        createArchiveFileSystem(archiveType, fileSystem, getCurrentJobScheduler()));
     //
     // The created file system must support the `IArchiveFileSystem`
     // interface (since we created it with `createArchiveFileSystem`).
@@ -674,10 +830,18 @@ SlangResult Session::_readBuiltinModule(
     module->setModuleDecl(moduleDecl);
 
     // After the AST module has been read in, we next look
-    // to deserialize the IR module.
+    // to deserialize the IR module. Only the bodies of functions
+    // that linking actually reaches are read in, and that
+    // happens on demand.
     //
     RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, this, sourceLocReader, irModule));
+    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(
+        irChunk,
+        this,
+        sourceLocReader,
+        irModule,
+        IRBodyLoading::OnDemand,
+        fileContents));
 
     irModule->setName(module->getNameObj());
     module->setIRModule(irModule);
@@ -821,6 +985,7 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     }
 
     linkage->m_optionSet.load(desc.compilerOptionEntryCount, desc.compilerOptionEntries);
+    linkage->attachFileDigestCache();
 
     if (!linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutColumn) &&
         !linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutRow))
@@ -1244,6 +1409,96 @@ ISlangSharedLibrary* Session::getOrLoadSlangLLVM()
     return m_slangLLVM.get();
 }
 
+namespace
+{ // anonymous
+
+struct PreloadDownstreamCompilerJob
+{
+    // Not a strong reference: releasing the last one would destroy the session, and with it
+    // the built-in scheduler, on one of the scheduler's own threads. The session waits for
+    // pending preloads when it is destroyed instead.
+    Session* session;
+    PassThroughMode type;
+
+    static void run(void* userData, SlangInt)
+    {
+        auto job = (PreloadDownstreamCompilerJob*)userData;
+
+        // Exceptions must not escape a worker thread. A failure to load is reported when the
+        // compiler is needed, so it is ignored here.
+        try
+        {
+            job->session->getOrLoadDownstreamCompiler(job->type, nullptr);
+        }
+        catch (...)
+        {
+        }
+        job->session->_endPreload();
+        delete job;
+    }
+};
+
+} // namespace
+
+void Session::preloadDownstreamCompilerForTarget(CodeGenTarget target)
+{
+    PassThroughMode type = PassThroughMode::None;
+    switch (target)
+    {
+    case CodeGenTarget::SPIRV:
+    case CodeGenTarget::SPIRVAssembly:
+        // SPIR-V emitted by Slang is linked, validated and optimized with slang-glslang.
+        type = PassThroughMode::SpirvOpt;
+        break;
+    case CodeGenTarget::HostHostCallable:
+    case CodeGenTarget::ShaderHostCallable:
+        // Host callable code is compiled with slang-llvm when it is available.
+        type = PassThroughMode::LLVM;
+        break;
+    default:
+        return;
+    }
+
+    if (m_sharedLibraryLoader != DefaultSharedLibraryLoader::getSingleton())
+        return;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+        if ((m_downstreamCompilerInitialized & (1 << int(type))) ||
+            !m_downstreamCompilerLocators[int(type)])
+            return;
+    }
+
+    // Loading on another thread only helps when the application asked for work to run in
+    // parallel. Otherwise a single threaded compile would start worker threads just for this.
+    bool hasApplicationJobScheduler;
+    {
+        std::lock_guard<std::mutex> lock(m_jobSchedulerMutex);
+        hasApplicationJobScheduler = m_hasApplicationJobScheduler;
+    }
+    if (!hasApplicationJobScheduler && m_jobThreadCount <= 1)
+        return;
+    auto scheduler = getCurrentJobScheduler();
+    if (scheduler->getThreadCount() <= 1)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingPreloadMutex);
+        m_pendingPreloadCount++;
+    }
+    auto job = new PreloadDownstreamCompilerJob();
+    job->session = this;
+    job->type = type;
+    scheduler->submitJob(&PreloadDownstreamCompilerJob::run, job);
+}
+
+void Session::_endPreload()
+{
+    std::lock_guard<std::mutex> lock(m_pendingPreloadMutex);
+    m_pendingPreloadCount--;
+    m_pendingPreloadCondition.notify_all();
+}
+
 SlangResult checkExternalCompilerSupport(Session* session, PassThroughMode passThrough)
 {
     // Check if the type is supported on this compile
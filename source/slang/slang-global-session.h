@@ -17,9 +17,11 @@
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-spirv-core-grammar.h"
 #include "../core/slang-command-options.h"
+#include "../core/slang-job-scheduler.h"
 #include "slang-pass-through.h"
 #include "slang-target.h"
 
+#include <condition_variable>
 #include <mutex>
 
 namespace Slang
@@ -106,6 +108,42 @@ protected:
 ///   `slang::IGlobalSession` interface, but should be *not* be
 ///   used by user applications.
 ///
+/// Blobs keyed by a digest, kept by a global session for the compiles of all its sessions,
+/// along with the diagnostics reported while producing them. Holds at most `maxBytes`, dropping
+/// the least recently used blobs to make room for new ones. Safe to use from multiple threads.
+class SessionBlobCache
+{
+public:
+    explicit SessionBlobCache(size_t maxBytes)
+        : m_maxBytes(maxBytes)
+    {
+    }
+
+    /// Find the blob added with `key`, or return null.
+    ComPtr<ISlangBlob> find(String const& key, String* outDiagnostics = nullptr);
+    void add(String const& key, ISlangBlob* blob, String const& diagnostics = String());
+
+    size_t getTotalBytes();
+
+private:
+    struct Entry
+    {
+        ComPtr<ISlangBlob> blob;
+        String diagnostics;
+        UInt64 lastUse = 0;
+
+        size_t getSize() const { return blob->getBufferSize() + diagnostics.getLength(); }
+    };
+
+    void _evictLeastRecentlyUsed();
+
+    Dictionary<String, Entry> m_entries;
+    UInt64 m_useCount = 0;
+    size_t m_totalBytes = 0;
+    size_t m_maxBytes;
+    std::mutex m_mutex;
+};
+
 class Session : public RefObject, public slang::IGlobalSession
 {
 public:
@@ -175,6 +213,13 @@ public:
         SlangArchiveType archiveType,
         ISlangBlob** outBlob) override;
 
+    /// Load a serialized builtin module held in `moduleBlob`.
+    /// Unlike `loadBuiltinModule`, an uncompressed archive is referenced in place rather than
+    /// copied, so a memory-mapped blob is only paged in as the module is deserialized.
+    SlangResult loadBuiltinModuleFromBlob(
+        slang::BuiltinModuleName moduleName,
+        ISlangBlob* moduleBlob);
+
     SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(char const* name) override;
 
     SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerForTransition(
@@ -204,6 +249,11 @@ public:
     SLANG_NO_THROW SlangResult SLANG_MCALL
     getSessionDescDigest(slang::SessionDesc* sessionDesc, ISlangBlob** outBlob) override;
 
+    SLANG_NO_THROW void SLANG_MCALL setJobScheduler(ISlangJobScheduler* scheduler) override;
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    getJobScheduler(ISlangJobScheduler** outScheduler) override;
+    SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(SlangMemoryUsage* outUsage) override;
+
     /// Get the downstream compiler for a transition
     IDownstreamCompiler* getDownstreamCompiler(CodeGenTarget source, CodeGenTarget target);
 
@@ -290,6 +340,16 @@ public:
     /// Will unload the specified shared library if it's currently loaded
     void resetDownstreamCompiler(PassThroughMode type);
 
+    /// Start loading the downstream compiler that code generation for `target` will load, on
+    /// the job scheduler, so that loading the (large) library overlaps with front-end work.
+    /// Only done for slang-glslang and slang-llvm, and only with the default shared library
+    /// loader, since a loader set by the application may not expect calls from another thread,
+    /// and only when the application set a job scheduler or asked for more than one job thread.
+    void preloadDownstreamCompilerForTarget(CodeGenTarget target);
+
+    /// Called by a preload job when it has finished using the session.
+    void _endPreload();
+
     /// Get the prelude associated with the language
     const String& getPreludeForLanguage(SourceLanguage language)
     {
@@ -354,6 +414,32 @@ public:
     // Backend compilation threads update and read these aggregate timing counters concurrently.
     std::mutex m_compileTimeMutex;
 
+    /// Find a serialized module stored by `addSharedCheckedModule`, or return null.
+    ComPtr<ISlangBlob> findSharedCheckedModule(String const& key, String& outDiagnostics);
+    /// Make a module checked by one session available to the others, see
+    /// `CompilerOptionName::ShareCheckedModules`. `diagnostics` are the warnings checking it
+    /// reported, which are reported again whenever it is reused. Safe to call from multiple
+    /// threads.
+    void addSharedCheckedModule(
+        String const& key,
+        ISlangBlob* serializedModule,
+        String const& diagnostics);
+
+    /// Find the SPIR-V that validating and optimizing the SPIR-V with digest `key` produced
+    /// before, or return null.
+    ComPtr<ISlangBlob> findOptimizedSPIRV(String const& key);
+    /// Remember the result of validating and optimizing SPIR-V, so that identical SPIR-V
+    /// generated later, for example by another permutation of the same shader, can skip those
+    /// steps. Safe to call from multiple threads.
+    void addOptimizedSPIRV(String const& key, ISlangBlob* optimizedSPIRV);
+
+    /// Get the scheduler to run parallel work on, creating the built-in one if needed.
+    /// Safe to call from multiple threads.
+    ComPtr<ISlangJobScheduler> getCurrentJobScheduler();
+
+    /// The thread count the built-in job scheduler is created with.
+    Count m_jobThreadCount = 0;
+
 private:
     struct BuiltinModuleInfo
     {
@@ -365,6 +451,10 @@ private:
 
     void _initCodeGenTransitionMap();
 
+    SlangResult _loadBuiltinModule(
+        slang::BuiltinModuleName moduleName,
+        ISlangFileSystemExt* fileSystem);
+
     SlangResult _readBuiltinModule(
         ISlangFileSystem* fileSystem,
         Scope* scope,
@@ -387,6 +477,27 @@ private:
     double m_downstreamCompileTime = 0.0;
     double m_totalCompileTime = 0.0;
 
+    static const size_t kMaxSharedCheckedModuleCacheBytes = 256 * 1024 * 1024;
+    static const size_t kMaxOptimizedSPIRVCacheBytes = 64 * 1024 * 1024;
+
+    /// Serialized modules shared between sessions, keyed by a digest of the module's source
+    /// and the options it was checked with.
+    SessionBlobCache m_sharedCheckedModules{kMaxSharedCheckedModuleCacheBytes};
+
+    /// Optimized SPIR-V keyed by a digest of the unoptimized SPIR-V, the optimization options
+    /// and the version of the optimizer.
+    SessionBlobCache m_optimizedSPIRV{kMaxOptimizedSPIRVCacheBytes};
+
+    /// The scheduler set by `setJobScheduler`, or the built-in one once it has been created.
+    ComPtr<ISlangJobScheduler> m_jobScheduler;
+    bool m_hasApplicationJobScheduler = false;
+    std::mutex m_jobSchedulerMutex;
+
+    /// The number of preload jobs that are still using the session.
+    Count m_pendingPreloadCount = 0;
+    std::mutex m_pendingPreloadMutex;
+    std::condition_variable m_pendingPreloadCondition;
+
     /// The AST builder that will be used for builtin modules.
     ///
     RefPtr<ASTBuilder> m_rootASTBuilder;
@@ -1,6 +1,7 @@
 #include "slang-ir-any-value-inference.h"
 
 #include "../core/slang-func-ptr.h"
+#include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-util.h"
@@ -408,6 +409,22 @@ void inferAnyValueSizeWhereNecessary(
         analysis.interfaceTypes,
         [&](IRInterfaceType* interfaceType) { return analysis.dependencyMap[interfaceType]; });
 
+    // With the packed layout, an implementation needs only as much space as its packed
+    // representation, which can be smaller than its natural size.
+    bool isPacked = isAnyValueLayoutPacked(targetProgram);
+    auto getImplSizeAndAlignment = [&](IRType* implType, IRSizeAndAlignment& outSizeAndAlignment)
+    {
+        getNaturalSizeAndAlignment(
+            targetProgram->getTargetReq(),
+            implType,
+            &outSizeAndAlignment);
+        if (!isPacked)
+            return;
+        auto packedSize = getAnyValueSize(implType, targetProgram);
+        if (packedSize >= 0)
+            outSizeAndAlignment.size = packedSize;
+    };
+
     for (auto interfaceType : sortedInterfaceTypes)
     {
         IRIntegerValue existingMaxSize = (IRIntegerValue)kMaxInt; // Default to max int.
@@ -423,10 +440,7 @@ void inferAnyValueSizeWhereNecessary(
         for (auto implType : analysis.nonSelfReferentialImpls[interfaceType])
         {
             IRSizeAndAlignment sizeAndAlignment;
-            getNaturalSizeAndAlignment(
-                targetProgram->getTargetReq(),
-                (IRType*)implType,
-                &sizeAndAlignment);
+            getImplSizeAndAlignment((IRType*)implType, sizeAndAlignment);
 
             maxAnyValueSize = Math::Max(maxAnyValueSize, sizeAndAlignment.size);
 
@@ -458,10 +472,7 @@ void inferAnyValueSizeWhereNecessary(
         for (auto implType : analysis.selfReferentialImpls[interfaceType])
         {
             IRSizeAndAlignment sizeAndAlignment;
-            getNaturalSizeAndAlignment(
-                targetProgram->getTargetReq(),
-                (IRType*)implType,
-                &sizeAndAlignment);
+            getImplSizeAndAlignment((IRType*)implType, sizeAndAlignment);
 
             maxAnyValueSize = Math::Max(maxAnyValueSize, sizeAndAlignment.size);
 
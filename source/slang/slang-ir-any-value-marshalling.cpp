@@ -5,11 +5,93 @@
 #include "slang-ir-layout.h"
 #include "slang-ir-util.h"
 #include "slang-legalize-types.h"
+#include "slang-target-program.h"
 #include "slang-target.h"
 
 namespace Slang
 {
 
+// Tracks the position reached in the uint fields of an `AnyValue` while a value is laid out
+// into it.
+struct AnyValueLayoutCursor
+{
+    uint32_t fieldOffset = 0;
+    uint32_t intraFieldOffset = 0;
+
+    // With the packed layout, each bool is a single bit of a field shared with other bools.
+    // A new shared field is allocated where the first bool that doesn't fit the previous one
+    // is laid out.
+    bool packBools = false;
+    bool hasBoolField = false;
+    uint32_t boolFieldOffset = 0;
+    uint32_t boolBitCount = 0;
+
+    void ensureOffsetAt4ByteBoundary()
+    {
+        if (intraFieldOffset)
+        {
+            fieldOffset++;
+            intraFieldOffset = 0;
+        }
+    }
+    void ensureOffsetAt8ByteBoundary()
+    {
+        ensureOffsetAt4ByteBoundary();
+        if ((fieldOffset & 1) != 0)
+            fieldOffset++;
+    }
+    void ensureOffsetAt2ByteBoundary()
+    {
+        if (intraFieldOffset == 0)
+            return;
+        if (intraFieldOffset <= 2)
+        {
+            intraFieldOffset = 2;
+            return;
+        }
+        fieldOffset++;
+        intraFieldOffset = 0;
+        return;
+    }
+
+    void ensureOffsetAtNByteBoundary(int n)
+    {
+        if (n == 1)
+            return;
+        else if (n == 2)
+            ensureOffsetAt2ByteBoundary();
+        else if (n == 4)
+            ensureOffsetAt4ByteBoundary();
+        else if (n == 8)
+            ensureOffsetAt8ByteBoundary();
+    }
+
+    void advanceOffset(uint32_t bytes)
+    {
+        intraFieldOffset += bytes;
+        fieldOffset += intraFieldOffset / 4;
+        intraFieldOffset = intraFieldOffset % 4;
+    }
+
+    // Get the field and bit that the next bool is packed into.
+    void allocateBoolBit(uint32_t& outFieldOffset, uint32_t& outBit)
+    {
+        if (!hasBoolField || boolBitCount == 32)
+        {
+            ensureOffsetAt4ByteBoundary();
+            hasBoolField = true;
+            boolFieldOffset = fieldOffset;
+            boolBitCount = 0;
+            advanceOffset(4);
+        }
+        outFieldOffset = boolFieldOffset;
+        outBit = boolBitCount++;
+    }
+
+    // The size in bytes of the fields used so far.
+    SlangInt getSize() const { return SlangInt(fieldOffset + (intraFieldOffset ? 1 : 0)) * 4; }
+};
+
 // This is a subpass of generics lowering IR transformation.
 // This pass generates packing/unpacking functions for `AnyValue`s,
 // and replaces all `IRPackAnyValue` and `IRUnpackAnyValue` with calls to these
@@ -109,12 +191,10 @@ struct AnyValueMarshallingContext
         return info.Ptr();
     }
 
-    struct TypeMarshallingContext
+    struct TypeMarshallingContext : AnyValueLayoutCursor
     {
         TargetRequest* targetRequest;
         AnyValueTypeInfo* anyValInfo;
-        uint32_t fieldOffset;
-        uint32_t intraFieldOffset;
         IRType* uintPtrType;
         IRInst* anyValueVar;
         TargetProgram* targetProgram;
@@ -139,53 +219,6 @@ struct AnyValueMarshallingContext
             IRInst* concreteTypedVar,
             bool isBindless,
             IRIntegerValue sizeInBytes) = 0;
-
-        void ensureOffsetAt4ByteBoundary()
-        {
-            if (intraFieldOffset)
-            {
-                fieldOffset++;
-                intraFieldOffset = 0;
-            }
-        }
-        void ensureOffsetAt8ByteBoundary()
-        {
-            ensureOffsetAt4ByteBoundary();
-            if ((fieldOffset & 1) != 0)
-                fieldOffset++;
-        }
-        void ensureOffsetAt2ByteBoundary()
-        {
-            if (intraFieldOffset == 0)
-                return;
-            if (intraFieldOffset <= 2)
-            {
-                intraFieldOffset = 2;
-                return;
-            }
-            fieldOffset++;
-            intraFieldOffset = 0;
-            return;
-        }
-
-        void ensureOffsetAtNByteBoundary(int n)
-        {
-            if (n == 1)
-                return;
-            else if (n == 2)
-                ensureOffsetAt2ByteBoundary();
-            else if (n == 4)
-                ensureOffsetAt4ByteBoundary();
-            else if (n == 8)
-                ensureOffsetAt8ByteBoundary();
-        }
-
-        void advanceOffset(uint32_t bytes)
-        {
-            intraFieldOffset += bytes;
-            fieldOffset += intraFieldOffset / 4;
-            intraFieldOffset = intraFieldOffset % 4;
-        }
     };
 
     void emitMarshallingCode(
@@ -375,6 +408,33 @@ struct AnyValueMarshallingContext
                 }
             case kIROp_BoolType:
                 {
+                    if (packBools)
+                    {
+                        uint32_t boolField = 0;
+                        uint32_t bit = 0;
+                        allocateBoolBit(boolField, bit);
+                        if (boolField < static_cast<uint32_t>(anyValInfo->fieldKeys.getCount()))
+                        {
+                            auto srcVal = builder->emitLoad(concreteVar);
+                            IRInst* args[] = {
+                                srcVal,
+                                builder->getIntValue(builder->getUIntType(), 1u << bit),
+                                builder->getIntValue(builder->getUIntType(), 0)};
+                            auto bitVal = builder->emitIntrinsicInst(
+                                builder->getUIntType(),
+                                kIROp_Select,
+                                3,
+                                args);
+                            auto dstAddr = builder->emitFieldAddress(
+                                uintPtrType,
+                                anyValueVar,
+                                anyValInfo->fieldKeys[boolField]);
+                            auto dstVal = builder->emitLoad(dstAddr);
+                            dstVal = builder->emitBitOr(dstVal->getFullType(), dstVal, bitVal);
+                            builder->emitStore(dstAddr, dstVal);
+                        }
+                        break;
+                    }
                     ensureOffsetAt4ByteBoundary();
                     if (fieldOffset < static_cast<uint32_t>(anyValInfo->fieldKeys.getCount()))
                     {
@@ -761,6 +821,7 @@ struct AnyValueMarshallingContext
         context.targetRequest = targetProgram->getTargetReq();
         context.anyValInfo = anyValInfo;
         context.fieldOffset = context.intraFieldOffset = 0;
+        context.packBools = isAnyValueLayoutPacked(targetProgram);
         context.uintPtrType = builder.getPtrType(builder.getUIntType());
         context.anyValueVar = resultVar;
         context.targetProgram = targetProgram;
@@ -797,6 +858,29 @@ struct AnyValueMarshallingContext
                 }
             case kIROp_BoolType:
                 {
+                    if (packBools)
+                    {
+                        uint32_t boolField = 0;
+                        uint32_t bit = 0;
+                        allocateBoolBit(boolField, bit);
+                        if (boolField < static_cast<uint32_t>(anyValInfo->fieldKeys.getCount()))
+                        {
+                            auto srcAddr = builder->emitFieldAddress(
+                                uintPtrType,
+                                anyValueVar,
+                                anyValInfo->fieldKeys[boolField]);
+                            auto srcVal = builder->emitLoad(srcAddr);
+                            srcVal = builder->emitBitAnd(
+                                srcVal->getFullType(),
+                                srcVal,
+                                builder->getIntValue(builder->getUIntType(), 1u << bit));
+                            srcVal = builder->emitNeq(
+                                srcVal,
+                                builder->getIntValue(builder->getUIntType(), 0));
+                            builder->emitStore(concreteVar, srcVal);
+                        }
+                        break;
+                    }
                     ensureOffsetAt4ByteBoundary();
                     if (fieldOffset < static_cast<uint32_t>(anyValInfo->fieldKeys.getCount()))
                     {
@@ -1166,6 +1250,7 @@ struct AnyValueMarshallingContext
         context.targetRequest = targetProgram->getTargetReq();
         context.anyValInfo = anyValInfo;
         context.fieldOffset = context.intraFieldOffset = 0;
+        context.packBools = isAnyValueLayoutPacked(targetProgram);
         context.uintPtrType = builder.getPtrType(builder.getUIntType());
         context.anyValueVar = anyValueVar;
         context.targetProgram = targetProgram;
@@ -1385,4 +1470,169 @@ SlangInt getAnyValueSize(IRType* type, TargetRequest* targetReq)
         return rawSize;
     return alignUp(rawSize, 4);
 }
+
+// Lay out `type` at `cursor` the way `emitMarshallingCode` does, without generating code.
+// Returns false for types that aren't marshalled field by field.
+static bool _advanceAnyValueLayout(
+    IRType* type,
+    TargetRequest* targetReq,
+    AnyValueLayoutCursor& cursor)
+{
+    switch (type->getOp())
+    {
+    case kIROp_VoidType:
+        return true;
+    case kIROp_IntType:
+    case kIROp_UIntType:
+    case kIROp_FloatType:
+        cursor.ensureOffsetAt4ByteBoundary();
+        cursor.advanceOffset(4);
+        return true;
+    case kIROp_BoolType:
+        if (cursor.packBools)
+        {
+            uint32_t boolField = 0;
+            uint32_t bit = 0;
+            cursor.allocateBoolBit(boolField, bit);
+        }
+        else
+        {
+            cursor.ensureOffsetAt4ByteBoundary();
+            cursor.advanceOffset(4);
+        }
+        return true;
+    case kIROp_Int16Type:
+    case kIROp_UInt16Type:
+    case kIROp_HalfType:
+    case kIROp_BFloat16Type:
+        cursor.ensureOffsetAt2ByteBoundary();
+        cursor.advanceOffset(2);
+        return true;
+    case kIROp_Int8Type:
+    case kIROp_UInt8Type:
+    case kIROp_FloatE4M3Type:
+    case kIROp_FloatE5M2Type:
+        cursor.advanceOffset(1);
+        return true;
+    case kIROp_UInt64Type:
+    case kIROp_Int64Type:
+    case kIROp_DoubleType:
+        cursor.ensureOffsetAt8ByteBoundary();
+        cursor.fieldOffset += 2;
+        return true;
+    case kIROp_PtrType:
+    case kIROp_UIntPtrType:
+    case kIROp_IntPtrType:
+        {
+            auto ptrSize = getPointerSize(targetReq);
+            cursor.ensureOffsetAtNByteBoundary(int(ptrSize));
+            cursor.advanceOffset(uint32_t(ptrSize));
+            return true;
+        }
+    case kIROp_EnumType:
+        return _advanceAnyValueLayout(
+            static_cast<IREnumType*>(type)->getTagType(),
+            targetReq,
+            cursor);
+    case kIROp_VectorType:
+        {
+            auto vectorType = static_cast<IRVectorType*>(type);
+            auto elementCount = as<IRIntLit>(vectorType->getElementCount());
+            if (!elementCount)
+                return false;
+            for (IRIntegerValue i = 0; i < elementCount->getValue(); i++)
+            {
+                if (!_advanceAnyValueLayout(vectorType->getElementType(), targetReq, cursor))
+                    return false;
+            }
+            return true;
+        }
+    case kIROp_MatrixType:
+        {
+            auto matrixType = static_cast<IRMatrixType*>(type);
+            auto rowCount = as<IRIntLit>(matrixType->getRowCount());
+            auto colCount = as<IRIntLit>(matrixType->getColumnCount());
+            if (!rowCount || !colCount)
+                return false;
+            for (IRIntegerValue i = 0; i < rowCount->getValue() * colCount->getValue(); i++)
+            {
+                if (!_advanceAnyValueLayout(matrixType->getElementType(), targetReq, cursor))
+                    return false;
+            }
+            return true;
+        }
+    case kIROp_StructType:
+        for (auto field : cast<IRStructType>(type)->getFields())
+        {
+            if (!_advanceAnyValueLayout(field->getFieldType(), targetReq, cursor))
+                return false;
+        }
+        return true;
+    case kIROp_ArrayType:
+        {
+            auto arrayType = cast<IRArrayType>(type);
+            auto elementCount = as<IRIntLit>(arrayType->getElementCount());
+            if (!elementCount)
+                return false;
+            for (IRIntegerValue i = 0; i < elementCount->getValue(); i++)
+            {
+                if (!_advanceAnyValueLayout(arrayType->getElementType(), targetReq, cursor))
+                    return false;
+            }
+            return true;
+        }
+    case kIROp_AnyValueType:
+        {
+            auto size = as<IRIntLit>(cast<IRAnyValueType>(type)->getSize());
+            if (!size)
+                return false;
+            cursor.ensureOffsetAt4ByteBoundary();
+            cursor.advanceOffset(uint32_t(alignUp(size->getValue(), 4)));
+            return true;
+        }
+    case kIROp_DescriptorHandleType:
+        {
+            IRIntegerValue size = 8;
+            IRSizeAndAlignment sizeAndAlign;
+            if (areResourceTypesBindlessOnTarget(targetReq) &&
+                SLANG_SUCCEEDED(getNaturalSizeAndAlignment(targetReq, type, &sizeAndAlign)) &&
+                sizeAndAlign.size > 0)
+                size = sizeAndAlign.size;
+            cursor.ensureOffsetAt4ByteBoundary();
+            cursor.advanceOffset(uint32_t(size));
+            return true;
+        }
+    default:
+        if (isResourceType(type))
+        {
+            IRIntegerValue size = 8;
+            IRSizeAndAlignment sizeAndAlign;
+            if (SLANG_SUCCEEDED(getNaturalSizeAndAlignment(targetReq, type, &sizeAndAlign)) &&
+                sizeAndAlign.size > 0)
+                size = sizeAndAlign.size;
+            cursor.ensureOffsetAt4ByteBoundary();
+            cursor.advanceOffset(uint32_t(size));
+            return true;
+        }
+        return false;
+    }
+}
+
+bool isAnyValueLayoutPacked(TargetProgram* targetProgram)
+{
+    return targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PackedAnyValueLayout);
+}
+
+SlangInt getAnyValueSize(IRType* type, TargetProgram* targetProgram)
+{
+    auto targetReq = targetProgram->getTargetReq();
+    if (isAnyValueLayoutPacked(targetProgram))
+    {
+        AnyValueLayoutCursor cursor;
+        cursor.packBools = true;
+        if (_advanceAnyValueLayout(type, targetReq, cursor))
+            return cursor.getSize();
+    }
+    return getAnyValueSize(type, targetReq);
+}
 } // namespace Slang
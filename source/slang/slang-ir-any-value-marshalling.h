@@ -19,4 +19,12 @@ void generateAnyValueMarshallingFunctions(IRModule* module, TargetProgram* targe
 
 /// Get the AnyValue size required to hold a value of `type`.
 SlangInt getAnyValueSize(IRType* type, TargetRequest* targetReq);
+
+/// Get the AnyValue size required to hold a value of `type` with the layout used by
+/// `targetProgram`, which is smaller than the natural size when `-packed-any-value-layout`
+/// is set.
+SlangInt getAnyValueSize(IRType* type, TargetProgram* targetProgram);
+
+/// Does `targetProgram` bit-pack bools in the values it marshals to `AnyValue`s?
+bool isAnyValueLayoutPacked(TargetProgram* targetProgram);
 } // namespace Slang
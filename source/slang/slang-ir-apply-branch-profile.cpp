@@ -0,0 +1,136 @@
+// slang-ir-apply-branch-profile.cpp
+#include "slang-ir-apply-branch-profile.h"
+
+#include "../compiler-core/slang-source-loc.h"
+#include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// A side of an `if` that runs at most once for every this many executions of the `if` is
+// considered rare.
+static const Int kRareSideRatio = 8;
+
+void BranchProfile::parse(UnownedStringSlice text)
+{
+    for (auto line : LineParser(text))
+    {
+        line = line.trim();
+        if (line.getLength() == 0 || line.startsWith("#"))
+            continue;
+
+        List<UnownedStringSlice> parts;
+        StringUtil::splitOnWhitespace(line, parts);
+        Int count = 0;
+        if (parts.getCount() != 2 || SLANG_FAILED(StringUtil::parseInt(parts[1], count)))
+            continue;
+
+        // The path itself can contain a `:`, as in a Windows drive letter.
+        auto position = parts[0];
+        auto colonIndex = position.lastIndexOf(':');
+        Int lineNumber = 0;
+        if (colonIndex <= 0 ||
+            SLANG_FAILED(StringUtil::parseInt(position.tail(colonIndex + 1), lineNumber)))
+            continue;
+        counts[String(position)] = count;
+    }
+}
+
+Int BranchProfile::getCount(SourceManager* sourceManager, SourceLoc loc) const
+{
+    if (!loc.isValid())
+        return -1;
+    auto humane = sourceManager->getHumaneLoc(loc, SourceLocType::Emit);
+    if (humane.line <= 0)
+        return -1;
+
+    StringBuilder key;
+    key << humane.pathInfo.foundPath << ":" << humane.line;
+    if (auto count = counts.tryGetValue(key.produceString()))
+        return *count;
+
+    key.clear();
+    key << Path::getFileName(humane.pathInfo.foundPath) << ":" << humane.line;
+    if (auto count = counts.tryGetValue(key.produceString()))
+        return *count;
+    return -1;
+}
+
+// Get the count of the first inst of `block` with a line in the profile, as long as it isn't
+// on `ifLine`, the line of the `if` itself.
+static Int getBlockCount(
+    SourceManager* sourceManager,
+    BranchProfile const& profile,
+    IRBlock* block,
+    Int ifLine)
+{
+    for (auto inst : block->getChildren())
+    {
+        if (!inst->sourceLoc.isValid())
+            continue;
+        auto humane = sourceManager->getHumaneLoc(inst->sourceLoc, SourceLocType::Emit);
+        if (humane.line == ifLine)
+            return -1;
+        auto count = profile.getCount(sourceManager, inst->sourceLoc);
+        if (count >= 0)
+            return count;
+    }
+    return -1;
+}
+
+static void applyBranchProfileToIf(
+    SourceManager* sourceManager,
+    BranchProfile const& profile,
+    IRIfElse* ifElse)
+{
+    if (ifElse->findDecorationImpl(kIROp_BranchDecoration) ||
+        ifElse->findDecorationImpl(kIROp_FlattenDecoration))
+        return;
+
+    auto ifCount = profile.getCount(sourceManager, ifElse->sourceLoc);
+    if (ifCount <= 0)
+        return;
+
+    // Statements on the same line as the `if` share its count, so they tell nothing about
+    // which side was taken.
+    auto ifLine = sourceManager->getHumaneLoc(ifElse->sourceLoc, SourceLocType::Emit).line;
+    auto trueCount = getBlockCount(sourceManager, profile, ifElse->getTrueBlock(), ifLine);
+    if (trueCount < 0)
+        return;
+
+    auto falseCount = ifCount > trueCount ? ifCount - trueCount : 0;
+    if (trueCount * kRareSideRatio > ifCount && falseCount * kRareSideRatio > ifCount)
+        return;
+
+    IRBuilder builder(ifElse);
+    builder.addDecoration(ifElse, kIROp_BranchDecoration);
+}
+
+void applyBranchProfile(
+    IRModule* module,
+    SourceManager* sourceManager,
+    BranchProfile const& profile)
+{
+    if (!sourceManager || profile.counts.getCount() == 0)
+        return;
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto value = inst;
+        if (auto generic = as<IRGeneric>(inst))
+            value = findGenericReturnVal(generic);
+        auto code = as<IRGlobalValueWithCode>(value);
+        if (!code)
+            continue;
+        for (auto block : code->getBlocks())
+        {
+            if (auto ifElse = as<IRIfElse>(block->getTerminator()))
+                applyBranchProfileToIf(sourceManager, profile, ifElse);
+        }
+    }
+}
+
+} // namespace Slang
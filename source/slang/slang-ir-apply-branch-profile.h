@@ -0,0 +1,40 @@
+// slang-ir-apply-branch-profile.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-dictionary.h"
+
+namespace Slang
+{
+struct IRModule;
+class SourceManager;
+class SourceLoc;
+
+/// How many times each source line ran, read from a `-branch-profile` file.
+///
+/// Each line of the file holds a source position as `path:line` and a count, separated by
+/// whitespace. Summing the `-trace-coverage` counters of each position in the coverage
+/// mapping gives such a file. The path can be either the path of the source file as it was
+/// found, or just its file name. Lines starting with `#` are comments.
+struct BranchProfile
+{
+    Dictionary<String, Int> counts;
+
+    /// Parse the profile `text`. Lines that don't hold a position and a count are ignored.
+    void parse(UnownedStringSlice text);
+
+    /// Get the count of the line that `loc` is on, or -1 if the profile has none.
+    Int getCount(SourceManager* sourceManager, SourceLoc loc) const;
+};
+
+/// Mark the `if` statements that the profile shows to be strongly biased as `[branch]`.
+///
+/// An `if` whose body ran at most a small fraction of the times the `if` itself ran, or
+/// whose `else` side did, gains the most from a real branch, since the threads of a group
+/// then usually all skip the rarely taken side. Statements that already have a `[branch]`
+/// or `[flatten]` attribute are left as they are.
+void applyBranchProfile(
+    IRModule* module,
+    SourceManager* sourceManager,
+    BranchProfile const& profile);
+} // namespace Slang
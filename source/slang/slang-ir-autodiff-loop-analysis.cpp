@@ -535,22 +535,22 @@ enum class BlockStateFlags
 
 void markUpwardPropCompleted(IRBlock* block)
 {
-    block->scratchData |= (UInt64)BlockStateFlags::UpwardPropCompleted;
+    block->scratchData |= (uint32_t)BlockStateFlags::UpwardPropCompleted;
 }
 
 void markDownwardPropCompleted(IRBlock* block)
 {
-    block->scratchData |= (UInt64)BlockStateFlags::DownwardPropCompleted;
+    block->scratchData |= (uint32_t)BlockStateFlags::DownwardPropCompleted;
 }
 
 bool isUpwardPropCompleted(IRBlock* block)
 {
-    return block->scratchData & (UInt64)BlockStateFlags::UpwardPropCompleted;
+    return block->scratchData & (uint32_t)BlockStateFlags::UpwardPropCompleted;
 }
 
 bool isDownwardPropCompleted(IRBlock* block)
 {
-    return block->scratchData & (UInt64)BlockStateFlags::DownwardPropCompleted;
+    return block->scratchData & (uint32_t)BlockStateFlags::DownwardPropCompleted;
 }
 
 void clearBlockState(IRBlock* block)
@@ -501,7 +501,7 @@ struct DiffPairLoweringPass : InstPassBase
                 }
             });
 
-        OrderedDictionary<IRInst*, IRInst*> pendingReplacements;
+        List<KeyValuePair<IRInst*, IRInst*>> pendingReplacements;
         processAllInsts(
             [&](IRInst* inst)
             {
@@ -509,16 +509,15 @@ struct DiffPairLoweringPass : InstPassBase
                 {
                     if (auto loweredType = lowerPairType(builder, pairType))
                     {
-                        pendingReplacements.add(pairType, loweredType);
+                        pendingReplacements.add(
+                            KeyValuePair<IRInst*, IRInst*>(pairType, loweredType));
                         modified = true;
                     }
                 }
             });
+        builder->getModule()->replaceUsesWith(pendingReplacements.getArrayView());
         for (auto replacement : pendingReplacements)
-        {
-            replacement.key->replaceUsesWith(replacement.value);
             replacement.key->removeAndDeallocate();
-        }
 
         return modified;
     }
@@ -5,9 +5,12 @@
 #include "slang-ir-autodiff-loop-analysis.h"
 #include "slang-ir-autodiff-region.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
+#include "slang-rich-diagnostics.h"
+#include "slang-target-program.h"
 
 namespace Slang
 {
@@ -415,9 +418,11 @@ RefPtr<HoistedPrimalsInfo> AutodiffCheckpointPolicyBase::processFunc(
 
     collectLoopExitConditions(func);
 
+    preparePolicy(func);
+
     RefPtr<CheckpointSetInfo> checkpointInfo = new CheckpointSetInfo();
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
 
     List<UseOrPseudoUse> workList;
     HashSet<UseOrPseudoUse> processedUses;
@@ -1111,7 +1116,7 @@ void AutodiffCheckpointPolicyBase::collectLoopExitConditions(IRGlobalValueWithCo
 {
     // Assume that the InductionValueInfo is already collected.
     IRBuilder builder(func->getModule());
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
     for (auto block : func->getBlocks())
     {
         auto loopInst = as<IRLoop>(block->getTerminator());
@@ -1950,7 +1955,7 @@ RefPtr<HoistedPrimalsInfo> ensurePrimalAvailability(
     // }
     //
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
 
     IRBlock* defaultVarBlock = func->getFirstBlock()->getNextBlock();
 
@@ -2520,7 +2525,11 @@ void lowerCheckpointObjectInsts(IRGlobalValueWithCode* func)
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink,
+    IRInst* originalFunc)
 {
     sortBlocksInFunc(func);
 
@@ -2553,10 +2562,21 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding
     // recompute block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
-    chkPolicy->preparePolicy(func);
+    RefPtr<DefaultCheckpointPolicy> chkPolicy =
+        new DefaultCheckpointPolicy(func->getModule(), targetProgram);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
+    if (sink && chkPolicy->getCheckpointBudget() &&
+        chkPolicy->getCheckpointBytes() > chkPolicy->getCheckpointBudget())
+    {
+        auto diagnosticFunc = originalFunc ? originalFunc : func;
+        sink->diagnose(Diagnostics::AutodiffCheckpointBudgetExceeded{
+            .funcName = diagnosticFunc,
+            .bytes = int64_t(chkPolicy->getCheckpointBytes()),
+            .budget = int64_t(chkPolicy->getCheckpointBudget()),
+            .location = diagnosticFunc->sourceLoc});
+    }
+
     // Legalize the primal inst accesses by introducing local variables / arrays and emitting
     // necessary load/store logic.
     //
@@ -2570,8 +2590,17 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
 
 void DefaultCheckpointPolicy::preparePolicy(IRGlobalValueWithCode* func)
 {
-    SLANG_UNUSED(func)
-    return;
+    checkpointBudget = 0;
+    checkpointBytes = 0;
+    budgetRecomputeSet.clear();
+
+    if (!targetProgram)
+        return;
+
+    checkpointBudget =
+        targetProgram->getOptionSet().getIntOption(CompilerOptionName::AutodiffCheckpointBudget);
+    if (checkpointBudget > 0)
+        applyCheckpointBudget(func);
 }
 
 CheckpointPreference getCheckpointPreference(IRInst* callee)
@@ -2838,6 +2867,184 @@ bool DefaultCheckpointPolicy::canRecompute(UseOrPseudoUse use)
     return true;
 }
 
+static bool isUsedInDifferentialOrRecomputeBlocks(IRInst* inst)
+{
+    for (auto use = inst->firstUse; use; use = use->nextUse)
+    {
+        auto userBlock = as<IRBlock>(use->getUser()->getParent());
+        if (userBlock && isDifferentialOrRecomputeBlock(userBlock))
+            return true;
+    }
+    return false;
+}
+
+// Returns true if the primal blocks of `func` may write to memory other than
+// its local variables, so that reading such memory again in the reverse blocks
+// could see a different value than the primal code did.
+//
+static bool mayWriteNonLocalMemory(IRGlobalValueWithCode* func)
+{
+    for (auto block : func->getBlocks())
+    {
+        if (isDifferentialOrRecomputeBlock(block))
+            continue;
+        for (auto inst : block->getChildren())
+        {
+            if (as<IRTerminatorInst>(inst) || !inst->mightHaveSideEffects())
+                continue;
+            if (auto store = as<IRStore>(inst))
+            {
+                if (!isGlobalOrUnknownMutableAddress(func, store->getPtr()))
+                    continue;
+            }
+            else if (auto call = as<IRCall>(inst))
+            {
+                if (!doesCalleeHaveSideEffect(call->getCallee()))
+                    continue;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true if `inst`, which the default policy stores, can be recomputed
+// instead without changing the results of the reverse blocks.
+//
+static bool canTradeStoreForRecompute(IRInst* inst, bool funcMayWriteNonLocalMemory)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_CheckpointObject:
+    case kIROp_Param:
+    case kIROp_Load:
+    case kIROp_LoopExitValue:
+        return false;
+    case kIROp_Call:
+        {
+            auto call = as<IRCall>(inst);
+            if (getCheckpointPreference(call->getCallee()) ==
+                CheckpointPreference::PreferCheckpoint)
+                return false;
+
+            // The callee may read memory, so calling it again is only safe if
+            // nothing in the function can have changed that memory.
+            if (funcMayWriteNonLocalMemory || doesCalleeHaveSideEffect(call->getCallee()))
+                return false;
+            for (UInt i = 0; i < call->getArgCount(); i++)
+            {
+                if (as<IRPtrTypeBase>(call->getArg(i)->getDataType()))
+                    return false;
+            }
+            return true;
+        }
+    default:
+        return !inst->mightHaveSideEffects();
+    }
+}
+
+// A rough measure of the work needed to recompute `inst`: a call costs the number
+// of instructions in its callee, anything else costs one.
+//
+static IRIntegerValue estimateRecomputeCost(IRInst* inst)
+{
+    IRIntegerValue cost = 0;
+    if (auto call = as<IRCall>(inst))
+    {
+        auto callee = as<IRGlobalValueWithCode>(getResolvedInstForDecorations(call->getCallee()));
+        if (callee)
+        {
+            for (auto block : callee->getBlocks())
+            {
+                for (auto child : block->getChildren())
+                {
+                    SLANG_UNUSED(child);
+                    cost++;
+                }
+            }
+        }
+    }
+    return Math::Max(cost, IRIntegerValue(1));
+}
+
+// Estimate how many bytes per thread `func` checkpoints under the default policy,
+// and if that is over `checkpointBudget`, pick values to recompute instead until it
+// fits. Values saving the most bytes per unit of recompute work are picked first.
+// Each stored value is counted once, even when it is stored on every iteration of
+// a loop.
+//
+void DefaultCheckpointPolicy::applyCheckpointBudget(IRGlobalValueWithCode* func)
+{
+    struct Candidate
+    {
+        IRInst* inst;
+        IRIntegerValue size;
+        IRIntegerValue cost;
+    };
+    List<Candidate> candidates;
+
+    const bool funcMayWriteNonLocalMemory = mayWriteNonLocalMemory(func);
+    auto targetReq = targetProgram->getTargetReq();
+
+    for (auto block : func->getBlocks())
+    {
+        // The parameters are available to the reverse blocks without checkpointing.
+        if (block == func->getFirstBlock() || isDifferentialOrRecomputeBlock(block))
+            continue;
+
+        for (auto inst : block->getChildren())
+        {
+            if (!isUsedInDifferentialOrRecomputeBlocks(inst))
+                continue;
+
+            IRType* storedType = nullptr;
+            bool isOptionalStore = false;
+            if (auto var = as<IRVar>(inst))
+            {
+                if (!shouldStoreVar(var))
+                    continue;
+                storedType = var->getDataType()->getValueType();
+            }
+            else if (shouldStoreInst(inst))
+            {
+                storedType = inst->getDataType();
+                isOptionalStore = canTradeStoreForRecompute(inst, funcMayWriteNonLocalMemory) &&
+                                  canRecompute(UseOrPseudoUse(nullptr, inst));
+            }
+            else if (!canRecompute(UseOrPseudoUse(nullptr, inst)))
+            {
+                storedType = inst->getDataType();
+            }
+            else
+            {
+                continue;
+            }
+
+            IRSizeAndAlignment sizeAndAlignment;
+            if (SLANG_FAILED(getNaturalSizeAndAlignment(targetReq, storedType, &sizeAndAlignment)))
+                continue;
+
+            checkpointBytes += sizeAndAlignment.getStride();
+            if (isOptionalStore)
+            {
+                candidates.add(
+                    Candidate{inst, sizeAndAlignment.getStride(), estimateRecomputeCost(inst)});
+            }
+        }
+    }
+
+    candidates.sort(
+        [](const Candidate& a, const Candidate& b) { return a.size * b.cost > b.size * a.cost; });
+
+    for (auto& candidate : candidates)
+    {
+        if (checkpointBytes <= checkpointBudget)
+            break;
+        budgetRecomputeSet.add(candidate.inst);
+        checkpointBytes -= candidate.size;
+    }
+}
+
 HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
 {
     // Store all that we can.. by default, classify will only be called on relevant differential
@@ -2854,6 +3061,10 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
     {
         if (shouldStoreInst(use.usedVal))
         {
+            // Trade the store for recomputation if it is needed to meet the budget.
+            if (budgetRecomputeSet.contains(use.usedVal) && canRecompute(use))
+                return HoistResult::recompute(use.usedVal);
+
             return HoistResult::store(use.usedVal);
         }
         else
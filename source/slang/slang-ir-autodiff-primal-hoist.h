@@ -333,7 +333,8 @@ public:
 
     // Do pre-processing on the function (mainly for
     // 'global' checkpointing methods that consider the entire
-    // function)
+    // function). Called by `processFunc` once the loop induction
+    // values and loop exit values have been collected.
     //
     virtual void preparePolicy(IRGlobalValueWithCode* func) = 0;
 
@@ -350,19 +351,42 @@ protected:
 class DefaultCheckpointPolicy : public AutodiffCheckpointPolicyBase
 {
 public:
-    DefaultCheckpointPolicy(IRModule* module)
-        : AutodiffCheckpointPolicyBase(module)
+    DefaultCheckpointPolicy(IRModule* module, TargetProgram* targetProgram = nullptr)
+        : AutodiffCheckpointPolicyBase(module), targetProgram(targetProgram)
     {
     }
 
     virtual void preparePolicy(IRGlobalValueWithCode* func);
     virtual HoistResult classify(UseOrPseudoUse use);
 
+    // The checkpoint budget in bytes that was applied to the last prepared
+    // function (0 if there is none), and the estimated number of bytes that
+    // function still checkpoints after applying it.
+    IRIntegerValue getCheckpointBudget() { return checkpointBudget; }
+    IRIntegerValue getCheckpointBytes() { return checkpointBytes; }
+
 private:
     bool canRecompute(UseOrPseudoUse use);
+    void applyCheckpointBudget(IRGlobalValueWithCode* func);
+
+    TargetProgram* targetProgram;
+    IRIntegerValue checkpointBudget = 0;
+    IRIntegerValue checkpointBytes = 0;
+
+    // Values that would be stored by default, but that are recomputed instead
+    // to keep the function within the checkpoint budget.
+    HashSet<IRInst*> budgetRecomputeSet;
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+// Decide for each primal inst of `func` used in its reverse blocks whether to store or
+// recompute it. `targetProgram` supplies the `-autodiff-checkpoint-budget` option, if any,
+// and `sink` is warned against `originalFunc` when the budget can't be met.
+//
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram = nullptr,
+    DiagnosticSink* sink = nullptr,
+    IRInst* originalFunc = nullptr);
 
 enum CheckpointPreference
 {
@@ -227,7 +227,11 @@ struct BackwardDiffTranslationContext
 
         // Apply checkpointing policy to legalize cross-scope uses of primal values
         // using either recompute or store strategies.
-        auto primalsInfo = applyCheckpointPolicy(propagateFunc);
+        auto primalsInfo = applyCheckpointPolicy(
+            propagateFunc,
+            autoDiffSharedContext->targetProgram,
+            sink,
+            targetFunc);
 
         // Extracts the primal computations into its own func, turn all accesses to stored primal
         // insts into explicit intermediate data structure reads and writes.
@@ -329,8 +329,9 @@ IRInst* DifferentiableTypeConformanceContext::getDiffTypeWitnessFromPairType(
 
 IRFunc* DifferentiableTypeConformanceContext::getOrCreateExistentialDAddMethod()
 {
-    if (this->existentialDAddFunc)
-        return this->existentialDAddFunc;
+    auto& existentialDAddFunc = sharedContext->existentialDAddFunc;
+    if (existentialDAddFunc)
+        return existentialDAddFunc;
 
     SLANG_ASSERT(sharedContext->differentiableInterfaceType);
     SLANG_ASSERT(sharedContext->nullDifferentialWitness);
@@ -391,19 +392,8 @@ IRFunc* DifferentiableTypeConformanceContext::getOrCreateExistentialDAddMethod()
     //
     auto concreteDiffTypeWitnessTable = builder.emitExtractExistentialWitnessTable(aObj);
 
-    // Extract func type from the witness table type.
-    IRFuncType* dAddFuncType = nullptr;
-    for (UIndex ii = 0; ii < sharedContext->differentiableInterfaceType->getOperandCount(); ii++)
-    {
-        auto entry = cast<IRInterfaceRequirementEntry>(
-            sharedContext->differentiableInterfaceType->getOperand(ii));
-        if (entry->getRequirementKey() == sharedContext->addMethodStructKey)
-        {
-            dAddFuncType = cast<IRFuncType>(entry->getRequirementVal());
-            break;
-        }
-    }
-
+    // The func type of the requirement was already found when setting up the shared context.
+    IRFuncType* dAddFuncType = sharedContext->addMethodType;
     SLANG_ASSERT(dAddFuncType);
 
     auto dAddMethod = builder.emitLookupInterfaceMethodInst(
@@ -121,6 +121,13 @@ struct AutoDiffSharedContext
     bool isInterfaceAvailable = false;
     bool isPtrInterfaceAvailable = false;
 
+    // The `dadd` implementation for existential differentials, synthesized the first
+    // time it is needed and then shared by every pass (forward, reverse, unzip,
+    // transpose) that works through this context, so that each differentiated
+    // function doesn't get its own copy.
+    //
+    IRFunc* existentialDAddFunc = nullptr;
+
     AutoDiffSharedContext(TargetProgram* targetProgram, IRModuleInst* inModuleInst);
 };
 
@@ -130,8 +137,6 @@ struct DifferentiableTypeConformanceContext
 
     IRGlobalValueWithCode* parentFunc = nullptr;
 
-    IRFunc* existentialDAddFunc = nullptr;
-
     DifferentiableTypeConformanceContext(AutoDiffSharedContext* shared)
         : sharedContext(shared)
     {
@@ -54,6 +54,9 @@ struct ByteAddressBufferLegalizationContext
 
         processInstRec(module->getModuleInst());
 
+        if (m_options.coalesceScalarLoadStore)
+            coalesceAccessesRec(module->getModuleInst());
+
         // After processing, remove ByteAddressBuffer parameters that have been
         // replaced by StructuredBuffer parameters. These are no longer needed
         // and would cause errors in backends like SPIR-V that don't support
@@ -1563,6 +1566,297 @@ struct ByteAddressBufferLegalizationContext
         }
     }
 
+    // Legalizing an aggregate load or store produces one scalar operation per field or
+    // element, so a `struct` of four `float`s becomes four adjacent `Load`s. After
+    // legalization, we look for runs of scalar loads or stores in a block that access
+    // consecutive 4-byte offsets from the same base, and replace each run with a single
+    // `Load2`/`Load3`/`Load4` or `Store2`/`Store3`/`Store4`.
+    //
+    // This is only enabled for targets where a vector byte-address access needs no more
+    // than the alignment of its element type.
+
+    // A set of scalar accesses of the same type through the same buffer and base offset,
+    // which differ only in their immediate offsets.
+    struct AccessGroup
+    {
+        IRInst* buffer = nullptr;
+        IRInst* baseOffset = nullptr;
+        IRType* type = nullptr;
+        List<IRInst*> insts;
+        List<IRIntegerValue> immediateOffsets;
+    };
+
+    void coalesceAccessesRec(IRInst* inst)
+    {
+        if (auto block = as<IRBlock>(inst))
+        {
+            coalesceAccessesInBlock(block);
+            return;
+        }
+        for (auto child : inst->getChildren())
+            coalesceAccessesRec(child);
+    }
+
+    bool isCoalescableType(IRType* type)
+    {
+        switch (type->getOp())
+        {
+        case kIROp_UIntType:
+            return true;
+        case kIROp_IntType:
+        case kIROp_FloatType:
+            return !m_options.useBitCastFromUInt;
+        default:
+            return false;
+        }
+    }
+
+    // Split `offset` into a base and a constant immediate offset.
+    void splitOffset(IRInst* offset, IRInst*& outBase, IRIntegerValue& outImmediate)
+    {
+        outBase = offset;
+        outImmediate = 0;
+        if (auto lit = as<IRIntLit>(offset))
+        {
+            outBase = nullptr;
+            outImmediate = lit->getValue();
+        }
+        else if (offset->getOp() == kIROp_Add)
+        {
+            if (auto lit = as<IRIntLit>(offset->getOperand(1)))
+            {
+                outBase = offset->getOperand(0);
+                outImmediate = lit->getValue();
+            }
+        }
+    }
+
+    // Does `inst`, accessing a value of `type`, belong in `group`?
+    bool isInGroup(AccessGroup const& group, IRInst* inst, IRType* type)
+    {
+        IRInst* baseOffset = nullptr;
+        IRIntegerValue immediateOffset = 0;
+        splitOffset(inst->getOperand(1), baseOffset, immediateOffset);
+        return group.buffer == inst->getOperand(0) && group.baseOffset == baseOffset &&
+               group.type == type;
+    }
+
+    // Add `inst` to the group for its buffer, base offset and type, creating the group if
+    // needed. Returns false, without adding it, if the group already has an access to the
+    // same offset.
+    bool addToGroup(List<AccessGroup>& groups, IRInst* inst, IRType* type)
+    {
+        IRInst* baseOffset = nullptr;
+        IRIntegerValue immediateOffset = 0;
+        splitOffset(inst->getOperand(1), baseOffset, immediateOffset);
+        auto buffer = inst->getOperand(0);
+        for (auto& group : groups)
+        {
+            if (!isInGroup(group, inst, type))
+                continue;
+            if (group.immediateOffsets.contains(immediateOffset))
+                return false;
+            group.insts.add(inst);
+            group.immediateOffsets.add(immediateOffset);
+            return true;
+        }
+        AccessGroup group;
+        group.buffer = buffer;
+        group.baseOffset = baseOffset;
+        group.type = type;
+        group.insts.add(inst);
+        group.immediateOffsets.add(immediateOffset);
+        groups.add(group);
+        return true;
+    }
+
+    // Find the runs of accesses in `group` at consecutive offsets, and call `coalesce`
+    // with each run of two to four accesses, in offset order.
+    template<typename F>
+    void forEachRun(AccessGroup& group, F const& coalesce)
+    {
+        List<Index> order;
+        for (Index i = 0; i < group.insts.getCount(); i++)
+            order.add(i);
+        order.sort([&](Index a, Index b)
+                   { return group.immediateOffsets[a] < group.immediateOffsets[b]; });
+
+        List<IRInst*> run;
+        IRIntegerValue runStart = 0;
+        auto flushRun = [&]()
+        {
+            if (run.getCount() >= 2)
+                coalesce(run, runStart);
+            run.clear();
+        };
+        for (auto i : order)
+        {
+            auto offset = group.immediateOffsets[i];
+            if (run.getCount() == 4 || (run.getCount() && offset != runStart + 4 * run.getCount()))
+                flushRun();
+            if (run.getCount() == 0)
+                runStart = offset;
+            run.add(group.insts[i]);
+        }
+        flushRun();
+    }
+
+    IRInst* emitRunOffset(AccessGroup const& group, IRInst* originalOffset, IRIntegerValue offset)
+    {
+        if (!group.baseOffset)
+            return m_builder.getIntValue(originalOffset->getDataType(), offset);
+        return emitOffsetAddIfNeeded(group.baseOffset, offset);
+    }
+
+    void coalesceLoads(AccessGroup& group)
+    {
+        forEachRun(
+            group,
+            [&](List<IRInst*> const& run, IRIntegerValue runStart)
+            {
+                // The loads are merged at the first of them in the block, which all of
+                // their operands are available at since they share a buffer and base.
+                IRInst* first = run[0];
+                for (auto load : run)
+                {
+                    for (auto inst = load->getNextInst(); inst; inst = inst->getNextInst())
+                    {
+                        if (inst == first)
+                        {
+                            first = load;
+                            break;
+                        }
+                    }
+                }
+
+                m_builder.setInsertBefore(first);
+                auto vectorType = m_builder.getVectorType(group.type, run.getCount());
+                IRInst* args[] = {
+                    group.buffer,
+                    emitRunOffset(group, first->getOperand(1), runStart)};
+                auto vectorLoad = m_builder.emitIntrinsicInst(
+                    vectorType,
+                    kIROp_ByteAddressBufferLoad,
+                    2,
+                    args);
+                for (Index i = 0; i < run.getCount(); i++)
+                {
+                    m_builder.setInsertBefore(run[i]);
+                    run[i]->replaceUsesWith(m_builder.emitElementExtract(vectorLoad, i));
+                    run[i]->removeAndDeallocate();
+                }
+            });
+    }
+
+    void coalesceStores(AccessGroup& group)
+    {
+        forEachRun(
+            group,
+            [&](List<IRInst*> const& run, IRIntegerValue runStart)
+            {
+                // The stores are merged at the last of them in the block, where all of the
+                // stored values are available.
+                IRInst* last = run[0];
+                for (auto store : run)
+                {
+                    for (auto inst = last->getNextInst(); inst; inst = inst->getNextInst())
+                    {
+                        if (inst == store)
+                        {
+                            last = store;
+                            break;
+                        }
+                    }
+                }
+
+                m_builder.setInsertBefore(last);
+                List<IRInst*> values;
+                for (auto store : run)
+                    values.add(store->getOperand(store->getOperandCount() - 1));
+                auto vectorType = m_builder.getVectorType(group.type, run.getCount());
+                auto vectorValue = m_builder.emitMakeVector(vectorType, values);
+                m_builder.emitByteAddressBufferStore(
+                    group.buffer,
+                    emitRunOffset(group, last->getOperand(1), runStart),
+                    vectorValue);
+                for (auto store : run)
+                    store->removeAndDeallocate();
+            });
+    }
+
+    void coalesceAccessesInBlock(IRBlock* block)
+    {
+        // Loads can be merged as long as nothing between them writes memory, and stores as
+        // long as nothing between them reads or writes the buffers.
+        List<AccessGroup> loadGroups;
+        List<AccessGroup> storeGroups;
+        auto flushLoads = [&]()
+        {
+            for (auto& group : loadGroups)
+                coalesceLoads(group);
+            loadGroups.clear();
+        };
+        auto flushStores = [&]()
+        {
+            for (auto& group : storeGroups)
+                coalesceStores(group);
+            storeGroups.clear();
+        };
+
+        for (auto inst = block->getFirstInst(); inst;)
+        {
+            // Coalescing removes insts before `next`, but never `next` itself.
+            auto next = inst->getNextInst();
+            switch (inst->getOp())
+            {
+            case kIROp_ByteAddressBufferLoad:
+                flushStores();
+                if (!isCoalescableType(inst->getDataType()))
+                    break;
+                if (!addToGroup(loadGroups, inst, inst->getDataType()))
+                {
+                    flushLoads();
+                    addToGroup(loadGroups, inst, inst->getDataType());
+                }
+                break;
+            case kIROp_ByteAddressBufferStore:
+                {
+                    flushLoads();
+                    auto valueType = inst->getOperand(inst->getOperandCount() - 1)->getDataType();
+                    IRInst* baseOffset = nullptr;
+                    IRIntegerValue immediateOffset = 0;
+                    splitOffset(inst->getOperand(1), baseOffset, immediateOffset);
+                    if (!isCoalescableType(valueType) || immediateOffset % 4 != 0)
+                    {
+                        flushStores();
+                        break;
+                    }
+                    // Merged stores move to the last store of their run, so they must not
+                    // move past a store that might overlap them. Only one group of stores
+                    // is open at a time, and a second store to an offset closes it.
+                    if (storeGroups.getCount() && !isInGroup(storeGroups[0], inst, valueType))
+                        flushStores();
+                    if (!addToGroup(storeGroups, inst, valueType))
+                    {
+                        flushStores();
+                        addToGroup(storeGroups, inst, valueType);
+                    }
+                }
+                break;
+            default:
+                if (inst->mightHaveSideEffects())
+                {
+                    flushLoads();
+                    flushStores();
+                }
+                break;
+            }
+            inst = next;
+        }
+        flushLoads();
+        flushStores();
+    }
+
     Result emitLegalSequenceStore(
         IRInst* buffer,
         IRInst* baseOffset,
@@ -15,6 +15,10 @@ struct ByteAddressBufferLegalizationOptions
     bool translateToStructuredBufferOps = false;
     bool lowerBasicTypeOps = false;
 
+    /// Merge adjacent scalar 32-bit loads and stores into vector loads and stores. Only valid
+    /// for targets where a vector access needs no more than its element type's alignment.
+    bool coalesceScalarLoadStore = false;
+
     /// Causes all calls to `getEquivlentStructuredBuffer` to return a `ByteAddressBuffer` (this)
     /// instead of a `StructuredBuffer`. This option is used for targets that do not distinctly
     /// define `ByteAddressBuffer`/`StructuredBuffer` and introduce operations which prevent DCE
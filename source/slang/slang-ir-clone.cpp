@@ -316,6 +316,20 @@ static void _cloneInstDecorationsAndChildren(
     }
 }
 
+// Count the decorations and children of `inst`, recursively.
+//
+static Index _countDecorationsAndChildren(IRInst* inst)
+{
+    Index count = 0;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        count++;
+        if (child->getFirstDecorationOrChild())
+            count += _countDecorationsAndChildren(child);
+    }
+    return count;
+}
+
 // The public version of `cloneInstDecorationsAndChildren` is then
 // just a wrapper over the internal one that sets up a temporary
 // environment to use for the cloning process when `env->squashChildrenMapping` is false (default),
@@ -343,6 +357,18 @@ void cloneInstDecorationsAndChildren(
         subEnv = &subEnvStorage;
         subEnv->parent = env;
     }
+
+    // Cloning a function or generic registers a replacement for every
+    // instruction in its body. Specialization and autodiff do this for
+    // whole functions over and over, so we size the map once up front
+    // instead of letting it grow (and rehash) one block at a time.
+    //
+    if (as<IRGlobalValueWithCode>(oldInst))
+    {
+        auto& map = subEnv->mapOldValToNew;
+        map.reserve(Index(map.getCount()) + _countDecorationsAndChildren(oldInst));
+    }
+
     _cloneInstDecorationsAndChildren(subEnv, module, oldInst, newInst);
 }
 
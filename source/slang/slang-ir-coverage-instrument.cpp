@@ -379,6 +379,7 @@ struct CoverageInstrumenter
     IRModule* module;
     IRGlobalParam* coverageBuffer;
     SourceManager* sourceManager;
+    SlangCoverageMode mode;
     ArtifactPostEmitMetadata& outMetadata;
     IRType* uintType;
     IRType* uintPtrType;
@@ -388,8 +389,9 @@ struct CoverageInstrumenter
         IRModule* m,
         IRGlobalParam* buf,
         SourceManager* sm,
+        SlangCoverageMode mo,
         ArtifactPostEmitMetadata& md)
-        : module(m), coverageBuffer(buf), sourceManager(sm), outMetadata(md)
+        : module(m), coverageBuffer(buf), sourceManager(sm), mode(mo), outMetadata(md)
     {
         IRBuilder tmpBuilder(module);
         uintType = tmpBuilder.getUIntType();
@@ -398,8 +400,8 @@ struct CoverageInstrumenter
     }
 
     // Lower a single IncrementCoverageCounter op to an atomic add on
-    // `coverageBuffer[slot]`. Appends a metadata entry for `slot` and
-    // removes the op.
+    // `coverageBuffer[slot]`, or to a plain store of 1 in hit mode.
+    // Appends a metadata entry for `slot` and removes the op.
     void lowerCounterOp(IRInst* counterOp, UInt slot)
     {
         CoverageTracingEntry entry;
@@ -419,16 +421,27 @@ struct CoverageInstrumenter
             2,
             getElemArgs);
 
-        // Emit `AtomicAdd(slotPtr, 1, relaxed)` — lowered by each
-        // backend emitter to its native atomic-increment idiom
-        // (InterlockedAdd on HLSL, atomicAdd on GLSL, OpAtomicIAdd on
-        // SPIR-V, etc.). Correct under GPU concurrency.
-        IRInst* atomicArgs[] = {
-            slotPtr,
-            builder.getIntValue(uintType, 1),
-            builder.getIntValue(intType, (IRIntegerValue)kIRMemoryOrder_Relaxed),
-        };
-        builder.emitIntrinsicInst(uintType, kIROp_AtomicAdd, 3, atomicArgs);
+        if (mode == SLANG_COVERAGE_MODE_HIT)
+        {
+            // Every thread that reaches the statement writes the same
+            // value, so racing plain stores still leave the slot at 1.
+            // This skips the serialization an atomic on a shared slot
+            // costs when a whole wave executes the same statement.
+            builder.emitStore(slotPtr, builder.getIntValue(uintType, 1));
+        }
+        else
+        {
+            // Emit `AtomicAdd(slotPtr, 1, relaxed)` — lowered by each
+            // backend emitter to its native atomic-increment idiom
+            // (InterlockedAdd on HLSL, atomicAdd on GLSL, OpAtomicIAdd on
+            // SPIR-V, etc.). Correct under GPU concurrency.
+            IRInst* atomicArgs[] = {
+                slotPtr,
+                builder.getIntValue(uintType, 1),
+                builder.getIntValue(intType, (IRIntegerValue)kIRMemoryOrder_Relaxed),
+            };
+            builder.emitIntrinsicInst(uintType, kIROp_AtomicAdd, 3, atomicArgs);
+        }
 
         // The counter op has void return type and, by construction, no uses.
         // Catch a future IR transform that takes a use of it before we reach
@@ -458,6 +471,7 @@ void instrumentCoverage(
     bool enabled,
     int explicitBinding,
     int explicitSpace,
+    SlangCoverageMode mode,
     TargetRequest* targetRequest,
     IRVarLayout*& globalScopeVarLayout,
     ArtifactPostEmitMetadata& outMetadata)
@@ -485,10 +499,11 @@ void instrumentCoverage(
     // and fails WGSL validation at the `atomicAdd` call. Until the
     // synthesized type is wrapped in `Atomic<...>` for WGSL targets,
     // skip instrumentation with a clear warning rather than emitting
-    // invalid WGSL. Other backends are unaffected. (For WebGPU
-    // workflows that need coverage today, `-target spirv` works via
-    // the SPIR-V → WebGPU path.)
-    if (isWGPUTarget(targetRequest))
+    // invalid WGSL. Other backends are unaffected, and so is hit mode,
+    // which only stores. (For WebGPU workflows that need execution
+    // counts today, `-target spirv` works via the SPIR-V → WebGPU
+    // path.)
+    if (isWGPUTarget(targetRequest) && mode != SLANG_COVERAGE_MODE_HIT)
     {
         if (sink)
             sink->diagnose(Diagnostics::CoverageTargetNotSupported{});
@@ -584,11 +599,13 @@ void instrumentCoverage(
 
     outMetadata.m_coverageBufferSpace = chosenSpace;
     outMetadata.m_coverageBufferBinding = chosenBinding;
+    outMetadata.m_coverageMode = mode;
 
     CoverageInstrumenter instrumenter(
         module,
         buffer,
         sink ? sink->getSourceManager() : nullptr,
+        mode,
         outMetadata);
     instrumenter.run(counterOps);
 }
@@ -1,6 +1,8 @@
 #ifndef SLANG_IR_COVERAGE_INSTRUMENT_H
 #define SLANG_IR_COVERAGE_INSTRUMENT_H
 
+#include "slang.h"
+
 namespace Slang
 {
 struct IRModule;
@@ -18,14 +20,15 @@ class ArtifactPostEmitMetadata;
 // extends the program-scope var layout so the buffer participates in
 // `collectGlobalUniformParameters` packaging on targets that need it
 // (CPU, CUDA), assigns one counter slot per `IncrementCoverageCounter`
-// op, and rewrites each op into an atomic add on its slot. The pass
+// op, and rewrites each op into an atomic add on its slot (or, under
+// `SLANG_COVERAGE_MODE_HIT`, a plain store of 1 to it). The pass
 // writes the resulting `(slot → file, line)` mapping and the chosen
 // buffer binding into `outMetadata` so hosts can query it via
 // `ICoverageTracingMetadata`.
 //
 // `explicitBinding` / `explicitSpace` are the values supplied by
 // `-trace-coverage-binding`; pass `-1` for either to request auto-
-// allocation.
+// allocation. `mode` is the value of `-trace-coverage-mode`.
 //
 // `globalScopeVarLayout` is taken by reference: when the pass extends
 // the program-scope layout to include the synthesized buffer, it
@@ -42,6 +45,7 @@ void instrumentCoverage(
     bool enabled,
     int explicitBinding,
     int explicitSpace,
+    SlangCoverageMode mode,
     TargetRequest* targetRequest,
     IRVarLayout*& globalScopeVarLayout,
     ArtifactPostEmitMetadata& outMetadata);
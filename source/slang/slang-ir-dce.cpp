@@ -2,6 +2,7 @@
 #include "slang-ir-dce.h"
 
 #include "slang-ir-insts.h"
+#include "slang-ir-pass-scratch.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
 
@@ -53,7 +54,7 @@ struct DeadCodeEliminationContext
     // looked at their impact on other
     // instructions.
     //
-    List<IRInst*> workList;
+    ScratchList<IRInst*> workList;
 
     // When we discover that an instruction seems
     // to be live, we will add it to our set,
@@ -224,6 +225,58 @@ struct DeadCodeEliminationContext
     //
     bool processModule() { return processInst(module->getModuleInst()); }
 
+    // The incremental alternative to `processInst` doesn't compute liveness
+    // at all. An instruction without any uses that would not be kept alive
+    // by its parent being alive is dead, whether its parent is live or not,
+    // so we can remove such instructions from the module's list of possibly
+    // dead instructions directly. Removing one clears the uses of its operands,
+    // which adds any of them that lost their last use to the same list.
+    //
+    bool processPossiblyDeadInsts(IRInst* root)
+    {
+        bool result = false;
+
+        auto& possiblyDeadInsts = module->getPossiblyDeadInsts();
+        List<IRInst*> instsOutsideRoot;
+        while (possiblyDeadInsts.getCount())
+        {
+            auto inst = possiblyDeadInsts.getLast();
+            possiblyDeadInsts.removeLast();
+
+            // Skip instructions that have been removed, or that have been used again.
+            //
+            if (!inst->getParent() || inst->hasUses())
+                continue;
+
+            if (!isChildInstOf(inst, root) || inst == root)
+            {
+                instsOutsideRoot.add(inst);
+                continue;
+            }
+
+            // Removing parameters would need their phi arguments to be removed too,
+            // so they are left for the full pass, along with anything that should
+            // stay alive for its own sake.
+            //
+            if (inst->getOp() == kIROp_Param || as<IRDecoration>(inst) ||
+                shouldInstBeLiveIfParentIsLive(inst))
+                continue;
+
+            for (auto parent = inst->getParent(); parent; parent = parent->getParent())
+            {
+                if (auto code = as<IRGlobalValueWithCode>(parent))
+                {
+                    module->invalidateAnalysisForInst(code);
+                    break;
+                }
+            }
+            inst->removeAndDeallocate();
+            result = true;
+        }
+        possiblyDeadInsts.addRange(instsOutsideRoot);
+        return result;
+    }
+
     bool eliminateDeadInstsRec(IRInst* inst)
     {
         bool changed = false;
@@ -283,7 +336,7 @@ struct DeadCodeEliminationContext
             // We need to cache all children in a work list to ensure they are
             // properly traversed.
             //
-            List<IRInst*> children;
+            ScratchList<IRInst*> children;
             for (auto child : inst->getDecorationsAndChildren())
                 children.add(child);
             for (IRInst* child : children)
@@ -675,21 +728,39 @@ bool isWeakReferenceOperand(IRInst* inst, UInt operandIndex)
 
 // The top-level function for invoking the DCE pass
 // is straighforward. We set up the context object
-// and then defer to it for the real work.
+// and then defer to it for the real work. The work
+// lists of the context come out of a scratch arena
+// that lives for the duration of the pass.
 //
 bool eliminateDeadCode(IRModule* module, IRDeadCodeEliminationOptions const& options)
 {
+    PassScratch scratch;
     DeadCodeEliminationContext context;
     context.module = module;
     context.options = options;
-    return context.processModule();
+
+    if (options.onlyPossiblyDeadInsts && module->isTrackingPossiblyDeadInsts())
+        return context.processPossiblyDeadInsts(module->getModuleInst());
+
+    bool result = context.processModule();
+
+    // After a full pass over the whole module, nothing that was tracked can be
+    // dead any more.
+    //
+    module->getPossiblyDeadInsts().clear();
+    return result;
 }
 
 bool eliminateDeadCode(IRInst* root, IRDeadCodeEliminationOptions const& options)
 {
+    PassScratch scratch;
     DeadCodeEliminationContext context;
     context.module = root->getModule();
     context.options = options;
+
+    if (options.onlyPossiblyDeadInsts && context.module->isTrackingPossiblyDeadInsts())
+        return context.processPossiblyDeadInsts(root);
+
     return context.processInst(root);
 }
 
@@ -13,6 +13,16 @@ struct IRDeadCodeEliminationOptions
     bool keepLayoutsAlive = false;
     bool useFastAnalysis = false;
     bool keepGlobalParamsAlive = true;
+
+    /// When the module is tracking possibly dead instructions (see
+    /// `IRModule::beginTrackingPossiblyDeadInsts`), only remove the tracked instructions
+    /// that have no uses left, and the ones whose last use goes away as a result, instead
+    /// of analyzing everything under the root.
+    ///
+    /// This finds less dead code than a full pass (for example, it never removes
+    /// instructions that only use each other), so a full pass should still follow a
+    /// series of these.
+    bool onlyPossiblyDeadInsts = false;
 };
 
 /// Eliminate "dead" code from the given IR module.
@@ -32,6 +42,19 @@ bool eliminateDeadCode(
 
 bool shouldInstBeLiveIfParentIsLive(IRInst* inst, IRDeadCodeEliminationOptions options);
 
+/// Keeps `module` tracking possibly dead instructions while in scope.
+struct IRPossiblyDeadInstTrackingScope
+{
+    IRPossiblyDeadInstTrackingScope(IRModule* module)
+        : m_module(module)
+    {
+        m_module->beginTrackingPossiblyDeadInsts();
+    }
+    ~IRPossiblyDeadInstTrackingScope() { m_module->endTrackingPossiblyDeadInsts(); }
+
+    IRModule* m_module;
+};
+
 bool isWeakReferenceOperand(IRInst* inst, UInt operandIndex);
 
 bool trimOptimizableTypes(IRModule* module);
@@ -91,6 +91,92 @@ bool isTypePreferrableToDeferLoad(CodeGenContext* codeGenContext, IRType* type)
     return true;
 }
 
+// Calls are followed this many levels deep when working out which parts of a value are used.
+static const int kMaxFieldUsageCallDepth = 4;
+
+static bool getNaturalSize(TargetRequest* targetReq, IRType* type, IRIntegerValue& outSize)
+{
+    IRSizeAndAlignment sizeAlignment = {};
+    if (SLANG_FAILED(getNaturalSizeAndAlignment(targetReq, type, &sizeAlignment)))
+        return false;
+    outSize = sizeAlignment.size;
+    return true;
+}
+
+// Estimate how many of the `size` bytes of `value` are read. Field and constant-index element
+// extracts only read their part of the value, and a value passed to a function only reads the
+// parts that the function's parameter reads. Any other use reads the whole value.
+static IRIntegerValue getUsedSize(
+    TargetRequest* targetReq,
+    IRInst* value,
+    IRIntegerValue size,
+    int depth)
+{
+    // The bytes read through each field key or constant index.
+    Dictionary<IRInst*, IRIntegerValue> usedParts;
+    IRIntegerValue usedByCalls = 0;
+    for (auto use = value->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        switch (user->getOp())
+        {
+        case kIROp_GetElement:
+        case kIROp_FieldExtract:
+            {
+                if (use != user->getOperands())
+                    return size;
+                auto selector = user->getOperand(1);
+                if (user->getOp() == kIROp_GetElement && !as<IRIntLit>(selector))
+                    return size;
+                IRIntegerValue partSize = 0;
+                if (!getNaturalSize(targetReq, user->getDataType(), partSize))
+                    return size;
+                auto used = getUsedSize(targetReq, user, partSize, depth);
+                if (auto existing = usedParts.tryGetValue(selector))
+                    used = Math::Max(used, *existing);
+                usedParts[selector] = used;
+            }
+            break;
+        case kIROp_Call:
+            {
+                auto call = as<IRCall>(user);
+                auto callee = as<IRFunc>(call->getCallee());
+                if (depth >= kMaxFieldUsageCallDepth || !callee || !callee->isDefinition() ||
+                    use == &call->getOperands()[0])
+                    return size;
+                UInt argIndex = 0;
+                for (auto param : callee->getParams())
+                {
+                    if (argIndex >= call->getArgCount())
+                        return size;
+                    if (call->getArg(argIndex) == value)
+                        usedByCalls += getUsedSize(targetReq, param, size, depth + 1);
+                    argIndex++;
+                }
+            }
+            break;
+        default:
+            return size;
+        }
+    }
+
+    IRIntegerValue total = usedByCalls;
+    for (const auto& [_, used] : usedParts)
+        total += used;
+    return Math::Min(total, size);
+}
+
+bool isValueSparselyUsed(CodeGenContext* codeGenContext, IRInst* value)
+{
+    auto targetReq = codeGenContext->getTargetReq();
+    IRIntegerValue size = 0;
+    if (!getNaturalSize(targetReq, value->getDataType(), size))
+        return false;
+    if (size <= kBufferLoadElementSizeSpecializationMinThreshold)
+        return false;
+    return getUsedSize(targetReq, value, size, 0) * 2 <= size;
+}
+
 // Returns true if memory loaded by `loadInst` is not modified before `userInst` after it is
 // loaded.
 // This method currently implements a conservative approach that observes all
@@ -225,9 +311,11 @@ struct DeferBufferLoadContext
             }
         }
 
-        // Don't defer the load anymore if the type is simple.
+        // Don't defer the load anymore if the type is simple, unless most of the loaded value
+        // goes unused.
         if (failDueToAttributeFound ||
-            !isTypePreferrableToDeferLoad(codeGenContext, loadInst->getDataType()))
+            (!isTypePreferrableToDeferLoad(codeGenContext, loadInst->getDataType()) &&
+             !isValueSparselyUsed(codeGenContext, loadInst)))
         {
             return;
         }
@@ -30,6 +30,11 @@ void deferBufferLoad(IRModule* module, CodeGenContext* context);
 // Generally, we want to defer loading large structs or composites that contain arrays.
 bool isTypePreferrableToDeferLoad(CodeGenContext* context, IRType* type);
 
+// Returns true if no more than half of `value` is read, counting the fields read by the
+// functions it is passed to. Loads of such values are worth deferring even if their type
+// is small enough that `isTypePreferrableToDeferLoad` returns false.
+bool isValueSparselyUsed(CodeGenContext* context, IRInst* value);
+
 // Returns true if memory loaded by `loadInst` may be modified before `userInst` after it is
 // loaded.
 bool isMemoryLocationUnmodifiedBetweenLoadAndUser(
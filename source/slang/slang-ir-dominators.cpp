@@ -354,6 +354,7 @@ void computePostorder(
     HashSet<IRBlock*>& outReachableSet,
     bool mirrored)
 {
+    outOrder.clear();
     PostorderComputationContext context;
     context.order = &outOrder;
 
@@ -363,22 +364,34 @@ void computePostorder(
     if (code->getFirstBlock())
         context.walk(code->getFirstBlock(), getSuccessors);
 
-    // Append unvisited blocks (unreachable blocks) to the begining of postOrder.
-    List<IRBlock*> prefix;
+    // Put the unvisited (unreachable) blocks at the beginning of the order. There usually
+    // aren't any, so the order is shifted in place rather than rebuilt.
+    Index unreachableCount = 0;
     for (auto block : code->getBlocks())
     {
         if (!context.visited.contains(block))
+            unreachableCount++;
+    }
+    if (unreachableCount)
+    {
+        Index reachableCount = outOrder.getCount();
+        outOrder.setCount(reachableCount + unreachableCount);
+        for (Index i = reachableCount; i-- > 0;)
+            outOrder[i + unreachableCount] = outOrder[i];
+
+        Index index = 0;
+        for (auto block : code->getBlocks())
         {
-            prefix.add(block);
+            if (!context.visited.contains(block))
+                outOrder[index++] = block;
         }
     }
-    prefix.addRange(outOrder);
-    outOrder = _Move(prefix);
     outReachableSet = _Move(context.visited);
 }
 
 void computePostorderOnReverseCFG(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
 {
+    outOrder.clear();
     PostorderComputationContext context;
     context.order = &outOrder;
     for (auto block = code->getLastBlock(); block; block = block->getPrevBlock())
@@ -862,4 +875,11 @@ RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code)
     return context.createDominatorTree(code);
 }
 
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code)
+{
+    if (auto module = code->getModule())
+        return module->findOrCreateDominatorTree(code);
+    return computeDominatorTree(code);
+}
+
 } // namespace Slang
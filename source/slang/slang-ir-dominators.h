@@ -167,6 +167,14 @@ private:
 
 RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code);
 
+/// Get the dominator tree of `code`, reusing the one cached by the module of `code`
+/// when the control-flow graph of `code` has not changed since it was computed.
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code);
+
+// The `compute*` functions below replace the contents of `outOrder`, so a pass that walks
+// many functions can reuse one list, such as one from the module's `ContainerPool`, instead
+// of allocating a new list for each function as the `get*` functions do.
+
 void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 void computeMirroredPostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 void computePostorder(
@@ -176,6 +184,26 @@ void computePostorder(
     bool mirrored = false);
 void computePostorderOnReverseCFG(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 
+inline void computeReversePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
+{
+    computePostorder(code, outOrder);
+    outOrder.reverse();
+}
+
+inline void computeReverseMirroredPostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
+{
+    computeMirroredPostorder(code, outOrder);
+    outOrder.reverse();
+}
+
+inline void computeReversePostorderOnReverseCFG(
+    IRGlobalValueWithCode* code,
+    List<IRBlock*>& outOrder)
+{
+    computePostorderOnReverseCFG(code, outOrder);
+    outOrder.reverse();
+}
+
 inline List<IRBlock*> getPostorder(IRGlobalValueWithCode* code)
 {
     List<IRBlock*> result;
@@ -193,24 +221,21 @@ inline List<IRBlock*> getPostorderOnReverseCFG(IRGlobalValueWithCode* code)
 inline List<IRBlock*> getReversePostorder(IRGlobalValueWithCode* code)
 {
     List<IRBlock*> result;
-    computePostorder(code, result);
-    result.reverse();
+    computeReversePostorder(code, result);
     return result;
 }
 
 inline List<IRBlock*> getReverseMirroredPostorder(IRGlobalValueWithCode* code)
 {
     List<IRBlock*> result;
-    computeMirroredPostorder(code, result);
-    result.reverse();
+    computeReverseMirroredPostorder(code, result);
     return result;
 }
 
 inline List<IRBlock*> getReversePostorderOnReverseCFG(IRGlobalValueWithCode* code)
 {
     List<IRBlock*> result;
-    computePostorderOnReverseCFG(code, result);
-    result.reverse();
+    computeReversePostorderOnReverseCFG(code, result);
     return result;
 }
 } // namespace Slang
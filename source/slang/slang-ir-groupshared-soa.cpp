@@ -0,0 +1,190 @@
+// slang-ir-groupshared-soa.cpp
+#include "slang-ir-groupshared-soa.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct GroupSharedSoAContext
+{
+    IRModule* module;
+
+    // Get the struct type of the elements of `var` if it is a `groupshared` array of
+    // structs that can be split.
+    IRStructType* getSplittableElementType(IRGlobalVar* var)
+    {
+        if (!as<IRGroupSharedRate>(var->getRate()) || var->getFirstBlock())
+            return nullptr;
+        auto varType = as<IRPtrTypeBase>(var->getDataType());
+        if (!varType)
+            return nullptr;
+        auto arrayType = as<IRArrayType>(varType->getValueType());
+        if (!arrayType || arrayType->getArrayStride())
+            return nullptr;
+        auto structType = as<IRStructType>(arrayType->getElementType());
+        if (!structType)
+            return nullptr;
+
+        // There is nothing to gain from splitting a struct with a single field.
+        Index fieldCount = 0;
+        for (auto field : structType->getFields())
+        {
+            SLANG_UNUSED(field);
+            fieldCount++;
+        }
+        if (fieldCount < 2)
+            return nullptr;
+        return structType;
+    }
+
+    // Is every use of `val` the base operand of an inst with opcode `op`?
+    static bool isOnlyUsedAsBaseOf(IRInst* val, IROp op)
+    {
+        for (auto use = val->firstUse; use; use = use->nextUse)
+        {
+            if (use->getUser()->getOp() != op || use != use->getUser()->getOperands())
+                return false;
+        }
+        return true;
+    }
+
+    // Is every use of `var` an element address that is only used to access a single field,
+    // either through a field address, or by loading the element and extracting a field?
+    bool isOnlyAccessedByField(IRGlobalVar* var)
+    {
+        if (!isOnlyUsedAsBaseOf(var, kIROp_GetElementPtr))
+            return false;
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto elementPtr = use->getUser();
+            for (auto elementUse = elementPtr->firstUse; elementUse;
+                 elementUse = elementUse->nextUse)
+            {
+                auto user = elementUse->getUser();
+                if (user->getOp() == kIROp_Load)
+                {
+                    if (!isOnlyUsedAsBaseOf(user, kIROp_FieldExtract))
+                        return false;
+                }
+                else if (user->getOp() != kIROp_FieldAddress || elementUse != user->getOperands())
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void addFieldNameHint(
+        IRBuilder& builder,
+        IRGlobalVar* var,
+        IRStructField* field,
+        IRInst* fieldVar)
+    {
+        auto nameHint = var->findDecoration<IRNameHintDecoration>();
+        auto keyNameHint = field->getKey()->findDecoration<IRNameHintDecoration>();
+        if (!nameHint || !keyNameHint)
+            return;
+        StringBuilder name;
+        name << nameHint->getName() << "_" << keyNameHint->getName();
+        builder.addNameHintDecoration(fieldVar, name.getUnownedSlice());
+    }
+
+    bool trySplitVar(IRGlobalVar* var)
+    {
+        auto structType = getSplittableElementType(var);
+        if (!structType || !isOnlyAccessedByField(var))
+            return false;
+
+        auto varType = as<IRPtrTypeBase>(var->getDataType());
+        auto arrayType = as<IRArrayType>(varType->getValueType());
+
+        // Declare one array per field, with the same element count, address space and
+        // rate as the original.
+        IRBuilder builder(module);
+        builder.setInsertBefore(var);
+        Dictionary<IRStructKey*, IRGlobalVar*> mapKeyToFieldVar;
+        for (auto field : structType->getFields())
+        {
+            auto fieldArrayType =
+                builder.getArrayType(field->getFieldType(), arrayType->getElementCount());
+            IRType* fieldVarType = builder.getPtrTypeWithAddressSpace(fieldArrayType, varType);
+            if (auto rateType = as<IRRateQualifiedType>(var->getFullType()))
+                fieldVarType = builder.getRateQualifiedType(rateType->getRate(), fieldVarType);
+
+            auto fieldVar = builder.createGlobalVar(fieldArrayType);
+            fieldVar->setFullType(fieldVarType);
+            fieldVar->sourceLoc = var->sourceLoc;
+            addFieldNameHint(builder, var, field, fieldVar);
+            mapKeyToFieldVar.add(field->getKey(), fieldVar);
+        }
+
+        // Rewrite each `var[i].field` as `fieldVar[i]`. Each user is removed, so the use
+        // lists are walked from their head until they are empty.
+        while (auto use = var->firstUse)
+        {
+            auto elementPtr = as<IRGetElementPtr>(use->getUser());
+            auto index = elementPtr->getIndex();
+            while (auto elementUse = elementPtr->firstUse)
+            {
+                auto user = elementUse->getUser();
+                if (auto fieldAddr = as<IRFieldAddress>(user))
+                {
+                    // Keep the type of the original field address.
+                    auto fieldVar =
+                        mapKeyToFieldVar.getValue(as<IRStructKey>(fieldAddr->getField()));
+                    builder.setInsertBefore(fieldAddr);
+                    auto newAddr =
+                        builder.emitElementAddress(fieldAddr->getFullType(), fieldVar, index);
+                    fieldAddr->replaceUsesWith(newAddr);
+                }
+                else
+                {
+                    // A load of the whole element becomes a load of each field that is
+                    // extracted from it, at the same point.
+                    builder.setInsertBefore(user);
+                    while (auto loadUse = user->firstUse)
+                    {
+                        auto fieldExtract = as<IRFieldExtract>(loadUse->getUser());
+                        auto fieldVar =
+                            mapKeyToFieldVar.getValue(as<IRStructKey>(fieldExtract->getField()));
+                        auto newVal = builder.emitLoad(builder.emitElementAddress(fieldVar, index));
+                        fieldExtract->replaceUsesWith(newVal);
+                        fieldExtract->removeAndDeallocate();
+                    }
+                }
+                user->removeAndDeallocate();
+            }
+            elementPtr->removeAndDeallocate();
+        }
+        var->removeAndDeallocate();
+        return true;
+    }
+
+    bool processModule()
+    {
+        List<IRGlobalVar*> vars;
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto var = as<IRGlobalVar>(inst))
+                vars.add(var);
+        }
+
+        bool changed = false;
+        for (auto var : vars)
+            changed |= trySplitVar(var);
+        return changed;
+    }
+};
+
+bool splitGroupSharedStructArrays(IRModule* module)
+{
+    GroupSharedSoAContext context;
+    context.module = module;
+    return context.processModule();
+}
+
+} // namespace Slang
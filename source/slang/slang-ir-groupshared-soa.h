@@ -0,0 +1,22 @@
+// slang-ir-groupshared-soa.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Split `groupshared` arrays of structs into one `groupshared` array per field.
+///
+/// In an array of structs, the same field of neighboring elements is a whole struct apart,
+/// so threads that read that field at consecutive indices hit the same few shared memory
+/// banks whenever the struct size shares a factor with the bank count. After the split,
+/// those threads read consecutive words instead.
+///
+/// An array is split only if every use of it selects an element and then a field of that
+/// element, as in `data[i].field`. Any other use, such as storing a whole element, using a
+/// loaded element as a whole or passing an element's address to a call, leaves the array as
+/// it is.
+///
+/// Returns true if any array was split.
+bool splitGroupSharedStructArrays(IRModule* module);
+} // namespace Slang
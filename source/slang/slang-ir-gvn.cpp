@@ -0,0 +1,279 @@
+// slang-ir-gvn.cpp
+#include "slang-ir-gvn.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// The number of blocks searched for writes between a load and an earlier access to the same
+// address. Past this, the load is left alone to bound compile time on very large functions.
+static const Index kMaxBlocksToSearch = 256;
+
+struct GlobalValueNumberingContext
+{
+    IRGlobalValueWithCode* func;
+    RefPtr<IRDominatorTree> dom;
+
+    // Returns true if `inst` is defined before the end of `block` on every path to it.
+    bool isAvailableAtEndOf(IRInst* inst, IRBlock* block)
+    {
+        if (!inst || !isChildInstOf(inst, func))
+            return true;
+        auto instBlock = as<IRBlock>(inst->getParent());
+        return instBlock && dom->dominates(instBlock, block);
+    }
+
+    // Loads are only considered if they are invocation scoped, and the address isn't one that
+    // other invocations are expected to write while this one runs.
+    bool isLoadOrStoreToForward(IRInst* inst)
+    {
+        if (inst->findAttr<IRMemoryScopeAttr>())
+            return false;
+        IRInst* ptr = inst->getOperand(0);
+        auto rootAddr = getRootAddr(ptr);
+        if (auto memoryQualifier = rootAddr->findDecoration<IRMemoryQualifierSetDecoration>())
+        {
+            if (memoryQualifier->getMemoryQualifierBit() &
+                (MemoryQualifierSetModifier::Flags::kCoherent |
+                 MemoryQualifierSetModifier::Flags::kVolatile))
+                return false;
+        }
+        return true;
+    }
+
+    // Collect the insts in `block` that could be hoisted into its predecessor: movable insts,
+    // and loads that come before anything in the block with a side effect.
+    void collectHoistCandidates(IRBlock* block, List<IRInst*>& outInsts)
+    {
+        bool seenSideEffect = false;
+        for (auto inst : block->getChildren())
+        {
+            if (as<IRLoad>(inst))
+            {
+                if (!seenSideEffect && isLoadOrStoreToForward(inst))
+                    outInsts.add(inst);
+            }
+            else if (isMovableInst(inst))
+            {
+                outInsts.add(inst);
+            }
+            else if (inst->mightHaveSideEffects())
+            {
+                seenSideEffect = true;
+            }
+        }
+    }
+
+    bool canHoistInto(IRInst* inst, IRBlock* block)
+    {
+        if (!isAvailableAtEndOf(inst->getFullType(), block))
+            return false;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (!isAvailableAtEndOf(inst->getOperand(i), block))
+                return false;
+        }
+        return true;
+    }
+
+    // If both sides of an `if`/`else` compute the same value, compute it once before the
+    // branch instead.
+    bool hoistCommonInstsFromBranches(IRBlock* block)
+    {
+        auto ifElse = as<IRIfElse>(block->getTerminator());
+        if (!ifElse)
+            return false;
+        auto trueBlock = ifElse->getTrueBlock();
+        auto falseBlock = ifElse->getFalseBlock();
+        if (trueBlock == falseBlock)
+            return false;
+        if (trueBlock->getPredecessors().getCount() != 1 ||
+            falseBlock->getPredecessors().getCount() != 1)
+            return false;
+
+        bool changed = false;
+        List<IRInst*> trueInsts;
+        collectHoistCandidates(trueBlock, trueInsts);
+        if (trueInsts.getCount() == 0)
+            return false;
+
+        // The keys of the false block's insts depend on their operands, which change when an
+        // inst they use is hoisted, so the map is rebuilt after each hoist.
+        Dictionary<IRInstKey, IRInst*> falseInsts;
+        bool falseInstsValid = false;
+        for (auto inst : trueInsts)
+        {
+            if (!canHoistInto(inst, block))
+                continue;
+
+            if (!falseInstsValid)
+            {
+                List<IRInst*> candidates;
+                collectHoistCandidates(falseBlock, candidates);
+                falseInsts.clear();
+                for (auto candidate : candidates)
+                    falseInsts.addIfNotExists(IRInstKey{candidate}, candidate);
+                falseInstsValid = true;
+            }
+
+            IRInst* twin = nullptr;
+            if (!falseInsts.tryGetValue(IRInstKey{inst}, twin))
+                continue;
+
+            inst->insertBefore(ifElse);
+            twin->replaceUsesWith(inst);
+            twin->removeAndDeallocate();
+            falseInstsValid = false;
+            changed = true;
+        }
+        return changed;
+    }
+
+    // Returns the value `load` would read if it was read by `inst`, or null if `inst` doesn't
+    // access the same address.
+    IRInst* getForwardedValue(IRLoad* load, IRInst* inst)
+    {
+        if (auto store = as<IRStore>(inst))
+        {
+            if (store->getPtr() == load->getPtr() && isLoadOrStoreToForward(store))
+                return store->getVal();
+        }
+        else if (auto prevLoad = as<IRLoad>(inst))
+        {
+            if (prevLoad->getPtr() == load->getPtr() && isLoadOrStoreToForward(prevLoad))
+                return prevLoad;
+        }
+        return nullptr;
+    }
+
+    bool isBlockClobberFree(IRBlock* block, IRInst* addr)
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (canInstHaveSideEffectAtAddress(func, inst, addr))
+                return false;
+        }
+        return true;
+    }
+
+    // Check that no block on a path from `defBlock` to `useBlock`, other than those two, can
+    // write to `addr`. `useBlock` itself is checked in full if it is reachable from itself
+    // without passing through `defBlock`.
+    bool arePathsClobberFree(IRBlock* defBlock, IRBlock* useBlock, IRInst* addr)
+    {
+        HashSet<IRBlock*> visited;
+        visited.add(defBlock);
+        List<IRBlock*> workList;
+        for (auto pred : useBlock->getPredecessors())
+        {
+            if (visited.add(pred))
+                workList.add(pred);
+        }
+        for (Index i = 0; i < workList.getCount(); i++)
+        {
+            if (i >= kMaxBlocksToSearch)
+                return false;
+            auto block = workList[i];
+            if (!isBlockClobberFree(block, addr))
+                return false;
+            for (auto pred : block->getPredecessors())
+            {
+                if (visited.add(pred))
+                    workList.add(pred);
+            }
+        }
+        return true;
+    }
+
+    // Find a value for `load` from a load or store of the same address that dominates it.
+    IRInst* findAvailableValue(IRLoad* load)
+    {
+        auto addr = load->getPtr();
+        auto useBlock = as<IRBlock>(load->getParent());
+
+        // Accesses earlier in the same block are handled by `eliminateRedundantLoadStore`, so
+        // only a clobber needs to be looked for here.
+        for (auto prev = load->getPrevInst(); prev; prev = prev->getPrevInst())
+        {
+            if (getForwardedValue(load, prev))
+                return nullptr;
+            if (canInstHaveSideEffectAtAddress(func, prev, addr))
+                return nullptr;
+        }
+
+        Index depth = 0;
+        for (auto block = dom->getImmediateDominator(useBlock); block;
+             block = dom->getImmediateDominator(block))
+        {
+            if (++depth > kMaxBlocksToSearch)
+                return nullptr;
+            for (auto prev = block->getTerminator(); prev; prev = prev->getPrevInst())
+            {
+                if (auto value = getForwardedValue(load, prev))
+                {
+                    if (!arePathsClobberFree(block, useBlock, addr))
+                        return nullptr;
+                    return value;
+                }
+                if (canInstHaveSideEffectAtAddress(func, prev, addr))
+                    return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    bool forwardLoadsAcrossBlocks()
+    {
+        bool changed = false;
+        for (auto block : func->getBlocks())
+        {
+            if (dom->isUnreachable(block))
+                continue;
+            IRInst* nextInst = nullptr;
+            for (auto inst = block->getFirstInst(); inst; inst = nextInst)
+            {
+                nextInst = inst->getNextInst();
+                auto load = as<IRLoad>(inst);
+                if (!load || !isLoadOrStoreToForward(load))
+                    continue;
+                auto value = findAvailableValue(load);
+                if (!value || value->getFullType() != load->getFullType())
+                    continue;
+                load->replaceUsesWith(value);
+                load->removeAndDeallocate();
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool processFunc()
+    {
+        bool changed = false;
+        for (auto block : func->getBlocks())
+        {
+            if (dom->isUnreachable(block))
+                continue;
+            changed |= hoistCommonInstsFromBranches(block);
+        }
+        changed |= forwardLoadsAcrossBlocks();
+        return changed;
+    }
+};
+
+bool applyGlobalValueNumbering(IRGlobalValueWithCode* func)
+{
+    if (!func->getFirstBlock())
+        return false;
+
+    GlobalValueNumberingContext context;
+    context.func = func;
+    context.dom = findOrComputeDominatorTree(func);
+    return context.processFunc();
+}
+
+} // namespace Slang
@@ -0,0 +1,21 @@
+// slang-ir-gvn.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+
+/// Remove redundant computations and memory loads that are available on every path to them.
+///
+/// This complements `removeRedundancyInFunc`, which only replaces an inst with an equivalent
+/// inst in a dominating block, and `eliminateRedundantLoadStore`, which only forwards loads
+/// within a single block. It does two things:
+///
+/// - An inst that is computed on both sides of an `if`/`else` is hoisted into the block that
+///   branches, so it is computed once. This is a limited form of partial redundancy elimination.
+/// - A load is replaced with the value of a dominating load or store of the same address, if
+///   nothing on any path between them can write to the address.
+///
+/// Returns true if the function was changed.
+bool applyGlobalValueNumbering(IRGlobalValueWithCode* func);
+} // namespace Slang
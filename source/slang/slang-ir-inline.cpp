@@ -5,6 +5,7 @@
 #include "slang-ir-specialize-address-space.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-util.h"
+#include "slang-target.h"
 
 // This file provides general facilities for inlining function calls.
 
@@ -1380,6 +1381,126 @@ void performIntrinsicFunctionInlining(IRModule* module)
     }
 }
 
+HeuristicInliningOptions HeuristicInliningOptions::getForTarget(TargetRequest* targetRequest)
+{
+    HeuristicInliningOptions options;
+    // D3D, CPU and CUDA code goes through compilers that inline on their own; drivers for
+    // the other targets often don't.
+    if (!isKhronosTarget(targetRequest) && !isWGPUTarget(targetRequest) &&
+        !isMetalTarget(targetRequest))
+    {
+        options.growthBudget = 0;
+    }
+    return options;
+}
+
+struct HeuristicInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    HeuristicInliningPass(IRModule* module, HeuristicInliningOptions const& options)
+        : Super(module), m_options(options)
+    {
+    }
+
+    HeuristicInliningOptions m_options;
+
+    /// The size of each callee seen so far. A function's entry is dropped when a call is
+    /// inlined into it.
+    Dictionary<IRFunc*, Index> m_funcCosts;
+
+    /// The number of instructions inlined into each function so far.
+    Dictionary<IRFunc*, Index> m_funcGrowth;
+
+    static Index calcFuncCost(IRFunc* func)
+    {
+        Index cost = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getOrdinaryInsts())
+            {
+                switch (inst->getOp())
+                {
+                case kIROp_DebugLine:
+                case kIROp_DebugVar:
+                case kIROp_DebugValue:
+                case kIROp_DebugScope:
+                case kIROp_DebugNoScope:
+                case kIROp_DebugInlinedVariable:
+                    break;
+                default:
+                    cost++;
+                    break;
+                }
+            }
+        }
+        return cost;
+    }
+
+    Index getFuncCost(IRFunc* func)
+    {
+        if (auto cost = m_funcCosts.tryGetValue(func))
+            return *cost;
+        auto cost = calcFuncCost(func);
+        m_funcCosts[func] = cost;
+        return cost;
+    }
+
+    static bool isResourceParamType(IRType* type)
+    {
+        if (auto ptrType = as<IRPtrTypeBase>(type))
+            type = ptrType->getValueType();
+        return isResourceType(type);
+    }
+
+    bool shouldInline(CallSiteInfo const& info)
+    {
+        auto callee = info.callee;
+        if (callee->findDecoration<IRNoInlineDecoration>())
+            return false;
+
+        auto caller = getParentFunc(info.call);
+        if (!caller || caller == callee)
+            return false;
+
+        Index limit = m_options.smallFunctionCost;
+        for (UInt i = 0; i < info.call->getArgCount(); i++)
+        {
+            if (as<IRConstant>(info.call->getArg(i)))
+                limit += m_options.constantArgumentBonus;
+        }
+        for (auto param : callee->getParams())
+        {
+            if (isResourceParamType(param->getDataType()))
+                limit += m_options.resourceParameterBonus;
+        }
+        if (!info.specialize && callee->firstUse && !callee->firstUse->nextUse)
+            limit = Math::Max(limit, m_options.singleCallSiteCost);
+
+        auto cost = getFuncCost(callee);
+        if (cost > limit)
+            return false;
+
+        // The budget also keeps recursive calls from being inlined forever.
+        auto& growth = m_funcGrowth.getOrAddValue(caller, 0);
+        if (growth + cost > m_options.growthBudget)
+            return false;
+        growth += cost;
+        m_funcCosts.remove(caller);
+        return true;
+    }
+};
+
+bool performHeuristicInlining(IRModule* module, HeuristicInliningOptions const& options)
+{
+    SLANG_PROFILE;
+
+    if (options.growthBudget <= 0)
+        return false;
+    HeuristicInliningPass pass(module, options);
+    return pass.considerAllCallSites();
+}
+
 struct CustomInliningPass : InliningPassBase
 {
     typedef InliningPassBase Super;
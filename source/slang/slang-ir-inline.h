@@ -11,6 +11,7 @@ struct IRCall;
 struct IRGlobalValueWithCode;
 class DiagnosticSink;
 class TargetProgram;
+class TargetRequest;
 struct IRInst;
 
 /// Any call to a function that takes or returns a string/RefType parameter is inlined
@@ -38,6 +39,40 @@ void performGLSLResourceReturnFunctionInlining(IRModule* module, TargetProgram*
 /// Inline simple intrinsic functions whose definition is a single asm block.
 void performIntrinsicFunctionInlining(IRModule* module);
 
+/// Limits for `performHeuristicInlining`, in numbers of instructions.
+struct HeuristicInliningOptions
+{
+    /// Calls to functions of at most this size are inlined.
+    Index smallFunctionCost = 8;
+
+    /// Added to the size limit for each constant argument of a call, since inlining lets
+    /// the code that depends on it be folded.
+    Index constantArgumentBonus = 4;
+
+    /// Added to the size limit for each resource-typed parameter of the callee, since
+    /// passing resources costs more than passing values on most graphics targets.
+    Index resourceParameterBonus = 8;
+
+    /// A function with a single call site may be inlined up to this size, since inlining
+    /// it doesn't duplicate any code.
+    Index singleCallSiteCost = 64;
+
+    /// The most instructions heuristic inlining may add to any one function. Zero disables
+    /// heuristic inlining.
+    Index growthBudget = 256;
+
+    /// Targets whose downstream compiler inlines well get a zero budget.
+    static HeuristicInliningOptions getForTarget(TargetRequest* targetRequest);
+};
+
+/// Inline calls to small functions, for targets whose drivers don't inline reliably.
+///
+/// A call is inlined if the callee is no larger than `smallFunctionCost`, raised for the
+/// constant arguments of the call and the resource parameters of the callee, or than
+/// `singleCallSiteCost` if the call is its only use. Functions marked `[noinline]` are left
+/// alone, and no function grows by more than `growthBudget`.
+bool performHeuristicInlining(IRModule* module, HeuristicInliningOptions const& options);
+
 /// Inline a specific call.
 bool inlineCall(IRCall* call);
 } // namespace Slang
@@ -296,6 +296,13 @@ struct IRAvailableInDownstreamIRDecoration : IRDecoration
     {
         return static_cast<CodeGenTarget>(cast<IRIntLit>(getOperand(0))->getValue());
     }
+
+    /// The options key of the embedded code the function is available in, or 0 if the
+    /// decoration predates keys. See `IREmbeddedDownstreamIR::getOptionsKey`.
+    UInt64 getOptionsKey()
+    {
+        return getOperandCount() > 1 ? UInt64(cast<IRIntLit>(getOperand(1))->getValue()) : 0;
+    }
 };
 
 
@@ -2837,6 +2844,21 @@ struct IREmbeddedDownstreamIR : IRInst
 {
     FIDDLE(leafInst())
     CodeGenTarget getTarget() { return static_cast<CodeGenTarget>(getTargetOperand()->getValue()); }
+
+    /// The key of the target options the code was generated with, see
+    /// `CodeGenContext::getDownstreamIROptionsKey`. 0 if the code predates keys.
+    UInt64 getOptionsKey()
+    {
+        auto keyOperand = getOptionsKeyOperand();
+        return keyOperand ? UInt64(keyOperand->getValue()) : 0;
+    }
+
+    /// True if the code can be linked into a program generated with `optionsKey`.
+    bool matchesOptionsKey(UInt64 optionsKey)
+    {
+        const auto key = getOptionsKey();
+        return key == 0 || key == optionsKey;
+    }
 };
 
 FIDDLE()
@@ -3890,7 +3912,7 @@ $(type_info.return_type) $(type_info.method_name)(
     IRInst* emitSPIRVSamplerDescriptorHeap();
     IRInst* emitMakeCombinedTextureSampler(IRType* type, IRInst* texture, IRInst* sampler);
 
-    IRInst* emitEmbeddedDownstreamIR(CodeGenTarget target, ISlangBlob* blob);
+    IRInst* emitEmbeddedDownstreamIR(CodeGenTarget target, ISlangBlob* blob, UInt64 optionsKey);
 
     IRFunc* createFunc();
     IRGlobalVar* createGlobalVar(IRType* valueType);
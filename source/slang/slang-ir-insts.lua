@@ -2748,7 +2748,15 @@ local insts = {
 		},
 	},
 	-- Embedded Precompiled Libraries
-	{ EmbeddedDownstreamIR = { operands = { { "targetOperand", "IRIntLit" }, { "blob", "IRBlobLit" } } } },
+	{
+		EmbeddedDownstreamIR = {
+			operands = {
+				{ "targetOperand", "IRIntLit" },
+				{ "blob", "IRBlobLit" },
+				{ "optionsKeyOperand", "IRIntLit", optional = true },
+			},
+		},
+	},
 	-- Inline assembly
 	{ SPIRVAsm = { parent = true } },
 	{ SPIRVAsmInst = { min_operands = 1 } },
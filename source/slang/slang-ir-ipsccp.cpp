@@ -0,0 +1,273 @@
+// slang-ir-ipsccp.cpp
+#include "slang-ir-ipsccp.h"
+
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-sccp.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Functions larger than this, in insts, aren't cloned.
+static const Index kMaxSpecializedFuncInstCount = 1024;
+
+// The most clones made of any one function.
+static const Index kMaxSpecializationsPerFunc = 8;
+
+// The most insts added to the module by cloning, over all functions.
+static const Index kMaxTotalClonedInstCount = 16384;
+
+// The most insts searched from a parameter for a use that makes specializing it worthwhile.
+static const Index kMaxParamUsesToSearch = 64;
+
+struct InterproceduralConstantPropagationContext
+{
+    IRModule* module;
+    TargetProgram* targetProgram;
+    DiagnosticSink* sink;
+
+    // A clone of a function, with the constant arguments it was made for. Arguments that
+    // weren't substituted are null.
+    struct Specialization
+    {
+        List<IRInst*> constantArgs;
+        IRFunc* func;
+    };
+    Dictionary<IRFunc*, List<Specialization>> specializations;
+
+    Dictionary<IRFunc*, Index> instCounts;
+    Index totalClonedInstCount = 0;
+
+    List<IRFunc*> workList;
+
+    Index getInstCount(IRFunc* func)
+    {
+        if (auto count = instCounts.tryGetValue(func))
+            return *count;
+        Index count = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                count++;
+            }
+        }
+        instCounts[func] = count;
+        return count;
+    }
+
+    static bool isConstantArg(IRInst* arg)
+    {
+        switch (arg->getOp())
+        {
+        case kIROp_IntLit:
+        case kIROp_BoolLit:
+        case kIROp_FloatLit:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Does the value of `param` decide a branch, directly or through a few side-effect free
+    // insts, or get passed on to another call where it could be propagated further?
+    static bool isParamWorthSpecializing(IRParam* param)
+    {
+        List<IRInst*> values;
+        HashSet<IRInst*> visited;
+        values.add(param);
+        for (Index i = 0; i < values.getCount() && i < kMaxParamUsesToSearch; i++)
+        {
+            for (auto use = values[i]->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                switch (user->getOp())
+                {
+                case kIROp_IfElse:
+                case kIROp_Switch:
+                case kIROp_Select:
+                case kIROp_Call:
+                    return true;
+                default:
+                    if (!user->mightHaveSideEffects() && user->getDataType() &&
+                        visited.add(user))
+                        values.add(user);
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool canSpecializeCallee(IRFunc* callee)
+    {
+        if (!callee->getFirstBlock())
+            return false;
+        if (callee->findDecoration<IREntryPointDecoration>() ||
+            callee->findDecoration<IRTargetIntrinsicDecoration>() ||
+            callee->findDecoration<IRKnownBuiltinDecoration>())
+            return false;
+        return getInstCount(callee) <= kMaxSpecializedFuncInstCount;
+    }
+
+    IRFunc* createSpecializedFunc(IRFunc* callee, List<IRInst*> const& constantArgs)
+    {
+        IRBuilder builder(module);
+        builder.setInsertBefore(callee);
+        IRCloneEnv cloneEnv;
+        auto newFunc = as<IRFunc>(cloneInst(&cloneEnv, &builder, callee));
+
+        // The clone is private to this module, and is only kept if something calls it.
+        List<IRDecoration*> decorationsToRemove;
+        for (auto decoration : newFunc->getDecorations())
+        {
+            if (as<IRLinkageDecoration>(decoration) || as<IRKeepAliveDecoration>(decoration))
+                decorationsToRemove.add(decoration);
+        }
+        for (auto decoration : decorationsToRemove)
+            decoration->removeAndDeallocate();
+
+        List<IRParam*> params;
+        for (auto param : newFunc->getParams())
+            params.add(param);
+        for (Index i = 0; i < params.getCount(); i++)
+        {
+            if (!constantArgs[i])
+                continue;
+            params[i]->replaceUsesWith(constantArgs[i]);
+            params[i]->removeAndDeallocate();
+        }
+        fixUpFuncType(newFunc);
+
+        applySparseConditionalConstantPropagation(newFunc, targetProgram, sink);
+        return newFunc;
+    }
+
+    // Find or create the clone of `callee` for `constantArgs`. Returns null if the budget
+    // doesn't allow another clone.
+    IRFunc* getSpecializedFunc(IRFunc* callee, List<IRInst*> const& constantArgs)
+    {
+        auto& funcSpecializations = specializations[callee];
+        for (auto& specialization : funcSpecializations)
+        {
+            if (specialization.constantArgs == constantArgs)
+                return specialization.func;
+        }
+        if (funcSpecializations.getCount() >= kMaxSpecializationsPerFunc)
+            return nullptr;
+
+        // A callee with a single call site will be removed once the call is redirected, so
+        // cloning it doesn't add to the size of the module.
+        bool hasSingleUse = callee->firstUse && !callee->firstUse->nextUse;
+        Index cost = hasSingleUse ? 0 : getInstCount(callee);
+        if (totalClonedInstCount + cost > kMaxTotalClonedInstCount)
+            return nullptr;
+        totalClonedInstCount += cost;
+
+        Specialization specialization;
+        specialization.constantArgs = constantArgs;
+        specialization.func = createSpecializedFunc(callee, constantArgs);
+        specializations[callee].add(specialization);
+        workList.add(specialization.func);
+        return specialization.func;
+    }
+
+    bool trySpecializeCall(IRCall* call)
+    {
+        auto callee = as<IRFunc>(call->getCallee());
+        if (!callee || !canSpecializeCallee(callee))
+            return false;
+
+        List<IRInst*> constantArgs;
+        bool hasConstantArg = false;
+        auto param = callee->getFirstParam();
+        for (UInt i = 0; i < call->getArgCount(); i++)
+        {
+            if (!param)
+                return false;
+            auto arg = call->getArg(i);
+            if (isConstantArg(arg) && arg->getFullType() == param->getFullType() &&
+                isParamWorthSpecializing(param))
+            {
+                constantArgs.add(arg);
+                hasConstantArg = true;
+            }
+            else
+            {
+                constantArgs.add(nullptr);
+            }
+            param = param->getNextParam();
+        }
+        if (!hasConstantArg)
+            return false;
+
+        auto newFunc = getSpecializedFunc(callee, constantArgs);
+        if (!newFunc)
+            return false;
+
+        List<IRInst*> newArgs;
+        for (UInt i = 0; i < call->getArgCount(); i++)
+        {
+            if (!constantArgs[i])
+                newArgs.add(call->getArg(i));
+        }
+        IRBuilder builder(call);
+        builder.setInsertBefore(call);
+        auto newCall = builder.emitCallInst(call->getFullType(), newFunc, newArgs);
+        call->transferDecorationsTo(newCall);
+        call->replaceUsesWith(newCall);
+        call->removeAndDeallocate();
+        return true;
+    }
+
+    bool processFunc(IRFunc* func)
+    {
+        List<IRCall*> calls;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (auto call = as<IRCall>(inst))
+                    calls.add(call);
+            }
+        }
+
+        bool changed = false;
+        for (auto call : calls)
+            changed |= trySpecializeCall(call);
+        return changed;
+    }
+
+    bool apply()
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto func = as<IRFunc>(inst))
+                workList.add(func);
+        }
+
+        // Clones are added to the work list as they are created, so the constants they
+        // received are propagated on into the functions they call.
+        bool changed = false;
+        for (Index i = 0; i < workList.getCount(); i++)
+            changed |= processFunc(workList[i]);
+        return changed;
+    }
+};
+
+bool applyInterproceduralConstantPropagation(
+    IRModule* module,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink)
+{
+    InterproceduralConstantPropagationContext context;
+    context.module = module;
+    context.targetProgram = targetProgram;
+    context.sink = sink;
+    return context.apply();
+}
+
+} // namespace Slang
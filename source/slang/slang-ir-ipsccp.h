@@ -0,0 +1,26 @@
+// slang-ir-ipsccp.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+class TargetProgram;
+
+/// Interprocedural constant propagation.
+///
+/// Calls that pass a constant argument to a parameter that decides a branch in the callee, or
+/// that the callee passes on to another call, are redirected to a clone of the callee with
+/// the constant substituted for the parameter. SCCP is applied to each clone, so constants
+/// passed down through several levels of helper functions reach the innermost one, and the
+/// branches they decide are folded away.
+///
+/// Call sites with the same constant arguments share a clone. The number of clones of each
+/// function, and the total size of the clones, are bounded to limit the growth in code size.
+///
+/// Returns true if any calls were redirected.
+bool applyInterproceduralConstantPropagation(
+    IRModule* module,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink);
+} // namespace Slang
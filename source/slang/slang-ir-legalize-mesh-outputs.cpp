@@ -33,4 +33,116 @@ void legalizeMeshOutputTypes(IRModule* module)
     }
 }
 
+// Is `inst` a value that the program never defined, or a part of one?
+static bool isUndefinedValue(IRInst* inst)
+{
+    for (;;)
+    {
+        if (as<IRUndefined>(inst))
+            return true;
+
+        switch (inst->getOp())
+        {
+        case kIROp_FieldExtract:
+            {
+                auto fieldExtract = as<IRFieldExtract>(inst);
+                auto field = fieldExtract->getField();
+                inst = fieldExtract->getBase();
+
+                // A struct that was built up one field at a time holds the last value
+                // written to each field, or whatever the struct started out as.
+                while (auto update = as<IRUpdateElement>(inst))
+                {
+                    if (update->getAccessKeyCount() != 1)
+                        return false;
+                    if (update->getAccessKey(0) == field)
+                    {
+                        inst = update->getElementValue();
+                        break;
+                    }
+                    inst = update->getOldValue();
+                }
+            }
+            break;
+        case kIROp_GetElement:
+        case kIROp_Swizzle:
+            inst = inst->getOperand(0);
+            break;
+        default:
+            return false;
+        }
+    }
+}
+
+// Remove the stores of undefined values through `ptr`, along with the addresses derived
+// from it that are left without uses.
+static bool removeUndefinedWritesThrough(IRInst* ptr)
+{
+    bool changed = false;
+    for (auto use = ptr->firstUse; use;)
+    {
+        auto nextUse = use->nextUse;
+        auto user = use->getUser();
+        switch (user->getOp())
+        {
+        case kIROp_GetElementPtr:
+        case kIROp_FieldAddress:
+            if (use == user->getOperands())
+            {
+                changed |= removeUndefinedWritesThrough(user);
+                if (!user->hasUses())
+                    user->removeAndDeallocate();
+            }
+            break;
+        case kIROp_Store:
+            {
+                auto store = as<IRStore>(user);
+                if (store->getPtr() == ptr && isUndefinedValue(store->getVal()))
+                {
+                    store->removeAndDeallocate();
+                    changed = true;
+                }
+            }
+            break;
+        }
+        use = nextUse;
+    }
+    return changed;
+}
+
+bool removeUndefinedMeshOutputWrites(IRModule* module)
+{
+    bool hasMeshEntryPoint = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto entryPointDecor = inst->findDecoration<IREntryPointDecoration>();
+        if (entryPointDecor && entryPointDecor->getProfile().getStage() == Stage::Mesh)
+            hasMeshEntryPoint = true;
+    }
+    if (!hasMeshEntryPoint)
+        return false;
+
+    // By now every field of a vertex or primitive output is a separate global parameter.
+    // Built-in outputs are left alone, since they are declared together as one block.
+    bool changed = false;
+    List<IRInst*> unwrittenOutputs;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto param = as<IRGlobalParam>(inst);
+        if (!param)
+            continue;
+        auto ptrType = as<IRPtrTypeBase>(param->getDataType());
+        if (!ptrType || ptrType->getAddressSpace() != AddressSpace::Output)
+            continue;
+        if (!removeUndefinedWritesThrough(param))
+            continue;
+        changed = true;
+        if (!param->hasUses())
+            unwrittenOutputs.add(param);
+    }
+    for (auto output : unwrittenOutputs)
+        output->removeAndDeallocate();
+    return changed;
+}
+
 } // namespace Slang
@@ -9,4 +9,19 @@ struct IRModule;
 
 // Turn opaque mesh output types into regular arrays
 void legalizeMeshOutputTypes(IRModule* module);
+
+/// Remove the writes of undefined values to the outputs of mesh shaders.
+///
+/// A vertex or primitive struct that is written to a mesh output as a whole, with some of
+/// its fields left unset, still writes something to every field. Each field of the outputs
+/// is a separate output attribute once the entry point has been legalized, so dropping
+/// these writes leaves attributes that the shader never defines without any writes, and
+/// they are then removed entirely. This reduces the output memory each meshlet needs,
+/// which lets more of them be in flight at once.
+///
+/// A later stage that reads a removed attribute no longer has a matching output, so this
+/// must only be run when that has been asked for.
+///
+/// Returns true if any write was removed.
+bool removeUndefinedMeshOutputWrites(IRModule* module);
 } // namespace Slang
@@ -127,7 +127,7 @@ struct IRGlobalParamInfo
 static LegalVal declareVars(
     IRTypeLegalizationContext* context,
     IROp op,
-    LegalType type,
+    LegalType const& type,
     IRTypeLayout* typeLayout,
     LegalVarChain const& varChain,
     UnownedStringSlice nameHint,
@@ -153,7 +153,7 @@ static LegalVal declareVars(
 ///
 static LegalVal unwrapBufferValue(
     IRTypeLegalizationContext* context,
-    LegalVal legalPtrOperand,
+    LegalVal const& legalPtrOperand,
     LegalElementWrapping const& elementInfo);
 
 /// Perform any actions required to materialize `val` into a usable value.
@@ -166,7 +166,9 @@ static LegalVal unwrapBufferValue(
 /// emitting additional IR instructions, and returns the unmodified
 /// `val` otherwise.
 ///
-static LegalVal maybeMaterializeWrappedValue(IRTypeLegalizationContext* context, LegalVal val)
+static LegalVal maybeMaterializeWrappedValue(
+    IRTypeLegalizationContext* context,
+    LegalVal const& val)
 {
     if (val.flavor != LegalVal::Flavor::wrappedBuffer)
         return val;
@@ -497,7 +499,7 @@ struct LegalReturnBuilder
     }
 
     /// Emit code to perform a return of `val`
-    void returnVal(LegalVal val)
+    void returnVal(LegalVal const& val)
     {
         auto builder = m_context->builder;
 
@@ -700,7 +702,7 @@ private:
 
 static LegalVal legalizeRetVal(
     IRTypeLegalizationContext* context,
-    LegalVal retVal,
+    LegalVal const& retVal,
     IRReturn* returnInst)
 {
     LegalReturnBuilder builder(context, returnInst);
@@ -767,7 +769,7 @@ static LegalVal legalizeUnconditionalBranch(
     return LegalVal();
 }
 
-static LegalVal legalizeLoad(IRTypeLegalizationContext* context, LegalVal legalPtrVal)
+static LegalVal legalizeLoad(IRTypeLegalizationContext* context, LegalVal const& legalPtrVal)
 {
     switch (legalPtrVal.flavor)
     {
@@ -848,7 +850,7 @@ static LegalVal legalizePrintf(IRTypeLegalizationContext* context, ArrayView<Leg
 
 static LegalVal legalizeDebugVar(
     IRTypeLegalizationContext* context,
-    LegalType type,
+    LegalType const& type,
     IRDebugVar* originalInst)
 {
     // For now we just discard any special part and keep the ordinary part.
@@ -902,7 +904,7 @@ static LegalVal legalizeDebugVar(
 static LegalVal legalizeDebugValue(
     IRTypeLegalizationContext* context,
     LegalVal debugVar,
-    LegalVal debugValue,
+    LegalVal const& debugValue,
     IRDebugValue* originalInst)
 {
     if (debugVar.flavor == LegalVal::Flavor::none)
@@ -947,7 +949,7 @@ static LegalVal legalizeDebugValue(
 
 static LegalVal legalizeStore(
     IRTypeLegalizationContext* context,
-    LegalVal legalPtrVal,
+    LegalVal const& legalPtrVal,
     LegalVal legalVal)
 {
     switch (legalPtrVal.flavor)
@@ -1017,7 +1019,7 @@ static LegalVal legalizeStore(
 static LegalVal legalizeFieldExtract(
     IRTypeLegalizationContext* context,
     LegalType type,
-    LegalVal legalStructOperand,
+    LegalVal const& legalStructOperand,
     IRStructKey* fieldKey)
 {
     auto builder = context->builder;
@@ -1110,9 +1112,9 @@ static LegalVal legalizeFieldExtract(
 
 static LegalVal legalizeFieldExtract(
     IRTypeLegalizationContext* context,
-    LegalType type,
-    LegalVal legalPtrOperand,
-    LegalVal legalFieldOperand)
+    LegalType const& type,
+    LegalVal const& legalPtrOperand,
+    LegalVal const& legalFieldOperand)
 {
     // We don't expect any legalization to affect
     // the "field" argument.
@@ -1124,7 +1126,7 @@ static LegalVal legalizeFieldExtract(
 /// Take a value of some buffer/pointer type and unwrap it according to provided info.
 static LegalVal unwrapBufferValue(
     IRTypeLegalizationContext* context,
-    LegalVal legalPtrOperand,
+    LegalVal const& legalPtrOperand,
     LegalElementWrapping const& elementInfo)
 {
     // The `elementInfo` tells us how a non-simple element
@@ -1274,7 +1276,7 @@ static LegalType getPointedToType(IRTypeLegalizationContext* context, LegalType
 static LegalVal legalizeFieldAddress(
     IRTypeLegalizationContext* context,
     LegalType type,
-    LegalVal legalPtrOperand,
+    LegalVal const& legalPtrOperand,
     IRStructKey* fieldKey)
 {
     auto builder = context->builder;
@@ -1393,9 +1395,9 @@ static LegalVal legalizeFieldAddress(
 
 static LegalVal legalizeFieldAddress(
     IRTypeLegalizationContext* context,
-    LegalType type,
-    LegalVal legalPtrOperand,
-    LegalVal legalFieldOperand)
+    LegalType const& type,
+    LegalVal const& legalPtrOperand,
+    LegalVal const& legalFieldOperand)
 {
     // We don't expect any legalization to affect
     // the "field" argument.
@@ -1407,7 +1409,7 @@ static LegalVal legalizeFieldAddress(
 static LegalVal legalizeGetElement(
     IRTypeLegalizationContext* context,
     LegalType type,
-    LegalVal legalPtrOperand,
+    LegalVal const& legalPtrOperand,
     IRInst* indexOperand)
 {
     auto builder = context->builder;
@@ -1490,8 +1492,8 @@ static LegalVal legalizeGetElement(
 static LegalVal legalizeGetElement(
     IRTypeLegalizationContext* context,
     LegalType type,
-    LegalVal legalPtrOperand,
-    LegalVal legalIndexOperand)
+    LegalVal const& legalPtrOperand,
+    LegalVal const& legalIndexOperand)
 {
     // We don't expect any legalization to affect
     // the "index" argument.
@@ -1506,7 +1508,7 @@ static LegalVal legalizeGetElement(
 static LegalVal legalizeGetElementPtr(
     IRTypeLegalizationContext* context,
     LegalType type,
-    LegalVal legalPtrOperand,
+    LegalVal const& legalPtrOperand,
     IRInst* indexOperand)
 {
     auto builder = context->builder;
@@ -1607,9 +1609,9 @@ static LegalVal legalizeGetElementPtr(
 
 static LegalVal legalizeGetElementPtr(
     IRTypeLegalizationContext* context,
-    LegalType type,
-    LegalVal legalPtrOperand,
-    LegalVal legalIndexOperand)
+    LegalType const& type,
+    LegalVal const& legalPtrOperand,
+    LegalVal const& legalIndexOperand)
 {
     // We don't expect any legalization to affect
     // the "index" argument.
@@ -1620,7 +1622,7 @@ static LegalVal legalizeGetElementPtr(
 
 static LegalVal legalizeMakeStruct(
     IRTypeLegalizationContext* context,
-    LegalType legalType,
+    LegalType const& legalType,
     LegalVal const* legalArgs,
     UInt argCount)
 {
@@ -1741,7 +1743,7 @@ static LegalVal legalizeMakeStruct(
 
 static LegalVal legalizeMakeArray(
     IRTypeLegalizationContext* context,
-    LegalType legalType,
+    LegalType const& legalType,
     LegalVal const* legalArgs,
     UInt argCount,
     IROp constructOp)
@@ -1911,7 +1913,9 @@ static LegalVal legalizeMakeArray(
     }
 }
 
-static LegalVal legalizeDefaultConstruct(IRTypeLegalizationContext* context, LegalType legalType)
+static LegalVal legalizeDefaultConstruct(
+    IRTypeLegalizationContext* context,
+    LegalType const& legalType)
 {
     auto builder = context->builder;
 
@@ -2134,7 +2138,8 @@ static LegalVal legalizeLocalVar(IRTypeLegalizationContext* context, IRVar* irLo
     LegalType maybeSimpleType = legalValueType;
     while (maybeSimpleType.flavor == LegalType::Flavor::implicitDeref)
     {
-        maybeSimpleType = maybeSimpleType.getImplicitDeref()->valueType;
+        LegalType valueType = maybeSimpleType.getImplicitDeref()->valueType;
+        maybeSimpleType = valueType;
     }
 
     switch (maybeSimpleType.flavor)
@@ -2584,7 +2589,7 @@ private:
     IRType* m_resultType = nullptr;
 
     /// Add a parameter of type `t` to the function signature
-    void _addParam(LegalType t)
+    void _addParam(LegalType const& t)
     {
         // This logic is a simple recursion over the structure of `t`,
         // with the leaf case adding parameters of simple IR type.
@@ -2624,7 +2629,7 @@ private:
     }
 
     /// Set the logical result type of the legalized function to `t`
-    void _addResult(LegalType t)
+    void _addResult(LegalType const& t)
     {
         switch (t.flavor)
         {
@@ -2691,7 +2696,7 @@ private:
     }
 
     /// Add a single `out` parameter based on type `t`.
-    void _addOutParam(LegalType t)
+    void _addOutParam(LegalType const& t)
     {
         switch (t.flavor)
         {
@@ -3268,7 +3273,7 @@ static IRTypeLayout* _createWrappedBufferTypeLayout(
 static LegalVal declareVars(
     IRTypeLegalizationContext* context,
     IROp op,
-    LegalType type,
+    LegalType const& type,
     IRTypeLayout* inTypeLayout,
     LegalVarChain const& inVarChain,
     UnownedStringSlice nameHint,
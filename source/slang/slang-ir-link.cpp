@@ -98,9 +98,10 @@ struct IRSpecContextBase
         RefPtr<IRSpecSymbol> symbol;
         if (shared->symbols.tryGetValue(hashedName, symbol))
             return symbol;
+        IRMangledNameKey mangledNameKey(mangledName);
         for (auto m : irModules)
         {
-            for (auto inst : m->findSymbolByMangledName(hashedName))
+            for (auto inst : m->findSymbolByMangledName(mangledNameKey))
                 insertGlobalValueSymbol(shared, inst);
         }
         if (shared->symbols.tryGetValue(hashedName, symbol))
@@ -1209,6 +1210,17 @@ static CapabilitySet _getBestSpecializationCaps(IRInst* inVal, CapabilitySet con
     }
 }
 
+/// Is `val` a definition, counting a body that hasn't been read in yet?
+static bool _isDefinitionForLinking(IRInst* val)
+{
+    if (auto module = val->getModule())
+    {
+        if (module->hasDeferredBody(val))
+            return true;
+    }
+    return isDefinition(val);
+}
+
 // Is `newVal` marked as being a better match for our
 // chosen code-generation target?
 //
@@ -1295,8 +1307,8 @@ bool isBetterForTarget(IRSpecContext* context, IRInst* newVal, IRInst* oldVal)
 
     // All preceding factors being equal, a definition is
     // better than a declaration.
-    auto newIsDef = isDefinition(newVal);
-    auto oldIsDef = isDefinition(oldVal);
+    auto newIsDef = _isDefinitionForLinking(newVal);
+    auto oldIsDef = _isDefinitionForLinking(oldVal);
     if (newIsDef != oldIsDef)
         return newIsDef;
 
@@ -1463,6 +1475,10 @@ IRInst* cloneGlobalValueImpl(
     IRInst* originalInst,
     IROriginalValuesForClone const& originalValues)
 {
+    // The original may come from a module whose bodies are read in on demand
+    if (auto originalModule = originalInst->getModule())
+        originalModule->ensureBodyLoaded(originalInst);
+
     auto clonedValue =
         cloneInst(context, &context->shared->builderStorage, originalInst, originalValues);
     clonedValue->moveToEnd();
@@ -1542,6 +1558,9 @@ IRInst* cloneGlobalValueWithLinkage(
         return nullptr;
     }
 
+    if (auto bestModule = bestVal->getModule())
+        bestModule->ensureBodyLoaded(bestVal);
+
     // Check that the best value we found is valid: if it's a function,
     // it should either have a body, be an intrinsic, or be imported.
     // This catches cases like extension methods declared without a body,
@@ -1601,6 +1620,18 @@ void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
     if (!linkage)
         return;
 
+    // Picking between candidates for a symbol looks at their target decorations. Those
+    // of a generic are on the value it returns, so make sure its body is available if
+    // it comes from a module read on demand. A function keeps its decorations outside
+    // of its body, which is only read in if it is the candidate picked for the target
+    // (see `cloneGlobalValueWithLinkage`), so that the variants of a core module
+    // function for other targets are never read.
+    if (!as<IRFunc>(gv))
+    {
+        if (auto module = gv->getModule())
+            module->ensureBodyLoaded(gv);
+    }
+
     auto mangledName = String(linkage->getMangledName());
 
     RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
@@ -2270,7 +2301,10 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
 
     for (IRModule* irModule : irModules)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        // Only the module's link root candidates can pass `shouldCopy`, so there is no need
+        // to walk all of its global insts (the core module alone has many thousands) on
+        // every link.
+        for (auto inst : irModule->getLinkRootCandidates())
         {
             // We need to copy over exported symbols,
             // and any global parameters if preserve-params option is set.
@@ -10,6 +10,7 @@
 #include "slang-ir-util.h"
 #include "slang-ir.h"
 #include "slang-rich-diagnostics.h"
+#include "slang-target-program.h"
 
 namespace Slang
 {
@@ -220,27 +221,78 @@ static void allocVarForLoopInductionPhiParam(
 }
 
 // Unroll loop up to a predefined maximum number of iterations.
-// Returns true if we can statically determine that the loop terminated within the iteration limit.
-// This operation assumes the loop does not have `continue` jumps, i.e. continueBlock ==
-// targetBlock.
-static bool _unrollLoop(
+enum class LoopUnrollResult
+{
+    Unrolled,        ///< The loop was fully unrolled (or isn't a loop to unroll).
+    DidNotTerminate, ///< The loop didn't terminate within the maximum number of iterations.
+    OverBudget,      ///< Unrolling stopped because the loop would grow past the budget.
+};
+
+static Count _countInstsInBlocks(const List<IRBlock*>& blocks)
+{
+    Count count = 0;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            SLANG_UNUSED(inst);
+            count++;
+        }
+    }
+    return count;
+}
+
+// Keep what is left of `loopInst` as an ordinary loop, and leave it to the downstream
+// compiler to unroll it.
+static void _leaveLoopRolled(IRBuilder& builder, IRLoop* loopInst)
+{
+    if (auto forceUnrollDecor = loopInst->findDecoration<IRForceUnrollDecoration>())
+        forceUnrollDecor->removeAndDeallocate();
+    if (!loopInst->findDecoration<IRLoopControlDecoration>())
+        builder.addLoopControlDecoration(loopInst, kIRLoopControl_Unroll);
+}
+
+// Unroll `loopInst`, whose body is made of `blocks`.
+//
+// Returns `Unrolled` if we can statically determine that the loop terminated within the
+// iteration limit. This operation assumes the loop does not have `continue` jumps, i.e.
+// continueBlock == targetBlock.
+//
+// If `instBudget` is positive, unrolling stops before the instructions added by the
+// iterations peeled off so far, plus one more copy of the loop body, would exceed it.
+// The iterations that are left stay in a loop, and `outUnrolledIterations` is set to
+// the number of iterations that were peeled off.
+//
+static LoopUnrollResult _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
-    List<IRBlock*>& blocks)
+    List<IRBlock*>& blocks,
+    Count instBudget,
+    int& outUnrolledIterations)
 {
+    outUnrolledIterations = 0;
+
     if (blocks.getCount() == 0)
     {
         IRBuilder subBuilder(module);
         subBuilder.setInsertBefore(loopInst);
         subBuilder.emitBranch(loopInst->getBreakBlock());
         loopInst->removeAndDeallocate();
-        return true;
+        return LoopUnrollResult::Unrolled;
     }
 
     auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
-        return true;
+        return LoopUnrollResult::Unrolled;
+
+    // The cost of peeling off an iteration is estimated by the size of the loop body
+    // before it is simplified, so that a loop whose body alone is over budget is never
+    // touched. The cost actually charged is the size of each iteration after it has been
+    // simplified.
+    //
+    const Count bodyInstCount = instBudget > 0 ? _countInstsInBlocks(blocks) : 0;
+    Count addedInstCount = 0;
 
     // If the loop contains any induction variables (phi params in the header block)
     // that are used outside of the loop, we need to make sure these uses are referencing
@@ -319,6 +371,13 @@ static bool _unrollLoop(
     bool loopTerminated = false;
     for (int attempedIterations = 0; attempedIterations < maxIterations; attempedIterations++)
     {
+        if (instBudget > 0 && addedInstCount + bodyInstCount > instBudget)
+        {
+            _leaveLoopRolled(builder, loopInst);
+            outUnrolledIterations = attempedIterations;
+            return LoopUnrollResult::OverBudget;
+        }
+
         // Our task is to peel off the first iteration and put it in front of the
         // loop.
         // We will create a breakable region (via single iteration loop), and clone the loop body
@@ -439,6 +498,9 @@ static bool _unrollLoop(
             firstIterationBreakBlock,
             unreachableBlock);
 
+        if (instBudget > 0)
+            addedInstCount += _countInstsInBlocks(clonedBlocks);
+
         // Now we have peeled off one iteration from the loop, we check if there are any
         // branches into next iteration, if not, the loop terminates and we are done.
 
@@ -505,7 +567,7 @@ static bool _unrollLoop(
         }
     }
 
-    return loopTerminated;
+    return loopTerminated ? LoopUnrollResult::Unrolled : LoopUnrollResult::DidNotTerminate;
 }
 
 // Visits all loop insts in a func, inner loop first.
@@ -515,9 +577,11 @@ List<IRLoop*> collectLoopsInFunc(IRGlobalValueWithCode* func, const TFunc& filte
     List<IRLoop*> loops;
 
     // Post order processing allows us to process inner loops first.
-    auto postOrder = getPostorder(func);
+    auto& pool = func->getModule()->getContainerPool();
+    auto postOrder = pool.getList<IRBlock>();
+    computePostorder(func, *postOrder);
 
-    for (auto block : postOrder)
+    for (auto block : *postOrder)
     {
         if (auto loop = as<IRLoop>(block->getTerminator()))
         {
@@ -527,6 +591,7 @@ List<IRLoop*> collectLoopsInFunc(IRGlobalValueWithCode* func, const TFunc& filte
             }
         }
     }
+    pool.free(postOrder);
     return loops;
 }
 
@@ -543,6 +608,11 @@ bool unrollLoopsInFunc(
     if (loops.getCount() == 0)
         return true;
 
+    const Count instBudget =
+        targetProgram
+            ? targetProgram->getOptionSet().getIntOption(CompilerOptionName::LoopUnrollBudget)
+            : 0;
+
     for (auto loop : loops)
     {
         if (!loop->parent)
@@ -553,11 +623,24 @@ bool unrollLoopsInFunc(
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+        int unrolledIterations = 0;
+        switch (_unrollLoop(targetProgram, module, loop, blocks, instBudget, unrolledIterations))
         {
+        case LoopUnrollResult::Unrolled:
+            break;
+        case LoopUnrollResult::DidNotTerminate:
             if (sink)
                 sink->diagnose(Diagnostics::CannotUnrollLoop{.location = loopLoc});
             return false;
+        case LoopUnrollResult::OverBudget:
+            if (sink)
+            {
+                sink->diagnose(Diagnostics::LoopUnrollBudgetExceeded{
+                    .iterations = int64_t(unrolledIterations),
+                    .budget = int64_t(instBudget),
+                    .location = loopLoc});
+            }
+            break;
         }
 
         // Make sure we simplify things as much as possible before
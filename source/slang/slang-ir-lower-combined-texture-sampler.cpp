@@ -309,12 +309,12 @@ void lowerCombinedTextureSamplers(
     }
 
     // Replace all other type use with the lowered struct type.
+    List<KeyValuePair<IRInst*, IRInst*>> typeReplacements;
     for (auto typeInfo : context.mapTypeToLoweredInfo)
-    {
-        auto loweredInfo = typeInfo.second;
-        typeInfo.first->replaceUsesWith(loweredInfo.type);
-        typeInfo.first->removeAndDeallocate();
-    }
+        typeReplacements.add(KeyValuePair<IRInst*, IRInst*>(typeInfo.first, typeInfo.second.type));
+    module->replaceUsesWith(typeReplacements.getArrayView());
+    for (auto typeReplacement : typeReplacements)
+        typeReplacement.key->removeAndDeallocate();
 }
 
 } // namespace Slang
@@ -56,6 +56,17 @@ struct CoopVecLoweringContext
         return info.Ptr();
     }
 
+    // Get the cooperative vector type of a value, including a value whose cooperative vector
+    // type has already been lowered to an array.
+    IRCoopVectorType* getCoopVecType(IRType* type)
+    {
+        if (const auto cvt = as<IRCoopVectorType>(type))
+            return cvt;
+        if (auto loweredInfo = mapLoweredArrayToCoopVecInfo.tryGetValue(type))
+            return as<IRCoopVectorType>((*loweredInfo)->coopvecType);
+        return nullptr;
+    }
+
     void addToWorkList(IRInst* inst)
     {
         for (auto ii = inst->getParent(); ii; ii = ii->getParent())
@@ -113,35 +124,38 @@ struct CoopVecLoweringContext
     void processEntrywiseOp(IRInst* inst)
     {
         SLANG_ASSERT(inst->getOperandCount());
-        if (!as<IRCoopVectorType>(inst->getDataType()))
+        const auto resultType = as<IRCoopVectorType>(inst->getDataType());
+        if (!resultType)
             return;
         List<IRInst*> operands;
         IRIntegerValue width = 0;
-        IRType* resultElementType = nullptr;
         UIndex opIndex = 0;
         for (auto operand = inst->getOperands(); opIndex < inst->getOperandCount();
              operand++, opIndex++)
         {
             operands.add(operand->get());
-            if (const auto cv = as<IRCoopVectorType>(operand->get()->getDataType()))
-            {
+            if (const auto cv = getCoopVecType(operand->get()->getDataType()))
                 width = getIntVal(cv->getElementCount());
-                resultElementType = cv->getElementType();
-            }
         }
         if (width == 0)
             return;
         IRBuilder builder(module);
-        IRType* resultElementPtrType = builder.getPtrType(resultElementType);
         builder.setInsertBefore(inst);
-        const auto result = builder.emitVar(inst->getFullType());
+        const auto info = getLoweredCoopVecType(&builder, resultType);
+
+        // Assemble the result from its elements rather than storing them into a temporary
+        // array. When the operand of an entrywise op is the result of another one, as in the
+        // bias addition and activation that follow a matrix multiplication, the element it
+        // reads then folds to the scalar computed by the earlier op, so a chain of entrywise
+        // ops stays in registers instead of going through memory after every step.
+        List<IRInst*> resultElements;
         List<IRInst*> entrywiseOperands;
         entrywiseOperands.setCount(operands.getCount());
         for (IRIntegerValue i = 0; i < width; ++i)
         {
             for (int j = 0; j < operands.getCount(); ++j)
             {
-                if (const auto cv = as<IRCoopVectorType>(operands[j]->getDataType()))
+                if (const auto cv = getCoopVecType(operands[j]->getDataType()))
                 {
                     SLANG_ASSERT(getIntVal(cv->getElementCount()) == width);
                     const auto elementType = cv->getElementType();
@@ -153,14 +167,16 @@ struct CoopVecLoweringContext
                 }
             }
             const auto x = builder.emitIntrinsicInst(
-                resultElementType,
+                resultType->getElementType(),
                 inst->getOp(),
                 entrywiseOperands.getCount(),
                 entrywiseOperands.begin());
-            const auto d = builder.emitGetElementPtr(resultElementPtrType, result, i);
-            builder.emitStore(d, x);
+            resultElements.add(x);
         }
-        const auto v = builder.emitLoad(result);
+        const auto v = builder.emitMakeArray(
+            info->arrayType,
+            resultElements.getCount(),
+            resultElements.getBuffer());
         inst->replaceUsesWith(v);
         inst->removeAndDeallocate();
     }
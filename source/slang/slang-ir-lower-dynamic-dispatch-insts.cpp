@@ -1,5 +1,6 @@
 #include "slang-ir-lower-dynamic-dispatch-insts.h"
 
+#include "../core/slang-string-util.h"
 #include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-inst-pass-base.h"
 #include "slang-ir-insts.h"
@@ -241,13 +242,50 @@ UInt getUniqueID(IRBuilder* builder, IRInst* inst)
     return builder->getUniqueID(inst);
 }
 
+void DispatchFrequencyHints::parse(UnownedStringSlice text)
+{
+    for (auto line : LineParser(text))
+    {
+        line = line.trim();
+        if (line.getLength() == 0 || line.startsWith("#"))
+            continue;
+
+        List<UnownedStringSlice> parts;
+        StringUtil::splitOnWhitespace(line, parts);
+        Int frequency = 0;
+        if (parts.getCount() != 2 || SLANG_FAILED(StringUtil::parseInt(parts[1], frequency)))
+            continue;
+        frequencies[String(parts[0])] = frequency;
+    }
+}
+
+Int DispatchFrequencyHints::getFrequency(IRInst* func) const
+{
+    auto nameHint = getResolvedInstForDecorations(func)->findDecoration<IRNameHintDecoration>();
+    if (!nameHint)
+        return 0;
+
+    // Method name hints are qualified by their type, as in `Type.method`, so a hint can name
+    // either the method or the type.
+    auto name = nameHint->getName();
+    if (auto frequency = frequencies.tryGetValue(name))
+        return *frequency;
+    auto dotIndex = name.lastIndexOf('.');
+    if (dotIndex < 0)
+        return 0;
+    if (auto frequency = frequencies.tryGetValue(name.head(dotIndex)))
+        return *frequency;
+    return 0;
+}
+
 // Generate a single function that dispatches to each function in the collection.
 // The resulting function will have one additional parameter to accept the tag
 // indicating which function to call.
 //
 IRFunc* createDispatchFunc(
     IRFuncType* dispatchFuncType,
-    Dictionary<IRInst*, std::pair<IRInst*, IRFuncType*>>& mapping)
+    Dictionary<IRInst*, std::pair<IRInst*, IRFuncType*>>& mapping,
+    DispatchFrequencyHints const* frequencyHints)
 {
     // Create a dispatch function with switch-case for each function
     IRBuilder builder(dispatchFuncType->getModule());
@@ -298,11 +336,34 @@ IRFunc* createDispatchFunc(
     List<IRInst*> caseValues;
     List<IRBlock*> caseBlocks;
 
-    for (auto kvPair : mapping)
+    // Order the cases by their expected frequency, keeping the order of the mapping for
+    // functions with the same frequency.
+    List<IRInst*> funcTags;
+    for (const auto& [funcTag, _] : mapping)
+        funcTags.add(funcTag);
+    if (frequencyHints && frequencyHints->frequencies.getCount())
+    {
+        Dictionary<IRInst*, Int> frequencies;
+        Dictionary<IRInst*, Index> mappingOrder;
+        for (Index i = 0; i < funcTags.getCount(); i++)
+        {
+            frequencies[funcTags[i]] =
+                frequencyHints->getFrequency(mapping.getValue(funcTags[i]).first);
+            mappingOrder[funcTags[i]] = i;
+        }
+        funcTags.sort(
+            [&](IRInst* a, IRInst* b)
+            {
+                if (frequencies[a] != frequencies[b])
+                    return frequencies[a] > frequencies[b];
+                return mappingOrder[a] < mappingOrder[b];
+            });
+    }
+
+    for (auto funcTag : funcTags)
     {
-        auto funcInst = kvPair.second.first;
-        auto effectiveFuncType = kvPair.second.second;
-        auto funcTag = kvPair.first;
+        auto funcInst = mapping.getValue(funcTag).first;
+        auto effectiveFuncType = mapping.getValue(funcTag).second;
 
         // The different functions in the mapping may have different signatures,
         // so we need to emit a wrapper that marshals the parameters to the expected types for
@@ -597,7 +658,7 @@ struct UntaggedUnionLoweringContext : public InstPassBase
         SlangInt maxSize = 0;
         for (auto type : types)
         {
-            auto size = getAnyValueSize(type, targetProgram->getTargetReq());
+            auto size = getAnyValueSize(type, targetProgram);
             if (size > maxSize)
                 maxSize = size;
 
@@ -948,56 +1009,38 @@ struct SequentialIDTagLoweringContext : public InstPassBase
                 if (inst->findDecoration<IRSequentialIDDecoration>())
                     continue;
 
+                if (shouldUpdateSequentialIDMap)
+                {
+                    static std::atomic<int32_t> uniqueId = 0;
+                    auto currentUniqueId = uniqueId.fetch_add(1, std::memory_order_relaxed) + 1;
+                    generatedMangledName << "_generated_witness_uuid_" << currentUniqueId;
+                    witnessTableMangledName = generatedMangledName.getUnownedSlice();
+                }
+
                 // Get a sequential ID for the witness table using the map from the Linkage.
+                auto& sequentialIDMap = linkage->sequentialIDMap;
                 uint32_t seqID = 0;
+                if (!sequentialIDMap.tryGetID(witnessTableMangledName, seqID))
                 {
-                    // Witness-table sequential ID allocation updates both linkage maps and the
-                    // generated-name counter, so keep the whole lookup/allocation/insertion atomic.
-                    std::lock_guard<std::mutex> lock(linkage->m_sequentialIDMapMutex);
-
-                    if (shouldUpdateSequentialIDMap)
+                    auto interfaceType =
+                        cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
+                    if (as<IRInterfaceType>(interfaceType))
                     {
-                        static std::atomic<int32_t> uniqueId = 0;
-                        auto currentUniqueId = uniqueId.fetch_add(1, std::memory_order_relaxed) + 1;
-                        generatedMangledName << "_generated_witness_uuid_" << currentUniqueId;
-                        witnessTableMangledName = generatedMangledName.getUnownedSlice();
-                    }
-
-                    if (!linkage->mapMangledNameToRTTIObjectIndex.tryGetValue(
+                        auto interfaceLinkage =
+                            interfaceType->findDecoration<IRLinkageDecoration>();
+                        SLANG_ASSERT(
+                            interfaceLinkage &&
+                            "An interface type does not have a linkage,"
+                            "but a witness table associated with it has one.");
+                        seqID = sequentialIDMap.getOrAllocateID(
                             witnessTableMangledName,
-                            seqID))
+                            interfaceLinkage->getMangledName());
+                    }
+                    else
                     {
-                        auto interfaceType =
-                            cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
-                        if (as<IRInterfaceType>(interfaceType))
-                        {
-                            auto interfaceLinkage =
-                                interfaceType->findDecoration<IRLinkageDecoration>();
-                            SLANG_ASSERT(
-                                interfaceLinkage &&
-                                "An interface type does not have a linkage,"
-                                "but a witness table associated with it has one.");
-                            auto interfaceName = interfaceLinkage->getMangledName();
-                            auto idAllocator =
-                                linkage->mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(
-                                    interfaceName);
-                            if (!idAllocator)
-                            {
-                                linkage
-                                    ->mapInterfaceMangledNameToSequentialIDCounters[interfaceName] =
-                                    0;
-                                idAllocator = linkage->mapInterfaceMangledNameToSequentialIDCounters
-                                                  .tryGetValue(interfaceName);
-                            }
-                            seqID = *idAllocator;
-                            ++(*idAllocator);
-                        }
-                        else
-                        {
-                            // NoneWitness, has special ID of -1.
-                            seqID = uint32_t(-1);
-                        }
-                        linkage->mapMangledNameToRTTIObjectIndex[witnessTableMangledName] = seqID;
+                        // NoneWitness, has special ID of -1.
+                        seqID =
+                            sequentialIDMap.getOrAssignID(witnessTableMangledName, uint32_t(-1));
                     }
                 }
 
@@ -45,11 +45,32 @@ void lowerGetDispatcher(
     bool shouldDiagnose,
     List<IRInst*>& newCallees);
 
+// How often each implementation of an interface is expected to be dispatched to, read from a
+// `-dispatch-frequency-hints` file. Each line of the file holds the name of a concrete type,
+// or of one of its methods, and a count, separated by whitespace. Lines starting with `#` are
+// comments.
+struct DispatchFrequencyHints
+{
+    Dictionary<String, Int> frequencies;
+
+    // Parse the hint file `text`. Lines that don't hold a name and a count are ignored.
+    void parse(UnownedStringSlice text);
+
+    // Get the expected frequency of calls to `func`, an implementation of an interface method,
+    // or 0 if there is no hint for it.
+    Int getFrequency(IRInst* func) const;
+};
+
 // Create a dispatch function that switches on a tag (first parameter) to call
 // one of the functions in the mapping.
+//
+// If `frequencyHints` is given, the cases are ordered from the most to the least frequently
+// called, so that downstream compilers lowering the switch to a chain of comparisons test
+// the common cases first.
 IRFunc* createDispatchFunc(
     IRFuncType* dispatchFuncType,
-    Dictionary<IRInst*, std::pair<IRInst*, IRFuncType*>>& mapping);
+    Dictionary<IRInst*, std::pair<IRInst*, IRFuncType*>>& mapping,
+    DispatchFrequencyHints const* frequencyHints = nullptr);
 
 // Report diagnostic information about a dynamic dispatch site.
 void reportDispatchLocation(
@@ -88,7 +88,7 @@ struct ReinterpretLoweringContext
         auto operand = inst->getOperand(0);
         auto fromType = operand->getDataType();
         auto toType = inst->getDataType();
-        SlangInt fromTypeSize = getAnyValueSize(fromType, targetProgram->getTargetReq());
+        SlangInt fromTypeSize = getAnyValueSize(fromType, targetProgram);
         if (fromTypeSize < 0)
         {
             sink->diagnose(Diagnostics::TypeCannotBePackedIntoAnyValue{
@@ -96,7 +96,7 @@ struct ReinterpretLoweringContext
                 .location = inst->sourceLoc,
             });
         }
-        SlangInt toTypeSize = getAnyValueSize(toType, targetProgram->getTargetReq());
+        SlangInt toTypeSize = getAnyValueSize(toType, targetProgram);
         if (toTypeSize < 0)
         {
             sink->diagnose(Diagnostics::TypeCannotBePackedIntoAnyValue{
@@ -75,14 +75,14 @@ struct ResultTypeLoweringContext
         auto valueType = resultType->getValueType();
         if (valueType->getOp() != kIROp_VoidType)
         {
-            anyValueSize = getAnyValueSize(valueType, targetProgram->getTargetReq());
+            anyValueSize = getAnyValueSize(valueType, targetProgram);
             info->valueType = valueType;
         }
 
         auto errorType = resultType->getErrorType();
         info->errorType = errorType;
 
-        auto errSize = getAnyValueSize(errorType, targetProgram->getTargetReq());
+        auto errSize = getAnyValueSize(errorType, targetProgram);
         if (errSize > anyValueSize)
             anyValueSize = errSize;
 
@@ -0,0 +1,238 @@
+// slang-ir-narrow-half-arithmetic.cpp
+#include "slang-ir-narrow-half-arithmetic.h"
+
+#include "../core/slang-math.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct HalfArithmeticNarrowingContext
+{
+    IRModule* module;
+
+    // The arithmetic insts of the current function that can be performed at `half` precision.
+    HashSet<IRInst*> candidates;
+    List<IRInst*> candidateList;
+
+    // The `half` value that replaces each candidate or input of a candidate.
+    Dictionary<IRInst*, IRInst*> mapToNarrowed;
+
+    // Get the `half` counterpart of `type`, if it is `float` or a vector of `float`.
+    IRType* getNarrowedType(IRBuilder& builder, IRType* type)
+    {
+        if (!type)
+            return nullptr;
+        if (type->getOp() == kIROp_FloatType)
+            return builder.getBasicType(BaseType::Half);
+        if (auto vectorType = as<IRVectorType>(type))
+        {
+            if (vectorType->getElementType()->getOp() != kIROp_FloatType)
+                return nullptr;
+            return builder.getVectorType(
+                builder.getBasicType(BaseType::Half),
+                vectorType->getElementCount());
+        }
+        return nullptr;
+    }
+
+    static bool isNarrowableOp(IROp op)
+    {
+        switch (op)
+        {
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_Neg:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Is `inst` a `half` value widened to `float`, or a `float` constant that `half`
+    // represents exactly?
+    bool isHalfInput(IRBuilder& builder, IRInst* inst)
+    {
+        if (auto cast = as<IRFloatCast>(inst))
+        {
+            auto narrowedType = getNarrowedType(builder, cast->getDataType());
+            return narrowedType && cast->getOperand(0)->getDataType() == narrowedType;
+        }
+        if (auto floatLit = as<IRFloatLit>(inst))
+        {
+            if (floatLit->getDataType()->getOp() != kIROp_FloatType)
+                return false;
+            float value = float(floatLit->getValue());
+            return HalfToFloat(FloatToHalf(value)) == value;
+        }
+        return false;
+    }
+
+    // Is `use` the operand of a conversion of the candidate it uses to `half`?
+    bool isNarrowingUse(IRBuilder& builder, IRUse* use)
+    {
+        auto cast = as<IRFloatCast>(use->getUser());
+        return cast && cast->getDataType() == getNarrowedType(builder, use->get()->getDataType());
+    }
+
+    bool canStayCandidate(IRBuilder& builder, IRInst* inst)
+    {
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand = inst->getOperand(i);
+            if (operand->getDataType() != inst->getDataType())
+                return false;
+            if (!candidates.contains(operand) && !isHalfInput(builder, operand))
+                return false;
+        }
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (!candidates.contains(use->getUser()) && !isNarrowingUse(builder, use))
+                return false;
+        }
+        return true;
+    }
+
+    void findCandidates(IRBuilder& builder, IRFunc* func)
+    {
+        candidates.clear();
+        candidateList.clear();
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (isNarrowableOp(inst->getOp()) &&
+                    getNarrowedType(builder, inst->getDataType()))
+                {
+                    candidates.add(inst);
+                    candidateList.add(inst);
+                }
+            }
+        }
+
+        // Start from the assumption that every arithmetic inst can be narrowed, and drop the
+        // ones with an input or a use that can't, until the remaining set is consistent.
+        List<IRInst*> workList = candidateList;
+        while (workList.getCount())
+        {
+            auto inst = workList.getLast();
+            workList.removeLast();
+            if (!candidates.contains(inst) || canStayCandidate(builder, inst))
+                continue;
+
+            candidates.remove(inst);
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                if (candidates.contains(inst->getOperand(i)))
+                    workList.add(inst->getOperand(i));
+            }
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                if (candidates.contains(use->getUser()))
+                    workList.add(use->getUser());
+            }
+        }
+    }
+
+    IRInst* getNarrowed(IRBuilder& builder, IRInst* inst)
+    {
+        if (auto narrowed = mapToNarrowed.tryGetValue(inst))
+            return *narrowed;
+
+        IRInst* result = nullptr;
+        auto narrowedType = getNarrowedType(builder, inst->getDataType());
+        if (auto cast = as<IRFloatCast>(inst))
+        {
+            result = cast->getOperand(0);
+        }
+        else if (auto floatLit = as<IRFloatLit>(inst))
+        {
+            result = builder.getFloatValue(narrowedType, floatLit->getValue());
+        }
+        else
+        {
+            List<IRInst*> operands;
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+                operands.add(getNarrowed(builder, inst->getOperand(i)));
+
+            // The operands are emitted before the insts that use them, so the narrowed
+            // arithmetic can take the place of the original.
+            builder.setInsertBefore(inst);
+            result = builder.emitIntrinsicInst(
+                narrowedType,
+                inst->getOp(),
+                operands.getCount(),
+                operands.getBuffer());
+        }
+        mapToNarrowed.add(inst, result);
+        return result;
+    }
+
+    bool processFunc(IRFunc* func)
+    {
+        IRBuilder builder(module);
+        findCandidates(builder, func);
+
+        // Replace each conversion of a candidate to `half` with the narrowed candidate.
+        List<IRInst*> narrowingCasts;
+        for (auto inst : candidateList)
+        {
+            if (!candidates.contains(inst))
+                continue;
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                if (!candidates.contains(use->getUser()))
+                    narrowingCasts.add(use->getUser());
+            }
+        }
+        if (narrowingCasts.getCount() == 0)
+            return false;
+
+        mapToNarrowed.clear();
+        for (auto cast : narrowingCasts)
+        {
+            cast->replaceUsesWith(getNarrowed(builder, cast->getOperand(0)));
+            cast->removeAndDeallocate();
+        }
+
+        // The original candidates are now only used by each other. Remove the ones without
+        // uses until none are left, since removing one can leave its operands without uses.
+        for (bool removedAny = true; removedAny;)
+        {
+            removedAny = false;
+            for (auto inst : candidateList)
+            {
+                if (!candidates.contains(inst) || inst->hasUses())
+                    continue;
+                candidates.remove(inst);
+                inst->removeAndDeallocate();
+                removedAny = true;
+            }
+        }
+        return true;
+    }
+
+    bool processModule()
+    {
+        bool changed = false;
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto func = as<IRFunc>(inst))
+                changed |= processFunc(func);
+        }
+        return changed;
+    }
+};
+
+bool narrowArithmeticToHalf(IRModule* module)
+{
+    HalfArithmeticNarrowingContext context;
+    context.module = module;
+    return context.processModule();
+}
+
+} // namespace Slang
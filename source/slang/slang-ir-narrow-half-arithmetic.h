@@ -0,0 +1,25 @@
+// slang-ir-narrow-half-arithmetic.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Perform `float` arithmetic at `half` precision where its result is only wanted as a `half`.
+///
+/// Code that stores its data as `half` but computes with `float`, as in
+/// `half r = half(float(a) * float(b) + 1.0)`, widens every input, does the arithmetic at
+/// full precision and rounds the result back. This pass finds additions, subtractions,
+/// multiplications, divisions and negations whose inputs are `half` values widened to
+/// `float` (or constants that `half` represents exactly, or other such arithmetic), and whose
+/// results are only used by conversions back to `half` (or by other such arithmetic), and
+/// rewrites them to operate on `half` directly. Vector arithmetic becomes arithmetic on
+/// vectors of `half`, which targets with packed 16-bit math execute two lanes at a time.
+///
+/// The intermediate results are rounded to `half` instead of only the final one, so this
+/// changes the results of the program within the precision of `half`, and must only be
+/// run when that has been asked for.
+///
+/// Returns true if any arithmetic was narrowed.
+bool narrowArithmeticToHalf(IRModule* module);
+} // namespace Slang
@@ -0,0 +1,78 @@
+// slang-ir-pass-scratch.cpp
+#include "slang-ir-pass-scratch.h"
+
+#include <cstddef>
+#include <stdlib.h>
+
+namespace Slang
+{
+
+// The arena of the outermost `PassScratch` that is alive on this thread.
+static thread_local MemoryArena* tl_activePassScratchArena = nullptr;
+
+// Every allocation starts with a header recording where it came from, so that freeing it
+// after its `PassScratch` has become active (or while no scope is active) does the right
+// thing. The header is as large as the strictest fundamental alignment, so the payload
+// stays aligned.
+//
+enum class PassScratchAllocationKind : size_t
+{
+    Heap,
+    Arena,
+};
+
+static const size_t kPassScratchHeaderSize = alignof(std::max_align_t);
+
+PassScratch::PassScratch()
+{
+    if (!tl_activePassScratchArena)
+    {
+        m_arena.init(64 * 1024, kPassScratchHeaderSize);
+        tl_activePassScratchArena = &m_arena;
+        m_isOutermost = true;
+    }
+}
+
+PassScratch::~PassScratch()
+{
+    if (m_isOutermost)
+        tl_activePassScratchArena = nullptr;
+}
+
+MemoryArena* PassScratch::getActiveArena()
+{
+    return tl_activePassScratchArena;
+}
+
+void* PassScratchAllocator::allocate(size_t size)
+{
+    const size_t allocSize = size + kPassScratchHeaderSize;
+
+    void* alloc;
+    PassScratchAllocationKind kind;
+    if (auto arena = tl_activePassScratchArena)
+    {
+        alloc = arena->allocateAligned(allocSize, kPassScratchHeaderSize);
+        kind = PassScratchAllocationKind::Arena;
+    }
+    else
+    {
+        alloc = ::malloc(allocSize);
+        kind = PassScratchAllocationKind::Heap;
+    }
+
+    *(PassScratchAllocationKind*)alloc = kind;
+    return (char*)alloc + kPassScratchHeaderSize;
+}
+
+void PassScratchAllocator::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    void* alloc = (char*)ptr - kPassScratchHeaderSize;
+    if (*(PassScratchAllocationKind*)alloc == PassScratchAllocationKind::Heap)
+        ::free(alloc);
+}
+
+} // namespace Slang
@@ -0,0 +1,61 @@
+// slang-ir-pass-scratch.h
+#pragma once
+
+#include "../core/slang-list.h"
+#include "../core/slang-memory-arena.h"
+
+namespace Slang
+{
+
+/// A scope in which the transient containers of a pass allocate from a single memory arena.
+///
+/// While a `PassScratch` is alive on a thread, every buffer that a `ScratchList` on that
+/// thread asks for comes from the arena of the outermost live `PassScratch`, and freeing
+/// such a buffer does nothing. The whole arena is released at once when the outermost
+/// `PassScratch` ends. Nested scopes share the outermost arena, so a list that grows while
+/// a nested pass runs stays valid until the outer pass is done.
+///
+/// A `ScratchList` must not outlive the outermost `PassScratch` that was alive when it
+/// grew, so declare the `PassScratch` before any of the lists it serves.
+///
+struct PassScratch
+{
+    PassScratch();
+    ~PassScratch();
+
+    PassScratch(const PassScratch&) = delete;
+    PassScratch& operator=(const PassScratch&) = delete;
+
+    /// Get the arena of the outermost live `PassScratch` on this thread, if any.
+    static MemoryArena* getActiveArena();
+
+private:
+    MemoryArena m_arena;
+    bool m_isOutermost = false;
+};
+
+/// An allocator for `List` that takes memory from the active `PassScratch`, and falls
+/// back to the heap when no `PassScratch` is alive.
+///
+class PassScratchAllocator
+{
+public:
+    void* allocate(size_t size);
+    void deallocate(void* ptr);
+};
+
+/// A `List` for the work lists and temporary arrays of a pass.
+///
+/// The buffer of a `ScratchList` can only be freed by `PassScratchAllocator`, so it can't be
+/// copied or moved to or from a plain `List`, or to another `ScratchList`.
+///
+template<typename T>
+class ScratchList : public List<T, PassScratchAllocator>
+{
+public:
+    ScratchList() = default;
+    ScratchList(const ScratchList&) = delete;
+    ScratchList& operator=(const ScratchList&) = delete;
+};
+
+} // namespace Slang
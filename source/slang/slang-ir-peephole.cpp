@@ -1238,6 +1238,19 @@ struct PeepholeContext : InstPassBase
                     maybeRemoveOldInst(inst);
                     changed = true;
                 }
+                // Pack(Unpack(obj: anyValueN)) : anyValueN --> obj
+                // The value packed into `obj` must have the type it was unpacked to, so
+                // repacking it into the same layout gives back the same value.
+                else if (
+                    inst->getOperand(0)->getOp() == kIROp_UnpackAnyValue &&
+                    isTypeEqual(
+                        inst->getOperand(0)->getOperand(0)->getDataType(),
+                        inst->getDataType()))
+                {
+                    inst->replaceUsesWith(inst->getOperand(0)->getOperand(0));
+                    maybeRemoveOldInst(inst);
+                    changed = true;
+                }
             }
             break;
         case kIROp_GetOptionalValue:
@@ -1966,10 +1979,11 @@ bool peepholeOptimize(TargetProgram* target, IRModule* module, PeepholeOptimizat
     return context.processModule();
 }
 
-bool peepholeOptimize(TargetProgram* target, IRInst* func)
+bool peepholeOptimize(TargetProgram* target, IRInst* func, PeepholeOptimizationOptions options)
 {
     PeepholeContext context = PeepholeContext(func->getModule());
     context.targetProgram = target;
+    context.isPrelinking = options.isPrelinking;
     context.useFastAnalysis =
         target ? target->getOptionSet().shouldPerformMinimumOptimizations() : true;
     return context.processFunc(func);
@@ -2002,6 +2016,42 @@ bool peepholeOptimizeGlobalScope(TargetProgram* target, IRModule* module)
     return result;
 }
 
+bool peepholeOptimizeGlobalInsts(
+    TargetProgram* target,
+    IRModule* module,
+    List<IRInst*> const& insts)
+{
+    PeepholeContext context = PeepholeContext(module);
+    context.targetProgram = target;
+    context.useFastAnalysis = true;
+
+    auto moduleInst = module->getModuleInst();
+    auto& changedInsts = module->getChangedGlobalInsts();
+    List<IRInst*> workList = insts;
+    bool result = false;
+    while (workList.getCount())
+    {
+        Index changedCount = changedInsts.getCount();
+        context.changed = false;
+        for (auto inst : workList)
+        {
+            // Skip the instructions that have been removed since they changed.
+            if (inst->getParent() == moduleInst)
+                context.processInst(inst);
+        }
+        result |= context.changed;
+        if (!context.changed)
+            break;
+
+        // Where the full pass would look at every global instruction again, look at the
+        // ones that the changes above inserted or gave new operands.
+        workList.clear();
+        for (Index i = changedCount; i < changedInsts.getCount(); i++)
+            workList.add(changedInsts[i]);
+    }
+    return result;
+}
+
 bool tryReplaceInstUsesWithSimplifiedValue(TargetProgram* target, IRModule* module, IRInst* inst)
 {
     if (inst != tryConstantFoldInst(module, target, inst))
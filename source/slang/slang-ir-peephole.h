@@ -1,6 +1,8 @@
 // slang-ir-peephole.h
 #pragma once
 
+#include "../core/slang-list.h"
+
 namespace Slang
 {
 struct IRModule;
@@ -21,8 +23,22 @@ struct PeepholeOptimizationOptions
 
 /// Apply peephole optimizations.
 bool peepholeOptimize(TargetProgram* target, IRModule* module, PeepholeOptimizationOptions options);
-bool peepholeOptimize(TargetProgram* target, IRInst* func);
+bool peepholeOptimize(
+    TargetProgram* target,
+    IRInst* func,
+    PeepholeOptimizationOptions options = PeepholeOptimizationOptions());
 bool peepholeOptimizeInst(TargetProgram* target, IRModule* module, IRInst* inst);
 bool peepholeOptimizeGlobalScope(TargetProgram* target, IRModule* module);
+
+/// Apply the peephole optimizations of `peepholeOptimizeGlobalScope` to just the global
+/// instructions in `insts`, and to the global instructions that change as a result.
+///
+/// `module` must be tracking changed global instructions (see
+/// `IRModule::beginTrackingChangedGlobalInsts`), and `insts` should hold the ones that
+/// changed since the global scope was last optimized in full.
+bool peepholeOptimizeGlobalInsts(
+    TargetProgram* target,
+    IRModule* module,
+    List<IRInst*> const& insts);
 bool tryReplaceInstUsesWithSimplifiedValue(TargetProgram* target, IRModule* module, IRInst* inst);
 } // namespace Slang
@@ -0,0 +1,493 @@
+// slang-ir-ray-payload-liveness.cpp
+#include "slang-ir-ray-payload-liveness.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+#include "slang-rich-diagnostics.h"
+
+namespace Slang
+{
+
+struct RayPayloadLivenessContext
+{
+    // The fields of a payload type that shaders access.
+    struct FieldUsage
+    {
+        HashSet<IRInst*> keys;
+
+        // Set when the payload is used in a way that isn't understood, which makes every
+        // field live.
+        bool allFieldsLive = false;
+
+        void addUsage(FieldUsage const& other)
+        {
+            allFieldsLive |= other.allFieldsLive;
+            for (auto key : other.keys)
+                keys.add(key);
+        }
+
+        bool isLive(IRStructField* field) const
+        {
+            return allFieldsLive || keys.contains(field->getKey());
+        }
+    };
+
+    // The payload parameter of a closest-hit, any-hit or miss shader.
+    struct PayloadParam
+    {
+        IRFunc* entryPoint;
+        IRParam* param;
+        IRStructType* payloadType;
+        FieldUsage usage;
+    };
+
+    IRModule* module;
+    TargetRequest* targetReq;
+    DiagnosticSink* sink;
+    RayPayloadLivenessOptions options;
+
+    List<PayloadParam> payloadParams;
+    Dictionary<IRStructType*, FieldUsage> typeUsages;
+
+    // The parameters of the functions a payload is passed to, which have been analyzed for
+    // the current shader.
+    HashSet<IRInst*> visitedParams;
+
+    // The insts that pass a payload to a `TraceRay` style call. For D3D the payload variable
+    // is wrapped in a `ForceVarIntoRayPayloadStructTemporarily`, and for Vulkan it is copied
+    // through a global variable with a `VulkanRayPayloadDecoration`.
+    List<IRInst*> forcedPayloads;
+    List<IRGlobalVar*> vulkanPayloadVars;
+
+    // The payload types with at least one call site, and those with call sites that can't be
+    // rewritten.
+    HashSet<IRStructType*> tracedTypes;
+    HashSet<IRStructType*> unrewritableTypes;
+
+    // The minimized type that replaces each payload type.
+    Dictionary<IRStructType*, IRStructType*> minimizedTypes;
+
+    static IRStructType* getPointedToStructType(IRInst* ptr)
+    {
+        auto ptrType = as<IRPtrTypeBase>(ptr->getDataType());
+        return ptrType ? as<IRStructType>(ptrType->getValueType()) : nullptr;
+    }
+
+    static Index getFieldCount(IRStructType* type)
+    {
+        Index count = 0;
+        for (auto field : type->getFields())
+        {
+            SLANG_UNUSED(field);
+            count++;
+        }
+        return count;
+    }
+
+    // Collect the fields accessed through `ptr`. Calls are followed into the callee, unless
+    // `allowCalls` is false because the shader can end without returning from them.
+    void collectFieldUses(IRInst* ptr, FieldUsage& usage, bool allowCalls)
+    {
+        for (auto use = ptr->firstUse; use && !usage.allFieldsLive; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+            case kIROp_FieldAddress:
+                if (use == user->getOperands())
+                    usage.keys.add(as<IRFieldAddress>(user)->getField());
+                else
+                    usage.allFieldsLive = true;
+                break;
+            case kIROp_Load:
+                for (auto valueUse = user->firstUse; valueUse; valueUse = valueUse->nextUse)
+                {
+                    auto extract = as<IRFieldExtract>(valueUse->getUser());
+                    if (extract && valueUse == extract->getOperands())
+                        usage.keys.add(extract->getField());
+                    else
+                        usage.allFieldsLive = true;
+                }
+                break;
+            case kIROp_Call:
+                {
+                    auto call = as<IRCall>(user);
+                    auto callee = as<IRFunc>(call->getCallee());
+                    if (!allowCalls || use == call->getCalleeUse() || !callee ||
+                        !callee->getFirstBlock())
+                    {
+                        usage.allFieldsLive = true;
+                        break;
+                    }
+                    auto param = callee->getFirstParam();
+                    for (UInt i = 0; i < call->getArgCount() && param; i++)
+                    {
+                        if (call->getArg(i) == ptr && visitedParams.add(param))
+                            collectFieldUses(param, usage, allowCalls);
+                        param = param->getNextParam();
+                    }
+                }
+                break;
+            default:
+                usage.allFieldsLive = true;
+                break;
+            }
+        }
+    }
+
+    void collectPayloadParams()
+    {
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(globalInst);
+            if (!func || !func->getFirstBlock())
+                continue;
+            auto entryPointDecor = func->findDecoration<IREntryPointDecoration>();
+            if (!entryPointDecor)
+                continue;
+            auto stage = entryPointDecor->getProfile().getStage();
+            if (stage != Stage::ClosestHit && stage != Stage::AnyHit && stage != Stage::Miss)
+                continue;
+
+            for (auto param : func->getParams())
+            {
+                auto varLayout = findVarLayout(param);
+                if (!varLayout || !varLayout->usesResourceKind(LayoutResourceKind::RayPayload))
+                    continue;
+                auto payloadType = getPointedToStructType(param);
+                if (!payloadType)
+                    continue;
+
+                PayloadParam payloadParam;
+                payloadParam.entryPoint = func;
+                payloadParam.param = param;
+                payloadParam.payloadType = payloadType;
+
+                // An any-hit shader ends at a call to `IgnoreHit` or `AcceptHitAndEndSearch`,
+                // so the payload can't be handed to a callee through a temporary.
+                visitedParams.clear();
+                collectFieldUses(param, payloadParam.usage, stage != Stage::AnyHit);
+
+                typeUsages[payloadType].addUsage(payloadParam.usage);
+                payloadParams.add(payloadParam);
+            }
+        }
+    }
+
+    bool canRewriteForcedPayload(IRInst* forced)
+    {
+        if (!as<IRPtrTypeBase>(forced->getDataType()))
+            return false;
+        for (auto use = forced->firstUse; use; use = use->nextUse)
+        {
+            if (!as<IRCall>(use->getUser()))
+                return false;
+        }
+        return true;
+    }
+
+    // Collect the insts that trace a ray with the Vulkan payload variable `var`. Returns false
+    // if `var` is used in any other way than by them and by loads and stores in functions.
+    bool collectVulkanTraceInsts(IRGlobalVar* var, List<IRInst*>& outTraceInsts)
+    {
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (!getParentFunc(user))
+                return false;
+            switch (user->getOp())
+            {
+            case kIROp_Store:
+                if (use != as<IRStore>(user)->getPtrUse())
+                    return false;
+                break;
+            case kIROp_Load:
+                break;
+            case kIROp_SPIRVAsmOperandInst:
+                {
+                    auto asmInst = user->getParent();
+                    while (asmInst && !as<IRSPIRVAsm>(asmInst))
+                        asmInst = asmInst->getParent();
+                    if (!asmInst)
+                        return false;
+                    if (!outTraceInsts.contains(asmInst))
+                        outTraceInsts.add(asmInst);
+                }
+                break;
+            case kIROp_GetVulkanRayTracingPayloadLocation:
+                for (auto locationUse = user->firstUse; locationUse;
+                     locationUse = locationUse->nextUse)
+                {
+                    auto call = as<IRCall>(locationUse->getUser());
+                    if (!call)
+                        return false;
+                    if (!outTraceInsts.contains(call))
+                        outTraceInsts.add(call);
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void collectCallSites()
+    {
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            if (auto var = as<IRGlobalVar>(globalInst))
+            {
+                if (!var->findDecoration<IRVulkanRayPayloadDecoration>())
+                    continue;
+                auto payloadType = getPointedToStructType(var);
+                if (!payloadType)
+                    continue;
+                tracedTypes.add(payloadType);
+                List<IRInst*> traceInsts;
+                if (collectVulkanTraceInsts(var, traceInsts))
+                    vulkanPayloadVars.add(var);
+                else
+                    unrewritableTypes.add(payloadType);
+                continue;
+            }
+
+            auto func = as<IRFunc>(globalInst);
+            if (!func)
+                continue;
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                {
+                    if (inst->getOp() != kIROp_ForceVarIntoRayPayloadStructTemporarily)
+                        continue;
+                    auto payloadType = getPointedToStructType(inst->getOperand(0));
+                    if (!payloadType)
+                        continue;
+                    tracedTypes.add(payloadType);
+                    if (canRewriteForcedPayload(inst))
+                        forcedPayloads.add(inst);
+                    else
+                        unrewritableTypes.add(payloadType);
+                }
+            }
+        }
+    }
+
+    IRStructType* createMinimizedType(IRStructType* type, FieldUsage const& usage)
+    {
+        IRBuilder builder(module);
+        builder.setInsertBefore(type);
+        auto newType = builder.createStructType();
+        if (auto nameHint = type->findDecoration<IRNameHintDecoration>())
+            builder.addNameHintDecoration(newType, nameHint->getName());
+        if (type->findDecoration<IRRayPayloadDecoration>())
+            builder.addRayPayloadDecoration(newType);
+
+        // The fields keep their keys, so accesses to them don't need to change. At least one
+        // field is kept, since an empty payload isn't legal for every target.
+        bool isFirstField = true;
+        for (auto field : type->getFields())
+        {
+            if (usage.isLive(field) || (isFirstField && usage.keys.getCount() == 0))
+                builder.createStructField(newType, field->getKey(), field->getFieldType());
+            isFirstField = false;
+        }
+        return newType;
+    }
+
+    // Copy the fields of `fieldsType` from the struct at `src` to the struct at `dst`.
+    void copyFields(IRBuilder& builder, IRInst* dst, IRInst* src, IRStructType* fieldsType)
+    {
+        for (auto field : fieldsType->getFields())
+        {
+            auto value = builder.emitLoad(builder.emitFieldAddress(src, field->getKey()));
+            builder.emitStore(builder.emitFieldAddress(dst, field->getKey()), value);
+        }
+    }
+
+    void rewritePayloadParam(PayloadParam const& payloadParam, IRStructType* newType)
+    {
+        auto param = payloadParam.param;
+        IRBuilder builder(module);
+        auto ptrType = as<IRPtrTypeBase>(param->getDataType());
+        param->setFullType(builder.getPtrTypeWithAddressSpace(newType, ptrType));
+
+        HashSet<IRInst*> users;
+        for (auto use = param->firstUse; use; use = use->nextUse)
+            users.add(use->getUser());
+        for (auto user : users)
+        {
+            if (auto load = as<IRLoad>(user))
+            {
+                load->setFullType(newType);
+                continue;
+            }
+
+            // Callees take the full payload type, so they are given a temporary that holds
+            // the live fields for the duration of the call.
+            auto call = as<IRCall>(user);
+            if (!call)
+                continue;
+            builder.setInsertBefore(call);
+            auto temp = builder.emitVar(payloadParam.payloadType);
+            copyFields(builder, temp, param, newType);
+            for (UInt i = 0; i < call->getArgCount(); i++)
+            {
+                if (call->getArg(i) == param)
+                    call->setArg(i, temp);
+            }
+            builder.setInsertAfter(call);
+            copyFields(builder, param, temp, newType);
+        }
+        fixUpFuncType(payloadParam.entryPoint);
+    }
+
+    void rewriteForcedPayload(IRInst* forced, IRStructType* newType)
+    {
+        IRBuilder builder(module);
+        auto payloadPtr = forced->getOperand(0);
+        builder.setInsertBefore(forced);
+        auto temp = builder.emitVar(newType);
+        copyFields(builder, temp, payloadPtr, newType);
+        forced->setOperand(0, temp);
+        forced->setFullType(builder.getPtrTypeWithAddressSpace(
+            newType,
+            as<IRPtrTypeBase>(forced->getDataType())));
+
+        for (auto use = forced->firstUse; use; use = use->nextUse)
+        {
+            builder.setInsertAfter(use->getUser());
+            copyFields(builder, payloadPtr, temp, newType);
+        }
+    }
+
+    void rewriteVulkanPayloadVar(IRGlobalVar* var, IRStructType* newType)
+    {
+        auto payloadType = getPointedToStructType(var);
+        List<IRInst*> traceInsts;
+        collectVulkanTraceInsts(var, traceInsts);
+
+        // The functions that trace with the variable access the payload through a local
+        // variable of the full type instead, and only the live fields are copied to and from
+        // the global around each trace. The other fields keep the caller's values.
+        IRBuilder builder(module);
+        Dictionary<IRFunc*, IRInst*> localVars;
+        auto getLocalVar = [&](IRInst* inst) -> IRInst*
+        {
+            auto func = getParentFunc(inst);
+            if (auto localVar = localVars.tryGetValue(func))
+                return *localVar;
+            builder.setInsertBefore(func->getFirstBlock()->getFirstOrdinaryInst());
+            auto localVar = builder.emitVar(payloadType);
+            localVars[func] = localVar;
+            return localVar;
+        };
+
+        List<IRInst*> accesses;
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            if (as<IRLoad>(use->getUser()) || as<IRStore>(use->getUser()))
+                accesses.add(use->getUser());
+        }
+        for (auto access : accesses)
+            access->setOperand(0, getLocalVar(access));
+
+        var->setFullType(
+            builder.getPtrTypeWithAddressSpace(newType, as<IRPtrTypeBase>(var->getDataType())));
+        for (auto traceInst : traceInsts)
+        {
+            auto localVar = getLocalVar(traceInst);
+            builder.setInsertBefore(traceInst);
+            copyFields(builder, var, localVar, newType);
+            builder.setInsertAfter(traceInst);
+            copyFields(builder, localVar, var, newType);
+        }
+    }
+
+    void minimizePayloads()
+    {
+        collectCallSites();
+
+        for (auto& [payloadType, usage] : typeUsages)
+        {
+            if (usage.allFieldsLive || !tracedTypes.contains(payloadType) ||
+                unrewritableTypes.contains(payloadType))
+                continue;
+            Index liveFieldCount = 0;
+            for (auto field : payloadType->getFields())
+                liveFieldCount += usage.isLive(field) ? 1 : 0;
+            if (liveFieldCount == getFieldCount(payloadType))
+                continue;
+            minimizedTypes[payloadType] = createMinimizedType(payloadType, usage);
+        }
+        if (minimizedTypes.getCount() == 0)
+            return;
+
+        for (auto& payloadParam : payloadParams)
+        {
+            if (auto newType = minimizedTypes.tryGetValue(payloadParam.payloadType))
+                rewritePayloadParam(payloadParam, *newType);
+        }
+        for (auto forced : forcedPayloads)
+        {
+            auto payloadType = getPointedToStructType(forced->getOperand(0));
+            if (auto newType = minimizedTypes.tryGetValue(payloadType))
+                rewriteForcedPayload(forced, *newType);
+        }
+        for (auto var : vulkanPayloadVars)
+        {
+            if (auto newType = minimizedTypes.tryGetValue(getPointedToStructType(var)))
+                rewriteVulkanPayloadVar(var, *newType);
+        }
+    }
+
+    void reportRegisters()
+    {
+        for (auto& payloadParam : payloadParams)
+        {
+            auto payloadType = payloadParam.payloadType;
+            Index liveFieldCount = 0;
+            for (auto field : payloadType->getFields())
+                liveFieldCount += payloadParam.usage.isLive(field) ? 1 : 0;
+
+            IRStructType* passedType = payloadType;
+            if (auto newType = minimizedTypes.tryGetValue(payloadType))
+                passedType = *newType;
+            IRSizeAndAlignment sizeAndAlignment;
+            getNaturalSizeAndAlignment(targetReq, passedType, &sizeAndAlignment);
+
+            Diagnostics::ReportRayPayloadRegisters diagnostic;
+            diagnostic.entryPoint = payloadParam.entryPoint;
+            diagnostic.payloadType = payloadType;
+            diagnostic.liveFieldCount = (int64_t)liveFieldCount;
+            diagnostic.fieldCount = (int64_t)getFieldCount(payloadType);
+            diagnostic.registerCount = (int64_t)((sizeAndAlignment.size + 3) / 4);
+            diagnostic.location = payloadParam.entryPoint->sourceLoc;
+            sink->diagnose(diagnostic);
+        }
+    }
+};
+
+void applyRayPayloadLiveness(
+    IRModule* module,
+    TargetRequest* targetReq,
+    DiagnosticSink* sink,
+    RayPayloadLivenessOptions const& options)
+{
+    RayPayloadLivenessContext context;
+    context.module = module;
+    context.targetReq = targetReq;
+    context.sink = sink;
+    context.options = options;
+
+    context.collectPayloadParams();
+    if (options.minimizePayloads)
+        context.minimizePayloads();
+    if (options.reportRegisters)
+        context.reportRegisters();
+}
+
+} // namespace Slang
@@ -0,0 +1,37 @@
+// slang-ir-ray-payload-liveness.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+class TargetRequest;
+
+struct RayPayloadLivenessOptions
+{
+    /// Drop the fields of each ray payload type that no closest-hit, any-hit or miss shader in
+    /// the module reads or writes. This assumes every shader a payload reaches is in the
+    /// module, so it must only be enabled for whole-pipeline compiles.
+    bool minimizePayloads = false;
+
+    /// Report the live fields and payload registers of the payload of each closest-hit,
+    /// any-hit and miss shader.
+    bool reportRegisters = false;
+};
+
+/// Find the fields of each ray payload type that the closest-hit, any-hit and miss shaders
+/// of the module access, following the payload into the functions it is passed to.
+///
+/// When minimizing, the shaders and the `TraceRay` style calls that pass a payload type
+/// are rewritten to use a payload type with only those fields. The caller's values of the
+/// other fields stay in its own variable across the call, which is what it would have read
+/// back since no shader writes them.
+///
+/// Payloads are only rewritten for the D3D and Vulkan ray tracing forms of the calls, before
+/// the target legalization that lowers them.
+void applyRayPayloadLiveness(
+    IRModule* module,
+    TargetRequest* targetReq,
+    DiagnosticSink* sink,
+    RayPayloadLivenessOptions const& options);
+} // namespace Slang
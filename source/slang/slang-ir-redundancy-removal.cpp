@@ -322,7 +322,7 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func, bool hoistLoopInvariant
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    context.dom = findOrComputeDominatorTree(func);
     Dictionary<IRBlock*, DeduplicateContext> mapBlockToDeduplicateContext;
     for (auto block : func->getBlocks())
     {
@@ -359,8 +359,12 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func, bool hoistLoopInvariant
 
 // Remove IR definitions from all AvailableInDownstreamIR functions where the
 // languages match what we're currently targetting,  as these functions are
-// already defined in the embedded precompiled library.
-void removeAvailableInDownstreamModuleDecorations(IRModule* module, CodeGenTarget target)
+// already defined in the embedded precompiled library. Code precompiled with
+// different options (`optionsKey`) isn't linked in, so those functions are kept.
+void removeAvailableInDownstreamModuleDecorations(
+    IRModule* module,
+    CodeGenTarget target,
+    UInt64 optionsKey)
 {
     List<IRInst*> toRemove;
     auto builder = IRBuilder(module);
@@ -370,8 +374,11 @@ void removeAvailableInDownstreamModuleDecorations(IRModule* module, CodeGenTarge
         {
             if (auto dec = globalInst->findDecoration<IRAvailableInDownstreamIRDecoration>())
             {
-                if ((dec->getTarget() == CodeGenTarget::DXIL && target == CodeGenTarget::HLSL) ||
-                    (dec->getTarget() == target))
+                const bool targetMatches =
+                    (dec->getTarget() == CodeGenTarget::DXIL && target == CodeGenTarget::HLSL) ||
+                    (dec->getTarget() == target);
+                const auto key = dec->getOptionsKey();
+                if (targetMatches && (key == 0 || key == optionsKey))
                 {
                     // Gut the function definition, turning it into a declaration
                     for (auto block : funcInst->getBlocks())
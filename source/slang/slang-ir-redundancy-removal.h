@@ -12,5 +12,8 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func, bool hoistLoopInvariant
 
 bool eliminateRedundantLoadStore(IRGlobalValueWithCode* func);
 
-void removeAvailableInDownstreamModuleDecorations(IRModule* module, CodeGenTarget target);
+void removeAvailableInDownstreamModuleDecorations(
+    IRModule* module,
+    CodeGenTarget target,
+    UInt64 optionsKey);
 } // namespace Slang
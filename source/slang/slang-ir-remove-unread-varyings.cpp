@@ -0,0 +1,185 @@
+// slang-ir-remove-unread-varyings.cpp
+#include "slang-ir-remove-unread-varyings.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct UnreadVaryingRemovalContext
+{
+    IRModule* module;
+
+    // The stage of each entry point.
+    Dictionary<IRInst*, Stage> mapFuncToStage;
+
+    // The ranges of locations read by the fragment shaders.
+    struct LocationRange
+    {
+        UInt begin;
+        UInt end;
+    };
+    List<LocationRange> fragmentInputRanges;
+
+    // Get the user-defined varying of `kind` that `inst` declares, and the locations it
+    // occupies.
+    static bool getVaryingLocations(
+        IRInst* inst,
+        AddressSpace addressSpace,
+        LayoutResourceKind kind,
+        LocationRange& outRange)
+    {
+        auto param = as<IRGlobalParam>(inst);
+        if (!param)
+            return false;
+        auto ptrType = as<IRPtrTypeBase>(param->getDataType());
+        if (!ptrType || ptrType->getAddressSpace() != addressSpace)
+            return false;
+        auto varLayout = findVarLayout(param);
+        if (!varLayout)
+            return false;
+        auto offsetAttr = varLayout->findOffsetAttr(kind);
+        auto sizeAttr = varLayout->getTypeLayout()->findSizeAttr(kind);
+        if (!offsetAttr || !sizeAttr || !sizeAttr->getSize().isFinite())
+            return false;
+        outRange.begin = offsetAttr->getOffset();
+        outRange.end = outRange.begin + sizeAttr->getFiniteSize();
+        return true;
+    }
+
+    bool mightBeUsedByFragmentShader(IRInst* inst)
+    {
+        if (!inst->hasUses())
+            return true;
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            auto stage = mapFuncToStage.tryGetValue(getParentFunc(use->getUser()));
+            if (!stage || *stage == Stage::Fragment)
+                return true;
+        }
+        return false;
+    }
+
+    bool isReadByFragmentShader(LocationRange const& range)
+    {
+        for (auto inputRange : fragmentInputRanges)
+        {
+            if (inputRange.begin < range.end && range.begin < inputRange.end)
+                return true;
+        }
+        return false;
+    }
+
+    // Collect the stores through `ptr`, and the addresses derived from it, in an order
+    // where each inst comes before the insts it uses. Fails if `ptr` is used in any other
+    // way, or outside of a vertex or mesh entry point.
+    bool collectWrites(IRInst* ptr, List<IRInst*>& outInsts)
+    {
+        for (auto use = ptr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            auto stage = mapFuncToStage.tryGetValue(getParentFunc(user));
+            if (!stage || (*stage != Stage::Vertex && *stage != Stage::Mesh))
+                return false;
+
+            switch (user->getOp())
+            {
+            case kIROp_GetElementPtr:
+            case kIROp_FieldAddress:
+                if (use != user->getOperands() || !collectWrites(user, outInsts))
+                    return false;
+                break;
+            case kIROp_Store:
+                if (as<IRStore>(user)->getPtr() != ptr)
+                    return false;
+                break;
+            default:
+                return false;
+            }
+            outInsts.add(user);
+        }
+        return true;
+    }
+
+    bool processModule()
+    {
+        bool hasFragmentShader = false;
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto entryPointDecor = inst->findDecoration<IREntryPointDecoration>();
+            if (!entryPointDecor)
+                continue;
+            auto stage = entryPointDecor->getProfile().getStage();
+            switch (stage)
+            {
+            case Stage::Geometry:
+            case Stage::Hull:
+            case Stage::Domain:
+                return false;
+            case Stage::Fragment:
+                hasFragmentShader = true;
+                break;
+            default:
+                break;
+            }
+            mapFuncToStage[inst] = stage;
+        }
+        if (!hasFragmentShader)
+            return false;
+
+        // Vertex shader inputs are varying inputs too. An input is only known not to belong
+        // to a fragment shader when all of its uses are in other entry points.
+        for (auto inst : module->getGlobalInsts())
+        {
+            LocationRange range;
+            if (getVaryingLocations(
+                    inst,
+                    AddressSpace::Input,
+                    LayoutResourceKind::VaryingInput,
+                    range) &&
+                mightBeUsedByFragmentShader(inst))
+            {
+                fragmentInputRanges.add(range);
+            }
+        }
+
+        List<IRInst*> unreadOutputs;
+        for (auto inst : module->getGlobalInsts())
+        {
+            LocationRange range;
+            if (getVaryingLocations(
+                    inst,
+                    AddressSpace::Output,
+                    LayoutResourceKind::VaryingOutput,
+                    range) &&
+                !isReadByFragmentShader(range))
+            {
+                unreadOutputs.add(inst);
+            }
+        }
+
+        bool changed = false;
+        for (auto output : unreadOutputs)
+        {
+            List<IRInst*> writes;
+            if (!collectWrites(output, writes))
+                continue;
+            for (auto write : writes)
+                write->removeAndDeallocate();
+            output->removeAndDeallocate();
+            changed = true;
+        }
+        return changed;
+    }
+};
+
+bool removeUnreadVaryingOutputs(IRModule* module)
+{
+    UnreadVaryingRemovalContext context;
+    context.module = module;
+    return context.processModule();
+}
+
+} // namespace Slang
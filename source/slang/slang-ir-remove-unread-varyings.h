@@ -0,0 +1,27 @@
+// slang-ir-remove-unread-varyings.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Remove the outputs of vertex and mesh shaders that no fragment shader in the same
+/// program reads.
+///
+/// When a program contains both the stage that feeds the rasterizer and the fragment
+/// stage, this pass compares the locations that the vertex or mesh entry points write
+/// with the locations the fragment entry points read. An output whose locations are not
+/// read by any fragment input is removed, together with all of the writes to it. Removing
+/// an output doesn't change the location of any other output, so the remaining outputs
+/// still match the fragment inputs.
+///
+/// An output is only removed if every write to it is in a vertex or mesh entry point,
+/// and nothing is removed when the program contains geometry or tessellation stages,
+/// which sit between the two.
+///
+/// A fragment shader compiled outside of this program might read a removed output, so
+/// this must only be run when that has been asked for.
+///
+/// Returns true if any output was removed.
+bool removeUnreadVaryingOutputs(IRModule* module);
+} // namespace Slang
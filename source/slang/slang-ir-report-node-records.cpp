@@ -0,0 +1,211 @@
+// slang-ir-report-node-records.cpp
+#include "slang-ir-report-node-records.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+#include "slang-rich-diagnostics.h"
+
+namespace Slang
+{
+
+struct NodeRecordReportContext
+{
+    // The fields of a record that a node reads.
+    struct FieldUsage
+    {
+        HashSet<IRInst*> keys;
+
+        // Set when the record is used in a way that isn't understood, which counts every
+        // field as read.
+        bool allFieldsRead = false;
+
+        bool isRead(IRStructField* field) const
+        {
+            return allFieldsRead || keys.contains(field->getKey());
+        }
+    };
+
+    IRModule* module;
+    TargetRequest* targetReq;
+    DiagnosticSink* sink;
+
+    // The parameters of the functions a record is passed to, which have been analyzed for
+    // the current entry point.
+    HashSet<IRInst*> visitedParams;
+
+    // Get the record type that `type` points to, if it is a pointer to a node record.
+    static IRStructType* getRecordType(IRType* type)
+    {
+        auto ptrType = as<IRPtrTypeBase>(type);
+        if (!ptrType || ptrType->getAddressSpace() != AddressSpace::NodePayloadAMDX)
+            return nullptr;
+        return as<IRStructType>(ptrType->getValueType());
+    }
+
+    static IRParam* getParamForArg(IRCall* call, IRUse* use)
+    {
+        auto callee = as<IRFunc>(call->getCallee());
+        if (!callee || !callee->getFirstBlock() || use == call->getOperands())
+            return nullptr;
+        Index argIndex = Index(use - call->getArgs());
+        Index paramIndex = 0;
+        for (auto param : callee->getParams())
+        {
+            if (paramIndex++ == argIndex)
+                return param;
+        }
+        return nullptr;
+    }
+
+    void addLoadUsage(IRInst* load, FieldUsage& usage)
+    {
+        for (auto use = load->firstUse; use; use = use->nextUse)
+        {
+            auto extract = as<IRFieldExtract>(use->getUser());
+            if (extract && use == extract->getOperands())
+                usage.keys.add(extract->getField());
+            else
+                usage.allFieldsRead = true;
+        }
+    }
+
+    void addPtrUsage(IRInst* ptr, FieldUsage& usage)
+    {
+        for (auto use = ptr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (use != user->getOperands())
+            {
+                // The record is passed to a function, which is analyzed in turn.
+                auto call = as<IRCall>(user);
+                auto param = call ? getParamForArg(call, use) : nullptr;
+                if (!param)
+                    usage.allFieldsRead = true;
+                else if (visitedParams.add(param))
+                    addPtrUsage(param, usage);
+                continue;
+            }
+
+            switch (user->getOp())
+            {
+            case kIROp_FieldAddress:
+                usage.keys.add(as<IRFieldAddress>(user)->getField());
+                break;
+            case kIROp_Load:
+                addLoadUsage(user, usage);
+                break;
+            default:
+                usage.allFieldsRead = true;
+                break;
+            }
+        }
+    }
+
+    // The size of the fields of `recordType` that are read, laid out from the largest
+    // alignment to the smallest so that no padding is needed between them.
+    IRIntegerValue getMinimizedSize(IRStructType* recordType, FieldUsage const& usage)
+    {
+        List<IRSizeAndAlignment> fieldLayouts;
+        for (auto field : recordType->getFields())
+        {
+            if (!usage.isRead(field))
+                continue;
+            IRSizeAndAlignment fieldLayout;
+            getNaturalSizeAndAlignment(targetReq, field->getFieldType(), &fieldLayout);
+            fieldLayouts.add(fieldLayout);
+        }
+        fieldLayouts.sort([](IRSizeAndAlignment const& a, IRSizeAndAlignment const& b)
+                          { return a.alignment > b.alignment; });
+
+        IRIntegerValue size = 0;
+        int alignment = 1;
+        for (auto& fieldLayout : fieldLayouts)
+        {
+            size = align(size, fieldLayout.alignment) + fieldLayout.size;
+            alignment = Math::Max(alignment, fieldLayout.alignment);
+        }
+        return align(size, alignment);
+    }
+
+    void reportRecord(IRFunc* entryPoint, IRStructType* recordType, FieldUsage const& usage)
+    {
+        Index fieldCount = 0;
+        Index readFieldCount = 0;
+        for (auto field : recordType->getFields())
+        {
+            fieldCount++;
+            if (usage.isRead(field))
+                readFieldCount++;
+        }
+
+        IRSizeAndAlignment recordLayout;
+        getNaturalSizeAndAlignment(targetReq, recordType, &recordLayout);
+
+        Diagnostics::ReportNodeRecord diagnostic;
+        diagnostic.entryPoint = entryPoint;
+        diagnostic.recordType = recordType;
+        diagnostic.readFieldCount = (int64_t)readFieldCount;
+        diagnostic.fieldCount = (int64_t)fieldCount;
+        diagnostic.size = (int64_t)recordLayout.getStride();
+        diagnostic.minimizedSize = (int64_t)getMinimizedSize(recordType, usage);
+        diagnostic.location = entryPoint->sourceLoc;
+        sink->diagnose(diagnostic);
+
+        for (auto field : recordType->getFields())
+        {
+            if (usage.isRead(field))
+                continue;
+            Diagnostics::ReportUnreadNodeRecordField fieldDiagnostic;
+            fieldDiagnostic.field = field->getKey();
+            fieldDiagnostic.recordType = recordType;
+            fieldDiagnostic.entryPoint = entryPoint;
+            fieldDiagnostic.location = entryPoint->sourceLoc;
+            sink->diagnose(fieldDiagnostic);
+        }
+    }
+
+    void processEntryPoint(IRFunc* entryPoint)
+    {
+        // The usages of each record type, in the order the records are first found.
+        OrderedDictionary<IRStructType*, FieldUsage> usages;
+        visitedParams.clear();
+        for (auto block : entryPoint->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto recordType = getRecordType(inst->getDataType());
+                if (!recordType)
+                    continue;
+                if (!usages.containsKey(recordType))
+                    usages.add(recordType, FieldUsage());
+                addPtrUsage(inst, *usages.tryGetValue(recordType));
+            }
+        }
+
+        for (auto& kv : usages)
+            reportRecord(entryPoint, kv.key, kv.value);
+    }
+
+    void processModule()
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (func && func->findDecoration<IREntryPointDecoration>())
+                processEntryPoint(func);
+        }
+    }
+};
+
+void reportNodeRecords(IRModule* module, TargetRequest* targetReq, DiagnosticSink* sink)
+{
+    NodeRecordReportContext context;
+    context.module = module;
+    context.targetReq = targetReq;
+    context.sink = sink;
+    context.processModule();
+}
+
+} // namespace Slang
@@ -0,0 +1,18 @@
+// slang-ir-report-node-records.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+class TargetRequest;
+
+/// Report the size of the input record of each work graph node entry point, the fields of
+/// the record that the node reads, and the size the record would take with only those fields
+/// ordered by decreasing alignment, which is the smallest size their natural layout allows.
+///
+/// The record is followed from the pointer the entry point gets for it into the functions
+/// it is passed to. The layout of a record is shared with the node that produces it, so the
+/// record itself is not changed.
+void reportNodeRecords(IRModule* module, TargetRequest* targetReq, DiagnosticSink* sink);
+} // namespace Slang
@@ -3,6 +3,7 @@
 
 #include "slang-ir-insts.h"
 #include "slang-ir-translate.h"
+#include "slang-ir-util.h"
 #include "slang-ir.h"
 #include "slang-rich-diagnostics.h"
 
@@ -1221,12 +1222,26 @@ struct SCCPContext
     // will either be marked as "never executed" or in a "possibly executed"
     // state. We track this as a set of the blocks that have been
     // marked as possibly executed, plus a getter and setter function.
+    //
+    // The set is indexed by the number of each block in `instNumbering`,
+    // which `apply()` builds before the algorithm starts. Blocks created
+    // after that are never marked.
 
-    HashSet<IRBlock*> executedBlocks;
+    IRInstNumbering instNumbering;
+    UIntSet executedBlocks;
 
-    bool isMarkedAsExecuted(IRBlock* block) { return executedBlocks.contains(block); }
+    bool isMarkedAsExecuted(IRBlock* block)
+    {
+        Index index = instNumbering.getIndex(block);
+        return index >= 0 && executedBlocks.contains(UInt(index));
+    }
 
-    void markAsExecuted(IRBlock* block) { executedBlocks.add(block); }
+    void markAsExecuted(IRBlock* block)
+    {
+        Index index = instNumbering.getIndex(block);
+        SLANG_ASSERT(index >= 0);
+        executedBlocks.add(UInt(index));
+    }
 
     // The core of the algorithm is based on two work lists.
     // One list holds CFG nodes (basic blocks) that we have
@@ -1503,16 +1518,69 @@ struct SCCPContext
         return changed;
     }
 
-    bool applyOnScope(IRInst* scopeInst)
+    // Run the constant folding on just the global insts in `insts`, and on what they affect.
+    //
+    // Every global inst that could be folded was replaced by a constant when the global scope
+    // was last folded in full, so the other global insts can only take the value `Any`, which
+    // is what `getLatticeVal` gives to a global inst that hasn't been looked at.
+    //
+    bool applyOnGlobalInsts(IRModule* module, List<IRInst*> const& insts)
     {
-        builderStorage = IRBuilder(scopeInst);
-        for (auto child : scopeInst->getChildren())
+        auto moduleInst = module->getModuleInst();
+        List<IRInst*> changedInsts;
+        HashSet<IRInst*> changedScopes;
+        for (auto inst : insts)
         {
-            // Only consider evaluable opcodes.
-            if (!isEvaluableOpCode(child->getOp()))
+            // Skip the insts that have been removed since they changed.
+            if (inst->getParent() != moduleInst)
                 continue;
+            switch (inst->getOp())
+            {
+            case kIROp_StructType:
+            case kIROp_ClassType:
+            case kIROp_InterfaceType:
+            case kIROp_WitnessTable:
+                changedScopes.add(inst);
+                break;
+            default:
+                changedInsts.add(inst);
+                break;
+            }
+        }
+
+        bool changed = applyOnScope(moduleInst, &changedInsts);
+        for (auto scope : changedScopes)
+        {
+            if (scope->getParent() == moduleInst)
+                changed |= applyOnScope(scope);
+        }
+        return changed;
+    }
 
-            updateValueForInst(child);
+    // Fold the constants in `scopeInst`, starting from all of its children, or from just the
+    // ones in `changedInsts` when it is given.
+    //
+    bool applyOnScope(IRInst* scopeInst, List<IRInst*> const* changedInsts = nullptr)
+    {
+        builderStorage = IRBuilder(scopeInst);
+        if (changedInsts)
+        {
+            for (auto inst : *changedInsts)
+            {
+                if (isEvaluableOpCode(inst->getOp()))
+                    updateValueForInst(inst);
+            }
+        }
+        else
+        {
+            for (auto child : scopeInst->getChildren())
+            {
+                // Only consider evaluable opcodes.
+                if (!isEvaluableOpCode(child->getOp()))
+                    continue;
+
+                updateValueForInst(child);
+            }
         }
         while (ssaWorkList.getCount())
         {
@@ -1528,11 +1596,23 @@ struct SCCPContext
         // Replace the insts with their values.
 
         List<IRInst*> instsToProcess;
-        for (auto child : scopeInst->getChildren())
+        if (changedInsts)
         {
-            if (!isEvaluableOpCode(child->getOp()))
-                continue;
-            instsToProcess.add(child);
+            // Only the insts that were reached from the changed ones have a lattice value.
+            for (auto& [inst, latticeVal] : mapInstToLatticeVal)
+            {
+                if (inst->getParent() == scopeInst && isEvaluableOpCode(inst->getOp()))
+                    instsToProcess.add(inst);
+            }
+        }
+        else
+        {
+            for (auto child : scopeInst->getChildren())
+            {
+                if (!isEvaluableOpCode(child->getOp()))
+                    continue;
+                instsToProcess.add(child);
+            }
         }
 
         for (auto child : instsToProcess)
@@ -1563,6 +1643,9 @@ struct SCCPContext
         auto firstBlock = code->getFirstBlock();
         SLANG_ASSERT(firstBlock);
 
+        instNumbering.build(code);
+        executedBlocks.resizeAndUnsetAll(UInt(instNumbering.getCount()));
+
         // The entry block is always going to be executed when the
         // function gets called, so we will process it right away.
         //
@@ -1982,6 +2065,25 @@ bool applySparseConditionalConstantPropagationForGlobalScope(
     return changed;
 }
 
+bool applySparseConditionalConstantPropagationForGlobalInsts(
+    IRModule* module,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink,
+    List<IRInst*> const& insts)
+{
+    if (sink && sink->getErrorCount())
+        return false;
+
+    SharedSCCPContext shared;
+    shared.module = module;
+    shared.targetProgram = targetProgram;
+    shared.sink = sink;
+    SCCPContext globalContext;
+    globalContext.shared = &shared;
+    globalContext.code = nullptr;
+    return globalContext.applyOnGlobalInsts(module, insts);
+}
+
 bool applySparseConditionalConstantPropagation(
     IRInst* func,
     TargetProgram* targetProgram,
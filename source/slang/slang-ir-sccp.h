@@ -1,5 +1,6 @@
 // slang-ir-sccp.h
 #pragma once
+#include "../core/slang-list.h"
 #include "slang-ir-insts-enum.h"
 
 namespace Slang
@@ -27,6 +28,17 @@ bool applySparseConditionalConstantPropagationForGlobalScope(
     TargetProgram* targetProgram,
     DiagnosticSink* sink);
 
+/// Fold the constants of `applySparseConditionalConstantPropagationForGlobalScope` starting
+/// from just the global instructions in `insts`.
+///
+/// `insts` should hold the global instructions that changed since the global scope was last
+/// folded in full (see `IRModule::beginTrackingChangedGlobalInsts`).
+bool applySparseConditionalConstantPropagationForGlobalInsts(
+    IRModule* module,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink,
+    List<IRInst*> const& insts);
+
 bool applySparseConditionalConstantPropagation(
     IRInst* func,
     TargetProgram* targetProgram,
@@ -0,0 +1,290 @@
+// slang-ir-schedule.cpp
+#include "slang-ir-schedule.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Blocks longer than this are left alone to bound compile time, since the pressure estimate
+// is recomputed for the whole block after each move.
+static const Index kMaxBlockInstCount = 1024;
+
+// The furthest, in insts, a load is moved earlier.
+static const Index kMaxLoadHoistDistance = 16;
+
+InstSchedulingOptions InstSchedulingOptions::getForTarget(CodeGenTarget target)
+{
+    InstSchedulingOptions options;
+    if (isCPUTarget(target))
+    {
+        // The downstream compiler schedules for the CPU, and loads hit the cache.
+        options.registerBudget = 0;
+    }
+    else if (isCUDATarget(target))
+    {
+        options.registerBudget = 128;
+    }
+    return options;
+}
+
+// Estimate the number of 32-bit registers a value of `type` occupies.
+static Index getRegisterCost(IRType* type)
+{
+    if (!type)
+        return 0;
+    if (auto vectorType = as<IRVectorType>(type))
+    {
+        auto count = as<IRIntLit>(vectorType->getElementCount());
+        return getRegisterCost(vectorType->getElementType()) * (count ? count->getValue() : 4);
+    }
+    if (auto matrixType = as<IRMatrixType>(type))
+    {
+        auto rows = as<IRIntLit>(matrixType->getRowCount());
+        auto columns = as<IRIntLit>(matrixType->getColumnCount());
+        return getRegisterCost(matrixType->getElementType()) * (rows ? rows->getValue() : 4) *
+               (columns ? columns->getValue() : 4);
+    }
+    switch (type->getOp())
+    {
+    case kIROp_VoidType:
+        return 0;
+    case kIROp_Int64Type:
+    case kIROp_UInt64Type:
+    case kIROp_DoubleType:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+struct BlockScheduler
+{
+    IRFunc* func;
+    IRBlock* block;
+    InstSchedulingOptions options;
+
+    // The ordinary insts of the block, in order.
+    List<IRInst*> insts;
+
+    // The estimated registers live just before each inst in `insts`.
+    List<Index> pressure;
+
+    // Is `value` an SSA value computed in this function, which would occupy registers?
+    bool isLocalValue(IRInst* value)
+    {
+        if (as<IRVar>(value))
+            return false;
+        auto valueBlock = as<IRBlock>(value->getParent());
+        return valueBlock && valueBlock->getParent() == func;
+    }
+
+    void collectInsts()
+    {
+        insts.clear();
+        for (auto inst : block->getOrdinaryInsts())
+            insts.add(inst);
+    }
+
+    void computePressure()
+    {
+        const Index count = insts.getCount();
+        Dictionary<IRInst*, Index> indexOf;
+        for (Index i = 0; i < count; i++)
+            indexOf[insts[i]] = i;
+
+        // Each value adds its cost to the points from where it is defined to its last use in
+        // the block, or to the end of the block if it is used elsewhere.
+        List<Index> delta;
+        delta.setCount(count + 1);
+        for (auto& d : delta)
+            d = 0;
+        auto addRange = [&](IRInst* value, Index start)
+        {
+            Index end = start;
+            for (auto use = value->firstUse; use; use = use->nextUse)
+            {
+                Index userIndex = 0;
+                if (!indexOf.tryGetValue(use->getUser(), userIndex))
+                {
+                    if (getBlock(use->getUser()) == block)
+                        continue;
+                    userIndex = count - 1;
+                }
+                end = Math::Max(end, userIndex);
+            }
+            if (end < start)
+                return;
+            const Index cost = getRegisterCost(value->getDataType());
+            delta[start] += cost;
+            delta[end + 1] -= cost;
+        };
+
+        HashSet<IRInst*> liveIns;
+        for (Index i = 0; i < count; i++)
+        {
+            auto inst = insts[i];
+            for (UInt j = 0; j < inst->getOperandCount(); j++)
+            {
+                auto operand = inst->getOperand(j);
+                if (isLocalValue(operand) && !indexOf.containsKey(operand) &&
+                    liveIns.add(operand))
+                    addRange(operand, 0);
+            }
+            if (i + 1 < count && isLocalValue(inst))
+                addRange(inst, i + 1);
+        }
+
+        pressure.setCount(count);
+        Index live = 0;
+        for (Index i = 0; i < count; i++)
+        {
+            live += delta[i];
+            pressure[i] = live;
+        }
+    }
+
+    // Move loads earlier, while no inst they pass could write to what they load and the
+    // estimated pressure stays under the budget.
+    void hoistLoads()
+    {
+        if (options.registerBudget <= 0)
+            return;
+        computePressure();
+        for (Index i = 1; i < insts.getCount(); i++)
+        {
+            auto load = as<IRLoad>(insts[i]);
+            if (!load || load->findAttr<IRMemoryScopeAttr>())
+                continue;
+            const Index cost = getRegisterCost(load->getDataType());
+            Index target = i;
+            while (target > 0 && i - target < kMaxLoadHoistDistance)
+            {
+                auto prev = insts[target - 1];
+                // Loads aren't reordered with each other, which keeps the order of any
+                // volatile accesses.
+                if (as<IRLoad>(prev))
+                    break;
+                bool isOperand = false;
+                for (UInt j = 0; j < load->getOperandCount(); j++)
+                    isOperand |= load->getOperand(j) == prev;
+                if (isOperand)
+                    break;
+                if (canInstHaveSideEffectAtAddress(func, prev, load->getPtr()))
+                    break;
+                if (pressure[target - 1] + cost > options.registerBudget)
+                    break;
+                target--;
+            }
+            if (target == i)
+                continue;
+            load->insertBefore(insts[target]);
+            insts.removeAt(i);
+            insts.insert(target, load);
+            computePressure();
+        }
+    }
+
+    // Move side-effect free insts down to just before their first use, if that shortens more
+    // live ranges than it lengthens.
+    void sinkInsts()
+    {
+        Dictionary<IRInst*, Index> position;
+        for (Index i = 0; i < insts.getCount(); i++)
+            position[insts[i]] = 2 * i;
+
+        HashSet<IRInst*> users;
+        IRInst* prevInst = nullptr;
+        for (auto inst = block->getLastOrdinaryInst(); inst; inst = prevInst)
+        {
+            prevInst = inst->getPrevInst();
+            if (as<IRParam>(inst))
+                break;
+            // Loads that are movable were placed by `hoistLoads`.
+            if (as<IRLoad>(inst) || !isMovableInst(inst) || !inst->hasUses())
+                continue;
+
+            users.clear();
+            bool allUsesInBlock = true;
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                allUsesInBlock &= user->getParent() == block;
+                users.add(user);
+            }
+            if (!allUsesInBlock)
+                continue;
+
+            IRInst* firstUser = inst->getNextInst();
+            while (firstUser && !users.contains(firstUser))
+                firstUser = firstUser->getNextInst();
+            if (!firstUser || firstUser == inst->getNextInst())
+                continue;
+
+            // Sinking `inst` keeps its operands live until `firstUser`. Count the operands
+            // that would otherwise die before that.
+            Index firstUserPosition = 0;
+            if (!position.tryGetValue(firstUser, firstUserPosition))
+                continue;
+            Index lengthened = 0;
+            for (UInt j = 0; j < inst->getOperandCount(); j++)
+            {
+                auto operand = inst->getOperand(j);
+                if (!isLocalValue(operand))
+                    continue;
+                bool isLiveAtFirstUser = false;
+                for (auto use = operand->firstUse; use; use = use->nextUse)
+                {
+                    auto user = use->getUser();
+                    if (user == inst)
+                        continue;
+                    Index userPosition = 0;
+                    if (user->getParent() != block || !position.tryGetValue(user, userPosition) ||
+                        userPosition >= firstUserPosition)
+                    {
+                        isLiveAtFirstUser = true;
+                        break;
+                    }
+                }
+                if (!isLiveAtFirstUser)
+                    lengthened += getRegisterCost(operand->getDataType());
+            }
+            if (lengthened >= getRegisterCost(inst->getDataType()))
+                continue;
+
+            inst->insertBefore(firstUser);
+            position[inst] = firstUserPosition - 1;
+        }
+    }
+
+    void schedule()
+    {
+        collectInsts();
+        if (insts.getCount() < 3 || insts.getCount() > kMaxBlockInstCount)
+            return;
+        hoistLoads();
+        sinkInsts();
+    }
+};
+
+void scheduleInstsForRegisterPressure(IRModule* module, InstSchedulingOptions const& options)
+{
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func)
+            continue;
+        for (auto block : func->getBlocks())
+        {
+            BlockScheduler scheduler;
+            scheduler.func = func;
+            scheduler.block = block;
+            scheduler.options = options;
+            scheduler.schedule();
+        }
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,29 @@
+// slang-ir-schedule.h
+#pragma once
+#include "slang-compiler.h"
+
+namespace Slang
+{
+struct IRModule;
+
+struct InstSchedulingOptions
+{
+    /// Estimated number of 32-bit registers available to a function before the target has to
+    /// spill. Loads are only moved earlier while the estimated pressure stays under this. Zero
+    /// disables moving loads.
+    Index registerBudget = 64;
+
+    static InstSchedulingOptions getForTarget(CodeGenTarget target);
+};
+
+/// Reorder the insts in each block to shorten the live ranges of SSA values.
+///
+/// Loads are moved earlier in their block, as far as their operands and any writes that may
+/// alias them allow, to give their latency time to be hidden, as long as the register budget
+/// isn't exceeded. Side-effect free insts whose uses are all in the same block are then moved
+/// down to just before their first use, so values aren't computed long before they are
+/// needed.
+///
+/// Insts are never moved between blocks, so the pass doesn't change how often anything runs.
+void scheduleInstsForRegisterPressure(IRModule* module, InstSchedulingOptions const& options);
+} // namespace Slang
@@ -92,7 +92,7 @@ bool isTrivialSingleIterationLoop(
     // We need to verify this is a trivial loop by checking if there is any multi-level breaks
     // that skips out of this loop.
     if (!domTree)
-        domTree = computeDominatorTree(func);
+        domTree = findOrComputeDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     auto loopBlocks = collectBlocksInRegion(domTree, loop, &hasMultiLevelBreaks);
     if (hasMultiLevelBreaks)
@@ -163,7 +163,7 @@ static bool doesLoopHasSideEffect(
 {
     bool hasMultiLevelBreaks = false;
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = findOrComputeDominatorTree(func);
     auto blocks = collectBlocksInRegion(context.domTree.get(), loopInst, &hasMultiLevelBreaks);
 
     // We'll currently not deal with loops that contain multi-level breaks.
@@ -887,7 +887,7 @@ static bool processFunc(IRGlobalValueWithCode* func, CFGSimplificationOptions op
                     // a normal branch.
                     auto targetBlock = loop->getTargetBlock();
                     if (!simplificationContext.domTree)
-                        simplificationContext.domTree = computeDominatorTree(func);
+                        simplificationContext.domTree = findOrComputeDominatorTree(func);
                     if (options.removeTrivialSingleIterationLoops &&
                         isTrivialSingleIterationLoop(simplificationContext.domTree, func, loop))
                     {
@@ -42,8 +42,13 @@ struct FuncBufferLoadSpecializationCondition : FunctionCallSpecializeCondition
     {
         // We only want to specialize for `struct` types and not base types.
         //
+        // Smaller types are still worth specializing if the callee, or the functions it
+        // passes the parameter to, only reads a few of their fields, since the specialized
+        // callee will load just those fields.
+        //
         auto paramType = (IRType*)unwrapAttributedType(param->getDataType());
-        if (!isTypePreferrableToDeferLoad(codegenContext, paramType))
+        if (!isTypePreferrableToDeferLoad(codegenContext, paramType) &&
+            !isValueSparselyUsed(codegenContext, param))
             return false;
 
         // We want to handle loads from arbitrary access chains rooting from a shader parameter.
@@ -1,11 +1,13 @@
 // slang-ir-specialize-function-call.cpp
 #include "slang-ir-specialize-function-call.h"
 
+#include "slang-code-gen.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
+#include "slang-rich-diagnostics.h"
 
 namespace Slang
 {
@@ -162,6 +164,9 @@ struct FunctionParameterSpecializationContext
                 changed = true;
             }
         }
+
+        if (codeGenContext->shouldReportFunctionSpecialization())
+            reportSpecializationStats();
         return changed;
     }
 
@@ -328,6 +333,53 @@ struct FunctionParameterSpecializationContext
     //
     Dictionary<Key, IRFunc*> specializedFuncs;
 
+    // For `-report-function-specialization`, we count the call
+    // sites of each original function that were specialized,
+    // and how many distinct specialized functions they needed.
+    // The original function is often removed once all of its
+    // calls are specialized, so we keep its name and location
+    // instead of the function itself.
+    //
+    struct SpecializationStats
+    {
+        String funcName;
+        SourceLoc loc;
+        Index callCount = 0;
+        Index variantCount = 0;
+    };
+    OrderedDictionary<IRFunc*, SpecializationStats> statsForFunc;
+
+    SpecializationStats& getStats(IRFunc* func)
+    {
+        if (auto stats = statsForFunc.tryGetValue(func))
+            return *stats;
+
+        SpecializationStats stats;
+        if (auto nameHint = func->findDecoration<IRNameHintDecoration>())
+            stats.funcName = nameHint->getName();
+        else
+            stats.funcName = getMangledName(func);
+        stats.loc = func->sourceLoc;
+        statsForFunc.add(func, stats);
+        return *statsForFunc.tryGetValue(func);
+    }
+
+    void reportSpecializationStats()
+    {
+        auto sink = codeGenContext->getSink();
+        for (auto& kv : statsForFunc)
+        {
+            auto& stats = kv.value;
+            Diagnostics::ReportFunctionSpecialization diagnostic;
+            diagnostic.function = stats.funcName;
+            diagnostic.callCount = (int64_t)stats.callCount;
+            diagnostic.variantCount = (int64_t)stats.variantCount;
+            diagnostic.sharedCount = (int64_t)(stats.callCount - stats.variantCount);
+            diagnostic.location = stats.loc;
+            sink->diagnose(diagnostic);
+        }
+    }
+
     // If the dictionary didn't have a specialized function
     // suitable for a call site, we need a second information-gathering
     // pass to decide what the new parameters of the specialized
@@ -374,9 +426,14 @@ struct FunctionParameterSpecializationContext
         // that we generated before (for another call site)
         // that is suitable to this call site.
         //
+        auto& stats = getStats(oldFunc);
+        stats.callCount++;
+
         IRFunc* newFunc = nullptr;
         if (!specializedFuncs.tryGetValue(callInfo.key, newFunc))
         {
+            stats.variantCount++;
+
             // If we didn't find a pre-existing specialized
             // function, then we will go ahead and create one.
             //
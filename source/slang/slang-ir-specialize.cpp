@@ -1781,7 +1781,8 @@ struct SpecializationContext
                     targetProgram,
                     sink,
                     this,
-                    options.reportDynamicDispatchSites);
+                    options.reportDynamicDispatchSites,
+                    options.dispatchFrequencyHints);
 
                 if (dynPassChanged)
                     eliminateDeadCode(module->getModuleInst());
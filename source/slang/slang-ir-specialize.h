@@ -3,6 +3,7 @@
 
 namespace Slang
 {
+struct DispatchFrequencyHints;
 struct IRModule;
 struct IRInst;
 struct IRFunc;
@@ -20,6 +21,9 @@ struct SpecializationOptions
 
     // Option to report dynamic dispatch sites.
     bool reportDynamicDispatchSites = false;
+
+    // Expected call frequencies used to order the cases of generated dispatch functions.
+    DispatchFrequencyHints const* dispatchFrequencyHints = nullptr;
 };
 
 /// Specialize generic and interface-based code to use concrete types.
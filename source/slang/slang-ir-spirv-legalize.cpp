@@ -8,6 +8,7 @@
 #include "slang-ir-dominators.h"
 #include "slang-ir-float-non-uniform-resource-index.h"
 #include "slang-ir-glsl-legalize.h"
+#include "slang-ir-gvn.h"
 #include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
@@ -2754,6 +2755,13 @@ void simplifyIRForSpirvLegalization(TargetProgram* target, DiagnosticSink* sink,
     const int kMaxIterations = 8;
     const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
+    const bool performGVN =
+        target && target->getOptionSet().getBoolOption(CompilerOptionName::GlobalValueNumbering);
+
+    // After the first iteration, the global scope passes only need to look at the global
+    // instructions that changed since the previous one.
+    IRChangedGlobalInstTrackingScope globalTrackingScope(module);
+    List<IRInst*> changedGlobalInsts;
 
     while (changed && iterationCounter < kMaxIterations)
     {
@@ -2762,8 +2770,23 @@ void simplifyIRForSpirvLegalization(TargetProgram* target, DiagnosticSink* sink,
 
         changed = false;
 
-        changed |= applySparseConditionalConstantPropagationForGlobalScope(module, target, sink);
-        changed |= peepholeOptimizeGlobalScope(target, module);
+        if (iterationCounter == 0)
+        {
+            changed |=
+                applySparseConditionalConstantPropagationForGlobalScope(module, target, sink);
+            changed |= peepholeOptimizeGlobalScope(target, module);
+        }
+        else
+        {
+            changedGlobalInsts.clear();
+            changedGlobalInsts.swapWith(module->getChangedGlobalInsts());
+            changed |= applySparseConditionalConstantPropagationForGlobalInsts(
+                module,
+                target,
+                sink,
+                changedGlobalInsts);
+            changed |= peepholeOptimizeGlobalInsts(target, module, changedGlobalInsts);
+        }
 
         for (auto inst : module->getGlobalInsts())
         {
@@ -2778,13 +2801,17 @@ void simplifyIRForSpirvLegalization(TargetProgram* target, DiagnosticSink* sink,
                 funcChanged |= applySparseConditionalConstantPropagation(func, target, sink);
                 funcChanged |= peepholeOptimize(target, func);
                 funcChanged |= removeRedundancyInFunc(func, false);
+                if (performGVN)
+                    funcChanged |= applyGlobalValueNumbering(func);
                 CFGSimplificationOptions options;
                 options.removeTrivialSingleIterationLoops = true;
                 options.removeSideEffectFreeLoops = false;
                 funcChanged |= simplifyCFG(func, options);
                 eliminateDeadCode(func);
+                funcIterationCount++;
             }
         }
+        iterationCounter++;
     }
 }
 
@@ -0,0 +1,255 @@
+// slang-ir-sroa.cpp
+#include "slang-ir-sroa.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Limits on the size of the aggregates that are split. Past these, the loads and stores of
+// the whole value expand into more code than splitting saves.
+static const Index kMaxStructFieldCount = 64;
+static const IRIntegerValue kMaxArrayElementCount = 16;
+
+struct ScalarReplacementContext
+{
+    // One part of an aggregate, with the key or index that selects it.
+    struct Part
+    {
+        IRType* type;
+        IRStructKey* key = nullptr;
+        IRIntegerValue index = 0;
+        IRVar* var = nullptr;
+    };
+
+    // Get the parts of `type` if it is an aggregate that can be split.
+    bool getParts(IRType* type, List<Part>& outParts)
+    {
+        if (auto structType = as<IRStructType>(type))
+        {
+            for (auto field : structType->getFields())
+            {
+                if (outParts.getCount() >= kMaxStructFieldCount)
+                    return false;
+                Part part;
+                part.type = field->getFieldType();
+                part.key = field->getKey();
+                outParts.add(part);
+            }
+        }
+        else if (auto arrayType = as<IRArrayType>(type))
+        {
+            auto count = as<IRIntLit>(arrayType->getElementCount());
+            if (!count || count->getValue() > kMaxArrayElementCount)
+                return false;
+            for (IRIntegerValue i = 0; i < count->getValue(); i++)
+            {
+                Part part;
+                part.type = arrayType->getElementType();
+                part.index = i;
+                outParts.add(part);
+            }
+        }
+        return outParts.getCount() != 0;
+    }
+
+    // Find the part that `addr`, a field or element address of the variable, refers to.
+    Index findPart(IRInst* addr, List<Part> const& parts)
+    {
+        if (auto fieldAddr = as<IRFieldAddress>(addr))
+        {
+            for (Index i = 0; i < parts.getCount(); i++)
+            {
+                if (parts[i].key && parts[i].key == fieldAddr->getField())
+                    return i;
+            }
+        }
+        else if (auto elementPtr = as<IRGetElementPtr>(addr))
+        {
+            auto index = as<IRIntLit>(elementPtr->getIndex());
+            if (!index)
+                return -1;
+            for (Index i = 0; i < parts.getCount(); i++)
+            {
+                if (!parts[i].key && parts[i].index == index->getValue())
+                    return i;
+            }
+        }
+        return -1;
+    }
+
+    bool canSplit(IRVar* var, IRPtrType* varType, List<Part> const& parts)
+    {
+        // Only the name hint is carried over to the parts. Other decorations, such as
+        // precision or layout, describe the variable as a whole.
+        for (auto decoration : var->getDecorations())
+        {
+            if (!as<IRNameHintDecoration>(decoration))
+                return false;
+        }
+
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+            case kIROp_Load:
+                break;
+            case kIROp_Store:
+                if (use != &as<IRStore>(user)->ptr)
+                    return false;
+                break;
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+                {
+                    if (use != user->getOperands())
+                        return false;
+                    if (findPart(user, parts) < 0)
+                        return false;
+
+                    // The part's variable replaces the address, so their types must match.
+                    auto addrType = as<IRPtrType>(user->getDataType());
+                    if (!addrType || addrType->getAddressSpace() != varType->getAddressSpace())
+                        return false;
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void addPartNameHint(IRBuilder& builder, IRVar* var, Part const& part)
+    {
+        auto nameHint = var->findDecoration<IRNameHintDecoration>();
+        if (!nameHint)
+            return;
+        StringBuilder name;
+        name << nameHint->getName() << "_";
+        if (part.key)
+        {
+            auto keyNameHint = part.key->findDecoration<IRNameHintDecoration>();
+            if (!keyNameHint)
+                return;
+            name << keyNameHint->getName();
+        }
+        else
+        {
+            name << part.index;
+        }
+        builder.addNameHintDecoration(part.var, name.getUnownedSlice());
+    }
+
+    IRInst* extractPart(IRBuilder& builder, IRInst* value, Part const& part)
+    {
+        if (part.key)
+            return builder.emitFieldExtract(part.type, value, part.key);
+        return builder.emitElementExtract(part.type, value, builder.getIntValue(part.index));
+    }
+
+    // Split `var` if possible, adding the new variables for its parts to `ioWorkList`.
+    bool trySplitVar(IRVar* var, List<IRVar*>& ioWorkList)
+    {
+        auto varType = as<IRPtrType>(var->getDataType());
+        if (!varType)
+            return false;
+        auto valueType = varType->getValueType();
+
+        List<Part> parts;
+        if (!getParts(valueType, parts))
+            return false;
+        if (!canSplit(var, varType, parts))
+            return false;
+
+        IRBuilder builder(var);
+        builder.setInsertBefore(var);
+        for (auto& part : parts)
+        {
+            part.var = varType->hasAddressSpace()
+                           ? builder.emitVar(part.type, varType->getAddressSpace())
+                           : builder.emitVar(part.type);
+            addPartNameHint(builder, var, part);
+            ioWorkList.add(part.var);
+        }
+
+        // Rewrite the uses of the variable in terms of its parts. Each user is replaced, so
+        // the use list is walked from its head until it is empty.
+        while (auto use = var->firstUse)
+        {
+            auto user = use->getUser();
+            builder.setInsertBefore(user);
+            switch (user->getOp())
+            {
+            case kIROp_Load:
+                {
+                    List<IRInst*> values;
+                    for (auto& part : parts)
+                        values.add(builder.emitLoad(part.var));
+                    IRInst* value = nullptr;
+                    if (as<IRStructType>(valueType))
+                        value = builder.emitMakeStruct(valueType, values);
+                    else
+                        value = builder.emitMakeArray(
+                            valueType,
+                            (UInt)values.getCount(),
+                            values.getBuffer());
+                    user->replaceUsesWith(value);
+                }
+                break;
+            case kIROp_Store:
+                {
+                    auto value = as<IRStore>(user)->getVal();
+                    for (auto& part : parts)
+                        builder.emitStore(part.var, extractPart(builder, value, part));
+                }
+                break;
+            default:
+                user->replaceUsesWith(parts[findPart(user, parts)].var);
+                break;
+            }
+            user->removeAndDeallocate();
+        }
+        var->removeAndDeallocate();
+        return true;
+    }
+
+    bool processFunc(IRGlobalValueWithCode* func)
+    {
+        List<IRVar*> workList;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (auto var = as<IRVar>(inst))
+                    workList.add(var);
+            }
+        }
+
+        bool changed = false;
+        for (Index i = 0; i < workList.getCount(); i++)
+            changed |= trySplitVar(workList[i], workList);
+        return changed;
+    }
+};
+
+bool applyScalarReplacementOfAggregates(IRGlobalValueWithCode* func)
+{
+    ScalarReplacementContext context;
+    return context.processFunc(func);
+}
+
+bool applyScalarReplacementOfAggregates(IRModule* module)
+{
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRGlobalValueWithCode>(inst))
+            changed |= applyScalarReplacementOfAggregates(func);
+    }
+    return changed;
+}
+
+} // namespace Slang
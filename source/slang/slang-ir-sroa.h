@@ -0,0 +1,25 @@
+// slang-ir-sroa.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+struct IRModule;
+
+/// Split local variables of struct and fixed-size array type into one variable per field or
+/// element, so SSA construction can promote each part to a separate value.
+///
+/// A variable is split only if it is accessed through whole-variable loads and stores, and
+/// through field addresses and constant-index element addresses. Any other use, such as a
+/// dynamic index or passing the variable's address to a call, leaves it whole. So does any
+/// decoration other than a name hint, since it could not be carried over to the parts.
+///
+/// Returns true if any variable was split.
+bool applyScalarReplacementOfAggregates(IRGlobalValueWithCode* func);
+
+/// Split the local variables of every function in `module`, as above.
+///
+/// Passes such as automatic differentiation work on whole aggregate variables, so this is
+/// run once late in code generation, before the simplification that constructs SSA form.
+bool applyScalarReplacementOfAggregates(IRModule* module);
+} // namespace Slang
@@ -1,6 +1,7 @@
 // slang-ir-ssa-simplification.cpp
 #include "slang-ir-ssa-simplification.h"
 
+#include "../compiler-core/slang-compile-time-budget.h"
 #include "../core/slang-performance-profiler.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-deduplicate-generic-children.h"
@@ -61,6 +62,41 @@ void simplifyIR(
     const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
 
+    // Apart from the first one for each function, the dead code eliminations
+    // in the loop below only need to look at what the other passes left unused.
+    // The full elimination at the end takes care of anything else.
+    IRPossiblyDeadInstTrackingScope trackingScope(module);
+    auto incrementalDCEOptions = options.deadCodeElimOptions;
+    incrementalDCEOptions.onlyPossiblyDeadInsts = true;
+
+    // If simplifying as long as it took before would go over the compile time budget, or
+    // the budget runs out while simplifying, fall back to the cheaper settings used for
+    // minimal optimization. The simplification still runs to a fixed point, since the
+    // passes that follow expect simplified IR.
+    auto budget = options.budget;
+    auto degradeIfOverBudget = [&](bool overBudget)
+    {
+        if (!overBudget || options.minimalOptimization)
+            return;
+        options.minimalOptimization = true;
+        options.cfgOptions = CFGSimplificationOptions::getFast();
+        options.deadCodeElimOptions.useFastAnalysis = true;
+        incrementalDCEOptions.useFastAnalysis = true;
+        budget->noteDegraded(toSlice("simplifyIR"));
+    };
+    if (budget)
+        degradeIfOverBudget(budget->shouldDegrade("simplifyIR"));
+
+    // The per-function passes only look at the function they are given and at
+    // global state, so a function that went through all of them without a change
+    // can't change in a later iteration unless the global passes changed something.
+    HashSet<IRGlobalValueWithCode*> convergedFuncs;
+
+    // Likewise, after the first iteration the global scope passes only need to look
+    // at the global instructions that changed since the previous one.
+    IRChangedGlobalInstTrackingScope globalTrackingScope(module);
+    List<IRInst*> changedGlobalInsts;
+
     while (changed && iterationCounter < kMaxIterations)
     {
         if (sink && sink->getErrorCount())
@@ -71,21 +107,50 @@ void simplifyIR(
         changed |= deduplicateGenericChildren(module);
         changed |= propagateFuncProperties(module);
         changed |= removeUnusedGenericParam(module);
-        changed |= applySparseConditionalConstantPropagationForGlobalScope(module, target, sink);
-        changed |= peepholeOptimizeGlobalScope(target, module);
+        if (iterationCounter == 0)
+        {
+            changed |=
+                applySparseConditionalConstantPropagationForGlobalScope(module, target, sink);
+            changed |= peepholeOptimizeGlobalScope(target, module);
+        }
+        else
+        {
+            changedGlobalInsts.clear();
+            changedGlobalInsts.swapWith(module->getChangedGlobalInsts());
+            changed |= applySparseConditionalConstantPropagationForGlobalInsts(
+                module,
+                target,
+                sink,
+                changedGlobalInsts);
+            changed |= peepholeOptimizeGlobalInsts(target, module, changedGlobalInsts);
+        }
         changed |= trimOptimizableTypes(module);
 
+        if (changed)
+            convergedFuncs.clear();
+
+        // Note: the functions are simplified one after another, on this thread.
+        // Although none of these passes look at more than one function, they can't
+        // run for different functions at the same time: every instruction they
+        // create or remove adds to or unlinks from the use lists of the module's
+        // global types and constants, all of the instructions come from the one
+        // memory arena of the module, and hoistable instructions are deduplicated
+        // through the one `IRDeduplicationContext`. Independent modules (one per
+        // target and entry point) are how code generation is run in parallel.
+        //
         for (auto inst : module->getGlobalInsts())
         {
             auto func = as<IRGlobalValueWithCode>(inst);
-            if (!func)
+            if (!func || convergedFuncs.contains(func))
                 continue;
             bool funcChanged = true;
             int funcIterationCount = 0;
             while (funcChanged && funcIterationCount < kMaxFuncIterations)
             {
-
-                eliminateDeadCode(func, options.deadCodeElimOptions);
+                eliminateDeadCode(
+                    func,
+                    funcIterationCount == 0 && iterationCounter == 0 ? options.deadCodeElimOptions
+                                                                     : incrementalDCEOptions);
                 funcChanged = false;
                 funcChanged |= applySparseConditionalConstantPropagation(func, target, sink);
                 funcChanged |= peepholeOptimize(target, func);
@@ -98,14 +163,19 @@ void simplifyIR(
                 // always returns true here. Run eliminate-dead-code twice to ensure optimizations
                 // are applied on the dce'd code.
                 //
-                eliminateDeadCode(func, options.deadCodeElimOptions);
+                eliminateDeadCode(func, incrementalDCEOptions);
                 if (funcIterationCount == 0)
                     funcChanged |= constructSSA(func);
                 changed |= funcChanged;
                 funcIterationCount++;
             }
+            if (!funcChanged)
+                convergedFuncs.add(func);
         }
         iterationCounter++;
+
+        if (changed && budget)
+            degradeIfOverBudget(budget->isExceeded());
     }
     eliminateDeadCode(module, options.deadCodeElimOptions);
 }
@@ -120,6 +190,12 @@ void simplifyNonSSAIR(
     const int kMaxIterations = 8;
     int iterationCounter = 0;
 
+    // The dead code eliminations in the loop only need to look at what the
+    // other passes left unused, as long as a full one follows the loop.
+    IRPossiblyDeadInstTrackingScope trackingScope(module);
+    auto incrementalDCEOptions = options.deadCodeElimOptions;
+    incrementalDCEOptions.onlyPossiblyDeadInsts = true;
+
     while (changed && iterationCounter < kMaxIterations)
     {
         changed = false;
@@ -134,12 +210,48 @@ void simplifyNonSSAIR(
         // SCCP pass could be generating temporarily evaluated constant values and never actually
         // use them. DCE will always remove those nearly generated consts and always returns true
         // here.
-        eliminateDeadCode(module, options.deadCodeElimOptions);
+        eliminateDeadCode(module, incrementalDCEOptions);
         iterationCounter++;
     }
+    eliminateDeadCode(module, options.deadCodeElimOptions);
 }
 
 
+void simplifyIRBeforeLinking(IRModule* module, DiagnosticSink* sink)
+{
+    SLANG_PROFILE;
+    const int kMaxFuncIterations = 16;
+
+    // Code exported from the module, or with a layout, is used by whatever links
+    // against it, so it has to be kept alive just as it is during lowering.
+    IRDeadCodeEliminationOptions dceOptions;
+    dceOptions.keepExportsAlive = true;
+    dceOptions.keepLayoutsAlive = true;
+    auto peepholeOptions = PeepholeOptimizationOptions::getPrelinking();
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRGlobalValueWithCode>(inst);
+        if (!func)
+            continue;
+        for (int iteration = 0; iteration < kMaxFuncIterations; iteration++)
+        {
+            if (sink && sink->getErrorCount())
+                return;
+
+            bool changed = false;
+            changed |= applySparseConditionalConstantPropagation(func, nullptr, sink);
+            changed |= peepholeOptimize(nullptr, func, peepholeOptions);
+            changed |= simplifyCFG(func, CFGSimplificationOptions::getDefault());
+            eliminateDeadCode(func, dceOptions);
+            changed |= constructSSA(func);
+            if (!changed)
+                break;
+        }
+    }
+    eliminateDeadCode(module, dceOptions);
+}
+
 void simplifyFunc(
     TargetProgram* target,
     IRGlobalValueWithCode* func,
@@ -9,6 +9,7 @@ namespace Slang
 {
 struct IRModule;
 struct IRGlobalValueWithCode;
+class CompileTimeBudget;
 class DiagnosticSink;
 class TargetProgram;
 
@@ -22,6 +23,10 @@ struct IRSimplificationOptions
     bool removeRedundancy = false;
     bool hoistLoopInvariantInsts = false;
 
+    // When set, `simplifyIR` falls back to the settings of `minimalOptimization`, and stops
+    // iterating early, when running it in full would go over the budget.
+    CompileTimeBudget* budget = nullptr;
+
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
     static IRSimplificationOptions getFast(TargetProgram* targetProgram);
@@ -42,6 +47,12 @@ void simplifyNonSSAIR(
     IRSimplificationOptions options,
     DiagnosticSink* sink = nullptr);
 
+// Run the passes that lowering runs on a module once (SSA, SCCP, SimplifyCFG, the
+// peephole optimizations that are valid before linking, and DeadCodeElimination) on
+// each of its functions until no more changes are possible. The result doesn't depend
+// on any target, so it can be serialized with the module.
+void simplifyIRBeforeLinking(IRModule* module, DiagnosticSink* sink = nullptr);
+
 void simplifyFunc(
     TargetProgram* target,
     IRGlobalValueWithCode* func,
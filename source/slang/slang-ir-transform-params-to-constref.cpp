@@ -183,7 +183,7 @@ struct TransformParamsToConstRefContext
     }
 
     // Check if `load` is an `IRLoad(addr)` where `addr` is a immutable location.
-    IRInst* isLoadFromImmutableAddress(IRInst* load)
+    virtual IRInst* isLoadFromImmutableAddress(IRInst* load)
     {
         if (load->getOp() != kIROp_Load)
             return nullptr;
@@ -428,6 +428,29 @@ SlangResult transformParamsToConstRef(IRModule* module, DiagnosticSink* sink)
     return context.processModule();
 }
 
+struct WGSLTransformParamsToConstRefContext : public TransformParamsToConstRefContext
+{
+    WGSLTransformParamsToConstRefContext(IRModule* module, DiagnosticSink* sink)
+        : TransformParamsToConstRefContext(module, sink)
+    {
+    }
+
+    // WGSL function parameters can only point into the function and private address spaces,
+    // so a value loaded from a constant buffer or parameter block is still copied into a
+    // temporary rather than passed by its address.
+    virtual IRInst* isLoadFromImmutableAddress(IRInst* load) override
+    {
+        SLANG_UNUSED(load);
+        return nullptr;
+    }
+};
+
+SlangResult transformParamsToConstRefForWGSL(IRModule* module, DiagnosticSink* sink)
+{
+    WGSLTransformParamsToConstRefContext context(module, sink);
+    return context.processModule();
+}
+
 struct EntryPointInParamToBorrowContext : public TransformParamsToConstRefContext
 {
     EntryPointInParamToBorrowContext(IRModule* module, DiagnosticSink* sink)
@@ -9,6 +9,10 @@ class DiagnosticSink;
 
 SlangResult transformParamsToConstRef(IRModule* module, DiagnosticSink* sink);
 
+// Like `transformParamsToConstRef`, but only passes the addresses of function-local values,
+// which are the only ones WGSL allows as pointer arguments.
+SlangResult transformParamsToConstRefForWGSL(IRModule* module, DiagnosticSink* sink);
+
 SlangResult translateEntryPointInParamToBorrow(IRModule* module, DiagnosticSink* sink);
 
 } // namespace Slang
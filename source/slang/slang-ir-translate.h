@@ -18,6 +18,12 @@ namespace Slang
 void initializeTranslationDictionary(IRModule* module);
 
 void clearTranslationDictionary(IRModule* module);
+
+// Derivatives are synthesized on demand, one function at a time, as `resolveInst` reaches
+// the translation insts that request them. This can't be spread over threads: every pass
+// creates insts through the module's deduplication context, records results in the shared
+// translation dictionary and annotation cache, and resolves the derivatives of callees
+// recursively while translating a caller.
 struct TranslationContext
 {
 
@@ -1126,10 +1126,6 @@ struct TypeFlowSpecializationContext
     template<typename T>
     T* unionSet(T* set1, T* set2)
     {
-        // It's possible to accelerate this further, but we usually
-        // don't have to deal with overly large sets (usually 3-20 elements)
-        //
-
         SLANG_ASSERT(as<IRSetBase>(set1) && as<IRSetBase>(set2));
         SLANG_ASSERT(set1->getOp() == set2->getOp());
 
@@ -1140,15 +1136,57 @@ struct TypeFlowSpecializationContext
         if (set1 == set2)
             return set1;
 
+        // Sets are hoistable and de-duplicated, so the pair of set insts identifies
+        // the union, and the same few unions tend to be requested over and over again
+        // as the propagation converges.
+        //
+        auto key = set1 < set2 ? KeyValuePair<IRInst*, IRInst*>(set1, set2)
+                               : KeyValuePair<IRInst*, IRInst*>(set2, set1);
+        if (auto cached = unionSetCache.tryGetValue(key))
+        {
+            if (auto cachedSet = as<T>((*cached)->getOperand(0)))
+                return cachedSet;
+        }
+
+        auto result = _unionSortedSets(set1, set2);
+
+        IRBuilder builder(module);
+        unionSetCache[key] = builder.getWeakUse(result);
+        return as<T>(result);
+    }
+
+    // Merge two sets whose elements are both sorted by unique ID (as `IRBuilder::getSet`
+    // creates them). If either set already contains the other, it is returned as-is without
+    // creating a new set.
+    //
+    IRSetBase* _unionSortedSets(IRSetBase* set1, IRSetBase* set2)
+    {
+        IRBuilder builder(module);
+
+        UInt count1 = set1->getOperandCount();
+        UInt count2 = set2->getOperandCount();
+        UInt i1 = 0;
+        UInt i2 = 0;
+        UInt unionCount = 0;
+        while (i1 < count1 && i2 < count2)
+        {
+            auto id1 = builder.getUniqueID(set1->getElement(i1));
+            auto id2 = builder.getUniqueID(set2->getElement(i2));
+            i1 += (id1 <= id2) ? 1 : 0;
+            i2 += (id2 <= id1) ? 1 : 0;
+            unionCount++;
+        }
+        unionCount += (count1 - i1) + (count2 - i2);
+
+        if (unionCount == count1)
+            return set1;
+        if (unionCount == count2)
+            return set2;
+
         HashSet<IRInst*> allValues;
-        // Collect all values from both sets
         forEachInSet(module, set1, [&](IRInst* value) { allValues.add(value); });
         forEachInSet(module, set2, [&](IRInst* value) { allValues.add(value); });
-
-        IRBuilder builder(module);
-        return as<T>(builder.getSet(
-            set1->getOp(),
-            allValues)); // Create a new set with the union of values
+        return builder.getSet(set1->getOp(), allValues);
     }
 
     // Performs a flat (non-structural) union of two propagation infos that are
@@ -1412,6 +1450,16 @@ struct TypeFlowSpecializationContext
         addUsersToWorkQueue(context, inst, unionedInfo, workQueue);
     }
 
+    // Helper method to add a work item to re-process an inst, unless one is already waiting
+    // in the queue. Processing an inst always reads the latest info of its operands, so a
+    // single pending item covers any number of updates made before it is dequeued.
+    //
+    void enqueueInst(IRInst* context, IRInst* inst, WorkQueue<WorkItem>& workQueue)
+    {
+        if (pendingInsts.add(InstWithContext(context, inst)))
+            workQueue.enqueue(WorkItem(context, inst));
+    }
+
     // Helper method to add work items for all call sites of a function/generic.
     void addContextUsersToWorkQueue(IRInst* context, WorkQueue<WorkItem>& workQueue)
     {
@@ -1472,7 +1520,7 @@ struct TypeFlowSpecializationContext
             // If user is in a different block (or the inst is a param), add that block to work
             // queue.
             //
-            workQueue.enqueue(WorkItem(context, user));
+            enqueueInst(context, user, workQueue);
 
             // If user is a terminator, add intra-procedural edges
             if (auto terminator = as<IRTerminatorInst>(user))
@@ -1679,6 +1727,7 @@ struct TypeFlowSpecializationContext
             switch (item.type)
             {
             case WorkItem::Type::Inst:
+                pendingInsts.remove(InstWithContext(item.context, item.inst));
                 processInstForPropagation(item.context, item.inst, workQueue);
                 break;
             case WorkItem::Type::Block:
@@ -2271,7 +2320,7 @@ struct TypeFlowSpecializationContext
 
                     if (this->fieldUseSites.containsKey(field))
                         for (auto useSite : this->fieldUseSites[field])
-                            workQueue.enqueue(WorkItem(useSite.context, useSite.inst));
+                            enqueueInst(useSite.context, useSite.inst, workQueue);
                 }
             }
 
@@ -4872,7 +4921,7 @@ struct TypeFlowSpecializationContext
 
                             if (this->fieldUseSites.containsKey(foundField))
                                 for (auto useSite : this->fieldUseSites[foundField])
-                                    workQueue.enqueue(WorkItem(useSite.context, useSite.inst));
+                                    enqueueInst(useSite.context, useSite.inst, workQueue);
                         }
                     }
                 }
@@ -6598,7 +6647,7 @@ struct TypeFlowSpecializationContext
         if (dispatchFuncType == nullptr)
             return nullptr;
 
-        auto dispatchFunc = createDispatchFunc(dispatchFuncType, elements);
+        auto dispatchFunc = createDispatchFunc(dispatchFuncType, elements, dispatchFrequencyHints);
 
         // Add a name hint based on the actions.
         {
@@ -8172,10 +8221,12 @@ struct TypeFlowSpecializationContext
         TargetProgram* target,
         DiagnosticSink* sink,
         SpecializationContext* specContext,
-        bool shouldReportDynamicDispatchSites)
+        bool shouldReportDynamicDispatchSites,
+        DispatchFrequencyHints const* dispatchFrequencyHints)
         : module(module)
         , sink(sink)
         , shouldReportDynamicDispatchSites(shouldReportDynamicDispatchSites)
+        , dispatchFrequencyHints(dispatchFrequencyHints)
         , specContext(specContext)
         , translationContext(target, module, specContext, sink)
     {
@@ -8186,6 +8237,7 @@ struct TypeFlowSpecializationContext
     IRModule* module;
     DiagnosticSink* sink;
     bool shouldReportDynamicDispatchSites;
+    DispatchFrequencyHints const* dispatchFrequencyHints;
 
     // Set of parameters already diagnosed for ref/constref interface issues,
     // to avoid emitting duplicate diagnostics per call edge.
@@ -8240,6 +8292,12 @@ struct TypeFlowSpecializationContext
     // IRFunc / IRSpecialize / IRSpecializeExistentialsInFunc as context.
     Dictionary<InstWithContext, IRWeakUse*> propagationMap;
 
+    // Set of (context, inst) pairs that currently have a work item in the propagation queue.
+    HashSet<InstWithContext> pendingInsts;
+
+    // Cache of `unionSet` results, keyed by the pair of input sets.
+    Dictionary<KeyValuePair<IRInst*, IRInst*>, IRWeakUse*> unionSetCache;
+
     // Mapping from context --> return value info
     Dictionary<IRInst*, IRInst*> funcReturnInfo;
 
@@ -8304,10 +8362,16 @@ bool specializeDynamicInsts(
     TargetProgram* target,
     DiagnosticSink* sink,
     SpecializationContext* outerContext,
-    bool shouldReportDynamicDispatchSites)
+    bool shouldReportDynamicDispatchSites,
+    DispatchFrequencyHints const* dispatchFrequencyHints)
 {
-    TypeFlowSpecializationContext
-        context(module, target, sink, outerContext, shouldReportDynamicDispatchSites);
+    TypeFlowSpecializationContext context(
+        module,
+        target,
+        sink,
+        outerContext,
+        shouldReportDynamicDispatchSites,
+        dispatchFrequencyHints);
     return context.processModule();
 }
 
@@ -5,6 +5,7 @@
 
 namespace Slang
 {
+struct DispatchFrequencyHints;
 struct SpecializationContext;
 
 // Convert dynamic insts such as `LookupWitnessMethod`, `ExtractExistentialValue`,
@@ -23,7 +24,8 @@ bool specializeDynamicInsts(
     TargetProgram* target,
     DiagnosticSink* sink,
     SpecializationContext* context,
-    bool shouldReportDynamicDispatchSites);
+    bool shouldReportDynamicDispatchSites,
+    DispatchFrequencyHints const* dispatchFrequencyHints = nullptr);
 
 bool isSetSpecializedGeneric(IRInst* callee);
 
@@ -501,4 +501,204 @@ void validateUniformity(IRModule* module, DiagnosticSink* sink)
     context.sink = sink;
     context.analyzeModule();
 }
+
+// A branch whose targets hold fewer insts than this, with no side effects, is left for the
+// downstream compiler to flatten if it wants to.
+static const Index kMinUniformBranchInstCount = 8;
+
+// The depth to which operands are followed when proving a value uniform.
+static const Index kMaxUniformValueDepth = 16;
+
+struct UniformityHintContext
+{
+    Dictionary<IRInst*, bool> uniformValues;
+
+    // Is `param`, an entry point or global parameter, the same for every invocation?
+    bool isUniformParam(IRInst* param)
+    {
+        auto varLayout = findVarLayout(param);
+        if (!varLayout)
+            return false;
+        return !isVaryingParameter(varLayout) && !varLayout->findAttr<IRSystemValueSemanticAttr>();
+    }
+
+    // Returns true only if `inst` is known to have the same value in every invocation.
+    //
+    // Unlike `validateUniformity`, which assumes a value is uniform unless it is derived from
+    // a known non-uniform source, this assumes nothing: only constants, uniform parameters,
+    // loads from constant buffers and pure arithmetic on those are accepted. Values read from
+    // writable memory or returned by intrinsics, such as atomics and wave prefix operations,
+    // can differ between invocations without the validation analysis noticing.
+    bool isDefinitelyUniform(IRInst* inst, Index depth = 0)
+    {
+        // Struct keys name a field, as operands of field accesses, and are the same everywhere.
+        if (as<IRConstant>(inst) || as<IRType>(inst) || as<IRStructKey>(inst))
+            return true;
+        if (auto cached = uniformValues.tryGetValue(inst))
+            return *cached;
+        if (depth > kMaxUniformValueDepth)
+            return false;
+
+        bool result = false;
+        switch (inst->getOp())
+        {
+        case kIROp_GlobalParam:
+            result = isUniformParam(inst);
+            break;
+        case kIROp_Param:
+            {
+                auto block = as<IRBlock>(inst->getParent());
+                auto func = block ? as<IRFunc>(block->getParent()) : nullptr;
+                result = func && block == func->getFirstBlock() &&
+                         func->findDecoration<IREntryPointDecoration>() && isUniformParam(inst);
+            }
+            break;
+        case kIROp_Load:
+            {
+                auto ptr = as<IRLoad>(inst)->getPtr();
+                auto root = getRootAddr(ptr);
+                if (!as<IRUniformParameterGroupType>(root->getDataType()) ||
+                    !isDefinitelyUniform(root, depth + 1))
+                    break;
+                result = true;
+                for (auto addr = ptr; addr != root; addr = addr->getOperand(0))
+                {
+                    // Only element accesses have an index that can vary; field accesses
+                    // name a field with a struct key.
+                    if (addr->getOp() == kIROp_GetElementPtr &&
+                        !isDefinitelyUniform(addr->getOperand(1), depth + 1))
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            break;
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_IRem:
+        case kIROp_FRem:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_BitAnd:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        case kIROp_BitNot:
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Less:
+        case kIROp_Greater:
+        case kIROp_Leq:
+        case kIROp_Geq:
+        case kIROp_IntCast:
+        case kIROp_FloatCast:
+        case kIROp_CastIntToFloat:
+        case kIROp_CastFloatToInt:
+        case kIROp_BitCast:
+        case kIROp_FieldExtract:
+        case kIROp_GetElement:
+        case kIROp_MakeVector:
+        case kIROp_MakeVectorFromScalar:
+        case kIROp_Swizzle:
+        case kIROp_Select:
+            result = true;
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                if (!isDefinitelyUniform(inst->getOperand(i), depth + 1))
+                {
+                    result = false;
+                    break;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+        uniformValues[inst] = result;
+        return result;
+    }
+
+    // Is there enough work behind a branch that executing both sides would cost more
+    // than a branch on a uniform condition?
+    bool isBranchWorthKeeping(List<IRBlock*> const& targets)
+    {
+        Index instCount = 0;
+        for (auto block : targets)
+        {
+            for (auto inst : block->getOrdinaryInsts())
+            {
+                if (inst->mightHaveSideEffects() && !as<IRTerminatorInst>(inst))
+                    return true;
+                instCount++;
+            }
+        }
+        return instCount >= kMinUniformBranchInstCount;
+    }
+
+    void processBranch(
+        IRBuilder& builder,
+        IRInst* branch,
+        IRInst* condition,
+        List<IRBlock*> const& targets)
+    {
+        if (branch->findDecorationImpl(kIROp_BranchDecoration) ||
+            branch->findDecorationImpl(kIROp_FlattenDecoration))
+            return;
+        if (!isDefinitelyUniform(condition) || !isBranchWorthKeeping(targets))
+            return;
+        builder.addDecoration(branch, kIROp_BranchDecoration);
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        IRBuilder builder(func);
+        List<IRBlock*> targets;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst = block->getFirstInst(); inst;)
+            {
+                auto next = inst->getNextInst();
+                if (inst->getOp() == kIROp_NonUniformResourceIndex &&
+                    isDefinitelyUniform(inst->getOperand(0)))
+                {
+                    inst->replaceUsesWith(inst->getOperand(0));
+                    inst->removeAndDeallocate();
+                }
+                inst = next;
+            }
+
+            auto terminator = block->getTerminator();
+            targets.clear();
+            if (auto ifElse = as<IRIfElse>(terminator))
+            {
+                targets.add(ifElse->getTrueBlock());
+                targets.add(ifElse->getFalseBlock());
+                processBranch(builder, ifElse, ifElse->getCondition(), targets);
+            }
+            else if (auto switchInst = as<IRSwitch>(terminator))
+            {
+                for (UInt c = 0; c < switchInst->getCaseCount(); c++)
+                    targets.add(switchInst->getCaseLabel(c));
+                targets.add(switchInst->getDefaultLabel());
+                processBranch(builder, switchInst, switchInst->getCondition(), targets);
+            }
+        }
+    }
+};
+
+void applyUniformityHints(IRModule* module)
+{
+    UniformityHintContext context;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(globalInst))
+            context.processFunc(func);
+    }
+}
 } // namespace Slang
@@ -7,4 +7,14 @@ struct IRModule;
 class DiagnosticSink;
 
 void validateUniformity(IRModule* module, DiagnosticSink* sink);
+
+/// Use what is known about which values are the same in every invocation to help the
+/// downstream compiler:
+///
+/// - `NonUniformResourceIndex` is removed from indices that are provably uniform, so the
+///   resource access doesn't need to be scalarized with a loop over the distinct indices.
+/// - Branches on provably uniform conditions are marked with `[branch]`, since every
+///   invocation takes the same side and the other side never needs to be executed.
+///
+void applyUniformityHints(IRModule* module);
 } // namespace Slang
@@ -1416,9 +1416,12 @@ IRInst* emitLoopBlocks(
 
 void sortBlocksInFunc(IRGlobalValueWithCode* func)
 {
-    auto order = getReverseMirroredPostorder(func);
-    for (auto block : order)
+    auto& pool = func->getModule()->getContainerPool();
+    auto order = pool.getList<IRBlock>();
+    computeReverseMirroredPostorder(func, *order);
+    for (auto block : *order)
         block->insertAtEnd(func);
+    pool.free(order);
 }
 
 void removeLinkageDecorations(IRInst* inst)
@@ -1960,12 +1963,26 @@ void resetScratchDataBit(IRInst* inst, int bitIndex)
     {
         auto item = workList.getLast();
         workList.removeLast();
-        item->scratchData &= ~(1ULL << bitIndex);
+        item->scratchData &= ~(1u << bitIndex);
         for (auto child = item->getLastDecorationOrChild(); child; child = child->getPrevInst())
             workList.add(child);
     }
 }
 
+void IRInstNumbering::build(IRGlobalValueWithCode* code)
+{
+    m_insts.clear();
+    for (auto block : code->getBlocks())
+    {
+        m_insts.add(block);
+        for (auto inst : block->getDecorationsAndChildren())
+            m_insts.add(inst);
+    }
+
+    for (Index i = 0; i < m_insts.getCount(); i++)
+        m_insts[i]->scratchData = uint32_t(i);
+}
+
 ///
 /// IRBlock related common helper methods
 ///
@@ -2119,13 +2136,13 @@ List<IRBlock*> collectBlocksInRegion(
     IRLoop* loopInst,
     bool* outHasMultiLevelBreaks)
 {
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
     return collectBlocksInRegion(dom, loopInst, outHasMultiLevelBreaks);
 }
 
 List<IRBlock*> collectBlocksInRegion(IRGlobalValueWithCode* func, IRLoop* loopInst)
 {
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     return collectBlocksInRegion(dom, loopInst, &hasMultiLevelBreaks);
 }
@@ -2649,7 +2666,7 @@ void legalizeDefUse(IRGlobalValueWithCode* func, TargetProgram* target)
     // fixes up such situations by creating temporary variables in the common dominator block, and
     // insert a store to the variable in the inner region, and replacing the uses with loads from
     // the variable.
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
 
     // Make a map of loop condition blocks to their loop header.
     // We need this because we'll be treating loop condition blocks as
@@ -345,6 +345,41 @@ IRPtrTypeBase* isMutablePointerType(IRInst* inst);
 
 void initializeScratchData(IRInst* inst);
 void resetScratchDataBit(IRInst* inst, int bitIndex);
+
+/// A dense numbering of the blocks and instructions of a function.
+///
+/// Passes that keep a value per instruction can index a `List` or `UIntSet`
+/// with these numbers instead of hashing pointers into a `Dictionary` or `HashSet`.
+///
+/// The number of each instruction is stored in its `scratchData`, so a numbering
+/// is only usable within the pass that built it. Lookups check the stored number
+/// against the numbered instructions, so an instruction that was added after the
+/// numbering was built (or whose scratch data was overwritten) is reported as
+/// unnumbered rather than aliasing another one. Call `build` again after changing
+/// the function.
+struct IRInstNumbering
+{
+    /// Number all of the blocks of `code` and the instructions in them, in order.
+    void build(IRGlobalValueWithCode* code);
+
+    /// Get the number of numbered instructions.
+    Index getCount() const { return m_insts.getCount(); }
+
+    /// Get the instruction with the number `index`.
+    IRInst* getInst(Index index) const { return m_insts[index]; }
+
+    /// Get the number of `inst`, or -1 if it isn't numbered.
+    Index getIndex(IRInst* inst) const
+    {
+        Index index = Index(inst->scratchData);
+        if (index >= m_insts.getCount() || m_insts[index] != inst)
+            return -1;
+        return index;
+    }
+
+private:
+    List<IRInst*> m_insts;
+};
 ///
 /// IRBlock related common helper methods
 ///
@@ -25,6 +25,10 @@ struct IRValidateContext
     // A set of instructions we've seen, to help confirm that
     // values are defined before they are used in a given block.
     HashSet<IRInst*> seenInsts;
+
+    // If set, the code of a global value is only validated when its fingerprint
+    // differs from the one recorded here, and is recorded once validated.
+    Dictionary<IRInst*, HashCode64>* validatedCodeFingerprints = nullptr;
 };
 
 // Context class for structured buffer validation
@@ -383,6 +387,27 @@ void validateCodeBody(IRValidateContext* context, IRGlobalValueWithCode* code)
     }
 }
 
+// Fold the identity, opcode, type and operands of `inst` and everything nested in it into
+// `hasher`. The parent of each operand is included too, so that removing an instruction
+// the code refers to changes the result even though the code itself is untouched.
+static void _hashCodeStructure(Hasher& hasher, IRInst* inst)
+{
+    hasher.hashValue(inst);
+    hasher.hashValue(UInt(inst->getOp()));
+    hasher.hashValue(inst->getFullType());
+    UInt operandCount = inst->getOperandCount();
+    hasher.hashValue(operandCount);
+    for (UInt ii = 0; ii < operandCount; ++ii)
+    {
+        auto operand = inst->getOperand(ii);
+        hasher.hashValue(operand);
+        if (operand)
+            hasher.hashValue(operand->getParent());
+    }
+    for (auto child : inst->getDecorationsAndChildren())
+        _hashCodeStructure(hasher, child);
+}
+
 void validateIRInst(IRValidateContext* context, IRInst* inst)
 {
     // Validate that any operands of the instruction are used appropriately
@@ -391,6 +416,18 @@ void validateIRInst(IRValidateContext* context, IRInst* inst)
 
     if (auto code = as<IRGlobalValueWithCode>(inst))
     {
+        // Hashing the code is much cheaper than validating it: it needs neither a
+        // dominator tree nor the set of seen instructions.
+        if (context->validatedCodeFingerprints)
+        {
+            Hasher hasher;
+            _hashCodeStructure(hasher, code);
+            auto fingerprint = hasher.getResult();
+            auto recorded = context->validatedCodeFingerprints->tryGetValue(code);
+            if (recorded && *recorded == fingerprint)
+                return;
+            context->validatedCodeFingerprints->set(code, fingerprint);
+        }
         context->domTree = computeDominatorTree(code);
         validateCodeBody(context, code);
     }
@@ -415,12 +452,16 @@ void validateIRInst(IRInst* inst)
     validateIRInst(context, inst);
 }
 
-void validateIRModule(IRModule* module, DiagnosticSink* sink)
+static void _validateIRModule(
+    IRModule* module,
+    DiagnosticSink* sink,
+    Dictionary<IRInst*, HashCode64>* validatedCodeFingerprints)
 {
     IRValidateContext contextStorage;
     IRValidateContext* context = &contextStorage;
     context->module = module;
     context->sink = sink;
+    context->validatedCodeFingerprints = validatedCodeFingerprints;
 
     auto moduleInst = module->getModuleInst();
 
@@ -432,6 +473,11 @@ void validateIRModule(IRModule* module, DiagnosticSink* sink)
     validateIRInst(context, moduleInst);
 }
 
+void validateIRModule(IRModule* module, DiagnosticSink* sink)
+{
+    _validateIRModule(module, sink, nullptr);
+}
+
 void validateIRModuleIfEnabled(CompileRequestBase* compileRequest, IRModule* module)
 {
     if (!compileRequest->getLinkage()->m_optionSet.getBoolOption(CompilerOptionName::ValidateIr))
@@ -446,8 +492,29 @@ void validateIRModuleIfEnabled(CodeGenContext* codeGenContext, IRModule* module)
     if (!codeGenContext->shouldValidateIR())
         return;
 
-    auto sink = codeGenContext->getSink();
-    validateIRModule(module, sink);
+    validateIRModuleAtValidationPoint(codeGenContext, module);
+}
+
+void validateIRModuleAtValidationPoint(CodeGenContext* codeGenContext, IRModule* module)
+{
+    auto& options = codeGenContext->getTargetProgram()->getOptionSet();
+    auto& state = codeGenContext->getIRValidationState();
+
+    auto interval = options.getIntOption(CompilerOptionName::ValidateIRInterval);
+    if (interval > 1 && (state.validationPointCount++ % UInt(interval)) != 0)
+        return;
+
+    Dictionary<IRInst*, HashCode64>* fingerprints = nullptr;
+    if (options.getBoolOption(CompilerOptionName::ValidateIRChangedOnly))
+    {
+        if (state.module != module)
+        {
+            state.module = module;
+            state.validatedCodeFingerprints.clear();
+        }
+        fingerprints = &state.validatedCodeFingerprints;
+    }
+    _validateIRModule(module, codeGenContext->getSink(), fingerprints);
 }
 
 // Returns whether 'dst' is a valid destination for atomic operations, meaning
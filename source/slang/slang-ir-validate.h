@@ -1,6 +1,8 @@
 // slang-ir-validate.h
 #pragma once
 
+#include "../core/slang-dictionary.h"
+
 namespace Slang
 {
 struct CodeGenContext;
@@ -36,6 +38,25 @@ void validateIRModuleIfEnabled(CompileRequestBase* compileRequest, IRModule* mod
 
 void validateIRModuleIfEnabled(CodeGenContext* codeGenContext, IRModule* module);
 
+// What the validation points of one code generation remember between them.
+struct IRValidationState
+{
+    // The module the fingerprints below belong to.
+    IRModule* module = nullptr;
+
+    // A fingerprint of the code of each global value with code as it was when it last
+    // passed validation, for `-validate-ir-changed-only`.
+    Dictionary<IRInst*, HashCode64> validatedCodeFingerprints;
+
+    // The number of validation points reached so far, for `-validate-ir-interval`.
+    UInt validationPointCount = 0;
+};
+
+// Validate `module` at a validation point of code generation. With `-validate-ir-interval N`
+// only every Nth point validates, and with `-validate-ir-changed-only` the code of global
+// values that hasn't changed since it last passed is skipped. Other checks always run.
+void validateIRModuleAtValidationPoint(CodeGenContext* codeGenContext, IRModule* module);
+
 // RAII class to manage IR validation state in an exception-safe manner
 class [[nodiscard]] IRValidationScope
 {
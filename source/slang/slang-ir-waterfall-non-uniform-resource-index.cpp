@@ -0,0 +1,289 @@
+// slang-ir-waterfall-non-uniform-resource-index.cpp
+#include "slang-ir-waterfall-non-uniform-resource-index.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+#include "slang-target-program.h"
+
+namespace Slang
+{
+
+struct NonUniformWaterfallContext
+{
+    IRModule* module;
+
+    // The `WaveReadLaneFirst` intrinsic for each index type.
+    Dictionary<IRType*, IRFunc*> readLaneFirstFuncs;
+
+    // The `NonUniformResourceIndex` insts that were removed while moving another one into a
+    // loop, and must not be visited.
+    HashSet<IRInst*> removedIndices;
+
+    IRFunc* getReadLaneFirstFunc(IRType* type)
+    {
+        if (auto func = readLaneFirstFuncs.tryGetValue(type))
+            return *func;
+
+        IRBuilder builder(module);
+        builder.setInsertInto(module->getModuleInst());
+        auto func = builder.createFunc();
+        builder.setDataType(func, builder.getFuncType(1, &type, type));
+        builder.addTargetIntrinsicDecoration(
+            func,
+            CapabilitySet(CapabilityName::hlsl),
+            UnownedStringSlice("WaveReadLaneFirst($0)"));
+        readLaneFirstFuncs.add(type, func);
+        return func;
+    }
+
+    // Ops that select the resource from the index, which are moved into the loop along with
+    // the accesses to the resource.
+    static bool isResourceSelectionOp(IROp op)
+    {
+        switch (op)
+        {
+        case kIROp_NonUniformResourceIndex:
+        case kIROp_IntCast:
+        case kIROp_GetElement:
+        case kIROp_GetElementPtr:
+        case kIROp_Load:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Can `inst`, which uses a selected resource, be performed only by the lanes that share
+    // an index? Calls are limited to intrinsics, such as the methods of textures, since a call
+    // to a function with a body could contain wave intrinsics or barriers.
+    static bool canAccessInLoop(IRInst* inst)
+    {
+        if (as<IRTerminatorInst>(inst))
+            return false;
+        if (auto call = as<IRCall>(inst))
+            return findAnyTargetIntrinsicDecoration(
+                       getResolvedInstForDecorations(call->getCallee())) != nullptr;
+        return true;
+    }
+
+    // Can a value computed in the loop be passed out of it through a variable?
+    static bool canPassOutOfLoop(IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        return type && !as<IRPtrTypeBase>(type) && isSimpleDataType(type);
+    }
+
+    bool tryWaterfall(IRInst* nonUniformIndex)
+    {
+        auto block = as<IRBlock>(nonUniformIndex->getParent());
+        auto func = block ? as<IRGlobalValueWithCode>(block->getParent()) : nullptr;
+        if (!func)
+            return false;
+        auto index = nonUniformIndex->getOperand(0);
+        auto indexType = index->getDataType();
+        if (!indexType || !isScalarIntegerType(indexType))
+            return false;
+
+        // Collect the insts that select a resource with the index, and the accesses that use
+        // the selected resources. All of them must be in the same block as the index.
+        HashSet<IRInst*> selection;
+        List<IRInst*> selectionList;
+        HashSet<IRInst*> accesses;
+        selection.add(nonUniformIndex);
+        selectionList.add(nonUniformIndex);
+        for (Index i = 0; i < selectionList.getCount(); i++)
+        {
+            for (auto use = selectionList[i]->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                if (user->getParent() != block)
+                    return false;
+                if (isResourceSelectionOp(user->getOp()))
+                {
+                    if (selection.add(user))
+                        selectionList.add(user);
+                }
+                else if (canAccessInLoop(user))
+                {
+                    accesses.add(user);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+        }
+        if (accesses.getCount() == 0)
+            return false;
+
+        // The loop holds the insts from the index to the last access. Other calls in between
+        // would only be made by some of the lanes in each iteration.
+        List<IRInst*> loopInsts;
+        Index remainingCount = selection.getCount() + accesses.getCount();
+        for (auto inst = nonUniformIndex; remainingCount != 0; inst = inst->getNextInst())
+        {
+            if (selection.contains(inst) || accesses.contains(inst))
+                remainingCount--;
+            else if (as<IRCall>(inst) || as<IRTerminatorInst>(inst))
+                return false;
+            loopInsts.add(inst);
+        }
+
+        HashSet<IRInst*> loopInstSet;
+        for (auto inst : loopInsts)
+            loopInstSet.add(inst);
+        List<IRInst*> escapingValues;
+        for (auto inst : loopInsts)
+        {
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                if (loopInstSet.contains(use->getUser()))
+                    continue;
+                if (!canPassOutOfLoop(inst))
+                    return false;
+                escapingValues.add(inst);
+                break;
+            }
+        }
+
+        // Pass the values used after the loop out of it through variables.
+        IRBuilder builder(module);
+        builder.setInsertBefore(func->getFirstBlock()->getFirstOrdinaryInst());
+        List<IRInst*> escapingVars;
+        for (auto value : escapingValues)
+            escapingVars.add(builder.emitVar(value->getDataType()));
+
+        auto headerBlock = builder.createBlock();
+        auto bodyBlock = builder.createBlock();
+        auto continueBlock = builder.createBlock();
+        auto mergeBlock = builder.createBlock();
+        headerBlock->insertAfter(block);
+        bodyBlock->insertAfter(headerBlock);
+        continueBlock->insertAfter(bodyBlock);
+        mergeBlock->insertAfter(continueBlock);
+
+        // Everything after the loop, including the terminator of the original block, moves
+        // to the merge block.
+        List<IRInst*> mergeInsts;
+        for (auto inst = loopInsts.getLast()->getNextInst(); inst; inst = inst->getNextInst())
+            mergeInsts.add(inst);
+        for (auto inst : mergeInsts)
+            inst->insertAtEnd(mergeBlock);
+        for (auto inst : loopInsts)
+            inst->insertAtEnd(bodyBlock);
+
+        builder.setInsertInto(block);
+        builder.emitLoop(headerBlock, mergeBlock, continueBlock);
+
+        builder.setInsertInto(headerBlock);
+        auto firstIndex =
+            builder.emitCallInst(indexType, getReadLaneFirstFunc(indexType), 1, &index);
+        builder.emitIf(builder.emitEql(firstIndex, index), bodyBlock, continueBlock);
+
+        builder.setInsertInto(continueBlock);
+        builder.emitBranch(headerBlock);
+
+        builder.setInsertInto(bodyBlock);
+        for (Index i = 0; i < escapingValues.getCount(); i++)
+            builder.emitStore(escapingVars[i], escapingValues[i]);
+        builder.emitBranch(mergeBlock);
+
+        builder.setInsertBefore(mergeBlock->getFirstInst());
+        for (Index i = 0; i < escapingValues.getCount(); i++)
+        {
+            auto value = escapingValues[i];
+            auto loadedValue = builder.emitLoad(escapingVars[i]);
+            traverseUses(
+                value,
+                [&](IRUse* use)
+                {
+                    if (!loopInstSet.contains(use->getUser()))
+                        builder.replaceOperand(use, loadedValue);
+                });
+        }
+
+        // Inside the loop the index is uniform, so the `NonUniformResourceIndex` insts are no
+        // longer needed.
+        for (auto inst : selectionList)
+        {
+            if (inst->getOp() != kIROp_NonUniformResourceIndex)
+                continue;
+            inst->replaceUsesWith(inst == nonUniformIndex ? firstIndex : inst->getOperand(0));
+            inst->removeAndDeallocate();
+            removedIndices.add(inst);
+        }
+
+        module->invalidateAnalysisForInst(func);
+        return true;
+    }
+
+    bool processModule()
+    {
+        List<IRInst*> nonUniformIndices;
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto func = as<IRGlobalValueWithCode>(globalInst);
+            if (!func)
+                continue;
+
+            // Implicit derivatives are undefined for the lanes that are inactive in an
+            // iteration of the loop.
+            if (auto entryPointDecor = func->findDecoration<IREntryPointDecoration>())
+            {
+                if (entryPointDecor->getProfile().getStage() == Stage::Fragment)
+                    return false;
+            }
+
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                {
+                    if (inst->getOp() == kIROp_NonUniformResourceIndex)
+                        nonUniformIndices.add(inst);
+                }
+            }
+        }
+
+        bool changed = false;
+        for (auto inst : nonUniformIndices)
+        {
+            if (!removedIndices.contains(inst))
+                changed |= tryWaterfall(inst);
+        }
+        return changed;
+    }
+};
+
+// Does `targetProgram` benefit from waterfall loops, and have the wave intrinsics to build
+// them?
+static bool shouldUseWaterfallLoops(TargetProgram* targetProgram)
+{
+    switch (targetProgram->getTargetReq()->getTarget())
+    {
+    case CodeGenTarget::HLSL:
+    case CodeGenTarget::DXIL:
+    case CodeGenTarget::DXILAssembly:
+        {
+            // Wave intrinsics need Shader Model 6.0. Without a profile, assume that the HLSL
+            // will be compiled by DXC.
+            auto profile = targetProgram->getOptionSet().getProfile();
+            return profile.getFamily() != ProfileFamily::DX ||
+                   profile.getVersion() >= ProfileVersion::DX_6_0;
+        }
+    default:
+        return false;
+    }
+}
+
+bool waterfallNonUniformResourceIndices(IRModule* module, TargetProgram* targetProgram)
+{
+    if (!shouldUseWaterfallLoops(targetProgram))
+        return false;
+
+    NonUniformWaterfallContext context;
+    context.module = module;
+    return context.processModule();
+}
+
+} // namespace Slang
@@ -0,0 +1,42 @@
+// slang-ir-waterfall-non-uniform-resource-index.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class TargetProgram;
+
+/// Turn accesses to resources selected with `NonUniformResourceIndex` into "waterfall" loops.
+///
+/// Indexing an array of resources with a non-uniform index makes the hardware select the
+/// descriptor of every lane separately, which is slow on GPUs that keep descriptors in scalar
+/// registers. A waterfall loop instead picks the index of the first active lane with
+/// `WaveReadLaneFirst`, lets every lane with that index perform its access with the now
+/// uniform index, and repeats for the remaining lanes until all of them are done:
+///
+///     for (;;)
+///     {
+///         uint first = WaveReadLaneFirst(index);
+///         if (first == index)
+///         {
+///             result = textures[first].Load(...);
+///             break;
+///         }
+///     }
+///
+/// Whether this is a win depends on the target, so the strategy is picked per target:
+///
+/// * HLSL and DXIL for Shader Model 6.0 and later get waterfall loops.
+/// * SPIR-V and GLSL keep the `NonUniform` decoration, which the drivers for the hardware that
+///   benefits from waterfall loops already lower to one.
+/// * Other targets either have no wave intrinsics or no descriptors, and are left as they are.
+///
+/// An access is only moved into a loop when the code between the index and the last access
+/// that uses it is in a single block and makes no calls other than those accesses, so that no
+/// wave intrinsic or barrier ends up being executed by only some of the lanes. Modules with a
+/// fragment shader entry point are left unchanged, since implicit derivatives are undefined
+/// inside the loop.
+///
+/// Returns true if any access was moved into a loop.
+bool waterfallNonUniformResourceIndices(IRModule* module, TargetProgram* targetProgram);
+} // namespace Slang
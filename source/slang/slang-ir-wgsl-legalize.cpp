@@ -37,6 +37,7 @@ static void legalizeCall(IRCall* call)
     };
     ShortList<WritebackPair> pendingWritebacks;
 
+    auto funcType = as<IRFuncType>(call->getCallee()->getDataType());
     for (UInt i = 0; i < call->getArgCount(); i++)
     {
         auto arg = call->getArg(i);
@@ -60,6 +61,11 @@ static void legalizeCall(IRCall* call)
         // Store the input argument into the local variable.
         builder.emitStore(var, builder.emitLoad(arg));
         builder.replaceOperand(call->getArgs() + i, var);
+
+        // A `borrow in` parameter is never written through, so there is nothing to write back.
+        if (funcType && i < funcType->getParamCount() &&
+            as<IRBorrowInParamType>(funcType->getParamType(i)))
+            continue;
         pendingWritebacks.add({arg, var});
     }
 
@@ -150,6 +150,72 @@ void IRUse::debugValidate()
 #endif
 }
 
+// The analyses that a module caches for a function, like its dominator tree, only
+// depend on the control-flow graph of the function. Every change to the blocks of a
+// function, or to the terminator instructions and block operands that connect them,
+// comes through here, so that cached results never go out of date.
+//
+static void _noteCFGChangedAt(IRInst* blockOrTerminator)
+{
+    auto block = as<IRBlock>(blockOrTerminator);
+    if (!block)
+        block = as<IRBlock>(blockOrTerminator->getParent());
+    if (!block)
+        return;
+    auto func = as<IRGlobalValueWithCode>(block->getParent());
+    if (!func)
+        return;
+    if (auto module = func->getModule())
+        module->_noteCFGChanged(func);
+}
+
+static bool _isCFGEdge(IRInst* user, IRInst* usedValue)
+{
+    return as<IRBlock>(usedValue) && as<IRTerminatorInst>(user);
+}
+
+// The number of modules that are tracking changed global instructions on this thread, so
+// that setting an operand or inserting an instruction only needs to look for the module
+// when one of them might be interested.
+static thread_local Index t_changedGlobalInstTrackingCount = 0;
+
+void IRModule::beginTrackingChangedGlobalInsts()
+{
+    m_changedGlobalInstTrackingDepth++;
+    t_changedGlobalInstTrackingCount++;
+}
+
+void IRModule::endTrackingChangedGlobalInsts()
+{
+    SLANG_ASSERT(m_changedGlobalInstTrackingDepth > 0);
+    t_changedGlobalInstTrackingCount--;
+    if (--m_changedGlobalInstTrackingDepth == 0)
+        m_changedGlobalInsts.clear();
+}
+
+// Record `inst` as changed if it is a global instruction, or record the global type or
+// witness table it is a member of.
+static void _maybeNoteChangedGlobalInst(IRInst* inst)
+{
+    if (!t_changedGlobalInstTrackingCount)
+        return;
+    auto parent = inst->getParent();
+    if (!parent)
+        return;
+    auto moduleInst = as<IRModuleInst>(parent);
+    if (!moduleInst)
+    {
+        if (as<IRGlobalValueWithCode>(parent))
+            return;
+        inst = parent;
+        moduleInst = as<IRModuleInst>(parent->getParent());
+        if (!moduleInst)
+            return;
+    }
+    if (moduleInst->module)
+        moduleInst->module->_noteChangedGlobalInst(inst);
+}
+
 void IRUse::init(IRInst* u, IRInst* v)
 {
     clear();
@@ -157,6 +223,9 @@ void IRUse::init(IRInst* u, IRInst* v)
     usedValue = v;
     if (v)
     {
+        if (_isCFGEdge(u, v))
+            _noteCFGChangedAt(u);
+
         nextUse = v->firstUse;
         prevLink = &v->firstUse;
 
@@ -167,6 +236,8 @@ void IRUse::init(IRInst* u, IRInst* v)
 
         v->firstUse = this;
     }
+    if (u)
+        _maybeNoteChangedGlobalInst(u);
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
     debugValidate();
 #endif
@@ -180,6 +251,25 @@ void IRUse::set(IRInst* uv)
     init(user, uv);
 }
 
+// The number of modules that are tracking possibly dead instructions on this thread,
+// so that removing a last use only needs to look for the module of the used value
+// when one of them might be interested.
+static thread_local Index t_possiblyDeadInstTrackingCount = 0;
+
+void IRModule::beginTrackingPossiblyDeadInsts()
+{
+    m_possiblyDeadInstTrackingDepth++;
+    t_possiblyDeadInstTrackingCount++;
+}
+
+void IRModule::endTrackingPossiblyDeadInsts()
+{
+    SLANG_ASSERT(m_possiblyDeadInstTrackingDepth > 0);
+    t_possiblyDeadInstTrackingCount--;
+    if (--m_possiblyDeadInstTrackingDepth == 0)
+        m_possiblyDeadInsts.clear();
+}
+
 void IRUse::clear()
 {
     // This `IRUse` is part of the linked list
@@ -190,9 +280,10 @@ void IRUse::clear()
 
     if (usedValue)
     {
-#ifdef SLANG_ENABLE_FULL_IR_VALIDATION
         auto uv = usedValue;
-#endif
+        if (_isCFGEdge(user, uv))
+            _noteCFGChangedAt(user);
+
         *prevLink = nextUse;
         if (nextUse)
         {
@@ -208,6 +299,12 @@ void IRUse::clear()
         if (uv->firstUse)
             uv->firstUse->debugValidate();
 #endif
+
+        if (!uv->firstUse && t_possiblyDeadInstTrackingCount)
+        {
+            if (auto module = uv->getModule())
+                module->_notePossiblyDeadInst(uv);
+        }
     }
 }
 
@@ -1341,9 +1438,7 @@ IRInst* IRBuilder::replaceOperand(IRUse* use, IRInst* newValue)
     auto user = use->getUser();
     if (user->getModule())
     {
-        user->getModule()->getDeduplicationContext()->getInstReplacementMap().tryGetValue(
-            newValue,
-            newValue);
+        newValue = user->getModule()->getDeduplicationContext()->getReplacementInst(newValue);
     }
 
     if (!getIROpInfo(user->getOp()).isHoistable())
@@ -1360,17 +1455,12 @@ IRInst* IRBuilder::replaceOperand(IRUse* use, IRInst* newValue)
     builder->_removeGlobalNumberingEntry(user);
     use->init(user, newValue);
 
-    IRInst* existingVal = nullptr;
-    if (builder->getGlobalValueNumberingMap().tryGetValue(IRInstKey{user}, existingVal))
+    if (IRInst* existingVal = builder->_findOrAddGlobalNumberingEntry(user))
     {
         user->replaceUsesWith(existingVal);
         return existingVal;
     }
-    else
-    {
-        builder->_addGlobalNumberingEntry(user);
-        return user;
-    }
+    return user;
 }
 
 // Given two parent instructions, pick the better one to use as as
@@ -1538,7 +1628,22 @@ IRInst* IRModule::_allocateInst(IROp op, Int operandCount, size_t minSizeInBytes
     size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
     size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-    IRInst* inst = (IRInst*)m_memoryArena.allocateAndZero(totalSize);
+    // Reuse the memory of a removed instruction of the same size if there is one
+    // (see `recycleRemovedInsts`).
+    //
+    IRInst* inst = nullptr;
+    if (totalSize == defaultSize && operandCount <= kMaxRecycledInstOperandCount)
+    {
+        if (auto recycled = m_recycledInsts[operandCount])
+        {
+            m_recycledInsts[operandCount] = recycled->next;
+            inst = (IRInst*)recycled;
+            memset(inst, 0, totalSize);
+        }
+    }
+    if (!inst)
+        inst = (IRInst*)m_memoryArena.allocateAndZero(totalSize);
+    m_createdInstCount++;
 
     // TODO: Is it actually important to run a constructor here?
     new (inst) IRInst();
@@ -1857,9 +1962,7 @@ IRInst* IRBuilder::_createInst(
     Int const* listArgCounts,
     IRInst* const* const* listArgs)
 {
-    IRInst* instReplacement = type;
-    m_dedupContext->getInstReplacementMap().tryGetValue(type, instReplacement);
-    type = (IRType*)instReplacement;
+    type = (IRType*)m_dedupContext->getReplacementInst(type);
 
     if (type && shouldHaveSpecConstRate(op, type, fixedArgCount, fixedArgs))
     {
@@ -1911,8 +2014,7 @@ IRInst* IRBuilder::_createInst(
     {
         if (fixedArgs)
         {
-            auto arg = fixedArgs[aa];
-            m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
+            auto arg = m_dedupContext->getReplacementInst(fixedArgs[aa]);
             operand->init(inst, arg);
         }
         else
@@ -1929,8 +2031,7 @@ IRInst* IRBuilder::_createInst(
         {
             if (listArgs[ii])
             {
-                auto arg = listArgs[ii][jj];
-                m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
+                auto arg = m_dedupContext->getReplacementInst(listArgs[ii][jj]);
                 operand->init(inst, arg);
             }
             else
@@ -2695,9 +2796,7 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
         IRUse* operand = inst->getOperands();
         for (Int ii = 0; ii < fixedArgCount; ++ii)
         {
-            auto arg = canonicalizedOperands[ii];
-            m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
-            operand->usedValue = arg;
+            operand->usedValue = m_dedupContext->getReplacementInst(canonicalizedOperands[ii]);
             operand++;
         }
         for (Int ii = 0; ii < varArgListCount; ++ii)
@@ -2705,9 +2804,7 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
             UInt listOperandCount = listArgCounts[ii];
             for (UInt jj = 0; jj < listOperandCount; ++jj)
             {
-                auto arg = listArgs[ii][jj];
-                m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
-                operand->usedValue = arg;
+                operand->usedValue = m_dedupContext->getReplacementInst(listArgs[ii][jj]);
                 operand++;
             }
         }
@@ -3060,12 +3157,12 @@ IRType* IRBuilder::getBindExistentialsType(
     if (slotArgCount == 0)
         return (IRType*)baseType;
 
-    List<IRInst*> slotArgs;
+    ShortList<IRInst*> slotArgs;
     for (UInt ii = 0; ii < slotArgCount; ++ii)
     {
         slotArgs.add(slotArgUses[ii].get());
     }
-    return getBindExistentialsType(baseType, slotArgCount, slotArgs.getBuffer());
+    return getBindExistentialsType(baseType, slotArgCount, slotArgs.getArrayView().getBuffer());
 }
 
 IRType* IRBuilder::getBoundInterfaceType(
@@ -3092,11 +3189,14 @@ IRType* IRBuilder::getAttributedType(
     UInt attributeCount,
     IRAttr* const* attributes)
 {
-    List<IRInst*> operands;
+    ShortList<IRInst*> operands;
     operands.add(baseType);
     for (UInt i = 0; i < attributeCount; ++i)
         operands.add(attributes[i]);
-    return getType(kIROp_AttributedType, operands.getCount(), operands.getBuffer());
+    return getType(
+        kIROp_AttributedType,
+        operands.getCount(),
+        operands.getArrayView().getBuffer());
 }
 
 
@@ -3442,14 +3542,8 @@ IRInst* IRBuilder::emitDebugVar(
 
 IRInst* IRBuilder::emitDebugValue(IRInst* debugVar, IRInst* debugValue)
 {
-    List<IRInst*> args;
-    args.add(debugVar);
-    args.add(debugValue);
-    return emitIntrinsicInst(
-        getVoidType(),
-        kIROp_DebugValue,
-        (UInt)args.getCount(),
-        args.getBuffer());
+    IRInst* args[] = {debugVar, debugValue};
+    return emitIntrinsicInst(getVoidType(), kIROp_DebugValue, SLANG_COUNT_OF(args), args);
 }
 
 IRInst* IRBuilder::emitDebugInlinedAt(
@@ -3584,14 +3678,17 @@ IRInst* IRBuilder::emitDispatchKernelInst(
     Int argCount,
     IRInst* const* inArgs)
 {
-    List<IRInst*> args = {baseFn, threadGroupSize, dispatchSize};
+    ShortList<IRInst*> args;
+    args.add(baseFn);
+    args.add(threadGroupSize);
+    args.add(dispatchSize);
     args.addRange(inArgs, (Index)argCount);
     auto inst = createInst<IRDispatchKernel>(
         this,
         kIROp_DispatchKernel,
         type,
         (Int)args.getCount(),
-        args.getBuffer());
+        args.getArrayView().getBuffer());
     addInst(inst);
     return inst;
 }
@@ -4124,11 +4221,17 @@ IRInst* IRBuilder::emitDefaultConstruct(IRType* type, bool fallback)
     return nullptr;
 }
 
-IRInst* IRBuilder::emitEmbeddedDownstreamIR(CodeGenTarget target, ISlangBlob* blob)
+IRInst* IRBuilder::emitEmbeddedDownstreamIR(
+    CodeGenTarget target,
+    ISlangBlob* blob,
+    UInt64 optionsKey)
 {
-    IRInst* args[] = {getIntValue(getIntType(), (int)target), getBlobValue(blob)};
+    IRInst* args[] = {
+        getIntValue(getIntType(), (int)target),
+        getBlobValue(blob),
+        getIntValue(getUInt64Type(), IRIntegerValue(optionsKey))};
 
-    return emitIntrinsicInst(getVoidType(), kIROp_EmbeddedDownstreamIR, 2, args);
+    return emitIntrinsicInst(getVoidType(), kIROp_EmbeddedDownstreamIR, 3, args);
 }
 
 enum class TypeCastStyle
@@ -4872,18 +4975,331 @@ RefPtr<IRModule> IRModule::create(Session* session)
     return module;
 }
 
+static bool _isLinkRootCandidate(IRInst* inst)
+{
+    if (as<IRGlobalParam>(inst))
+        return true;
+
+    for (auto decoration : inst->getDecorations())
+    {
+        switch (decoration->getOp())
+        {
+        case kIROp_HLSLExportDecoration:
+        case kIROp_DownstreamModuleExportDecoration:
+            return true;
+        case kIROp_KnownBuiltinDecoration:
+            if (as<IRKnownBuiltinDecoration>(decoration)->getName() ==
+                KnownBuiltinDeclName::NullDifferential)
+                return true;
+            break;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
 void IRModule::buildMangledNameToGlobalInstMap()
 {
     m_mapMangledNameToGlobalInst.clear();
+    m_linkRootCandidates.clear();
     for (auto inst : getGlobalInsts())
     {
         if (auto linkageDecor = inst->findDecoration<IRLinkageDecoration>())
         {
-            m_mapMangledNameToGlobalInst[linkageDecor->getMangledName()].add(inst);
+            m_mapMangledNameToGlobalInst[IRMangledNameKey(linkageDecor->getMangledName())].add(
+                inst);
         }
+        if (_isLinkRootCandidate(inst))
+            m_linkRootCandidates.add(inst);
     }
 }
 
+/// Get the number of bytes that `_allocateInst` handed out for `inst`.
+static size_t _getAllocatedInstSize(IRInst* inst)
+{
+    // This must agree with the sizes requested by `_allocateInst` and `_findOrEmitConstant`.
+    // `IRConstant` and `IRModuleInst` are the only instructions with state beyond their
+    // operands.
+    //
+    size_t size = sizeof(IRInst) + inst->getOperandCount() * sizeof(IRUse);
+    size_t minSize = 0;
+
+    const size_t constantPrefixSize = SLANG_OFFSET_OF(IRConstant, value);
+    switch (inst->getOp())
+    {
+    case kIROp_ModuleInst:
+        minSize = sizeof(IRModuleInst);
+        break;
+    case kIROp_BoolLit:
+    case kIROp_IntLit:
+        minSize = constantPrefixSize + sizeof(IRIntegerValue);
+        break;
+    case kIROp_FloatLit:
+        minSize = constantPrefixSize + sizeof(IRFloatingPointValue);
+        break;
+    case kIROp_PtrLit:
+    case kIROp_VoidLit:
+        minSize = constantPrefixSize + sizeof(void*);
+        break;
+    case kIROp_BlobLit:
+    case kIROp_StringLit:
+        minSize = constantPrefixSize + offsetof(IRConstant::StringValue, chars) +
+                  static_cast<IRConstant*>(inst)->value.stringVal.numChars;
+        break;
+    default:
+        break;
+    }
+    return minSize > size ? minSize : size;
+}
+
+void IRModule::recycleRemovedInsts()
+{
+    if (m_removedInsts.getCount() == 0)
+        return;
+
+    // An instruction may have been recorded more than once, and must only be
+    // recycled once.
+    //
+    m_removedInsts.sort();
+
+    bool recycledAny = false;
+    IRInst* prevInst = nullptr;
+    for (auto inst : m_removedInsts)
+    {
+        if (inst == prevInst)
+            continue;
+        prevInst = inst;
+
+        // Leave anything that is still reachable from the module alone.
+        if (inst->getParent() || inst->firstUse)
+            continue;
+        if (as<IRConstant>(inst) || getIROpInfo(inst->getOp()).isHoistable())
+            continue;
+
+        // An instruction that had operands removed is filed under its current
+        // operand count, which just leaves the rest of its memory unused.
+        //
+        const Int operandCount = Int(inst->getOperandCount());
+        if (operandCount > kMaxRecycledInstOperandCount)
+            continue;
+
+        auto recycled = (RecycledInst*)inst;
+        recycled->next = m_recycledInsts[operandCount];
+        m_recycledInsts[operandCount] = recycled;
+        recycledAny = true;
+    }
+    m_removedInsts.clear();
+
+    // Drop anything that might still refer to a recycled instruction.
+    if (recycledAny)
+    {
+        m_staleAnalyses.clear();
+        m_annotationLookupCache.clear();
+    }
+}
+
+bool IRModule::compact(Dictionary<IRInst*, IRInst*>& outOldToNew)
+{
+    outOldToNew.clear();
+
+    // The loader of deferred bodies holds on to the stubs it is going to fill in.
+    if (m_deferredBodyLoader)
+        return false;
+
+    // Collect the instructions in the order they will be laid out: each instruction comes
+    // right before its decorations and children.
+    //
+    List<IRInst*> insts;
+    {
+        List<IRInst*> stack;
+        stack.add(m_moduleInst);
+        while (stack.getCount())
+        {
+            IRInst* inst = stack.getLast();
+            stack.removeLast();
+            insts.add(inst);
+            for (auto child = inst->m_decorationsAndChildren.last; child; child = child->prev)
+                stack.add(child);
+        }
+    }
+
+    MemoryArena newArena(kMemoryArenaBlockSize);
+    outOldToNew.reserve(insts.getCount());
+    for (auto inst : insts)
+    {
+        const size_t size = _getAllocatedInstSize(inst);
+        void* newInst = newArena.allocate(size);
+        memcpy(newInst, inst, size);
+        outOldToNew.add(inst, (IRInst*)newInst);
+    }
+
+    auto remap = [&](IRInst* inst) -> IRInst*
+    {
+        if (!inst)
+            return nullptr;
+        if (auto newInst = outOldToNew.tryGetValue(inst))
+            return *newInst;
+        return nullptr;
+    };
+
+    // Everything the module refers to has to be part of it, or the new instructions would
+    // point into the arena that is about to be freed.
+    //
+    for (auto inst : insts)
+    {
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand = inst->getOperand(i);
+            if (operand && !remap(operand))
+            {
+                outOldToNew.clear();
+                return false;
+            }
+        }
+        auto type = inst->getFullType();
+        if (type && !remap(type))
+        {
+            outOldToNew.clear();
+            return false;
+        }
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            // Uses by instructions that are no longer part of the module go away with them,
+            // but any other use must be an operand of an instruction in the module.
+            auto user = use->getUser();
+            if (user && !remap(user))
+                continue;
+            const char* userStart = (const char*)user;
+            if (!user || (const char*)use < userStart ||
+                (const char*)use >= userStart + _getAllocatedInstSize(user))
+            {
+                outOldToNew.clear();
+                return false;
+            }
+        }
+    }
+
+    // Point the links between the instructions at their new locations.
+    for (auto inst : insts)
+    {
+        IRInst* newInst = remap(inst);
+        newInst->parent = remap(inst->parent);
+        newInst->next = remap(inst->next);
+        newInst->prev = remap(inst->prev);
+        newInst->m_decorationsAndChildren.first = remap(inst->m_decorationsAndChildren.first);
+        newInst->m_decorationsAndChildren.last = remap(inst->m_decorationsAndChildren.last);
+        newInst->firstUse = nullptr;
+
+        auto initUse = [&](IRUse& newUse, IRUse& oldUse)
+        {
+            newUse.user = newInst;
+            newUse.usedValue = remap(oldUse.usedValue);
+            newUse.nextUse = nullptr;
+            newUse.prevLink = nullptr;
+        };
+        initUse(newInst->typeUse, inst->typeUse);
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+            initUse(newInst->getOperands()[i], inst->getOperands()[i]);
+    }
+
+    // Rebuild the use lists, keeping the uses of each value in the same order.
+    for (auto inst : insts)
+    {
+        IRUse** link = &remap(inst)->firstUse;
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            IRInst* newUser = remap(use->getUser());
+            if (!newUser)
+                continue;
+            auto newUse = (IRUse*)((char*)newUser + ((char*)use - (char*)use->getUser()));
+            newUse->prevLink = link;
+            *link = newUse;
+            link = &newUse->nextUse;
+        }
+    }
+
+    // Update the state of the module that refers to instructions.
+    m_moduleInst = static_cast<IRModuleInst*>(remap(m_moduleInst));
+    m_translationDict = static_cast<IRCompilerDictionary*>(remap(m_translationDict));
+
+    {
+        List<IRInst*> possiblyDeadInsts;
+        for (auto inst : m_possiblyDeadInsts)
+        {
+            if (auto newInst = remap(inst))
+                possiblyDeadInsts.add(newInst);
+        }
+        m_possiblyDeadInsts = _Move(possiblyDeadInsts);
+    }
+
+    {
+        List<IRInst*> changedGlobalInsts;
+        for (auto inst : m_changedGlobalInsts)
+        {
+            if (auto newInst = remap(inst))
+                changedGlobalInsts.add(newInst);
+        }
+        m_changedGlobalInsts = _Move(changedGlobalInsts);
+    }
+
+    {
+        Dictionary<IRInst*, UInt> uniqueIds;
+        for (auto& [inst, id] : m_mapInstToUniqueId)
+        {
+            if (auto newInst = remap(inst))
+                uniqueIds.add(newInst, id);
+        }
+        m_mapInstToUniqueId = _Move(uniqueIds);
+    }
+
+    {
+        // The keys of the deduplication maps hash the operands of their instructions, so
+        // the maps are built again from the new instructions.
+        //
+        IRDeduplicationContext::GlobalValueNumberingMap globalValueNumberingMap;
+        for (auto& [key, inst] : m_deduplicationContext.getGlobalValueNumberingMap())
+        {
+            if (auto newInst = remap(inst))
+                globalValueNumberingMap.addIfNotExists(IRInstKey{newInst}, newInst);
+        }
+        m_deduplicationContext.getGlobalValueNumberingMap() = _Move(globalValueNumberingMap);
+
+        IRDeduplicationContext::ConstantMap constantMap;
+        for (auto& [key, inst] : m_deduplicationContext.getConstantMap())
+        {
+            if (auto newInst = static_cast<IRConstant*>(remap(inst)))
+                constantMap.addIfNotExists(IRConstantKey{newInst}, newInst);
+        }
+        m_deduplicationContext.getConstantMap() = _Move(constantMap);
+
+        Dictionary<IRInst*, IRInst*> replacementMap;
+        for (auto& [inst, replacement] : m_deduplicationContext.getInstReplacementMap())
+        {
+            auto newInst = remap(inst);
+            auto newReplacement = remap(replacement);
+            if (newInst && newReplacement)
+                replacementMap.add(newInst, newReplacement);
+        }
+        m_deduplicationContext.getInstReplacementMap() = _Move(replacementMap);
+    }
+
+    if (m_mapMangledNameToGlobalInst.getCount() || m_linkRootCandidates.getCount())
+        buildMangledNameToGlobalInstMap();
+
+    invalidateAllAnalysis();
+    m_annotationLookupCache.clear();
+
+    // Removed and recycled instructions live in the old arena.
+    m_removedInsts.clear();
+    for (auto& recycled : m_recycledInsts)
+        recycled = nullptr;
+
+    // The old arena, with everything in it, is freed when `newArena` goes out of scope.
+    m_memoryArena.swapWith(newArena);
+    return true;
+}
+
 IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
 {
     IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
@@ -5744,7 +6160,7 @@ IRInst* IRBuilder::emitUpdateElement(
     ArrayView<IRInst*> accessChain,
     IRInst* newElement)
 {
-    List<IRInst*> args;
+    ShortList<IRInst*> args;
     args.add(base);
     args.add(newElement);
     args.addRange(accessChain);
@@ -5753,7 +6169,7 @@ IRInst* IRBuilder::emitUpdateElement(
         kIROp_UpdateElement,
         base->getFullType(),
         (Int)args.getCount(),
-        args.getBuffer());
+        args.getArrayView().getBuffer());
     addInst(inst);
     return inst;
 }
@@ -6126,16 +6542,15 @@ IRInst* IRBuilder::emitBranch(IRBlock* pBlock)
 
 IRInst* IRBuilder::emitBranch(IRBlock* block, Int argCount, IRInst* const* args)
 {
-    List<IRInst*> argList;
+    ShortList<IRInst*> argList;
     argList.add(block);
-    for (Int i = 0; i < argCount; ++i)
-        argList.add(args[i]);
+    argList.addRange(args, argCount);
     auto inst = createInst<IRUnconditionalBranch>(
         this,
         kIROp_UnconditionalBranch,
         nullptr,
         argList.getCount(),
-        argList.getBuffer());
+        argList.getArrayView().getBuffer());
     addInst(inst);
     return inst;
 }
@@ -6167,17 +6582,19 @@ IRInst* IRBuilder::emitLoop(
     Int argCount,
     IRInst* const* args)
 {
-    List<IRInst*> argList;
+    ShortList<IRInst*> argList;
 
     argList.add(target);
     argList.add(breakBlock);
     argList.add(continueBlock);
+    argList.addRange(args, argCount);
 
-    for (Count ii = 0; ii < argCount; ii++)
-        argList.add(args[ii]);
-
-    auto inst =
-        createInst<IRLoop>(this, kIROp_Loop, nullptr, argList.getCount(), argList.getBuffer());
+    auto inst = createInst<IRLoop>(
+        this,
+        kIROp_Loop,
+        nullptr,
+        argList.getCount(),
+        argList.getArrayView().getBuffer());
     addInst(inst);
     return inst;
 }
@@ -8641,7 +9058,9 @@ static void _maybeHoistOperand(IRUse* use)
     }
 }
 
-static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
+// Replace the uses of the key of each pair in `replacements` with its value, in order.
+//
+static void _replaceInstUsesWith(ArrayView<KeyValuePair<IRInst*, IRInst*>> replacements)
 {
     IRDeduplicationContext* dedupContext = nullptr;
 
@@ -8667,15 +9086,21 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
         }
     };
 
-    addToWorkList(thisInst, other);
+    // All of the replacements share the work list, so that the users merged with an
+    // existing inst and the sets that need sorting again are only handled once for the
+    // whole batch.
+    //
+    for (auto& replacement : replacements)
+        addToWorkList(replacement.key, replacement.value);
 
     List<IRInst*> duplicateAnnotations;
     List<IRSetBase*> setsToUpdate;
+    HashSet<IRSetBase*> setsToUpdateSet;
     for (Index i = 0; i < workList.getCount(); i++)
     {
         auto workItem = workList[i];
-        thisInst = workItem.thisInst;
-        other = workItem.otherInst;
+        IRInst* thisInst = workItem.thisInst;
+        IRInst* other = workItem.otherInst;
 
         SLANG_ASSERT(other);
 
@@ -8730,10 +9155,17 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
             }
 
             // Swap this use over to use the other value.
+            if (_isCFGEdge(user, thisInst))
+                _noteCFGChangedAt(user);
             uu->usedValue = other;
+            // This bypasses `IRUse::init`, so the user has to be noted as changed here.
+            _maybeNoteChangedGlobalInst(user);
 
             if (auto setBase = as<IRSetBase>(uu->getUser()))
-                setsToUpdate.add(setBase);
+            {
+                if (setsToUpdateSet.add(setBase))
+                    setsToUpdate.add(setBase);
+            }
 
             // If `other` is hoistable, then we need to make sure `other` is hoisted
             // to a point before `user`, if it is not already so.
@@ -8754,7 +9186,7 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
                             existingConstant))
                     {
                         IRInst* existingVal = existingConstant;
-                        dedupContext->getInstReplacementMap().tryGetValue(existingVal, existingVal);
+                        existingVal = dedupContext->getReplacementInst(existingVal);
                         addToWorkList(user, existingVal);
                     }
                     else
@@ -8772,7 +9204,7 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
                             existingVal))
                     {
                         // If existingVal has been replaced by something else, use that.
-                        dedupContext->getInstReplacementMap().tryGetValue(existingVal, existingVal);
+                        existingVal = dedupContext->getReplacementInst(existingVal);
                         addToWorkList(user, existingVal);
 
                         if (!user->hasUses() && (as<IRAnnotation>(user)))
@@ -8822,6 +9254,14 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
         // And `this` will have no uses any more.
         thisInst->firstUse = nullptr;
 
+        // The uses were moved rather than cleared one at a time, so `IRUse::clear` didn't
+        // get to record that `this` may now be dead.
+        if (t_possiblyDeadInstTrackingCount)
+        {
+            if (auto module = thisInst->getModule())
+                module->_notePossiblyDeadInst(thisInst);
+        }
+
         ff->debugValidate();
     }
 
@@ -8830,7 +9270,10 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
     for (auto setInst : setsToUpdate)
     {
+        // A set can be merged into another one, and removed, while earlier sets are sorted.
         auto module = setInst->getModule();
+        if (!module)
+            continue;
         IRBuilder builder(module);
 
         HashSet<IRInst*>& elements = *module->getContainerPool().getHashSet<IRInst>();
@@ -8854,7 +9297,13 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
 void IRInst::replaceUsesWith(IRInst* other)
 {
-    _replaceInstUsesWith(this, other);
+    KeyValuePair<IRInst*, IRInst*> replacement(this, other);
+    _replaceInstUsesWith(makeArrayViewSingle(replacement));
+}
+
+void IRModule::replaceUsesWith(ArrayView<KeyValuePair<IRInst*, IRInst*>> replacements)
+{
+    _replaceInstUsesWith(replacements);
 }
 
 // Insert this instruction into the same basic block
@@ -8913,6 +9362,10 @@ void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     this->next = inNext;
     this->parent = inParent;
 
+    if (as<IRBlock>(this) || as<IRTerminatorInst>(this))
+        _noteCFGChangedAt(this);
+    _maybeNoteChangedGlobalInst(this);
+
 #if _DEBUG
     validateIRInstOperands(this);
 #endif
@@ -8973,6 +9426,9 @@ void IRInst::removeFromParent()
     if (!oldParent)
         return;
 
+    if (as<IRBlock>(this) || as<IRTerminatorInst>(this))
+        _noteCFGChangedAt(this);
+
     auto pp = getPrevInst();
     auto nn = getNextInst();
 
@@ -9038,9 +9494,10 @@ void IRInst::removeAndDeallocate()
         {
             module->getDeduplicationContext()->removeInstFromConstantMap(constInst);
         }
-        module->getDeduplicationContext()->getInstReplacementMap().remove(this);
+        module->getDeduplicationContext()->removeInstReplacement(this);
         if (auto func = as<IRGlobalValueWithCode>(this))
             module->invalidateAnalysisForInst(func);
+        module->_noteInstDestroyed(this);
     }
     removeArguments();
     removeFromParent();
@@ -10,6 +10,7 @@
 #include "../compiler-core/slang-source-map.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-stable-hash.h"
 #include "slang-ast-type.h"
 #include "slang-container-pool.h"
 #include "slang-ir-insts-enum.h"
@@ -560,6 +561,16 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // Reserved memory space for use by individual IR passes.
+    // This field is not supposed to be valid outside an IR pass,
+    // and each IR pass should always treat it as uninitialized
+    // upon entry.
+    //
+    // Note: this is kept 32 bits wide and placed beside the other
+    // 32-bit fields so that it fills what would otherwise be padding
+    // before the pointer fields below.
+    uint32_t scratchData = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -674,12 +685,6 @@ struct IRInst
     uint32_t _debugUID;
 #endif
 
-    // Reserved memory space for use by individual IR passes.
-    // This field is not supposed to be valid outside an IR pass,
-    // and each IR pass should always treat it as uninitialized
-    // upon entry.
-    UInt64 scratchData = 0;
-
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
@@ -2020,22 +2025,46 @@ public:
     GlobalValueNumberingMap& getGlobalValueNumberingMap() { return m_globalValueNumberingMap; }
     Dictionary<IRInst*, IRInst*>& getInstReplacementMap() { return m_instReplacementMap; }
 
+    /// Get the inst that `inst` has been replaced with, or `inst` itself if there is none.
+    ///
+    /// The replacement map is only non-empty while hoistable insts are being merged, so
+    /// the common case skips the lookup entirely rather than hashing every operand.
+    IRInst* getReplacementInst(IRInst* inst)
+    {
+        if (m_instReplacementMap.getCount() != 0)
+            m_instReplacementMap.tryGetValue(inst, inst);
+        return inst;
+    }
+    void removeInstReplacement(IRInst* inst)
+    {
+        if (m_instReplacementMap.getCount() != 0)
+            m_instReplacementMap.remove(inst);
+    }
+
     void _addGlobalNumberingEntry(IRInst* inst)
     {
         m_globalValueNumberingMap.add(IRInstKey{inst}, inst);
-        m_instReplacementMap.remove(inst);
+        removeInstReplacement(inst);
+        tryHoistInst(inst);
+    }
+    /// Add `inst` to the global numbering map unless an equivalent inst is already there.
+    /// Returns the existing equivalent inst, or null if `inst` was added.
+    IRInst* _findOrAddGlobalNumberingEntry(IRInst* inst)
+    {
+        // A single key (and so a single structural hash) serves both the lookup and the
+        // insertion.
+        if (IRInst** existing = m_globalValueNumberingMap.tryGetValueOrAdd(IRInstKey{inst}, inst))
+            return *existing;
+        removeInstReplacement(inst);
         tryHoistInst(inst);
+        return nullptr;
     }
     void _removeGlobalNumberingEntry(IRInst* inst)
     {
-        IRInst* value = nullptr;
-        if (m_globalValueNumberingMap.tryGetValue(IRInstKey{inst}, value))
-        {
-            if (value == inst)
-            {
-                m_globalValueNumberingMap.remove(IRInstKey{inst});
-            }
-        }
+        IRInstKey key{inst};
+        IRInst** value = m_globalValueNumberingMap.tryGetValue(key);
+        if (value && *value == inst)
+            m_globalValueNumberingMap.remove(key);
     }
 
     ConstantMap& getConstantMap() { return m_constantMap; }
@@ -2064,6 +2093,44 @@ struct IRAnalysis
     IRDominatorTree* getDominatorTree();
 };
 
+/// Reads in the bodies of global values for a module that was deserialized without them.
+///
+/// See `IRModule::ensureBodyLoaded`.
+class IRDeferredBodyLoader : public RefObject
+{
+public:
+    /// Read in the body of `globalInst`, if it was deferred and hasn't been read in yet.
+    virtual void loadBody(IRInst* globalInst) = 0;
+    /// Does `globalInst` have a body that hasn't been read in yet?
+    virtual bool hasDeferredBody(IRInst* globalInst) = 0;
+    /// Read in all of the bodies that haven't been read in yet.
+    virtual void loadAllBodies() = 0;
+};
+
+/// Key for looking up global insts by their mangled name.
+///
+/// The key does not own the name. In `IRModule`'s map it refers to the string literal of a
+/// linkage decoration, which lives as long as the module. The 64-bit hash is computed once,
+/// so a lookup only compares strings when the hashes are equal.
+///
+struct IRMangledNameKey
+{
+    UnownedStringSlice name;
+    StableHashCode64 hash = {0};
+
+    IRMangledNameKey() = default;
+    explicit IRMangledNameKey(UnownedStringSlice name)
+        : name(name), hash(getStableHashCode64(name.begin(), name.getLength()))
+    {
+    }
+
+    bool operator==(const IRMangledNameKey& other) const
+    {
+        return hash == other.hash && name == other.name;
+    }
+    HashCode64 getHashCode() const { return HashCode64(hash.hash); }
+};
+
 FIDDLE()
 struct IRModule : RefObject
 {
@@ -2080,6 +2147,70 @@ public:
     SLANG_FORCE_INLINE IRModuleInst* getModuleInst() const { return m_moduleInst; }
     SLANG_FORCE_INLINE MemoryArena& getMemoryArena() { return m_memoryArena; }
 
+    /// The number of instructions allocated in this module so far.
+    SLANG_FORCE_INLINE UInt64 getCreatedInstCount() const { return m_createdInstCount; }
+    /// The number of instructions of this module removed with `removeAndDeallocate` so far.
+    SLANG_FORCE_INLINE UInt64 getDestroyedInstCount() const { return m_destroyedInstCount; }
+    void _noteInstDestroyed(IRInst* inst)
+    {
+        m_destroyedInstCount++;
+        if (m_recycleRemovedInsts)
+            m_removedInsts.add(inst);
+    }
+
+    /// Enable or disable reuse of the memory of removed instructions, see
+    /// `recycleRemovedInsts`.
+    void setRecycleRemovedInsts(bool enable) { m_recycleRemovedInsts = enable; }
+
+    /// Make the memory of the instructions removed with `removeAndDeallocate` since the
+    /// last call available to `_allocateInst`.
+    ///
+    /// Removed instructions are only recorded while recycling is enabled with
+    /// `setRecycleRemovedInsts`. Nothing may hold on to a removed instruction when this
+    /// is called, so it should only be called between passes. Instructions that still
+    /// have uses or a parent, constants, and hoistable instructions are never reused.
+    void recycleRemovedInsts();
+
+    /// Start recording the instructions of this module that lose their last use, so
+    /// that `eliminateDeadCode` can look at just those when it is asked to with
+    /// `IRDeadCodeEliminationOptions::onlyPossiblyDeadInsts`.
+    ///
+    /// Calls may be nested, and each must be matched by `endTrackingPossiblyDeadInsts`
+    /// on the same thread. Only uses removed on that thread are recorded.
+    void beginTrackingPossiblyDeadInsts();
+    void endTrackingPossiblyDeadInsts();
+    bool isTrackingPossiblyDeadInsts() const { return m_possiblyDeadInstTrackingDepth != 0; }
+
+    /// The instructions that lost their last use while tracking was on. The list can
+    /// hold an instruction more than once, and instructions that have been removed since.
+    List<IRInst*>& getPossiblyDeadInsts() { return m_possiblyDeadInsts; }
+    void _notePossiblyDeadInst(IRInst* inst)
+    {
+        if (m_possiblyDeadInstTrackingDepth)
+            m_possiblyDeadInsts.add(inst);
+    }
+
+    /// Start recording the global instructions of this module that are inserted into the
+    /// module, or that have an operand set, so that the global scope peephole and SCCP passes
+    /// can look at just those instead of at every global instruction. A change to a member of
+    /// a global type or witness table is recorded as a change to that type or witness table.
+    /// Changes inside function bodies are not recorded.
+    ///
+    /// Calls may be nested, and each must be matched by `endTrackingChangedGlobalInsts` on the
+    /// same thread. Only changes made on that thread are recorded.
+    void beginTrackingChangedGlobalInsts();
+    void endTrackingChangedGlobalInsts();
+    bool isTrackingChangedGlobalInsts() const { return m_changedGlobalInstTrackingDepth != 0; }
+
+    /// The global instructions that changed while tracking was on. The list can hold an
+    /// instruction more than once, and instructions that have been removed since.
+    List<IRInst*>& getChangedGlobalInsts() { return m_changedGlobalInsts; }
+    void _noteChangedGlobalInst(IRInst* inst)
+    {
+        if (m_changedGlobalInstTrackingDepth)
+            m_changedGlobalInsts.add(inst);
+    }
+
     SLANG_FORCE_INLINE IBoxValue<SourceMap>* getObfuscatedSourceMap() const
     {
         return m_obfuscatedSourceMap;
@@ -2089,15 +2220,77 @@ public:
         m_obfuscatedSourceMap = sourceMap;
     }
 
-    ArrayView<IRInst*> findSymbolByMangledName(const ImmutableHashedString& mangledName) const
+    ArrayView<IRInst*> findSymbolByMangledName(const IRMangledNameKey& mangledName) const
     {
         if (auto list = m_mapMangledNameToGlobalInst.tryGetValue(mangledName))
             return list->getArrayView();
         return {};
     }
 
+    /// Build the lookup tables used when linking against this module: the map from mangled
+    /// names to global insts, and the list of link root candidates.
+    ///
+    /// Must be called again after global insts are added, removed or redecorated.
     void buildMangledNameToGlobalInstMap();
 
+    /// Move every instruction of this module into a fresh memory arena and free the old one.
+    ///
+    /// Instructions are laid out in the order of a depth-first walk of the module, so that
+    /// a global value is followed by its blocks, and each block by its instructions. Memory
+    /// held by instructions that were removed from the module is released along the way.
+    ///
+    /// Every instruction moves, so `outOldToNew` is filled in with the new location of each
+    /// one, and the caller must update any `IRInst*` it holds. Cached analyses are dropped.
+    ///
+    /// Returns false and leaves the module as it was if it still has deferred bodies, or if
+    /// an instruction in it refers to one that is not.
+    bool compact(Dictionary<IRInst*, IRInst*>& outOldToNew);
+
+    /// Replace all uses of the key of each pair in `replacements` with its value.
+    ///
+    /// The result is the same as calling `replaceUsesWith` on each pair in order, but the
+    /// whole batch shares one pass over the affected uses: hoistable users that become
+    /// duplicates are merged, and sets whose elements changed are sorted again, once at the
+    /// end instead of after every replacement.
+    void replaceUsesWith(ArrayView<KeyValuePair<IRInst*, IRInst*>> replacements);
+
+    /// Global insts that the linker may copy into a program even when nothing it links
+    /// refers to them: exported symbols, global parameters and always-needed builtins.
+    ///
+    /// Linking checks each candidate against its own options. Without this list it would
+    /// have to scan every global inst of every module (including the core module) on
+    /// every link.
+    ArrayView<IRInst*> getLinkRootCandidates() const
+    {
+        return m_linkRootCandidates.getArrayView();
+    }
+
+    /// A module deserialized with `IRBodyLoading::OnDemand` only holds the decorations of
+    /// its global values with code until their bodies are first needed.
+    ///
+    /// Make sure the body of the global `inst` has been read in. Code that looks at more than
+    /// the decorations of a global value from such a module (as linking does) must call this
+    /// first. It is a no-op for modules with nothing deferred, and is safe to call from
+    /// multiple threads.
+    void ensureBodyLoaded(IRInst* inst)
+    {
+        if (m_deferredBodyLoader)
+            m_deferredBodyLoader->loadBody(inst);
+    }
+    /// Does the global `inst` have a body that hasn't been read in yet? This lets code that
+    /// only needs to know whether a function is defined avoid reading in its body.
+    bool hasDeferredBody(IRInst* inst)
+    {
+        return m_deferredBodyLoader && m_deferredBodyLoader->hasDeferredBody(inst);
+    }
+    /// Make sure all deferred bodies have been read in, see `ensureBodyLoaded`.
+    void ensureAllBodiesLoaded()
+    {
+        if (m_deferredBodyLoader)
+            m_deferredBodyLoader->loadAllBodies();
+    }
+    void setDeferredBodyLoader(IRDeferredBodyLoader* loader) { m_deferredBodyLoader = loader; }
+
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
     Dictionary<IRInst*, UInt>* getUniqueIdMap() { return &m_mapInstToUniqueId; }
@@ -2114,12 +2307,33 @@ public:
             return analysis->getDominatorTree();
         return nullptr;
     }
+    /// Get the dominator tree of `func`, computing it only if the control-flow graph of
+    /// `func` has changed since it was last computed.
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
     void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
     {
         m_mapInstToAnalysis.remove(func);
     }
-    void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
+    void invalidateAllAnalysis()
+    {
+        m_mapInstToAnalysis.clear();
+        m_staleAnalyses.clear();
+    }
+
+    /// Drop the analyses cached for `func` because its control-flow graph changed.
+    ///
+    /// This is called automatically whenever a block of `func` is inserted or removed, or
+    /// a terminator instruction of `func` is inserted, removed or pointed at another
+    /// block. A pass may still hold a result it got before the change, so dropped results
+    /// are kept alive until the next `invalidateAllAnalysis`.
+    void _noteCFGChanged(IRGlobalValueWithCode* func)
+    {
+        if (auto analysis = m_mapInstToAnalysis.tryGetValue(func))
+        {
+            m_staleAnalyses.add(*analysis);
+            m_mapInstToAnalysis.remove(func);
+        }
+    }
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
@@ -2190,6 +2404,7 @@ private:
     IRModule(Session* session)
         : m_session(session), m_memoryArena(kMemoryArenaBlockSize), m_deduplicationContext(this)
     {
+        m_memoryArena.setCategory(MemoryArenaCategory::IR);
     }
 
     // The compilation session in use.
@@ -2214,6 +2429,29 @@ private:
     /// are allocated.
     MemoryArena m_memoryArena;
 
+    /// Running counts of instructions created and destroyed, used for pass statistics.
+    UInt64 m_createdInstCount = 0;
+    UInt64 m_destroyedInstCount = 0;
+
+    /// State for `recycleRemovedInsts`. Recycled instructions of each operand count
+    /// are kept in a singly linked list threaded through their memory.
+    struct RecycledInst
+    {
+        RecycledInst* next;
+    };
+    static const Int kMaxRecycledInstOperandCount = 15;
+    bool m_recycleRemovedInsts = false;
+    List<IRInst*> m_removedInsts;
+    RecycledInst* m_recycledInsts[kMaxRecycledInstOperandCount + 1] = {};
+
+    /// State for `beginTrackingPossiblyDeadInsts`.
+    Index m_possiblyDeadInstTrackingDepth = 0;
+    List<IRInst*> m_possiblyDeadInsts;
+
+    /// State for `beginTrackingChangedGlobalInsts`.
+    Index m_changedGlobalInstTrackingDepth = 0;
+    List<IRInst*> m_changedGlobalInsts;
+
     /// A pool to allow reuse of common types of containers to reduce memory allocations
     /// and rehashing.
     ContainerPool m_containerPool;
@@ -2226,7 +2464,16 @@ private:
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
-    Dictionary<ImmutableHashedString, List<IRInst*>> m_mapMangledNameToGlobalInst;
+    /// Analyses dropped by `_noteCFGChanged`, see there.
+    List<IRAnalysis> m_staleAnalyses;
+
+    Dictionary<IRMangledNameKey, List<IRInst*>> m_mapMangledNameToGlobalInst;
+
+    /// See `getLinkRootCandidates`.
+    List<IRInst*> m_linkRootCandidates;
+
+    /// Reads in deferred bodies, if the module was deserialized with any.
+    RefPtr<IRDeferredBodyLoader> m_deferredBodyLoader;
 
     /// Hold a mapping for inst -> uniqueID. This mapping is generated on
     /// demand if passes need them, rather than eagerly storing them on
@@ -2288,6 +2535,19 @@ struct InstWorkList
     void setCount(Index count) { workList->setCount(count); }
 };
 
+/// Keeps `module` tracking changed global instructions while in scope.
+struct IRChangedGlobalInstTrackingScope
+{
+    IRChangedGlobalInstTrackingScope(IRModule* module)
+        : m_module(module)
+    {
+        m_module->beginTrackingChangedGlobalInsts();
+    }
+    ~IRChangedGlobalInstTrackingScope() { m_module->endTrackingChangedGlobalInsts(); }
+
+    IRModule* m_module;
+};
+
 struct InstHashSet
 {
     HashSet<IRInst*>* set = nullptr;
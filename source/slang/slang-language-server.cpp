@@ -2905,32 +2905,143 @@ SlangResult LanguageServer::runCommand(Command& call)
     return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
 }
 
+// Get the URI of the document a request is about, or an empty string if the command isn't
+// a request about a single document.
+static String _getRequestDocumentURI(Command& cmd)
+{
+    if (cmd.hoverArgs.isValid())
+        return cmd.hoverArgs.get().textDocument.uri;
+    if (cmd.definitionArgs.isValid())
+        return cmd.definitionArgs.get().textDocument.uri;
+    if (cmd.completionArgs.isValid())
+        return cmd.completionArgs.get().textDocument.uri;
+    if (cmd.signatureHelpArgs.isValid())
+        return cmd.signatureHelpArgs.get().textDocument.uri;
+    if (cmd.semanticTokenArgs.isValid())
+        return cmd.semanticTokenArgs.get().textDocument.uri;
+    if (cmd.documentSymbolArgs.isValid())
+        return cmd.documentSymbolArgs.get().textDocument.uri;
+    if (cmd.inlayHintArgs.isValid())
+        return cmd.inlayHintArgs.get().textDocument.uri;
+    if (cmd.formattingArgs.isValid())
+        return cmd.formattingArgs.get().textDocument.uri;
+    if (cmd.rangeFormattingArgs.isValid())
+        return cmd.rangeFormattingArgs.get().textDocument.uri;
+    if (cmd.onTypeFormattingArgs.isValid())
+        return cmd.onTypeFormattingArgs.get().textDocument.uri;
+    return String();
+}
+
+// Is `cmd` a request the user isn't waiting on as they type, and that can need the whole
+// document to be checked?
+static bool _isBackgroundRequest(Command& cmd)
+{
+    return cmd.method == SemanticTokensParams::methodName ||
+           cmd.method == InlayHintParams::methodName ||
+           cmd.method == DocumentSymbolParams::methodName;
+}
+
+void LanguageServer::readPendingMessages()
+{
+    while (true)
+    {
+        m_connection->tryReadMessage();
+        if (!m_connection->hasMessage())
+            break;
+        parseNextMessage();
+    }
+}
+
 void LanguageServer::processCommands()
 {
+    const int kErrorRequestCanceled = -32800;
+    const int kErrorContentModified = -32801;
+
+    // More commands can be added to `commands` while they are processed, so they are only
+    // ever accessed by index.
     HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    Index scannedCommandCount = 0;
+    auto scanNewCommands = [&]()
     {
-        if (cmd.method == "$/cancelRequest")
+        for (; scannedCommandCount < commands.getCount(); scannedCommandCount++)
         {
-            auto id = cmd.cancelArgs.get().id;
-            if (id > 0)
+            auto& cmd = commands[scannedCommandCount];
+            if (cmd.method == "$/cancelRequest")
             {
-                canceledIDs.add(id);
+                auto id = cmd.cancelArgs.get().id;
+                if (id > 0)
+                {
+                    canceledIDs.add(id);
+                }
             }
         }
-    }
-    const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
+    };
+
+    // A request is stale if its document is changed or closed by a later command, since the
+    // positions in it and in its result refer to the old text.
+    auto isStale = [&](Index commandIndex)
     {
+        auto uri = _getRequestDocumentURI(commands[commandIndex]);
+        if (uri.getLength() == 0)
+            return false;
+        for (Index i = commandIndex + 1; i < commands.getCount(); i++)
+        {
+            auto& laterCmd = commands[i];
+            if (laterCmd.changeDocArgs.isValid() &&
+                laterCmd.changeDocArgs.get().textDocument.uri == uri)
+                return true;
+            if (laterCmd.closeDocArgs.isValid() &&
+                laterCmd.closeDocArgs.get().textDocument.uri == uri)
+                return true;
+        }
+        return false;
+    };
+
+    auto processCommand = [&](Index commandIndex)
+    {
+        auto& cmd = commands[commandIndex];
         if (cmd.id.getKind() == JSONValue::Kind::Integer &&
             canceledIDs.contains(cmd.id.asInteger()))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
         }
+        else if (isStale(commandIndex))
+        {
+            m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, cmd.id);
+        }
         else
         {
             runCommand(cmd);
         }
+    };
+
+    Index processedCommandCount = 0;
+    while (processedCommandCount < commands.getCount())
+    {
+        // Document changes and interactive requests are handled in order. Background requests
+        // are left until the rest of the batch is done, so that a hover or completion isn't
+        // kept waiting behind them.
+        scanNewCommands();
+        List<Index> backgroundCommands;
+        const Index commandCount = commands.getCount();
+        for (Index i = processedCommandCount; i < commandCount; i++)
+        {
+            if (_isBackgroundRequest(commands[i]))
+                backgroundCommands.add(i);
+            else
+                processCommand(i);
+        }
+        processedCommandCount = commandCount;
+
+        // Before each background request, pick up the messages that arrived while the earlier
+        // ones ran, so it is dropped if it has been canceled or made stale in the meantime.
+        // The new commands themselves are processed in the next round.
+        for (auto i : backgroundCommands)
+        {
+            readPendingMessages();
+            scanNewCommands();
+            processCommand(i);
+        }
     }
 }
 
@@ -3117,13 +3228,7 @@ SlangResult LanguageServer::execute()
     {
         // Consume all messages first.
         commands.clear();
-        while (true)
-        {
-            m_connection->tryReadMessage();
-            if (!m_connection->hasMessage())
-                break;
-            parseNextMessage();
-        }
+        readPendingMessages();
 
         auto workStart = platform::PerformanceCounter::now();
 
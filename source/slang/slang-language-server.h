@@ -249,6 +249,7 @@ public:
 
 private:
     SlangResult parseNextMessage();
+    void readPendingMessages();
     void resetDiagnosticUpdateTime();
     void publishDiagnostics();
     void updatePredefinedMacros(const JSONValue& macros);
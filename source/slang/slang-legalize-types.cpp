@@ -100,10 +100,10 @@ LegalElementWrapping LegalElementWrapping::makeSimple(IRStructKey* key, IRType*
     return result;
 }
 
-RefPtr<SimpleLegalElementWrappingObj> LegalElementWrapping::getSimple() const
+SimpleLegalElementWrappingObj* LegalElementWrapping::getSimple() const
 {
     SLANG_ASSERT(flavor == Flavor::simple);
-    return obj.as<SimpleLegalElementWrappingObj>();
+    return static_cast<SimpleLegalElementWrappingObj*>(obj.Ptr());
 }
 
 LegalElementWrapping LegalElementWrapping::makeImplicitDeref(LegalElementWrapping const& field)
@@ -117,10 +117,10 @@ LegalElementWrapping LegalElementWrapping::makeImplicitDeref(LegalElementWrappin
     return result;
 }
 
-RefPtr<ImplicitDerefLegalElementWrappingObj> LegalElementWrapping::getImplicitDeref() const
+ImplicitDerefLegalElementWrappingObj* LegalElementWrapping::getImplicitDeref() const
 {
     SLANG_ASSERT(flavor == Flavor::implicitDeref);
-    return obj.as<ImplicitDerefLegalElementWrappingObj>();
+    return static_cast<ImplicitDerefLegalElementWrappingObj*>(obj.Ptr());
 }
 
 LegalElementWrapping LegalElementWrapping::makePair(
@@ -139,10 +139,10 @@ LegalElementWrapping LegalElementWrapping::makePair(
     return result;
 }
 
-RefPtr<PairLegalElementWrappingObj> LegalElementWrapping::getPair() const
+PairLegalElementWrappingObj* LegalElementWrapping::getPair() const
 {
     SLANG_ASSERT(flavor == Flavor::pair);
-    return obj.as<PairLegalElementWrappingObj>();
+    return static_cast<PairLegalElementWrappingObj*>(obj.Ptr());
 }
 
 LegalElementWrapping LegalElementWrapping::makeTuple(TupleLegalElementWrappingObj* obj)
@@ -153,10 +153,10 @@ LegalElementWrapping LegalElementWrapping::makeTuple(TupleLegalElementWrappingOb
     return result;
 }
 
-RefPtr<TupleLegalElementWrappingObj> LegalElementWrapping::getTuple() const
+TupleLegalElementWrappingObj* LegalElementWrapping::getTuple() const
 {
     SLANG_ASSERT(flavor == Flavor::tuple);
-    return obj.as<TupleLegalElementWrappingObj>();
+    return static_cast<TupleLegalElementWrappingObj*>(obj.Ptr());
 }
 
 //
@@ -71,6 +71,10 @@ struct LegalType
     typedef LegalFlavor Flavor;
 
     Flavor flavor = Flavor::none;
+
+    // The pseudo-type, for flavors that have one. The `get*()` accessors return it
+    // without adding a reference, so the result is only valid while this `LegalType`
+    // (or some other reference) keeps it alive.
     RefPtr<RefObject> obj;
     IRType* irType = nullptr;
 
@@ -90,19 +94,11 @@ struct LegalType
 
     static LegalType implicitDeref(LegalType const& valueType);
 
-    RefPtr<ImplicitDerefType> getImplicitDeref() const
-    {
-        SLANG_ASSERT(flavor == Flavor::implicitDeref);
-        return obj.as<ImplicitDerefType>();
-    }
+    ImplicitDerefType* getImplicitDeref() const;
 
     static LegalType tuple(RefPtr<TuplePseudoType> tupleType);
 
-    RefPtr<TuplePseudoType> getTuple() const
-    {
-        SLANG_ASSERT(flavor == Flavor::tuple);
-        return obj.as<TuplePseudoType>();
-    }
+    TuplePseudoType* getTuple() const;
 
     static LegalType pair(RefPtr<PairPseudoType> pairType);
 
@@ -111,19 +107,11 @@ struct LegalType
         LegalType const& specialType,
         RefPtr<PairInfo> pairInfo);
 
-    RefPtr<PairPseudoType> getPair() const
-    {
-        SLANG_ASSERT(flavor == Flavor::pair);
-        return obj.as<PairPseudoType>();
-    }
+    PairPseudoType* getPair() const;
 
     static LegalType makeWrappedBuffer(IRType* simpleType, LegalElementWrapping const& elementInfo);
 
-    RefPtr<WrappedBufferPseudoType> getWrappedBuffer() const
-    {
-        SLANG_ASSERT(flavor == Flavor::wrappedBuffer);
-        return obj.as<WrappedBufferPseudoType>();
-    }
+    WrappedBufferPseudoType* getWrappedBuffer() const;
 };
 
 struct LegalElementWrappingObj : RefObject
@@ -152,10 +140,10 @@ struct LegalElementWrapping
         PairInfo* pairInfo);
     static LegalElementWrapping makeTuple(TupleLegalElementWrappingObj* obj);
 
-    RefPtr<SimpleLegalElementWrappingObj> getSimple() const;
-    RefPtr<ImplicitDerefLegalElementWrappingObj> getImplicitDeref() const;
-    RefPtr<PairLegalElementWrappingObj> getPair() const;
-    RefPtr<TupleLegalElementWrappingObj> getTuple() const;
+    SimpleLegalElementWrappingObj* getSimple() const;
+    ImplicitDerefLegalElementWrappingObj* getImplicitDeref() const;
+    PairLegalElementWrappingObj* getPair() const;
+    TupleLegalElementWrappingObj* getTuple() const;
 };
 
 struct SimpleLegalElementWrappingObj : LegalElementWrappingObj
@@ -316,6 +304,33 @@ struct WrappedBufferPseudoType : LegalTypeImpl
     LegalElementWrapping elementInfo;
 };
 
+// The pseudo-types are only complete here, so the accessors of `LegalType`
+// that cast to them are defined here too.
+//
+inline ImplicitDerefType* LegalType::getImplicitDeref() const
+{
+    SLANG_ASSERT(flavor == Flavor::implicitDeref);
+    return static_cast<ImplicitDerefType*>(obj.Ptr());
+}
+
+inline TuplePseudoType* LegalType::getTuple() const
+{
+    SLANG_ASSERT(flavor == Flavor::tuple);
+    return static_cast<TuplePseudoType*>(obj.Ptr());
+}
+
+inline PairPseudoType* LegalType::getPair() const
+{
+    SLANG_ASSERT(flavor == Flavor::pair);
+    return static_cast<PairPseudoType*>(obj.Ptr());
+}
+
+inline WrappedBufferPseudoType* LegalType::getWrappedBuffer() const
+{
+    SLANG_ASSERT(flavor == Flavor::wrappedBuffer);
+    return static_cast<WrappedBufferPseudoType*>(obj.Ptr());
+}
+
 //
 
 IRTypeLayout* getDerefTypeLayout(IRTypeLayout* typeLayout);
@@ -456,6 +471,9 @@ struct LegalVal
     typedef LegalFlavor Flavor;
 
     Flavor flavor = Flavor::none;
+
+    // The pseudo-value, for flavors that have one. As with `LegalType::obj`, the
+    // `get*()` accessors return it without adding a reference.
     RefPtr<RefObject> obj;
     IRInst* irValue = nullptr;
 
@@ -475,11 +493,7 @@ struct LegalVal
 
     static LegalVal tuple(RefPtr<TuplePseudoVal> tupleVal);
 
-    RefPtr<TuplePseudoVal> getTuple() const
-    {
-        SLANG_ASSERT(flavor == Flavor::tuple);
-        return obj.as<TuplePseudoVal>();
-    }
+    TuplePseudoVal* getTuple() const;
 
     static LegalVal implicitDeref(LegalVal const& val);
     LegalVal getImplicitDeref() const;
@@ -490,19 +504,11 @@ struct LegalVal
         LegalVal const& specialVal,
         RefPtr<PairInfo> pairInfo);
 
-    RefPtr<PairPseudoVal> getPair() const
-    {
-        SLANG_ASSERT(flavor == Flavor::pair);
-        return obj.as<PairPseudoVal>();
-    }
+    PairPseudoVal* getPair() const;
 
     static LegalVal wrappedBuffer(LegalVal const& baseVal, LegalElementWrapping const& elementInfo);
 
-    RefPtr<WrappedBufferPseudoVal> getWrappedBuffer() const
-    {
-        SLANG_ASSERT(flavor == Flavor::wrappedBuffer);
-        return obj.as<WrappedBufferPseudoVal>();
-    }
+    WrappedBufferPseudoVal* getWrappedBuffer() const;
 };
 
 struct TuplePseudoVal : LegalValImpl
@@ -537,6 +543,24 @@ struct WrappedBufferPseudoVal : LegalValImpl
     LegalElementWrapping elementInfo;
 };
 
+inline TuplePseudoVal* LegalVal::getTuple() const
+{
+    SLANG_ASSERT(flavor == Flavor::tuple);
+    return static_cast<TuplePseudoVal*>(obj.Ptr());
+}
+
+inline PairPseudoVal* LegalVal::getPair() const
+{
+    SLANG_ASSERT(flavor == Flavor::pair);
+    return static_cast<PairPseudoVal*>(obj.Ptr());
+}
+
+inline WrappedBufferPseudoVal* LegalVal::getWrappedBuffer() const
+{
+    SLANG_ASSERT(flavor == Flavor::wrappedBuffer);
+    return static_cast<WrappedBufferPseudoVal*>(obj.Ptr());
+}
+
 //
 
 /// Information about a function that has been legalized
@@ -7,10 +7,16 @@
 #include "core/slang-char-util.h"
 #include "core/slang-memory-file-system.h"
 #include "slang-check-impl.h"
+#include "slang-code-gen.h"
 #include "slang-compiler.h"
+#include "slang-ir-link.h"
 #include "slang-lookup.h"
 #include "slang-mangle.h"
 #include "slang-rich-diagnostics.h"
+#include "slang-serialize-ir.h"
+#include "slang-serialize-types.h"
+
+#include <condition_variable>
 
 namespace Slang
 {
@@ -581,6 +587,300 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetHostCallable(
     return artifact->loadSharedLibrary(ArtifactKeep::Yes, outSharedLibrary);
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::compileEntryPointPermutations(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    slang::SpecializationArg const* specializationArgs,
+    SlangInt specializationArgCount,
+    SlangInt permutationCount,
+    slang::IBlob** outCodes,
+    slang::IBlob** outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    if (permutationCount < 0 || specializationArgCount < 0)
+        return SLANG_E_INVALID_ARG;
+    if (permutationCount > 0 && !outCodes)
+        return SLANG_E_INVALID_ARG;
+    if (permutationCount > 0 && specializationArgCount > 0 && !specializationArgs)
+        return SLANG_E_INVALID_ARG;
+
+    struct Permutation
+    {
+        ComPtr<slang::IComponentType> linked;
+        ComPtr<slang::IBlob> code;
+        StringBuilder diagnostics;
+        SlangResult result = SLANG_FAIL;
+    };
+    List<Permutation> permutations;
+    permutations.setCount(permutationCount);
+
+    auto appendDiagnostics = [](StringBuilder& builder, slang::IBlob* blob)
+    {
+        if (blob)
+            builder << UnownedStringSlice(
+                (const char*)blob->getBufferPointer(),
+                blob->getBufferSize());
+    };
+
+    // Specialization and linking are front-end operations that have to run one at a
+    // time, but they only build on the modules that are already loaded and checked,
+    // so they are cheap next to the code generation that follows.
+    //
+    {
+        std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
+        for (Index ii = 0; ii < permutationCount; ++ii)
+        {
+            auto& permutation = permutations[ii];
+
+            ComPtr<slang::IComponentType> specialized;
+            ComPtr<slang::IBlob> diagnostics;
+            permutation.result = specialize(
+                specializationArgs + ii * specializationArgCount,
+                specializationArgCount,
+                specialized.writeRef(),
+                diagnostics.writeRef());
+            appendDiagnostics(permutation.diagnostics, diagnostics);
+            if (SLANG_FAILED(permutation.result))
+                continue;
+
+            diagnostics.setNull();
+            permutation.result =
+                specialized->link(permutation.linked.writeRef(), diagnostics.writeRef());
+            appendDiagnostics(permutation.diagnostics, diagnostics);
+        }
+    }
+
+    // Each linked permutation is a program of its own, and code generation for
+    // different programs may run concurrently (see `getEntryPointCode`).
+    //
+    auto runPermutation = [&](Index permutationIndex)
+    {
+        auto& permutation = permutations[permutationIndex];
+        if (!permutation.linked)
+            return;
+
+        // Exceptions must not escape a worker thread.
+        ComPtr<slang::IBlob> diagnostics;
+        try
+        {
+            permutation.result = permutation.linked->getEntryPointCode(
+                entryPointIndex,
+                targetIndex,
+                permutation.code.writeRef(),
+                diagnostics.writeRef());
+        }
+        catch (...)
+        {
+            permutation.result = SLANG_FAIL;
+        }
+        appendDiagnostics(permutation.diagnostics, diagnostics);
+    };
+
+    // Without a thread count set on the session, use as many threads as the scheduler has.
+    auto& optionSet = linkage->m_optionSet;
+    const Count threadCount = optionSet.hasOption(CompilerOptionName::CodeGenThreadCount)
+                                  ? optionSet.getIntOption(CompilerOptionName::CodeGenThreadCount)
+                                  : 0;
+    runJobs(
+        linkage->getSessionImpl()->getCurrentJobScheduler(),
+        permutationCount,
+        threadCount,
+        runPermutation);
+
+    SlangResult result = SLANG_OK;
+    StringBuilder diagnostics;
+    for (Index ii = 0; ii < permutationCount; ++ii)
+    {
+        auto& permutation = permutations[ii];
+        diagnostics << permutation.diagnostics;
+        if (SLANG_FAILED(permutation.result))
+        {
+            result = permutation.result;
+            outCodes[ii] = nullptr;
+        }
+        else
+        {
+            outCodes[ii] = permutation.code.detach();
+        }
+    }
+
+    if (outDiagnostics && diagnostics.getLength())
+        *outDiagnostics = StringBlob::moveCreate(diagnostics).detach();
+
+    return result;
+}
+
+namespace
+{
+/// A code generation request run as a job on the job scheduler of the global session.
+class CodeGenFuture : public ComBaseObject, public slang::ICodeGenFuture
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    SLANG_NO_THROW SlangBool SLANG_MCALL isReady() SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_isReady;
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    getResult(slang::IBlob** outCode, slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_readyCondition.wait(lock, [&]() { return m_isReady; });
+        if (outCode)
+            *outCode = ComPtr<slang::IBlob>(m_code).detach();
+        if (outDiagnostics)
+            *outDiagnostics = ComPtr<slang::IBlob>(m_diagnostics).detach();
+        return m_result;
+    }
+
+    SLANG_NO_THROW void SLANG_MCALL cancel() SLANG_OVERRIDE { m_isCancelled = true; }
+
+    /// Generate code for the entry point at `entryPointIndex` of `program`, or for the
+    /// whole program if the index is negative.
+    CodeGenFuture(
+        ComponentType* program,
+        Int entryPointIndex,
+        Int targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData)
+        : m_program(program)
+        , m_entryPointIndex(entryPointIndex)
+        , m_targetIndex(targetIndex)
+        , m_callback(callback)
+        , m_userData(userData)
+    {
+    }
+
+    void start(ISlangJobScheduler* scheduler)
+    {
+        // The job holds a reference to the future until it has run.
+        addRef();
+        scheduler->submitJob(&_run, this);
+    }
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == slang::ICodeGenFuture::getTypeGuid())
+            return static_cast<slang::ICodeGenFuture*>(this);
+        return nullptr;
+    }
+
+    static void _run(void* userData, SlangInt)
+    {
+        auto future = (CodeGenFuture*)userData;
+
+        ComPtr<slang::IBlob> code;
+        ComPtr<slang::IBlob> diagnostics;
+        SlangResult result = SLANG_E_ABORT;
+        if (!future->m_isCancelled)
+        {
+            CodeGenCancellationScope cancellationScope(&future->m_isCancelled);
+
+            // Exceptions must not escape a worker thread.
+            try
+            {
+                if (future->m_entryPointIndex < 0)
+                {
+                    result = future->m_program->getTargetCode(
+                        future->m_targetIndex,
+                        code.writeRef(),
+                        diagnostics.writeRef());
+                }
+                else
+                {
+                    result = future->m_program->getEntryPointCode(
+                        future->m_entryPointIndex,
+                        future->m_targetIndex,
+                        code.writeRef(),
+                        diagnostics.writeRef());
+                }
+            }
+            catch (...)
+            {
+                result = SLANG_FAIL;
+            }
+
+            if (SLANG_FAILED(result) && future->m_isCancelled)
+                result = SLANG_E_ABORT;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(future->m_mutex);
+            future->m_result = result;
+            future->m_code = code;
+            future->m_diagnostics = diagnostics;
+            future->m_isReady = true;
+        }
+        future->m_readyCondition.notify_all();
+
+        if (future->m_callback)
+            future->m_callback(future, future->m_userData);
+
+        future->m_program = nullptr;
+        future->release();
+    }
+
+    ComPtr<slang::IComponentType> m_program;
+    Int m_entryPointIndex;
+    Int m_targetIndex;
+    CodeGenFutureCallback m_callback;
+    void* m_userData;
+
+    std::atomic<bool> m_isCancelled{false};
+
+    std::mutex m_mutex;
+    std::condition_variable m_readyCondition;
+    bool m_isReady = false;
+    SlangResult m_result = SLANG_E_PENDING;
+    ComPtr<slang::IBlob> m_code;
+    ComPtr<slang::IBlob> m_diagnostics;
+};
+} // namespace
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCodeAsync(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    CodeGenFutureCallback callback,
+    void* userData,
+    slang::ICodeGenFuture** outFuture)
+{
+    auto linkage = getLinkage();
+    if (!outFuture || entryPointIndex < 0)
+        return SLANG_E_INVALID_ARG;
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    ComPtr<CodeGenFuture> future(
+        new CodeGenFuture(this, entryPointIndex, targetIndex, callback, userData));
+    future->start(linkage->getSessionImpl()->getCurrentJobScheduler());
+    *outFuture = future.detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetCodeAsync(
+    SlangInt targetIndex,
+    CodeGenFutureCallback callback,
+    void* userData,
+    slang::ICodeGenFuture** outFuture)
+{
+    auto linkage = getLinkage();
+    if (!outFuture)
+        return SLANG_E_INVALID_ARG;
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    ComPtr<CodeGenFuture> future(new CodeGenFuture(this, -1, targetIndex, callback, userData));
+    future->start(linkage->getSessionImpl()->getCurrentJobScheduler());
+    *outFuture = future.detach();
+    return SLANG_OK;
+}
+
 /// Visitor used by `ComponentType::enumerateModules`
 struct EnumerateModulesVisitor : ComponentTypeVisitor
 {
@@ -808,9 +1108,75 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetIRHash(
+    SlangInt targetIndex,
+    slang::IBlob** outHash,
+    slang::IBlob** outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if (!outHash)
+        return SLANG_E_INVALID_ARG;
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    auto target = linkage->targets[targetIndex];
+    auto targetProgram = getTargetProgram(target);
+
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
+    applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+
+    try
+    {
+        if (!targetProgram->getOrCreateIRModuleForLayout(&sink))
+        {
+            sink.getBlobIfNeeded(outDiagnostics);
+            return SLANG_FAIL;
+        }
+
+        List<Index> entryPointIndices;
+        entryPointIndices.setCount(getEntryPointCount());
+        for (Index i = 0; i < entryPointIndices.getCount(); i++)
+            entryPointIndices[i] = i;
+
+        ComPtr<ISlangBlob> serializedIR;
+        SlangResult result =
+            targetProgram->serializeLinkedIR(entryPointIndices, &sink, serializedIR.writeRef());
+        sink.getBlobIfNeeded(outDiagnostics);
+        SLANG_RETURN_ON_FAIL(result);
+
+        // Search paths and macros only affect the code through the IR they produce, so they
+        // are left out to keep the digest the same across machines.
+        CompilerOptionSet optionSet;
+        optionSet.overrideWith(targetProgram->getOptionSet());
+        optionSet.remove(CompilerOptionName::Include);
+        optionSet.remove(CompilerOptionName::MacroDefine);
+
+        DigestBuilder<SHA1> builder;
+        builder.append(String(getBuildTagString()));
+        optionSet.buildHash(builder);
+        builder.append(serializedIR);
+        const auto digest = builder.finalize();
+
+        *outHash = RawBlob::create(digest.data, 16).detach();
+        return SLANG_OK;
+    }
+    catch (const Exception& e)
+    {
+        sink.diagnose(Diagnostics::CompilationAbortedDueToException{
+            .exceptionType = typeid(e).name(),
+            .exceptionMessage = e.Message});
+        sink.getBlobIfNeeded(outDiagnostics);
+        return SLANG_FAIL;
+    }
+}
+
 Expr* ComponentType::parseExprFromString(String exprStr, DiagnosticSink* sink)
 {
     auto linkage = getLinkage();
+    // Parsing and checking a string mutates the linkage's AST, so serialize it with other
+    // front-end operations.
+    std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(linkage->getASTBuilder());
     auto astBuilder = linkage->getASTBuilder();
     Scope* scope = _getOrCreateScopeForLegacyLookup(astBuilder);
@@ -839,6 +1205,7 @@ Type* ComponentType::getTypeFromString(String const& typeStr, DiagnosticSink* si
 
     auto linkage = getLinkage();
 
+    std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(linkage->getASTBuilder());
 
     Expr* typeExpr = linkage->parseTermString(typeStr, scope);
@@ -959,6 +1326,7 @@ Expr* ComponentType::findDeclFromString(String const& name, DiagnosticSink* sink
 
     auto linkage = getLinkage();
 
+    std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(linkage->getASTBuilder());
 
     Expr* expr = linkage->parseTermString(name, scope);
@@ -1018,6 +1386,7 @@ Expr* ComponentType::findDeclFromStringInType(
 
     auto linkage = getLinkage();
 
+    std::lock_guard<std::recursive_mutex> lock(linkage->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(linkage->getASTBuilder());
 
     Expr* expr = nullptr;
@@ -1183,6 +1552,7 @@ Dictionary<String, IntVal*>& ComponentType::getMangledNameToIntValMap()
 ConstantIntVal* ComponentType::tryFoldIntVal(IntVal* intVal)
 {
     auto astBuilder = getLinkage()->getASTBuilder();
+    std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(astBuilder);
     return as<ConstantIntVal>(intVal->linkTimeResolve(getMangledNameToIntValMap()));
 }
@@ -189,6 +189,29 @@ public:
         int targetIndex,
         ISlangSharedLibrary** outSharedLibrary,
         slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        slang::SpecializationArg const* specializationArgs,
+        SlangInt specializationArgCount,
+        SlangInt permutationCount,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetIRHash(
+        SlangInt targetIndex,
+        slang::IBlob** outHash,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
 
     //
     // slang::IModulePrecompileService interface
@@ -195,6 +195,13 @@ static void _lookUpDirectAndTransparentMembers(
     LookupResult& result,
     BreadcrumbInfo* inBreadcrumbs)
 {
+    if (auto searchedContainers = request.outSearchedContainers)
+    {
+        searchedContainers->add(KeyValuePair<ContainerDecl*, UInt>(
+            containerDecl,
+            containerDecl->getDirectMemberDeclsModificationCount()));
+    }
+
     if (request.isCompletionRequest())
     {
         // If we are looking up for completion suggestions,
@@ -1092,7 +1099,37 @@ LookupResult lookUpMember(
 {
     LookupResult result;
     LookupRequest request = initLookupRequest(semantics, name, mask, options, sourceScope, nullptr);
+
+    // Member lookup walks every facet of `type` and searches the members of each, which is
+    // repeated for every member access expression on the type, so the results are cached
+    // on the shared semantics context. Lookup in a type doesn't depend on the source scope,
+    // only on the facets of the type and the members they have.
+    //
+    auto shared = semantics ? semantics->getShared() : nullptr;
+    if (!shared || !type || request.isCompletionRequest())
+    {
+        _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+        return result;
+    }
+
+    MemberLookupKey key;
+    key.type = type;
+    key.name = name;
+    key.mask = mask;
+    key.options = request.options;
+    if (shared->tryGetMemberLookupFromCache(key, result))
+        return result;
+
+    List<KeyValuePair<ContainerDecl*, UInt>> searchedContainers;
+    request.outSearchedContainers = &searchedContainers;
+    const UInt incompleteInfoCount = shared->getIncompleteInheritanceInfoCount();
+
     _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+
+    // A lookup that used the incomplete inheritance info of a type that is still having its
+    // inheritance computed could be missing members, so it isn't cached.
+    if (incompleteInfoCount == shared->getIncompleteInheritanceInfoCount())
+        shared->cacheMemberLookup(key, result, searchedContainers);
     return result;
 }
 
@@ -6,6 +6,7 @@
 #include "../core/slang-hash.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-random-generator.h"
+#include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 #include "slang-check.h"
 #include "slang-ir-autodiff.h"
@@ -32,6 +33,7 @@
 #include "slang-ir-peephole.h"
 #include "slang-ir-sccp.h"
 #include "slang-ir-simplify-cfg.h"
+#include "slang-ir-ssa-simplification.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-string-hash.h"
 #include "slang-ir-strip.h"
@@ -48,6 +50,8 @@
 // Natural layout
 #include "slang-ast-natural-layout.h"
 
+#include <optional>
+
 namespace Slang
 {
 
@@ -538,6 +542,15 @@ struct SharedIRGenContext
     ModuleDecl* m_mainModuleDecl = nullptr;
     Linkage* m_linkage = nullptr;
 
+    // When only the global functions that are reachable from the entry points
+    // have been checked, this is used to check the bodies of any other functions
+    // that lowering turns out to need.
+    SemanticsVisitor* m_reachableFunctionChecker = nullptr;
+
+    // Should global functions that are not exported only be lowered
+    // once something that is lowered refers to them?
+    bool m_lowerReachableFunctionsOnly = false;
+
     // List of all string literals used in user code, regardless
     // of how they were used (i.e., whether or not they were hashed).
     //
@@ -12983,7 +12996,8 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
             auto irModule = importedModule->getIRModule();
             SLANG_ASSERT(irModule && "Module containing imported decl does not have an IRModule.");
             String mangledName = getMangledName(context->astBuilder, decl);
-            auto importedFunc = irModule->findSymbolByMangledName(mangledName);
+            auto importedFunc =
+                irModule->findSymbolByMangledName(IRMangledNameKey(mangledName.getUnownedSlice()));
             SLANG_ASSERT(importedFunc.getCount() > 0);
             subContext->shared->externalSymbolsToPrelink.add(importedFunc[0]);
         }
@@ -13871,6 +13885,47 @@ LoweredValInfo* _findLoweredValInfo(IRGenContext* context, Decl* decl)
     return nullptr;
 }
 
+// Is `decl` a function whose body was left unchecked because nothing
+// reachable from the entry points refers to it (at least not yet)?
+static bool _isUncheckedReachableFunction(IRGenContext* context, Decl* decl)
+{
+    if (!context->shared->m_reachableFunctionChecker)
+        return false;
+    auto funcDecl = getGlobalFunctionWithBody(decl);
+    return funcDecl && !funcDecl->isChecked(DeclCheckState::CapabilityChecked);
+}
+
+// Must `funcDecl` be lowered even if nothing else that is lowered refers to it?
+static bool _isExportedFunction(FunctionDeclBase* funcDecl)
+{
+    for (auto modifier : funcDecl->modifiers)
+    {
+        if (as<EntryPointAttribute>(modifier) || as<HLSLExportModifier>(modifier) ||
+            as<DllExportAttribute>(modifier) || as<CudaDeviceExportAttribute>(modifier) ||
+            as<CudaHostAttribute>(modifier) || as<CudaKernelAttribute>(modifier) ||
+            as<ExternCppModifier>(modifier) || as<ExternAttribute>(modifier) ||
+            as<ExternModifier>(modifier))
+            return true;
+
+        // Derivative and substitute functions decorate the function they are
+        // for, which does not refer back to them.
+        if (as<DerivativeOfAttribute>(modifier) || as<PrimalSubstituteOfAttribute>(modifier))
+            return true;
+    }
+    return false;
+}
+
+// Can lowering `decl` wait until something else that is lowered refers to it?
+static bool _isLoweredOnlyIfReferenced(IRGenContext* context, Decl* decl)
+{
+    if (_isUncheckedReachableFunction(context, decl))
+        return true;
+    if (!context->shared->m_lowerReachableFunctionsOnly)
+        return false;
+    auto funcDecl = getGlobalFunctionWithBody(decl);
+    return funcDecl && !_isExportedFunction(funcDecl);
+}
+
 // Ensure that a version of the given declaration has been emitted to the IR
 LoweredValInfo ensureDecl(IRGenContext* context, Decl* decl)
 {
@@ -13879,6 +13934,21 @@ LoweredValInfo ensureDecl(IRGenContext* context, Decl* decl)
         return *valInfoPtr;
     }
 
+    // A function that was not reachable through calls from the entry points
+    // may still be referenced in other ways, so we check its body on demand.
+    // Its body must not be lowered if checking it found errors.
+    //
+    if (_isUncheckedReachableFunction(context, decl))
+    {
+        auto sink = context->getSink();
+        auto errorCount = sink->getErrorCount();
+        context->shared->m_reachableFunctionChecker->ensureDecl(
+            getGlobalFunctionWithBody(decl),
+            DeclCheckState::CapabilityChecked);
+        if (sink->getErrorCount() != errorCount)
+            SLANG_ABORT_COMPILATION("errors in the body of a referenced function");
+    }
+
     // If we have a decl that's a generic value/type decl then something has gone seriously
     // wrong
     if (isGenericParam(decl))
@@ -14345,6 +14415,11 @@ static void lowerProgramEntryPointToIR(
 /// Ensure that `decl` and all relevant declarations under it get emitted.
 static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
 {
+    // Functions that nothing refers to don't get emitted when only the
+    // functions reachable from the entry points are checked or lowered.
+    if (_isLoweredOnlyIfReferenced(context, decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -14365,16 +14440,18 @@ static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
     }
     else if (auto namespaceDecl = as<NamespaceDecl>(decl))
     {
-        for (auto memberDecl : namespaceDecl->getDirectMemberDecls())
+        // Checking a function body on demand may add members, so we access
+        // them by index rather than with an iterator.
+        for (Index i = 0; i < namespaceDecl->getDirectMemberDeclCount(); ++i)
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, namespaceDecl->getDirectMemberDecl(i));
         }
     }
     else if (auto fileDecl = as<FileDecl>(decl))
     {
-        for (auto memberDecl : fileDecl->getDirectMemberDecls())
+        for (Index i = 0; i < fileDecl->getDirectMemberDeclCount(); ++i)
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, fileDecl->getDirectMemberDecl(i));
         }
     }
     else if (auto genericDecl = as<GenericDecl>(decl))
@@ -14392,6 +14469,10 @@ RefPtr<IRModule> generateIRForTranslationUnit(
 
     auto session = translationUnit->getSession();
     auto compileRequest = translationUnit->compileRequest;
+    SLANG_PROFILE_PHASE(
+        compileRequest->optionSet.shouldProfilePhases(),
+        "lower",
+        getText(translationUnit->moduleName));
     Linkage* linkage = compileRequest->getLinkage();
 
     SharedIRGenContext sharedContextStorage(
@@ -14405,6 +14486,28 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     IRGenContext contextStorage(sharedContext, astBuilder);
     IRGenContext* context = &contextStorage;
 
+    // Only a compile that checked just the functions reachable from the entry points
+    // may need to check more of them while lowering.
+    std::optional<SharedSemanticsContext> semanticsContext;
+    std::optional<SemanticsVisitor> reachableFunctionChecker;
+    if (compileRequest->m_checkReachableFunctionsOnly)
+    {
+        semanticsContext.emplace(
+            linkage,
+            translationUnit->getModule(),
+            compileRequest->getSink(),
+            nullptr,
+            translationUnit);
+        reachableFunctionChecker.emplace(&*semanticsContext);
+        sharedContext->m_reachableFunctionChecker = &*reachableFunctionChecker;
+    }
+
+    // A module that is built as a library, without entry points, has
+    // all of its functions lowered.
+    sharedContext->m_lowerReachableFunctionsOnly =
+        compileRequest->m_lowerReachableFunctionsOnly &&
+        translationUnit->getModule()->getEntryPoints().getCount() != 0;
+
     RefPtr<IRModule> module = IRModule::create(session);
 
     module->setName(translationUnit->getModuleDecl()->getName());
@@ -14468,9 +14571,10 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     //
     // Next, ensure that all other global declarations have
     // been emitted.
-    for (auto decl : translationUnit->getModuleDecl()->getDirectMemberDecls())
+    auto moduleDecl = translationUnit->getModuleDecl();
+    for (Index i = 0; i < moduleDecl->getDirectMemberDeclCount(); ++i)
     {
-        ensureAllDeclsRec(context, decl);
+        ensureAllDeclsRec(context, moduleDecl->getDirectMemberDecl(i));
     }
 
     // Build a global instruction to hold all the string
@@ -14749,6 +14853,16 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     // from other modules potentially makes the IR we generate
     // "fragile" in that we'd now need to recompile when
     // a module we depend on changes.
+    //
+    // What we can do is take the simplifications above to a fixed
+    // point, since they only look at the code of this module. A
+    // precompiled module then holds simplified functions, and every
+    // program it is linked into doesn't have to simplify them again.
+    if (!minimumOptimizations &&
+        linkage->m_optionSet.getBoolOption(CompilerOptionName::OptimizeModuleIR))
+    {
+        simplifyIRBeforeLinking(module, compileRequest->getSink());
+    }
 
     validateIRModuleIfEnabled(compileRequest, module);
 
@@ -14979,6 +15093,16 @@ RefPtr<IRModule> generateIRForTypeConformance(
 
 RefPtr<IRModule> TargetProgram::getOrCreateIRModuleForLayout(DiagnosticSink* sink)
 {
+    // Everything that needs IR comes through here, so this is where a reflection-only
+    // linkage refuses to go past layout.
+    if (m_program->getLinkage()->isReflectionOnly())
+    {
+        sink->diagnose(Diagnostics::CodeRequestedInReflectionOnlyMode{
+            .target = TypeTextUtil::getCompileTargetName(
+                SlangCompileTarget(m_targetReq->getTarget()))});
+        return nullptr;
+    }
+
     getOrCreateLayout(sink);
     return m_irModuleForLayout;
 }
@@ -970,18 +970,40 @@ static String getMangledName(ASTBuilder* astBuilder, DeclRef<Decl> const& declRe
     return context.sb.produceString();
 }
 
+// Can the mangled name of `declRef` be remembered in the cache of `astBuilder`?
+//
+// The name must not change once it is cached, so the decl must be fully checked. The
+// `DeclRef` must also be one that `astBuilder` itself de-duplicates, since a `DeclRef`
+// owned by a descendent builder could be freed while `astBuilder` is still alive.
+//
+static bool _canCacheMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef)
+{
+    auto decl = declRef->getDecl();
+    if (!decl || !decl->isChecked(DeclCheckState::DefinitionChecked))
+        return false;
+
+    auto found = astBuilder->m_cachedNodes.tryGetValue(ValKey(declRef));
+    return found && *found == declRef;
+}
+
 String getMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
 
-    return getMangledName(astBuilder, DeclRef<Decl>(declRef));
+    if (auto cached = astBuilder->m_mangledNameCache.tryGetValue(declRef))
+        return *cached;
+
+    String mangledName = getMangledName(astBuilder, DeclRef<Decl>(declRef));
+    if (_canCacheMangledName(astBuilder, declRef))
+        astBuilder->m_mangledNameCache.add(declRef, mangledName);
+    return mangledName;
 }
 
 String getMangledName(ASTBuilder* astBuilder, Decl* decl)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
 
-    return getMangledName(astBuilder, makeDeclRef(decl));
+    return getMangledName(astBuilder, makeDeclRef(decl).declRefBase);
 }
 
 String getMangledNameForConformanceWitness(
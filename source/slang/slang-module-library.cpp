@@ -81,11 +81,12 @@ SlangResult loadModuleLibrary(
         library->m_modules.add(loadedModule);
     }
 
+    ContainerStringTable strings(container);
     for (auto entryPointChunk : container->getEntryPoints())
     {
         FrontEndCompileRequest::ExtraEntryPointInfo entryPointInfo;
-        entryPointInfo.mangledName = entryPointChunk->getMangledName();
-        entryPointInfo.name = namePool->getName(entryPointChunk->getName());
+        entryPointInfo.mangledName = entryPointChunk->getMangledName(&strings);
+        entryPointInfo.name = namePool->getName(entryPointChunk->getName(&strings));
         entryPointInfo.profile = entryPointChunk->getProfile();
 
         library->m_entryPoints.add(entryPointInfo);
@@ -106,6 +106,10 @@ RefPtr<EntryPoint> Module::findAndCheckEntryPoint(
     SlangStage stage,
     ISlangBlob** outDiagnostics)
 {
+    // Checking a function as an entry point mutates the linkage's AST, so serialize it with
+    // other front-end operations.
+    std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
+
     // If there is already an entrypoint marked with the [shader] attribute,
     // we should just return that.
     //
@@ -275,6 +279,7 @@ UnownedStringSlice Module::getExportedDeclMangledName(Index index)
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
+    std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(m_astBuilder);
 
     SerialContainerUtil::WriteOptions writeOptions;
@@ -289,6 +294,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
+    std::lock_guard<std::recursive_mutex> lock(getLinkage()->getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(m_astBuilder);
 
     SerialContainerUtil::WriteOptions writeOptions;
@@ -11,6 +11,8 @@
 #include "slang-entry-point.h"
 #include "slang-linkable.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -126,6 +128,57 @@ public:
         return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        slang::SpecializationArg const* specializationArgs,
+        SlangInt specializationArgCount,
+        SlangInt permutationCount,
+        slang::IBlob** outCodes,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::compileEntryPointPermutations(
+            entryPointIndex,
+            targetIndex,
+            specializationArgs,
+            specializationArgCount,
+            permutationCount,
+            outCodes,
+            outDiagnostics);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE
+    {
+        return Super::getEntryPointCodeAsync(
+            entryPointIndex,
+            targetIndex,
+            callback,
+            userData,
+            outFuture);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        CodeGenFutureCallback callback,
+        void* userData,
+        slang::ICodeGenFuture** outFuture) SLANG_OVERRIDE
+    {
+        return Super::getTargetCodeAsync(targetIndex, callback, userData, outFuture);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetIRHash(
+        SlangInt targetIndex,
+        slang::IBlob** outHash,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+    {
+        return Super::getTargetIRHash(targetIndex, outHash, outDiagnostics);
+    }
+
     SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointHostCallable(
         int entryPointIndex,
         int targetIndex,
@@ -286,6 +339,13 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics) override;
 
+    /// Precompile the module for `targetReq`, using the options set on it, reporting to `sink`.
+    /// If `includeEntryPoints` is false only the module's library functions are precompiled.
+    SlangResult precompileForTargetRequest(
+        TargetRequest* targetReq,
+        DiagnosticSink* sink,
+        bool includeEntryPoints);
+
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPrecompiledTargetCode(
         SlangCompileTarget target,
         slang::IBlob** outCode,
@@ -518,6 +578,9 @@ private:
     // Source files that have been pulled into the module with `__include`.
     Dictionary<SourceFile*, FileDecl*> m_mapSourceFileToFileDecl;
 
+    // Serializes precompiling, which modifies the IR of the module.
+    std::mutex m_precompileMutex;
+
 public:
     SLANG_NO_THROW SlangResult SLANG_MCALL disassemble(slang::IBlob** outDisassembledBlob) override
     {
@@ -390,7 +390,9 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::DepFile,
          "-depfile",
          "-depfile <path>",
-         "Save the source file dependency list in a file."},
+         "Save the source file dependency list in a file.\n"
+         "If <path> ends in .json, the file is written as JSON, and also records a digest of "
+         "each dependency's content, each imported module and the options used."},
         {OptionKind::EntryPointName,
          "-entry",
          "-entry <name>",
@@ -444,6 +446,134 @@ void initCommandOptions(CommandOptions& options)
          "-minimum-slang-optimization",
          nullptr,
          "Perform minimum code optimization in Slang to favor compilation time."},
+        {OptionKind::CheckReachableFunctionsOnly,
+         "-check-reachable-functions-only",
+         nullptr,
+         "Only check and generate code for the bodies of global functions that are reachable "
+         "from the entry points being compiled. Errors in the bodies of other functions are not "
+         "reported."},
+        {OptionKind::LowerReachableFunctionsOnly,
+         "-lower-reachable-functions-only",
+         nullptr,
+         "When compiling entry points, only generate IR for the global functions that are "
+         "referenced from them, or that are exported from the module."},
+        {OptionKind::OptimizeModuleIR,
+         "-optimize-module-ir",
+         nullptr,
+         "Simplify the IR of each module to a fixed point when it is generated, using only the "
+         "optimizations that don't depend on the target or on other modules. A module "
+         "precompiled with this option stores simplified IR, so the programs it is linked into "
+         "spend less time optimizing its functions."},
+        {OptionKind::HeuristicInlining,
+         "-heuristic-inlining",
+         nullptr,
+         "Inline calls to small functions when generating SPIR-V, GLSL, Metal or WGSL, whose "
+         "drivers don't reliably inline on their own. Calls with constant arguments and callees "
+         "with resource parameters get a larger size limit, functions called once are inlined "
+         "up to a larger size still, and no function grows by more than a per-target budget. "
+         "Functions marked [noinline] are never inlined."},
+        {OptionKind::SplitGroupSharedStructArrays,
+         "-split-groupshared-struct-arrays",
+         nullptr,
+         "Split each groupshared array of structs whose elements are only accessed one field at "
+         "a time into one groupshared array per field, so that threads accessing the same field "
+         "of neighboring elements don't contend for the same shared memory banks."},
+        {OptionKind::NarrowHalfArithmetic,
+         "-narrow-half-arithmetic",
+         nullptr,
+         "Perform float additions, subtractions, multiplications, divisions and negations at half "
+         "precision when their inputs are half values or constants and their results are only "
+         "converted back to half. This rounds intermediate results to half, so the results can "
+         "differ from the unmodified program within the precision of half."},
+        {OptionKind::RemoveUndefinedMeshOutputs,
+         "-remove-undefined-mesh-outputs",
+         nullptr,
+         "Remove the writes of undefined values, such as fields of a vertex struct that were "
+         "never set, to the outputs of mesh shaders, and remove the output attributes that are "
+         "left without any writes. A later stage that reads a removed attribute no longer has a "
+         "matching output."},
+        {OptionKind::RemoveUnreadVaryingOutputs,
+         "-remove-unread-varying-outputs",
+         nullptr,
+         "When a program contains both vertex or mesh entry points and fragment entry points, "
+         "remove the outputs of the vertex and mesh entry points at locations that no fragment "
+         "entry point reads. A fragment shader compiled separately can no longer read the "
+         "removed outputs."},
+        {OptionKind::WaterfallNonUniformResourceIndex,
+         "-waterfall-non-uniform-resource-index",
+         nullptr,
+         "On HLSL and DXIL targets for Shader Model 6.0 and later, access resources selected with "
+         "NonUniformResourceIndex in a loop that uses WaveReadLaneFirst to handle one index at a "
+         "time, so that each access uses a uniform index. Other targets, and modules with a "
+         "fragment entry point, are left unchanged."},
+        {OptionKind::UniformityHints,
+         "-uniformity-hints",
+         nullptr,
+         "Remove NonUniformResourceIndex from resource indices that are provably the same in "
+         "every invocation, and mark branches on such values with [branch], so that the "
+         "downstream compiler neither scalarizes the resource access nor flattens the branch."},
+        {OptionKind::InterproceduralConstantPropagation,
+         "-interprocedural-constant-propagation",
+         nullptr,
+         "Clone functions that are called with constant arguments, substituting the constants "
+         "for the parameters, so that the branches those arguments decide can be folded. Each "
+         "function gets a limited number of clones, and the module a limited number of cloned "
+         "instructions."},
+        {OptionKind::ScheduleForRegisterPressure,
+         "-schedule-for-register-pressure",
+         nullptr,
+         "Reorder the instructions within each block to shorten the live ranges of the values "
+         "they compute, moving instructions closer to their uses, before the code is emitted."},
+        {OptionKind::ScalarReplacementOfAggregates,
+         "-scalar-replacement-of-aggregates",
+         nullptr,
+         "Split local variables of struct and small fixed-size array type that are only accessed "
+         "one field or constant-index element at a time into one variable per field or element, "
+         "late in code generation, so that each of them can become a separate SSA value."},
+        {OptionKind::GlobalValueNumbering,
+         "-global-value-numbering",
+         nullptr,
+         "When emitting SPIR-V directly, compute values and loads that are repeated on both "
+         "sides of a branch once before the branch, and replace loads with the value of an "
+         "earlier load or store of the same address when nothing in between can write to it."},
+        {OptionKind::CoalesceByteAddressAccesses,
+         "-coalesce-byte-address-accesses",
+         nullptr,
+         "When generating HLSL, merge adjacent scalar loads from and stores to a byte-address "
+         "buffer into one vector load or store."},
+        {OptionKind::RecycleRemovedIR,
+         "-recycle-removed-ir",
+         nullptr,
+         "Reuse the memory of IR instructions removed by a pass of code generation for the "
+         "instructions created by later passes, so that the memory used while generating code "
+         "follows the size of the live IR rather than the total amount of IR created."},
+        {OptionKind::CompactIR,
+         "-compact-ir",
+         nullptr,
+         "Move the IR of the program being compiled into freshly allocated memory after "
+         "specialization and after legalization, releasing the memory held by removed "
+         "instructions and laying out the rest in traversal order."},
+        {OptionKind::LoopUnrollBudget,
+         "-loop-unroll-budget",
+         "-loop-unroll-budget <count>",
+         "Stop unrolling a [ForceUnroll] loop before it adds more than <count> instructions, and "
+         "leave the remaining iterations in a loop for the downstream compiler, with a warning. "
+         "The default of 0 unrolls such loops without a limit."},
+        {OptionKind::CompileTimeBudget,
+         "-compile-time-budget",
+         "-compile-time-budget <milliseconds>",
+         "Once optimizing the IR for a target has taken, or is predicted from the time its passes "
+         "took so far to take, more than <milliseconds>, fall back to cheaper settings for the "
+         "repeated simplification passes and skip heuristic inlining, with a note listing the "
+         "optimizations that were reduced. Such results are not stored in the shader cache. The "
+         "default of 0 sets no limit."},
+        {OptionKind::AutodiffCheckpointBudget,
+         "-autodiff-checkpoint-budget",
+         "-autodiff-checkpoint-budget <bytes>",
+         "When the primal values a backward derivative checkpoints add up to more than <bytes> "
+         "bytes per thread, recompute those that can be recomputed without side effects instead, "
+         "starting with the ones that save the most memory for the least work. Warns if the "
+         "function is still over budget. The default of 0 sets no limit."},
         {OptionKind::DisableNonEssentialValidations,
          "-disable-non-essential-validations",
          nullptr,
@@ -528,12 +658,27 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::ReportPerfBenchmark,
          "-report-perf-benchmark",
          nullptr,
-         "Reports compiler performance benchmark results."},
+         "Reports compiler performance benchmark results, including the time spent in each "
+         "phase of compilation (preprocess, parse, check, lower, link, optimize, emit and "
+         "downstream) for each module."},
         {OptionKind::ReportDetailedPerfBenchmark,
          "-report-detailed-perf-benchmark",
          nullptr,
          "Reports compiler performance benchmark results for each intermediate pass (implies "
          "-report-perf-benchmark)."},
+        {OptionKind::ReportPassStatistics,
+         "-report-pass-stats",
+         "-report-pass-stats <path>",
+         "Write the number of invocations, wall time, instructions created and destroyed, and "
+         "IR memory growth of each IR pass, added up over its invocations, to <path> as JSON. "
+         "Use '-' for stdout."},
+        {OptionKind::TraceEvents,
+         "-trace-events",
+         "-trace-events <path>",
+         "Write the timeline of the compile to <path> in the Chrome trace event format, for "
+         "viewing in chrome://tracing or Perfetto. Profiled functions, compiler phases, IR passes "
+         "and module loads are recorded as nested spans on the threads that ran them. Use '-' "
+         "for stdout."},
         {OptionKind::ReportCheckpointIntermediates,
          "-report-checkpoint-intermediates",
          nullptr,
@@ -553,10 +698,49 @@ void initCommandOptions(CommandOptions& options)
          "Useful when the host needs the binding fixed at compile time "
          "(e.g. for a pre-built D3D12 root signature). Implies "
          "`-trace-coverage`."},
+        {OptionKind::TraceCoverageMode,
+         "-trace-coverage-mode",
+         "-trace-coverage-mode <count|hit>",
+         "Choose how coverage counters record executions. `count` (the default) atomically adds "
+         "every execution of a statement to its counter. `hit` stores 1 to the counter with a "
+         "plain write instead, recording only whether the statement ran, which avoids the cost "
+         "of an atomic per statement per thread. Implies `-trace-coverage`."},
         {OptionKind::ReportDynamicDispatchSites,
          "-report-dynamic-dispatch-sites",
          nullptr,
          "Reports information about dynamic dispatch sites for interface calls."},
+        {OptionKind::ReportRayPayloadRegisters,
+         "-report-ray-payload-registers",
+         nullptr,
+         "Reports the ray payload fields that each closest-hit, any-hit and miss shader accesses, "
+         "and the number of 32-bit payload registers its payload takes."},
+        {OptionKind::ReportFunctionSpecialization,
+         "-report-function-specialization",
+         nullptr,
+         "Reports, for each function whose calls are specialized to the resources, arrays or "
+         "buffer loads passed to it, the number of specialized call sites, the number of "
+         "specialized functions created for them, and the number of call sites that share a "
+         "function created for another call site."},
+        {OptionKind::ReportNodeRecords,
+         "-report-node-records",
+         nullptr,
+         "Reports, for each work graph node entry point, the size of its input record, the "
+         "fields of the record it reads, and the size the record would take with only those "
+         "fields ordered by decreasing alignment."},
+        {OptionKind::DispatchFrequencyHints,
+         "-dispatch-frequency-hints",
+         "-dispatch-frequency-hints <path>",
+         "Order the cases of dynamic dispatch functions by the expected call frequencies in "
+         "<path>, most frequent first. Each line of the file holds the name of a concrete type, "
+         "or of one of its methods as 'Type.method', and a count. Lines starting with '#' are "
+         "comments."},
+        {OptionKind::BranchProfile,
+         "-branch-profile",
+         "-branch-profile <path>",
+         "Mark the if statements that the execution counts in <path> show to rarely take one of "
+         "their sides as [branch]. Each line of the file holds a source position as 'path:line', "
+         "where the path may also be just the file name, and a count, such as the sums of the "
+         "-trace-coverage counters of each position. Lines starting with '#' are comments."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
@@ -604,6 +788,34 @@ void initCommandOptions(CommandOptions& options)
          "-reflection-json",
          "-reflection-json <path>",
          "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionBinary,
+         "-reflection-binary",
+         "-reflection-binary <path>",
+         "Emit reflection data to a file in a compact binary format, which can be read in place "
+         "with the C reader in slang-reflection-binary.h."},
+        {OptionKind::ReflectionOnly,
+         "-reflection-only",
+         nullptr,
+         "Only parse and check the code and compute parameter layouts for reflection. No IR is "
+         "generated, so this is cheaper than a full compile, but asking for target code is an "
+         "error."},
+        {OptionKind::ShaderCacheDirectory,
+         "-cache-dir",
+         "-cache-dir <path>",
+         "Use <path> as a persistent cache of compiled target code. Compiles whose linked "
+         "program, target options and downstream compiler version match a previous compile "
+         "reuse the cached result instead of running code generation again. Host-callable "
+         "targets JIT-compiled by LLVM cache their object code in the 'llvm-jit' subdirectory. "
+         "DXIL compiled by DXC and PTX compiled by NVRTC are also cached by the generated HLSL "
+         "or CUDA source, so a change to the source that leaves the generated code unchanged "
+         "doesn't run the downstream compiler again."},
+        {OptionKind::CodeGenThreadCount,
+         "-codegen-threads",
+         "-codegen-threads <count>",
+         "Generate code for independent targets and entry points on up to <count> threads. "
+         "The default of 1 generates code for each target and entry point in turn. "
+         "Host-callable targets JIT-compiled by LLVM also split large modules across the "
+         "threads."},
         {OptionKind::UseMSVCStyleBitfieldPacking,
          "-msvc-style-bitfield-packing",
          nullptr,
@@ -662,6 +874,13 @@ void initCommandOptions(CommandOptions& options)
          "-disable-specialization",
          nullptr,
          "Disables generics and specialization pass."},
+        {OptionKind::SpecializationConstant,
+         "-specialization-constant",
+         "-specialization-constant <name>",
+         "Compile the `static const` global <name> as a specialization constant (a function "
+         "constant on Metal), with its initializer as the default value, so that one compiled "
+         "module covers every value it can take. Only applies when all targets support "
+         "specialization constants. Can be repeated."},
         {OptionKind::FloatingPointMode,
          "-fp-mode,-floating-point-mode",
          "-fp-mode <fp-mode>, -floating-point-mode <fp-mode>",
@@ -823,6 +1042,34 @@ void initCommandOptions(CommandOptions& options)
          "-llvm-features",
          "-llvm-features <a1,+enable,-disable,...>",
          "Sets a comma-separates list of architecture-specific features for the LLVM targets."},
+        {OptionKind::CPUVectorizeThreadGroups,
+         "-cpu-vectorize-thread-groups",
+         nullptr,
+         "Emit the loop over the threads of a group in C++ compute kernels so that the C++ "
+         "compiler may run the threads on separate SIMD lanes. The threads of a group must not "
+         "depend on one another's memory accesses. Kernels that use group shared memory, "
+         "barriers or atomics keep running one thread at a time."},
+        {OptionKind::SPIRVModuleLinking,
+         "-spirv-module-linking",
+         nullptr,
+         "When generating SPIR-V, compile the library functions of each module the program uses "
+         "once, and link that code into the SPIR-V of every entry point rather than generating "
+         "it again for each of them."},
+        {OptionKind::PackedAnyValueLayout,
+         "-packed-any-value-layout",
+         nullptr,
+         "Pack the bool fields of values stored in an interface-typed existential (an "
+         "'AnyValue') as single bits in shared 32-bit words, rather than one word each. This "
+         "shrinks the inferred size of existential payloads, such as those in ray payloads and "
+         "callable shader data. It changes the layout that 'createDynamicObject' and bit casts "
+         "between interfaces and plain data expect."},
+        {OptionKind::MinimizeRayPayloads,
+         "-minimize-ray-payloads",
+         nullptr,
+         "For D3D and Vulkan targets, remove the fields of ray payloads that no closest-hit, "
+         "any-hit or miss shader in the program reads or writes, so that 'TraceRay' carries only "
+         "the live fields. The caller keeps its values of the other fields. Every shader a "
+         "payload type reaches must be compiled in the same program."},
     };
 
     _addOptions(makeConstArrayView(targetOpts), options);
@@ -959,6 +1206,16 @@ void initCommandOptions(CommandOptions& options)
          "-validate-ir-detailed",
          nullptr,
          "Perform debug validation on IR after each intermediate pass."},
+        {OptionKind::ValidateIRChangedOnly,
+         "-validate-ir-changed-only",
+         nullptr,
+         "When validating IR during code generation, skip the code of functions that hasn't "
+         "changed since it last passed validation. Implies `-validate-ir`."},
+        {OptionKind::ValidateIRInterval,
+         "-validate-ir-interval",
+         "-validate-ir-interval <count>",
+         "When validating IR during code generation, only validate at every <count>th point "
+         "where validation would run, starting with the first. Implies `-validate-ir`."},
         {OptionKind::DumpIRBefore,
          "-dump-ir-before",
          "-dump-ir-before <pass-names>",
@@ -2409,6 +2666,9 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::ReportPerfBenchmark:
         case OptionKind::ReportCheckpointIntermediates:
         case OptionKind::ReportDynamicDispatchSites:
+        case OptionKind::ReportRayPayloadRegisters:
+        case OptionKind::ReportFunctionSpecialization:
+        case OptionKind::ReportNodeRecords:
         case OptionKind::TraceCoverage:
         case OptionKind::SkipSPIRVValidation:
         case OptionKind::DisableSpecialization:
@@ -2427,6 +2687,28 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::IgnoreCapabilities:
         case OptionKind::RestrictiveCapabilityCheck:
         case OptionKind::MinimumSlangOptimization:
+        case OptionKind::CheckReachableFunctionsOnly:
+        case OptionKind::LowerReachableFunctionsOnly:
+        case OptionKind::CompactIR:
+        case OptionKind::OptimizeModuleIR:
+        case OptionKind::HeuristicInlining:
+        case OptionKind::RecycleRemovedIR:
+        case OptionKind::SplitGroupSharedStructArrays:
+        case OptionKind::NarrowHalfArithmetic:
+        case OptionKind::CoalesceByteAddressAccesses:
+        case OptionKind::GlobalValueNumbering:
+        case OptionKind::ScalarReplacementOfAggregates:
+        case OptionKind::ScheduleForRegisterPressure:
+        case OptionKind::InterproceduralConstantPropagation:
+        case OptionKind::UniformityHints:
+        case OptionKind::RemoveUndefinedMeshOutputs:
+        case OptionKind::RemoveUnreadVaryingOutputs:
+        case OptionKind::WaterfallNonUniformResourceIndex:
+        case OptionKind::CPUVectorizeThreadGroups:
+        case OptionKind::SPIRVModuleLinking:
+        case OptionKind::PackedAnyValueLayout:
+        case OptionKind::MinimizeRayPayloads:
+        case OptionKind::ReflectionOnly:
         case OptionKind::DisableNonEssentialValidations:
         case OptionKind::DisableSourceMap:
         case OptionKind::DefaultImageFormatUnknown:
@@ -2836,6 +3118,26 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(OptionKind::TraceCoverage, true);
                 break;
             }
+        case OptionKind::TraceCoverageMode:
+            {
+                CommandLineArg modeArg;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(modeArg));
+                SlangCoverageMode modeValue = SLANG_COVERAGE_MODE_COUNT;
+                if (modeArg.value == "count")
+                    modeValue = SLANG_COVERAGE_MODE_COUNT;
+                else if (modeArg.value == "hit")
+                    modeValue = SLANG_COVERAGE_MODE_HIT;
+                else
+                {
+                    m_sink->diagnose(Diagnostics::UnknownCommandLineValue{
+                        .option = m_currentOptionName,
+                        .validValues = "count, hit"});
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.set(optionKind, (int)modeValue);
+                linkage->m_optionSet.set(OptionKind::TraceCoverage, true);
+                break;
+            }
         case OptionKind::Profile:
             SLANG_RETURN_ON_FAIL(_parseProfile(arg));
             break;
@@ -3102,6 +3404,70 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::SpecializationConstant:
+            {
+                CommandLineArg name;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(name));
+
+                linkage->m_optionSet.add(CompilerOptionName::SpecializationConstant, name.value);
+                break;
+            }
+        case OptionKind::EmitReflectionBinary:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::EmitReflectionBinary,
+                    outputPath.value);
+                break;
+            }
+        case OptionKind::ReportPassStatistics:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::ReportPassStatistics,
+                    outputPath.value);
+                break;
+            }
+        case OptionKind::TraceEvents:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(CompilerOptionName::TraceEvents, outputPath.value);
+                break;
+            }
+        case OptionKind::DispatchFrequencyHints:
+            {
+                CommandLineArg hintsPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(hintsPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::DispatchFrequencyHints,
+                    hintsPath.value);
+                break;
+            }
+        case OptionKind::BranchProfile:
+            {
+                CommandLineArg profilePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(profilePath));
+
+                linkage->m_optionSet.set(CompilerOptionName::BranchProfile, profilePath.value);
+                break;
+            }
+        case OptionKind::ShaderCacheDirectory:
+            {
+                CommandLineArg cacheDirectory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cacheDirectory));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::ShaderCacheDirectory,
+                    cacheDirectory.value);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -3342,12 +3708,28 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::BindlessSpaceIndex:
         case OptionKind::SPIRVSamplerHeapStride:
         case OptionKind::SPIRVResourceHeapStride:
+        case OptionKind::CodeGenThreadCount:
+        case OptionKind::LoopUnrollBudget:
+        case OptionKind::AutodiffCheckpointBudget:
+        case OptionKind::CompileTimeBudget:
             {
                 Int index = 0;
                 SLANG_RETURN_ON_FAIL(_expectUInt(arg, index));
                 linkage->m_optionSet.add(optionKind, (int)index);
                 break;
             }
+        case OptionKind::ValidateIRChangedOnly:
+            linkage->m_optionSet.set(optionKind, true);
+            linkage->m_optionSet.set(OptionKind::ValidateIr, true);
+            break;
+        case OptionKind::ValidateIRInterval:
+            {
+                Int interval = 0;
+                SLANG_RETURN_ON_FAIL(_expectUInt(arg, interval));
+                linkage->m_optionSet.set(optionKind, (int)interval);
+                linkage->m_optionSet.set(OptionKind::ValidateIr, true);
+                break;
+            }
         case OptionKind::DumpModule:
             {
                 CommandLineArg fileName;
@@ -786,7 +786,43 @@ static void collectGlobalScopeParameter(
     // We use a single operation to both check whether the
     // variable represents a shader parameter, and to compute
     // the layout for that parameter's type.
-    auto typeLayout = getTypeLayoutForGlobalShaderParameter(context, varDeclRef.getDecl(), type);
+    //
+    // When the parameter's type can't depend on specialization its layout is the
+    // same in every specialization of the program, so we compute it once per target
+    // and share it. Only the binding of registers, which depends on the other
+    // parameters in the program, is redone for each specialization.
+    //
+    // On Khronos targets, explicit HLSL `register`s can adjust the type layout of
+    // the parameter they are on (see `addExplicitParameterBindings_GLSL`), so we
+    // don't share those layouts.
+    //
+    bool canShareLayout =
+        shaderParamInfo.specializationParamCount == 0 &&
+        !(isKhronosTarget(context->getTargetRequest()) &&
+          varDeclRef.getDecl()->hasModifier<HLSLRegisterSemantic>());
+    auto sharedCache = context->getTargetRequest()->getSharedTypeLayoutCache();
+    SharedTypeLayoutCache::ParameterKey sharedKey = {
+        varDeclRef.getDecl(),
+        type,
+        context->layoutContext.rules,
+        context->layoutContext.matrixLayoutMode};
+
+    RefPtr<TypeLayout> typeLayout;
+    if (canShareLayout)
+        typeLayout = sharedCache->tryGetParameterLayout(sharedKey);
+    if (!typeLayout)
+    {
+        auto sink = getSink(context);
+        auto errorCount = sink ? sink->getErrorCount() : 0;
+
+        typeLayout = getTypeLayoutForGlobalShaderParameter(context, varDeclRef.getDecl(), type);
+
+        if (typeLayout && canShareLayout && (!sink || sink->getErrorCount() == errorCount) &&
+            !mayTypeLayoutDependOnSpecialization(astBuilder, type))
+        {
+            typeLayout = sharedCache->addParameterLayout(sharedKey, typeLayout);
+        }
+    }
 
     // If we did not find appropriate layout rules, then it
     // must mean that this global variable is *not* a shader
@@ -4410,7 +4446,8 @@ ProgramLayout* TargetProgram::getOrCreateLayout(DiagnosticSink* sink)
             return nullptr;
     }
 
-    if (m_layout && !m_irModuleForLayout)
+    // A reflection-only linkage stops at the layout, without lowering it to IR.
+    if (m_layout && !m_irModuleForLayout && !m_program->getLinkage()->isReflectionOnly())
     {
         m_irModuleForLayout = createIRModuleForLayout(sink);
     }
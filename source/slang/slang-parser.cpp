@@ -84,13 +84,17 @@ enum class ParsingStage
     Body,
 };
 
+// The parser is copied for every speculative parse (e.g., of each `<` that might start a
+// generic argument list) and created for every function body, so the options it needs are
+// kept as plain flags rather than as a copy of the whole `CompilerOptionSet`.
 struct ParserOptions
 {
     bool enableEffectAnnotations = false;
     bool allowGLSLInput = false;
     bool isInLanguageServer = false;
+    bool noMangle = false;
+    bool unscopedEnum = false;
     ParsingStage stage = ParsingStage::Body;
-    CompilerOptionSet optionSet;
 };
 
 // TODO: implement two pass parsing for file reference and struct type recognition
@@ -3820,7 +3824,7 @@ static Decl* ParseBufferBlockDecl(
     else
     {
         // Otherwise, we need to generate a name for the buffer variable.
-        if (parser->options.optionSet.getBoolOption(CompilerOptionName::NoMangle))
+        if (parser->options.noMangle)
         {
             // If no-mangle option is set, use the reflection name as the variable name,
             // and mark all members of the buffer object as no mangle.
@@ -5955,7 +5959,7 @@ static Decl* parseEnumDecl(Parser* parser)
 
     if (!isEnumClass)
     {
-        if (parser->options.optionSet.getBoolOption(CompilerOptionName::UnscopedEnum))
+        if (parser->options.unscopedEnum)
         {
             isUnscoped = true;
         }
@@ -9420,6 +9424,26 @@ Expr* parseTermFromSourceFile(
     return parser.ParseExpression();
 }
 
+static ParserOptions _getParserOptions(
+    TranslationUnitRequest* translationUnit,
+    SourceLanguage sourceLanguage,
+    ParsingStage stage)
+{
+    auto& optionSet = translationUnit->compileRequest->optionSet;
+
+    ParserOptions options = {};
+    options.stage = stage;
+    options.enableEffectAnnotations =
+        optionSet.getBoolOption(CompilerOptionName::EnableEffectAnnotations);
+    options.allowGLSLInput = optionSet.getBoolOption(CompilerOptionName::AllowGLSL) ||
+                             sourceLanguage == SourceLanguage::GLSL;
+    options.isInLanguageServer =
+        translationUnit->compileRequest->getLinkage()->isInLanguageServer();
+    options.noMangle = optionSet.getBoolOption(CompilerOptionName::NoMangle);
+    options.unscopedEnum = optionSet.getBoolOption(CompilerOptionName::UnscopedEnum);
+    return options;
+}
+
 Stmt* parseUnparsedStmt(
     ASTBuilder* astBuilder,
     SemanticsVisitor* semanticsVisitor,
@@ -9430,16 +9454,8 @@ Stmt* parseUnparsedStmt(
     Scope* currentScope,
     Scope* outerScope)
 {
-    ParserOptions options = {};
-    options.stage = ParsingStage::Body;
-    options.enableEffectAnnotations = translationUnit->compileRequest->optionSet.getBoolOption(
-        CompilerOptionName::EnableEffectAnnotations);
-    options.allowGLSLInput =
-        translationUnit->compileRequest->optionSet.getBoolOption(CompilerOptionName::AllowGLSL) ||
-        sourceLanguage == SourceLanguage::GLSL;
-    options.isInLanguageServer =
-        translationUnit->compileRequest->getLinkage()->isInLanguageServer();
-    options.optionSet = translationUnit->compileRequest->optionSet;
+    ParserOptions options =
+        _getParserOptions(translationUnit, sourceLanguage, ParsingStage::Body);
 
     Parser parser(astBuilder, tokens, sink, outerScope, options);
     parser.currentScope = outerScope;
@@ -9461,16 +9477,8 @@ void parseSourceFile(
     Scope* outerScope,
     ContainerDecl* parentDecl)
 {
-    ParserOptions options = {};
-    options.stage = ParsingStage::Decl;
-    options.enableEffectAnnotations = translationUnit->compileRequest->optionSet.getBoolOption(
-        CompilerOptionName::EnableEffectAnnotations);
-    options.allowGLSLInput =
-        translationUnit->compileRequest->optionSet.getBoolOption(CompilerOptionName::AllowGLSL) ||
-        sourceLanguage == SourceLanguage::GLSL;
-    options.isInLanguageServer =
-        translationUnit->compileRequest->getLinkage()->isInLanguageServer();
-    options.optionSet = translationUnit->compileRequest->optionSet;
+    ParserOptions options =
+        _getParserOptions(translationUnit, sourceLanguage, ParsingStage::Decl);
 
     Parser parser(astBuilder, tokens, sink, outerScope, options);
     parser.namePool = translationUnit->getNamePool();
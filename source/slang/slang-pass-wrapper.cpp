@@ -54,6 +54,8 @@ static void dumpIRForPass(CodeGenContext* codeGenContext, IRModule* irModule, co
 
 void prePassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName)
 {
+    checkCodeGenCancellation();
+
     auto targetRequest = codeGenContext->getTargetReq();
     auto targetCompilerOptions = targetRequest->getOptionSet();
 
@@ -70,10 +72,14 @@ void postPassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const cha
     auto targetRequest = codeGenContext->getTargetReq();
     auto targetCompilerOptions = targetRequest->getOptionSet();
 
+    // Nothing refers to the instructions the pass removed any more, so their memory
+    // can be reused by the passes that follow.
+    irModule->recycleRemovedInsts();
+
     // Check if we should perform detailed IR validation
     if (targetCompilerOptions.getBoolOption(CompilerOptionName::ValidateIRDetailed))
     {
-        validateIRModule(irModule, codeGenContext->getSink());
+        validateIRModuleAtValidationPoint(codeGenContext, irModule);
     }
 
     // Check if we should dump IR after this pass
@@ -84,4 +90,42 @@ void postPassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const cha
     }
 }
 
+bool shouldCollectPassStatistics(CompilerOptionSet& options)
+{
+    return options.getBoolOption(CompilerOptionName::ReportDetailedPerfBenchmark) ||
+           options.hasOption(CompilerOptionName::ReportPassStatistics);
+}
+
+PassStatisticsSnapshot beginPassStatistics(IRModule* irModule)
+{
+    PassStatisticsSnapshot snapshot;
+    snapshot.createdInstCount = irModule->getCreatedInstCount();
+    snapshot.destroyedInstCount = irModule->getDestroyedInstCount();
+    snapshot.arenaBytes = irModule->getMemoryArena().calcTotalMemoryAllocated();
+    snapshot.startTime = std::chrono::high_resolution_clock::now();
+    return snapshot;
+}
+
+void endPassStatistics(
+    IRModule* irModule,
+    const char* passName,
+    PassStatisticsSnapshot const& snapshot)
+{
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    PassStatisticsInfo info;
+    info.passName = passName;
+    info.invocationCount = 1;
+    info.duration = endTime - snapshot.startTime;
+    info.instsCreated = irModule->getCreatedInstCount() - snapshot.createdInstCount;
+    info.instsDestroyed = irModule->getDestroyedInstCount() - snapshot.destroyedInstCount;
+
+    // The arena only ever grows while a module is live, but guard against a pass that
+    // resets it.
+    auto arenaBytes = irModule->getMemoryArena().calcTotalMemoryAllocated();
+    info.arenaBytesGrown = arenaBytes > snapshot.arenaBytes ? arenaBytes - snapshot.arenaBytes : 0;
+
+    PerformanceProfiler::getProfiler()->getPassStatistics().add(info);
+}
+
 } // namespace Slang
@@ -20,6 +20,23 @@ struct CodeGenContext;
 void prePassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName);
 void postPassHooks(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName);
 
+// State of an IR module captured at the start of a pass, so that statistics for the pass
+// can be recorded when it finishes.
+struct PassStatisticsSnapshot
+{
+    std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    UInt64 createdInstCount = 0;
+    UInt64 destroyedInstCount = 0;
+    size_t arenaBytes = 0;
+};
+
+bool shouldCollectPassStatistics(CompilerOptionSet& options);
+PassStatisticsSnapshot beginPassStatistics(IRModule* irModule);
+void endPassStatistics(
+    IRModule* irModule,
+    const char* passName,
+    PassStatisticsSnapshot const& snapshot);
+
 // RAII helper for pass hooks and performance profiling
 struct PassHooksRAII
 {
@@ -27,23 +44,49 @@ struct PassHooksRAII
     IRModule* irModule;
     const char* passName;
     std::optional<PerformanceProfilerFuncRAIIContext> perfContext;
+    std::optional<PassStatisticsSnapshot> passStatistics;
+    std::optional<PerformanceProfilerTraceRAIIContext> traceContext;
+    std::optional<std::chrono::time_point<std::chrono::steady_clock>> budgetStartTime;
 
     PassHooksRAII(CodeGenContext* ctx, IRModule* module, const char* name)
         : codeGenContext(ctx), irModule(module), passName(name)
     {
         prePassHooks(codeGenContext, irModule, passName);
 
+        if (PerformanceProfiler::getProfiler()->isTracing())
+        {
+            traceContext.emplace("pass", passName);
+        }
+
         auto targetRequest = codeGenContext->getTargetReq();
-        auto targetCompilerOptions = targetRequest->getOptionSet();
+        auto& targetCompilerOptions = targetRequest->getOptionSet();
         if (targetCompilerOptions.getBoolOption(CompilerOptionName::ReportDetailedPerfBenchmark))
         {
             perfContext.emplace(passName);
         }
+        if (shouldCollectPassStatistics(targetCompilerOptions))
+        {
+            passStatistics = beginPassStatistics(irModule);
+        }
+        if (codeGenContext->getCompileTimeBudget().isEnabled())
+        {
+            budgetStartTime = std::chrono::steady_clock::now();
+        }
     }
 
     ~PassHooksRAII()
     {
-        perfContext.reset(); // End profiler timing before post hooks
+        // End profiler timing before post hooks
+        if (passStatistics)
+            endPassStatistics(irModule, passName, *passStatistics);
+        if (budgetStartTime)
+        {
+            std::chrono::duration<double, std::milli> duration =
+                std::chrono::steady_clock::now() - *budgetStartTime;
+            codeGenContext->getCompileTimeBudget().notePassDuration(passName, duration.count());
+        }
+        perfContext.reset();
+        traceContext.reset();
         postPassHooks(codeGenContext, irModule, passName);
     }
 };
@@ -12,6 +12,7 @@
 // to another.
 
 #include "../compiler-core/slang-lexer.h"
+#include "../compiler-core/slang-perfect-hash.h"
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
 #include "slang-rich-diagnostics.h"
@@ -39,6 +40,98 @@ void PreprocessorHandler::handleFileDependency(SourceFile* sourceFile)
     SLANG_UNUSED(sourceFile);
 }
 
+//
+// IncludeFileTokenCache
+//
+
+// Lexing a file depends on nothing but its content, so a header that many translation units
+// `#include` only needs to be lexed once. The tokens are kept relative to the start of the
+// file they were lexed from, so they can be replayed into the new source view that every
+// `#include` of the file creates.
+
+/// Tokens lexed from `#include`d files, keyed by the identity and content of each file
+struct IncludeFileTokenCache : RefObject
+{
+    /// A token as lexed from a file, with its location and content relative to the file
+    struct CachedToken
+    {
+        TokenType type;
+        TokenFlags flags;
+        uint32_t charsCount;
+
+        /// Offset of the token from the start of the file
+        uint32_t locOffset;
+
+        /// Offset of the token content in the file, or in `Entry::scrubbedText` if the
+        /// content isn't part of the file (because escaped newlines were scrubbed from it)
+        uint32_t contentOffset;
+        bool isScrubbed;
+
+        /// The name of the token, if it has one
+        Name* name;
+    };
+
+    /// All the (non-whitespace, non-comment) tokens lexed from one file
+    struct Entry : RefObject
+    {
+        /// The tokens of the file, ending with its end-of-file token
+        List<CachedToken> tokens;
+
+        StringBuilder scrubbedText;
+
+        /// If the whole file is inside of an `#ifndef`, the macro it tests.
+        ///
+        /// Including the file again while that macro is defined would skip all of it,
+        /// so there is no need to open it.
+        Name* includeGuard = nullptr;
+    };
+
+    struct Key
+    {
+        String uniqueIdentity;
+        HashCode64 contentHash = 0;
+        Count contentSize = 0;
+
+        bool operator==(Key const& other) const
+        {
+            return contentHash == other.contentHash && contentSize == other.contentSize &&
+                   uniqueIdentity == other.uniqueIdentity;
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(uniqueIdentity.getHashCode(), contentHash);
+        }
+    };
+
+    /// The key and (if there is one) the cached entry for a file
+    struct Lookup
+    {
+        Key key;
+        RefPtr<Entry> entry;
+    };
+
+    Lookup lookup(SourceFile* sourceFile)
+    {
+        auto content = sourceFile->getContent();
+
+        Lookup result;
+        result.key.uniqueIdentity = sourceFile->getPathInfo().getMostUniqueIdentity();
+        result.key.contentHash = Slang::getHashCode(content.begin(), content.getLength());
+        result.key.contentSize = content.getLength();
+        entries.tryGetValue(result.key, result.entry);
+        return result;
+    }
+
+    Dictionary<Key, RefPtr<Entry>> entries;
+};
+
+IncludeFileTokenCache* Linkage::getIncludeFileTokenCache()
+{
+    if (!m_includeFileTokenCache)
+        m_includeFileTokenCache = new IncludeFileTokenCache();
+    return static_cast<IncludeFileTokenCache*>(m_includeFileTokenCache.get());
+}
+
 // In order to simplify the naming scheme, we will nest the implementaiton of the
 // preprocessor under an additional namesspace, so taht we can have, e.g.,
 // `MacroDefinition` instead of `PreprocessorMacroDefinition`.
@@ -519,7 +612,14 @@ struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
-    LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView);
+    /// Create a stream for the tokens of `sourceView`.
+    ///
+    /// If `cacheLookup` has an entry, its tokens are replayed instead of lexing the file, and
+    /// otherwise the tokens that get lexed are added to the cache once the file has been read.
+    LexerInputStream(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        IncludeFileTokenCache::Lookup* cacheLookup);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -545,12 +645,17 @@ private:
     /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+            return _replayCachedToken();
+
         for (;;)
         {
             Token token = m_lexer.lexToken();
             switch (token.type)
             {
             default:
+                if (m_recordedTokens)
+                    _recordToken(token);
                 return token;
 
             case TokenType::WhiteSpace:
@@ -561,9 +666,24 @@ private:
         }
     }
 
+    Token _replayCachedToken();
+    void _recordToken(Token const& token);
+
     /// The lexer state that will provide input
+    ///
+    /// When tokens are replayed from the cache the lexer is never advanced, but it is
+    /// still used to find line ends and to identify the source view.
     Lexer m_lexer;
 
+    /// Tokens being replayed from the cache, if the file was lexed before
+    RefPtr<IncludeFileTokenCache::Entry> m_cachedTokens;
+    Index m_cachedTokenIndex = 0;
+
+    /// Tokens being recorded to add to the cache under `m_cacheKey`, if the file wasn't
+    IncludeFileTokenCache* m_tokenCache = nullptr;
+    IncludeFileTokenCache::Key m_cacheKey;
+    RefPtr<IncludeFileTokenCache::Entry> m_recordedTokens;
+
     /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -949,7 +1069,10 @@ private:
 ///
 struct InputFile
 {
-    InputFile(Preprocessor* preprocessor, SourceView* sourceView);
+    InputFile(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        IncludeFileTokenCache::Lookup* cacheLookup = nullptr);
 
     ~InputFile();
 
@@ -1321,6 +1444,9 @@ struct Preprocessor
     /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+    /// Tokens lexed from `#include`d files, if they are shared with other runs
+    IncludeFileTokenCache* includeFileTokenCache = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 
@@ -1397,19 +1523,167 @@ DiagnosticSink* InputStream::getSink()
 // Basic Input Handling
 //
 
-LexerInputStream::LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView)
+LexerInputStream::LexerInputStream(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    IncludeFileTokenCache::Lookup* cacheLookup)
     : Super(preprocessor)
 {
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
+
+    if (cacheLookup)
+    {
+        if (cacheLookup->entry)
+        {
+            m_cachedTokens = cacheLookup->entry;
+        }
+        else
+        {
+            m_tokenCache = preprocessor->includeFileTokenCache;
+            m_cacheKey = cacheLookup->key;
+            m_recordedTokens = new IncludeFileTokenCache::Entry();
+        }
+    }
+
     m_lookaheadToken = _readTokenImpl();
 }
 
-InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
+Token LexerInputStream::_replayCachedToken()
+{
+    auto const& tokens = m_cachedTokens->tokens;
+    auto const& cached = tokens[m_cachedTokenIndex];
+
+    // Like the lexer, keep returning the end-of-file token once it has been reached.
+    if (m_cachedTokenIndex < tokens.getCount() - 1)
+        m_cachedTokenIndex++;
+
+    Token token;
+    token.type = cached.type;
+    token.flags = cached.flags;
+    token.loc = m_lexer.m_startLoc + cached.locOffset;
+    if (cached.name)
+    {
+        token.setName(cached.name);
+    }
+    else if (cached.isScrubbed)
+    {
+        // Scrubbed content lives as long as the content the lexer would have allocated.
+        char* chars = (char*)m_lexer.m_memoryArena->allocateUnaligned(cached.charsCount);
+        memcpy(
+            chars,
+            m_cachedTokens->scrubbedText.getBuffer() + cached.contentOffset,
+            cached.charsCount);
+        token.setContent(UnownedStringSlice(chars, cached.charsCount));
+    }
+    else
+    {
+        token.setContent(
+            UnownedStringSlice(m_lexer.m_begin + cached.contentOffset, cached.charsCount));
+    }
+    return token;
+}
+
+/// Find the macro tested by an include guard wrapped around all of `tokens`.
+///
+/// That is, the file must start with `#ifndef NAME`, and the `#endif` that ends it must be
+/// the last thing in the file.
+static Name* _findIncludeGuard(List<IncludeFileTokenCache::CachedToken> const& tokens)
+{
+    auto getDirectiveName = [&](Index index) -> Name*
+    {
+        if (index + 1 >= tokens.getCount())
+            return nullptr;
+        auto const& pound = tokens[index];
+        if (pound.type != TokenType::Pound || !(pound.flags & TokenFlag::AtStartOfLine))
+            return nullptr;
+        auto const& directive = tokens[index + 1];
+        if (directive.type != TokenType::Identifier || (directive.flags & TokenFlag::AtStartOfLine))
+            return nullptr;
+        return directive.name;
+    };
+    auto isDirective = [&](Name* name, const char* text)
+    { return name && name->text == text; };
+
+    if (!isDirective(getDirectiveName(0), "ifndef") || tokens.getCount() < 4)
+        return nullptr;
+    auto const& guard = tokens[2];
+    if (guard.type != TokenType::Identifier || (guard.flags & TokenFlag::AtStartOfLine) ||
+        !(tokens[3].flags & TokenFlag::AtStartOfLine))
+        return nullptr;
+
+    Index depth = 1;
+    for (Index i = 3; i < tokens.getCount(); i++)
+    {
+        auto name = getDirectiveName(i);
+        if (!name)
+            continue;
+        if (isDirective(name, "if") || isDirective(name, "ifdef") || isDirective(name, "ifndef"))
+        {
+            depth++;
+        }
+        else if (isDirective(name, "endif"))
+        {
+            if (--depth == 0)
+                return tokens[i + 2].type == TokenType::EndOfFile ? guard.name : nullptr;
+        }
+        else if (depth == 1 && (isDirective(name, "else") || isDirective(name, "elif")))
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void LexerInputStream::_recordToken(Token const& token)
+{
+    IncludeFileTokenCache::CachedToken cached;
+    cached.type = token.type;
+    cached.flags = token.flags;
+    cached.charsCount = token.charsCount;
+    cached.locOffset = uint32_t(token.loc.getRaw() - m_lexer.m_startLoc.getRaw());
+    cached.contentOffset = 0;
+    cached.isScrubbed = false;
+    cached.name = token.getNameOrNull();
+    if (!cached.name && token.hasContent())
+    {
+        const char* chars = token.charsNameUnion.chars;
+        if (chars >= m_lexer.m_begin && chars + token.charsCount <= m_lexer.m_end)
+        {
+            cached.contentOffset = uint32_t(chars - m_lexer.m_begin);
+        }
+        else
+        {
+            auto& scrubbedText = m_recordedTokens->scrubbedText;
+            cached.contentOffset = uint32_t(scrubbedText.getLength());
+            cached.isScrubbed = true;
+            scrubbedText.append(token.getContent());
+        }
+    }
+    m_recordedTokens->tokens.add(cached);
+
+    if (token.type != TokenType::EndOfFile)
+        return;
+
+    // Tokens are only shared if lexing them didn't diagnose anything, because the
+    // diagnostics would be lost when replaying them. This includes diagnostics that were
+    // suppressed inside disabled conditionals, which may be enabled in another translation unit.
+    if (!(m_lexer.m_lexerFlags & kLexerFlag_HasDiagnostics))
+    {
+        m_recordedTokens->includeGuard = _findIncludeGuard(m_recordedTokens->tokens);
+        m_tokenCache->entries[m_cacheKey] = m_recordedTokens;
+    }
+    m_recordedTokens = nullptr;
+}
+
+InputFile::InputFile(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    IncludeFileTokenCache::Lookup* cacheLookup)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cacheLookup);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -3710,11 +3984,26 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         handler->handleFileDependency(sourceFile);
     }
 
+    // If the file was lexed before, its tokens can be replayed. And if the file is wrapped in an
+    // include guard that is already defined, all of it would be skipped, so it is left out
+    // entirely (unless the language server wants to see the skipped code).
+    IncludeFileTokenCache::Lookup cacheLookup;
+    auto tokenCache = context->m_preprocessor->includeFileTokenCache;
+    if (tokenCache)
+    {
+        cacheLookup = tokenCache->lookup(sourceFile);
+        auto entry = cacheLookup.entry;
+        if (entry && entry->includeGuard && !context->m_preprocessor->contentAssistInfo &&
+            LookupMacro(context, entry->includeGuard))
+            return;
+    }
+
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView =
         sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    InputFile* inputFile =
+        new InputFile(context->m_preprocessor, sourceView, tokenCache ? &cacheLookup : nullptr);
 
     context->m_preprocessor->pushInputFile(inputFile, directiveLoc, fileIdentity);
 }
@@ -4604,9 +4893,6 @@ struct PreprocessorDirective
 };
 
 // A simple array of all the directives we know how to handle.
-// TODO(tfoley): considering making this into a real hash map,
-// and then make it easy-ish for users of the codebase to add
-// their own directives as desired.
 static const PreprocessorDirective kDirectives[] = {
     {"if", &HandleIfDirective, ProcessWhenSkipping},
     {"ifdef", &HandleIfDefDirective, ProcessWhenSkipping},
@@ -4640,19 +4926,36 @@ static const PreprocessorDirective kInvalidDirective = {
     0,
 };
 
-// Look up the directive with the given name.
-static PreprocessorDirective const* FindDirective(String const& name)
+// A minimal perfect hash of the names in `kDirectives`, so that looking up a directive hashes
+// its name once and compares it against a single candidate.
+struct PreprocessorDirectiveTable
 {
-    char const* nameStr = name.getBuffer();
-    for (int ii = 0; kDirectives[ii].name; ++ii)
+    PreprocessorDirectiveTable()
     {
-        if (strcmp(kDirectives[ii].name, nameStr) != 0)
-            continue;
+        List<String> names;
+        for (int ii = 0; kDirectives[ii].name; ++ii)
+            names.add(kDirectives[ii].name);
 
-        return &kDirectives[ii];
+        [[maybe_unused]] const auto result = minimalPerfectHash(names, hashParams);
+        SLANG_ASSERT(result == HashFindResult::Success);
+
+        for (const auto& name : hashParams.destTable)
+            directives.add(&kDirectives[names.indexOf(name)]);
     }
 
-    return &kInvalidDirective;
+    HashParams hashParams;
+
+    // The directive for each entry in `hashParams.destTable`
+    List<PreprocessorDirective const*> directives;
+};
+
+// Look up the directive with the given name.
+static PreprocessorDirective const* FindDirective(UnownedStringSlice const& name)
+{
+    static const PreprocessorDirectiveTable table;
+
+    const Index index = perfectHashLookup(table.hashParams, name);
+    return index >= 0 ? table.directives[index] : &kInvalidDirective;
 }
 
 // Process a directive, where the preprocessor has already consumed the
@@ -4988,6 +5291,7 @@ TokenList preprocessSource(
     desc.fileSystem = linkage->getFileSystemExt();
     desc.namePool = linkage->getNamePool();
     desc.sourceManager = linkage->getSourceManager();
+    desc.includeFileTokenCache = linkage->getIncludeFileTokenCache();
 
     if (linkage->isInLanguageServer())
     {
@@ -5024,6 +5328,7 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
+    preprocessor.includeFileTokenCache = desc.includeFileTokenCache;
 
     preprocessor.warningStateTracker =
         dynamicCast<preprocessor::WarningStateTracker>(desc.sink->getSourceWarningStateTracker());
@@ -10,6 +10,7 @@ namespace Slang
 {
 
 class DiagnosticSink;
+struct IncludeFileTokenCache;
 class Linkage;
 struct PreprocessorContentAssistInfo;
 
@@ -59,6 +60,9 @@ struct PreprocessorDesc
 
     /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+    /// Optional: cache of the tokens lexed from `#include`d files, shared with other runs
+    IncludeFileTokenCache* includeFileTokenCache = nullptr;
 };
 
 /// Take a source `file` and preprocess it into a list of tokens.
@@ -2633,20 +2633,31 @@ struct ExtendedTypeLayoutContext
 
 TypeLayout::ExtendedInfo* getExtendedTypeLayout(TypeLayout* typeLayout)
 {
-    if (!typeLayout->m_extendedInfo)
-    {
-        RefPtr<TypeLayout::ExtendedInfo> extendedInfo = new TypeLayout::ExtendedInfo;
+    if (auto existing = typeLayout->m_extendedInfo.load(std::memory_order_acquire))
+        return existing;
+
+    // Threads that race to get here each compute the info, which only reads the type
+    // layout, and the first one to publish its result wins.
+    RefPtr<TypeLayout::ExtendedInfo> extendedInfo = new TypeLayout::ExtendedInfo;
 
-        ExtendedTypeLayoutContext context;
-        context.m_typeLayout = typeLayout;
-        context.m_extendedInfo = extendedInfo;
+    ExtendedTypeLayoutContext context;
+    context.m_typeLayout = typeLayout;
+    context.m_extendedInfo = extendedInfo;
 
-        BindingRangePath rootPath;
-        context.addRangesRec(typeLayout, rootPath, 1);
+    BindingRangePath rootPath;
+    context.addRangesRec(typeLayout, rootPath, 1);
 
-        typeLayout->m_extendedInfo = extendedInfo;
+    TypeLayout::ExtendedInfo* existing = nullptr;
+    if (!typeLayout->m_extendedInfo.compare_exchange_strong(
+            existing,
+            extendedInfo.get(),
+            std::memory_order_acq_rel,
+            std::memory_order_acquire))
+    {
+        return existing;
     }
-    return typeLayout->m_extendedInfo;
+    // The reference is now held by the type layout.
+    return extendedInfo.detach();
 }
 } // namespace Slang
 
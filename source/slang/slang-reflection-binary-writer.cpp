@@ -0,0 +1,318 @@
+// slang-reflection-binary-writer.cpp
+#include "slang-reflection-binary-writer.h"
+
+#include "../core/slang-basic.h"
+#include "../core/slang-riff.h"
+#include "slang-reflection-binary.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+static const FourCC::RawValue kReflectionBinaryFourCC = SLANG_FOUR_CC('S', 'L', 'r', 'f');
+static const FourCC::RawValue kReflectionBinaryDataFourCC = SLANG_FOUR_CC('d', 'a', 't', 'a');
+
+/// Get `size` as it is stored in the binary format.
+static uint32_t _toSize32(size_t size)
+{
+    if (size == SLANG_UNBOUNDED_SIZE)
+        return SLANG_REFLECTION_BINARY_SIZE_UNBOUNDED;
+    if (size == SLANG_UNKNOWN_SIZE || size >= SLANG_REFLECTION_BINARY_SIZE_UNKNOWN)
+        return SLANG_REFLECTION_BINARY_SIZE_UNKNOWN;
+    return uint32_t(size);
+}
+
+/// Flattens reflection into the tables of the binary format.
+///
+/// A run of var layouts, such as the fields of a struct, is reserved before any of them are
+/// written, because writing a var layout can add the layouts of its type to the tables.
+struct ReflectionBinaryWriter
+{
+    ReflectionBinaryWriter() { m_strings.add(0); }
+
+    uint32_t addString(const char* text)
+    {
+        if (!text || !text[0])
+            return 0;
+
+        String string(text);
+        if (auto offset = m_stringOffsets.tryGetValue(string))
+            return *offset;
+
+        const uint32_t offset = uint32_t(m_strings.getCount());
+        m_strings.addRange(text, Index(::strlen(text)) + 1);
+        m_stringOffsets.add(string, offset);
+        return offset;
+    }
+
+    uint32_t reserveVarLayouts(Count count)
+    {
+        const uint32_t first = uint32_t(m_varLayouts.getCount());
+        if (count)
+            m_varLayouts.growToCount(first + count);
+        return first;
+    }
+
+    void writeVarLayout(uint32_t index, slang::VariableLayoutReflection* varLayout)
+    {
+        SlangReflectionBinaryVarLayout record = {};
+        record.name = addString(varLayout->getName());
+        record.semanticName = addString(varLayout->getSemanticName());
+        record.semanticIndex = uint32_t(varLayout->getSemanticIndex());
+
+        auto typeLayout = varLayout->getTypeLayout();
+        record.firstBinding = uint32_t(m_bindings.getCount());
+        record.bindingCount = varLayout->getCategoryCount();
+        for (unsigned i = 0; i < record.bindingCount; ++i)
+        {
+            auto category = SlangParameterCategory(varLayout->getCategoryByIndex(i));
+
+            SlangReflectionBinaryBinding binding;
+            binding.category = uint32_t(category);
+            binding.index = _toSize32(varLayout->getOffset(category));
+            binding.space = _toSize32(varLayout->getBindingSpace(category));
+            binding.count = _toSize32(typeLayout->getSize(category));
+            m_bindings.add(binding);
+        }
+
+        record.typeLayout = addTypeLayout(typeLayout);
+        m_varLayouts[index] = record;
+    }
+
+    uint32_t addVarLayout(slang::VariableLayoutReflection* varLayout)
+    {
+        if (!varLayout)
+            return SLANG_REFLECTION_BINARY_NONE;
+        const uint32_t index = reserveVarLayouts(1);
+        writeVarLayout(index, varLayout);
+        return index;
+    }
+
+    uint32_t addTypeLayout(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+            return SLANG_REFLECTION_BINARY_NONE;
+        if (auto index = m_typeLayoutIndices.tryGetValue(typeLayout))
+            return *index;
+
+        // Add the index first, so a type that refers back to itself finds it.
+        const uint32_t index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayouts.add(SlangReflectionBinaryTypeLayout{});
+        m_typeLayoutIndices.add(typeLayout, index);
+
+        SlangReflectionBinaryTypeLayout record = {};
+        record.elementTypeLayout = SLANG_REFLECTION_BINARY_NONE;
+        record.elementVarLayout = SLANG_REFLECTION_BINARY_NONE;
+        record.kind = uint32_t(typeLayout->getKind());
+        record.uniformAlignment =
+            uint32_t(typeLayout->getAlignment(SLANG_PARAMETER_CATEGORY_UNIFORM));
+
+        record.firstSize = uint32_t(m_sizes.getCount());
+        record.sizeCount = typeLayout->getCategoryCount();
+        for (unsigned i = 0; i < record.sizeCount; ++i)
+        {
+            auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+            SlangReflectionBinarySize size;
+            size.category = uint32_t(category);
+            size.size = _toSize32(typeLayout->getSize(category));
+            m_sizes.add(size);
+        }
+
+        if (auto type = typeLayout->getType())
+        {
+            record.name = addString(type->getName());
+            record.scalarType = uint32_t(type->getScalarType());
+            record.resourceShape = uint32_t(type->getResourceShape());
+            record.resourceAccess = uint32_t(type->getResourceAccess());
+        }
+
+        switch (typeLayout->getKind())
+        {
+        case slang::TypeReflection::Kind::Struct:
+            {
+                record.fieldCount = typeLayout->getFieldCount();
+                record.firstField = reserveVarLayouts(record.fieldCount);
+                for (unsigned i = 0; i < record.fieldCount; ++i)
+                    writeVarLayout(record.firstField + i, typeLayout->getFieldByIndex(i));
+            }
+            break;
+
+        case slang::TypeReflection::Kind::Array:
+            record.elementCount = _toSize32(typeLayout->getElementCount());
+            record.uniformStride =
+                _toSize32(typeLayout->getElementStride(SLANG_PARAMETER_CATEGORY_UNIFORM));
+            record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+            break;
+
+        case slang::TypeReflection::Kind::Vector:
+            record.elementCount = _toSize32(typeLayout->getElementCount());
+            record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+            break;
+
+        case slang::TypeReflection::Kind::Matrix:
+            record.rowCount = typeLayout->getRowCount();
+            record.columnCount = typeLayout->getColumnCount();
+            record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+            break;
+
+        case slang::TypeReflection::Kind::ConstantBuffer:
+        case slang::TypeReflection::Kind::ParameterBlock:
+        case slang::TypeReflection::Kind::TextureBuffer:
+        case slang::TypeReflection::Kind::ShaderStorageBuffer:
+        case slang::TypeReflection::Kind::OutputStream:
+            record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+            record.elementVarLayout = addVarLayout(typeLayout->getElementVarLayout());
+            break;
+
+        case slang::TypeReflection::Kind::Resource:
+            {
+                // Only structured buffers have a layout for their element type.
+                const auto baseShape = record.resourceShape & SLANG_RESOURCE_BASE_SHAPE_MASK;
+                if (baseShape == SLANG_STRUCTURED_BUFFER)
+                    record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+            }
+            break;
+
+        default:
+            // As in the JSON, pointers don't record the layout of what they point to, because
+            // it can lead back to the pointer.
+            break;
+        }
+
+        m_typeLayouts[index] = record;
+        return index;
+    }
+
+    void addEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        SlangReflectionBinaryEntryPoint record = {};
+        record.name = addString(entryPoint->getName());
+        record.stage = uint32_t(entryPoint->getStage());
+
+        record.parameterCount = entryPoint->getParameterCount();
+        record.firstParameter = reserveVarLayouts(record.parameterCount);
+        for (unsigned i = 0; i < record.parameterCount; ++i)
+            writeVarLayout(record.firstParameter + i, entryPoint->getParameterByIndex(i));
+
+        if (entryPoint->getStage() == SLANG_STAGE_COMPUTE)
+        {
+            SlangUInt threadGroupSize[3] = {};
+            entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+            for (int i = 0; i < 3; ++i)
+                record.threadGroupSize[i] = uint32_t(threadGroupSize[i]);
+        }
+
+        record.resultVarLayout = addVarLayout(entryPoint->getResultVarLayout());
+        m_entryPoints.add(record);
+    }
+
+    SlangResult write(slang::ShaderReflection* reflection, ISlangBlob** outBlob)
+    {
+        SlangReflectionBinaryHeader header = {};
+        header.version = SLANG_REFLECTION_BINARY_VERSION;
+        header.bindlessSpaceIndex = int32_t(reflection->getBindlessSpaceIndex());
+
+        header.parameterCount = reflection->getParameterCount();
+        header.firstParameter = reserveVarLayouts(header.parameterCount);
+        for (unsigned i = 0; i < header.parameterCount; ++i)
+            writeVarLayout(header.firstParameter + i, reflection->getParameterByIndex(i));
+
+        const auto entryPointCount = reflection->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+            addEntryPoint(reflection->getEntryPointByIndex(i));
+
+        // The tables follow the header, with the strings last because their size needn't be
+        // a multiple of 4.
+        uint32_t offset = uint32_t(sizeof(header));
+        auto placeTable = [&](uint32_t& outOffset, uint32_t& outCount, Count count, size_t size)
+        {
+            outOffset = offset;
+            outCount = uint32_t(count);
+            offset += uint32_t(count * size);
+        };
+        placeTable(
+            header.typeLayoutsOffset,
+            header.typeLayoutCount,
+            m_typeLayouts.getCount(),
+            sizeof(SlangReflectionBinaryTypeLayout));
+        placeTable(
+            header.varLayoutsOffset,
+            header.varLayoutCount,
+            m_varLayouts.getCount(),
+            sizeof(SlangReflectionBinaryVarLayout));
+        placeTable(
+            header.bindingsOffset,
+            header.bindingCount,
+            m_bindings.getCount(),
+            sizeof(SlangReflectionBinaryBinding));
+        placeTable(
+            header.sizesOffset,
+            header.sizeCount,
+            m_sizes.getCount(),
+            sizeof(SlangReflectionBinarySize));
+        placeTable(
+            header.entryPointsOffset,
+            header.entryPointCount,
+            m_entryPoints.getCount(),
+            sizeof(SlangReflectionBinaryEntryPoint));
+        placeTable(header.stringsOffset, header.stringsSize, m_strings.getCount(), 1);
+
+        RIFF::Builder riff;
+        RIFF::BuildCursor cursor(riff);
+        {
+            SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kReflectionBinaryFourCC);
+            SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, kReflectionBinaryDataFourCC);
+
+            cursor.addData(header);
+            _addTable(cursor, m_typeLayouts);
+            _addTable(cursor, m_varLayouts);
+            _addTable(cursor, m_bindings);
+            _addTable(cursor, m_sizes);
+            _addTable(cursor, m_entryPoints);
+            _addTable(cursor, m_strings);
+        }
+        return riff.writeToBlob(outBlob);
+    }
+
+    template<typename T>
+    static void _addTable(RIFF::BuildCursor& cursor, const List<T>& table)
+    {
+        if (table.getCount())
+            cursor.addData(table.getBuffer(), table.getCount() * sizeof(T));
+    }
+
+    List<char> m_strings;
+    Dictionary<String, uint32_t> m_stringOffsets;
+
+    List<SlangReflectionBinaryTypeLayout> m_typeLayouts;
+    Dictionary<slang::TypeLayoutReflection*, uint32_t> m_typeLayoutIndices;
+
+    List<SlangReflectionBinaryVarLayout> m_varLayouts;
+    List<SlangReflectionBinaryBinding> m_bindings;
+    List<SlangReflectionBinarySize> m_sizes;
+    List<SlangReflectionBinaryEntryPoint> m_entryPoints;
+};
+
+} // namespace
+
+SlangResult writeReflectionBinary(slang::ShaderReflection* reflection, ISlangBlob** outBlob)
+{
+    ReflectionBinaryWriter writer;
+    return writer.write(reflection, outBlob);
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        using namespace Slang;
+        if (!reflection || !outBlob)
+            return SLANG_E_INVALID_ARG;
+        return writeReflectionBinary((slang::ShaderReflection*)reflection, outBlob);
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef SLANG_REFLECTION_BINARY_WRITER_H
+#define SLANG_REFLECTION_BINARY_WRITER_H
+
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Write `reflection` in the binary format read by `include/slang-reflection-binary.h`.
+SlangResult writeReflectionBinary(slang::ShaderReflection* reflection, ISlangBlob** outBlob);
+
+} // namespace Slang
+
+#endif
@@ -0,0 +1,110 @@
+// slang-sequential-id-map.cpp
+#include "slang-sequential-id-map.h"
+
+#include <atomic>
+
+namespace Slang
+{
+
+// The IDs that the current thread has looked up, from the map identified by `mapUniqueID`.
+// A thread usually works with a single `Linkage` at a time, so the cache only holds the IDs
+// of one map, and starts over when a different map is used.
+struct SequentialIDThreadCache
+{
+    uint64_t mapUniqueID = 0;
+    Dictionary<String, uint32_t> ids;
+};
+
+static thread_local SequentialIDThreadCache tl_sequentialIDCache;
+
+SequentialIDMap::SequentialIDMap()
+{
+    static std::atomic<uint64_t> nextUniqueID = 0;
+    m_uniqueID = nextUniqueID.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+Index SequentialIDMap::_getShardIndex(UnownedStringSlice name)
+{
+    return Index(name.getHashCode() % kShardCount);
+}
+
+void SequentialIDMap::_cacheID(String const& witnessName, uint32_t id)
+{
+    auto& cache = tl_sequentialIDCache;
+    if (cache.mapUniqueID != m_uniqueID)
+    {
+        cache.ids.clear();
+        cache.mapUniqueID = m_uniqueID;
+    }
+    cache.ids[witnessName] = id;
+}
+
+bool SequentialIDMap::tryGetID(UnownedStringSlice witnessName, uint32_t& outID)
+{
+    auto& cache = tl_sequentialIDCache;
+    String name(witnessName);
+    if (cache.mapUniqueID == m_uniqueID && cache.ids.tryGetValue(name, outID))
+        return true;
+
+    auto& shard = m_idShards[_getShardIndex(witnessName)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.map.tryGetValue(name, outID))
+            return false;
+    }
+    _cacheID(name, outID);
+    return true;
+}
+
+uint32_t SequentialIDMap::_allocateID(UnownedStringSlice interfaceName)
+{
+    auto& shard = m_counterShards[_getShardIndex(interfaceName)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& counter = shard.map.getOrAddValue(String(interfaceName), 0);
+    return counter++;
+}
+
+uint32_t SequentialIDMap::getOrAllocateID(
+    UnownedStringSlice witnessName,
+    UnownedStringSlice interfaceName)
+{
+    uint32_t id = 0;
+    if (tryGetID(witnessName, id))
+        return id;
+
+    String name(witnessName);
+    auto& shard = m_idShards[_getShardIndex(witnessName)];
+    {
+        // Another thread may have given the witness table an ID since the lookup above, so
+        // check again while holding the lock that guards assigning it.
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.map.tryGetValue(name, id))
+        {
+            id = _allocateID(interfaceName);
+            shard.map.add(name, id);
+        }
+    }
+    _cacheID(name, id);
+    return id;
+}
+
+uint32_t SequentialIDMap::getOrAssignID(UnownedStringSlice witnessName, uint32_t id)
+{
+    uint32_t existingID = 0;
+    if (tryGetID(witnessName, existingID))
+        return existingID;
+
+    String name(witnessName);
+    auto& shard = m_idShards[_getShardIndex(witnessName)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.map.tryGetValue(name, existingID))
+            id = existingID;
+        else
+            shard.map.add(name, id);
+    }
+    _cacheID(name, id);
+    return id;
+}
+
+} // namespace Slang
@@ -0,0 +1,64 @@
+// slang-sequential-id-map.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+/// The sequential IDs that `switch`-based dynamic dispatch uses for witness tables, shared by
+/// all of the programs compiled in a `Linkage`.
+///
+/// Each witness table, named by its mangled name, is given the next unused ID of the interface
+/// it conforms to, and keeps that ID for the lifetime of the map. Lookups are made while
+/// lowering every program that uses dynamic dispatch, so the map is split into shards that are
+/// locked separately, and each thread remembers the IDs it has already looked up. An ID never
+/// changes once it is assigned, so those remembered IDs never go stale.
+///
+class SequentialIDMap
+{
+public:
+    SequentialIDMap();
+
+    /// Get the ID of the witness table `witnessName` if it has one.
+    bool tryGetID(UnownedStringSlice witnessName, uint32_t& outID);
+
+    /// Get the ID of the witness table `witnessName`, giving it the next unused ID of the
+    /// interface `interfaceName` if it doesn't have one yet.
+    uint32_t getOrAllocateID(UnownedStringSlice witnessName, UnownedStringSlice interfaceName);
+
+    /// Get the ID of the witness table `witnessName`, giving it `id` if it doesn't have one yet.
+    uint32_t getOrAssignID(UnownedStringSlice witnessName, uint32_t id);
+
+private:
+    static const Index kShardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        Dictionary<String, uint32_t> map;
+    };
+
+    static Index _getShardIndex(UnownedStringSlice name);
+
+    /// Remember `id` for `witnessName` in the cache of the current thread.
+    void _cacheID(String const& witnessName, uint32_t id);
+
+    /// Allocate the next ID of `interfaceName`.
+    uint32_t _allocateID(UnownedStringSlice interfaceName);
+
+    // Tells the maps apart in the caches of each thread, which outlive any single map.
+    uint64_t m_uniqueID;
+
+    // The ID of each witness table, sharded by the witness table name.
+    Shard m_idShards[kShardCount];
+
+    // The next unused ID of each interface, sharded by the interface name. A lock on one of
+    // these is only ever taken while holding a lock on one of `m_idShards`, never the other
+    // way around.
+    Shard m_counterShards[kShardCount];
+};
+
+} // namespace Slang
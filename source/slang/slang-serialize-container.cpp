@@ -24,6 +24,10 @@ private:
     StringSlicePool _containerStringPool;
     RefPtr<SerialSourceLocWriter> _sourceLocWriter;
 
+    // If set, strings are written to `_containerStringPool`, and
+    // chunks just refer to them.
+    bool _useContainerStrings = false;
+
     RIFF::Builder _riff;
     RIFF::BuildCursor _cursor;
 
@@ -53,17 +57,38 @@ public:
         // is simply a matter of encoding the module for each
         // of the translation units that got compiled.
         //
+        // The modules are indexed by name, so that a reader looking
+        // for one module doesn't have to walk all of those before it.
+        //
         SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(_cursor, SerialBinary::kModuleListFourCc);
+        auto indexChunk = _cursor.addDataChunk(RIFF::ChunkIndex::kType);
+        List<RIFF::ChunkIndex::Child> indexedModules;
         for (TranslationUnitRequest* translationUnit : frontEndReq->translationUnits)
         {
-            SLANG_RETURN_ON_FAIL(encode(translationUnit->module));
+            auto module = translationUnit->module;
+            SLANG_RETURN_ON_FAIL(encode(module));
+            indexedModules.add(_getIndexedChild(module->getNameObj()->text.getUnownedSlice()));
         }
+        RIFF::ChunkIndex::write(indexChunk, indexedModules.getArrayView());
         return SLANG_OK;
     }
 
+    /// Get an index entry for the chunk that was most recently added to the current list.
+    RIFF::ChunkIndex::Child _getIndexedChild(UnownedStringSlice const& name)
+    {
+        auto list = as<RIFF::ListChunkBuilder>(_cursor.getCurrentChunk());
+        SLANG_ASSERT(list);
+
+        RIFF::ChunkIndex::Child child;
+        child.chunk = list->getChildren().getLast();
+        child.nameHash = RIFF::ChunkIndex::getNameHash(name);
+        return child;
+    }
+
     SlangResult encode(FrontEndCompileRequest* frontEndReq)
     {
         SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(_cursor, SerialBinary::kContainerFourCc);
+        _useContainerStrings = true;
         SLANG_RETURN_ON_FAIL(encodeModuleList(frontEndReq));
         return SLANG_OK;
     }
@@ -72,6 +97,12 @@ public:
     {
         SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(_cursor, SerialBinary::kContainerFourCc);
 
+        // The modules and entry points in a container share a lot of
+        // names and file paths, which are stored once in the container's
+        // string table.
+        //
+        _useContainerStrings = true;
+
         // Encoding an end-to-end compile request starts with the same
         // work as for a front-end request: we encode each of
         // the modules for the translation units.
@@ -113,6 +144,8 @@ public:
         //
         {
             SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(_cursor, SerialBinary::kEntryPointListFourCc);
+            auto indexChunk = _cursor.addDataChunk(RIFF::ChunkIndex::kType);
+            List<RIFF::ChunkIndex::Child> indexedEntryPoints;
 
             auto entryPointCount = program->getEntryPointCount();
             for (Index ii = 0; ii < entryPointCount; ++ii)
@@ -120,7 +153,9 @@ public:
                 auto entryPoint = program->getEntryPoint(ii);
                 auto entryPointMangledName = program->getEntryPointMangledName(ii);
                 encode(entryPoint, entryPointMangledName);
+                indexedEntryPoints.add(_getIndexedChild(entryPointMangledName.getUnownedSlice()));
             }
+            RIFF::ChunkIndex::write(indexChunk, indexedEntryPoints.getArrayView());
         }
 
         return SLANG_OK;
@@ -152,6 +187,14 @@ public:
 
     void encode(String const& value, FourCC type = SerialBinary::kStringFourCC)
     {
+        if (_useContainerStrings)
+        {
+            SerialBinary::StringRef stringRef;
+            stringRef.type = type;
+            stringRef.index = uint32_t(_containerStringPool.add(value));
+            encodeData(&stringRef, sizeof(stringRef), SerialBinary::kStringRefFourCc);
+            return;
+        }
         encodeData(value.getBuffer(), value.getLength(), type);
     }
 
@@ -413,9 +456,67 @@ public:
     return SLANG_OK;
 }
 
-String StringChunk::getValue() const
+ContainerStringTable::ContainerStringTable(RIFF::ListChunk const* containerChunk)
+{
+    if (!containerChunk)
+        return;
+
+    auto tableChunk = containerChunk->findDataChunk(SerialBinary::kStringTableFourCc);
+    if (!tableChunk)
+        return;
+
+    // The indices in the table match the handles of the `StringSlicePool`
+    // it was written from.
+    //
+    SerialStringTableUtil::decodeStringTable(
+        (char const*)tableChunk->getPayload(),
+        tableChunk->getPayloadSize(),
+        _strings);
+}
+
+SlangResult ContainerStringTable::getString(uint32_t index, UnownedStringSlice& outString) const
+{
+    if (Index(index) >= _strings.getCount())
+        return SLANG_FAIL;
+    outString = _strings[Index(index)];
+    return SLANG_OK;
+}
+
+String StringChunk::getValue(ContainerStringTable const* strings) const
+{
+    if (getType() != SerialBinary::kStringRefFourCc)
+        return String(UnownedStringSlice((char const*)getPayload(), getPayloadSize()));
+
+    UnownedStringSlice value;
+    if (!strings ||
+        SLANG_FAILED(
+            strings->getString(readPayloadAs<SerialBinary::StringRef>().index, value)))
+    {
+        SLANG_UNEXPECTED("string reference without a matching container string table");
+    }
+    return String(value);
+}
+
+StringChunk const* StringChunk::find(RIFF::ListChunk const* parent, FourCC::RawValue type)
 {
-    return String(UnownedStringSlice((char const*)getPayload(), getPayloadSize()));
+    for (auto chunk : parent->getChildren())
+    {
+        auto dataChunk = as<RIFF::DataChunk>(chunk);
+        if (!dataChunk)
+            continue;
+
+        if (dataChunk->getType() == SerialBinary::kStringRefFourCc)
+        {
+            if (dataChunk->readPayloadAs<SerialBinary::StringRef>().type != type)
+                continue;
+        }
+        else if (dataChunk->getType() != type)
+        {
+            continue;
+        }
+        return static_cast<StringChunk const*>(dataChunk);
+    }
+    return nullptr;
 }
 
 RIFF::ChunkList<StringChunk> ModuleChunk::getFileDependencies() const
@@ -442,14 +543,14 @@ SHA1::Digest ModuleChunk::getDigest() const
     return foundChunk->readPayloadAs<SHA1::Digest>();
 }
 
-String ModuleChunk::getName() const
+String ModuleChunk::getName(ContainerStringTable const* strings) const
 {
-    auto found = findDataChunk(SerialBinary::kNameFourCC);
+    auto found = StringChunk::find(this, SerialBinary::kNameFourCC);
     if (!found)
     {
         SLANG_UNEXPECTED("module chunk had no name");
     }
-    return static_cast<StringChunk const*>(found)->getValue();
+    return found->getValue(strings);
 }
 
 
@@ -482,7 +583,7 @@ RIFF::ChunkList<ModuleChunk> ContainerChunk::getModules() const
     auto found = findListChunk(SerialBinary::kModuleListFourCc);
     if (!found)
         return RIFF::ChunkList<ModuleChunk>();
-    return found->getChildren().cast<ModuleChunk>();
+    return RIFF::ChunkIndex::getChildren(found).cast<ModuleChunk>();
 }
 
 RIFF::ChunkList<EntryPointChunk> ContainerChunk::getEntryPoints() const
@@ -490,27 +591,92 @@ RIFF::ChunkList<EntryPointChunk> ContainerChunk::getEntryPoints() const
     auto found = findListChunk(SerialBinary::kEntryPointListFourCc);
     if (!found)
         return RIFF::ChunkList<EntryPointChunk>();
-    return found->getChildren().cast<EntryPointChunk>();
+    return RIFF::ChunkIndex::getChildren(found).cast<EntryPointChunk>();
+}
+
+ModuleChunk const* ContainerChunk::findModule(UnownedStringSlice const& name) const
+{
+    auto found = findListChunk(SerialBinary::kModuleListFourCc);
+    if (!found)
+        return nullptr;
+
+    ContainerStringTable strings(this);
+
+    // Containers written before lists were indexed have no index,
+    // and have to be searched in order.
+    //
+    if (!RIFF::ChunkIndex::getEntries(found).getCount())
+    {
+        for (auto moduleChunk : getModules())
+        {
+            if (moduleChunk->getName(&strings) == name)
+                return moduleChunk;
+        }
+        return nullptr;
+    }
+
+    for (auto const& entry : RIFF::ChunkIndex::findEntries(
+             found,
+             SerialBinary::kModuleFourCC,
+             RIFF::ChunkIndex::getNameHash(name)))
+    {
+        auto moduleChunk =
+            static_cast<ModuleChunk const*>(RIFF::ChunkIndex::getChild(found, entry));
+        if (moduleChunk && moduleChunk->getName(&strings) == name)
+            return moduleChunk;
+    }
+    return nullptr;
+}
+
+EntryPointChunk const* ContainerChunk::findEntryPoint(UnownedStringSlice const& mangledName) const
+{
+    auto found = findListChunk(SerialBinary::kEntryPointListFourCc);
+    if (!found)
+        return nullptr;
+
+    ContainerStringTable strings(this);
+
+    if (!RIFF::ChunkIndex::getEntries(found).getCount())
+    {
+        for (auto entryPointChunk : getEntryPoints())
+        {
+            if (entryPointChunk->getMangledName(&strings) == mangledName)
+                return entryPointChunk;
+        }
+        return nullptr;
+    }
+
+    for (auto const& entry : RIFF::ChunkIndex::findEntries(
+             found,
+             SerialBinary::kEntryPointFourCc,
+             RIFF::ChunkIndex::getNameHash(mangledName)))
+    {
+        auto entryPointChunk =
+            static_cast<EntryPointChunk const*>(RIFF::ChunkIndex::getChild(found, entry));
+        if (entryPointChunk && entryPointChunk->getMangledName(&strings) == mangledName)
+            return entryPointChunk;
+    }
+    return nullptr;
 }
 
-String EntryPointChunk::getMangledName() const
+String EntryPointChunk::getMangledName(ContainerStringTable const* strings) const
 {
-    auto found = findDataChunk(SerialBinary::kMangledNameFourCC);
+    auto found = StringChunk::find(this, SerialBinary::kMangledNameFourCC);
     if (!found)
     {
         SLANG_UNEXPECTED("entry point chunk had no mangled name");
     }
-    return static_cast<StringChunk const*>(found)->getValue();
+    return found->getValue(strings);
 }
 
-String EntryPointChunk::getName() const
+String EntryPointChunk::getName(ContainerStringTable const* strings) const
 {
-    auto found = findDataChunk(SerialBinary::kNameFourCC);
+    auto found = StringChunk::find(this, SerialBinary::kNameFourCC);
     if (!found)
     {
         SLANG_UNEXPECTED("entry point chunk had no name");
     }
-    return static_cast<StringChunk const*>(found)->getValue();
+    return found->getValue(strings);
 }
 
 Profile EntryPointChunk::getProfile() const
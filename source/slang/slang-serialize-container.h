@@ -62,10 +62,45 @@ struct SerialContainerUtil
     static SlangResult write(Module* module, const WriteOptions& options, Stream* stream);
 };
 
+/// The strings shared by the modules and entry points of a container.
+///
+/// When a container is written, the names and file paths of its modules
+/// and entry points are stored once, in the container string table, and
+/// the chunks that use them hold a `SerialBinary::StringRef` instead.
+///
+struct ContainerStringTable
+{
+public:
+    ContainerStringTable() {}
+
+    /// Read the string table of `containerChunk`, if it has one.
+    ///
+    /// `containerChunk` can be null, for a module that isn't in a container.
+    ///
+    explicit ContainerStringTable(RIFF::ListChunk const* containerChunk);
+
+    /// Get the string at `index`, or fail if there is no such string.
+    SlangResult getString(uint32_t index, UnownedStringSlice& outString) const;
+
+private:
+    List<UnownedStringSlice> _strings;
+};
+
+/// A chunk that either holds a string, or is a reference to one
+/// in a `ContainerStringTable`.
+///
 struct StringChunk : RIFF::DataChunk
 {
 public:
-    String getValue() const;
+    /// Get the string value of this chunk.
+    ///
+    /// `strings` must be the string table of the enclosing container if
+    /// this chunk is a reference.
+    ///
+    String getValue(ContainerStringTable const* strings = nullptr) const;
+
+    /// Find a child of `parent` holding, or referring to, a string of the given `type`.
+    static StringChunk const* find(RIFF::ListChunk const* parent, FourCC::RawValue type);
 };
 
 struct IRModuleChunk : RIFF::ListChunk
@@ -81,7 +116,7 @@ struct ModuleChunk : RIFF::ListChunk
 public:
     static ModuleChunk const* find(RIFF::ListChunk const* baseChunk);
 
-    String getName() const;
+    String getName(ContainerStringTable const* strings = nullptr) const;
 
     IRModuleChunk const* findIR() const;
     ASTModuleChunk const* findAST() const;
@@ -94,8 +129,8 @@ public:
 struct EntryPointChunk : RIFF::ListChunk
 {
 public:
-    String getMangledName() const;
-    String getName() const;
+    String getMangledName(ContainerStringTable const* strings = nullptr) const;
+    String getName(ContainerStringTable const* strings = nullptr) const;
     Profile getProfile() const;
 };
 
@@ -107,6 +142,13 @@ public:
     RIFF::ChunkList<ModuleChunk> getModules() const;
 
     RIFF::ChunkList<EntryPointChunk> getEntryPoints() const;
+
+    /// Find the module called `name`, using the index of the module list if there is one.
+    ModuleChunk const* findModule(UnownedStringSlice const& name) const;
+
+    /// Find the entry point with `mangledName`, using the index of the entry point list if
+    /// there is one.
+    EntryPointChunk const* findEntryPoint(UnownedStringSlice const& mangledName) const;
 };
 
 struct DebugChunk : RIFF::ListChunk
@@ -1307,7 +1307,7 @@ void SerialReader::handleSharedPtr(void*& value, SerializerCallback callback, vo
     // At this point we are reading a reference to an
     // object index that has not yet been read at all.
     //
-    auto objectInfo = RefPtr(new ObjectInfo());
+    auto objectInfo = new (_context._objectInfoArena) ObjectInfo();
     _context.mapFossilizedObjectPtrToObjectInfo.add(targetValPtr.get(), objectInfo);
 
     objectInfo->fossilizedObjectPtr = targetValPtr;
@@ -776,7 +776,11 @@ private:
         ReadingInProgress,
         ReadingComplete,
     };
-    struct ObjectInfo : public RefObject
+    // The records are allocated from an arena owned by the
+    // `ReadContext`, since one is created for every object
+    // that gets read and they all live as long as the context.
+    //
+    struct ObjectInfo
     {
         ObjectState state = ObjectState::Unread;
 
@@ -855,12 +859,16 @@ public:
     struct ReadContext
     {
     public:
-        ReadContext() = default;
+        ReadContext()
+            : _objectInfoArena(4096)
+        {
+        }
 
     private:
         friend struct SerialReader;
 
-        Dictionary<void*, RefPtr<ObjectInfo>> mapFossilizedObjectPtrToObjectInfo;
+        MemoryArena _objectInfoArena;
+        Dictionary<void*, ObjectInfo*> mapFossilizedObjectPtrToObjectInfo;
         List<DeferredAction> _deferredActions;
 
         Count _readerCount = 0;
@@ -5,6 +5,7 @@
 #include "core/slang-common.h"
 #include "core/slang-dictionary.h"
 #include "core/slang-performance-profiler.h"
+#include "slang-com-ptr.h"
 #include "slang-ir-insts-stable-names.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-validate.h"
@@ -15,16 +16,14 @@
 #include "slang-tag-version.h"
 #include "slang.h"
 
+#include <mutex>
+
 //
 #include "slang-serialize-ir.cpp.fiddle"
 
 // If USE_RIFF is set, then we serialize using the RIFF backend, it's the
 // slowest option
 #define USE_RIFF 0
-// If we are serializing using Fossil, DIRECT_FROM_FOSSIL will make it so that
-// we unflatten directly from the fossilized representation rather than
-// deserializing everything first. It is the fastest option
-#define DIRECT_FROM_FOSSIL 0
 
 FIDDLE()
 namespace Slang
@@ -48,7 +47,9 @@ struct IRModuleInfo
     // IRModuleInst or IRConstants.
     // If we want to support back compat we'll need to change this to a list of
     // accepted values, and branch on that later down.
-    const static UInt64 kSupportedSerializationVersion = 1;
+    //
+    // Version 2 stores source locations as runs of instructions, see `FlatInstTable`.
+    const static UInt64 kSupportedSerializationVersion = 2;
     FIDDLE() UInt64 serializationVersion = kSupportedSerializationVersion;
     // Include the specific compiler version in serialized output, in case we
     // ever need to do any version specific workarounds.
@@ -97,7 +98,13 @@ struct FlatInstTable
     // The instAllocInfo list is all that's necessary to allocate an instruction
     FIDDLE() List<InstAllocInfo> instAllocInfo;
     FIDDLE() List<Int64> childCounts;
-    FIDDLE() List<SourceLoc> sourceLocs;
+
+    // Neighbouring instructions usually have the same source location, so the
+    // locations are stored as runs of instructions that share one, as written
+    // by `SerialSourceLocRunWriter`. These are the same length, the number of
+    // runs.
+    FIDDLE() List<uint32_t> sourceLocRunLocs;
+    FIDDLE() List<uint32_t> sourceLocRunLengths;
 
     // The length of operandIndices is the number of instructions in the module
     // (for typeUse) + the number of operands in the module
@@ -144,14 +151,20 @@ struct FlatInstTable
             (size_t)table.childCounts.getCount(),
             (size_t)instCount);
     }
-    if (table.sourceLocs.getCount() != instCount)
+    Int64 sourceLocCount = 0;
+    for (auto runLength : table.sourceLocRunLengths)
+    {
+        sourceLocCount += runLength;
+    }
+    if (sourceLocCount != instCount)
     {
         fprintf(
             stderr,
-            "WARNING: sourceLocs size (%zu) != instruction count (%zu)\n",
-            (size_t)table.sourceLocs.getCount(),
+            "WARNING: sourceLoc run total (%zu) != instruction count (%zu)\n",
+            (size_t)sourceLocCount,
             (size_t)instCount);
     }
+    fprintf(stderr, "Source location runs: %zu\n", (size_t)table.sourceLocRunLengths.getCount());
 
     // Count string/blob instructions
     Int64 stringBlobInstCount = 0;
@@ -245,7 +258,8 @@ struct FlatInstTable
     size_t totalMemory = 0;
     totalMemory += table.instAllocInfo.getCount() * sizeof(InstAllocInfo);
     totalMemory += table.childCounts.getCount() * sizeof(Int64);
-    totalMemory += table.sourceLocs.getCount() * sizeof(SourceLoc);
+    totalMemory += table.sourceLocRunLocs.getCount() * sizeof(uint32_t);
+    totalMemory += table.sourceLocRunLengths.getCount() * sizeof(uint32_t);
     totalMemory += table.operandIndices.getCount() * sizeof(Int64);
     totalMemory += table.stringLengths.getCount() * sizeof(Int64);
     totalMemory += table.stringChars.getCount() * sizeof(uint8_t);
@@ -312,6 +326,13 @@ struct IRSerialReadContext : SourceLocSerialContext, RefObject
 
     //
     bool _foundUnrecognizedInstructions = false;
+
+    // Whether function bodies are read in up front or when needed
+    IRBodyLoading _bodyLoading = IRBodyLoading::Eager;
+
+    // The blob the serialized module is in, if it can be kept alive to read
+    // bodies from later
+    ComPtr<ISlangBlob> _blobHoldingSerializedData;
 };
 
 SLANG_DECLARE_FOSSILIZED_AS(Name, String);
@@ -470,6 +491,10 @@ static void serializeAsFlatModule(const IRWriteSerializer& serializer, IRModuleI
     Dictionary<IRInst*, Int64> instMap;
     instMap.add(nullptr, -1);
     List<IRInst*> insts;
+    SerialSourceLocRunWriter sourceLocRunWriter(
+        serializer.getContext()->getSourceLocWriter(),
+        flat.sourceLocRunLocs,
+        flat.sourceLocRunLengths);
 
     traverseInstsInSerializationOrder(
         moduleInst,
@@ -483,8 +508,8 @@ static void serializeAsFlatModule(const IRWriteSerializer& serializer, IRModuleI
                 .operandCount = inst->operandCount,
             });
             flat.childCounts.add(0);
-            flat.sourceLocs.add(inst->sourceLoc);
-            inst->scratchData = thisInstIndex; // Store index for child counting
+            sourceLocRunWriter.add(inst->sourceLoc);
+            inst->scratchData = uint32_t(thisInstIndex); // Store index for child counting
 
             // Update parent's child count
             if (inst->parent)
@@ -546,148 +571,554 @@ static T deserialize1(const IRReadSerializer& serializer, const Fossil::AnyValRe
     return t;
 }
 
-static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serializer, IRModule* module)
+//
+// Instructions are read out of a flat table in two steps. First all of the
+// instructions are allocated, and then their operands, payloads and children
+// are filled in, walking the table in the same preorder it was written in.
+//
+// When bodies are loaded on demand, both steps skip over the ranges of the
+// table holding the children (other than decorations) of global values with
+// code. Reading in one of those bodies later is then just the same two steps
+// run over that range.
+//
+// The table can either be a deserialized `FlatInstTable`, or the
+// `Fossilized<FlatInstTable>` read in place from the serialized data, in
+// which case none of the table needs to be copied out before instructions
+// are made from it.
+//
+struct FlatInstReaderBase
 {
-    IRSerialReadContext& readContext = *serializer.getContext();
-#if DIRECT_FROM_FOSSIL
-    const auto flatPtr = as<Fossilized<FlatInstTable>>(serializer.getImpl()->readValPtr());
-    Fossilized<FlatInstTable>& flat = flatPtr->getDataRef();
-    // Read just the sourceLocs using normal deserialization
-    const auto sourceLocs = deserialize1<List<SourceLoc>>(serializer, flatPtr->getSourceLocs());
-#else
-    FlatInstTable flat;
-    serialize(serializer, flat);
-    const List<SourceLoc>& sourceLocs = flat.sourceLocs;
-    // dumpFlatInstTableStats(flat, "deserializing");
-#endif
+    /// A position in each of the streams that make up the table
+    struct Cursor
+    {
+        Int64 instIndex = 0;
+        Int64 operandIndex = 0;
+        Int64 literalIndex = 0;
+        Int64 stringLengthIndex = 0;
+        Int64 stringDataIndex = 0;
+    };
 
-    Int64 stringLengthIndex = 0;
-    List<IRInst*> instsList;
+    /// The range of the table holding the body of a global value
+    struct DeferredBody
+    {
+        /// The index of the global value
+        Int64 parentIndex = 0;
+        /// The number of children of the global value in the range
+        Int64 childCount = 0;
+        Cursor begin;
+        Cursor end;
+        /// True until the body is read in
+        bool isDeferred = true;
+    };
 
-#if DIRECT_FROM_FOSSIL
-    const auto numInsts = flat.instAllocInfo.getElementCount();
-#else
-    const auto numInsts = flat.instAllocInfo.getCount();
-#endif
+    static Index _findBodyContaining(const List<DeferredBody>& bodies, Int64 instIndex)
+    {
+        // Bodies are in order, so find the last one starting at or before the instruction
+        Index lo = 0;
+        Index hi = bodies.getCount();
+        while (lo < hi)
+        {
+            const Index mid = (lo + hi) / 2;
+            if (bodies[mid].begin.instIndex <= instIndex)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == 0 || instIndex >= bodies[lo - 1].end.instIndex)
+            return -1;
+        return lo - 1;
+    }
 
-    instsList.setCount(numInsts + 1);
-    // nullptr instructions are represented as `-1`. We can save ourselves a
-    // branch by just making that index valid.
-    IRInst** const insts = &instsList[1];
-    insts[-1] = nullptr;
+    static Int64 _getCount(const List<InstAllocInfo>& infos) { return infos.getCount(); }
+    static Int64 _getCount(const Fossilized<List<InstAllocInfo>>& infos)
+    {
+        return infos.getElementCount();
+    }
 
-    for (Int64 instIndex = 0; instIndex < numInsts; ++instIndex)
+    static IROp _getOp(const InstAllocInfo& info) { return info.op; }
+    static IROp _getOp(const Fossilized<InstAllocInfo>& info)
     {
-        const auto& a = flat.instAllocInfo[instIndex];
         // The opcode is serialized as the stable name, so if we're reading
-        // directly we need to destabilize that
-#if DIRECT_FROM_FOSSIL
-        IROp op = getStableNameOpcode(a.op);
-#else
-        IROp op = a.op;
-#endif
-        if (op == kIROp_Invalid) [[unlikely]]
-        {
-            readContext._foundUnrecognizedInstructions = true;
-            op = kIROp_Unrecognized;
-        }
-        size_t minSizeInBytes = 0;
+        // in place we need to destabilize that
+        return getStableNameOpcode(info.op);
+    }
+};
+
+template<typename Table>
+struct FlatInstReader : FlatInstReaderBase
+{
+    FlatInstReader(
+        IRModule* module,
+        const Table& flat,
+        const List<SourceLoc>& sourceLocs,
+        IRInst** insts)
+        : m_module(module), m_flat(flat), m_sourceLocs(sourceLocs), m_insts(insts)
+    {
+    }
+
+    Int64 getInstCount() const { return _getCount(m_flat.instAllocInfo); }
+
+    IROp getOp(Int64 instIndex) const { return _getOp(m_flat.instAllocInfo[instIndex]); }
+
+    /// Move `cursor` past the instruction it is at, but not its children
+    void skipInst(Cursor& cursor) const
+    {
+        const IROp op = getOp(cursor.instIndex);
+        cursor.operandIndex += 1 + m_flat.instAllocInfo[cursor.instIndex].operandCount;
+        cursor.instIndex++;
         switch (op)
         {
-        [[unlikely]] case kIROp_ModuleInst:
-            minSizeInBytes = offsetof(IRModuleInst, module) +
-                             sizeof(IRModuleInst::module); // NOLINT(bugprone-sizeof-expression)
-            break;
         case kIROp_BoolLit:
         case kIROp_IntLit:
         case kIROp_FloatLit:
         case kIROp_PtrLit:
-        case kIROp_VoidLit:
-            minSizeInBytes = offsetof(IRConstant, value) + sizeof(IRConstant::value);
+            cursor.literalIndex++;
             break;
-        // About 5% of instructions in the core module are strings!
         case kIROp_StringLit:
         case kIROp_BlobLit:
-            minSizeInBytes = offsetof(IRConstant, value) +
-                             offsetof(IRConstant::StringValue, chars) +
-                             flat.stringLengths[stringLengthIndex++];
+            cursor.stringDataIndex += m_flat.stringLengths[cursor.stringLengthIndex++];
+            break;
+        default:
             break;
         }
-        insts[instIndex] = module->_allocateInst(op, a.operandCount, minSizeInBytes);
     }
 
-    Int64 litIndex = 0;
-    Int64 operandIndex = 0;
-    Int64 instIndex = 0;
-    stringLengthIndex = 0;
-    Int64 stringDataIndex = 0;
-    const auto go = [&](auto& go, IRInst* parent) -> IRInst*
+    /// Move `cursor` past the instruction it is at and all of its descendants
+    void skipTree(Cursor& cursor) const
+    {
+        const Int64 childCount = m_flat.childCounts[cursor.instIndex];
+        skipInst(cursor);
+        for (Int64 i = 0; i < childCount; ++i)
+            skipTree(cursor);
+    }
+
+    /// Find the bodies of the module's global values with code that can be left
+    /// out until they are needed.
+    void findDeferredBodies(List<DeferredBody>& outBodies)
+    {
+        List<DeferredBody> bodies;
+
+        Cursor cursor;
+        const Int64 moduleChildCount = m_flat.childCounts[0];
+        skipInst(cursor);
+        for (Int64 i = 0; i < moduleChildCount; ++i)
+        {
+            const auto globalIndex = cursor.instIndex;
+            if (!IRGlobalValueWithCode::isaImpl(getOp(globalIndex)))
+            {
+                skipTree(cursor);
+                continue;
+            }
+
+            const Int64 childCount = m_flat.childCounts[globalIndex];
+            skipInst(cursor);
+
+            // Decorations come first, and are always read in, as they are
+            // what's used to find a global value and decide if it's needed
+            Int64 decorationCount = 0;
+            while (decorationCount < childCount && IRDecoration::isaImpl(getOp(cursor.instIndex)))
+            {
+                skipTree(cursor);
+                decorationCount++;
+            }
+
+            DeferredBody body;
+            body.parentIndex = globalIndex;
+            body.childCount = childCount - decorationCount;
+            body.begin = cursor;
+            for (Int64 c = 0; c < body.childCount; ++c)
+            {
+                // A decoration following the body would be missed, so such
+                // a value is just read in up front
+                if (IRDecoration::isaImpl(getOp(cursor.instIndex)))
+                    body.isDeferred = false;
+                skipTree(cursor);
+            }
+            body.end = cursor;
+
+            if (body.childCount > 0 && body.isDeferred)
+                bodies.add(body);
+        }
+
+        // A body can only be left out if nothing outside of it refers to the
+        // instructions inside it.
+        Index containingBody = -1;
+        Index nextBody = 0;
+        Int64 operandIndex = 0;
+        const auto instCount = getInstCount();
+        for (Int64 instIndex = 0; instIndex < instCount; ++instIndex)
+        {
+            if (containingBody >= 0 && instIndex == bodies[containingBody].end.instIndex)
+                containingBody = -1;
+            if (nextBody < bodies.getCount() && instIndex == bodies[nextBody].begin.instIndex)
+                containingBody = nextBody++;
+
+            // Bodies that are read in later can't fail the load, so check
+            // for anything we don't recognize up front
+            if (getOp(instIndex) == kIROp_Invalid)
+                m_foundUnrecognizedInstructions = true;
+
+            const auto operandEnd =
+                operandIndex + 1 + m_flat.instAllocInfo[instIndex].operandCount;
+            for (; operandIndex < operandEnd; ++operandIndex)
+            {
+                const auto targetBody =
+                    _findBodyContaining(bodies, m_flat.operandIndices[operandIndex]);
+                if (targetBody >= 0 && targetBody != containingBody)
+                    bodies[targetBody].isDeferred = false;
+            }
+        }
+
+        for (const auto& body : bodies)
+        {
+            if (body.isDeferred)
+                outBodies.add(body);
+        }
+    }
+
+    /// Allocate the instructions from `cursor` up to `endInstIndex`, other than
+    /// those in any of the `bodiesToSkip`.
+    void allocateInsts(Cursor cursor, Int64 endInstIndex, ConstArrayView<DeferredBody> bodiesToSkip)
+    {
+        Index nextBody = 0;
+        Int64 stringLengthIndex = cursor.stringLengthIndex;
+        Int64 instIndex = cursor.instIndex;
+        while (instIndex < endInstIndex)
+        {
+            if (nextBody < bodiesToSkip.getCount() &&
+                instIndex == bodiesToSkip[nextBody].begin.instIndex)
+            {
+                stringLengthIndex = bodiesToSkip[nextBody].end.stringLengthIndex;
+                instIndex = bodiesToSkip[nextBody].end.instIndex;
+                nextBody++;
+                continue;
+            }
+
+            const auto& a = m_flat.instAllocInfo[instIndex];
+            IROp op = getOp(instIndex);
+            if (op == kIROp_Invalid) [[unlikely]]
+            {
+                m_foundUnrecognizedInstructions = true;
+                op = kIROp_Unrecognized;
+            }
+            size_t minSizeInBytes = 0;
+            switch (op)
+            {
+            [[unlikely]] case kIROp_ModuleInst:
+                minSizeInBytes = offsetof(IRModuleInst, module) +
+                                 sizeof(IRModuleInst::module); // NOLINT(bugprone-sizeof-expression)
+                break;
+            case kIROp_BoolLit:
+            case kIROp_IntLit:
+            case kIROp_FloatLit:
+            case kIROp_PtrLit:
+            case kIROp_VoidLit:
+                minSizeInBytes = offsetof(IRConstant, value) + sizeof(IRConstant::value);
+                break;
+            // About 5% of instructions in the core module are strings!
+            case kIROp_StringLit:
+            case kIROp_BlobLit:
+                minSizeInBytes = offsetof(IRConstant, value) +
+                                 offsetof(IRConstant::StringValue, chars) +
+                                 m_flat.stringLengths[stringLengthIndex++];
+                break;
+            }
+            m_insts[instIndex] = m_module->_allocateInst(op, a.operandCount, minSizeInBytes);
+            instIndex++;
+        }
+    }
+
+    /// Fill in the (allocated) instruction at `cursor`, and read in its children.
+    /// The children in any of `m_bodiesToSkip` are left out.
+    IRInst* readInst(Cursor& cursor, IRInst* parent)
     {
-        const auto thisInstIndex = instIndex++;
-        IRInst* inst = insts[thisInstIndex];
+        const auto thisInstIndex = cursor.instIndex++;
+        IRInst* inst = m_insts[thisInstIndex];
 
         // operands and sourcelocs
-        inst->sourceLoc = sourceLocs[thisInstIndex];
-        inst->typeUse.init(inst, insts[flat.operandIndices[operandIndex++]]);
+        inst->sourceLoc = m_sourceLocs[thisInstIndex];
+        inst->typeUse.init(inst, m_insts[m_flat.operandIndices[cursor.operandIndex++]]);
         for (Int64 o = 0; o < inst->operandCount; ++o)
-            inst->getOperands()[o].init(inst, insts[flat.operandIndices[operandIndex++]]);
+        {
+            inst->getOperands()[o].init(
+                inst,
+                m_insts[m_flat.operandIndices[cursor.operandIndex++]]);
+        }
 
         // Handle special instructions
         switch (inst->m_op)
         {
         [[unlikely]] case kIROp_ModuleInst:
-            cast<IRModuleInst>(inst)->module = module;
+            cast<IRModuleInst>(inst)->module = m_module;
             break;
         case kIROp_BoolLit:
         case kIROp_IntLit:
             cast<IRConstant>(inst)->value.intVal =
-                bitCast<IRIntegerValue>(flat.literals[litIndex++]);
+                bitCast<IRIntegerValue>(UInt64(m_flat.literals[cursor.literalIndex++]));
             break;
         case kIROp_FloatLit:
-            cast<IRConstant>(inst)->value.floatVal = bitCast<double>(flat.literals[litIndex++]);
+            cast<IRConstant>(inst)->value.floatVal =
+                bitCast<double>(UInt64(m_flat.literals[cursor.literalIndex++]));
             break;
         case kIROp_PtrLit:
             // Keep the compiler happy on 32 bit builds
-            cast<IRConstant>(inst)->value.ptrVal = (void*)(uintptr_t(flat.literals[litIndex++]));
+            cast<IRConstant>(inst)->value.ptrVal =
+                (void*)(uintptr_t(UInt64(m_flat.literals[cursor.literalIndex++])));
             break;
         case kIROp_StringLit:
         case kIROp_BlobLit:
             const auto c = cast<IRConstant>(inst);
-            const auto len = flat.stringLengths[stringLengthIndex++];
+            const Int64 len = m_flat.stringLengths[cursor.stringLengthIndex++];
             char* const dstChars = c->value.stringVal.chars;
             c->value.stringVal.numChars = uint32_t(len);
-            memcpy(dstChars, flat.stringChars.begin() + stringDataIndex, len);
-            stringDataIndex += len;
+            memcpy(dstChars, m_flat.stringChars.begin() + cursor.stringDataIndex, len);
+            cursor.stringDataIndex += len;
             break;
         }
 
-        // Read in children, and fix up pointers
         inst->parent = parent;
-        IRInst* prev = nullptr;
-        IRInst* first = nullptr;
-        IRInst* last = nullptr;
-        for (Int64 i = 0; i < flat.childCounts[thisInstIndex]; ++i)
+
+        // Read in children, leaving out the body if it's deferred
+        Int64 childCount = m_flat.childCounts[thisInstIndex];
+        const DeferredBody* skippedBody = nullptr;
+        if (m_nextBodyToSkip < m_bodiesToSkip.getCount() &&
+            m_bodiesToSkip[m_nextBodyToSkip].parentIndex == thisInstIndex)
+        {
+            skippedBody = &m_bodiesToSkip[m_nextBodyToSkip++];
+            childCount -= skippedBody->childCount;
+        }
+
+        readChildren(cursor, inst, childCount);
+
+        if (skippedBody)
+        {
+            SLANG_ASSERT(cursor.instIndex == skippedBody->begin.instIndex);
+            cursor = skippedBody->end;
+        }
+        return inst;
+    }
+
+    /// Read `childCount` instructions from `cursor`, appending them to the children of `parent`
+    void readChildren(Cursor& cursor, IRInst* parent, Int64 childCount)
+    {
+        IRInst* prev = parent->m_decorationsAndChildren.last;
+        for (Int64 i = 0; i < childCount; ++i)
         {
-            auto c = go(go, inst);
-            if (i == 0)
-                first = c;
-            last = c;
+            auto c = readInst(cursor, parent);
             c->prev = prev;
             if (prev)
                 prev->next = c;
+            else
+                parent->m_decorationsAndChildren.first = c;
             prev = c;
         }
-        if (last)
-            last->next = nullptr;
-        inst->m_decorationsAndChildren.first = first;
-        inst->m_decorationsAndChildren.last = last;
+        if (prev)
+            prev->next = nullptr;
+        parent->m_decorationsAndChildren.last = prev;
+    }
+
+    /// Read in a body that was previously skipped
+    void readBody(const DeferredBody& body)
+    {
+        allocateInsts(body.begin, body.end.instIndex, ConstArrayView<DeferredBody>());
+
+        Cursor cursor = body.begin;
+        readChildren(cursor, m_insts[body.parentIndex], body.childCount);
+        SLANG_ASSERT(cursor.instIndex == body.end.instIndex);
+    }
+
+    IRModule* m_module;
+    const Table& m_flat;
+    const List<SourceLoc>& m_sourceLocs;
+
+    /// Indexed by instruction index, where index `-1` is nullptr
+    IRInst** m_insts;
+
+    ConstArrayView<DeferredBody> m_bodiesToSkip;
+    Index m_nextBodyToSkip = 0;
+
+    bool m_foundUnrecognizedInstructions = false;
+};
+
+/// Holds on to the serialized data of a module read with `IRBodyLoading::OnDemand`,
+/// so that the bodies that were left out can be read in, in place, when needed.
+struct FlatInstDeferredBodyLoader : IRDeferredBodyLoader
+{
+    typedef FlatInstReader<Fossilized<FlatInstTable>> Reader;
+
+    FlatInstDeferredBodyLoader(
+        IRModule* module,
+        ISlangBlob* blobHoldingSerializedData,
+        Fossilized<FlatInstTable> const* flat)
+        : m_module(module), m_blobHoldingSerializedData(blobHoldingSerializedData), m_flat(flat)
+    {
+    }
+
+    void loadBody(IRInst* globalInst) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Index bodyIndex;
+        if (m_mapGlobalToBody.tryGetValue(globalInst, bodyIndex))
+            _loadBody(bodyIndex);
+    }
+
+    bool hasDeferredBody(IRInst* globalInst) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_mapGlobalToBody.containsKey(globalInst);
+    }
+
+    void loadAllBodies() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Index i = 0; i < m_bodies.getCount(); ++i)
+            _loadBody(i);
+    }
+
+    void setBodies(List<FlatInstReaderBase::DeferredBody>&& bodies)
+    {
+        m_bodies = _Move(bodies);
+        for (Index i = 0; i < m_bodies.getCount(); ++i)
+            m_mapGlobalToBody.add(getInsts()[m_bodies[i].parentIndex], i);
+    }
+
+    IRInst** getInsts() { return m_insts.getBuffer() + 1; }
+
+    void _loadBody(Index bodyIndex)
+    {
+        auto& body = m_bodies[bodyIndex];
+        if (!body.isDeferred)
+            return;
+        body.isDeferred = false;
+
+        Reader reader(m_module, *m_flat, m_sourceLocs, getInsts());
+        reader.readBody(body);
+        m_mapGlobalToBody.remove(getInsts()[body.parentIndex]);
+
+        // Once everything is read in the serialized data is no longer needed
+        if (m_mapGlobalToBody.getCount() == 0)
+        {
+            m_flat = nullptr;
+            m_blobHoldingSerializedData.setNull();
+            m_sourceLocs = List<SourceLoc>();
+            m_insts = List<IRInst*>();
+            m_bodies = List<FlatInstReaderBase::DeferredBody>();
+        }
+    }
+
+    // The module owns the loader, so this can't be a strong reference
+    IRModule* m_module;
+
+    /// Keeps `m_flat` valid
+    ComPtr<ISlangBlob> m_blobHoldingSerializedData;
+    /// The table, read in place from the serialized data
+    Fossilized<FlatInstTable> const* m_flat;
+    /// Source locations have to be translated as they are read, so unlike the
+    /// rest of the table they are read out up front
+    List<SourceLoc> m_sourceLocs;
+
+    /// All of the module's instructions, indexed by instruction index + 1
+    List<IRInst*> m_insts;
+    List<FlatInstReaderBase::DeferredBody> m_bodies;
+    Dictionary<IRInst*, Index> m_mapGlobalToBody;
+
+    // Bodies may be needed by multiple threads doing code generation at once
+    std::mutex m_mutex;
+};
+
+/// Read the module instruction and its descendants out of `flat`. If `outBodies`
+/// is set, the bodies that can be read in later are left out and written to it.
+template<typename Table>
+static IRModuleInst* _readFlatModule(
+    IRSerialReadContext& readContext,
+    IRModule* module,
+    const Table& flat,
+    const List<SourceLoc>& sourceLocs,
+    List<IRInst*>& instsList,
+    List<FlatInstReaderBase::DeferredBody>* outBodies)
+{
+    FlatInstReader<Table> reader(module, flat, sourceLocs, nullptr);
+    const auto numInsts = reader.getInstCount();
+
+    instsList.setCount(numInsts + 1);
+    // nullptr instructions are represented as `-1`. We can save ourselves a
+    // branch by just making that index valid.
+    IRInst** const insts = &instsList[1];
+    insts[-1] = nullptr;
+    reader.m_insts = insts;
+
+    ConstArrayView<FlatInstReaderBase::DeferredBody> bodies;
+    if (outBodies)
+    {
+        reader.findDeferredBodies(*outBodies);
+        bodies = outBodies->getArrayView();
+    }
+
+    reader.allocateInsts(FlatInstReaderBase::Cursor(), numInsts, bodies);
+
+    reader.m_bodiesToSkip = bodies;
+    FlatInstReaderBase::Cursor cursor;
+    const auto moduleInst = reader.readInst(cursor, nullptr);
+
+    if (reader.m_foundUnrecognizedInstructions)
+        readContext._foundUnrecognizedInstructions = true;
 
-        return inst;
-    };
-    const auto moduleInst = go(go, nullptr);
     return cast<IRModuleInst>(moduleInst);
 }
 
+static IRModuleInst* deserializeFromFlatModule(const IRReadSerializer& serializer, IRModule* module)
+{
+    IRSerialReadContext& readContext = *serializer.getContext();
+
+    // When bodies are read on demand the table is used in place, straight out
+    // of the serialized data, which the loader keeps alive for as long as
+    // there are bodies left to read.
+    if (readContext._bodyLoading == IRBodyLoading::OnDemand &&
+        readContext._blobHoldingSerializedData)
+    {
+        const auto flatPtr = cast<Fossilized<FlatInstTable>>(serializer.getImpl()->readValPtr());
+        RefPtr<FlatInstDeferredBodyLoader> loader = new FlatInstDeferredBodyLoader(
+            module,
+            readContext._blobHoldingSerializedData,
+            flatPtr.get());
+        readSerialSourceLocRuns(
+            readContext.getSourceLocReader(),
+            deserialize1<List<uint32_t>>(serializer, flatPtr->getSourceLocRunLocs()),
+            deserialize1<List<uint32_t>>(serializer, flatPtr->getSourceLocRunLengths()),
+            loader->m_sourceLocs);
+
+        List<FlatInstReaderBase::DeferredBody> bodies;
+        const auto moduleInst = _readFlatModule(
+            readContext,
+            module,
+            *loader->m_flat,
+            loader->m_sourceLocs,
+            loader->m_insts,
+            &bodies);
+
+        if (bodies.getCount() > 0)
+        {
+            loader->setBodies(_Move(bodies));
+            module->setDeferredBodyLoader(loader);
+        }
+        return moduleInst;
+    }
+
+    FlatInstTable flat;
+    serialize(serializer, flat);
+    // dumpFlatInstTableStats(flat, "deserializing");
+
+    List<SourceLoc> sourceLocs;
+    readSerialSourceLocRuns(
+        readContext.getSourceLocReader(),
+        flat.sourceLocRunLocs,
+        flat.sourceLocRunLengths,
+        sourceLocs);
+
+    List<IRInst*> instsList;
+    return _readFlatModule(readContext, module, flat, sourceLocs, instsList, nullptr);
+}
+
 void IRSerialWriteContext::handleIRModule(IRWriteSerializer const& serializer, IRModule*& value)
 {
     SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
@@ -719,6 +1150,9 @@ void writeSerializedModuleIR(
     // The flow here is very similar to writeSerializedModuleAST which is very
     // well documented.
 
+    // If the module was itself read with bodies on demand, write out all of it
+    irModule->ensureAllBodiesLoaded();
+
     IRModuleInfo moduleInfo;
     moduleInfo.fullVersion = SLANG_TAG_VERSION;
     moduleInfo.module = irModule;
@@ -785,7 +1219,9 @@ Result readSerializedModuleInfo(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule)
+    RefPtr<IRModule>& outIRModule,
+    IRBodyLoading bodyLoading,
+    ISlangBlob* blobHoldingSerializedData)
 {
 #if USE_RIFF
     auto dataChunk = as<RIFF::ListChunk>(chunk);
@@ -796,6 +1232,7 @@ Result readSerializedModuleInfo(
 
     IRModuleInfo info;
     auto sharedDecodingContext = RefPtr(new IRSerialReadContext(session, sourceLocReader));
+    sharedDecodingContext->_bodyLoading = bodyLoading;
     {
         RIFFSerialReader reader(dataChunk);
 
@@ -825,6 +1262,8 @@ Result readSerializedModuleInfo(
 
     IRModuleInfo info;
     auto sharedDecodingContext = RefPtr(new IRSerialReadContext(session, sourceLocReader));
+    sharedDecodingContext->_bodyLoading = bodyLoading;
+    sharedDecodingContext->_blobHoldingSerializedData = blobHoldingSerializedData;
     {
         Fossil::ReadContext readContext;
         Fossil::SerialReader reader(
@@ -848,11 +1287,19 @@ Result readSerializedModuleIR(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule)
+    RefPtr<IRModule>& outIRModule,
+    IRBodyLoading bodyLoading,
+    ISlangBlob* blobHoldingSerializedData)
 {
     SLANG_PROFILE;
 
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR_(chunk, session, sourceLocReader, outIRModule));
+    SLANG_RETURN_ON_FAIL(readSerializedModuleIR_(
+        chunk,
+        session,
+        sourceLocReader,
+        outIRModule,
+        bodyLoading,
+        blobHoldingSerializedData));
 
     //
     // Module is finally valid (or at least as much as it was going it) and
@@ -23,11 +23,29 @@ void writeSerializedModuleIR(
     IRModule* moduleDecl,
     SerialSourceLocWriter* sourceLocWriter);
 
+/// How the bodies of functions (and other global values with code) are read in
+enum class IRBodyLoading
+{
+    /// Everything is read in up front
+    Eager,
+    /// Global values are read in along with their decorations, but their bodies are only read
+    /// in when first needed, see `IRModule::ensureBodyLoaded`
+    OnDemand,
+};
+
+/// Read the IR module serialized in `chunk`.
+///
+/// With `IRBodyLoading::OnDemand` the bodies left out are later read in place from the
+/// serialized data, without copying it out first, so `blobHoldingSerializedData` must be
+/// the blob `chunk` points into. It is retained until every body has been read in. Without
+/// a blob everything is read in up front.
 [[nodiscard]] Result readSerializedModuleIR(
     RIFF::Chunk const* chunk,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outIRModule);
+    RefPtr<IRModule>& outIRModule,
+    IRBodyLoading bodyLoading = IRBodyLoading::Eager,
+    ISlangBlob* blobHoldingSerializedData = nullptr);
 
 [[nodiscard]] Result readSerializedModuleInfo(
     RIFF::Chunk const* chunk,
@@ -46,13 +46,24 @@ SerialSourceLocData::SourceLoc SerialSourceLocWriter::addSourceLoc(SourceLoc sou
         return SerialSourceLocData::SourceLoc(0);
     }
 
-    // Look up the view it's from
-    SourceView* sourceView = m_sourceManager->findSourceView(sourceLoc);
+    // Neighbouring AST nodes and instructions often have the same location
+    if (sourceLoc == m_lastSourceLoc)
+    {
+        return m_lastSerialSourceLoc;
+    }
+
+    // Look up the view it's from, which is usually the same as for the last location
+    SourceView* sourceView = m_lastSourceView;
+    if (!sourceView || !sourceView->getRange().contains(sourceLoc))
+    {
+        sourceView = m_sourceManager->findSourceView(sourceLoc);
+    }
     if (!sourceView)
     {
         // If not found we just ingore
         return SerialSourceLocData::SourceLoc(0);
     }
+    m_lastSourceView = sourceView;
 
     SourceFile* sourceFile = sourceView->getSourceFile();
     Source* debugSourceFile;
@@ -75,7 +86,7 @@ SerialSourceLocData::SourceLoc SerialSourceLocWriter::addSourceLoc(SourceLoc sou
     // We need to work out the line index
 
     int offset = sourceView->getRange().getOffset(sourceLoc);
-    int lineIndex = sourceFile->calcLineIndexFromOffset(offset);
+    int lineIndex = sourceView->calcLineIndexFromOffset(offset);
 
     SerialSourceLocData::LineInfo lineInfo;
     lineInfo.m_lineStartOffset = sourceFile->getLineBreakOffsets()[lineIndex];
@@ -116,7 +127,10 @@ SerialSourceLocData::SourceLoc SerialSourceLocWriter::addSourceLoc(SourceLoc sou
         debugSourceFile->setHasLineIndex(lineIndex);
     }
 
-    return SerialSourceLocData::SourceLoc(debugSourceFile->m_baseSourceLoc + offset);
+    m_lastSourceLoc = sourceLoc;
+    m_lastSerialSourceLoc =
+        SerialSourceLocData::SourceLoc(debugSourceFile->m_baseSourceLoc + offset);
+    return m_lastSerialSourceLoc;
 }
 
 void SerialSourceLocWriter::write(SerialSourceLocData* outSourceLocData)
@@ -165,6 +179,42 @@ void SerialSourceLocWriter::write(SerialSourceLocData* outSourceLocData)
     SerialStringTableUtil::encodeStringTable(m_stringSlicePool, outSourceLocData->m_stringTable);
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialSourceLocRunWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void SerialSourceLocRunWriter::add(SourceLoc sourceLoc)
+{
+    const uint32_t serialLoc = m_writer ? m_writer->addSourceLoc(sourceLoc) : 0;
+
+    const Index runCount = m_runLengths.getCount();
+    if (runCount && m_runLocs[runCount - 1] == serialLoc)
+    {
+        m_runLengths[runCount - 1]++;
+        return;
+    }
+    m_runLocs.add(serialLoc);
+    m_runLengths.add(1);
+}
+
+void readSerialSourceLocRuns(
+    SerialSourceLocReader* reader,
+    List<uint32_t> const& runLocs,
+    List<uint32_t> const& runLengths,
+    List<SourceLoc>& outSourceLocs)
+{
+    SLANG_ASSERT(runLocs.getCount() == runLengths.getCount());
+
+    outSourceLocs.clear();
+    for (Index i = 0; i < runLengths.getCount(); ++i)
+    {
+        // Each run is only looked up once, however many items it covers
+        const SourceLoc sourceLoc = reader ? reader->getSourceLoc(runLocs[i]) : SourceLoc();
+        for (uint32_t j = 0; j < runLengths[i]; ++j)
+        {
+            outSourceLocs.add(sourceLoc);
+        }
+    }
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialSourceLocReader !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 Index SerialSourceLocReader::findViewIndex(SerialSourceLocData::SourceLoc loc)
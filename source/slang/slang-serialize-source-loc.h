@@ -232,8 +232,49 @@ public:
     StringSlicePool m_stringSlicePool;   ///< Slices held just for debug usage
     SourceLoc::RawValue m_freeSourceLoc; ///< Locations greater than this are free
     Dictionary<SourceFile*, RefPtr<Source>> m_sourceFileMap;
+
+    /// The last location added, the view it is in, and what it was added as. Neighbouring
+    /// nodes and instructions often have the same location.
+    SourceView* m_lastSourceView = nullptr;
+    SourceLoc m_lastSourceLoc;
+    SerialSourceLocData::SourceLoc m_lastSerialSourceLoc = 0;
+};
+
+/// Writes the source locations of a sequence of items, such as the instructions of an IR
+/// module, where neighbouring items usually have the same location.
+///
+/// The locations are stored as runs of consecutive items that share a location, each with
+/// its length and the location written by the `SerialSourceLocWriter`, so they take space
+/// per run rather than per item. The locations refer to the same `SerialSourceLocData` as
+/// any other locations written with the writer, such as those of AST nodes.
+class SerialSourceLocRunWriter
+{
+public:
+    /// Add the location of the next item. If `writer` is null every item has no location.
+    void add(SourceLoc sourceLoc);
+
+    SerialSourceLocRunWriter(
+        SerialSourceLocWriter* writer,
+        List<uint32_t>& outRunLocs,
+        List<uint32_t>& outRunLengths)
+        : m_writer(writer), m_runLocs(outRunLocs), m_runLengths(outRunLengths)
+    {
+    }
+
+protected:
+    SerialSourceLocWriter* m_writer;
+    List<uint32_t>& m_runLocs;
+    List<uint32_t>& m_runLengths;
 };
 
+/// Read the locations written by a `SerialSourceLocRunWriter` into `outSourceLocs`, one per
+/// item. If `reader` is null every item gets an invalid location.
+void readSerialSourceLocRuns(
+    SerialSourceLocReader* reader,
+    List<uint32_t> const& runLocs,
+    List<uint32_t> const& runLengths,
+    List<SourceLoc>& outSourceLocs);
+
 // A class a custom serialization context can inherit from to enable
 // serializing SourceLoc
 struct SourceLocSerialContext
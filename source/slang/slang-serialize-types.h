@@ -127,6 +127,18 @@ struct SerialBinary
     /// A string table
     static const FourCC::RawValue kStringTableFourCc = SLANG_FOUR_CC('S', 'L', 's', 't');
 
+    /// A reference to a string in the string table of the enclosing container.
+    /// The payload is a `StringRef`.
+    static const FourCC::RawValue kStringRefFourCc = SLANG_FOUR_CC('S', 'L', 's', 'r');
+
+    struct StringRef
+    {
+        /// The type the chunk would have if it held the string itself
+        FourCC::RawValue type;
+        /// The index of the string in the container string table
+        uint32_t index;
+    };
+
     /// TranslationUnitList
     static const FourCC::RawValue kModuleListFourCc = SLANG_FOUR_CC('S', 'L', 'm', 'l');
 
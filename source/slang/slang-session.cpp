@@ -1,8 +1,10 @@
 // slang-session.cpp
 #include "slang-session.h"
 
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-shared-library.h"
 #include "compiler-core/slang-artifact-util.h"
+#include "compiler-core/slang-import-scan-util.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-lower-to-ir.h"
@@ -17,6 +19,8 @@
 #include "slang-serialize-ir.h"
 #include "slang-standard-module-config.h"
 
+#include <optional>
+
 namespace Slang
 {
 
@@ -111,9 +115,14 @@ Linkage::~Linkage()
     {
         auto globalSession = getSessionImpl();
         std::lock_guard<std::mutex> lock(globalSession->m_typeCheckingCacheMutex);
+        auto getCachedOverloadCount = [](TypeCheckingCache* cache)
+        {
+            return cache->resolvedOperatorOverloadCache.getCount() +
+                   cache->resolvedFunctionOverloadCache.getCount();
+        };
         if (!globalSession->m_typeCheckingCache ||
-            globalSession->getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount() <
-                getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount())
+            getCachedOverloadCount(globalSession->getTypeCheckingCache()) <
+                getCachedOverloadCount(getTypeCheckingCache()))
         {
             globalSession->m_typeCheckingCache = m_typeCheckingCache;
             getTypeCheckingCache()->version++;
@@ -178,6 +187,9 @@ void Linkage::addTarget(slang::TargetDesc const& desc)
 SLANG_NO_THROW slang::IModule* SLANG_MCALL
 Linkage::loadModule(const char* moduleName, slang::IBlob** outDiagnostics)
 {
+    // Importing mutates the linkage's module maps and AST, so it is serialized with other
+    // front-end operations on this session.
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
@@ -223,6 +235,8 @@ slang::IModule* Linkage::loadModuleFromBlob(
     ModuleBlobType blobType,
     slang::IBlob** outDiagnostics)
 {
+    // Loading mutates the linkage's module maps and AST, so serialize it like `loadModule`.
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
@@ -352,6 +366,9 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::loadModuleInfoFromIRBlob(
     UInt version;
     String name;
     SLANG_RETURN_ON_FAIL(readSerializedModuleInfo(irChunk, compilerVersion, version, name));
+
+    // The string pool is shared by every thread using this session.
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     const auto compilerVersionSlice = m_stringSlicePool.addAndGetSlice(compilerVersion);
     const auto nameSlice = m_stringSlicePool.addAndGetSlice(name);
     outModuleCompilerVersion = compilerVersionSlice.begin();
@@ -422,6 +439,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     SlangInt specializationArgCount,
     ISlangBlob** outDiagnostics)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto unspecializedType = asInternal(inUnspecializedType);
@@ -620,6 +638,7 @@ SLANG_NO_THROW slang::TypeLayoutReflection* SLANG_MCALL Linkage::getTypeLayout(
     slang::LayoutRules rules,
     ISlangBlob** outDiagnostics)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -652,6 +671,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
     slang::ContainerType containerType,
     ISlangBlob** outDiagnostics)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -703,6 +723,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
 
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     return asExternal(getASTBuilder()->getSharedASTBuilder()->getDynamicType());
@@ -711,6 +732,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Linkage::getTypeRTTIMangledName(slang::TypeReflection* type, ISlangBlob** outNameBlob)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto internalType = asInternal(type);
@@ -729,6 +751,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessMangled
     slang::TypeReflection* interfaceType,
     ISlangBlob** outNameBlob)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -744,6 +767,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     slang::TypeReflection* interfaceType,
     uint32_t* outId)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -754,25 +778,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
 
     auto name = getMangledNameForConformanceWitness(m_astBuilder, subType, supType);
     auto interfaceName = getMangledTypeName(m_astBuilder, supType);
-    // API lookups share the same sequential-ID maps that IR lowering updates when tagging
-    // witness tables, so keep each lookup/allocation atomic.
-    std::lock_guard<std::mutex> lock(m_sequentialIDMapMutex);
-    uint32_t resultIndex = 0;
-    if (mapMangledNameToRTTIObjectIndex.tryGetValue(name, resultIndex))
-    {
-        if (outId)
-            *outId = resultIndex;
-        return SLANG_OK;
-    }
-    auto idAllocator = mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(interfaceName);
-    if (!idAllocator)
-    {
-        mapInterfaceMangledNameToSequentialIDCounters[interfaceName] = 0;
-        idAllocator = mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(interfaceName);
-    }
-    resultIndex = (*idAllocator);
-    ++(*idAllocator);
-    mapMangledNameToRTTIObjectIndex[name] = resultIndex;
+    auto resultIndex =
+        sequentialIDMap.getOrAllocateID(name.getUnownedSlice(), interfaceName.getUnownedSlice());
     if (outId)
         *outId = resultIndex;
     return SLANG_OK;
@@ -793,6 +800,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getDynamicObjectRTTIBytes(
     if (bufferSize < 16)
         return SLANG_E_BUFFER_TOO_SMALL;
 
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     SLANG_RETURN_ON_FAIL(getTypeConformanceWitnessSequentialID(type, interfaceType, outBuffer + 2));
@@ -813,6 +821,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createTypeConformanceComponentTy
     if (outConformanceComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     RefPtr<TypeConformance> result;
@@ -853,11 +862,13 @@ Linkage::createCompileRequest(SlangCompileRequest** outCompileRequest)
 
 SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getLoadedModuleCount()
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     return loadedModulesList.getCount();
 }
 
 SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::getLoadedModule(SlangInt index)
 {
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
     if (index >= 0 && index < loadedModulesList.getCount())
         return loadedModulesList[index].get();
     return nullptr;
@@ -927,6 +938,40 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     }
 }
 
+PersistentCache* Linkage::getShaderCache()
+{
+    std::lock_guard<std::mutex> lock(m_shaderCacheMutex);
+    if (!m_isShaderCacheInitialized)
+    {
+        m_isShaderCacheInitialized = true;
+
+        String directory = m_optionSet.getStringOption(CompilerOptionName::ShaderCacheDirectory);
+        if (directory.getLength())
+        {
+            PersistentCache::Desc desc;
+            desc.directory = directory.getBuffer();
+            m_shaderCache = new PersistentCache(desc);
+        }
+    }
+    return m_shaderCache;
+}
+
+void Linkage::attachFileDigestCache()
+{
+    auto cacheFileSystem = as<CacheFileSystem>(m_fileSystemExt);
+    if (!cacheFileSystem || cacheFileSystem->getDigestCache())
+        return;
+
+    String directory = m_optionSet.getStringOption(CompilerOptionName::ShaderCacheDirectory);
+    if (!directory.getLength())
+        return;
+
+    const String digestDirectory = Path::combine(directory, "file-digests");
+    PersistentCache::Desc desc;
+    desc.directory = digestDirectory.getBuffer();
+    cacheFileSystem->setDigestCache(new PersistentCache(desc));
+}
+
 SlangResult Linkage::addSearchPath(char const* path)
 {
     m_optionSet.add(CompilerOptionName::Include, String(path));
@@ -1034,6 +1079,8 @@ UInt Linkage::addTarget(CodeGenTarget target)
 
     Index result = targets.getCount();
     targets.add(targetReq);
+
+    getSessionImpl()->preloadDownstreamCompilerForTarget(target);
     return UInt(result);
 }
 
@@ -1071,9 +1118,9 @@ void Linkage::loadParsedModule(
         throw;
     }
     errorCountAfter = sink->getErrorCount();
-    if (isInLanguageServer())
+    if (isInLanguageServer() || isReflectionOnly())
     {
-        // Don't generate IR as language server.
+        // Don't generate IR as language server, or when only reflection was asked for.
         // This means that we currently cannot report errors that are detected during IR passes.
         // Ideally we want to run those passes, but that is too risky for what it is worth right
         // now.
@@ -1101,6 +1148,40 @@ void Linkage::loadParsedModule(
     loadedModulesList.add(loadedModule);
 }
 
+void Linkage::unloadModules(HashSet<Module*> const& modules)
+{
+    List<RefPtr<LoadedModule>> remainingModules;
+    for (auto& module : loadedModulesList)
+    {
+        if (!modules.contains(module.get()))
+            remainingModules.add(module);
+    }
+    loadedModulesList = _Move(remainingModules);
+
+    List<String> pathsToRemove;
+    for (const auto& [path, module] : mapPathToLoadedModule)
+    {
+        if (modules.contains(module.get()))
+            pathsToRemove.add(path);
+    }
+    for (auto& path : pathsToRemove)
+        mapPathToLoadedModule.remove(path);
+
+    // A null entry records an import that failed, which may now succeed.
+    List<Name*> namesToRemove;
+    for (const auto& [name, module] : mapNameToLoadedModules)
+    {
+        if (!module || modules.contains(module.get()))
+            namesToRemove.add(name);
+    }
+    for (auto name : namesToRemove)
+        mapNameToLoadedModules.remove(name);
+
+    // Cached lookups may refer to declarations of the unloaded modules.
+    destroyTypeCheckingCache();
+    m_inheritanceInfoCache = nullptr;
+}
+
 RefPtr<Module> Linkage::findOrLoadSerializedModuleForModuleLibrary(
     ISlangBlob* blobHoldingSerializedData,
     ModuleChunk const* moduleChunk,
@@ -1117,7 +1198,12 @@ RefPtr<Module> Linkage::findOrLoadSerializedModuleForModuleLibrary(
     // The first step is to simply decode the module name, and
     // see if we have a already loaded a matching module.
 
-    auto moduleName = getNamePool()->getName(moduleChunk->getName());
+    // Names and paths of modules in a library may be stored in the
+    // string table of the library, rather than in the module chunk.
+    //
+    ContainerStringTable strings(libraryChunk);
+
+    auto moduleName = getNamePool()->getName(moduleChunk->getName(&strings));
     if (mapNameToLoadedModules.tryGetValue(moduleName, resultModule))
         return resultModule;
 
@@ -1138,7 +1224,7 @@ RefPtr<Module> Linkage::findOrLoadSerializedModuleForModuleLibrary(
     if (!firstFileDependencyChunk)
         return nullptr;
 
-    auto modulePathInfo = PathInfo::makePath(firstFileDependencyChunk->getValue());
+    auto modulePathInfo = PathInfo::makePath(firstFileDependencyChunk->getValue(&strings));
     if (mapPathToLoadedModule.tryGetValue(modulePathInfo.getMostUniqueIdentity(), resultModule))
         return resultModule;
 
@@ -1292,6 +1378,8 @@ RefPtr<Module> Linkage::loadModuleImpl(
     const LoadedModuleDictionary* additionalLoadedModules,
     ModuleBlobType blobType)
 {
+    SLANG_PROFILE_TRACE("module", "loadModule", getText(moduleName));
+
     switch (blobType)
     {
     case ModuleBlobType::IR:
@@ -1312,6 +1400,111 @@ RefPtr<Module> Linkage::loadModuleImpl(
     }
 }
 
+namespace
+{
+// While in scope, keeps a copy of the diagnostics written to a sink while a module is checked,
+// so that they can be reported again when the module is shared with another session. The
+// diagnostics are still output as usual.
+class SharedModuleDiagnosticCapture : public AppendBufferWriter
+{
+public:
+    SharedModuleDiagnosticCapture(DiagnosticSink* sink)
+        : AppendBufferWriter(WriterFlag::IsStatic)
+        , m_sink(sink)
+        , m_previousWriter(sink->writer)
+        , m_outer(t_innermostCapture)
+    {
+        // The diagnostics of a module imported by this one are reported again when that module
+        // is loaded, so they bypass the capture of the importing module.
+        m_outputWriter =
+            (m_outer && m_previousWriter == m_outer) ? m_outer->m_outputWriter : m_previousWriter;
+        sink->writer = this;
+        t_innermostCapture = this;
+    }
+
+    ~SharedModuleDiagnosticCapture()
+    {
+        m_sink->writer = m_previousWriter;
+        t_innermostCapture = m_outer;
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL write(const char* chars, size_t numChars)
+        SLANG_OVERRIDE
+    {
+        m_diagnostics.append(chars, numChars);
+        if (m_outputWriter)
+            return m_outputWriter->write(chars, numChars);
+        m_sink->outputBuffer.append(chars, numChars);
+        return SLANG_OK;
+    }
+
+    String const& getDiagnostics() const { return m_diagnostics; }
+
+private:
+    DiagnosticSink* m_sink;
+    ISlangWriter* m_previousWriter;
+    ISlangWriter* m_outputWriter;
+    SharedModuleDiagnosticCapture* m_outer;
+    StringBuilder m_diagnostics;
+
+    // Modules are imported on the thread that loads the importing module.
+    static thread_local SharedModuleDiagnosticCapture* t_innermostCapture;
+};
+
+thread_local SharedModuleDiagnosticCapture* SharedModuleDiagnosticCapture::t_innermostCapture =
+    nullptr;
+} // namespace
+
+String Linkage::_getSharedCheckedModuleKey(
+    Name* name,
+    const PathInfo& filePathInfo,
+    ISlangBlob* sourceBlob)
+{
+    // Files the module includes or imports aren't known until it is parsed, so they are
+    // not part of the key. Instead a found module is checked to be up to date with them,
+    // in the same way as a precompiled module.
+    DigestBuilder<SHA1> digestBuilder;
+    digestBuilder.append(String(getBuildTagString()));
+    m_optionSet.buildHash(digestBuilder);
+    digestBuilder.append(getText(name));
+    digestBuilder.append(filePathInfo.getMostUniqueIdentity());
+    digestBuilder.append(sourceBlob);
+    return digestBuilder.finalize().toString();
+}
+
+RefPtr<Module> Linkage::_findSharedCheckedModule(
+    Name* name,
+    const PathInfo& filePathInfo,
+    String const& key,
+    SourceLoc const& srcLoc,
+    DiagnosticSink* sink)
+{
+    String diagnostics;
+    auto serializedModule = getSessionImpl()->findSharedCheckedModule(key, diagnostics);
+    if (!serializedModule)
+        return nullptr;
+
+    auto rootChunk = RIFF::RootChunk::getFromBlob(serializedModule);
+    if (!rootChunk)
+        return nullptr;
+    auto moduleChunk = ModuleChunk::find(rootChunk);
+    if (!moduleChunk || !isBinaryModuleUpToDate(filePathInfo.foundPath, moduleChunk))
+        return nullptr;
+
+    // Report the warnings checking the module reported, as if it had been checked again.
+    if (diagnostics.getLength())
+        sink->diagnoseRaw(Severity::Warning, diagnostics.getUnownedSlice());
+
+    return loadSerializedModule(
+        name,
+        filePathInfo,
+        serializedModule,
+        moduleChunk,
+        rootChunk,
+        srcLoc,
+        sink);
+}
+
 RefPtr<Module> Linkage::loadSourceModuleImpl(
     Name* name,
     const PathInfo& filePathInfo,
@@ -1320,6 +1513,21 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
     DiagnosticSink* sink,
     const LoadedModuleDictionary* additionalLoadedModules)
 {
+    // Modules checked by other sessions can be reused when this session shares them too.
+    // The language server checks modules only partially, and reflection-only linkages don't
+    // generate their IR, so neither takes part.
+    String sharedCheckedModuleKey;
+    if (sourceBlob && !additionalLoadedModules && !isInLanguageServer() && !isReflectionOnly() &&
+        m_optionSet.getBoolOption(CompilerOptionName::ShareCheckedModules))
+    {
+        sharedCheckedModuleKey = _getSharedCheckedModuleKey(name, filePathInfo, sourceBlob);
+        if (auto sharedModule =
+                _findSharedCheckedModule(name, filePathInfo, sharedCheckedModuleKey, srcLoc, sink))
+        {
+            return sharedModule;
+        }
+    }
+
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, sink);
 
     frontEndReq->additionalLoadedModules = additionalLoadedModules;
@@ -1376,6 +1584,11 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
         // Some problem accessing source files
         return nullptr;
     }
+
+    std::optional<SharedModuleDiagnosticCapture> diagnosticCapture;
+    if (sharedCheckedModuleKey.getLength())
+        diagnosticCapture.emplace(sink);
+
     int errorCountBefore = sink->getErrorCount();
     frontEndReq->parseTranslationUnit(translationUnit);
     int errorCountAfter = sink->getErrorCount();
@@ -1412,6 +1625,16 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
         return nullptr;
 
     module->setPathInfo(filePathInfo);
+
+    if (sharedCheckedModuleKey.getLength() && errorCountAfter == 0 && module->getIRModule())
+    {
+        ComPtr<ISlangBlob> serializedModule;
+        if (SLANG_SUCCEEDED(module->serialize(serializedModule.writeRef())))
+            getSessionImpl()->addSharedCheckedModule(
+                sharedCheckedModuleKey,
+                serializedModule,
+                diagnosticCapture->getDiagnostics());
+    }
     return module;
 }
 
@@ -1456,6 +1679,48 @@ String getFileNameFromModuleName(Name* name, bool translateUnderScore)
     return fileName;
 }
 
+// Get the names of the source files to search for a module in, in the order they are tried.
+static List<String> _getModuleSourceFileNamesToTry(Name* moduleName)
+{
+    // We will always search for a file name that directly matches the
+    // module name as written first, and then search for one with
+    // underscores replaced by dashes. The latter is the original
+    // behavior that `import` provided, but it seems safest to prefer
+    // the exact name spelled in the user's code when there might
+    // actually be ambiguity.
+    //
+    auto defaultSourceFileName = getFileNameFromModuleName(moduleName, false);
+    auto alternativeSourceFileName = getFileNameFromModuleName(moduleName, true);
+
+    List<String> fileNames;
+    fileNames.add(defaultSourceFileName);
+    fileNames.add(alternativeSourceFileName);
+    fileNames.add(defaultSourceFileName + ".md");
+    fileNames.add(alternativeSourceFileName + ".md");
+    return fileNames;
+}
+
+// Get the name of the file to load a module of the given type from, for one of the
+// source file names from `_getModuleSourceFileNamesToTry`.
+static String _getModuleFileName(String const& sourceFileName, ModuleBlobType type)
+{
+    // The `sourceFileName` will have a `.slang` or `.slang.md`
+    // extension, so if we are looking for a binary module, we
+    // need to change the extension we will look for. For
+    // `.slang.md` files, we first strip the `.md` suffix so
+    // that `Path::replaceExt` replaces `.slang` correctly.
+    //
+    switch (type)
+    {
+    case ModuleBlobType::IR:
+        return Path::replaceExt(maybeStripLiterateFileExtension(sourceFileName), "slang-module");
+
+    case ModuleBlobType::Source:
+    default:
+        return sourceFileName;
+    }
+}
+
 RefPtr<Module> Linkage::findOrImportModule(
     Name* moduleName,
     SourceLoc const& requestingLoc,
@@ -1561,22 +1826,7 @@ RefPtr<Module> Linkage::findOrImportModule(
         typesToTry.add(ModuleBlobType::Source);
     }
 
-    // We will always search for a file name that directly matches the
-    // module name as written first, and then search for one with
-    // underscores replaced by dashes. The latter is the original
-    // behavior that `import` provided, but it seems safest to prefer
-    // the exact name spelled in the user's code when there might
-    // actually be ambiguity.
-    //
-    auto defaultSourceFileName = getFileNameFromModuleName(moduleName, false);
-    auto alternativeSourceFileName = getFileNameFromModuleName(moduleName, true);
-    auto defaultMDFileName = defaultSourceFileName + ".md";
-    auto alternativeMDFileName = alternativeSourceFileName + ".md";
-    String sourceFileNamesToTry[] = {
-        defaultSourceFileName,
-        alternativeSourceFileName,
-        defaultMDFileName,
-        alternativeMDFileName};
+    auto sourceFileNamesToTry = _getModuleSourceFileNamesToTry(moduleName);
 
     // We are going to look for the candidate file using the same
     // logic that would be used for a preprocessor `#include`,
@@ -1596,25 +1846,7 @@ RefPtr<Module> Linkage::findOrImportModule(
     {
         for (auto sourceFileName : sourceFileNamesToTry)
         {
-            // The `sourceFileName` will have a `.slang` or `.slang.md`
-            // extension, so if we are looking for a binary module, we
-            // need to change the extension we will look for. For
-            // `.slang.md` files, we first strip the `.md` suffix so
-            // that `Path::replaceExt` replaces `.slang` correctly.
-            //
-            String fileName;
-            switch (type)
-            {
-            case ModuleBlobType::Source:
-                fileName = sourceFileName;
-                break;
-
-            case ModuleBlobType::IR:
-                fileName = Path::replaceExt(
-                    maybeStripLiterateFileExtension(sourceFileName),
-                    "slang-module");
-                break;
-            }
+            String fileName = _getModuleFileName(sourceFileName, type);
 
             // We now search for a file matching the desired name,
             // using the same logic as for a `#include`.
@@ -1761,7 +1993,7 @@ RefPtr<Module> Linkage::findOrImportModule(
     // nothing was even found via the include system).
     //
     sink->diagnose(
-        Diagnostics::CannotOpenFile{.path = defaultSourceFileName, .location = requestingLoc});
+        Diagnostics::CannotOpenFile{.path = sourceFileNamesToTry[0], .location = requestingLoc});
 
     // If the attempt to import the module failed, then
     // we will stick a null pointer into the map of loaded
@@ -1773,6 +2005,110 @@ RefPtr<Module> Linkage::findOrImportModule(
     return nullptr;
 }
 
+void Linkage::prefetchImportedModuleSources(ModuleDecl* moduleDecl)
+{
+    // Files are read on worker threads, which is only safe for the OS file system, and the
+    // language server loads modules from the documents it is editing.
+    if (m_fileSystem || isInLanguageServer())
+        return;
+    auto jobScheduler = getSessionImpl()->getCurrentJobScheduler();
+    if (jobScheduler->getThreadCount() <= 1)
+        return;
+
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+
+    struct PendingFile
+    {
+        PathInfo pathInfo;
+        ComPtr<ISlangBlob> contents;
+        List<String> importedModuleNames;
+    };
+    List<PendingFile> pendingFiles;
+    HashSet<String> pendingIdentities;
+
+    // Find the source file that an `import` of `moduleName` from `requestingPath` would load,
+    // and add it to the files to read, unless it is loaded already.
+    auto addImport = [&](Name* moduleName, String const& requestingPath)
+    {
+        if (mapNameToLoadedModules.containsKey(moduleName) ||
+            moduleName == getSessionImpl()->glslModuleName)
+            return;
+
+        auto sourceFileNames = _getModuleSourceFileNamesToTry(moduleName);
+        PathInfo filePathInfo;
+        for (auto& sourceFileName : sourceFileNames)
+        {
+            // A precompiled module is loaded in preference to the source.
+            if (SLANG_SUCCEEDED(includeSystem.findFile(
+                    _getModuleFileName(sourceFileName, ModuleBlobType::IR),
+                    requestingPath,
+                    filePathInfo)))
+                return;
+        }
+        for (auto& sourceFileName : sourceFileNames)
+        {
+            if (SLANG_FAILED(includeSystem.findFile(sourceFileName, requestingPath, filePathInfo)))
+                continue;
+
+            auto identity = filePathInfo.getMostUniqueIdentity();
+            if (!mapPathToLoadedModule.containsKey(identity) &&
+                !getSourceManager()->findSourceFileRecursively(filePathInfo.uniqueIdentity) &&
+                pendingIdentities.add(identity))
+            {
+                PendingFile pendingFile;
+                pendingFile.pathInfo = filePathInfo;
+                pendingFiles.add(pendingFile);
+            }
+            return;
+        }
+    };
+
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        auto requestingPathInfo = getSourceManager()->getPathInfo(
+            importDecl->moduleNameAndLoc.loc,
+            SourceLocType::Actual);
+        addImport(importDecl->moduleNameAndLoc.name, requestingPathInfo.foundPath);
+    }
+
+    // The files are read, and scanned for the modules they import in turn, one wave of the
+    // import graph at a time. The files end up in the source manager, so that when each
+    // module is imported it is parsed without waiting for its file to be read.
+    Index waveStart = 0;
+    while (waveStart < pendingFiles.getCount())
+    {
+        Index waveEnd = pendingFiles.getCount();
+        auto readFile = [&](Index index)
+        {
+            auto& pendingFile = pendingFiles[waveStart + index];
+            if (SLANG_FAILED(OSFileSystem::getExtSingleton()->loadFile(
+                    pendingFile.pathInfo.foundPath.getBuffer(),
+                    pendingFile.contents.writeRef())))
+                return;
+            ImportScanUtil::scanImportedModuleNames(
+                StringUtil::getSlice(pendingFile.contents),
+                pendingFile.importedModuleNames);
+        };
+        runJobs(jobScheduler, waveEnd - waveStart, 0, readFile);
+
+        for (Index i = waveStart; i < waveEnd; i++)
+        {
+            // The list may grow while the wave is processed, so the file is not referenced.
+            auto pathInfo = pendingFiles[i].pathInfo;
+            auto contents = pendingFiles[i].contents;
+            if (!contents || getSourceManager()->findSourceFileRecursively(pathInfo.uniqueIdentity))
+                continue;
+            auto sourceFile = getSourceManager()->createSourceFileWithBlob(pathInfo, contents);
+            getSourceManager()->addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+
+            auto importedModuleNames = _Move(pendingFiles[i].importedModuleNames);
+            for (auto& importedModuleName : importedModuleNames)
+                addImport(getNamePool()->getName(importedModuleName), pathInfo.foundPath);
+        }
+        waveStart = waveEnd;
+    }
+}
+
 SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
 {
     IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
@@ -1851,6 +2187,9 @@ Linkage::getDeclSourceLocation(slang::DeclReflection* inDecl, slang::SourceLocat
     if (!inDecl || !outLocation)
         return SLANG_E_INVALID_ARG;
 
+    // Source views and the string pool are added to by front-end operations on other threads.
+    std::lock_guard<std::recursive_mutex> lock(getComponentTypeOperationMutex());
+
     Decl* decl = (Decl*)inDecl;
     SourceManager* sourceManager = getSourceManager();
     auto sourceView = sourceManager->findSourceViewRecursively(decl->getNameLoc());
@@ -1869,6 +2208,89 @@ Linkage::getDeclSourceLocation(slang::DeclReflection* inDecl, slang::SourceLocat
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getMemoryUsage(SlangMemoryUsage* outUsage)
+{
+    if (!outUsage)
+        return SLANG_E_INVALID_ARG;
+
+    // The module list and the arenas are only changed by front-end operations.
+    std::lock_guard<std::recursive_mutex> lock(m_componentTypeOperationMutex);
+
+    *outUsage = {};
+    outUsage->astBytes = m_astBuilder->getMemoryArena().calcTotalMemoryAllocated();
+    for (auto& loadedModule : loadedModulesList)
+    {
+        if (auto irModule = loadedModule->getIRModule())
+            outUsage->irBytes += irModule->getMemoryArena().calcTotalMemoryAllocated();
+    }
+    outUsage->stringPoolBytes = m_stringSlicePool.calcTotalMemoryAllocated();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::invalidateChangedFiles(
+    const char* const* filePaths,
+    SlangInt filePathCount,
+    SlangInt* outUnloadedModuleCount)
+{
+    if (filePathCount < 0 || (filePathCount > 0 && !filePaths))
+        return SLANG_E_INVALID_ARG;
+
+    std::lock_guard<std::recursive_mutex> lock(m_componentTypeOperationMutex);
+
+    // A source file is identified by the unique identity the file system gave it when it was
+    // loaded, or by its path if the file system didn't give one. A changed file may no longer
+    // exist, so match on both.
+    HashSet<String> changedIdentities;
+    for (SlangInt i = 0; i < filePathCount; i++)
+    {
+        if (!filePaths[i])
+            return SLANG_E_INVALID_ARG;
+        changedIdentities.add(filePaths[i]);
+
+        ComPtr<ISlangBlob> uniqueIdentity;
+        if (SLANG_SUCCEEDED(
+                m_fileSystemExt->getFileUniqueIdentity(filePaths[i], uniqueIdentity.writeRef())))
+            changedIdentities.add(StringUtil::getString(uniqueIdentity));
+    }
+    auto isChanged = [&](SourceFile* sourceFile)
+    {
+        auto& pathInfo = sourceFile->getPathInfo();
+        return changedIdentities.contains(pathInfo.getMostUniqueIdentity()) ||
+               changedIdentities.contains(pathInfo.foundPath);
+    };
+
+    // A module's file dependencies include those of every module it imports, so this finds
+    // the modules using the changed files along with everything that depends on them.
+    HashSet<Module*> modulesToUnload;
+    for (auto& loadedModule : loadedModulesList)
+    {
+        for (auto sourceFile : loadedModule->getFileDependencies())
+        {
+            if (isChanged(sourceFile))
+            {
+                modulesToUnload.add(loadedModule.get());
+                break;
+            }
+        }
+    }
+    if (modulesToUnload.getCount() != 0)
+        unloadModules(modulesToUnload);
+
+    // Make sure the changed files are read again rather than served from a cache.
+    auto sourceManager = getSourceManager();
+    for (auto sourceFile : sourceManager->getSourceFiles())
+    {
+        if (isChanged(sourceFile))
+            sourceManager->removeSourceFile(sourceFile);
+    }
+    if (filePathCount != 0)
+        m_fileSystemExt->clearCache();
+
+    if (outUnloadedModuleCount)
+        *outUnloadedModuleCount = modulesToUnload.getCount();
+    return SLANG_OK;
+}
+
 SourceFile* Linkage::findFile(Name* name, SourceLoc loc, IncludeSystem& outIncludeSystem)
 {
     auto impl = [&](bool translateUnderScore) -> SourceFile*
@@ -1972,15 +2394,25 @@ Linkage::IncludeResult Linkage::findAndIncludeFile(
 
     auto segments = extractSourceSegments(sourceFile, getSourceManager());
 
-    auto preprocessed = preprocessSourceSegments(
-        segments,
-        sourceLanguage,
-        slangLanguageVersion,
-        sink,
-        &includeSystem,
-        combinedPreprocessorDefinitions,
-        this,
-        &preprocessorHandler);
+    // An included file is preprocessed and parsed while its module is being
+    // checked, so these phases nest inside that module's "check" phase.
+    const bool shouldProfilePhases =
+        translationUnit->compileRequest->optionSet.shouldProfilePhases();
+    const String moduleName = getText(translationUnit->moduleName);
+
+    List<PreprocessedSegment> preprocessed;
+    {
+        SLANG_PROFILE_PHASE(shouldProfilePhases, "preprocess", moduleName);
+        preprocessed = preprocessSourceSegments(
+            segments,
+            sourceLanguage,
+            slangLanguageVersion,
+            sink,
+            &includeSystem,
+            combinedPreprocessorDefinitions,
+            this,
+            &preprocessorHandler);
+    }
 
     if (slangLanguageVersion != module->getModuleDecl()->languageVersion)
     {
@@ -1996,13 +2428,16 @@ Linkage::IncludeResult Linkage::findAndIncludeFile(
         sink->diagnose(Diagnostics::LanguageVersionDiffersFromIncludingModule{.location = diagLoc});
     }
 
-    parsePreprocessedSegments(
-        preprocessed,
-        module->getASTBuilder(),
-        translationUnit,
-        sink,
-        module->getModuleDecl()->ownedScope,
-        fileDecl);
+    {
+        SLANG_PROFILE_PHASE(shouldProfilePhases, "parse", moduleName);
+        parsePreprocessedSegments(
+            preprocessed,
+            module->getASTBuilder(),
+            translationUnit,
+            sink,
+            module->getModuleDecl()->ownedScope,
+            fileDecl);
+    }
 
     module->getModuleDecl()->addMember(fileDecl);
 
@@ -2062,6 +2497,8 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
 
     // Set the file system used on the source manager
     getSourceManager()->setFileSystemExt(m_fileSystemExt);
+
+    attachFileDigestCache();
 }
 
 SlangResult Linkage::loadSerializedModuleContents(
@@ -2179,7 +2616,13 @@ SlangResult Linkage::loadSerializedModuleContents(
     module->setModuleDecl(moduleDecl);
 
     RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, session, sourceLocReader, irModule));
+    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(
+        irChunk,
+        session,
+        sourceLocReader,
+        irModule,
+        IRBodyLoading::OnDemand,
+        blobHoldingSerializedData));
     module->setIRModule(irModule);
 
     // The handling of file dependencies is complicated, because of
@@ -2192,9 +2635,10 @@ SlangResult Linkage::loadSerializedModuleContents(
     module->clearFileDependency();
     String moduleSourcePath = moduleFilePathInfo.foundPath;
     bool isFirst = true;
+    ContainerStringTable strings(containerChunk);
     for (auto depenencyFileChunk : moduleChunk->getFileDependencies())
     {
-        auto encodedDependencyFilePath = depenencyFileChunk->getValue();
+        auto encodedDependencyFilePath = depenencyFileChunk->getValue(&strings);
 
         auto sourceFile = loadSourceFile(moduleFilePathInfo.foundPath, encodedDependencyFilePath);
         if (isFirst)
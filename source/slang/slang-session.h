@@ -16,6 +16,7 @@
 #include "../compiler-core/slang-command-line-args.h"
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-name.h"
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-riff.h"
 #include "../core/slang-smart-pointer.h"
 #include "slang-ast-base.h"
@@ -23,6 +24,7 @@
 #include "slang-compiler-options.h"
 #include "slang-content-assist-info.h"
 #include "slang-global-session.h"
+#include "slang-sequential-id-map.h"
 
 #include <mutex>
 #include <slang.h>
@@ -184,12 +186,29 @@ public:
     isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     getDeclSourceLocation(slang::DeclReflection* decl, slang::SourceLocation* outLocation) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getMemoryUsage(SlangMemoryUsage* outUsage) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL invalidateChangedFiles(
+        const char* const* filePaths,
+        SlangInt filePathCount,
+        SlangInt* outUnloadedModuleCount) override;
 
     // Updates the supplied builder with linkage-related information, which includes preprocessor
     // defines, the compiler version, and other compiler options. This is then merged with the hash
     // produced for the program to produce a key that can be used with the shader cache.
     void buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex = -1);
 
+    /// Get the persistent cache used to store compiled target code, or
+    /// null if no `CompilerOptionName::ShaderCacheDirectory` is set.
+    ///
+    /// The cache is opened lazily the first time it is requested.
+    PersistentCache* getShaderCache();
+
+    /// If a `CompilerOptionName::ShaderCacheDirectory` is set and the file system is a
+    /// `CacheFileSystem`, give it a digest cache in that directory, so that files hashed
+    /// for their unique identity aren't hashed again in later sessions unless they change.
+    void attachFileDigestCache();
+
     void addTarget(slang::TargetDesc const& desc);
     SlangResult addSearchPath(char const* path);
     SlangResult addPreprocessorDefine(char const* name, char const* value);
@@ -205,6 +224,12 @@ public:
         return contentAssistInfo.checkingMode != ContentAssistCheckingMode::None;
     }
 
+    /// Is the linkage only checking code and computing layouts, without generating any IR?
+    bool isReflectionOnly()
+    {
+        return m_optionSet.getBoolOption(CompilerOptionName::ReflectionOnly);
+    }
+
     /// Get the parent session for this linkage
     Session* getSessionImpl() { return m_session; }
 
@@ -241,8 +266,20 @@ public:
     void destroyTypeCheckingCache();
 
     RefPtr<RefObject> m_typeCheckingCache = nullptr;
-    // Front-end component-type operations still share linkage-owned mutable state and can
-    // re-enter one another, so they remain serialized even when backend emission is parallelized.
+
+    // Inheritance info shared between the semantic checking contexts of the linkage,
+    // implemented in slang-check-inheritance.cpp
+    InheritanceInfoCache* getInheritanceInfoCache();
+    RefPtr<RefObject> m_inheritanceInfoCache = nullptr;
+
+    // Tokens lexed from `#include`d files, shared between the translation units of the linkage,
+    // implemented in slang-preprocessor.cpp
+    IncludeFileTokenCache* getIncludeFileTokenCache();
+    RefPtr<RefObject> m_includeFileTokenCache = nullptr;
+    // Front-end operations share linkage-owned mutable state (the AST builder, the module maps
+    // and the type checking cache) and can re-enter one another, so every public entry point
+    // that parses, checks, loads, specializes, links or lays out code takes this lock. Code
+    // generation for linked programs does not, which lets it run on several threads at once.
     std::recursive_mutex m_componentTypeOperationMutex;
 
     // Modules that have been dynamically loaded via `import`
@@ -256,14 +293,8 @@ public:
     // Map from the logical name of a module to its definition
     Dictionary<Name*, RefPtr<LoadedModule>> mapNameToLoadedModules;
 
-    // Map from the mangled name of RTTI objects to sequential IDs
-    // used by `switch`-based dynamic dispatch.
-    Dictionary<String, uint32_t> mapMangledNameToRTTIObjectIndex;
-
-    // Counters for allocating sequential IDs to witness tables conforming to each interface type.
-    Dictionary<String, uint32_t> mapInterfaceMangledNameToSequentialIDCounters;
-    // Witness-table sequential ID assignment updates both maps together.
-    std::mutex m_sequentialIDMapMutex;
+    // Sequential IDs of witness tables used by `switch`-based dynamic dispatch.
+    SequentialIDMap sequentialIDMap;
 
     SearchDirectoryList searchDirectoryCache;
 
@@ -382,14 +413,42 @@ public:
         Name* name,
         PathInfo const& pathInfo);
 
+    /// Forget the given previously loaded modules, along with any failed import attempts,
+    /// so that a later `import` of them loads them again.
+    ///
+    /// The modules themselves stay alive for as long as something references them. This is
+    /// used by the language server to re-check only the modules affected by an edit.
+    void unloadModules(HashSet<Module*> const& modules);
+
     bool isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* baseChunk);
 
+    /// Key under which a module loaded from `sourceBlob` is shared with other sessions.
+    String _getSharedCheckedModuleKey(
+        Name* name,
+        const PathInfo& filePathInfo,
+        ISlangBlob* sourceBlob);
+    /// Load a module shared by another session under `key`, if there is one that is up to date.
+    RefPtr<Module> _findSharedCheckedModule(
+        Name* name,
+        const PathInfo& filePathInfo,
+        String const& key,
+        SourceLoc const& srcLoc,
+        DiagnosticSink* sink);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
         DiagnosticSink* sink,
         const LoadedModuleDictionary* loadedModules = nullptr);
 
+    /// Read the source files of the modules that a just parsed module imports, directly or
+    /// indirectly, on the job scheduler, so that the files are in the source manager by the
+    /// time `findOrImportModule` loads each of the modules.
+    ///
+    /// Checking a module imports its dependencies one at a time, so this is the only part of
+    /// loading an import graph that is done concurrently.
+    void prefetchImportedModuleSources(ModuleDecl* moduleDecl);
+
     SourceFile* findFile(Name* name, SourceLoc loc, IncludeSystem& outIncludeSystem);
     struct IncludeResult
     {
@@ -490,5 +549,11 @@ private:
     List<Type*> m_specializedTypes;
 
     RefPtr<SharedSemanticsContext> m_semanticsForReflection;
+
+    // Persistent cache of compiled target code, see `getShaderCache`.
+    // Back-end emission may run on several threads, so opening the cache is guarded.
+    std::mutex m_shaderCacheMutex;
+    bool m_isShaderCacheInitialized = false;
+    RefPtr<PersistentCache> m_shaderCache;
 };
 } // namespace Slang
@@ -1,10 +1,21 @@
 // slang-target-program.cpp
 #include "slang-target-program.h"
 
+#include "../compiler-core/slang-artifact-associated-impl.h"
+#include "../compiler-core/slang-artifact-util.h"
+#include "../core/slang-blob.h"
+#include "../core/slang-riff.h"
+#include "../core/slang-writer.h"
+#include "slang-check.h"
+#include "slang-code-gen.h"
 #include "slang-compiler.h"
+#include "slang-ir-link.h"
 #include "slang-rich-diagnostics.h"
+#include "slang-serialize-ir.h"
 #include "slang-type-layout.h"
 
+#include <optional>
+
 namespace Slang
 {
 
@@ -18,6 +29,7 @@ TargetProgram::TargetProgram(ComponentType* componentType, TargetRequest* target
     m_entryPointResults.setCount(componentType->getEntryPointCount());
     m_optionSet.overrideWith(m_program->getOptionSet());
     m_optionSet.inheritFrom(targetReq->getOptionSet());
+    m_optionSet.freeze();
 }
 
 IArtifact* TargetProgram::_createWholeProgramResult(
@@ -34,11 +46,9 @@ IArtifact* TargetProgram::_createWholeProgramResult(
     for (Index i = 0; i < entryPointIndices.getCount(); i++)
         entryPointIndices[i] = i;
 
-    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
-    CodeGenContext codeGenContext(&sharedCodeGenContext);
-
-    ComPtr<IArtifact> artifact;
-    if (SLANG_FAILED(codeGenContext.emitEntryPoints(artifact)))
+    ComPtr<IArtifact> artifact =
+        _emitEntryPointsWithShaderCache(entryPointIndices, sink, endToEndReq);
+    if (!artifact)
     {
         return nullptr;
     }
@@ -73,11 +83,9 @@ IArtifact* TargetProgram::_createEntryPointResult(
     CodeGenContext::EntryPointIndices entryPointIndices;
     entryPointIndices.add(entryPointIndex);
 
-    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
-    CodeGenContext codeGenContext(&sharedCodeGenContext);
-
-    ComPtr<IArtifact> artifact;
-    if (SLANG_FAILED(codeGenContext.emitEntryPoints(artifact)))
+    ComPtr<IArtifact> artifact =
+        _emitEntryPointsWithShaderCache(entryPointIndices, sink, endToEndReq);
+    if (!artifact)
     {
         return nullptr;
     }
@@ -95,6 +103,431 @@ IArtifact* TargetProgram::_createEntryPointResult(
     }
 }
 
+// Targets whose results are loaded into the process (rather than being a
+// blob of code) cannot be round-tripped through the shader cache.
+static bool _isShaderCacheableTarget(CodeGenTarget target)
+{
+    switch (target)
+    {
+    case CodeGenTarget::None:
+    case CodeGenTarget::Unknown:
+    case CodeGenTarget::HostHostCallable:
+    case CodeGenTarget::ShaderHostCallable:
+        return false;
+    default:
+        return true;
+    }
+}
+
+PersistentCache* TargetProgram::_getShaderCacheAndKey(
+    List<Index> const& entryPointIndices,
+    EndToEndCompileRequest* endToEndReq,
+    PersistentCache::Key& outKey)
+{
+    auto linkage = m_program->getLinkage();
+    auto shaderCache = linkage->getShaderCache();
+    if (!shaderCache)
+        return nullptr;
+
+    if (!_isShaderCacheableTarget(m_targetReq->getTarget()))
+        return nullptr;
+
+    // Pass-through compiles bypass the Slang front-end entirely, so the program
+    // hash doesn't describe their input.
+    if (endToEndReq && endToEndReq->m_passThrough != PassThroughMode::None)
+        return nullptr;
+
+    // A cache entry only holds the primary blob of the result along with its metadata
+    // and diagnostics. Options that ask for intermediate dumps, or that attach
+    // additional outputs to the result, always need code generation to actually run.
+    if (m_optionSet.shouldDumpIR() || m_optionSet.shouldDumpIntermediates() ||
+        m_optionSet.getBoolOption(CompilerOptionName::TraceCoverage) ||
+        m_optionSet.getBoolOption(CompilerOptionName::EmitSeparateDebug))
+        return nullptr;
+
+    const Index targetIndex = linkage->targets.indexOf(m_targetReq);
+    if (targetIndex < 0)
+        return nullptr;
+
+    // The linkage hash covers the compiler version, session and target options,
+    // the prelude and the version of the downstream compiler. The program hash
+    // covers the contents of every source file the program depends on, along
+    // with any specialization arguments.
+    DigestBuilder<SHA1> builder;
+    linkage->buildHash(builder, targetIndex);
+    m_program->buildHash(builder);
+
+    // Options can also be attached to the program itself (e.g. via `linkWithOptions`).
+    builder.append(m_optionSet.getDigest());
+
+    for (auto entryPointIndex : entryPointIndices)
+    {
+        builder.append(m_program->getEntryPointMangledName(entryPointIndex));
+        builder.append(m_program->getEntryPointNameOverride(entryPointIndex));
+    }
+
+    outKey = builder.finalize();
+    return shaderCache;
+}
+
+SlangResult TargetProgram::serializeLinkedIR(
+    List<Index> const& entryPointIndices,
+    DiagnosticSink* sink,
+    ISlangBlob** outBlob)
+{
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    LinkedIR linkedIR = linkIR(&codeGenContext);
+    if (!linkedIR.module || sink->getErrorCount())
+        return SLANG_FAIL;
+
+    // The linked IR is serialized without source locations, so that it only changes when the
+    // code does.
+    RIFF::Builder riff;
+    RIFF::BuildCursor cursor(riff);
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, PropertyKeys<IRModule>::IRModule);
+    writeSerializedModuleIR(cursor, linkedIR.module, nullptr);
+    return riff.writeToBlob(outBlob);
+}
+
+SlangResult TargetProgram::_getLinkedIRShaderCacheKey(
+    List<Index> const& entryPointIndices,
+    PersistentCache::Key& outKey)
+{
+    auto linkage = m_program->getLinkage();
+
+    // Anything wrong with the program is reported when its code is generated.
+    DiagnosticSink sink(linkage->getSourceManager(), nullptr);
+    ComPtr<ISlangBlob> serializedIR;
+    SLANG_RETURN_ON_FAIL(serializeLinkedIR(entryPointIndices, &sink, serializedIR.writeRef()));
+
+    // The same as the key from `_getShaderCacheAndKey`, with the linked IR in place of the
+    // contents of the source files.
+    DigestBuilder<SHA1> builder;
+    builder.append(toSlice("linked-ir"));
+    linkage->buildHash(builder, linkage->targets.indexOf(m_targetReq));
+    builder.append(m_optionSet.getDigest());
+    for (auto entryPointIndex : entryPointIndices)
+    {
+        builder.append(m_program->getEntryPointMangledName(entryPointIndex));
+        builder.append(m_program->getEntryPointNameOverride(entryPointIndex));
+    }
+    builder.append(serializedIR);
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+void TargetProgram::_precompileModulesForLinking(DiagnosticSink* sink)
+{
+    // Precompiled code is only linked into programs compiled with the same options as it
+    // was (see CodeGenContext::getDownstreamIROptionsKey), so precompile with this program's
+    // options rather than the target's defaults.
+    RefPtr<TargetRequest> targetReq = new TargetRequest(*m_targetReq);
+    targetReq->getOptionSet().overrideWith(m_optionSet);
+
+    m_program->enumerateModules(
+        [&](Module* module)
+        {
+            if (!module->getIRModule() || isFromCoreModule(module->getModuleDecl()))
+                return;
+
+            // A module that can't be precompiled is linked from its IR as usual, so its
+            // diagnostics are kept out of the program's.
+            DiagnosticSink precompileSink(
+                sink->getSourceManager(),
+                sink->getSourceLocationLexer());
+            module->precompileForTargetRequest(targetReq, &precompileSink, false);
+        });
+}
+
+// A shader cache entry holds everything about a result that can be queried through the API, so
+// that a hit can't be told apart from generating the code again: the code, the metadata, and
+// the diagnostics generating it reported.
+static const FourCC::RawValue kShaderCacheEntryFourCC = SLANG_FOUR_CC('S', 'C', 'E', 'N');
+static const FourCC::RawValue kShaderCacheCodeFourCC = SLANG_FOUR_CC('c', 'o', 'd', 'e');
+static const FourCC::RawValue kShaderCacheDiagnosticsFourCC = SLANG_FOUR_CC('d', 'i', 'a', 'g');
+static const FourCC::RawValue kShaderCacheMetadataFourCC = SLANG_FOUR_CC('m', 'e', 't', 'a');
+static const FourCC::RawValue kUsedBindingsFourCC = SLANG_FOUR_CC('b', 'n', 'd', 's');
+static const FourCC::RawValue kExportedFunctionsFourCC = SLANG_FOUR_CC('e', 'x', 'p', 'f');
+static const FourCC::RawValue kExportedFunctionFourCC = SLANG_FOUR_CC('n', 'a', 'm', 'e');
+static const FourCC::RawValue kCooperativeMatrixTypesFourCC = SLANG_FOUR_CC('c', 'm', 't', 'y');
+static const FourCC::RawValue kCooperativeMatrixCombinationsFourCC =
+    SLANG_FOUR_CC('c', 'm', 'c', 'o');
+static const FourCC::RawValue kCooperativeVectorTypesFourCC = SLANG_FOUR_CC('c', 'v', 't', 'y');
+static const FourCC::RawValue kCooperativeVectorCombinationsFourCC =
+    SLANG_FOUR_CC('c', 'v', 'c', 'o');
+static const FourCC::RawValue kDebugBuildIdentifierFourCC = SLANG_FOUR_CC('d', 'b', 'i', 'd');
+
+namespace
+{
+// While in scope, keeps a copy of the diagnostics written to a sink, so that they can be stored
+// in the shader cache. The diagnostics are still output as usual.
+class ShaderCacheDiagnosticCapture : public AppendBufferWriter
+{
+public:
+    ShaderCacheDiagnosticCapture(DiagnosticSink* sink)
+        : AppendBufferWriter(WriterFlag::IsStatic), m_sink(sink), m_previousWriter(sink->writer)
+    {
+        sink->writer = this;
+    }
+
+    ~ShaderCacheDiagnosticCapture() { m_sink->writer = m_previousWriter; }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL write(const char* chars, size_t numChars)
+        SLANG_OVERRIDE
+    {
+        m_diagnostics.append(chars, numChars);
+        if (m_previousWriter)
+            return m_previousWriter->write(chars, numChars);
+        m_sink->outputBuffer.append(chars, numChars);
+        return SLANG_OK;
+    }
+
+    String const& getDiagnostics() const { return m_diagnostics; }
+
+private:
+    DiagnosticSink* m_sink;
+    ISlangWriter* m_previousWriter;
+    StringBuilder m_diagnostics;
+};
+} // namespace
+
+// The cache key covers the compiler build, so the metadata structures can be stored as they
+// are laid out in memory.
+template<typename T>
+static void _addShaderCacheArrayChunk(
+    RIFF::BuildCursor& cursor,
+    RIFF::Chunk::Type type,
+    List<T> const& values)
+{
+    cursor.addDataChunk(type, values.getBuffer(), values.getCount() * sizeof(T));
+}
+
+template<typename T>
+static void _readShaderCacheArrayChunk(
+    RIFF::ListChunk const* listChunk,
+    RIFF::Chunk::Type type,
+    List<T>& outValues)
+{
+    auto dataChunk = listChunk->findDataChunk(type);
+    if (!dataChunk)
+        return;
+    outValues.setCount(Index(dataChunk->getPayloadSize() / sizeof(T)));
+    dataChunk->writePayloadInto(outValues.getBuffer(), outValues.getCount() * sizeof(T));
+}
+
+static String _readShaderCacheStringChunk(RIFF::DataChunk const* dataChunk)
+{
+    auto chars = static_cast<char const*>(dataChunk->getPayload());
+    return UnownedStringSlice(chars, chars + dataChunk->getPayloadSize());
+}
+
+static SlangResult _writeShaderCacheEntry(
+    IArtifact* artifact,
+    String const& diagnostics,
+    ISlangBlob** outEntry)
+{
+    ComPtr<ISlangBlob> code;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, code.writeRef()));
+
+    RIFF::Builder riff;
+    RIFF::BuildCursor cursor(riff);
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kShaderCacheEntryFourCC);
+    cursor.addDataChunk(kShaderCacheCodeFourCC, code->getBufferPointer(), code->getBufferSize());
+    cursor.addDataChunk(
+        kShaderCacheDiagnosticsFourCC,
+        diagnostics.getBuffer(),
+        diagnostics.getLength());
+
+    if (auto metadata = findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact))
+    {
+        auto metadataImpl = static_cast<ArtifactPostEmitMetadata*>(metadata);
+
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kShaderCacheMetadataFourCC);
+        _addShaderCacheArrayChunk(cursor, kUsedBindingsFourCC, metadataImpl->m_usedBindings);
+        {
+            SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kExportedFunctionsFourCC);
+            for (auto const& name : metadataImpl->m_exportedFunctionMangledNames)
+                cursor.addDataChunk(kExportedFunctionFourCC, name.getBuffer(), name.getLength());
+        }
+        _addShaderCacheArrayChunk(
+            cursor,
+            kCooperativeMatrixTypesFourCC,
+            metadataImpl->m_cooperativeMatrixTypes);
+        _addShaderCacheArrayChunk(
+            cursor,
+            kCooperativeMatrixCombinationsFourCC,
+            metadataImpl->m_cooperativeMatrixCombinations);
+        _addShaderCacheArrayChunk(
+            cursor,
+            kCooperativeVectorTypesFourCC,
+            metadataImpl->m_cooperativeVectorTypes);
+        _addShaderCacheArrayChunk(
+            cursor,
+            kCooperativeVectorCombinationsFourCC,
+            metadataImpl->m_cooperativeVectorCombinations);
+        cursor.addDataChunk(
+            kDebugBuildIdentifierFourCC,
+            metadataImpl->m_debugBuildIdentifier.getBuffer(),
+            metadataImpl->m_debugBuildIdentifier.getLength());
+    }
+
+    return riff.writeToBlob(outEntry);
+}
+
+// Recreates the result a shader cache entry was written for, reporting its diagnostics to
+// `sink` again. Returns nullptr if the entry can't be read, in which case it is treated as a
+// miss.
+static ComPtr<IArtifact> _readShaderCacheEntry(
+    CodeGenTarget target,
+    ISlangBlob* entry,
+    DiagnosticSink* sink)
+{
+    auto rootChunk = RIFF::RootChunk::getFromBlob(entry);
+    if (!rootChunk || rootChunk->getType() != kShaderCacheEntryFourCC)
+        return nullptr;
+    auto codeChunk = rootChunk->findDataChunk(kShaderCacheCodeFourCC);
+    if (!codeChunk)
+        return nullptr;
+
+    auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(target));
+    artifact->addRepresentationUnknown(RawBlob::create(
+        codeChunk->getPayload(),
+        codeChunk->getPayloadSize()));
+
+    if (auto metadataChunk = rootChunk->findListChunk(kShaderCacheMetadataFourCC))
+    {
+        auto metadata = ArtifactPostEmitMetadata::create();
+        auto metadataImpl = static_cast<ArtifactPostEmitMetadata*>(metadata.get());
+
+        _readShaderCacheArrayChunk(
+            metadataChunk,
+            kUsedBindingsFourCC,
+            metadataImpl->m_usedBindings);
+        if (auto namesChunk = metadataChunk->findListChunk(kExportedFunctionsFourCC))
+        {
+            for (auto chunk : namesChunk->getChildren())
+            {
+                if (auto nameChunk = as<RIFF::DataChunk>(chunk))
+                    metadataImpl->m_exportedFunctionMangledNames.add(
+                        _readShaderCacheStringChunk(nameChunk));
+            }
+        }
+        _readShaderCacheArrayChunk(
+            metadataChunk,
+            kCooperativeMatrixTypesFourCC,
+            metadataImpl->m_cooperativeMatrixTypes);
+        _readShaderCacheArrayChunk(
+            metadataChunk,
+            kCooperativeMatrixCombinationsFourCC,
+            metadataImpl->m_cooperativeMatrixCombinations);
+        _readShaderCacheArrayChunk(
+            metadataChunk,
+            kCooperativeVectorTypesFourCC,
+            metadataImpl->m_cooperativeVectorTypes);
+        _readShaderCacheArrayChunk(
+            metadataChunk,
+            kCooperativeVectorCombinationsFourCC,
+            metadataImpl->m_cooperativeVectorCombinations);
+        if (auto idChunk = metadataChunk->findDataChunk(kDebugBuildIdentifierFourCC))
+            metadataImpl->m_debugBuildIdentifier = _readShaderCacheStringChunk(idChunk);
+
+        ArtifactUtil::addAssociated(artifact, metadata);
+    }
+
+    // Report the warnings generating the code reported, as if it had been generated again.
+    if (auto diagnosticsChunk = rootChunk->findDataChunk(kShaderCacheDiagnosticsFourCC))
+    {
+        auto diagnostics = _readShaderCacheStringChunk(diagnosticsChunk);
+        if (diagnostics.getLength())
+            sink->diagnoseRaw(Severity::Warning, diagnostics.getUnownedSlice());
+    }
+
+    return artifact;
+}
+
+ComPtr<IArtifact> TargetProgram::_emitEntryPointsWithShaderCache(
+    List<Index> const& entryPointIndices,
+    DiagnosticSink* sink,
+    EndToEndCompileRequest* endToEndReq)
+{
+    PersistentCache::Key cacheKey;
+    PersistentCache* shaderCache = _getShaderCacheAndKey(entryPointIndices, endToEndReq, cacheKey);
+
+    if (shaderCache)
+    {
+        // On a hit we skip IR linking, optimization, emission and any downstream
+        // compiler invocation entirely.
+        ComPtr<ISlangBlob> cachedEntry;
+        if (SLANG_SUCCEEDED(shaderCache->readEntry(cacheKey, cachedEntry.writeRef())))
+        {
+            if (auto artifact = _readShaderCacheEntry(m_targetReq->getTarget(), cachedEntry, sink))
+                return artifact;
+        }
+    }
+
+    // A source edit misses in the cache above for every program using the edited file. The
+    // code is only generated again for the programs that the edit changes the linked IR of,
+    // the others are found under the key computed from their linked IR.
+    PersistentCache::Key linkedIRCacheKey;
+    bool hasLinkedIRCacheKey =
+        shaderCache &&
+        SLANG_SUCCEEDED(_getLinkedIRShaderCacheKey(entryPointIndices, linkedIRCacheKey));
+    if (hasLinkedIRCacheKey)
+    {
+        ComPtr<ISlangBlob> cachedEntry;
+        if (SLANG_SUCCEEDED(shaderCache->readEntry(linkedIRCacheKey, cachedEntry.writeRef())))
+        {
+            if (auto artifact = _readShaderCacheEntry(m_targetReq->getTarget(), cachedEntry, sink))
+            {
+                shaderCache->writeEntry(cacheKey, cachedEntry);
+                return artifact;
+            }
+        }
+    }
+
+    if (m_targetReq->getTarget() == CodeGenTarget::SPIRV &&
+        m_optionSet.getBoolOption(CompilerOptionName::SPIRVModuleLinking))
+    {
+        _precompileModulesForLinking(sink);
+    }
+
+    std::optional<ShaderCacheDiagnosticCapture> diagnosticCapture;
+    if (shaderCache)
+        diagnosticCapture.emplace(sink);
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    ComPtr<IArtifact> artifact;
+    if (SLANG_FAILED(codeGenContext.emitEntryPoints(artifact)) || !artifact)
+    {
+        return nullptr;
+    }
+
+    // Code generated with optimizations reduced to stay within a compile time budget depends
+    // on how long this compile took, so it must not be served to later compiles.
+    if (shaderCache && !sharedCodeGenContext.compileTimeBudget.wasDegraded())
+    {
+        // Failing to store a result is not an error; the next compile
+        // will simply miss in the cache again.
+        ComPtr<ISlangBlob> entry;
+        if (SLANG_SUCCEEDED(_writeShaderCacheEntry(
+                artifact,
+                diagnosticCapture->getDiagnostics(),
+                entry.writeRef())))
+        {
+            shaderCache->writeEntry(cacheKey, entry);
+            if (hasLinkedIRCacheKey)
+                shaderCache->writeEntry(linkedIRCacheKey, entry);
+        }
+    }
+
+    return artifact;
+}
+
 IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
 {
     {
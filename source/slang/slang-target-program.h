@@ -7,6 +7,7 @@
 // linked program/binary and/or its entry points.
 //
 
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-smart-pointer.h"
 #include "slang-hlsl-to-vulkan-layout-options.h"
 #include "slang-ir.h"
@@ -110,6 +111,16 @@ public:
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
 
+    /// Link the IR of the given entry points for the target, without optimizing it, and
+    /// serialize it without source locations.
+    ///
+    /// The result only changes when the code the entry points use does, so it tells whether
+    /// code generated for an earlier version of the program can be reused.
+    SlangResult serializeLinkedIR(
+        List<Index> const& entryPointIndices,
+        DiagnosticSink* sink,
+        ISlangBlob** outBlob);
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions()
@@ -125,6 +136,36 @@ public:
 private:
     RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
+    /// Get the linkage's shader cache along with the key under which the code
+    /// generated for `entryPointIndices` is stored.
+    ///
+    /// Returns null if there is no shader cache, or if the result of this
+    /// particular compile should not be cached.
+    PersistentCache* _getShaderCacheAndKey(
+        List<Index> const& entryPointIndices,
+        EndToEndCompileRequest* endToEndReq,
+        PersistentCache::Key& outKey);
+
+    /// Get the key under which the code generated for `entryPointIndices` is also stored in
+    /// the shader cache, computed from the linked IR rather than from the source files.
+    ///
+    /// An edit to a source file changes the key from `_getShaderCacheAndKey` of every program
+    /// using the file, but this key only for the programs whose code changes.
+    SlangResult _getLinkedIRShaderCacheKey(
+        List<Index> const& entryPointIndices,
+        PersistentCache::Key& outKey);
+
+    /// Code generation with a lookup in the shader cache before, and a store
+    /// to the shader cache after, whenever the shader cache is enabled.
+    /// Precompile the modules linked into the program for the target, so that
+    /// their code is generated once and linked into each entry point.
+    void _precompileModulesForLinking(DiagnosticSink* sink);
+
+    ComPtr<IArtifact> _emitEntryPointsWithShaderCache(
+        List<Index> const& entryPointIndices,
+        DiagnosticSink* sink,
+        EndToEndCompileRequest* endToEndReq);
+
     // The program being compiled or laid out
     ComponentType* m_program;
 
@@ -31,13 +31,18 @@ TargetRequest::TargetRequest(Linkage* linkage, CodeGenTarget format)
 {
     optionSet = linkage->m_optionSet;
     optionSet.add(CompilerOptionName::Target, format);
+    m_sharedTypeLayoutCache = new SharedTypeLayoutCache();
 }
 
 TargetRequest::TargetRequest(const TargetRequest& other)
     : RefObject(), linkage(other.linkage), optionSet(other.optionSet)
 {
+    // The copy may go on to have different options, so it doesn't share layouts.
+    m_sharedTypeLayoutCache = new SharedTypeLayoutCache();
 }
 
+TargetRequest::~TargetRequest() {}
+
 
 Session* TargetRequest::getSession()
 {
@@ -116,6 +116,8 @@ public:
 
     TargetRequest(const TargetRequest& other);
 
+    ~TargetRequest();
+
     Linkage* getLinkage() { return linkage; }
 
     Session* getSession();
@@ -148,6 +150,9 @@ public:
 
     TypeLayout* getTypeLayout(Type* type, slang::LayoutRules rules);
 
+    /// Get the layouts of types shared by all programs laid out for this target.
+    SharedTypeLayoutCache* getSharedTypeLayoutCache() { return m_sharedTypeLayoutCache; }
+
     CompilerOptionSet& getOptionSet() { return optionSet; }
 
     CapabilitySet getTargetCaps();
@@ -161,6 +166,7 @@ private:
     CompilerOptionSet optionSet;
     CapabilitySet cookedCapabilities;
     RefPtr<HLSLToVulkanLayoutOptions> hlslToVulkanOptions;
+    RefPtr<SharedTypeLayoutCache> m_sharedTypeLayoutCache;
     // Layout/codegen threads share one TargetRequest and lazily initialize this derived state.
     std::mutex m_mutex;
 };
@@ -5272,6 +5272,131 @@ static TypeLayoutResult _updateLayout(
     return result;
 }
 
+/// Is the layout of `type` independent of the program it is laid out in?
+///
+/// This holds for types made only of scalars, vectors, matrices, fixed size arrays and
+/// `struct`s. The layouts of anything that could depend on the program, such as generic
+/// parameters, interfaces, `extern` types or link-time constants, aren't shared.
+static bool _isTypeLayoutShareable(TypeLayoutContext const& context, Type* type)
+{
+    if (as<BasicExpressionType>(type) || as<VectorExpressionType>(type) ||
+        as<MatrixExpressionType>(type))
+    {
+        return true;
+    }
+    if (auto arrayType = as<ArrayExpressionType>(type))
+    {
+        return !arrayType->isUnsized() && as<ConstantIntVal>(arrayType->getElementCount()) &&
+               _isTypeLayoutShareable(context, arrayType->getElementType());
+    }
+    auto structDeclRef = isDeclRefTypeOf<StructDecl>(type);
+    if (!structDeclRef || as<ConditionalType>(type))
+    {
+        return false;
+    }
+    auto structDecl = structDeclRef.getDecl();
+    if (structDecl->hasModifier<ExternAttribute>() || structDecl->hasModifier<ExternModifier>())
+    {
+        return false;
+    }
+    for (auto inheritanceDeclRef :
+         getMembersOfType<InheritanceDecl>(context.astBuilder, structDeclRef))
+    {
+        auto baseType = getSup(context.astBuilder, inheritanceDeclRef);
+        if (isInterfaceType(baseType))
+            continue;
+        if (!_isTypeLayoutShareable(context, baseType))
+            return false;
+    }
+    for (auto field : getFields(context.astBuilder, structDeclRef, MemberFilterStyle::Instance))
+    {
+        if (!_isTypeLayoutShareable(context, getType(context.astBuilder, field)))
+            return false;
+    }
+    return true;
+}
+
+static bool _mayTypeLayoutDependOnSpecialization(
+    ASTBuilder* astBuilder,
+    Val* val,
+    HashSet<Val*>& visitedVals)
+{
+    if (!val || !visitedVals.add(val))
+        return false;
+
+    // Witnesses only tell us how a type conforms to an interface, not how it is laid out.
+    if (as<Witness>(val))
+        return false;
+
+    if (auto type = as<Type>(val))
+    {
+        if (isInterfaceType(type))
+            return true;
+    }
+    if (as<IntVal>(val) && !as<ConstantIntVal>(val))
+        return true;
+
+    for (Index i = 0; i < val->getOperandCount(); i++)
+    {
+        auto& operand = val->m_operands[i];
+        switch (operand.kind)
+        {
+        case ValNodeOperandKind::ValNode:
+            if (_mayTypeLayoutDependOnSpecialization(astBuilder, val->getOperand(i), visitedVals))
+                return true;
+            break;
+        case ValNodeOperandKind::ASTNode:
+            {
+                auto decl = as<Decl>(operand.getDecl());
+                if (as<InterfaceDecl>(decl) || as<GlobalGenericParamDecl>(decl) ||
+                    as<GlobalGenericValueParamDecl>(decl) || as<GenericTypeParamDeclBase>(decl) ||
+                    as<GenericValueParamDecl>(decl) || as<AssocTypeDecl>(decl))
+                {
+                    return true;
+                }
+                if (decl &&
+                    (decl->hasModifier<ExternAttribute>() || decl->hasModifier<ExternModifier>()))
+                {
+                    return true;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // The fields of a `struct` aren't operands of its type, so we walk them as well.
+    auto structDeclRef = isDeclRefTypeOf<StructDecl>(val);
+    if (!structDeclRef)
+        return false;
+    for (auto inheritanceDeclRef : getMembersOfType<InheritanceDecl>(astBuilder, structDeclRef))
+    {
+        auto baseType = getSup(astBuilder, inheritanceDeclRef);
+        if (isInterfaceType(baseType))
+            continue;
+        if (_mayTypeLayoutDependOnSpecialization(astBuilder, baseType, visitedVals))
+            return true;
+    }
+    for (auto field : getFields(astBuilder, structDeclRef, MemberFilterStyle::Instance))
+    {
+        if (_mayTypeLayoutDependOnSpecialization(
+                astBuilder,
+                getType(astBuilder, field),
+                visitedVals))
+            return true;
+    }
+    return false;
+}
+
+bool mayTypeLayoutDependOnSpecialization(ASTBuilder* astBuilder, Type* type)
+{
+    HashSet<Val*> visitedVals;
+    return _mayTypeLayoutDependOnSpecialization(astBuilder, type, visitedVals);
+}
+
+static TypeLayoutResult _createTypeLayoutImpl(TypeLayoutContext& context, Type* type);
+
 static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type)
 {
     if (context.recursionDepth >= kMaxTypeNestingDepth)
@@ -5300,6 +5425,39 @@ static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type
         return *layoutResultPtr;
     }
 
+    // Types whose layout doesn't depend on the program are laid out once for the target,
+    // and the layout is shared by every program that uses them.
+    auto sharedCache = context.targetReq ? context.targetReq->getSharedTypeLayoutCache() : nullptr;
+    if (!sharedCache || !context.rules)
+    {
+        return _createTypeLayoutImpl(context, type);
+    }
+
+    SharedTypeLayoutCache::Key sharedKey = {type, context.rules, context.matrixLayoutMode};
+    TypeLayoutResult sharedResult;
+    if (sharedCache->tryGetLayout(sharedKey, sharedResult))
+    {
+        return sharedResult;
+    }
+
+    if (!_isTypeLayoutShareable(context, type))
+    {
+        return _createTypeLayoutImpl(context, type);
+    }
+
+    auto result = _createTypeLayoutImpl(context, type);
+
+    // A type nested too deeply gets an invalid layout along with a diagnostic, which
+    // other programs would miss if it were shared.
+    if (result.layout && result.info.size.isValid())
+    {
+        sharedCache->addLayout(sharedKey, result);
+    }
+    return result;
+}
+
+static TypeLayoutResult _createTypeLayoutImpl(TypeLayoutContext& context, Type* type)
+{
     auto rules = context.rules;
 
     if (auto parameterGroupType = as<ParameterGroupType>(type))
@@ -6371,6 +6529,37 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
     return createSimpleTypeLayout(SimpleLayoutInfo(), type, rules).layout;
 }
 
+bool SharedTypeLayoutCache::tryGetLayout(Key const& key, TypeLayoutResult& outResult)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_layouts.tryGetValue(key, outResult);
+}
+
+void SharedTypeLayoutCache::addLayout(Key const& key, TypeLayoutResult const& result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // If another thread laid the type out first, keep its layout so all programs share one.
+    m_layouts.addIfNotExists(key, result);
+}
+
+RefPtr<TypeLayout> SharedTypeLayoutCache::tryGetParameterLayout(ParameterKey const& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RefPtr<TypeLayout> layout;
+    m_parameterLayouts.tryGetValue(key, layout);
+    return layout;
+}
+
+RefPtr<TypeLayout> SharedTypeLayoutCache::addParameterLayout(
+    ParameterKey const& key,
+    TypeLayout* layout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // As with `addLayout`, the first layout added wins.
+    m_parameterLayouts.addIfNotExists(key, layout);
+    return m_parameterLayouts.getValue(key);
+}
+
 RefPtr<TypeLayout> createTypeLayout(TypeLayoutContext& context, Type* type)
 {
     return _createTypeLayout(context, type).layout;
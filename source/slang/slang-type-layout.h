@@ -8,8 +8,10 @@
 #include "slang.h"
 
 #include <algorithm>
+#include <atomic>
 #include <compare>
 #include <limits>
+#include <mutex>
 
 namespace Slang
 {
@@ -858,7 +860,18 @@ public:
         List<SubObjectRangeInfo> m_subObjectRanges;
     };
 
-    RefPtr<ExtendedInfo> m_extendedInfo;
+    /// Computed on first use by `getExtendedTypeLayout`, and never modified after.
+    ///
+    /// Reflection can be queried from several threads at once, so the info is published
+    /// with a compare-and-swap rather than behind a lock. The type layout holds a
+    /// reference to the published info.
+    std::atomic<ExtendedInfo*> m_extendedInfo = nullptr;
+
+    ~TypeLayout()
+    {
+        if (auto extendedInfo = m_extendedInfo.load(std::memory_order_acquire))
+            extendedInfo->releaseReference();
+    }
 };
 
 typedef unsigned int VarLayoutFlags;
@@ -1513,6 +1526,75 @@ struct TypeLayoutResult
     }
 };
 
+/// Layouts of types that don't depend on the program they are laid out in, such as
+/// plain data `struct` types. One cache is kept per target, so that programs laid out
+/// for the target share a single `TypeLayout` for each such type.
+class SharedTypeLayoutCache : public RefObject
+{
+public:
+    struct Key
+    {
+        Type* type;
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.hashValue(type);
+            hasher.hashValue(rules);
+            hasher.hashValue(matrixLayoutMode);
+            return hasher.getResult();
+        }
+        bool operator==(Key const& other) const
+        {
+            return type == other.type && rules == other.rules &&
+                   matrixLayoutMode == other.matrixLayoutMode;
+        }
+    };
+
+    bool tryGetLayout(Key const& key, TypeLayoutResult& outResult);
+    void addLayout(Key const& key, TypeLayoutResult const& result);
+
+    /// Identifies the layout of a global shader parameter, which also depends on the
+    /// modifiers of the parameter's declaration.
+    struct ParameterKey
+    {
+        VarDeclBase* decl;
+        Type* type;
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.hashValue(decl);
+            hasher.hashValue(type);
+            hasher.hashValue(rules);
+            hasher.hashValue(matrixLayoutMode);
+            return hasher.getResult();
+        }
+        bool operator==(ParameterKey const& other) const
+        {
+            return decl == other.decl && type == other.type && rules == other.rules &&
+                   matrixLayoutMode == other.matrixLayoutMode;
+        }
+    };
+
+    /// Layouts of global shader parameters whose types don't depend on specialization,
+    /// so that the specializations of a program can share them.
+    RefPtr<TypeLayout> tryGetParameterLayout(ParameterKey const& key);
+
+    /// Add `layout` for `key`, returning the layout that is shared from now on.
+    RefPtr<TypeLayout> addParameterLayout(ParameterKey const& key, TypeLayout* layout);
+
+private:
+    // Programs for the same target can be laid out on several threads at once.
+    std::mutex m_mutex;
+    Dictionary<Key, TypeLayoutResult> m_layouts;
+    Dictionary<ParameterKey, RefPtr<TypeLayout>> m_parameterLayouts;
+};
+
 struct TypeLayoutContext
 {
     ASTBuilder* astBuilder;
@@ -1717,6 +1799,11 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
 // according to the layout rules in `context`.
 RefPtr<TypeLayout> createTypeLayout(TypeLayoutContext& context, Type* type);
 
+// Could the layout of `type` change with the arguments its program is
+// specialized with? This is conservative, answering `true` for anything
+// that refers to generic parameters, interfaces or `extern` declarations.
+bool mayTypeLayoutDependOnSpecialization(ASTBuilder* astBuilder, Type* type);
+
 // A wrapper for createTypeLayout which copies the context applying the
 // provided rules with TypeLayoutContext::with
 RefPtr<TypeLayout> createTypeLayoutWith(
@@ -85,6 +85,8 @@ SIMPLE_UNARY_SCALAR_FUNC(Neg, -);
 SIMPLE_UNARY_SCALAR_FUNC(Not, !);
 SIMPLE_UNARY_SCALAR_FUNC(BitNot, ~);
 
+// The operands are copied into local arrays first, so that the compiler can assume
+// they don't alias and turn the element loop into SIMD instructions.
 template<typename ScalarFunc, typename TR, typename T1, typename T2, int elementCount>
 struct BinaryVectorFunc
 {
@@ -92,13 +94,16 @@ struct BinaryVectorFunc
     {
         SLANG_UNUSED(context);
         SLANG_UNUSED(userData);
-        TR* dst = (TR*)inst->getOperand(0).getPtr();
-        T1* src1 = (T1*)inst->getOperand(1).getPtr();
-        T2* src2 = (T2*)inst->getOperand(2).getPtr();
+        T1 src1[elementCount];
+        T2 src2[elementCount];
+        TR dst[elementCount];
+        memcpy(src1, inst->getOperand(1).getPtr(), sizeof(src1));
+        memcpy(src2, inst->getOperand(2).getPtr(), sizeof(src2));
         for (int i = 0; i < elementCount; ++i)
         {
             ScalarFunc::template run<TR, T1, T2>(&dst[i], &src1[i], &src2[i]);
         }
+        memcpy(inst->getOperand(0).getPtr(), dst, sizeof(dst));
     }
 };
 
@@ -314,12 +319,14 @@ struct UnaryVectorFunc
     {
         SLANG_UNUSED(context);
         SLANG_UNUSED(userData);
-        TR* dst = (TR*)inst->getOperand(0).getPtr();
-        T1* src1 = (T1*)inst->getOperand(1).getPtr();
+        T1 src1[elementCount];
+        TR dst[elementCount];
+        memcpy(src1, inst->getOperand(1).getPtr(), sizeof(src1));
         for (int i = 0; i < elementCount; ++i)
         {
             ScalarFunc::template run<TR, T1>(&dst[i], &src1[i]);
         }
+        memcpy(inst->getOperand(0).getPtr(), dst, sizeof(dst));
     }
 };
 
@@ -1093,4 +1100,114 @@ VMExtFunction mapInstToFunction(
     return VMExtFunction();
 }
 
+////////
+// Superinstructions.
+//
+// A superinstruction handler runs a fixed sequence of handlers on consecutive
+// instructions in a single dispatch. Since the handlers are template arguments,
+// the compiler can inline them into one function. Only the last handler of a
+// sequence may change `m_currentInst`.
+
+template<VMExtFunction first, VMExtFunction second>
+static void superInst2Handler(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void* userData)
+{
+    auto ctx = convert(inCtx);
+    auto secondInst = inst->getNextInst();
+    first(inCtx, inst, userData);
+    ctx->m_currentInst = secondInst->getNextInst();
+    second(inCtx, secondInst, userData);
+}
+
+template<VMExtFunction first, VMExtFunction second, VMExtFunction third>
+static void superInst3Handler(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void* userData)
+{
+    auto ctx = convert(inCtx);
+    auto secondInst = inst->getNextInst();
+    auto thirdInst = secondInst->getNextInst();
+    first(inCtx, inst, userData);
+    second(inCtx, secondInst, userData);
+    ctx->m_currentInst = thirdInst->getNextInst();
+    third(inCtx, thirdInst, userData);
+}
+
+struct SuperInstEntry
+{
+    VMExtFunction handlers[kMaxSuperInstLength];
+    VMExtFunction superHandler;
+};
+
+#define SUPER_INST_2(a, b) {{a, b}, superInst2Handler<a, b>}
+#define SUPER_INST_3(a, b, c) {{a, b, c}, superInst3Handler<a, b, c>}
+
+// A compare followed by a branch on its result, as emitted for loop and `if` conditions.
+#define COMPARE_JUMP_IF(func, T) \
+    SUPER_INST_2((BinaryVectorFunc<func##ScalarFunc, uint32_t, T, T, 1>::run), jumpIfHandler)
+
+#define COMPARE_JUMP_IF_ENTRIES(T)                                                   \
+    COMPARE_JUMP_IF(Less, T), COMPARE_JUMP_IF(Leq, T), COMPARE_JUMP_IF(Greater, T), \
+        COMPARE_JUMP_IF(Geq, T), COMPARE_JUMP_IF(Equal, T), COMPARE_JUMP_IF(Neq, T)
+
+// A read-modify-write of a 32-bit value through a pointer.
+#define LOAD_ARITH_STORE(func, T)                                 \
+    SUPER_INST_3(                                                 \
+        loadHandler32,                                            \
+        (BinaryVectorFunc<func##ScalarFunc, T, T, T, 1>::run),    \
+        storeHandler32)
+
+#define LOAD_ARITH_STORE_ENTRIES(T) \
+    LOAD_ARITH_STORE(Add, T), LOAD_ARITH_STORE(Sub, T), LOAD_ARITH_STORE(Mul, T)
+
+static const SuperInstEntry kSuperInstEntries[] = {
+    COMPARE_JUMP_IF_ENTRIES(int32_t),
+    COMPARE_JUMP_IF_ENTRIES(uint32_t),
+    COMPARE_JUMP_IF_ENTRIES(float),
+    LOAD_ARITH_STORE_ENTRIES(int32_t),
+    LOAD_ARITH_STORE_ENTRIES(uint32_t),
+    LOAD_ARITH_STORE_ENTRIES(float),
+
+    // Phi copies followed by the jump to the target block.
+    SUPER_INST_2(copyHandler32, copyHandler32),
+    SUPER_INST_2(copyHandler32, jumpHandler),
+    SUPER_INST_2(copyHandler64, copyHandler64),
+    SUPER_INST_2(copyHandler64, jumpHandler),
+};
+
+#undef LOAD_ARITH_STORE_ENTRIES
+#undef LOAD_ARITH_STORE
+#undef COMPARE_JUMP_IF_ENTRIES
+#undef COMPARE_JUMP_IF
+#undef SUPER_INST_3
+#undef SUPER_INST_2
+
+VMExtFunction findSuperInstHandler(ArrayView<VMExtFunction> handlers)
+{
+    const SuperInstEntry* bestEntry = nullptr;
+    Index bestLength = 0;
+    for (auto& entry : kSuperInstEntries)
+    {
+        Index length = 0;
+        while (length < kMaxSuperInstLength && entry.handlers[length])
+            length++;
+        if (length <= bestLength || length > handlers.getCount())
+            continue;
+
+        bool matches = true;
+        for (Index i = 0; i < length; i++)
+        {
+            if (entry.handlers[i] != handlers[i])
+            {
+                matches = false;
+                break;
+            }
+        }
+        if (matches)
+        {
+            bestEntry = &entry;
+            bestLength = length;
+        }
+    }
+
+    return bestEntry ? bestEntry->superHandler : nullptr;
+}
+
 } // namespace Slang
@@ -11,6 +11,13 @@ slang::VMExtFunction mapInstToFunction(
     VMModuleView* module,
     Dictionary<String, slang::VMExtFunction>& extInstHandlers);
 
+// The longest sequence of instructions that can be merged into one superinstruction.
+static const Index kMaxSuperInstLength = 3;
+
+// Find a superinstruction handler that runs the longest prefix of `handlers`, the
+// handlers of consecutive instructions, in one dispatch. Returns nullptr if there is none.
+slang::VMExtFunction findSuperInstHandler(ArrayView<slang::VMExtFunction> handlers);
+
 } // namespace Slang
 
 #endif
@@ -21,6 +21,20 @@ ISlangUnknown* ByteCodeInterpreter::getInterface(const Guid& guid)
     return nullptr;
 }
 
+// Let each instruction that starts a known sequence run the whole sequence in one
+// dispatch. The later instructions of the sequence keep their own handlers, so
+// jumping directly to one of them still works.
+static void fuseSuperInsts(List<VMExecInstHeader*>& insts, List<VMExtFunction>& handlers)
+{
+    for (Index i = 0; i < insts.getCount(); i++)
+    {
+        auto sequence =
+            handlers.getArrayView(i, Math::Min(kMaxSuperInstLength, handlers.getCount() - i));
+        if (auto superHandler = findSuperInstHandler(sequence))
+            insts[i]->functionPtr = superHandler;
+    }
+}
+
 SlangResult ByteCodeInterpreter::prepareModuleForExecution()
 {
     m_stringLits.clear();
@@ -51,6 +65,8 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
             memcpy(exeFunc.m_codeBuffer.getBuffer(), func.functionCode, func.header->codeSize);
 
         // Replace the instruction headers with function pointers
+        List<VMExecInstHeader*> insts;
+        List<VMExtFunction> handlers;
         for (auto inst : exeFunc)
         {
             VMInstHeader* instHeader = reinterpret_cast<VMInstHeader*>(inst);
@@ -65,6 +81,8 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
                 return SLANG_FAIL;
             }
             inst->functionPtr = handler;
+            insts.add(inst);
+            handlers.add(handler);
             for (uint32_t operandIdx = 0; operandIdx < instHeader->operandCount; operandIdx++)
             {
                 auto& operand = instHeader->getOperand(operandIdx);
@@ -87,6 +105,8 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
                 }
             }
         }
+
+        fuseSuperInsts(insts, handlers);
     }
 
     return SLANG_OK;
@@ -149,12 +169,19 @@ ByteCodeInterpreter::selectFunctionByIndex(uint32_t functionIndex)
             m_moduleView.functionCount);
         return SLANG_FAIL;
     }
+    beginInvocation(functionIndex);
+    m_selectedFunctionIndex = (int)functionIndex;
+    return SLANG_OK;
+}
+
+void ByteCodeInterpreter::beginInvocation(uint32_t functionIndex)
+{
     auto func = m_moduleView.getFunction(functionIndex);
+    m_stack.clear();
     m_currentFuncCode = m_functions[functionIndex].m_codeBuffer.getBuffer();
     m_currentInst = reinterpret_cast<VMExecInstHeader*>(m_currentFuncCode);
     m_workingSetBuffer.setCount(func.header->workingSetSizeInBytes / sizeof(uint64_t));
     m_currentWorkingSet = m_workingSetBuffer.getBuffer();
-    return SLANG_OK;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL
@@ -192,6 +219,43 @@ ByteCodeInterpreter::execute(void* argumentData, size_t argumentSize)
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ByteCodeInterpreter::executeBatch(
+    uint32_t invocationCount,
+    const void* argumentData,
+    size_t argumentSize,
+    size_t argumentStride,
+    void* outReturnValues,
+    size_t returnValueStride)
+{
+    if (m_selectedFunctionIndex < 0)
+    {
+        reportError("No function selected for execution");
+        return SLANG_FAIL;
+    }
+    if (invocationCount > 1 && argumentStride < argumentSize)
+    {
+        reportError("Argument stride is smaller than the argument size.");
+        return SLANG_FAIL;
+    }
+
+    // The module is relocated once when it is loaded, so each invocation only has to
+    // reset the execution state and copy in its own arguments.
+    for (uint32_t i = 0; i < invocationCount; i++)
+    {
+        beginInvocation((uint32_t)m_selectedFunctionIndex);
+        auto arguments = argumentData ? (uint8_t*)argumentData + i * argumentStride : nullptr;
+        SLANG_RETURN_ON_FAIL(execute(arguments, argumentSize));
+        if (outReturnValues && m_returnValSize)
+        {
+            memcpy(
+                (uint8_t*)outReturnValues + i * returnValueStride,
+                m_returnRegister.getBuffer(),
+                Math::Min(m_returnValSize, returnValueStride));
+        }
+    }
+    return SLANG_OK;
+}
+
 ByteCodeInterpreter::ByteCodeInterpreter()
 {
     m_printCallback = defaultPrintCallback;
@@ -133,6 +133,21 @@ public:
 
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     setPrintCallback(VMPrintFunc callback, void* userData) override;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL executeBatch(
+        uint32_t invocationCount,
+        const void* argumentData,
+        size_t argumentSize,
+        size_t argumentStride,
+        void* outReturnValues,
+        size_t returnValueStride) override;
+
+private:
+    // Reset the call stack, working set and instruction pointer to the start of
+    // the function at `functionIndex`.
+    void beginInvocation(uint32_t functionIndex);
+
+    int m_selectedFunctionIndex = -1;
 };
 
 } // namespace Slang
@@ -35,8 +35,13 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     doc->setText(text.getUnownedSlice());
     doc->setPath(path);
     openedDocuments[path] = doc;
-    workspaceSearchPaths.add(Path::getParentDirectory(path));
-    invalidate();
+
+    // A new search path, or one derived from the open documents, can change which file an
+    // `import` resolves to, so modules loaded so far can't be reused.
+    if (workspaceSearchPaths.add(Path::getParentDirectory(path)) || !searchInWorkspace)
+        invalidate();
+    else
+        invalidateDocument(path);
     return doc.Ptr();
 }
 
@@ -53,27 +58,28 @@ void Workspace::changeDoc(
         auto startOffset = doc->getOffset(line, col);
         doc->zeroBasedUTF16LocToOneBasedUTF8Loc(range.end.line, range.end.character, line, col);
         auto endOffset = doc->getOffset(line, col);
-        auto originalText = doc->getText().getUnownedSlice();
-        StringBuilder newText;
-        if (startOffset != -1)
-            newText << originalText.head(startOffset);
-        newText << text;
-        if (endOffset != -1)
-            newText << originalText.tail(endOffset);
-        changeDoc(doc.Ptr(), newText.produceString());
+        if (startOffset == -1)
+            startOffset = 0;
+        if (endOffset == -1)
+            endOffset = doc->getText().getLength();
+        doc->replaceText(startOffset, Math::Max(startOffset, endOffset), text);
+        invalidateDocument(doc->getPath());
     }
 }
 
 void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 {
     doc->setText(newText);
-    invalidate();
+    invalidateDocument(doc->getPath());
 }
 
 void Workspace::closeDoc(const String& path)
 {
     openedDocuments.remove(path);
-    invalidate();
+    if (!searchInWorkspace)
+        invalidate();
+    else
+        invalidateDocument(path);
 }
 
 bool Workspace::updatePredefinedMacros(List<String> macros)
@@ -196,7 +202,22 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
 
 void Workspace::invalidate()
 {
+    if (currentCompletionVersion)
+        currentCompletionVersion->isReusable = false;
     currentVersion = nullptr;
+    previousVersion = nullptr;
+}
+
+void Workspace::invalidateDocument(const String& path)
+{
+    if (currentVersion)
+        previousVersion = currentVersion;
+    currentVersion = nullptr;
+
+    if (previousVersion)
+        previousVersion->changedDocumentPaths.add(path);
+    if (currentCompletionVersion)
+        currentCompletionVersion->changedDocumentPaths.add(path);
 }
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
@@ -528,6 +549,23 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     return version;
 }
 
+// The AST of every module that is checked again stays in the shared linkage, so start over
+// with a fresh linkage after this many versions to bound memory use.
+static const Index kMaxLinkageReuseCount = 32;
+
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion(
+    WorkspaceVersion* previous,
+    bool reuseDocumentModules)
+{
+    if (!previous || !previous->isReusable || previous->linkageReuseCount >= kMaxLinkageReuseCount)
+        return createWorkspaceVersion();
+
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->reuseModulesFrom(previous, reuseDocumentModules);
+    return version;
+}
+
 SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 {
     String canonnicalPath;
@@ -543,12 +581,17 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        currentVersion = createWorkspaceVersion(previousVersion, true);
+        previousVersion = nullptr;
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
 {
-    currentCompletionVersion = createWorkspaceVersion();
+    // Checking of the document being completed depends on the cursor location, so only
+    // modules loaded through `import` are reused between completion requests.
+    currentCompletionVersion = createWorkspaceVersion(currentCompletionVersion, false);
     currentCompletionVersion->linkage->contentAssistInfo.checkingMode =
         ContentAssistCheckingMode::Completion;
     return currentCompletionVersion.Ptr();
@@ -579,157 +622,6 @@ void* Workspace::castAs(const Guid& guid)
     return getObject(guid);
 }
 
-void DocumentVersion::setText(const String& newText)
-{
-    text = newText;
-    StringUtil::calcLines(text.getUnownedSlice(), lines);
-    mapUTF16CharIndexToCodePointIndex.clear();
-    mapCodePointIndexToUTF8ByteOffset.clear();
-}
-
-void DocumentVersion::ensureUTFBoundsAvailable()
-{
-    for (auto slice : lines)
-    {
-        List<Index> bounds;
-        List<Index> utf8Bounds;
-        Index index = 0;
-        Index codePointIndex = 0;
-        while (index < slice.getLength())
-        {
-            auto startIndex = index;
-            const Char32 codePoint = getUnicodePointFromUTF8(
-                [&]() -> Byte
-                {
-                    if (index < slice.getLength())
-                        return slice[index++];
-                    else
-                        return '\0';
-                });
-            if (!codePoint)
-                break;
-
-            Char16 buffer[2];
-            int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
-            for (int i = 0; i < count; i++)
-                bounds.add(codePointIndex);
-            utf8Bounds.add(startIndex);
-            codePointIndex++;
-        }
-        bounds.add(slice.getLength());
-        utf8Bounds.add(slice.getLength());
-        mapUTF16CharIndexToCodePointIndex.add(_Move(bounds));
-        mapCodePointIndexToUTF8ByteOffset.add(_Move(utf8Bounds));
-    }
-}
-
-ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
-{
-    if (!mapUTF16CharIndexToCodePointIndex.getCount())
-    {
-        ensureUTFBoundsAvailable();
-    }
-    return line >= 1 && line <= mapUTF16CharIndexToCodePointIndex.getCount()
-               ? mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView()
-               : ArrayView<Index>();
-}
-
-ArrayView<Index> DocumentVersion::getUTF8Boundaries(Index line)
-{
-    if (!mapCodePointIndexToUTF8ByteOffset.getCount())
-    {
-        ensureUTFBoundsAvailable();
-    }
-    return line >= 1 && line <= mapCodePointIndexToUTF8ByteOffset.getCount()
-               ? mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView()
-               : ArrayView<Index>();
-}
-
-void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
-    Index inLine,
-    Index inCol,
-    int64_t& outLine,
-    int64_t& outCol)
-{
-    if (inLine <= 0)
-    {
-        outLine = 0;
-        outCol = 0;
-    }
-
-    Index rsLine = inLine - 1;
-    auto bounds = getUTF16Boundaries(inLine);
-    outLine = rsLine;
-    if (bounds.getCount() != 0)
-        outCol = std::lower_bound(bounds.begin(), bounds.end(), inCol - 1) - bounds.begin();
-    else
-        outCol = inCol - 1;
-}
-
-void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
-    Index inLine,
-    Index inCol,
-    int32_t& outLine,
-    int32_t& outCol)
-{
-    int64_t ioutLine, ioutCol;
-    oneBasedUTF8LocToZeroBasedUTF16Loc(inLine, inCol, ioutLine, ioutCol);
-    outLine = (int32_t)ioutLine;
-    outCol = (int32_t)ioutCol;
-}
-
-void DocumentVersion::zeroBasedUTF16LocToOneBasedUTF8Loc(
-    Index inLine,
-    Index inCol,
-    Index& outLine,
-    Index& outCol)
-{
-    outLine = inLine + 1;
-    auto bounds = getUTF16Boundaries(inLine + 1);
-    outCol = inCol >= 0 && inCol < bounds.getCount() ? bounds[inCol] + 1 : 0;
-}
-
-static bool _isIdentifierChar(char ch)
-{
-    return ch >= 'a' && ch <= 'z' || ch >= 'A' && ch <= 'Z' || ch >= '0' && ch <= '9' || ch == '_';
-}
-
-UnownedStringSlice DocumentVersion::peekIdentifier(Index& offset)
-{
-    Index start = offset;
-    Index end = offset;
-    if (start >= text.getLength())
-        return UnownedStringSlice("");
-
-    while (start >= 0 && _isIdentifierChar(text[start]))
-        start--;
-    while (end < text.getLength() && _isIdentifierChar(text[end]))
-        end++;
-    offset = start + 1;
-    if (end > offset)
-        return text.getUnownedSlice().subString(start + 1, end - start - 1);
-    return UnownedStringSlice("");
-}
-
-int DocumentVersion::getTokenLength(Index offset)
-{
-    if (offset >= 0)
-    {
-        Index pos = offset;
-        for (; pos < text.getLength() && _isIdentifierChar(text[pos]); ++pos)
-        {
-        }
-        return (int)(pos - offset);
-    }
-    return 0;
-}
-
-int DocumentVersion::getTokenLength(Index line, Index col)
-{
-    auto offset = getOffset(line, col);
-    return getTokenLength(offset);
-}
-
 ASTMarkup* WorkspaceVersion::getOrCreateMarkupAST(ModuleDecl* module)
 {
     RefPtr<ASTMarkup> astMarkup;
@@ -774,11 +666,140 @@ void WorkspaceVersion::ensureWorkspaceFlavor(UnownedStringSlice path)
     }
 }
 
+bool WorkspaceVersion::isSourceFileChanged(
+    SourceFile* sourceFile,
+    HashSet<String> const& changedPaths)
+{
+    String canonicalPath;
+    if (!canonicalSourceFilePaths.tryGetValue(sourceFile, canonicalPath))
+    {
+        auto& pathInfo = sourceFile->getPathInfo();
+        if (SLANG_FAILED(Path::getCanonical(pathInfo.foundPath, canonicalPath)))
+            canonicalPath = pathInfo.getMostUniqueIdentity();
+        canonicalSourceFilePaths[sourceFile] = canonicalPath;
+    }
+    return changedPaths.contains(canonicalPath);
+}
+
+template<typename T, typename Predicate>
+static void _removeEntriesIf(List<T>& list, Predicate const& predicate)
+{
+    Index count = 0;
+    for (Index i = 0; i < list.getCount(); i++)
+    {
+        if (predicate(list[i]))
+            continue;
+        if (count != i)
+            list[count] = _Move(list[i]);
+        count++;
+    }
+    list.setCount(count);
+}
+
+void WorkspaceVersion::reuseModulesFrom(WorkspaceVersion* previous, bool reuseDocumentModules)
+{
+    linkage = previous->linkage;
+    flavor = previous->flavor;
+    linkageReuseCount = previous->linkageReuseCount + 1;
+    canonicalSourceFilePaths = _Move(previous->canonicalSourceFilePaths);
+    unloadedModules = _Move(previous->unloadedModules);
+
+    auto& changedPaths = previous->changedDocumentPaths;
+
+    // A module's file dependencies include those of every module it imports, so this finds
+    // the changed modules along with everything that depends on them.
+    HashSet<Module*> modulesToUnload;
+    for (auto& loadedModule : linkage->loadedModulesList)
+    {
+        for (auto file : loadedModule->getFileDependencies())
+        {
+            if (isSourceFileChanged(file, changedPaths))
+            {
+                modulesToUnload.add(loadedModule.get());
+                break;
+            }
+        }
+    }
+    for (const auto& [path, module] : previous->modules)
+    {
+        if (!reuseDocumentModules)
+            modulesToUnload.add(module);
+        else if (!modulesToUnload.contains(module))
+        {
+            modules[path] = module;
+            if (auto output = previous->moduleDiagnosticOutputs.tryGetValue(path))
+                moduleDiagnosticOutputs[path] = *output;
+            pendingReusedDiagnostics.add(path);
+            if (auto markup = previous->markupASTs.tryGetValue(module->getModuleDecl()))
+                markupASTs[module->getModuleDecl()] = *markup;
+        }
+    }
+
+    if (modulesToUnload.getCount() != 0)
+    {
+        for (auto module : modulesToUnload)
+            unloadedModules.add(module);
+        linkage->unloadModules(modulesToUnload);
+    }
+
+    // Make sure the changed files are read again rather than served from a cache.
+    auto sourceManager = linkage->getSourceManager();
+    for (auto sourceFile : sourceManager->getSourceFiles())
+    {
+        if (isSourceFileChanged(sourceFile, changedPaths))
+            sourceManager->removeSourceFile(sourceFile);
+    }
+    if (changedPaths.getCount() != 0)
+        linkage->getFileSystemExt()->clearCache();
+
+    // Drop what the preprocessor recorded for the old contents of the changed files.
+    auto isInChangedFile = [&](SourceLoc loc)
+    {
+        auto sourceView = sourceManager->findSourceView(loc);
+        return sourceView && isSourceFileChanged(sourceView->getSourceFile(), changedPaths);
+    };
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    _removeEntriesIf(
+        preprocessorInfo.macroDefinitions,
+        [&](MacroDefinitionContentAssistInfo const& def) { return isInChangedFile(def.loc); });
+    _removeEntriesIf(
+        preprocessorInfo.macroInvocations,
+        [&](MacroInvocationContentAssistInfo const& invocation)
+        { return isInChangedFile(invocation.loc); });
+    _removeEntriesIf(
+        preprocessorInfo.fileIncludes,
+        [&](FileIncludeContentAssistInfo const& include) { return isInChangedFile(include.loc); });
+    linkage->contentAssistInfo.completionSuggestions.clear();
+
+    // The previous version no longer owns the linkage.
+    previous->isReusable = false;
+}
+
+void WorkspaceVersion::addModuleDiagnostics(const String& path, const String& compilerOutput)
+{
+    moduleDiagnosticOutputs[path] = compilerOutput;
+    if (compilerOutput.getLength() == 0)
+        return;
+    parseDiagnostics(compilerOutput);
+    auto docDiagnostic = diagnostics.tryGetValue(path);
+    if (docDiagnostic)
+        docDiagnostic->originalOutput = compilerOutput;
+}
+
 Module* WorkspaceVersion::getOrLoadModule(String path)
 {
     Module* module;
     if (modules.tryGetValue(path, module))
     {
+        // A module reused from an earlier version didn't produce any diagnostics when it
+        // was handed out, so report the ones from when it was loaded.
+        if (pendingReusedDiagnostics.contains(path))
+        {
+            pendingReusedDiagnostics.remove(path);
+            String output;
+            moduleDiagnosticOutputs.tryGetValue(path, output);
+            addModuleDiagnostics(path, output);
+        }
         return module;
     }
     auto doc = workspace->openedDocuments.tryGetValue(path);
@@ -810,14 +831,10 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     {
         modules[path] = static_cast<Module*>(parsedModule);
     }
+    String diagnosticString;
     if (diagnosticBlob)
-    {
-        auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.tryGetValue(path);
-        if (docDiagnostic)
-            docDiagnostic->originalOutput = diagnosticString;
-    }
+        diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
+    addModuleDiagnostics(path, diagnosticString);
     return static_cast<Module*>(parsedModule);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../compiler-core/slang-document-version.h"
 #include "../compiler-core/slang-language-server-protocol.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-com-object.h"
@@ -13,116 +14,6 @@ namespace Slang
 {
 class Workspace;
 
-class DocumentVersion : public RefObject
-{
-private:
-    URI uri;
-    String path;
-    String text;
-    List<UnownedStringSlice> lines;
-    List<List<Index>> mapUTF16CharIndexToCodePointIndex;
-    List<List<Index>> mapCodePointIndexToUTF8ByteOffset;
-
-public:
-    void setPath(String filePath)
-    {
-        path = filePath;
-        uri = URI::fromLocalFilePath(path.getUnownedSlice());
-    }
-    URI getURI() { return uri; }
-    String getPath() { return path; }
-    const String& getText() { return text; }
-    void setText(const String& newText);
-
-    void ensureUTFBoundsAvailable();
-    ArrayView<Index> getUTF16Boundaries(Index line);
-    ArrayView<Index> getUTF8Boundaries(Index line);
-
-    void oneBasedUTF8LocToZeroBasedUTF16Loc(
-        Index inLine,
-        Index inCol,
-        int64_t& outLine,
-        int64_t& outCol);
-    void oneBasedUTF8LocToZeroBasedUTF16Loc(
-        Index inLine,
-        Index inCol,
-        int32_t& outLine,
-        int32_t& outCol);
-    void zeroBasedUTF16LocToOneBasedUTF8Loc(
-        Index inLine,
-        Index inCol,
-        Index& outLine,
-        Index& outCol);
-
-    // Get starting offset of line.
-    Index getLineStart(UnownedStringSlice line) { return line.begin() - text.begin(); }
-
-    UnownedStringSlice peekIdentifier(Index line, Index col, Index& offset)
-    {
-        offset = getOffset(line, col);
-        return peekIdentifier(offset);
-    }
-
-    UnownedStringSlice peekIdentifier(Index& offset);
-
-    // Get offset from 1-based, utf-8 encoding location.
-    Index getOffset(Index lineIndex, Index colIndex)
-    {
-        if (lineIndex < 0)
-            return -1;
-        if (lineIndex - 1 >= lines.getCount())
-            return -1;
-        if (lines.getCount() == 0)
-            return -1;
-
-        Index lineStart = lineIndex >= 1 ? getLineStart(lines[lineIndex - 1]) : 0;
-        auto boundaries = getUTF8Boundaries(lineIndex);
-        Index byteOffset = 0;
-        if (colIndex > 0 && colIndex <= boundaries.getCount())
-            byteOffset = boundaries[colIndex - 1];
-        return lineStart + byteOffset;
-    }
-
-    // Get 1-based, utf-8 encoding location from offset.
-    void offsetToLineCol(Index offset, Index& line, Index& col)
-    {
-        auto firstGreater = std::upper_bound(
-            lines.begin(),
-            lines.end(),
-            offset,
-            [this](Index first, UnownedStringSlice second)
-            { return first < getLineStart(second); });
-        line = Index(firstGreater - lines.begin());
-        if (firstGreater == lines.begin())
-        {
-            col = offset + 1;
-        }
-        else
-        {
-            col = Index(offset - getLineStart(lines[line - 1])) + 1;
-        }
-        if (line > 0 && line <= lines.getCount())
-            col = UTF8Util::calcCodePointCount(lines[line - 1].head(col - 1)) + 1;
-    }
-
-    // Get line from 1-based index.
-    UnownedStringSlice getLine(Index lineIndex)
-    {
-        if (lineIndex < 0)
-            return UnownedStringSlice();
-        if (lineIndex - 1 >= lines.getCount())
-            return UnownedStringSlice();
-        if (lines.getCount() == 0)
-            return UnownedStringSlice();
-
-        return lineIndex > 0 ? lines[lineIndex - 1] : UnownedStringSlice();
-    }
-
-    // Get length of an identifier token starting at the specified position.
-    int getTokenLength(Index line, Index col);
-    int getTokenLength(Index offset);
-};
-
 struct DocumentDiagnostics
 {
     OrderedHashSet<LanguageServerProtocol::Diagnostic> messages;
@@ -139,19 +30,46 @@ class WorkspaceVersion : public RefObject
 {
 private:
     Dictionary<String, Module*> modules;
+    // The compiler output produced when each module in `modules` was loaded.
+    Dictionary<String, String> moduleDiagnosticOutputs;
+    // Paths of reused modules whose diagnostics have not been added to `diagnostics` yet.
+    HashSet<String> pendingReusedDiagnostics;
     Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
     Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
+    // Canonical paths of the source files in `linkage`, computed on demand.
+    Dictionary<SourceFile*, String> canonicalSourceFilePaths;
+    // Modules unloaded from `linkage` by earlier versions. Their AST is still owned by the
+    // linkage, so they are kept alive alongside it.
+    List<RefPtr<Module>> unloadedModules;
     void parseDiagnostics(String compilerOutput);
+    void addModuleDiagnostics(const String& path, const String& compilerOutput);
+    bool isSourceFileChanged(SourceFile* sourceFile, HashSet<String> const& changedPaths);
 
 public:
     Workspace* workspace;
     WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
     RefPtr<Linkage> linkage;
     Dictionary<String, DocumentDiagnostics> diagnostics;
+
+    // Canonical paths of the documents that changed after this version was created.
+    HashSet<String> changedDocumentPaths;
+    // Whether a later version may reuse the modules loaded into `linkage`.
+    bool isReusable = true;
+    // The number of earlier versions that `linkage` has been shared with.
+    Index linkageReuseCount = 0;
+
     ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
     Module* getOrLoadModule(String path);
     void ensureWorkspaceFlavor(UnownedStringSlice path);
     MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
+
+    /// Make this version share the linkage of `previous`, keeping every module whose source
+    /// files have not changed since `previous` was created, and unloading the rest so they are
+    /// parsed and checked again when next needed.
+    ///
+    /// If `reuseDocumentModules` is false, only modules loaded through `import` are kept,
+    /// and the modules of open documents are always checked again.
+    void reuseModulesFrom(WorkspaceVersion* previous, bool reuseDocumentModules);
 };
 
 struct OwnedPreprocessorMacroDefinition
@@ -164,7 +82,16 @@ class Workspace : public ComObject, public ISlangFileSystem
 private:
     RefPtr<WorkspaceVersion> currentVersion;
     RefPtr<WorkspaceVersion> currentCompletionVersion;
+    // The last version handed out by `getCurrentVersion`, kept after an edit invalidates it
+    // so that the next version can reuse its modules.
+    RefPtr<WorkspaceVersion> previousVersion;
     RefPtr<WorkspaceVersion> createWorkspaceVersion();
+    RefPtr<WorkspaceVersion> createWorkspaceVersion(
+        WorkspaceVersion* previous,
+        bool reuseDocumentModules);
+    // Invalidate the current version after the document at `path` changed. Unlike
+    // `invalidate`, modules not affected by the change can still be reused.
+    void invalidateDocument(const String& path);
 
 public:
     List<String> rootDirectories;
@@ -8,6 +8,13 @@ SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 #include "../core/slang-test-tool-util.h"
 #include "../slang/slang-internal.h"
 
+#ifndef SLANG_BOOTSTRAP
+#include "../compiler-core/slang-json-parser.h"
+#include "../compiler-core/slang-json-rpc-connection.h"
+#include "../compiler-core/slang-json-value.h"
+#include "../compiler-core/slang-test-server-protocol.h"
+#endif
+
 using namespace Slang;
 
 #include <assert.h>
@@ -115,9 +122,236 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     return res;
 }
 
+#ifndef SLANG_BOOTSTRAP
+
+/// Creates the global session shared by all the compilations in a server or batch run.
+static SlangResult _createSharedSession(ComPtr<slang::IGlobalSession>& outSession)
+{
+    SlangGlobalSessionDesc desc = {};
+    desc.enableGLSL = true;
+    return slang_createGlobalSession2(&desc, outSession.writeRef());
+}
+
+/// Runs slangc as a compile server, started with `slangc --server` (or `slang compile --server`).
+///
+/// Command lines are received over stdin/stdout as JSON-RPC calls, using the same protocol as
+/// test-server: an `ExecuteToolTestArgs` call with a `toolName` of "slangc" runs a compilation
+/// and replies with an `ExecutionResult` holding the captured output and return code, and a
+/// `QuitArgs` call ends the server. Every compilation reuses one global session, so the core
+/// module is only loaded once, however many command lines are sent.
+static SlangResult _runServer(StdWriters* defaultWriters, const char* exePath)
+{
+    RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+    SLANG_RETURN_ON_FAIL(connection->initWithStdStreams());
+
+    ComPtr<slang::IGlobalSession> session;
+
+    while (connection->isActive())
+    {
+        // Failures only affect the call being handled, so keep serving.
+        if (SLANG_FAILED(connection->waitForResult()) || !connection->hasMessage())
+        {
+            continue;
+        }
+
+        if (connection->getMessageType() != JSONRPCMessageType::Call)
+        {
+            connection->sendError(
+                JSONRPC::ErrorCode::InvalidRequest,
+                connection->getCurrentMessageId());
+            continue;
+        }
+
+        JSONRPCCall call;
+        if (SLANG_FAILED(connection->getRPCOrSendError(&call)))
+        {
+            continue;
+        }
+
+        if (call.method == TestServerProtocol::QuitArgs::g_methodName)
+        {
+            break;
+        }
+        if (call.method != TestServerProtocol::ExecuteToolTestArgs::g_methodName)
+        {
+            connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+            continue;
+        }
+
+        auto id = connection->getPersistentValue(call.id);
+
+        TestServerProtocol::ExecuteToolTestArgs args;
+        if (SLANG_FAILED(connection->toNativeArgsOrSendError(call.params, &args, id)))
+        {
+            continue;
+        }
+        if (args.toolName != "slangc")
+        {
+            connection->sendError(JSONRPC::ErrorCode::InvalidParams, id);
+            continue;
+        }
+
+        if (!session)
+        {
+            if (SLANG_FAILED(_createSharedSession(session)))
+            {
+                connection->sendError(JSONRPC::ErrorCode::InternalError, id);
+                continue;
+            }
+        }
+
+        // The executable path is passed as argv[0], so that the prelude and search paths are
+        // found relative to this executable, as they are when slangc is run directly.
+        List<const char*> toolArgs;
+        toolArgs.add(exePath);
+        for (const auto& arg : args.args)
+        {
+            toolArgs.add(arg.getBuffer());
+        }
+
+        StringBuilder stdOut;
+        StringBuilder stdError;
+        RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut));
+        RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError));
+
+        StdWriters stdWriters;
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+        const SlangResult res =
+            innerMain(&stdWriters, session, int(toolArgs.getCount()), toolArgs.getBuffer());
+
+        // innerMain makes the writers for this call the singleton, so put the defaults back.
+        StdWriters::setSingleton(defaultWriters);
+
+        TestServerProtocol::ExecutionResult result;
+        result.result = res;
+        result.stdOut = stdOut;
+        result.stdError = stdError;
+        result.returnCode = int32_t(TestToolUtil::getReturnCode(res));
+        connection->sendResult(&result, id);
+    }
+
+    return SLANG_OK;
+}
+
+/// Reads the command lines of a batch manifest. The manifest is a JSON array with an element
+/// per job, each an array of the arguments that would be passed to slangc for that job.
+static SlangResult _readBatchManifest(
+    const String& path,
+    ISlangWriter* errorWriter,
+    List<List<String>>& outJobs)
+{
+    String contents;
+    SLANG_RETURN_ON_FAIL(File::readAllText(path, contents));
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    sink.writer = errorWriter;
+
+    SourceFile* sourceFile =
+        sourceManager.createSourceFileWithString(PathInfo::makeFromString(path), contents);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, &sink);
+
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+    JSONBuilder builder(container);
+
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+
+    const JSONValue root = builder.getRootValue();
+    if (root.getKind() != JSONValue::Kind::Array)
+    {
+        return SLANG_FAIL;
+    }
+    for (auto job : container->getArray(root))
+    {
+        if (job.getKind() != JSONValue::Kind::Array)
+        {
+            return SLANG_FAIL;
+        }
+        List<String> args;
+        for (auto arg : container->getArray(job))
+        {
+            if (arg.getKind() != JSONValue::Kind::String)
+            {
+                return SLANG_FAIL;
+            }
+            args.add(container->getString(arg));
+        }
+        outJobs.add(args);
+    }
+    return SLANG_OK;
+}
+
+/// Runs every job in the manifest at `manifestPath` with one global session, so the core module
+/// is only loaded once for all of them. Jobs run in order, and a failing job doesn't stop the
+/// ones after it. Returns the result of the first job that failed.
+static SlangResult _runBatch(StdWriters* stdWriters, const char* exePath, const char* manifestPath)
+{
+    List<List<String>> jobs;
+    if (SLANG_FAILED(_readBatchManifest(
+            manifestPath,
+            stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR),
+            jobs)))
+    {
+        StdWriters::getError().print("error: cannot read batch manifest '%s'\n", manifestPath);
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(_createSharedSession(session));
+
+    SlangResult batchResult = SLANG_OK;
+    for (Index i = 0; i < jobs.getCount(); ++i)
+    {
+        List<const char*> args;
+        args.add(exePath);
+        for (const auto& arg : jobs[i])
+        {
+            args.add(arg.getBuffer());
+        }
+
+        const SlangResult res =
+            innerMain(stdWriters, session, int(args.getCount()), args.getBuffer());
+        if (SLANG_FAILED(res))
+        {
+            StdWriters::getError().print("error: batch job %d failed\n", int(i));
+            if (SLANG_SUCCEEDED(batchResult))
+            {
+                batchResult = res;
+            }
+        }
+    }
+    return batchResult;
+}
+
+#endif
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
+
+#ifndef SLANG_BOOTSTRAP
+    if (argc == 2 && UnownedStringSlice(argv[1]) == "--server")
+    {
+        SlangResult res = _runServer(stdWriters, argv[0]);
+        slang::shutdown();
+        return (int)TestToolUtil::getReturnCode(res);
+    }
+    if (argc == 3 && UnownedStringSlice(argv[1]) == "--batch")
+    {
+        SlangResult res = _runBatch(stdWriters, argv[0], argv[2]);
+        slang::shutdown();
+        return (int)TestToolUtil::getReturnCode(res);
+    }
+#endif
+
     SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
     slang::shutdown();
     return (int)TestToolUtil::getReturnCode(res);
@@ -0,0 +1,14 @@
+// include-guard.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_H
+#define INCLUDE_GUARD_H
+
+#ifdef INCLUDE_GUARD_VALUE
+#error "include-guard.h was read again while its guard was defined"
+#endif
+
+#define INCLUDE_GUARD_VALUE 2
+
+#endif
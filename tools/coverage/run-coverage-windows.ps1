@@ -134,6 +134,7 @@ $SlangcExcludePatterns = @(
     '\source\compiler-core\slang-language-server-protocol'
     '\source\compiler-core\slang-json-rpc'
     '\source\compiler-core\slang-doc-extractor'
+    '\source\compiler-core\slang-document-version'
     '\source\slang\slang-ast-expr.h'
     '\source\slang\slang-ast-modifier.h'
     '\source\slang\slang-ast-stmt.h'
@@ -50,6 +50,6 @@ SLANGC_EXCLUDE_PATTERNS: Tuple[str, ...] = (
     r"^source/slang/slang-(language-server|doc-markdown-writer|doc-ast|ast-dump|repro|workspace-version)[.\-]",
     # Language-server / doc-only files that live in compiler-core
     # (LSP protocol structs, JSON-RPC framing, doc-comment extraction).
-    r"^source/compiler-core/slang-(language-server-protocol|json-rpc|doc-extractor)[.\-]",
+    r"^source/compiler-core/slang-(language-server-protocol|json-rpc|doc-extractor|document-version)[.\-]",
     r"^source/slang/slang-ast-(expr|modifier|stmt)\.h$",
 )
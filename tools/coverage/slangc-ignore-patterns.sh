@@ -24,7 +24,7 @@ SLANGC_IGNORE_ARGS=(
 
   # Language-server / doc-only files that live in compiler-core
   # (LSP protocol structs, JSON-RPC framing, doc-comment extraction).
-  -ignore-filename-regex='source/compiler-core/slang-(language-server-protocol|json-rpc|doc-extractor)[.\-]'
+  -ignore-filename-regex='source/compiler-core/slang-(language-server-protocol|json-rpc|doc-extractor|document-version)[.\-]'
 
   # FIDDLE-generated AST declaration headers (no executable code)
   -ignore-filename-regex='source/slang/slang-ast-(expr|modifier|stmt)\.h$'
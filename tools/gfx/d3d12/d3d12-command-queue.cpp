@@ -55,6 +55,7 @@ void CommandQueueImpl::executeCommandBuffers(
         m_d3dQueue->ExecuteCommandLists((UINT)count, commandLists.getArrayView().getBuffer());
 
         m_fenceValue++;
+        const uint64_t ringValue = m_renderer->signalRingFence(m_queueIndex, m_d3dQueue);
 
         for (GfxCount i = 0; i < count; i++)
         {
@@ -66,6 +67,7 @@ void CommandQueueImpl::executeCommandBuffers(
             waitInfo.waitValue = m_fenceValue;
             waitInfo.fence = m_fence;
             waitInfo.queue = m_d3dQueue;
+            transientHeap->recordSubmitPoint(m_queueIndex, ringValue);
         }
     }
 
@@ -2,6 +2,8 @@
 #include "d3d12-device.h"
 
 #include "../nvapi/nvapi-util.h"
+#include "core/slang-crypto.h"
+#include "core/slang-io.h"
 #include "d3d12-buffer.h"
 #include "d3d12-fence.h"
 #include "d3d12-framebuffer.h"
@@ -868,6 +870,8 @@ Result DeviceImpl::initialize(const Desc& desc)
         m_info.limits = limits;
     }
 
+    SLANG_RETURN_ON_FAIL(initRingBuffers());
+
     SLANG_RETURN_ON_FAIL(createTransientResourceHeapImpl(
         ITransientResourceHeap::Flags::AllowResizing,
         0,
@@ -913,6 +917,11 @@ Result DeviceImpl::initialize(const Desc& desc)
         m_info.adapterName = m_adapterName.begin();
     }
 
+    if (desc.pipelineCache.pipelineCachePath)
+    {
+        SLANG_RETURN_ON_FAIL(initPipelineLibrary(desc.pipelineCache.pipelineCachePath));
+    }
+
     // Initialize DXR interface.
 #if SLANG_GFX_HAS_DXR_SUPPORT
     m_device->QueryInterface<ID3D12Device5>(m_deviceInfo.m_device5.writeRef());
@@ -2308,9 +2317,221 @@ void* DeviceImpl::loadProc(SharedLibrary::Handle module, char const* name)
     return proc;
 }
 
+Result DeviceImpl::initRingBuffers()
+{
+    const size_t kRingSize = 32 * 1024 * 1024;
+
+    m_constantBufferRing = new RingBufferAllocator<DeviceImpl, BufferResourceImpl>();
+    SLANG_RETURN_ON_FAIL(m_constantBufferRing->init(
+        this,
+        isRingSubmitPointComplete,
+        kRingSize,
+        D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT,
+        ResourceStateSet(
+            ResourceState::ConstantBuffer,
+            ResourceState::CopySource,
+            ResourceState::CopyDestination)));
+    m_uploadBufferRing = new RingBufferAllocator<DeviceImpl, BufferResourceImpl>();
+    SLANG_RETURN_ON_FAIL(m_uploadBufferRing->init(
+        this,
+        isRingSubmitPointComplete,
+        kRingSize,
+        D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT,
+        ResourceStateSet(ResourceState::CopySource, ResourceState::CopyDestination)));
+    return SLANG_OK;
+}
+
+uint64_t DeviceImpl::signalRingFence(uint32_t queueIndex, ID3D12CommandQueue* queue)
+{
+    // Queue indices are reused when queues are destroyed, but the fences are kept, so a value
+    // on a fence is always greater than the ones signaled before it.
+    while ((uint32_t)m_ringFences.getCount() <= queueIndex)
+    {
+        ComPtr<ID3D12Fence> fence;
+        if (FAILED(m_device->CreateFence(
+                0,
+                D3D12_FENCE_FLAG_NONE,
+                IID_PPV_ARGS(fence.writeRef()))))
+        {
+            return 0;
+        }
+        m_ringFences.add(fence);
+        m_ringFenceValues.add(0);
+    }
+    const uint64_t value = ++m_ringFenceValues[queueIndex];
+    queue->Signal(m_ringFences[queueIndex], value);
+    return value;
+}
+
+bool DeviceImpl::isRingSubmitPointComplete(DeviceImpl* device, const RingSubmitPoint& point)
+{
+    if (point.queueIndex >= (uint32_t)device->m_ringFences.getCount())
+        return false;
+    return device->m_ringFences[point.queueIndex]->GetCompletedValue() >= point.value;
+}
+
 DeviceImpl::~DeviceImpl()
 {
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+    savePipelineLibrary();
+}
+
+Result DeviceImpl::initPipelineLibrary(const char* directory)
+{
+    ComPtr<ID3D12Device1> device1;
+    if (SLANG_FAILED(m_device->QueryInterface<ID3D12Device1>(device1.writeRef())))
+    {
+        return SLANG_OK;
+    }
+
+    // A library is only valid for the adapter and driver that wrote it, so each has its own file.
+    StringBuilder fileName;
+    fileName << "d3d12-pipeline-library-";
+    fileName.append(uint32_t(m_deviceInfo.m_desc.VendorId), 16);
+    fileName << "-";
+    fileName.append(uint32_t(m_deviceInfo.m_desc.DeviceId), 16);
+    fileName << "-";
+    fileName.append(uint32_t(m_deviceInfo.m_desc.SubSysId), 16);
+    fileName << "-";
+    fileName.append(uint32_t(m_deviceInfo.m_desc.Revision), 16);
+    LARGE_INTEGER driverVersion = {};
+    if (m_deviceInfo.m_adapter &&
+        SUCCEEDED(m_deviceInfo.m_adapter->CheckInterfaceSupport(
+            __uuidof(IDXGIDevice),
+            &driverVersion)))
+    {
+        fileName << "-";
+        fileName.append(uint64_t(driverVersion.QuadPart), 16);
+    }
+    fileName << ".bin";
+
+    Path::createDirectoryRecursive(directory);
+    m_pipelineLibraryFileName = Path::combine(directory, fileName);
+
+    File::readAllBytes(m_pipelineLibraryFileName, m_pipelineLibraryData);
+    if (m_pipelineLibraryData.getCount() == 0 ||
+        FAILED(device1->CreatePipelineLibrary(
+            m_pipelineLibraryData.getBuffer(),
+            SIZE_T(m_pipelineLibraryData.getCount()),
+            IID_PPV_ARGS(m_pipelineLibrary.writeRef()))))
+    {
+        // The file is missing, corrupt or was written by another driver, so start again.
+        m_pipelineLibraryData = List<uint8_t>();
+        SLANG_RETURN_ON_FAIL(
+            device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(m_pipelineLibrary.writeRef())));
+    }
+    return SLANG_OK;
+}
+
+void DeviceImpl::savePipelineLibrary()
+{
+    if (!m_pipelineLibrary || !m_pipelineLibraryChanged)
+    {
+        return;
+    }
+    List<uint8_t> data;
+    data.setCount(Index(m_pipelineLibrary->GetSerializedSize()));
+    if (SUCCEEDED(m_pipelineLibrary->Serialize(data.getBuffer(), SIZE_T(data.getCount()))))
+    {
+        File::writeAllBytes(m_pipelineLibraryFileName, data.getBuffer(), data.getCount());
+    }
+    m_pipelineLibraryChanged = false;
+}
+
+static void _appendBytecode(DigestBuilder<SHA1>& builder, const D3D12_SHADER_BYTECODE& bytecode)
+{
+    builder.append(bytecode.BytecodeLength);
+    builder.append(bytecode.pShaderBytecode, SlangInt(bytecode.BytecodeLength));
+}
+
+// Add a newly created pipeline to the library. This fails if a different pipeline has the same
+// name, which only loses the caching of the new one.
+static void _storePipelineState(
+    ID3D12PipelineLibrary* library,
+    const wchar_t* name,
+    ID3D12PipelineState* state,
+    bool& ioLibraryChanged)
+{
+    if (SUCCEEDED(library->StorePipeline(name, state)))
+    {
+        ioLibraryChanged = true;
+    }
+}
+
+// Pipelines in the library are named by a hash of their shaders and state. The root signature is
+// not part of the name, so if it differs the library fails to load the pipeline, and it is
+// created again.
+Result DeviceImpl::loadOrCreateComputePipelineState(
+    const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    if (!m_pipelineLibrary)
+    {
+        return m_device->CreateComputePipelineState(&desc, IID_PPV_ARGS(outState));
+    }
+
+    DigestBuilder<SHA1> builder;
+    _appendBytecode(builder, desc.CS);
+    builder.append(desc.Flags);
+    const auto name = builder.finalize().toString().toWString();
+
+    if (SUCCEEDED(
+            m_pipelineLibrary->LoadComputePipeline(name.begin(), &desc, IID_PPV_ARGS(outState))))
+    {
+        return SLANG_OK;
+    }
+    SLANG_RETURN_ON_FAIL(m_device->CreateComputePipelineState(&desc, IID_PPV_ARGS(outState)));
+    _storePipelineState(m_pipelineLibrary, name.begin(), *outState, m_pipelineLibraryChanged);
+    return SLANG_OK;
+}
+
+Result DeviceImpl::loadOrCreateGraphicsPipelineState(
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+    ID3D12PipelineState** outState)
+{
+    if (!m_pipelineLibrary)
+    {
+        return m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(outState));
+    }
+
+    DigestBuilder<SHA1> builder;
+    _appendBytecode(builder, desc.VS);
+    _appendBytecode(builder, desc.PS);
+    _appendBytecode(builder, desc.DS);
+    _appendBytecode(builder, desc.HS);
+    _appendBytecode(builder, desc.GS);
+    builder.append(&desc.BlendState, sizeof(desc.BlendState));
+    builder.append(desc.SampleMask);
+    builder.append(&desc.RasterizerState, sizeof(desc.RasterizerState));
+    builder.append(&desc.DepthStencilState, sizeof(desc.DepthStencilState));
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+    {
+        const auto& element = desc.InputLayout.pInputElementDescs[i];
+        builder.append(UnownedStringSlice(element.SemanticName));
+        builder.append(element.SemanticIndex);
+        builder.append(element.Format);
+        builder.append(element.InputSlot);
+        builder.append(element.AlignedByteOffset);
+        builder.append(element.InputSlotClass);
+        builder.append(element.InstanceDataStepRate);
+    }
+    builder.append(desc.IBStripCutValue);
+    builder.append(desc.PrimitiveTopologyType);
+    builder.append(desc.NumRenderTargets);
+    builder.append(&desc.RTVFormats, sizeof(desc.RTVFormats));
+    builder.append(desc.DSVFormat);
+    builder.append(&desc.SampleDesc, sizeof(desc.SampleDesc));
+    builder.append(desc.Flags);
+    const auto name = builder.finalize().toString().toWString();
+
+    if (SUCCEEDED(
+            m_pipelineLibrary->LoadGraphicsPipeline(name.begin(), &desc, IID_PPV_ARGS(outState))))
+    {
+        return SLANG_OK;
+    }
+    SLANG_RETURN_ON_FAIL(m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(outState)));
+    _storePipelineState(m_pipelineLibrary, name.begin(), *outState, m_pipelineLibraryChanged);
+    return SLANG_OK;
 }
 
 
@@ -69,6 +69,13 @@ public:
     RefPtr<CommandQueueImpl> m_resourceCommandQueue;
     RefPtr<TransientResourceHeapImpl> m_resourceCommandTransientHeap;
 
+    // Rings shared by all transient heaps. Each queue index has its own fence, which every
+    // submission to the queue signals with the next value in `m_ringFenceValues`.
+    RefPtr<RingBufferAllocator<DeviceImpl, BufferResourceImpl>> m_constantBufferRing;
+    RefPtr<RingBufferAllocator<DeviceImpl, BufferResourceImpl>> m_uploadBufferRing;
+    List<ComPtr<ID3D12Fence>> m_ringFences;
+    List<uint64_t> m_ringFenceValues;
+
     RefPtr<D3D12GeneralExpandingDescriptorHeap> m_rtvAllocator;
     RefPtr<D3D12GeneralExpandingDescriptorHeap> m_dsvAllocator;
 
@@ -89,6 +96,14 @@ public:
 
     bool m_nvapi = false;
 
+    // Pipeline library persisted to `m_pipelineLibraryFileName`, if the device was created with a
+    // pipeline cache path. The library reads from `m_pipelineLibraryData`, so it is declared
+    // after it to be released first.
+    List<uint8_t> m_pipelineLibraryData;
+    ComPtr<ID3D12PipelineLibrary> m_pipelineLibrary;
+    String m_pipelineLibraryFileName;
+    bool m_pipelineLibraryChanged = false;
+
     // Command signatures required for indirect draws. These indicate the format of the indirect
     // as well as the command type to be used (DrawInstanced and DrawIndexedInstanced, in this
     // case).
@@ -98,6 +113,12 @@ public:
 
 public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc) override;
+
+    /// Create the rings transient heaps allocate constant data and upload staging from.
+    Result initRingBuffers();
+    /// Signal the ring fence of the queue at `queueIndex` from `queue`, and return the value.
+    uint64_t signalRingFence(uint32_t queueIndex, ID3D12CommandQueue* queue);
+    static bool isRingSubmitPointComplete(DeviceImpl* device, const RingSubmitPoint& point);
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getFormatSupportedResourceStates(Format format, ResourceStateSet* outStates) override;
 
@@ -231,6 +252,20 @@ public:
 public:
     static void* loadProc(SharedLibrary::Handle module, char const* name);
 
+    /// Create the pipeline library, with the pipelines saved by an earlier run if there are any.
+    Result initPipelineLibrary(const char* directory);
+    /// Write the pipeline library to its file, if pipelines were added to it.
+    void savePipelineLibrary();
+
+    /// Create a pipeline state, loading it from the pipeline library if it is there, and adding
+    /// it to the library otherwise.
+    Result loadOrCreateComputePipelineState(
+        const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+        ID3D12PipelineState** outState);
+    Result loadOrCreateGraphicsPipelineState(
+        const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+        ID3D12PipelineState** outState);
+
     Result createCommandQueueImpl(CommandQueueImpl** outQueue);
 
     Result createTransientResourceHeapImpl(
@@ -290,9 +290,9 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
             }
             else
             {
-                SLANG_RETURN_ON_FAIL(m_device->m_device->CreateGraphicsPipelineState(
-                    &graphicsDesc,
-                    IID_PPV_ARGS(m_pipelineState.writeRef())));
+                SLANG_RETURN_ON_FAIL(m_device->loadOrCreateGraphicsPipelineState(
+                    graphicsDesc,
+                    m_pipelineState.writeRef()));
             }
         }
     }
@@ -357,9 +357,9 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
                 }
                 else
                 {
-                    SLANG_RETURN_ON_FAIL(m_device->m_device->CreateComputePipelineState(
-                        &computeDesc,
-                        IID_PPV_ARGS(m_pipelineState.writeRef())));
+                    SLANG_RETURN_ON_FAIL(m_device->loadOrCreateComputePipelineState(
+                        computeDesc,
+                        m_pipelineState.writeRef()));
                 }
             }
         }
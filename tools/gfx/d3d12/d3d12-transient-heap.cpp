@@ -125,6 +125,8 @@ Result TransientResourceHeapImpl::init(
     uint32_t samplerHeapSize)
 {
     Super::init(desc, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, device);
+    m_constantBufferRing = device->m_constantBufferRing;
+    m_uploadBufferRing = device->m_uploadBufferRing;
     m_canResize = (desc.flags & ITransientResourceHeap::Flags::AllowResizing) != 0;
     m_viewHeapSize = viewHeapSize;
     m_samplerHeapSize = samplerHeapSize;
@@ -24,6 +24,13 @@ Result DebugResourceView::getNativeHandle(InteropHandle* outNativeHandle)
     return baseObject->getNativeHandle(outNativeHandle);
 }
 
+Result DebugResourceView::getDescriptorHandle(uint64_t* outHandle)
+{
+    SLANG_GFX_API_FUNC;
+
+    return baseObject->getDescriptorHandle(outHandle);
+}
+
 DeviceAddress DebugAccelerationStructure::getDeviceAddress()
 {
     SLANG_GFX_API_FUNC;
@@ -45,5 +52,12 @@ IResourceView::Desc* DebugAccelerationStructure::getViewDesc()
     return baseObject->getViewDesc();
 }
 
+Result DebugAccelerationStructure::getDescriptorHandle(uint64_t* outHandle)
+{
+    SLANG_GFX_API_FUNC;
+
+    return baseObject->getDescriptorHandle(outHandle);
+}
+
 } // namespace debug
 } // namespace gfx
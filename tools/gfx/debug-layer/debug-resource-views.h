@@ -19,6 +19,7 @@ public:
     virtual SLANG_NO_THROW Desc* SLANG_MCALL getViewDesc() override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getNativeHandle(InteropHandle* outNativeHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 class DebugAccelerationStructure : public DebugObject<IAccelerationStructure>
@@ -32,6 +33,7 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getNativeHandle(InteropHandle* outNativeHandle) override;
     virtual SLANG_NO_THROW Desc* SLANG_MCALL getViewDesc() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 } // namespace debug
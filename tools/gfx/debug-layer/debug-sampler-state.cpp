@@ -17,5 +17,12 @@ Result DebugSamplerState::getNativeHandle(InteropHandle* outNativeHandle)
     return baseObject->getNativeHandle(outNativeHandle);
 }
 
+Result DebugSamplerState::getDescriptorHandle(uint64_t* outHandle)
+{
+    SLANG_GFX_API_FUNC;
+
+    return baseObject->getDescriptorHandle(outHandle);
+}
+
 } // namespace debug
 } // namespace gfx
@@ -18,6 +18,7 @@ public:
     ISamplerState* getInterface(const Slang::Guid& guid);
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getNativeHandle(InteropHandle* outNativeHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 } // namespace debug
@@ -362,6 +362,9 @@ BufferResourceImpl* ShaderObjectImpl::_ensureArgumentBufferUpToDate(
         SLANG_ASSERT(m_data.getCount() == dataSize);
         memcpy(argumentData, m_data.getBuffer(), dataSize);
 
+        m_argumentBufferResources.clear();
+        m_argumentBufferSubObjects.clear();
+
         // Special handle the parameter block and constant buffer
         for (uint32_t i = 0; i < typeLayout->getFieldCount(); i++)
         {
@@ -390,13 +393,10 @@ BufferResourceImpl* ShaderObjectImpl::_ensureArgumentBufferUpToDate(
                         gfx::DeviceAddress bufferAddr = argumentBufferPtr->getDeviceAddress();
                         memcpy(argumentBuffer, &bufferAddr, sizeof(bufferAddr));
 
-                        MTL::Resource const* resource[] = {argumentBufferPtr->m_buffer.get()};
                         // Nested parameter block and constant buffer is also bindless resource, we
                         // need to inform Metal to hazard track the resource
-                        context->useResources(
-                            resource,
-                            1,
-                            MTL::ResourceUsageWrite | MTL::ResourceUsageRead);
+                        m_argumentBufferResources.add(argumentBufferPtr->m_buffer.get());
+                        m_argumentBufferSubObjects.add(subObject);
                     }
                     break;
                 }
@@ -406,13 +406,12 @@ BufferResourceImpl* ShaderObjectImpl::_ensureArgumentBufferUpToDate(
         }
 
         // Handle bindless resources
-        List<MTL::Resource const*> resources;
         for (uint32_t i = 0; i < m_buffers.getCount(); i++)
         {
             if (m_buffers[i])
             {
                 MTL::Buffer* mtlBuffer = m_buffers[i]->m_buffer->m_buffer.get();
-                resources.add(mtlBuffer);
+                m_argumentBufferResources.add(mtlBuffer);
             }
         }
 
@@ -421,20 +420,30 @@ BufferResourceImpl* ShaderObjectImpl::_ensureArgumentBufferUpToDate(
             if (m_textures[i])
             {
                 MTL::Texture* mtlTexture = m_textures[i]->m_texture->m_texture.get();
-                resources.add(mtlTexture);
+                m_argumentBufferResources.add(mtlTexture);
             }
         }
-        // It's important to call useResources because Metal will not automatically do the hazard
-        // tracking for bindless resources, we have to call useResources to inform Metal to track
-        // the resources.
-        context->useResources(
-            resources.getBuffer(),
-            resources.getCount(),
-            MTL::ResourceUsageWrite | MTL::ResourceUsageRead);
 
         m_argumentBuffer->unmap(&range);
         m_isArgumentBufferDirty = false;
     }
+    else
+    {
+        // The argument buffer is reused as it is, without encoding it again, but the nested
+        // argument buffers may have changed, and their resources need declaring to this
+        // encoder as well.
+        for (auto subObject : m_argumentBufferSubObjects)
+            subObject->_ensureArgumentBufferUpToDate(context, device, subObject->getLayout());
+    }
+
+    // It's important to call useResources because Metal will not automatically do the hazard
+    // tracking for bindless resources, we have to call useResources to inform Metal to track
+    // the resources. This is needed every time the argument buffer is bound, since each
+    // encoder tracks its own resources.
+    context->useResources(
+        m_argumentBufferResources.getBuffer(),
+        m_argumentBufferResources.getCount(),
+        MTL::ResourceUsageWrite | MTL::ResourceUsageRead);
 
     return m_argumentBuffer.get();
 }
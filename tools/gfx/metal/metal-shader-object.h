@@ -151,6 +151,14 @@ public:
     /// Argument buffer created on demand to bind as a parameter block.
     RefPtr<BufferResourceImpl> m_argumentBuffer;
 
+    /// The resources referenced by `m_argumentBuffer`, recorded when it is filled in.
+    /// Metal doesn't track resources that are only referenced from an argument buffer, so
+    /// they have to be declared to every encoder the argument buffer is bound to.
+    List<MTL::Resource const*> m_argumentBufferResources;
+
+    /// The sub-objects whose argument buffers are referenced by `m_argumentBuffer`.
+    List<ShaderObjectImpl*> m_argumentBufferSubObjects;
+
 
     bool m_isConstantBufferDirty = true;
     bool m_isArgumentBufferDirty = true;
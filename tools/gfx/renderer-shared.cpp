@@ -203,6 +203,12 @@ Result ResourceViewBase::getNativeHandle(InteropHandle* outHandle)
     return SLANG_E_NOT_IMPLEMENTED;
 }
 
+Result ResourceViewBase::getDescriptorHandle(uint64_t* outHandle)
+{
+    *outHandle = 0;
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 ISamplerState* SamplerStateBase::getInterface(const Slang::Guid& guid)
 {
     if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_ISamplerState)
@@ -217,6 +223,12 @@ Result SamplerStateBase::getNativeHandle(InteropHandle* outHandle)
     return SLANG_E_NOT_IMPLEMENTED;
 }
 
+Result SamplerStateBase::getDescriptorHandle(uint64_t* outHandle)
+{
+    *outHandle = 0;
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 IAccelerationStructure* AccelerationStructureBase::getInterface(const Slang::Guid& guid)
 {
     if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_IResourceView ||
@@ -225,6 +237,12 @@ IAccelerationStructure* AccelerationStructureBase::getInterface(const Slang::Gui
     return nullptr;
 }
 
+Result AccelerationStructureBase::getDescriptorHandle(uint64_t* outHandle)
+{
+    *outHandle = 0;
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 bool _doesValueFitInExistentialPayload(
     slang::TypeLayoutReflection* concreteTypeLayout,
     slang::TypeLayoutReflection* existentialTypeLayout)
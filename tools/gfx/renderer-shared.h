@@ -320,6 +320,7 @@ public:
     IResourceView* getInterface(const Slang::Guid& guid);
     virtual SLANG_NO_THROW Desc* SLANG_MCALL getViewDesc() override { return &m_desc; }
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 class SamplerStateBase : public ISamplerState, public Slang::ComObject
@@ -328,6 +329,7 @@ public:
     SLANG_COM_OBJECT_IUNKNOWN_ALL
     ISamplerState* getInterface(const Slang::Guid& guid);
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 class AccelerationStructureBase : public IAccelerationStructure, public ResourceViewInternalBase
@@ -338,6 +340,7 @@ public:
     SLANG_COM_OBJECT_IUNKNOWN_ALL
     IAccelerationStructure* getInterface(const Slang::Guid& guid);
     virtual SLANG_NO_THROW Desc* SLANG_MCALL getViewDesc() override { return &m_desc; }
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
 };
 
 class RendererBase;
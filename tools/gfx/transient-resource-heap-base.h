@@ -133,6 +133,174 @@ public:
     }
 };
 
+/// A point on a command queue's timeline, reached when a submission to the queue completes.
+struct RingSubmitPoint
+{
+    uint32_t queueIndex;
+    uint64_t value;
+};
+
+/// A persistent upload buffer that transient heaps sub-allocate from in ring order.
+///
+/// Memory allocated by a transient heap is tagged with the heap's version. When the heap is
+/// reset or destroyed that version is retired, along with the points on each queue's timeline
+/// that its submissions signal, and the memory is reclaimed once all of those points are
+/// reached. The device owns the ring, so heaps share one buffer instead of each creating pages.
+template<typename TDevice, typename TBufferResource>
+class RingBufferAllocator : public Slang::RefObject
+{
+public:
+    typedef bool (*IsSubmitPointCompleteFunc)(TDevice* device, const RingSubmitPoint& point);
+
+    struct Allocation
+    {
+        TBufferResource* resource;
+        size_t offset;
+    };
+
+    /// A run of allocations made for one heap version.
+    struct Block
+    {
+        uint64_t version;
+        /// Position of the end of the block, counting all the bytes ever allocated.
+        size_t end;
+        bool isRetired;
+        Slang::List<RingSubmitPoint> submitPoints;
+    };
+
+    TDevice* m_device = nullptr;
+    IsSubmitPointCompleteFunc m_isSubmitPointComplete = nullptr;
+    Slang::RefPtr<TBufferResource> m_buffer;
+    size_t m_capacity = 0;
+    uint32_t m_alignment = 256;
+
+    // `m_head` and `m_tail` count all the bytes ever allocated and reclaimed, so the used
+    // size is their difference, and the offset into the buffer is their value modulo the
+    // capacity.
+    size_t m_head = 0;
+    size_t m_tail = 0;
+
+    Slang::List<Block> m_blocks;
+    Slang::Index m_firstBlock = 0;
+
+    Result init(
+        TDevice* device,
+        IsSubmitPointCompleteFunc isSubmitPointComplete,
+        size_t capacity,
+        uint32_t alignment,
+        ResourceStateSet allowedStates)
+    {
+        m_device = device;
+        m_isSubmitPointComplete = isSubmitPointComplete;
+        m_capacity = capacity;
+        m_alignment = alignment;
+
+        Slang::ComPtr<IBufferResource> bufferPtr;
+        IBufferResource::Desc bufferDesc;
+        bufferDesc.type = IResource::Type::Buffer;
+        bufferDesc.defaultState = ResourceState::General;
+        bufferDesc.allowedStates = allowedStates;
+        bufferDesc.memoryType = MemoryType::Upload;
+        bufferDesc.sizeInBytes = capacity;
+        SLANG_RETURN_ON_FAIL(
+            device->createBufferResource(bufferDesc, nullptr, bufferPtr.writeRef()));
+        m_buffer = static_cast<TBufferResource*>(bufferPtr.get());
+        return SLANG_OK;
+    }
+
+    /// Allocate `size` bytes for the heap at `version`.
+    /// Returns false if the ring doesn't have the space, in which case the heap falls back to
+    /// its own staging buffer pool.
+    bool allocate(size_t size, uint64_t version, Allocation& outAllocation)
+    {
+        // Large allocations would quickly exhaust the ring.
+        if (size == 0 || size > (m_capacity >> 2))
+            return false;
+
+        size_t start = 0;
+        if (!_findSpace(size, start))
+        {
+            reclaim();
+            if (!_findSpace(size, start))
+                return false;
+        }
+
+        m_head = start + size;
+        if (m_firstBlock < m_blocks.getCount() && m_blocks.getLast().version == version &&
+            !m_blocks.getLast().isRetired)
+        {
+            m_blocks.getLast().end = m_head;
+        }
+        else
+        {
+            Block block;
+            block.version = version;
+            block.end = m_head;
+            block.isRetired = false;
+            m_blocks.add(block);
+        }
+
+        outAllocation.resource = m_buffer.Ptr();
+        outAllocation.offset = start % m_capacity;
+        return true;
+    }
+
+    /// Mark the allocations made for `version` as no longer used by the heap. They are reclaimed
+    /// once every point in `submitPoints` is reached.
+    void retire(uint64_t version, Slang::ArrayView<RingSubmitPoint> submitPoints)
+    {
+        for (Slang::Index i = m_firstBlock; i < m_blocks.getCount(); i++)
+        {
+            auto& block = m_blocks[i];
+            if (block.version != version || block.isRetired)
+                continue;
+            block.isRetired = true;
+            block.submitPoints.addRange(submitPoints.getBuffer(), submitPoints.getCount());
+        }
+    }
+
+    /// Reclaim the blocks at the tail of the ring whose submissions have completed.
+    void reclaim()
+    {
+        while (m_firstBlock < m_blocks.getCount())
+        {
+            auto& block = m_blocks[m_firstBlock];
+            if (!block.isRetired)
+                break;
+            for (auto point : block.submitPoints)
+            {
+                if (!m_isSubmitPointComplete(m_device, point))
+                    return;
+            }
+            m_tail = block.end;
+            m_firstBlock++;
+        }
+        if (m_firstBlock == m_blocks.getCount())
+        {
+            m_blocks.clear();
+            m_firstBlock = 0;
+        }
+        else if (m_firstBlock > 64 && m_firstBlock * 2 > m_blocks.getCount())
+        {
+            m_blocks.removeRange(0, m_firstBlock);
+            m_firstBlock = 0;
+        }
+    }
+
+private:
+    bool _findSpace(size_t size, size_t& outStart) const
+    {
+        size_t start = StagingBufferPool<TDevice, TBufferResource>::alignUp(m_head, m_alignment);
+        // An allocation can't wrap around the end of the buffer, so skip to the start of it.
+        if (start % m_capacity + size > m_capacity)
+            start += m_capacity - start % m_capacity;
+        if (start + size - m_tail > m_capacity)
+            return false;
+        outStart = start;
+        return true;
+    }
+};
+
 template<typename TDevice, typename TBufferResource>
 class TransientResourceHeapBaseImpl : public TransientResourceHeapBase
 {
@@ -145,6 +313,15 @@ public:
     StagingBufferPool<TDevice, TBufferResource> m_uploadBufferPool;
     StagingBufferPool<TDevice, TBufferResource> m_readbackBufferPool;
 
+    // Device owned rings that constant data and upload staging are allocated from when the
+    // backend supports them. Allocations that don't fit in a ring use the pools above.
+    Slang::RefPtr<RingBufferAllocator<TDevice, TBufferResource>> m_constantBufferRing;
+    Slang::RefPtr<RingBufferAllocator<TDevice, TBufferResource>> m_uploadBufferRing;
+    // Points on the queue timelines that this heap's submissions signal since it was last reset.
+    Slang::List<RingSubmitPoint> m_submitPoints;
+
+    ~TransientResourceHeapBaseImpl() { _retireRingAllocations(); }
+
     Result init(const ITransientResourceHeap::Desc& desc, uint32_t alignment, TDevice* device)
     {
         m_device = device;
@@ -193,6 +370,14 @@ public:
             break;
         default:
             {
+                typename RingBufferAllocator<TDevice, TBufferResource>::Allocation ringAllocation;
+                if (m_uploadBufferRing && !forceLargePage &&
+                    m_uploadBufferRing->allocate(size, m_version, ringAllocation))
+                {
+                    outBufferWeakPtr = ringAllocation.resource;
+                    offset = ringAllocation.offset;
+                    break;
+                }
                 auto allocation = m_uploadBufferPool.allocate(size, forceLargePage);
                 outBufferWeakPtr = allocation.resource;
                 offset = allocation.offset;
@@ -207,14 +392,51 @@ public:
         IBufferResource*& outBufferWeakPtr,
         size_t& outOffset)
     {
+        typename RingBufferAllocator<TDevice, TBufferResource>::Allocation ringAllocation;
+        if (m_constantBufferRing &&
+            m_constantBufferRing->allocate(size, m_version, ringAllocation))
+        {
+            outBufferWeakPtr = ringAllocation.resource;
+            outOffset = ringAllocation.offset;
+            return SLANG_OK;
+        }
         auto allocation = m_constantBufferPool.allocate(size, false);
         outBufferWeakPtr = allocation.resource;
         outOffset = allocation.offset;
         return SLANG_OK;
     }
 
+    /// Record that a submission using this heap signals `value` on the timeline of the queue
+    /// at `queueIndex`.
+    void recordSubmitPoint(uint32_t queueIndex, uint64_t value)
+    {
+        for (auto& point : m_submitPoints)
+        {
+            if (point.queueIndex == queueIndex)
+            {
+                if (point.value < value)
+                    point.value = value;
+                return;
+            }
+        }
+        RingSubmitPoint point;
+        point.queueIndex = queueIndex;
+        point.value = value;
+        m_submitPoints.add(point);
+    }
+
+    void _retireRingAllocations()
+    {
+        if (m_constantBufferRing)
+            m_constantBufferRing->retire(m_version, m_submitPoints.getArrayView());
+        if (m_uploadBufferRing)
+            m_uploadBufferRing->retire(m_version, m_submitPoints.getArrayView());
+        m_submitPoints.clear();
+    }
+
     void reset()
     {
+        _retireRingAllocations();
         m_constantBufferPool.reset();
         m_uploadBufferPool.reset();
         m_readbackBufferPool.reset();
@@ -59,6 +59,9 @@ namespace gfx
     x(vkCreatePipelineLayout) \
     x(vkDestroyPipelineLayout) \
     x(vkCreateComputePipelines) \
+    x(vkCreatePipelineCache) \
+    x(vkDestroyPipelineCache) \
+    x(vkGetPipelineCacheData) \
     x(vkCreateGraphicsPipelines) \
     x(vkDestroyPipeline) \
     x(vkCreateShaderModule) \
@@ -309,6 +312,10 @@ struct VulkanExtendedFeatureProperties
     VkPhysicalDeviceCooperativeVectorFeaturesNV cooperativeVectorFeatures = {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_VECTOR_FEATURES_NV};
 
+    // Mutable descriptor type features
+    VkPhysicalDeviceMutableDescriptorTypeFeaturesEXT mutableDescriptorTypeFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_EXT};
+
     // Ray tracing validation features
     VkPhysicalDeviceRayTracingValidationFeaturesNV rayTracingValidationFeatures = {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_VALIDATION_FEATURES_NV};
@@ -0,0 +1,185 @@
+// vk-bindless-heap.cpp
+#include "vk-bindless-heap.h"
+
+#include "vk-device.h"
+#include "vk-util.h"
+
+namespace gfx
+{
+
+using namespace Slang;
+
+namespace vk
+{
+
+// The descriptor types a resource handle can refer to.
+static const VkDescriptorType kMutableResourceTypes[] = {
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+bool BindlessDescriptorHeap::SlotAllocator::allocate(uint32_t& outSlot)
+{
+    if (freeSlots.getCount())
+    {
+        outSlot = freeSlots.getLast();
+        freeSlots.removeLast();
+        return true;
+    }
+    if (next >= count)
+        return false;
+    outSlot = next++;
+    return true;
+}
+
+bool BindlessDescriptorHeap::isSupported(const VulkanApi& api)
+{
+    const auto& features = api.m_extendedFeatures.vulkan12Features;
+    return api.m_extendedFeatures.mutableDescriptorTypeFeatures.mutableDescriptorType &&
+           features.runtimeDescriptorArray && features.descriptorBindingPartiallyBound &&
+           features.descriptorBindingUpdateUnusedWhilePending &&
+           features.descriptorBindingSampledImageUpdateAfterBind &&
+           features.descriptorBindingStorageImageUpdateAfterBind &&
+           features.descriptorBindingStorageBufferUpdateAfterBind &&
+           features.descriptorBindingUniformTexelBufferUpdateAfterBind &&
+           features.descriptorBindingStorageTexelBufferUpdateAfterBind;
+}
+
+Result BindlessDescriptorHeap::init(DeviceImpl* device, const IDevice::BindlessDesc& desc)
+{
+    m_device = device;
+    auto& api = device->m_api;
+
+    // Vulkan doesn't allow empty pool sizes, so each binding has at least one descriptor.
+    const uint32_t resourceCount = Math::Max(1u, desc.resourceDescriptorCount);
+    const uint32_t samplerCount = Math::Max(1u, desc.samplerDescriptorCount);
+    m_resourceSlots.count = resourceCount;
+    m_samplerSlots.count = samplerCount;
+
+    VkMutableDescriptorTypeListEXT typeLists[3] = {};
+    typeLists[kResourceBinding].descriptorTypeCount = SLANG_COUNT_OF(kMutableResourceTypes);
+    typeLists[kResourceBinding].pDescriptorTypes = kMutableResourceTypes;
+    VkMutableDescriptorTypeCreateInfoEXT mutableInfo = {
+        VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_EXT};
+    mutableInfo.mutableDescriptorTypeListCount = SLANG_COUNT_OF(typeLists);
+    mutableInfo.pMutableDescriptorTypeLists = typeLists;
+
+    VkDescriptorSetLayoutBinding bindings[3] = {};
+    bindings[kSamplerBinding].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    bindings[kSamplerBinding].descriptorCount = samplerCount;
+    bindings[kCombinedTextureSamplerBinding].descriptorType =
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[kCombinedTextureSamplerBinding].descriptorCount = samplerCount;
+    bindings[kResourceBinding].descriptorType = VK_DESCRIPTOR_TYPE_MUTABLE_EXT;
+    bindings[kResourceBinding].descriptorCount = resourceCount;
+    VkDescriptorBindingFlags bindingFlags[3] = {};
+    for (uint32_t i = 0; i < SLANG_COUNT_OF(bindings); ++i)
+    {
+        bindings[i].binding = i;
+        bindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+        bindingFlags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                          VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                          VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO};
+    bindingFlagsInfo.pNext = &mutableInfo;
+    bindingFlagsInfo.bindingCount = SLANG_COUNT_OF(bindingFlags);
+    bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = SLANG_COUNT_OF(bindings);
+    layoutInfo.pBindings = bindings;
+    SLANG_VK_RETURN_ON_FAIL(
+        api.vkCreateDescriptorSetLayout(api.m_device, &layoutInfo, nullptr, &m_setLayout));
+
+    VkDescriptorSetLayoutCreateInfo emptyLayoutInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    SLANG_VK_RETURN_ON_FAIL(api.vkCreateDescriptorSetLayout(
+        api.m_device,
+        &emptyLayoutInfo,
+        nullptr,
+        &m_emptySetLayout));
+
+    // The pool's mutable type list is matched to its pool sizes by index.
+    VkDescriptorPoolSize poolSizes[3] = {};
+    poolSizes[kSamplerBinding] = {VK_DESCRIPTOR_TYPE_SAMPLER, samplerCount};
+    poolSizes[kCombinedTextureSamplerBinding] = {
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        samplerCount};
+    poolSizes[kResourceBinding] = {VK_DESCRIPTOR_TYPE_MUTABLE_EXT, resourceCount};
+    VkDescriptorPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolInfo.pNext = &mutableInfo;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = SLANG_COUNT_OF(poolSizes);
+    poolInfo.pPoolSizes = poolSizes;
+    SLANG_VK_RETURN_ON_FAIL(api.vkCreateDescriptorPool(api.m_device, &poolInfo, nullptr, &m_pool));
+
+    VkDescriptorSetAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    allocInfo.descriptorPool = m_pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_setLayout;
+    SLANG_VK_RETURN_ON_FAIL(
+        api.vkAllocateDescriptorSets(api.m_device, &allocInfo, &m_descriptorSet));
+    return SLANG_OK;
+}
+
+BindlessDescriptorHeap::~BindlessDescriptorHeap()
+{
+    if (!m_device)
+        return;
+    auto& api = m_device->m_api;
+    if (m_pool != VK_NULL_HANDLE)
+        api.vkDestroyDescriptorPool(api.m_device, m_pool, nullptr);
+    if (m_setLayout != VK_NULL_HANDLE)
+        api.vkDestroyDescriptorSetLayout(api.m_device, m_setLayout, nullptr);
+    if (m_emptySetLayout != VK_NULL_HANDLE)
+        api.vkDestroyDescriptorSetLayout(api.m_device, m_emptySetLayout, nullptr);
+}
+
+Result BindlessDescriptorHeap::allocateResource(VkWriteDescriptorSet& write, uint32_t& outSlot)
+{
+    uint32_t slot = 0;
+    if (!m_resourceSlots.allocate(slot))
+        return SLANG_E_OUT_OF_MEMORY;
+    write.dstSet = m_descriptorSet;
+    write.dstBinding = kResourceBinding;
+    write.dstArrayElement = slot;
+    write.descriptorCount = 1;
+    auto& api = m_device->m_api;
+    api.vkUpdateDescriptorSets(api.m_device, 1, &write, 0, nullptr);
+    outSlot = slot;
+    return SLANG_OK;
+}
+
+Result BindlessDescriptorHeap::allocateSampler(VkSampler sampler, uint32_t& outSlot)
+{
+    uint32_t slot = 0;
+    if (!m_samplerSlots.allocate(slot))
+        return SLANG_E_OUT_OF_MEMORY;
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = sampler;
+    VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+    write.dstSet = m_descriptorSet;
+    write.dstBinding = kSamplerBinding;
+    write.dstArrayElement = slot;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    auto& api = m_device->m_api;
+    api.vkUpdateDescriptorSets(api.m_device, 1, &write, 0, nullptr);
+    outSlot = slot;
+    return SLANG_OK;
+}
+
+} // namespace vk
+} // namespace gfx
@@ -0,0 +1,67 @@
+// vk-bindless-heap.h
+#pragma once
+
+#include "vk-base.h"
+
+namespace gfx
+{
+
+using namespace Slang;
+
+namespace vk
+{
+
+/// The descriptor set that `DescriptorHandle<T>` values index into.
+///
+/// The layout matches Slang's default lowering of `DescriptorHandle` for SPIR-V, which assumes
+/// `VK_EXT_mutable_descriptor_type`: samplers are in binding 0, combined texture samplers in
+/// binding 1, and all other resources in the mutable binding 2. The set is bound at the
+/// program's bindless space index alongside the program's own descriptor sets.
+///
+/// A descriptor is written once, when a handle for a view or sampler is first requested, and
+/// its slot is freed when the view or sampler is destroyed.
+class BindlessDescriptorHeap : public RefObject
+{
+public:
+    static const uint32_t kSamplerBinding = 0;
+    static const uint32_t kCombinedTextureSamplerBinding = 1;
+    static const uint32_t kResourceBinding = 2;
+    static const uint32_t kInvalidSlot = 0xFFFFFFFF;
+
+    /// Returns true if the device supports the features the heap requires.
+    static bool isSupported(const VulkanApi& api);
+
+    Result init(DeviceImpl* device, const IDevice::BindlessDesc& desc);
+    ~BindlessDescriptorHeap();
+
+    /// Allocate a slot in the resource binding, and write `write` into it.
+    /// The binding, array element and set of `write` are filled in.
+    Result allocateResource(VkWriteDescriptorSet& write, uint32_t& outSlot);
+    /// Allocate a slot in the sampler binding, and write `sampler` into it.
+    Result allocateSampler(VkSampler sampler, uint32_t& outSlot);
+
+    void freeResource(uint32_t slot) { m_resourceSlots.free(slot); }
+    void freeSampler(uint32_t slot) { m_samplerSlots.free(slot); }
+
+    struct SlotAllocator
+    {
+        uint32_t count = 0;
+        uint32_t next = 0;
+        List<uint32_t> freeSlots;
+
+        bool allocate(uint32_t& outSlot);
+        void free(uint32_t slot) { freeSlots.add(slot); }
+    };
+
+    DeviceImpl* m_device = nullptr;
+    VkDescriptorPool m_pool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+    /// A layout with no bindings, for any unused sets before the bindless set.
+    VkDescriptorSetLayout m_emptySetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+    SlotAllocator m_resourceSlots;
+    SlotAllocator m_samplerSlots;
+};
+
+} // namespace vk
+} // namespace gfx
@@ -132,8 +132,10 @@ Result PipelineCommandEncoder::bindRootShaderObjectImpl(
     // by the specialized program layout.
     //
     List<VkDescriptorSet> descriptorSetsStorage;
+    List<DescriptorSetContents> descriptorSetContentsStorage;
 
     context.descriptorSets = &descriptorSetsStorage;
+    context.descriptorSetContents = &descriptorSetContentsStorage;
 
     // We kick off recursive binding of shader objects to the pipeline (plus
     // the state in `context`).
@@ -146,6 +148,15 @@ Result PipelineCommandEncoder::bindRootShaderObjectImpl(
     //
     rootShaderObject->bindAsRoot(this, context, specializedLayout);
 
+    // Binding only recorded the contents of each descriptor set, so now we
+    // can find or create the sets themselves.
+    //
+    for (Index i = 0; i < descriptorSetsStorage.getCount(); ++i)
+    {
+        descriptorSetsStorage[i] =
+            m_commandBuffer->m_transientHeap->getDescriptorSet(descriptorSetContentsStorage[i]);
+    }
+
     // Once we've filled in all the descriptor sets, we bind them
     // to the pipeline at once.
     //
@@ -162,6 +173,22 @@ Result PipelineCommandEncoder::bindRootShaderObjectImpl(
             nullptr);
     }
 
+    // The bindless heap's set is the same for every draw and dispatch, and follows the
+    // program's own sets.
+    //
+    if (specializedLayout->m_bindlessSetIndex >= 0)
+    {
+        m_device->m_api.vkCmdBindDescriptorSets(
+            m_commandBuffer->m_commandBuffer,
+            bindPoint,
+            specializedLayout->m_pipelineLayout,
+            (uint32_t)specializedLayout->m_bindlessSetIndex,
+            1,
+            &m_device->m_bindlessHeap->m_descriptorSet,
+            0,
+            nullptr);
+    }
+
     return SLANG_OK;
 }
 
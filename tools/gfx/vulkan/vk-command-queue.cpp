@@ -89,8 +89,8 @@ void CommandQueueImpl::queueSubmitImpl(
         auto vkCmdBuf = cmdBufImpl->m_commandBuffer;
         m_submitCommandBuffers.add(vkCmdBuf);
     }
-    Array<VkSemaphore, 2> signalSemaphores;
-    Array<uint64_t, 2> signalValues;
+    Array<VkSemaphore, 3> signalSemaphores;
+    Array<uint64_t, 3> signalValues;
     signalSemaphores.add(m_semaphore);
     signalValues.add(0);
 
@@ -125,6 +125,22 @@ void CommandQueueImpl::queueSubmitImpl(
         auto fenceImpl = static_cast<FenceImpl*>(fence);
         signalSemaphores.add(fenceImpl->m_semaphore);
         signalValues.add(valueToSignal);
+    }
+    // Signal the ring timeline, so the ring memory used by these command buffers can be
+    // reclaimed without waiting on the heaps' fences.
+    if (count && m_renderer->m_ringTimeline != VK_NULL_HANDLE)
+    {
+        uint64_t ringValue = ++m_renderer->m_ringTimelineValue;
+        signalSemaphores.add(m_renderer->m_ringTimeline);
+        signalValues.add(ringValue);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto cmdBufImpl = static_cast<CommandBufferImpl*>(commandBuffers[i]);
+            cmdBufImpl->m_transientHeap->recordSubmitPoint(0, ringValue);
+        }
+    }
+    if (signalValues.getCount() > 1)
+    {
         submitInfo.pNext = &timelineSubmitInfo;
         timelineSubmitInfo.signalSemaphoreValueCount = (uint32_t)signalValues.getCount();
         timelineSubmitInfo.pSignalSemaphoreValues = signalValues.getBuffer();
@@ -4,6 +4,49 @@
 
 namespace gfx
 {
+void DescriptorWrite::set(VkWriteDescriptorSet const& write)
+{
+    memset(this, 0, sizeof(*this));
+    binding = write.dstBinding;
+    arrayElement = write.dstArrayElement;
+    descriptorType = write.descriptorType;
+    if (write.pImageInfo)
+    {
+        imageInfo = *write.pImageInfo;
+    }
+    else if (write.pBufferInfo)
+    {
+        bufferInfo = *write.pBufferInfo;
+    }
+    else if (write.pTexelBufferView)
+    {
+        texelBufferView = *write.pTexelBufferView;
+    }
+    else if (write.pNext)
+    {
+        auto writeAS = (VkWriteDescriptorSetAccelerationStructureKHR const*)write.pNext;
+        accelerationStructure = writeAS->pAccelerationStructures[0];
+    }
+}
+
+Slang::HashCode64 DescriptorSetContents::getHashCode() const
+{
+    Slang::HashCode64 hash = Slang::getHashCode((const char*)&layout, sizeof(layout));
+    return Slang::combineHash(
+        hash,
+        Slang::getHashCode(
+            (const char*)writes.getBuffer(),
+            size_t(writes.getCount()) * sizeof(DescriptorWrite)));
+}
+
+bool DescriptorSetContents::operator==(DescriptorSetContents const& other) const
+{
+    return layout == other.layout && writes.getCount() == other.writes.getCount() &&
+           memcmp(writes.getBuffer(),
+                  other.writes.getBuffer(),
+                  size_t(writes.getCount()) * sizeof(DescriptorWrite)) == 0;
+}
+
 VkDescriptorPool DescriptorSetAllocator::newPool()
 {
     VkDescriptorPoolCreateInfo descriptorPoolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
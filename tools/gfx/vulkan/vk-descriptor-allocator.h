@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "core/slang-hash.h"
 #include "core/slang-list.h"
+#include "core/slang-smart-pointer.h"
 #include "vk-api.h"
 
 namespace gfx
@@ -12,6 +14,42 @@ struct VulkanDescriptorSet
     VkDescriptorSet handle;
     VkDescriptorPool pool;
 };
+
+/// A single descriptor written into a descriptor set.
+/// The whole struct, including the unused part of the union, is zero initialized so that writes
+/// can be compared and hashed as bytes.
+struct DescriptorWrite
+{
+    uint32_t binding;
+    uint32_t arrayElement;
+    VkDescriptorType descriptorType;
+    union
+    {
+        VkDescriptorBufferInfo bufferInfo;
+        VkDescriptorImageInfo imageInfo;
+        VkBufferView texelBufferView;
+        VkAccelerationStructureKHR accelerationStructure;
+    };
+
+    /// Set from a `VkWriteDescriptorSet` of a single descriptor.
+    void set(VkWriteDescriptorSet const& write);
+};
+
+/// The contents of a descriptor set: its layout, and every descriptor written into it.
+/// Used as the key of the descriptor set cache, so sets with identical contents are only
+/// allocated and written once.
+struct DescriptorSetContents
+{
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    Slang::List<DescriptorWrite> writes;
+    // The objects the descriptors refer to. These are not part of the key, but holding them
+    // means their handles can't be reused by new objects while a cached set refers to them.
+    Slang::List<Slang::RefPtr<Slang::RefObject>> objects;
+
+    Slang::HashCode64 getHashCode() const;
+    bool operator==(DescriptorSetContents const& other) const;
+};
+
 class DescriptorSetAllocator
 {
 public:
@@ -1,6 +1,8 @@
 // vk-device.cpp
 #include "vk-device.h"
 
+#include "core/slang-crypto.h"
+#include "core/slang-io.h"
 #include "core/slang-platform.h"
 #include "vk-buffer.h"
 #include "vk-command-queue.h"
@@ -64,8 +66,24 @@ DeviceImpl::~DeviceImpl()
 
     m_deviceQueue.destroy();
 
+    m_constantBufferRing = nullptr;
+    m_uploadBufferRing = nullptr;
+    m_bindlessHeap = nullptr;
+    if (m_ringTimeline != VK_NULL_HANDLE)
+    {
+        m_api.vkDestroySemaphore(m_device, m_ringTimeline, nullptr);
+        m_ringTimeline = VK_NULL_HANDLE;
+    }
+
     descriptorSetAllocator.close();
 
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        savePipelineCache();
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+
     m_emptyFramebuffer = nullptr;
 
     if (m_device != VK_NULL_HANDLE)
@@ -516,6 +534,10 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
         extendedFeatures.cooperativeVectorFeatures.pNext = deviceFeatures2.pNext;
         deviceFeatures2.pNext = &extendedFeatures.cooperativeVectorFeatures;
 
+        // mutable descriptor type features
+        extendedFeatures.mutableDescriptorTypeFeatures.pNext = deviceFeatures2.pNext;
+        deviceFeatures2.pNext = &extendedFeatures.mutableDescriptorTypeFeatures;
+
         // Atomic Float
         // To detect atomic float we need
         // https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkPhysicalDeviceShaderAtomicFloatFeaturesEXT.html
@@ -737,6 +759,12 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
             VK_NV_COOPERATIVE_VECTOR_EXTENSION_NAME,
             "cooperative-vector");
 
+        SIMPLE_EXTENSION_FEATURE(
+            extendedFeatures.mutableDescriptorTypeFeatures,
+            mutableDescriptorType,
+            VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME,
+            "mutable-descriptor-type");
+
 #undef SIMPLE_EXTENSION_FEATURE
 
         if (extendedFeatures.vulkan12Features.shaderBufferInt64Atomics)
@@ -999,6 +1027,62 @@ Result DeviceImpl::initVulkanInstanceAndDevice(
     return SLANG_OK;
 }
 
+Result DeviceImpl::initPipelineCache(const char* directory)
+{
+    // The driver ignores cache data written by a different device or driver, but keeping a file
+    // for each means that machines with several GPUs, or switching drivers, don't keep
+    // overwriting each other's pipelines.
+    const auto& props = m_api.m_deviceProperties;
+    StringBuilder fileName;
+    fileName << "vulkan-pipeline-cache-";
+    fileName.append(props.vendorID, 16);
+    fileName << "-";
+    fileName.append(props.deviceID, 16);
+    fileName << "-";
+    fileName.append(props.driverVersion, 16);
+    fileName << "-";
+    fileName << DigestUtil::digestToString(props.pipelineCacheUUID, VK_UUID_SIZE);
+    fileName << ".bin";
+
+    Path::createDirectoryRecursive(directory);
+    m_pipelineCacheFileName = Path::combine(directory, fileName);
+
+    List<uint8_t> initialData;
+    File::readAllBytes(m_pipelineCacheFileName, initialData);
+
+    VkPipelineCacheCreateInfo createInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    createInfo.initialDataSize = size_t(initialData.getCount());
+    createInfo.pInitialData = initialData.getBuffer();
+    if (m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache) !=
+        VK_SUCCESS)
+    {
+        // The data may be corrupt, so start again with an empty cache.
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        SLANG_VK_RETURN_ON_FAIL(
+            m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache));
+    }
+    return SLANG_OK;
+}
+
+void DeviceImpl::savePipelineCache()
+{
+    size_t size = 0;
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, nullptr) != VK_SUCCESS ||
+        size == 0)
+    {
+        return;
+    }
+    List<uint8_t> data;
+    data.setCount(Index(size));
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, data.getBuffer()) !=
+        VK_SUCCESS)
+    {
+        return;
+    }
+    File::writeAllBytes(m_pipelineCacheFileName, data.getBuffer(), size);
+}
+
 SlangResult DeviceImpl::initialize(const Desc& desc)
 {
     // Initialize device info.
@@ -1040,6 +1124,11 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         SLANG_RETURN_ON_FAIL(m_deviceQueue.init(m_api, queue, m_queueFamilyIndex));
     }
 
+    if (desc.pipelineCache.pipelineCachePath)
+    {
+        SLANG_RETURN_ON_FAIL(initPipelineCache(desc.pipelineCache.pipelineCachePath));
+    }
+
     SLANG_RETURN_ON_FAIL(slangContext.initialize(
         desc.slang,
         desc.extendedDescCount,
@@ -1084,9 +1173,74 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         m_emptyFramebuffer->m_renderer.breakStrongReference();
     }
 
+    SLANG_RETURN_ON_FAIL(initRingBuffers());
+
+    if (desc.bindless.resourceDescriptorCount || desc.bindless.samplerDescriptorCount)
+    {
+        if (!BindlessDescriptorHeap::isSupported(m_api))
+            return SLANG_E_NOT_AVAILABLE;
+        m_bindlessHeap = new BindlessDescriptorHeap();
+        SLANG_RETURN_ON_FAIL(m_bindlessHeap->init(this, desc.bindless));
+        m_features.add("bindless");
+    }
+
     return SLANG_OK;
 }
 
+Result DeviceImpl::initRingBuffers()
+{
+    if (!m_api.m_extendedFeatures.vulkan12Features.timelineSemaphore)
+        return SLANG_OK;
+
+    VkSemaphoreTypeCreateInfo timelineCreateInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = 0;
+    VkSemaphoreCreateInfo createInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    createInfo.pNext = &timelineCreateInfo;
+    SLANG_VK_RETURN_ON_FAIL(
+        m_api.vkCreateSemaphore(m_device, &createInfo, nullptr, &m_ringTimeline));
+
+    const size_t kRingSize = 32 * 1024 * 1024;
+    const uint32_t alignment = Math::Max(
+        256u,
+        (uint32_t)m_api.m_deviceProperties.limits.minUniformBufferOffsetAlignment);
+
+    m_constantBufferRing = new RingBufferAllocator<DeviceImpl, BufferResourceImpl>();
+    SLANG_RETURN_ON_FAIL(m_constantBufferRing->init(
+        this,
+        isRingSubmitPointComplete,
+        kRingSize,
+        alignment,
+        ResourceStateSet(
+            ResourceState::ConstantBuffer,
+            ResourceState::CopySource,
+            ResourceState::CopyDestination)));
+    m_uploadBufferRing = new RingBufferAllocator<DeviceImpl, BufferResourceImpl>();
+    SLANG_RETURN_ON_FAIL(m_uploadBufferRing->init(
+        this,
+        isRingSubmitPointComplete,
+        kRingSize,
+        alignment,
+        ResourceStateSet(ResourceState::CopySource, ResourceState::CopyDestination)));
+
+    // The device owns the rings, so their buffers must not keep the device alive.
+    m_constantBufferRing->m_buffer->m_renderer = nullptr;
+    m_uploadBufferRing->m_buffer->m_renderer = nullptr;
+    return SLANG_OK;
+}
+
+bool DeviceImpl::isRingSubmitPointComplete(DeviceImpl* device, const RingSubmitPoint& point)
+{
+    uint64_t value = 0;
+    auto& api = device->m_api;
+    if (api.vkGetSemaphoreCounterValue(api.m_device, device->m_ringTimeline, &value) !=
+        VK_SUCCESS)
+    {
+        return false;
+    }
+    return value >= point.value;
+}
+
 void DeviceImpl::waitForGpu()
 {
     m_deviceQueue.flushAndWait();
@@ -3,6 +3,7 @@
 
 #include "glslang-module.h"
 #include "vk-base.h"
+#include "vk-bindless-heap.h"
 #include "vk-framebuffer.h"
 
 namespace gfx
@@ -18,6 +19,13 @@ class DeviceImpl : public RendererBase
 public:
     // Renderer    implementation
     Result initVulkanInstanceAndDevice(const InteropHandle* handles, bool useValidationLayer);
+    /// Create the pipeline cache, with the data saved by an earlier run if there is any.
+    Result initPipelineCache(const char* directory);
+    /// Write the contents of the pipeline cache to its file.
+    void savePipelineCache();
+    /// Create the rings transient heaps allocate constant data and upload staging from.
+    Result initRingBuffers();
+    static bool isRingSubmitPointComplete(DeviceImpl* device, const RingSubmitPoint& point);
     virtual SLANG_NO_THROW Result SLANG_MCALL initialize(const Desc& desc) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
     getFormatSupportedResourceStates(Format format, ResourceStateSet* outStates) override;
@@ -226,8 +234,25 @@ public:
 
     VkSampler m_defaultSampler;
 
+    // Pipeline cache persisted to `m_pipelineCacheFileName`, if the device was created with a
+    // pipeline cache path.
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+    String m_pipelineCacheFileName;
+
     RefPtr<FramebufferImpl> m_emptyFramebuffer;
 
+    // Rings shared by all transient heaps, which are only created if timeline semaphores are
+    // supported. Every submission signals the next value of `m_ringTimeline`, and there is only
+    // one queue, so a point on it is reached once all earlier submissions complete.
+    RefPtr<RingBufferAllocator<DeviceImpl, BufferResourceImpl>> m_constantBufferRing;
+    RefPtr<RingBufferAllocator<DeviceImpl, BufferResourceImpl>> m_uploadBufferRing;
+    VkSemaphore m_ringTimeline = VK_NULL_HANDLE;
+    uint64_t m_ringTimelineValue = 0;
+
+    // The descriptor set `DescriptorHandle` values index into, which is only created if the
+    // device was created with a non-empty `Desc::bindless`.
+    RefPtr<BindlessDescriptorHeap> m_bindlessHeap;
+
     // If true, slang will skip downstream linking, so we need to do it ourselves
     bool m_skipsDownstreamLinking = false;
 };
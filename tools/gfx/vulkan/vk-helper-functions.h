@@ -129,6 +129,11 @@ struct RootBindingContext
     /// The descriptor sets that are being allocated and bound
     List<VkDescriptorSet>* descriptorSets;
 
+    /// The contents of each set in `descriptorSets`. Descriptors are recorded here rather than
+    /// written directly, so that a set with the same contents as one written earlier can be
+    /// reused. The sets are allocated and written once binding is complete.
+    List<DescriptorSetContents>* descriptorSetContents;
+
     /// Information about all the push-constant ranges that should be bound
     ConstArrayView<VkPushConstantRange> pushConstantRanges;
 };
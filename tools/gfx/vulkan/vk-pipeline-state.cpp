@@ -70,7 +70,7 @@ void PipelineStateImpl::init(const RayTracingPipelineStateDesc& inDesc)
 
 Result PipelineStateImpl::createVKGraphicsPipelineState()
 {
-    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache pipelineCache = m_device->m_pipelineCache;
 
     auto inputLayoutImpl = (InputLayoutImpl*)desc.graphics.inputLayout;
 
@@ -324,7 +324,7 @@ Result PipelineStateImpl::createVKComputePipelineState()
     }
     else
     {
-        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+        VkPipelineCache pipelineCache = m_device->m_pipelineCache;
         SLANG_VK_RETURN_ON_FAIL(m_device->m_api.vkCreateComputePipelines(
             m_device->m_device,
             pipelineCache,
@@ -471,7 +471,7 @@ Result RayTracingPipelineStateImpl::createVKRayTracingPipelineState()
             programImpl->linkedProgram.get());
     }
 
-    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache pipelineCache = m_device->m_pipelineCache;
     SLANG_VK_RETURN_ON_FAIL(m_device->m_api.vkCreateRayTracingPipelinesKHR(
         m_device->m_device,
         VK_NULL_HANDLE,
@@ -9,6 +9,64 @@ using namespace Slang;
 namespace vk
 {
 
+ResourceViewImpl::~ResourceViewImpl()
+{
+    if (m_bindlessSlot != BindlessDescriptorHeap::kInvalidSlot)
+        m_device->m_bindlessHeap->freeResource(m_bindlessSlot);
+}
+
+Result ResourceViewImpl::getDescriptorHandle(uint64_t* outHandle)
+{
+    *outHandle = 0;
+    auto heap = m_device->m_bindlessHeap.Ptr();
+    if (!heap)
+        return SLANG_E_NOT_AVAILABLE;
+
+    if (m_bindlessSlot == BindlessDescriptorHeap::kInvalidSlot)
+    {
+        const bool isUnorderedAccess = m_desc.type == IResourceView::Type::UnorderedAccess;
+        VkDescriptorImageInfo imageInfo = {};
+        VkDescriptorBufferInfo bufferInfo = {};
+        VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        switch (m_type)
+        {
+        case ViewType::Texture:
+            {
+                auto view = static_cast<TextureResourceViewImpl*>(this);
+                imageInfo.imageView = view->m_view;
+                imageInfo.imageLayout = view->m_layout;
+                write.descriptorType = isUnorderedAccess ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                                                         : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                write.pImageInfo = &imageInfo;
+                break;
+            }
+        case ViewType::TexelBuffer:
+            {
+                auto view = static_cast<TexelBufferResourceViewImpl*>(this);
+                write.descriptorType = isUnorderedAccess ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                                                         : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                write.pTexelBufferView = &view->m_view;
+                break;
+            }
+        case ViewType::PlainBuffer:
+            {
+                auto view = static_cast<PlainBufferResourceViewImpl*>(this);
+                bufferInfo.buffer = view->m_buffer->m_buffer.m_buffer;
+                bufferInfo.offset = view->offset;
+                bufferInfo.range = view->size;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write.pBufferInfo = &bufferInfo;
+                break;
+            }
+        default:
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        SLANG_RETURN_ON_FAIL(heap->allocateResource(write, m_bindlessSlot));
+    }
+    *outHandle = m_bindlessSlot;
+    return SLANG_OK;
+}
+
 TextureResourceViewImpl::~TextureResourceViewImpl()
 {
     m_device->m_api.vkDestroyImageView(m_device->m_api.m_device, m_view, nullptr);
@@ -60,6 +118,13 @@ Result AccelerationStructureImpl::getNativeHandle(InteropHandle* outHandle)
     return SLANG_OK;
 }
 
+Result AccelerationStructureImpl::getDescriptorHandle(uint64_t* outHandle)
+{
+    // Acceleration structure handles hold the device address rather than a heap slot.
+    *outHandle = getDeviceAddress();
+    return SLANG_OK;
+}
+
 AccelerationStructureImpl::~AccelerationStructureImpl()
 {
     if (m_device)
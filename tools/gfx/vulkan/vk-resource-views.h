@@ -29,8 +29,13 @@ public:
         : m_type(viewType), m_device(device)
     {
     }
+    ~ResourceViewImpl();
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
     ViewType m_type;
     RefPtr<DeviceImpl> m_device;
+    /// The view's slot in the device's bindless heap, allocated when its handle is first
+    /// requested.
+    uint32_t m_bindlessSlot = BindlessDescriptorHeap::kInvalidSlot;
 };
 
 class TextureResourceViewImpl : public ResourceViewImpl
@@ -81,6 +86,7 @@ public:
 public:
     virtual SLANG_NO_THROW DeviceAddress SLANG_MCALL getDeviceAddress() override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
     ~AccelerationStructureImpl();
 };
 
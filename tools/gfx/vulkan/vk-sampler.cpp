@@ -16,6 +16,8 @@ SamplerStateImpl::SamplerStateImpl(DeviceImpl* device)
 
 SamplerStateImpl::~SamplerStateImpl()
 {
+    if (m_bindlessSlot != BindlessDescriptorHeap::kInvalidSlot)
+        m_device->m_bindlessHeap->freeSampler(m_bindlessSlot);
     m_device->m_api.vkDestroySampler(m_device->m_api.m_device, m_sampler, nullptr);
 }
 
@@ -26,5 +28,17 @@ Result SamplerStateImpl::getNativeHandle(InteropHandle* outHandle)
     return SLANG_OK;
 }
 
+Result SamplerStateImpl::getDescriptorHandle(uint64_t* outHandle)
+{
+    *outHandle = 0;
+    auto heap = m_device->m_bindlessHeap.Ptr();
+    if (!heap)
+        return SLANG_E_NOT_AVAILABLE;
+    if (m_bindlessSlot == BindlessDescriptorHeap::kInvalidSlot)
+        SLANG_RETURN_ON_FAIL(heap->allocateSampler(m_sampler, m_bindlessSlot));
+    *outHandle = m_bindlessSlot;
+    return SLANG_OK;
+}
+
 } // namespace vk
 } // namespace gfx
@@ -20,6 +20,10 @@ public:
     SamplerStateImpl(DeviceImpl* device);
     ~SamplerStateImpl();
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getDescriptorHandle(uint64_t* outHandle) override;
+    /// The sampler's slot in the device's bindless heap, allocated when its handle is first
+    /// requested.
+    uint32_t m_bindlessSlot = BindlessDescriptorHeap::kInvalidSlot;
 };
 
 } // namespace vk
@@ -772,6 +772,25 @@ Result RootShaderObjectLayout::_init(Builder const* builder)
     //
     SLANG_RETURN_ON_FAIL(addAllDescriptorSets());
 
+    // If the program uses `DescriptorHandle`s and the device has a bindless heap, the heap's
+    // set goes in the space Slang reserved for it, after the program's own sets.
+    //
+    if (auto heap = renderer->m_bindlessHeap.Ptr())
+    {
+        const SlangInt bindlessSpace = m_programLayout->getBindlessSpaceIndex();
+        if (bindlessSpace >= 0)
+        {
+            if (bindlessSpace >= kMaxDescriptorSets)
+                return SLANG_FAIL;
+            while (m_vkDescriptorSetLayouts.getCount() < (Index)bindlessSpace)
+                m_vkDescriptorSetLayouts.add(heap->m_emptySetLayout);
+            if (m_vkDescriptorSetLayouts.getCount() != (Index)bindlessSpace)
+                return SLANG_FAIL;
+            m_vkDescriptorSetLayouts.add(heap->m_setLayout);
+            m_bindlessSetIndex = (int32_t)bindlessSpace;
+        }
+    }
+
     // We will also use a recursive walk to collect all the push-constant
     // ranges needed for this object, sub-objects, and entry points.
     //
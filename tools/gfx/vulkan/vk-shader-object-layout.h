@@ -421,6 +421,8 @@ public:
     List<EntryPointInfo> m_entryPoints;
     VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
     Array<VkDescriptorSetLayout, kMaxDescriptorSets> m_vkDescriptorSetLayouts;
+    /// The set the device's bindless heap is bound to, or -1 if the program doesn't use it.
+    int32_t m_bindlessSetIndex = -1;
     List<VkPushConstantRange> m_allPushConstantRanges;
     uint32_t m_totalPushConstantSize = 0;
 
@@ -238,10 +238,19 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
 void ShaderObjectImpl::writeDescriptor(
     RootBindingContext& context,
-    VkWriteDescriptorSet const& write)
+    uint32_t setIndex,
+    VkWriteDescriptorSet const& write,
+    RefObject* object,
+    RefObject* sampler)
 {
-    auto device = context.device;
-    device->m_api.vkUpdateDescriptorSets(device->m_device, 1, &write, 0, nullptr);
+    auto& contents = (*context.descriptorSetContents)[setIndex];
+    DescriptorWrite descriptorWrite;
+    descriptorWrite.set(write);
+    contents.writes.add(descriptorWrite);
+    if (object)
+        contents.objects.add(object);
+    if (sampler)
+        contents.objects.add(sampler);
 }
 
 void ShaderObjectImpl::writeBufferDescriptor(
@@ -252,8 +261,6 @@ void ShaderObjectImpl::writeBufferDescriptor(
     Offset bufferOffset,
     Size bufferSize)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     VkDescriptorBufferInfo bufferInfo = {};
     if (buffer)
     {
@@ -268,10 +275,9 @@ void ShaderObjectImpl::writeBufferDescriptor(
     write.descriptorType = descriptorType;
     write.dstArrayElement = 0;
     write.dstBinding = offset.binding;
-    write.dstSet = descriptorSet;
     write.pBufferInfo = &bufferInfo;
 
-    writeDescriptor(context, write);
+    writeDescriptor(context, offset.bindingSet, write, buffer);
 }
 
 void ShaderObjectImpl::writeBufferDescriptor(
@@ -295,8 +301,6 @@ void ShaderObjectImpl::writePlainBufferDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -321,10 +325,9 @@ void ShaderObjectImpl::writePlainBufferDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pBufferInfo = &bufferInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, resourceViews[i].Ptr());
     }
 }
 
@@ -334,8 +337,6 @@ void ShaderObjectImpl::writeTexelBufferDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -355,10 +356,9 @@ void ShaderObjectImpl::writeTexelBufferDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.descriptorCount = 1;
         write.pTexelBufferView = &bufferView;
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, resourceViews[i].Ptr());
     }
 }
 
@@ -368,8 +368,6 @@ void ShaderObjectImpl::writeTextureSamplerDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<CombinedTextureSamplerSlot> slots)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = slots.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -396,10 +394,9 @@ void ShaderObjectImpl::writeTextureSamplerDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, texture.Ptr(), sampler.Ptr());
     }
 }
 
@@ -409,8 +406,6 @@ void ShaderObjectImpl::writeAccelerationStructureDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -440,9 +435,8 @@ void ShaderObjectImpl::writeAccelerationStructureDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pNext = &writeAS;
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, accelerationStructure);
     }
 }
 
@@ -452,8 +446,6 @@ void ShaderObjectImpl::writeTextureDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<ResourceViewInternalBase>> resourceViews)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = resourceViews.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -476,10 +468,9 @@ void ShaderObjectImpl::writeTextureDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, resourceViews[i].Ptr());
     }
 }
 
@@ -489,8 +480,6 @@ void ShaderObjectImpl::writeSamplerDescriptor(
     VkDescriptorType descriptorType,
     ArrayView<RefPtr<SamplerStateImpl>> samplers)
 {
-    auto descriptorSet = (*context.descriptorSets)[offset.bindingSet];
-
     Index count = samplers.getCount();
     for (Index i = 0; i < count; ++i)
     {
@@ -513,10 +502,9 @@ void ShaderObjectImpl::writeSamplerDescriptor(
         write.descriptorType = descriptorType;
         write.dstArrayElement = uint32_t(i);
         write.dstBinding = offset.binding;
-        write.dstSet = descriptorSet;
         write.pImageInfo = &imageInfo;
 
-        writeDescriptor(context, write);
+        writeDescriptor(context, offset.bindingSet, write, sampler.Ptr());
     }
 }
 
@@ -800,16 +788,19 @@ Result ShaderObjectImpl::allocateDescriptorSets(
     //
     for (auto descriptorSetInfo : specializedLayout->getOwnDescriptorSets())
     {
-        auto descriptorSetHandle =
-            context.descriptorSetAllocator->allocate(descriptorSetInfo.descriptorSetLayout).handle;
-
-        // For each set, we need to write it into the set of descriptor sets
+        // For each set, we need to add it to the set of descriptor sets
         // being used for binding. This is done both so that other steps
         // in binding can find the set to fill it in, but also so that
         // we can bind all the descriptor sets to the pipeline when the
         // time comes.
         //
-        (*context.descriptorSets).add(descriptorSetHandle);
+        // The set itself isn't allocated until binding is complete and its
+        // contents are known, since an identical set may already exist.
+        //
+        (*context.descriptorSets).add(VK_NULL_HANDLE);
+        DescriptorSetContents contents;
+        contents.layout = descriptorSetInfo.descriptorSetLayout;
+        (*context.descriptorSetContents).add(_Move(contents));
     }
 
     return SLANG_OK;
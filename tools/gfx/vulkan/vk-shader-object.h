@@ -72,8 +72,15 @@ protected:
         ShaderObjectLayoutImpl* specializedLayout);
 
 public:
-    /// Write a single descriptor using the Vulkan API
-    static void writeDescriptor(RootBindingContext& context, VkWriteDescriptorSet const& write);
+    /// Record a single descriptor to be written into the set at `setIndex` in the `context`.
+    /// `object` and `sampler` are the objects the descriptor refers to, which are kept alive
+    /// while the set may be reused.
+    static void writeDescriptor(
+        RootBindingContext& context,
+        uint32_t setIndex,
+        VkWriteDescriptorSet const& write,
+        RefObject* object,
+        RefObject* sampler = nullptr);
 
     static void writeBufferDescriptor(
         RootBindingContext& context,
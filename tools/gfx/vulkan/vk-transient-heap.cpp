@@ -37,6 +37,8 @@ Result TransientResourceHeapImpl::init(const ITransientResourceHeap::Desc& desc,
         device);
 
     m_descSetAllocator.m_api = &device->m_api;
+    m_constantBufferRing = device->m_constantBufferRing;
+    m_uploadBufferRing = device->m_uploadBufferRing;
 
     VkCommandPoolCreateInfo poolCreateInfo = {};
     poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -81,6 +83,70 @@ Result TransientResourceHeapImpl::createCommandBuffer(ICommandBuffer** outCmdBuf
     return SLANG_OK;
 }
 
+VkDescriptorSet TransientResourceHeapImpl::getDescriptorSet(DescriptorSetContents const& contents)
+{
+    if (auto descriptorSet = m_descriptorSetCache.tryGetValue(contents))
+        return *descriptorSet;
+
+    auto descriptorSet = m_descSetAllocator.allocate(contents.layout).handle;
+
+    const Index writeCount = contents.writes.getCount();
+    List<VkWriteDescriptorSet> writes;
+    writes.reserve(writeCount);
+    // Reserved up front, so the pointers `writes` hold into it stay valid.
+    List<VkWriteDescriptorSetAccelerationStructureKHR> accelerationStructureWrites;
+    accelerationStructureWrites.reserve(writeCount);
+    for (auto& descriptorWrite : contents.writes)
+    {
+        VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        write.dstSet = descriptorSet;
+        write.dstBinding = descriptorWrite.binding;
+        write.dstArrayElement = descriptorWrite.arrayElement;
+        write.descriptorCount = 1;
+        write.descriptorType = descriptorWrite.descriptorType;
+        switch (descriptorWrite.descriptorType)
+        {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            write.pImageInfo = &descriptorWrite.imageInfo;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            write.pTexelBufferView = &descriptorWrite.texelBufferView;
+            break;
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            {
+                VkWriteDescriptorSetAccelerationStructureKHR writeAS = {
+                    VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR};
+                writeAS.accelerationStructureCount = 1;
+                writeAS.pAccelerationStructures = &descriptorWrite.accelerationStructure;
+                accelerationStructureWrites.add(writeAS);
+                write.pNext = &accelerationStructureWrites.getLast();
+            }
+            break;
+        default:
+            write.pBufferInfo = &descriptorWrite.bufferInfo;
+            break;
+        }
+        writes.add(write);
+    }
+    if (writes.getCount())
+    {
+        m_device->m_api.vkUpdateDescriptorSets(
+            m_device->m_api.m_device,
+            (uint32_t)writes.getCount(),
+            writes.getBuffer(),
+            0,
+            nullptr);
+    }
+
+    m_descriptorSetCache.add(contents, descriptorSet);
+    return descriptorSet;
+}
+
 Result TransientResourceHeapImpl::synchronizeAndReset()
 {
     m_commandBufferAllocId = 0;
@@ -95,6 +161,7 @@ Result TransientResourceHeapImpl::synchronizeAndReset()
         return SLANG_FAIL;
     }
     api.vkResetCommandPool(api.m_device, m_commandPool, 0);
+    m_descriptorSetCache.clear();
     m_descSetAllocator.reset();
     m_fenceIndex = 0;
     Super::reset();
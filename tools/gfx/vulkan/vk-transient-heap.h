@@ -29,6 +29,14 @@ public:
     VkFence getCurrentFence() { return m_fences[m_fenceIndex]; }
     void advanceFence();
 
+    // Descriptor sets allocated from `m_descSetAllocator` since the heap was last reset, by
+    // their contents.
+    Dictionary<DescriptorSetContents, VkDescriptorSet> m_descriptorSetCache;
+
+    /// Get a descriptor set with the given `contents`, reusing one allocated from this heap
+    /// since it was last reset if there is one, or else allocating and writing a new one.
+    VkDescriptorSet getDescriptorSet(DescriptorSetContents const& contents);
+
     Result init(const ITransientResourceHeap::Desc& desc, DeviceImpl* device);
     ~TransientResourceHeapImpl();
 
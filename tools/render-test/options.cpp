@@ -234,6 +234,17 @@ static rhi::DeviceType _toRenderType(Slang::RenderApiType apiType)
         {
             outOptions.performanceProfile = true;
         }
+        else if (argValue == "-benchmark")
+        {
+            CommandLineArg count;
+            SLANG_RETURN_ON_FAIL(reader.expectArg(count));
+            outOptions.benchmarkRepetitionCount = stringToInt(count.value);
+            if (outOptions.benchmarkRepetitionCount < 1)
+            {
+                sink.diagnose(count.loc, RenderTestDiagnostics::expectingPositiveBenchmarkCount);
+                return SLANG_FAIL;
+            }
+        }
         else if (argValue == "-output-using-type")
         {
             outOptions.outputUsingType = true;
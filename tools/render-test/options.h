@@ -70,6 +70,11 @@ struct Options
 
     bool performanceProfile = false;
 
+    /// If set, instead of producing output the shader is compiled, its pipeline created and
+    /// (for compute shaders) dispatched this many times, and the time taken by each step is
+    /// reported.
+    int benchmarkRepetitionCount = 0;
+
     bool dontAddDefaultEntryPoints = false;
 
     bool disableDebugInfo = false;
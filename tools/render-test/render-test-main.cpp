@@ -6,6 +6,7 @@
 #include "../source/core/slang-io.h"
 #include "../source/core/slang-std-writers.h"
 #include "../source/core/slang-string-util.h"
+#include "../source/core/slang-type-text-util.h"
 #include "core/slang-token-reader.h"
 #include "options.h"
 #include "png-serialize-util.h"
@@ -233,7 +234,14 @@ public:
 
     Result writeScreen(const String& filename);
 
+    /// Repeatedly compile the shader, create its pipeline and dispatch it, and output the time
+    /// taken by each step.
+    Result runBenchmark();
+
 protected:
+    /// Create a pipeline for `program` for the type of shader being tested
+    ComPtr<IPipeline> _createPipeline(IShaderProgram* program);
+
     /// Called in initialize
     Result _initializeShaders(
         SlangSession* session,
@@ -270,6 +278,7 @@ protected:
     ShaderInputLayout m_shaderInputLayout; ///< The binding layout
 
     Options m_options;
+    ShaderCompilerUtil::Input m_input;
 
     ShaderOutputPlan m_outputPlan;
     TestResourceContext m_resourceContext;
@@ -960,6 +969,7 @@ SlangResult RenderTestApp::initialize(
     }
 
     m_device = device;
+    m_input = input;
 
     _initializeRenderPass();
     _initializeAccelerationStructure();
@@ -972,12 +982,6 @@ SlangResult RenderTestApp::initialize(
             return SLANG_FAIL;
 
         case Options::ShaderProgramType::Compute:
-            {
-                ComputePipelineDesc desc;
-                desc.program = m_shaderProgram;
-
-                m_pipeline = device->createComputePipeline(desc);
-            }
             break;
 
         case Options::ShaderProgramType::Graphics:
@@ -1016,12 +1020,11 @@ SlangResult RenderTestApp::initialize(
                     inputElements.addRange(allInputElements, SLANG_COUNT_OF(allInputElements));
                 }
 
-                ComPtr<IInputLayout> inputLayout;
                 SLANG_RETURN_ON_FAIL(device->createInputLayout(
                     sizeof(Vertex),
                     inputElements.getBuffer(),
                     inputElements.getCount(),
-                    inputLayout.writeRef()));
+                    m_inputLayout.writeRef()));
 
                 BufferDesc vertexBufferDesc;
                 vertexBufferDesc.size = kVertexCount * sizeof(Vertex);
@@ -1031,40 +1034,15 @@ SlangResult RenderTestApp::initialize(
 
                 SLANG_RETURN_ON_FAIL(
                     device->createBuffer(vertexBufferDesc, kVertexData, m_vertexBuffer.writeRef()));
-
-                ColorTargetDesc colorTarget;
-                colorTarget.format = Format::RGBA8Unorm;
-                RenderPipelineDesc desc;
-                desc.program = m_shaderProgram;
-                desc.inputLayout = inputLayout;
-                desc.targets = &colorTarget;
-                desc.targetCount = 1;
-                desc.depthStencil.format = Format::D32Float;
-                m_pipeline = device->createRenderPipeline(desc);
             }
             break;
 
         case Options::ShaderProgramType::GraphicsMeshCompute:
         case Options::ShaderProgramType::GraphicsTaskMeshCompute:
-            {
-                ColorTargetDesc colorTarget;
-                colorTarget.format = Format::RGBA8Unorm;
-                RenderPipelineDesc desc;
-                desc.program = m_shaderProgram;
-                desc.targets = &colorTarget;
-                desc.targetCount = 1;
-                desc.depthStencil.format = Format::D32Float;
-                m_pipeline = device->createRenderPipeline(desc);
-            }
             break;
 
         case Options::ShaderProgramType::RayTracing:
             {
-                RayTracingPipelineDesc desc;
-                desc.program = m_shaderProgram;
-
-                m_pipeline = device->createRayTracingPipeline(desc);
-
                 const char* raygenNames[] = {"raygenMain"};
 
                 // We don't define a miss shader for this test. OptiX allows
@@ -1085,10 +1063,52 @@ SlangResult RenderTestApp::initialize(
             break;
         }
     }
+    m_pipeline = _createPipeline(m_shaderProgram);
+
     // If success must have a pipeline state
     return m_pipeline ? SLANG_OK : SLANG_FAIL;
 }
 
+ComPtr<IPipeline> RenderTestApp::_createPipeline(IShaderProgram* program)
+{
+    switch (m_options.shaderType)
+    {
+    case Options::ShaderProgramType::Compute:
+        {
+            ComputePipelineDesc desc;
+            desc.program = program;
+            return ComPtr<IPipeline>(m_device->createComputePipeline(desc));
+        }
+
+    case Options::ShaderProgramType::Graphics:
+    case Options::ShaderProgramType::GraphicsCompute:
+    case Options::ShaderProgramType::GraphicsMeshCompute:
+    case Options::ShaderProgramType::GraphicsTaskMeshCompute:
+        {
+            // Mesh shaders don't have an input layout
+            ColorTargetDesc colorTarget;
+            colorTarget.format = Format::RGBA8Unorm;
+            RenderPipelineDesc desc;
+            desc.program = program;
+            desc.inputLayout = m_inputLayout;
+            desc.targets = &colorTarget;
+            desc.targetCount = 1;
+            desc.depthStencil.format = Format::D32Float;
+            return ComPtr<IPipeline>(m_device->createRenderPipeline(desc));
+        }
+
+    case Options::ShaderProgramType::RayTracing:
+        {
+            RayTracingPipelineDesc desc;
+            desc.program = program;
+            return ComPtr<IPipeline>(m_device->createRayTracingPipeline(desc));
+        }
+
+    default:
+        return ComPtr<IPipeline>();
+    }
+}
+
 Result RenderTestApp::_initializeShaders(
     SlangSession* session,
     IDevice* device,
@@ -1540,6 +1560,133 @@ Result RenderTestApp::update()
     return SLANG_OK;
 }
 
+// Times taken by one step of the benchmark, in milliseconds
+struct BenchmarkTimes
+{
+    const char* name;
+    List<double> times;
+};
+
+static void _outputBenchmarkTimes(const BenchmarkTimes& step)
+{
+    WriterHelper out = StdWriters::getOut();
+    if (step.times.getCount() == 0)
+    {
+        out.print("%-20s %12s %12s %12s\n", step.name, "-", "-", "-");
+        return;
+    }
+
+    List<double> sorted(step.times);
+    sorted.sort();
+    double total = 0;
+    for (auto time : sorted)
+        total += time;
+    out.print(
+        "%-20s %12.3f %12.3f %12.3f\n",
+        step.name,
+        sorted[0],
+        sorted[sorted.getCount() / 2],
+        total / double(sorted.getCount()));
+}
+
+Result RenderTestApp::runBenchmark()
+{
+    auto globalSession = m_device->getSlangSession()->getGlobalSession();
+    const double tickToMs = 1000.0 / double(Process::getClockFrequency());
+
+    // Compiling the shaders to target code is done by Slang when the pipeline is created. The
+    // session records the time spent in code generation, and in the downstream compiler, and so
+    // the time taken by the driver is what remains of the pipeline creation.
+    BenchmarkTimes compileTimes = {"slang-compile"};
+    BenchmarkTimes codeGenTimes = {"slang-codegen"};
+    BenchmarkTimes downstreamTimes = {"downstream"};
+    BenchmarkTimes driverTimes = {"driver-pipeline"};
+    BenchmarkTimes dispatchTimes = {"dispatch"};
+
+    for (int i = 0; i < m_options.benchmarkRepetitionCount; ++i)
+    {
+        uint64_t startTicks = Process::getClockTick();
+        ShaderCompilerUtil::OutputAndLayout compilationOutput;
+        SLANG_RETURN_ON_FAIL(ShaderCompilerUtil::compileWithLayout(
+            globalSession,
+            m_options,
+            m_input,
+            compilationOutput));
+        compileTimes.times.add(double(Process::getClockTick() - startTicks) * tickToMs);
+
+        double startTotalTime = 0;
+        double startDownstreamTime = 0;
+        globalSession->getCompilerElapsedTime(&startTotalTime, &startDownstreamTime);
+
+        startTicks = Process::getClockTick();
+        ComPtr<IShaderProgram> shaderProgram;
+        ComPtr<ISlangBlob> diagnostics;
+        SLANG_RETURN_ON_FAIL(m_device->createShaderProgram(
+            compilationOutput.output.desc,
+            shaderProgram.writeRef(),
+            diagnostics.writeRef()));
+        ComPtr<IPipeline> pipeline = _createPipeline(shaderProgram);
+        if (!pipeline)
+        {
+            return SLANG_FAIL;
+        }
+        const double pipelineTime = double(Process::getClockTick() - startTicks) * tickToMs;
+
+        double endTotalTime = 0;
+        double endDownstreamTime = 0;
+        globalSession->getCompilerElapsedTime(&endTotalTime, &endDownstreamTime);
+
+        const double slangTime = (endTotalTime - startTotalTime) * 1000.0;
+        const double downstreamTime = (endDownstreamTime - startDownstreamTime) * 1000.0;
+        codeGenTimes.times.add(slangTime - downstreamTime);
+        downstreamTimes.times.add(downstreamTime);
+        driverTimes.times.add(Math::Max(0.0, pipelineTime - slangTime));
+    }
+
+    // Only compute shaders are dispatched. The bindings are set up once, so that only the
+    // recording, submission and execution of the dispatch is timed.
+    if (m_options.shaderType == Options::ShaderProgramType::Compute)
+    {
+        ComPtr<IShaderObject> rootObject;
+        SLANG_RETURN_ON_FAIL(
+            m_device->createRootShaderObject(m_shaderProgram, rootObject.writeRef()));
+        SLANG_RETURN_ON_FAIL(applyBinding(rootObject));
+        rootObject->finalize();
+
+        for (int i = 0; i < m_options.benchmarkRepetitionCount; ++i)
+        {
+            const uint64_t startTicks = Process::getClockTick();
+            auto encoder = m_queue->createCommandEncoder();
+            auto passEncoder = encoder->beginComputePass();
+            passEncoder->bindPipeline(
+                static_cast<IComputePipeline*>(m_pipeline.get()),
+                rootObject);
+            passEncoder->dispatchCompute(
+                m_options.computeDispatchSize[0],
+                m_options.computeDispatchSize[1],
+                m_options.computeDispatchSize[2]);
+            passEncoder->end();
+            m_queue->submit(encoder->finish());
+            m_queue->waitOnHost();
+            dispatchTimes.times.add(double(Process::getClockTick() - startTicks) * tickToMs);
+        }
+    }
+
+    WriterHelper out = StdWriters::getOut();
+    out.print(
+        "benchmark: device=%s target=%s spirv-direct=%s repetitions=%d\n",
+        getRHI()->getDeviceTypeName(m_options.deviceType),
+        String(TypeTextUtil::getCompileTargetName(m_input.target)).getBuffer(),
+        m_options.generateSPIRVDirectly ? "yes" : "no",
+        m_options.benchmarkRepetitionCount);
+    out.print("%-20s %12s %12s %12s\n", "step", "min ms", "median ms", "mean ms");
+    _outputBenchmarkTimes(compileTimes);
+    _outputBenchmarkTimes(codeGenTimes);
+    _outputBenchmarkTimes(downstreamTimes);
+    _outputBenchmarkTimes(driverTimes);
+    _outputBenchmarkTimes(dispatchTimes);
+    return SLANG_OK;
+}
 
 static SlangResult _setSessionPrelude(
     const Options& options,
@@ -2008,7 +2155,14 @@ static SlangResult _innerMain(
         RenderTestApp app;
         renderDocBeginFrame();
         SLANG_RETURN_ON_FAIL(app.initialize(session, deviceWrapper.get(), options, input));
-        app.update();
+        if (options.benchmarkRepetitionCount > 0)
+        {
+            SLANG_RETURN_ON_FAIL(app.runBenchmark());
+        }
+        else
+        {
+            app.update();
+        }
         renderDocEndFrame();
         app.finalize();
     }
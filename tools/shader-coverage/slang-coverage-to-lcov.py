@@ -7,7 +7,9 @@ Pipeline:
            slangc shader.slang -trace-coverage ...
        This instruments the shader with a synthesized
        `RWStructuredBuffer<uint> __slang_coverage`. Counter slots are
-       assigned one-per-op in traversal order.
+       assigned one-per-op in traversal order. Under
+       `-trace-coverage-mode hit` a slot holds 1 once its statement
+       ran instead of an execution count.
     2. Read the `.coverage-mapping.json` sidecar describing each
        counter's `(file, line)`, or query the same data through
        `ICoverageTracingMetadata`.
@@ -94,6 +96,11 @@ def main():
     if version != 1:
         sys.exit(f"error: unsupported manifest version {version}")
 
+    # Manifests written before the mode was recorded are execution counts.
+    mode = manifest.get("buffer", {}).get("mode", "count")
+    if mode not in ("count", "hit"):
+        sys.exit(f"error: unsupported coverage mode '{mode}'")
+
     total = int(manifest["counters"])
     if total < 0:
         sys.exit(f"error: manifest 'counters' must be non-negative, got {total}")
@@ -104,7 +111,8 @@ def main():
 
     # Aggregate by (file, line). Multiple counter slots may map to the
     # same line because the compiler assigns one slot per counter op;
-    # LCOV wants line-oriented reporting, so sum them here.
+    # LCOV wants line-oriented reporting, so sum them here. Hit flags
+    # are combined with max instead, so a line reads as hit at most once.
     #
     # GCOV/LCOV-style output only admits real source files and positive
     # line numbers. Keep unattributable slots in the manifest/metadata,
@@ -120,7 +128,11 @@ def main():
         if not source or line <= 0:
             skipped_entries += 1
             continue
-        hits_by_line[source][line] += counters[idx]
+        if mode == "hit":
+            hits = min(counters[idx], 1)
+            hits_by_line[source][line] = max(hits_by_line[source][line], hits)
+        else:
+            hits_by_line[source][line] += counters[idx]
 
     out = sys.stdout if args.output == "-" else open(args.output, "w")
     out.write(f"TN:{args.test_name}\n")
@@ -131,6 +143,7 @@ def main():
         out.write("end_of_record\n")
     if out is not sys.stdout:
         out.close()
+    print(f"note: coverage mode: {mode}", file=sys.stderr)
     if skipped_entries:
         print(
             f"note: skipped {skipped_entries} coverage entr"
@@ -11,6 +11,28 @@ import unittest
 SCRIPT = pathlib.Path(__file__).with_name("slang-coverage-to-lcov.py")
 
 
+def run_converter(manifest, counters_text):
+    with tempfile.TemporaryDirectory() as td:
+        manifest_path = pathlib.Path(td) / "shader.coverage-mapping.json"
+        manifest_path.write_text(json.dumps(manifest), encoding="utf-8")
+        return subprocess.run(
+            [
+                sys.executable,
+                str(SCRIPT),
+                "--manifest",
+                str(manifest_path),
+                "--counters-text",
+                "-",
+                "--test-name",
+                "shader_coverage",
+            ],
+            input=counters_text,
+            capture_output=True,
+            text=True,
+            check=True,
+        )
+
+
 class SlangCoverageToLcovTests(unittest.TestCase):
     def test_filters_unattributable_entries_from_lcov(self):
         manifest = {
@@ -23,27 +45,7 @@ class SlangCoverageToLcovTests(unittest.TestCase):
             ],
         }
 
-        with tempfile.TemporaryDirectory() as td:
-            td_path = pathlib.Path(td)
-            manifest_path = td_path / "shader.coverage-mapping.json"
-            manifest_path.write_text(json.dumps(manifest), encoding="utf-8")
-
-            result = subprocess.run(
-                [
-                    sys.executable,
-                    str(SCRIPT),
-                    "--manifest",
-                    str(manifest_path),
-                    "--counters-text",
-                    "-",
-                    "--test-name",
-                    "shader_coverage",
-                ],
-                input="5 7 11\n",
-                capture_output=True,
-                text=True,
-                check=True,
-            )
+        result = run_converter(manifest, "5 7 11\n")
 
         self.assertEqual(
             result.stdout,
@@ -56,6 +58,30 @@ class SlangCoverageToLcovTests(unittest.TestCase):
             "note: skipped 2 coverage entries without attributable source location",
             result.stderr,
         )
+        self.assertIn("note: coverage mode: count", result.stderr)
+
+    def test_hit_mode_reports_each_line_at_most_once(self):
+        manifest = {
+            "counters": 3,
+            "buffer": {"name": "__slang_coverage", "mode": "hit"},
+            "entries": [
+                {"index": 0, "file": "shader.slang", "line": 12},
+                {"index": 1, "file": "shader.slang", "line": 12},
+                {"index": 2, "file": "shader.slang", "line": 13},
+            ],
+        }
+
+        result = run_converter(manifest, "1 1 0\n")
+
+        self.assertEqual(
+            result.stdout,
+            "TN:shader_coverage\n"
+            "SF:shader.slang\n"
+            "DA:12,1\n"
+            "DA:13,0\n"
+            "end_of_record\n",
+        )
+        self.assertIn("note: coverage mode: hit", result.stderr)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,744 @@
+// slang-benchmark-main.cpp
+
+// Measures how long representative compilation workloads take through the
+// `slang::IGlobalSession` API, and writes the results as JSON:
+//
+//   slang-benchmark [-samples <count>] [-warmup <count>] [-target <name>] [-profile <name>]
+//                   [-workload <name>]... [-o <path>]
+//
+// Every workload is run `-warmup` times without being measured, and then `-samples` times.
+// For each workload the report has the percentiles of the wall clock time per sample, the mean
+// time spent in each compiler phase per sample, and the peak resident set size of the process
+// after the workload ran. Because the peak resident set only grows, run one workload per process
+// with `-workload` to get a peak for that workload alone.
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-math.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-std-writers.h"
+#include "../../source/core/slang-string-escape-util.h"
+#include "../../source/core/slang-type-text-util.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if SLANG_WINDOWS_FAMILY
+#include <windows.h>
+//
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Slang;
+
+namespace
+{
+
+struct BenchmarkOptions
+{
+    Index sampleCount = 8;
+    Index warmupCount = 1;
+    SlangCompileTarget target = SLANG_SPIRV;
+    String targetName = "spirv";
+    String profileName = "spirv_1_5";
+    List<String> workloadNames;
+    String outputPath;
+};
+
+struct BenchmarkContext
+{
+    BenchmarkOptions options;
+    ComPtr<slang::IGlobalSession> globalSession;
+
+    /// Used only to read the phase timings, which are recorded per thread.
+    ComPtr<slang::ICompileRequest> profileRequest;
+
+    /// The serialized library module used by the "precompiled-module-link" workload.
+    ComPtr<ISlangBlob> precompiledLibrary;
+};
+
+struct Workload
+{
+    const char* name;
+    const char* description;
+
+    /// Optional. Called once before the workload is run, and not measured.
+    SlangResult (*prepare)(BenchmarkContext& context);
+
+    /// Run one sample of the workload.
+    SlangResult (*run)(BenchmarkContext& context);
+};
+
+struct PhaseTime
+{
+    String phaseName;
+    uint64_t selfMicroseconds = 0;
+};
+
+struct WorkloadResult
+{
+    const char* name;
+    List<double> sampleMilliseconds;
+    List<PhaseTime> phases;
+    uint64_t peakResidentBytes = 0;
+};
+
+} // namespace
+
+static void _writeDiagnostics(ISlangBlob* diagnostics)
+{
+    if (diagnostics && diagnostics->getBufferSize())
+    {
+        StdWriters::getError().put(UnownedStringSlice(
+            (const char*)diagnostics->getBufferPointer(),
+            diagnostics->getBufferSize()));
+    }
+}
+
+static uint64_t _getPeakResidentBytes()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return uint64_t(counters.PeakWorkingSetSize);
+#else
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if SLANG_APPLE_FAMILY
+    // Darwin reports the peak in bytes, other platforms in kilobytes.
+    return uint64_t(usage.ru_maxrss);
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static SlangResult _createSession(
+    BenchmarkContext& context,
+    slang::PreprocessorMacroDesc const* macros,
+    SlangInt macroCount,
+    ComPtr<slang::ISession>& outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = context.options.target;
+    targetDesc.profile =
+        context.globalSession->findProfile(context.options.profileName.getBuffer());
+
+    // Phase timings are only recorded when asked for.
+    slang::CompilerOptionEntry option = {};
+    option.name = slang::CompilerOptionName::ReportPerfBenchmark;
+    option.value.kind = slang::CompilerOptionValueKind::Int;
+    option.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.preprocessorMacros = macros;
+    sessionDesc.preprocessorMacroCount = macroCount;
+    sessionDesc.compilerOptionEntries = &option;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    return context.globalSession->createSession(sessionDesc, outSession.writeRef());
+}
+
+static SlangResult _loadModule(
+    slang::ISession* session,
+    const char* moduleName,
+    const char* source,
+    ComPtr<slang::IModule>& outModule)
+{
+    ComPtr<ISlangBlob> diagnostics;
+    String path = String(moduleName) + ".slang";
+    outModule = session->loadModuleFromSourceString(
+        moduleName,
+        path.getBuffer(),
+        source,
+        diagnostics.writeRef());
+    if (!outModule)
+    {
+        _writeDiagnostics(diagnostics);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+/// Link `entryPointName` in `module` and generate its code for the session's target.
+static SlangResult _compileEntryPoint(
+    slang::ISession* session,
+    slang::IModule* module,
+    const char* entryPointName)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName(entryPointName, entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        composite.writeRef()));
+
+    ComPtr<ISlangBlob> diagnostics;
+    ComPtr<slang::IComponentType> linked;
+    if (SLANG_FAILED(composite->link(linked.writeRef(), diagnostics.writeRef())))
+    {
+        _writeDiagnostics(diagnostics);
+        return SLANG_FAIL;
+    }
+
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())))
+    {
+        _writeDiagnostics(diagnostics);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _compileModuleSource(
+    BenchmarkContext& context,
+    const char* moduleName,
+    const char* source)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(context, nullptr, 0, session));
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, moduleName, source, module));
+    return _compileEntryPoint(session, module, "computeMain");
+}
+
+//
+// core-module-startup
+//
+
+static SlangResult _runCoreModuleStartup(BenchmarkContext& context)
+{
+    SLANG_UNUSED(context);
+    ComPtr<slang::IGlobalSession> globalSession;
+    return slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef());
+}
+
+//
+// uber-shader
+//
+
+static const Index kUberShaderMaterialCount = 256;
+
+static String _generateUberShaderSource()
+{
+    StringBuilder sb;
+    sb << "interface IMaterial\n{\n    float3 eval(float3 n, float3 l, float3 v);\n}\n\n";
+
+    for (Index i = 0; i < kUberShaderMaterialCount; ++i)
+    {
+        sb << "struct Material" << i << " : IMaterial\n{\n";
+        sb << "    float3 albedo;\n    float roughness;\n\n";
+        sb << "    float3 eval(float3 n, float3 l, float3 v)\n    {\n";
+        sb << "        float3 h = normalize(l + v);\n";
+        sb << "        float specular = pow(saturate(dot(n, h)), float(" << (i + 1)
+           << ") / (roughness + 0.01));\n";
+        sb << "        return albedo * saturate(dot(n, l)) + specular * float(" << (i % 7)
+           << ");\n";
+        sb << "    }\n}\n\n";
+    }
+
+    sb << "StructuredBuffer<float4> materialData;\n";
+    sb << "RWStructuredBuffer<float4> outputBuffer;\n\n";
+
+    sb << "float3 shade(uint materialId, float3 n, float3 l, float3 v)\n{\n";
+    sb << "    switch (materialId)\n    {\n";
+    for (Index i = 0; i < kUberShaderMaterialCount; ++i)
+    {
+        sb << "    case " << i << ":\n    {\n";
+        sb << "        Material" << i << " m;\n";
+        sb << "        m.albedo = materialData[" << i << "].xyz;\n";
+        sb << "        m.roughness = materialData[" << i << "].w;\n";
+        sb << "        return m.eval(n, l, v);\n";
+        sb << "    }\n";
+    }
+    sb << "    default:\n        return float3(0);\n    }\n}\n\n";
+
+    sb << "[shader(\"compute\")]\n[numthreads(64, 1, 1)]\n";
+    sb << "void computeMain(uint3 tid : SV_DispatchThreadID)\n{\n";
+    sb << "    float3 n = normalize(float3(float(tid.x), 1, 0));\n";
+    sb << "    float3 l = normalize(float3(0, 1, 1));\n";
+    sb << "    float3 v = normalize(float3(1, 1, 0));\n";
+    sb << "    outputBuffer[tid.x] = float4(shade(tid.x % " << kUberShaderMaterialCount
+       << ", n, l, v), 1);\n";
+    sb << "}\n";
+    return sb.produceString();
+}
+
+static SlangResult _runUberShader(BenchmarkContext& context)
+{
+    static const String source = _generateUberShaderSource();
+    return _compileModuleSource(context, "uberShader", source.getBuffer());
+}
+
+//
+// permutation-sweep
+//
+
+static const char kPermutationSource[] = R"(
+struct Light
+{
+    float3 position;
+    float3 color;
+}
+
+StructuredBuffer<Light> lights;
+Texture2D shadowMap;
+SamplerState shadowSampler;
+RWStructuredBuffer<float4> outputBuffer;
+
+float3 shadeLight(Light light, float3 position, float3 normal)
+{
+    float3 l = light.position - position;
+    float attenuation = 1.0 / (1.0 + dot(l, l));
+    float3 color = light.color * saturate(dot(normal, normalize(l))) * attenuation;
+#if USE_SHADOWS
+    color *= shadowMap.SampleLevel(shadowSampler, position.xy, 0).r;
+#endif
+    return color;
+}
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void computeMain(uint3 tid : SV_DispatchThreadID)
+{
+    float3 position = float3(float(tid.x), 0, 0);
+    float3 normal = float3(0, 1, 0);
+    float3 color = float3(0);
+    [ForceUnroll]
+    for (int i = 0; i < LIGHT_COUNT; i++)
+        color += shadeLight(lights[i], position, normal);
+#if USE_FOG
+    color = lerp(color, float3(0.5), saturate(position.x * 0.01));
+#endif
+    outputBuffer[tid.x] = float4(color, 1);
+}
+)";
+
+static SlangResult _runPermutationSweep(BenchmarkContext& context)
+{
+    static const char* const kLightCounts[] = {"1", "2", "4", "8"};
+    static const char* const kFlags[] = {"0", "1"};
+
+    for (auto lightCount : kLightCounts)
+    {
+        for (auto useShadows : kFlags)
+        {
+            for (auto useFog : kFlags)
+            {
+                const slang::PreprocessorMacroDesc macros[] = {
+                    {"LIGHT_COUNT", lightCount},
+                    {"USE_SHADOWS", useShadows},
+                    {"USE_FOG", useFog},
+                };
+
+                ComPtr<slang::ISession> session;
+                SLANG_RETURN_ON_FAIL(
+                    _createSession(context, macros, SLANG_COUNT_OF(macros), session));
+                ComPtr<slang::IModule> module;
+                SLANG_RETURN_ON_FAIL(
+                    _loadModule(session, "permutation", kPermutationSource, module));
+                SLANG_RETURN_ON_FAIL(_compileEntryPoint(session, module, "computeMain"));
+            }
+        }
+    }
+    return SLANG_OK;
+}
+
+//
+// precompiled-module-link
+//
+
+static const Index kLibraryFunctionCount = 128;
+
+static String _generateLibrarySource()
+{
+    StringBuilder sb;
+    for (Index i = 0; i < kLibraryFunctionCount; ++i)
+    {
+        sb << "float4 libraryFunction" << i << "(float4 x)\n{\n";
+        sb << "    float4 y = x * float(" << (i + 1) << ") + sin(x);\n";
+        sb << "    return y / (1.0 + abs(y));\n";
+        sb << "}\n\n";
+    }
+    return sb.produceString();
+}
+
+static String _generateLibraryClientSource()
+{
+    StringBuilder sb;
+    sb << "import library;\n\n";
+    sb << "RWStructuredBuffer<float4> outputBuffer;\n\n";
+    sb << "[shader(\"compute\")]\n[numthreads(64, 1, 1)]\n";
+    sb << "void computeMain(uint3 tid : SV_DispatchThreadID)\n{\n";
+    sb << "    float4 value = outputBuffer[tid.x];\n";
+    for (Index i = 0; i < kLibraryFunctionCount; ++i)
+        sb << "    value = libraryFunction" << i << "(value);\n";
+    sb << "    outputBuffer[tid.x] = value;\n";
+    sb << "}\n";
+    return sb.produceString();
+}
+
+static SlangResult _preparePrecompiledModuleLink(BenchmarkContext& context)
+{
+    const String source = _generateLibrarySource();
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(context, nullptr, 0, session));
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, "library", source.getBuffer(), module));
+    return module->serialize(context.precompiledLibrary.writeRef());
+}
+
+static SlangResult _runPrecompiledModuleLink(BenchmarkContext& context)
+{
+    static const String clientSource = _generateLibraryClientSource();
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(_createSession(context, nullptr, 0, session));
+
+    ComPtr<ISlangBlob> diagnostics;
+    ComPtr<slang::IModule> library(session->loadModuleFromIRBlob(
+        "library",
+        "library.slang",
+        context.precompiledLibrary,
+        diagnostics.writeRef()));
+    if (!library)
+    {
+        _writeDiagnostics(diagnostics);
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IModule> module;
+    SLANG_RETURN_ON_FAIL(_loadModule(session, "client", clientSource.getBuffer(), module));
+    return _compileEntryPoint(session, module, "computeMain");
+}
+
+//
+// autodiff
+//
+
+static const char kAutodiffSource[] = R"(
+[Differentiable]
+float3 tonemap(float3 color, float exposure)
+{
+    float3 x = color * exposure;
+    return x / (1.0 + x);
+}
+
+[Differentiable]
+float3 grade(float3 color, float contrast)
+{
+    float3 centered = color - 0.5;
+    return centered * contrast + 0.5 + sin(centered * contrast) * 0.1;
+}
+
+[Differentiable]
+float loss(float3 color, float exposure, float contrast, no_diff float3 target)
+{
+    float3 d = grade(tonemap(color, exposure), contrast) - target;
+    return dot(d, d);
+}
+
+RWStructuredBuffer<float4> buffer;
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void computeMain(uint3 tid : SV_DispatchThreadID)
+{
+    float4 value = buffer[tid.x];
+    var color = diffPair(value.xyz);
+    var exposure = diffPair(value.w);
+    var contrast = diffPair(1.2);
+    bwd_diff(loss)(color, exposure, contrast, float3(0.5), 1.0);
+    buffer[tid.x] = float4(color.d, exposure.d + contrast.d);
+}
+)";
+
+static SlangResult _runAutodiff(BenchmarkContext& context)
+{
+    return _compileModuleSource(context, "autodiff", kAutodiffSource);
+}
+
+static const Workload kWorkloads[] = {
+    {"core-module-startup",
+     "Create a global session, which loads the core module",
+     nullptr,
+     _runCoreModuleStartup},
+    {"uber-shader",
+     "Compile a shader that dispatches over many material types",
+     nullptr,
+     _runUberShader},
+    {"permutation-sweep",
+     "Compile every permutation of a shader's preprocessor options",
+     nullptr,
+     _runPermutationSweep},
+    {"precompiled-module-link",
+     "Load a serialized library module and link a shader against it",
+     _preparePrecompiledModuleLink,
+     _runPrecompiledModuleLink},
+    {"autodiff",
+     "Compile a shader that takes the backward derivative of a function",
+     nullptr,
+     _runAutodiff},
+};
+
+/// Take the phase timings recorded since the last call, and add their self time to `ioPhases`.
+/// Self time is used so that nested phases are not counted twice.
+static SlangResult _accumulatePhaseTimes(BenchmarkContext& context, List<PhaseTime>& ioPhases)
+{
+    ComPtr<ISlangProfiler> profiler;
+    SLANG_RETURN_ON_FAIL(context.profileRequest->getCompileTimeProfile(profiler.writeRef(), true));
+
+    ComPtr<ISlangPhaseProfiler> phaseProfiler;
+    SLANG_RETURN_ON_FAIL(profiler->queryInterface(
+        ISlangPhaseProfiler::getTypeGuid(),
+        (void**)phaseProfiler.writeRef()));
+
+    const auto count = phaseProfiler->getPhaseInvocationCount();
+    for (uint32_t ii = 0; ii < count; ++ii)
+    {
+        SlangPhaseStatistics statistics = {};
+        SLANG_RETURN_ON_FAIL(phaseProfiler->getPhaseInvocation(ii, &statistics));
+
+        const UnownedStringSlice phaseName(statistics.phaseName);
+        Index phaseIndex =
+            ioPhases.findFirstIndex([&](const PhaseTime& p) { return p.phaseName == phaseName; });
+        if (phaseIndex < 0)
+        {
+            phaseIndex = ioPhases.getCount();
+            ioPhases.add(PhaseTime{phaseName, 0});
+        }
+        ioPhases[phaseIndex].selfMicroseconds += statistics.selfDurationMicroseconds;
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runWorkload(
+    BenchmarkContext& context,
+    const Workload& workload,
+    WorkloadResult& outResult)
+{
+    outResult.name = workload.name;
+
+    if (workload.prepare)
+        SLANG_RETURN_ON_FAIL(workload.prepare(context));
+
+    for (Index i = 0; i < context.options.warmupCount; ++i)
+        SLANG_RETURN_ON_FAIL(workload.run(context));
+
+    // Drop whatever the preparation and warm up recorded.
+    List<PhaseTime> ignoredPhases;
+    SLANG_RETURN_ON_FAIL(_accumulatePhaseTimes(context, ignoredPhases));
+
+    const double tickToMilliseconds = 1000.0 / double(Process::getClockFrequency());
+    for (Index i = 0; i < context.options.sampleCount; ++i)
+    {
+        const auto startTick = Process::getClockTick();
+        SLANG_RETURN_ON_FAIL(workload.run(context));
+        const auto endTick = Process::getClockTick();
+        outResult.sampleMilliseconds.add(double(endTick - startTick) * tickToMilliseconds);
+
+        SLANG_RETURN_ON_FAIL(_accumulatePhaseTimes(context, outResult.phases));
+    }
+
+    outResult.peakResidentBytes = _getPeakResidentBytes();
+    return SLANG_OK;
+}
+
+/// The nearest rank percentile of sorted `samples`.
+static double _getPercentile(const List<double>& samples, double percentile)
+{
+    Index rank = Index(percentile / 100.0 * double(samples.getCount()) + 0.999999);
+    rank = Math::Clamp(rank, Index(1), samples.getCount());
+    return samples[rank - 1];
+}
+
+static void _appendNumber(StringBuilder& sb, double value)
+{
+    sb << String(value, "%.3f");
+}
+
+static void _appendResultJSON(StringBuilder& sb, WorkloadResult& result)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    auto& samples = result.sampleMilliseconds;
+    samples.sort();
+    double total = 0;
+    for (auto sample : samples)
+        total += sample;
+    const double sampleCount = double(samples.getCount());
+
+    sb << "        {\n";
+    sb << "            \"name\": ";
+    StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(result.name), sb);
+    sb << ",\n";
+    sb << "            \"unit\": \"milliseconds\",\n";
+    sb << "            \"samples\": " << samples.getCount() << ",\n";
+    sb << "            \"min\": ";
+    _appendNumber(sb, samples[0]);
+    sb << ",\n            \"mean\": ";
+    _appendNumber(sb, total / sampleCount);
+    sb << ",\n            \"p50\": ";
+    _appendNumber(sb, _getPercentile(samples, 50));
+    sb << ",\n            \"p90\": ";
+    _appendNumber(sb, _getPercentile(samples, 90));
+    sb << ",\n            \"p99\": ";
+    _appendNumber(sb, _getPercentile(samples, 99));
+    sb << ",\n            \"max\": ";
+    _appendNumber(sb, samples.getLast());
+    sb << ",\n            \"phases\": {";
+    for (Index i = 0; i < result.phases.getCount(); ++i)
+    {
+        auto& phase = result.phases[i];
+        sb << (i == 0 ? "\n" : ",\n") << "                ";
+        StringEscapeUtil::appendQuoted(handler, phase.phaseName.getUnownedSlice(), sb);
+        sb << ": ";
+        _appendNumber(sb, double(phase.selfMicroseconds) / 1000.0 / sampleCount);
+    }
+    sb << (result.phases.getCount() ? "\n            },\n" : "},\n");
+    sb << "            \"peakResidentBytes\": " << result.peakResidentBytes << "\n";
+    sb << "        }";
+}
+
+static void _printUsage()
+{
+    StringBuilder sb;
+    sb << "Usage: slang-benchmark [-samples <count>] [-warmup <count>] [-target <name>]\n";
+    sb << "                       [-profile <name>] [-workload <name>]... [-o <path>]\n\n";
+    sb << "Workloads:\n";
+    for (auto& workload : kWorkloads)
+        sb << "  " << workload.name << ": " << workload.description << "\n";
+    StdWriters::getError().put(sb.getUnownedSlice());
+}
+
+static SlangResult _parseOptions(int argc, char** argv, BenchmarkOptions& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == toSlice("-samples") && hasValue)
+        {
+            outOptions.sampleCount = Index(atoi(argv[++i]));
+            if (outOptions.sampleCount <= 0)
+                return SLANG_E_INVALID_ARG;
+        }
+        else if (arg == toSlice("-warmup") && hasValue)
+        {
+            outOptions.warmupCount = Index(atoi(argv[++i]));
+            if (outOptions.warmupCount < 0)
+                return SLANG_E_INVALID_ARG;
+        }
+        else if (arg == toSlice("-target") && hasValue)
+        {
+            outOptions.targetName = argv[++i];
+            outOptions.target =
+                TypeTextUtil::findCompileTargetFromName(outOptions.targetName.getUnownedSlice());
+            if (outOptions.target == SLANG_TARGET_UNKNOWN)
+                return SLANG_E_INVALID_ARG;
+        }
+        else if (arg == toSlice("-profile") && hasValue)
+        {
+            outOptions.profileName = argv[++i];
+        }
+        else if (arg == toSlice("-workload") && hasValue)
+        {
+            const UnownedStringSlice name(argv[++i]);
+            bool found = false;
+            for (auto& workload : kWorkloads)
+                found = found || name == UnownedStringSlice(workload.name);
+            if (!found)
+                return SLANG_E_INVALID_ARG;
+            outOptions.workloadNames.add(name);
+        }
+        else if (arg == toSlice("-o") && hasValue)
+        {
+            outOptions.outputPath = argv[++i];
+        }
+        else
+        {
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    auto stdWriters = StdWriters::initDefaultSingleton();
+
+    BenchmarkContext context;
+    if (SLANG_FAILED(_parseOptions(argc, argv, context.options)))
+    {
+        _printUsage();
+        return SLANG_E_INVALID_ARG;
+    }
+
+    SLANG_RETURN_ON_FAIL(
+        slang_createGlobalSession(SLANG_API_VERSION, context.globalSession.writeRef()));
+    SLANG_ALLOW_DEPRECATED_BEGIN
+    SLANG_RETURN_ON_FAIL(
+        context.globalSession->createCompileRequest(context.profileRequest.writeRef()));
+    SLANG_ALLOW_DEPRECATED_END
+
+    List<WorkloadResult> results;
+    for (auto& workload : kWorkloads)
+    {
+        auto& names = context.options.workloadNames;
+        if (names.getCount() && names.indexOf(String(workload.name)) < 0)
+            continue;
+
+        WorkloadResult result;
+        if (SLANG_FAILED(_runWorkload(context, workload, result)))
+        {
+            StdWriters::getError().print("error: workload '%s' failed\n", workload.name);
+            return SLANG_FAIL;
+        }
+        results.add(result);
+    }
+
+    StringBuilder sb;
+    sb << "{\n";
+    sb << "    \"target\": ";
+    StringEscapeUtil::appendQuoted(
+        StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON),
+        context.options.targetName.getUnownedSlice(),
+        sb);
+    sb << ",\n";
+    sb << "    \"benchmarks\": [";
+    for (Index i = 0; i < results.getCount(); ++i)
+    {
+        sb << (i == 0 ? "\n" : ",\n");
+        _appendResultJSON(sb, results[i]);
+    }
+    sb << "\n    ],\n";
+    sb << "    \"peakResidentBytes\": " << _getPeakResidentBytes() << "\n";
+    sb << "}\n";
+
+    if (context.options.outputPath.getLength() == 0)
+    {
+        StdWriters::getOut().put(sb.getUnownedSlice());
+        return SLANG_OK;
+    }
+    return File::writeAllText(context.options.outputPath, sb);
+}
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = innerMain(argc, argv);
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
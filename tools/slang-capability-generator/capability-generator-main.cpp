@@ -178,6 +178,7 @@ public:
         this->rank = other.rank;
         this->canonicalRepresentation = other.canonicalRepresentation;
         this->serializedCanonicalRepresentation = other.serializedCanonicalRepresentation;
+        this->serializedImpliedAtoms = other.serializedImpliedAtoms;
         this->sourceLoc = other.sourceLoc;
         this->keyAtomsPresent = other.keyAtomsPresent;
         this->sharedContext = other.sharedContext;
@@ -192,6 +193,8 @@ public:
     int rank = 0;
     List<List<CapabilityDef*>> canonicalRepresentation;
     SerializedArrayView serializedCanonicalRepresentation;
+    /// Index of the serialized set of atoms this def is derived from, including itself.
+    Index serializedImpliedAtoms = 0;
     SourceLoc sourceLoc;
     AutoDocInfo docComment;
     /// Stores key atoms a CapabilityDef refers to.
@@ -1222,11 +1225,8 @@ SlangResult generateDefinitions(
     List<SerializedConjunction> serializedCapabilitesCache;
 
     List<Index> serializedAtomDisjunctions;
-    auto serializeConjunction = [&](const List<CapabilityDef*>& capabilities,
-                                    CapabilityDef* parentDef,
-                                    Index conjunctionNumber) -> Index
+    auto serializeAtomSet = [&](UIntSet& capabilitiesAsUIntSet, const String& initName) -> Index
     {
-        auto capabilitiesAsUIntSet = atomSetToUIntSet(capabilities);
         // Do we already have a serialized capability array that is the same the one we are trying
         // to serialize?
         for (Index i = 0; i < serializedCapabilitesCache.getCount(); i++)
@@ -1237,8 +1237,6 @@ SlangResult generateDefinitions(
                 return i;
             }
         }
-        auto initName =
-            "generatorOf_" + parentDef->name + "_conjunction" + String(conjunctionNumber);
         outputUIntSetGenerator(initName, sbCpp, capabilitiesAsUIntSet);
 
         auto result = serializedCapabilitesCache.getCount();
@@ -1246,6 +1244,15 @@ SlangResult generateDefinitions(
             SerializedConjunction(initName + "()", capabilitiesAsUIntSet));
         return result;
     };
+    auto serializeConjunction = [&](const List<CapabilityDef*>& capabilities,
+                                    CapabilityDef* parentDef,
+                                    Index conjunctionNumber) -> Index
+    {
+        auto capabilitiesAsUIntSet = atomSetToUIntSet(capabilities);
+        return serializeAtomSet(
+            capabilitiesAsUIntSet,
+            "generatorOf_" + parentDef->name + "_conjunction" + String(conjunctionNumber));
+    };
     auto serializeDisjunction = [&](const List<Index>& conjunctions) -> SerializedArrayView
     {
         SerializedArrayView result;
@@ -1263,6 +1270,15 @@ SlangResult generateDefinitions(
         for (auto& c : def->canonicalRepresentation)
             conjunctions.add(serializeConjunction(c, def, conjunctions.getCount()));
         def->serializedCanonicalRepresentation = serializeDisjunction(conjunctions);
+
+        // The canonical conjunctions are already fully expanded, so their union is the
+        // transitive closure of every atom that `def` is derived from.
+        UIntSet impliedAtoms{};
+        impliedAtoms.add(def->enumValue);
+        for (auto& c : def->canonicalRepresentation)
+            impliedAtoms.unionWith(atomSetToUIntSet(c));
+        def->serializedImpliedAtoms =
+            serializeAtomSet(impliedAtoms, "generatorOf_" + def->name + "_impliedAtoms");
     }
 
     sbCpp << "static CapabilityAtomSet kCapabilityArray[] = {\n";
@@ -1286,7 +1302,7 @@ SlangResult generateDefinitions(
         if (!def)
         {
             sbCpp
-                << R"(    { UnownedStringSlice::fromLiteral("Invalid"), CapabilityNameFlavor::Concrete, CapabilityName::Invalid, 0, {nullptr, 0} },)"
+                << R"(    { UnownedStringSlice::fromLiteral("Invalid"), CapabilityNameFlavor::Concrete, CapabilityName::Invalid, 0, {nullptr, 0}, nullptr },)"
                 << "\n";
             continue;
         }
@@ -1327,7 +1343,10 @@ SlangResult generateDefinitions(
 
         // canonnical representation.
         sbCpp << "{ kCapabilityConjunctions + " << def->serializedCanonicalRepresentation.first
-              << ", " << def->serializedCanonicalRepresentation.count << "} },\n";
+              << ", " << def->serializedCanonicalRepresentation.count << "}, ";
+
+        // implied atoms.
+        sbCpp << "kCapabilityArray + " << def->serializedImpliedAtoms << " },\n";
     }
 
     sbCpp << "};\n";
@@ -1,4 +1,5 @@
 #include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
 #include "../../source/slang-record-replay/replay-context.h"
 #include "../../source/slang-record-replay/replay-stream-decoder.h"
 
@@ -10,7 +11,9 @@ struct Options
     bool decode{false};
     bool rawDecode{false};
     bool replay{false};
+    bool benchmark{false};
     bool verbose{false};
+    int iterationCount{10};
     Slang::String recordFileName;
     Slang::String outputFileName;
 };
@@ -24,9 +27,13 @@ void printUsage()
         "                If given a folder with index.bin, uses structured call-by-call output.\n");
     printf("  --raw, -R: Force raw value-by-value output (ignore index.bin even if present).\n");
     printf("  --replay, -r: Replay the recorded API calls.\n");
+    printf("  --benchmark, -b: Replay the recorded API calls repeatedly, and report the time\n");
+    printf("                   taken by each kind of call.\n");
+    printf("  --iterations, -n <count>: Number of timed replays for --benchmark (default 10).\n");
     printf("  --verbose, -v: Enable verbose output during replay.\n");
     printf(
-        "  --output, -o <file>: Write decoded output to the specified file instead of stdout.\n");
+        "  --output, -o <file>: Write decoded output or the benchmark report to the specified\n");
+    printf("                       file instead of stdout.\n");
 }
 
 Options parseOption(int argc, char* argv[])
@@ -65,6 +72,23 @@ Options parseOption(int argc, char* argv[])
             option.replay = true;
             argIndex++;
         }
+        else if ((strcmp("--benchmark", arg) == 0) || (strcmp("-b", arg) == 0))
+        {
+            option.benchmark = true;
+            argIndex++;
+        }
+        else if ((strcmp("--iterations", arg) == 0) || (strcmp("-n", arg) == 0))
+        {
+            argIndex++;
+            if (argIndex >= argc || atoi(argv[argIndex]) <= 0)
+            {
+                printf("Error: --iterations requires a positive count\n");
+                printUsage();
+                exit(1);
+            }
+            option.iterationCount = atoi(argv[argIndex]);
+            argIndex++;
+        }
         else if ((strcmp("--verbose", arg) == 0) || (strcmp("-v", arg) == 0))
         {
             option.verbose = true;
@@ -105,6 +129,150 @@ Options parseOption(int argc, char* argv[])
     return option;
 }
 
+// Get the folder holding stream.bin, given either the folder or the stream.bin file.
+static SlangResult findReplayFolder(const Slang::String& path, Slang::String& outFolder)
+{
+    Slang::String streamPath = path;
+    if (!streamPath.endsWith(".bin"))
+    {
+        streamPath = Slang::Path::combine(streamPath, "stream.bin");
+    }
+
+    if (!Slang::File::exists(streamPath))
+    {
+        fprintf(stderr, "Error: stream.bin not found at: %s\n", streamPath.getBuffer());
+        return SLANG_E_NOT_FOUND;
+    }
+
+    outFolder = Slang::Path::getParentDirectory(streamPath);
+    return SLANG_OK;
+}
+
+// The times taken by every call with the same signature.
+struct CallTimes
+{
+    Slang::String signature;
+    Slang::List<double> times;
+    double total = 0;
+};
+
+// Get the value at `percentile` of the sorted `times`, using the nearest rank.
+static double getPercentile(const Slang::List<double>& sortedTimes, double percentile)
+{
+    const Slang::Index count = sortedTimes.getCount();
+    Slang::Index rank = Slang::Index(percentile / 100.0 * double(count) + 0.999999);
+    rank = rank < 1 ? 1 : (rank > count ? count : rank);
+    return sortedTimes[rank - 1];
+}
+
+static void appendTimesRow(
+    Slang::StringBuilder& out,
+    const char* name,
+    Slang::List<double>& times,
+    double total)
+{
+    times.sort();
+    char buffer[512];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%-48s %8d %12.3f %10.4f %10.4f %10.4f %10.4f %10.4f\n",
+        name,
+        int(times.getCount()),
+        total,
+        total / double(times.getCount()),
+        getPercentile(times, 50),
+        getPercentile(times, 90),
+        getPercentile(times, 99),
+        times.getLast());
+    out << buffer;
+}
+
+// Replay the recording `iterationCount` times, after one untimed replay to warm up, and report
+// the latency of each kind of API call.
+static SlangResult runBenchmark(const Options& options, Slang::String& outReport)
+{
+    Slang::String folder;
+    SLANG_RETURN_ON_FAIL(findReplayFolder(options.recordFileName, folder));
+
+    auto& ctx = SlangRecord::ReplayContext::get();
+    const double tickToMs = 1000.0 / double(Slang::Process::getClockFrequency());
+
+    Slang::Dictionary<Slang::String, Slang::Index> callIndices;
+    Slang::List<CallTimes> calls;
+    Slang::List<double> replayTimes;
+    double replayTotal = 0;
+
+    for (int iteration = 0; iteration <= options.iterationCount; ++iteration)
+    {
+        // Each replay starts from a freshly loaded recording, so it creates all its objects
+        // again.
+        ctx.reset();
+        SLANG_RETURN_ON_FAIL(ctx.loadReplay(folder.getBuffer()));
+
+        const bool isWarmup = iteration == 0;
+        const uint64_t replayStartTicks = Slang::Process::getClockTick();
+        for (;;)
+        {
+            const uint64_t startTicks = Slang::Process::getClockTick();
+            if (!ctx.executeNextCall())
+                break;
+            const double time = double(Slang::Process::getClockTick() - startTicks) * tickToMs;
+            if (isWarmup)
+                continue;
+
+            const char* signature = ctx.getLastCallSignature();
+            const Slang::String key(signature ? signature : "<unknown>");
+            Slang::Index callIndex = 0;
+            if (!callIndices.tryGetValue(key, callIndex))
+            {
+                callIndex = calls.getCount();
+                callIndices.add(key, callIndex);
+                CallTimes callTimes;
+                callTimes.signature = key;
+                calls.add(callTimes);
+            }
+            calls[callIndex].times.add(time);
+            calls[callIndex].total += time;
+        }
+        const double replayTime =
+            double(Slang::Process::getClockTick() - replayStartTicks) * tickToMs;
+        if (!isWarmup)
+        {
+            replayTimes.add(replayTime);
+            replayTotal += replayTime;
+        }
+    }
+    ctx.reset();
+
+    // The calls that take the most time in total are the most interesting, so they go first.
+    calls.sort([](const CallTimes& a, const CallTimes& b) { return a.total > b.total; });
+
+    Slang::StringBuilder out;
+    out << "benchmark: " << folder << " iterations=" << options.iterationCount << "\n";
+    char header[512];
+    snprintf(
+        header,
+        sizeof(header),
+        "%-48s %8s %12s %10s %10s %10s %10s %10s\n",
+        "call",
+        "count",
+        "total ms",
+        "mean ms",
+        "p50 ms",
+        "p90 ms",
+        "p99 ms",
+        "max ms");
+    out << header;
+    appendTimesRow(out, "<replay>", replayTimes, replayTotal);
+    for (auto& call : calls)
+    {
+        appendTimesRow(out, call.signature.getBuffer(), call.times, call.total);
+    }
+    outReport = out.produceString();
+    return SLANG_OK;
+}
+
 int main(int argc, char* argv[])
 {
     Options options = parseOption(argc, argv);
@@ -167,6 +335,44 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (options.benchmark)
+    {
+        try
+        {
+            Slang::String report;
+            if (SLANG_FAILED(runBenchmark(options, report)))
+            {
+                fprintf(stderr, "Error loading replay file\n");
+                return 1;
+            }
+
+            if (options.outputFileName.getLength() > 0)
+            {
+                SlangResult res = Slang::File::writeAllText(
+                    options.outputFileName.getBuffer(),
+                    report.getUnownedSlice());
+                if (SLANG_FAILED(res))
+                {
+                    fprintf(
+                        stderr,
+                        "Error writing to file: %s\n",
+                        options.outputFileName.getBuffer());
+                    return 1;
+                }
+            }
+            else
+            {
+                printf("%s", report.getBuffer());
+            }
+            return 0;
+        }
+        catch (const Slang::Exception& e)
+        {
+            fprintf(stderr, "Error during replay: %s\n", e.Message.getBuffer());
+            return 1;
+        }
+    }
+
     if (options.replay)
     {
         // Replay the recorded API calls
@@ -98,6 +98,12 @@ static bool _isSubCommand(const char* arg)
         "                                 (alphabetical for prefixes matching multiple tests)\n"
         "  -dry-run                       List tests that would be run without running them\n"
         "  -disable-retries               Disable automatic retries of failed tests\n"
+        "  -test-durations <file>         Start the slowest tests first, using durations\n"
+        "                                 from earlier runs stored in <file>, and update\n"
+        "                                 <file> with the durations from this run\n"
+        "  -show-slowest-tests <n>        List the <n> slowest test files and their times\n"
+        "  -compile-cache <dir>           Share the results of identical compiles between\n"
+        "                                 tests and between runs, storing them in <dir>\n"
         "  -synthesize-compile-targets    Synthesize compile-only tests for all available\n"
         "                                 backends from GPU-requiring tests, exercising\n"
         "                                 emit paths without needing a GPU\n"
@@ -295,6 +301,40 @@ static bool _isSubCommand(const char* arg)
         {
             optionsOut->disableRetries = true;
         }
+        else if (strcmp(arg, "-test-durations") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                showHelp(stdError);
+                return SLANG_FAIL;
+            }
+            optionsOut->testDurationsPath = *argCursor++;
+        }
+        else if (strcmp(arg, "-compile-cache") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                showHelp(stdError);
+                return SLANG_FAIL;
+            }
+            optionsOut->compileCachePath = *argCursor++;
+        }
+        else if (strcmp(arg, "-show-slowest-tests") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                showHelp(stdError);
+                return SLANG_FAIL;
+            }
+            optionsOut->showSlowestTestCount = stringToInt(*argCursor++);
+            if (optionsOut->showSlowestTestCount < 0)
+            {
+                optionsOut->showSlowestTestCount = 0;
+            }
+        }
         else if (strcmp(arg, "-synthesize-compile-targets") == 0)
         {
             optionsOut->synthesizeCompileTargets = true;
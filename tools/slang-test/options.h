@@ -179,6 +179,16 @@ struct Options
     /// Whether to disable automatic retries of failed tests
     bool disableRetries = false;
 
+    /// File holding the duration of each test file from earlier runs. When set, the slowest
+    /// tests are started first, and the file is updated with the durations from this run.
+    Slang::String testDurationsPath;
+
+    /// The number of slowest test files to list at the end of the run
+    int showSlowestTestCount = 0;
+
+    /// Directory holding the results of compiles, shared between tests and between runs
+    Slang::String compileCachePath;
+
     /// Only run API detection and print results, then exit
     bool apiDetectionOnly = false;
 
@@ -31,6 +31,7 @@
 #include "parse-diagnostic-util.h"
 #include "slangc-tool.h"
 #include "slangi-tool.h"
+#include "test-compile-cache.h"
 #include "test-context.h"
 #include "test-reporter.h"
 
@@ -47,6 +48,7 @@
 #include "../../prelude/slang-cpp-types.h"
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #if SLANG_UNIX_FAMILY
@@ -2672,14 +2674,6 @@ TestResult runSimpleTest(TestContext* context, TestInput& input)
         return TestResult::Ignored;
     }
 
-    ExecuteResult exeRes;
-    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
-
-    if (context->isCollectingRequirements())
-    {
-        return TestResult::Pass;
-    }
-
     // See what kind of target it is
     SlangCompileTarget target = SLANG_TARGET_UNKNOWN;
     {
@@ -2692,6 +2686,35 @@ TestResult runSimpleTest(TestContext* context, TestInput& input)
         }
     }
 
+    // Tests often compile the same sources with the same options, and only differ in how they
+    // check the output, so share the compile through the cache if there is one. Executables
+    // are written to disk, so those compiles are not cached.
+    TestCompileCache* compileCache = context->compileCache;
+    TestCompileCache::Key compileKey;
+    const bool isCacheable = compileCache && context->isExecuting() &&
+                             target != SLANG_HOST_EXECUTABLE &&
+                             SLANG_SUCCEEDED(compileCache->calcKey(cmdLine, compileKey));
+
+    ExecuteResult exeRes;
+    if (!isCacheable || SLANG_FAILED(compileCache->readResult(compileKey, exeRes)))
+    {
+        TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
+
+        // Only the results of compiles that ran to completion are kept, so a crash or a
+        // timeout is always retried.
+        const auto returnCode = TestToolUtil::getReturnCodeFromInt(exeRes.resultCode);
+        if (isCacheable && (returnCode == ToolReturnCode::Success ||
+                            returnCode == ToolReturnCode::CompilationFailed))
+        {
+            compileCache->writeResult(compileKey, exeRes);
+        }
+    }
+
+    if (context->isCollectingRequirements())
+    {
+        return TestResult::Pass;
+    }
+
     // If it's executable we run it and use it's output
     if (target == SLANG_HOST_EXECUTABLE)
     {
@@ -5383,8 +5406,63 @@ void runTestsInParallel(TestContext* context, int count, const F& f)
     context->setTestReporter(originalReporter);
 }
 
+/// Read the test durations written by `_writeTestDurations`. Each line holds a duration in
+/// milliseconds and the path of a test file, separated by a tab.
+static void _readTestDurations(const String& path, Dictionary<String, double>& outDurations)
+{
+    String text;
+    if (SLANG_FAILED(File::readAllText(path, text)))
+        return;
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    for (auto line : lines)
+    {
+        const Index tabIndex = line.indexOf('\t');
+        double duration = 0;
+        if (tabIndex < 0 ||
+            SLANG_FAILED(StringUtil::parseDouble(line.head(tabIndex).trim(), duration)))
+            continue;
+        outDurations[line.tail(tabIndex + 1).trim()] = duration;
+    }
+}
+
+static void _writeTestDurations(const String& path, const Dictionary<String, double>& durations)
+{
+    List<String> files;
+    for (const auto& [file, duration] : durations)
+        files.add(file);
+    files.sort();
+
+    StringBuilder sb;
+    for (const auto& file : files)
+        sb << String(durations.getValue(file), "%.1f") << "\t" << file << "\n";
+
+    if (SLANG_FAILED(File::writeAllText(path, sb)))
+        fprintf(stderr, "warning: unable to write test durations to '%s'\n", path.getBuffer());
+}
+
+static void _showSlowestTests(const Dictionary<String, double>& durations, int count)
+{
+    List<KeyValuePair<String, double>> slowest;
+    for (const auto& [file, duration] : durations)
+        slowest.add(KeyValuePair<String, double>(file, duration));
+    slowest.sort([](const KeyValuePair<String, double>& a, const KeyValuePair<String, double>& b)
+                 { return a.value > b.value; });
+
+    printf("Slowest test files:\n");
+    for (Index i = 0; i < Math::Min(Index(count), slowest.getCount()); ++i)
+        printf("%10.1f ms  %s\n", slowest[i].value, slowest[i].key.getBuffer());
+}
+
 void runTestsInDirectory(TestContext* context)
 {
+    if (context->options.compileCachePath.getLength() && !context->compileCache)
+    {
+        Path::createDirectoryRecursive(context->options.compileCachePath);
+        context->compileCache = new TestCompileCache(context->options.compileCachePath);
+    }
+
     List<String> files;
     getFilesInDirectory(context->options.testDir, files);
 
@@ -5447,11 +5525,46 @@ void runTestsInDirectory(TestContext* context)
             { return getPrefixIndex(a) < getPrefixIndex(b); });
     }
 
+    // Start the slowest tests first, so that the servers are not left waiting on a few slow
+    // tests at the end of the run. Tests without a recorded duration may be new, and are
+    // started before all the others since nothing is known about them.
+    Dictionary<String, double> previousDurations;
+    const auto& durationsPath = context->options.testDurationsPath;
+    if (durationsPath.getLength())
+    {
+        _readTestDurations(durationsPath, previousDurations);
+        if (!context->options.shuffleTests && !context->options.explicitTestOrder)
+        {
+            auto getDuration = [&](const String& file)
+            {
+                double duration = 0;
+                return previousDurations.tryGetValue(file, duration) ? duration : -1.0;
+            };
+            auto isStartedBefore = [&](const String& a, const String& b)
+            {
+                const double durationA = getDuration(a);
+                const double durationB = getDuration(b);
+                if ((durationA < 0) != (durationB < 0))
+                    return durationA < 0;
+                return durationA > durationB;
+            };
+            std::stable_sort(files.begin(), files.end(), isStartedBefore);
+        }
+    }
+
     auto processFile = [&](String file)
     {
         if (shouldRunTest(context, file))
         {
+            const auto startTime = std::chrono::steady_clock::now();
             SlangResult result = _runTestsOnFile(context, file);
+            const std::chrono::duration<double, std::milli> duration =
+                std::chrono::steady_clock::now() - startTime;
+            {
+                std::lock_guard<std::mutex> lock(context->mutexTestDurations);
+                context->testDurations[file] = duration.count();
+            }
+
             if (SLANG_FAILED(result))
             {
                 {
@@ -5495,6 +5608,26 @@ void runTestsInDirectory(TestContext* context)
             (int)files.getCount(),
             [&](int index) { processFile(files[index]); });
     }
+
+    if (context->options.showSlowestTestCount > 0)
+        _showSlowestTests(context->testDurations, context->options.showSlowestTestCount);
+
+    if (context->compileCache)
+    {
+        const auto& stats = context->compileCache->getStats();
+        printf(
+            "Compile cache: %d hits, %d misses\n",
+            int(stats.hitCount),
+            int(stats.missCount));
+    }
+
+    if (durationsPath.getLength() && !context->options.dryRun)
+    {
+        // Keep the durations of tests that did not run this time, such as those filtered out.
+        for (const auto& [file, duration] : context->testDurations)
+            previousDurations[file] = duration;
+        _writeTestDurations(durationsPath, previousDurations);
+    }
 }
 
 static void _disableCPPBackends(TestContext* context)
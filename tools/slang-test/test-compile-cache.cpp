@@ -0,0 +1,359 @@
+// test-compile-cache.cpp
+
+#include "test-compile-cache.h"
+
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-shared-library.h"
+#include "../../source/core/slang-string-util.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+// Options that make the compiler write files, or produce output that differs between
+// otherwise identical compiles. Compiles using them are never cached.
+static const char* const kUncachableOptions[] = {
+    "-o",
+    "-depfile",
+    "-dump-intermediates",
+    "-dump-ir",
+    "-dump-repro",
+    "-trace-events",
+    "-report-perf-benchmark",
+};
+
+TestCompileCache::TestCompileCache(const String& directory)
+{
+    PersistentCache::Desc desc;
+    desc.directory = directory.getBuffer();
+    // Bound the size of the cache so a long lived cache directory on CI doesn't keep growing.
+    desc.maxEntryCount = 16384;
+    m_cache = new PersistentCache(desc);
+
+    // The compiler is identified by the contents of the slang shared library, and by the
+    // modification time and size of the other binaries beside it, which include the downstream
+    // compilers.
+    DigestBuilder<SHA1> builder;
+
+    const String libraryPath =
+        SharedLibraryUtils::getSharedLibraryFileName((void*)&slang_createGlobalSession);
+    ComPtr<ISlangBlob> libraryBlob;
+    if (libraryPath.getLength() && SLANG_SUCCEEDED(File::mapAllBytes(libraryPath, libraryBlob)))
+    {
+        builder.append(libraryBlob);
+    }
+
+    if (libraryPath.getLength())
+    {
+        CombinePathVisitor visitor(Path::getParentDirectory(libraryPath), Path::TypeFlag::File);
+        Path::find(Path::getParentDirectory(libraryPath), nullptr, &visitor);
+        visitor.m_paths.sort();
+        for (const auto& path : visitor.m_paths)
+        {
+            uint64_t modifiedTime = 0;
+            uint64_t size = 0;
+            if (SLANG_SUCCEEDED(File::getModifiedTimeAndSize(path, modifiedTime, size)))
+            {
+                builder.append(Path::getFileName(path));
+                builder.append(modifiedTime);
+                builder.append(size);
+            }
+        }
+    }
+
+    m_compilerDigest = builder.finalize();
+}
+
+// Find `name` in the directory of the including file, then in the search directories.
+static SlangResult _findFile(
+    const UnownedStringSlice& name,
+    const String& includerDirectory,
+    const List<String>& searchDirectories,
+    String& outPath)
+{
+    const String nameString(name);
+    if (includerDirectory.getLength())
+    {
+        const String path = Path::combine(includerDirectory, nameString);
+        if (File::exists(path))
+        {
+            outPath = path;
+            return SLANG_OK;
+        }
+    }
+    for (const auto& directory : searchDirectories)
+    {
+        const String path = Path::combine(directory, nameString);
+        if (File::exists(path))
+        {
+            outPath = path;
+            return SLANG_OK;
+        }
+    }
+    return SLANG_E_NOT_FOUND;
+}
+
+// Get the text following `keyword` at the start of `line`, or an empty slice if `line` doesn't
+// start with it.
+static UnownedStringSlice _getDirectiveOperand(
+    const UnownedStringSlice& line,
+    const char* keyword)
+{
+    const UnownedStringSlice keywordSlice(keyword);
+    if (!line.startsWith(keywordSlice) || line.getLength() == keywordSlice.getLength())
+    {
+        return UnownedStringSlice();
+    }
+    const char next = line[keywordSlice.getLength()];
+    if (next != ' ' && next != '\t' && next != '"' && next != '<')
+    {
+        return UnownedStringSlice();
+    }
+    return line.tail(keywordSlice.getLength()).trim();
+}
+
+// Get the text between the quotes or angle brackets that start `operand`.
+static UnownedStringSlice _getQuoted(const UnownedStringSlice& operand)
+{
+    if (operand.getLength() < 2)
+    {
+        return UnownedStringSlice();
+    }
+    const char close = operand[0] == '"' ? '"' : (operand[0] == '<' ? '>' : 0);
+    if (close == 0)
+    {
+        return UnownedStringSlice();
+    }
+    const Index end = operand.tail(1).indexOf(close);
+    return end < 0 ? UnownedStringSlice() : operand.subString(1, end);
+}
+
+SlangResult TestCompileCache::_appendSourceFile(
+    const String& path,
+    const List<String>& searchDirectories,
+    HashSet<String>& ioVisited,
+    DigestBuilder<SHA1>& builder)
+{
+    const String canonicalPath = Path::simplify(path);
+    if (!ioVisited.add(canonicalPath))
+    {
+        return SLANG_OK;
+    }
+
+    String contents;
+    SLANG_RETURN_ON_FAIL(File::readAllText(canonicalPath, contents));
+
+    builder.append(canonicalPath);
+    builder.append(contents.getLength());
+    builder.append(contents);
+
+    const String directory = Path::getParentDirectory(canonicalPath);
+
+    // Follow the files this one includes or imports. This is a line based scan rather than a
+    // preprocess, so it can find dependencies that the compile doesn't use, which only costs
+    // some hashing.
+    for (auto line : LineParser(contents.getUnownedSlice()))
+    {
+        line = line.trim();
+
+        UnownedStringSlice operand = _getDirectiveOperand(line, "#include");
+        if (operand.getLength())
+        {
+            const UnownedStringSlice name = _getQuoted(operand);
+            String dependencyPath;
+            // If an include can't be found we can't know what the compile reads.
+            if (name.getLength() == 0 ||
+                SLANG_FAILED(_findFile(name, directory, searchDirectories, dependencyPath)))
+            {
+                return SLANG_E_NOT_AVAILABLE;
+            }
+            SLANG_RETURN_ON_FAIL(
+                _appendSourceFile(dependencyPath, searchDirectories, ioVisited, builder));
+            continue;
+        }
+
+        // `import` names a module that is either a file, or one of the modules built into the
+        // compiler, so a module that can't be found is assumed to be built in.
+        // `__include` and `implementing` always name files.
+        bool mustExist = true;
+        operand = _getDirectiveOperand(line, "__include");
+        if (operand.getLength() == 0)
+        {
+            operand = _getDirectiveOperand(line, "implementing");
+        }
+        if (operand.getLength() == 0)
+        {
+            operand = _getDirectiveOperand(line, "import");
+            mustExist = false;
+        }
+        if (operand.getLength() == 0)
+        {
+            continue;
+        }
+
+        List<String> candidateNames;
+        const UnownedStringSlice quoted = _getQuoted(operand);
+        if (quoted.getLength())
+        {
+            candidateNames.add(String(quoted));
+        }
+        else
+        {
+            // A module name such as `a_b.c` can be found as `a_b/c.slang` or `a-b/c.slang`.
+            const Index end = operand.indexOf(';');
+            const UnownedStringSlice moduleName = (end < 0 ? operand : operand.head(end)).trim();
+            if (moduleName.getLength() == 0)
+            {
+                continue;
+            }
+            StringBuilder fileName;
+            for (auto c : moduleName)
+            {
+                fileName.appendChar(c == '.' ? '/' : c);
+            }
+            fileName.append(".slang");
+            candidateNames.add(fileName);
+            candidateNames.add(StringUtil::calcCharReplaced(fileName, '_', '-'));
+        }
+
+        bool found = false;
+        for (const auto& candidateName : candidateNames)
+        {
+            String dependencyPath;
+            if (SLANG_SUCCEEDED(_findFile(
+                    candidateName.getUnownedSlice(),
+                    directory,
+                    searchDirectories,
+                    dependencyPath)))
+            {
+                SLANG_RETURN_ON_FAIL(
+                    _appendSourceFile(dependencyPath, searchDirectories, ioVisited, builder));
+                found = true;
+                break;
+            }
+        }
+        if (!found && mustExist)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult TestCompileCache::calcKey(const CommandLine& cmdLine, Key& outKey)
+{
+    const auto& args = cmdLine.m_args;
+
+    List<String> searchDirectories;
+    for (Index i = 0; i < args.getCount(); ++i)
+    {
+        const auto& arg = args[i];
+        for (auto option : kUncachableOptions)
+        {
+            if (arg == option)
+            {
+                return SLANG_E_NOT_AVAILABLE;
+            }
+        }
+        if (arg == "-I" && i + 1 < args.getCount())
+        {
+            searchDirectories.add(args[i + 1]);
+        }
+        else if (arg.startsWith("-I") && arg.getLength() > 2)
+        {
+            searchDirectories.add(String(arg.getUnownedSlice().tail(2)));
+        }
+    }
+
+    DigestBuilder<SHA1> builder;
+    builder.append(m_compilerDigest);
+    builder.append(cmdLine.m_executableLocation.m_pathOrName);
+    builder.append(args.getCount());
+    for (const auto& arg : args)
+    {
+        builder.append(arg.getLength());
+        builder.append(arg);
+    }
+
+    // Any arg that names a file is a source the compile reads.
+    HashSet<String> visited;
+    for (const auto& arg : args)
+    {
+        if (arg.getLength() && arg[0] != '-' && File::exists(arg))
+        {
+            SlangPathType pathType;
+            if (SLANG_SUCCEEDED(Path::getPathType(arg, &pathType)) &&
+                pathType == SLANG_PATH_TYPE_FILE)
+            {
+                SLANG_RETURN_ON_FAIL(_appendSourceFile(arg, searchDirectories, visited, builder));
+            }
+        }
+    }
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+static void _appendString(List<uint8_t>& ioData, const String& text)
+{
+    const uint32_t length = uint32_t(text.getLength());
+    ioData.addRange((const uint8_t*)&length, sizeof(length));
+    ioData.addRange((const uint8_t*)text.getBuffer(), text.getLength());
+}
+
+static SlangResult _readString(const uint8_t*& ioCursor, const uint8_t* end, String& outText)
+{
+    uint32_t length = 0;
+    if (size_t(end - ioCursor) < sizeof(length))
+    {
+        return SLANG_FAIL;
+    }
+    memcpy(&length, ioCursor, sizeof(length));
+    ioCursor += sizeof(length);
+    if (size_t(end - ioCursor) < length)
+    {
+        return SLANG_FAIL;
+    }
+    outText = UnownedStringSlice((const char*)ioCursor, length);
+    ioCursor += length;
+    return SLANG_OK;
+}
+
+SlangResult TestCompileCache::writeResult(const Key& key, const ExecuteResult& result)
+{
+    List<uint8_t> data;
+    const int32_t resultCode = int32_t(result.resultCode);
+    data.addRange((const uint8_t*)&resultCode, sizeof(resultCode));
+    _appendString(data, result.standardOutput);
+    _appendString(data, result.standardError);
+    _appendString(data, result.debugLayer);
+
+    auto blob = RawBlob::create(data.getBuffer(), data.getCount());
+    return m_cache->writeEntry(key, blob);
+}
+
+SlangResult TestCompileCache::readResult(const Key& key, ExecuteResult& outResult)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(m_cache->readEntry(key, blob.writeRef()));
+
+    const uint8_t* cursor = (const uint8_t*)blob->getBufferPointer();
+    const uint8_t* end = cursor + blob->getBufferSize();
+
+    int32_t resultCode = 0;
+    if (size_t(end - cursor) < sizeof(resultCode))
+    {
+        return SLANG_FAIL;
+    }
+    memcpy(&resultCode, cursor, sizeof(resultCode));
+    cursor += sizeof(resultCode);
+
+    ExecuteResult result;
+    result.init();
+    result.resultCode = resultCode;
+    SLANG_RETURN_ON_FAIL(_readString(cursor, end, result.standardOutput));
+    SLANG_RETURN_ON_FAIL(_readString(cursor, end, result.standardError));
+    SLANG_RETURN_ON_FAIL(_readString(cursor, end, result.debugLayer));
+
+    outResult = result;
+    return SLANG_OK;
+}
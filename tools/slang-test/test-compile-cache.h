@@ -0,0 +1,51 @@
+// test-compile-cache.h
+
+#ifndef TEST_COMPILE_CACHE_H_INCLUDED
+#define TEST_COMPILE_CACHE_H_INCLUDED
+
+#include "../../source/core/slang-command-line.h"
+#include "../../source/core/slang-crypto.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-persistent-cache.h"
+#include "../../source/core/slang-process-util.h"
+
+/// A content addressed cache of the results of compiling with slangc.
+///
+/// The key of an entry is a hash of the compiler binaries, the command line, and the contents
+/// of every source file the compile reads, so tests that compile the same sources with the same
+/// options share one compile, both within a run and across runs that use the same cache
+/// directory.
+class TestCompileCache : public Slang::RefObject
+{
+public:
+    typedef Slang::PersistentCache::Key Key;
+
+    /// Calculate the key for compiling with `cmdLine`.
+    /// Returns SLANG_E_NOT_AVAILABLE if the compile can't be cached, for example because it
+    /// writes files, or one of the files it includes can't be found.
+    SlangResult calcKey(const Slang::CommandLine& cmdLine, Key& outKey);
+
+    /// Read the result of a compile. Returns SLANG_E_NOT_FOUND if it isn't in the cache.
+    SlangResult readResult(const Key& key, Slang::ExecuteResult& outResult);
+    /// Write the result of a compile.
+    SlangResult writeResult(const Key& key, const Slang::ExecuteResult& result);
+
+    /// Get the hit and miss counts
+    const Slang::PersistentCache::Stats& getStats() const { return m_cache->getStats(); }
+
+    /// Ctor. The cache is stored in `directory`.
+    TestCompileCache(const Slang::String& directory);
+
+protected:
+    SlangResult _appendSourceFile(
+        const Slang::String& path,
+        const Slang::List<Slang::String>& searchDirectories,
+        Slang::HashSet<Slang::String>& ioVisited,
+        Slang::DigestBuilder<Slang::SHA1>& builder);
+
+    /// Digest identifying the compiler binaries
+    Key m_compilerDigest;
+    Slang::RefPtr<Slang::PersistentCache> m_cache;
+};
+
+#endif // TEST_COMPILE_CACHE_H_INCLUDED
@@ -15,6 +15,7 @@
 #include "filecheck.h"
 #include "options.h"
 #include "slang-com-ptr.h"
+#include "test-compile-cache.h"
 
 #include <atomic>
 #include <mutex>
@@ -192,6 +193,13 @@ public:
     Slang::List<Slang::RefPtr<FileTestInfo>> failedFileTests;
     Slang::List<Slang::String> failedUnitTests;
 
+    /// Wall clock time taken by each test file in this run, in milliseconds.
+    std::mutex mutexTestDurations;
+    Slang::Dictionary<Slang::String, double> testDurations;
+
+    /// Results of compiles shared between tests, set if `-compile-cache` is used.
+    Slang::RefPtr<TestCompileCache> compileCache;
+
     /// Set when too many consecutive failures indicate a systemic issue (e.g., GPU driver crash).
     /// Checked by the parallel test loop to stop scheduling new tests.
     std::atomic<bool> stopSchedulingTests{false};
@@ -0,0 +1,131 @@
+// unit-test-async-codegen.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+using namespace Slang;
+
+namespace
+{
+
+static void _countCallback(slang::ICodeGenFuture* future, void* userData)
+{
+    // The future must already be ready when its callback runs.
+    if (future->isReady())
+        (*(std::atomic<int>*)userData)++;
+}
+
+} // namespace
+
+// Test that code generated through a future is the same as the code generated directly, and
+// that a cancelled future finishes.
+//
+SLANG_UNIT_TEST(asyncCodeGen)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = int(tid.x) * 2;
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IComponentType2> linked2;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linked->queryInterface(slang::IComponentType2::getTypeGuid(), (void**)linked2.writeRef())));
+
+    std::atomic<int> callbackCount{0};
+
+    ComPtr<slang::ICodeGenFuture> entryPointFuture;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linked2->getEntryPointCodeAsync(
+        0,
+        0,
+        &_countCallback,
+        &callbackCount,
+        entryPointFuture.writeRef())));
+
+    ComPtr<slang::ICodeGenFuture> targetFuture;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linked2->getTargetCodeAsync(
+        0,
+        &_countCallback,
+        &callbackCount,
+        targetFuture.writeRef())));
+
+    ComPtr<slang::IBlob> asyncCode;
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(entryPointFuture->getResult(asyncCode.writeRef(), diagnostics.writeRef())));
+    SLANG_CHECK(entryPointFuture->isReady());
+
+    ComPtr<slang::IBlob> asyncTargetCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(targetFuture->getResult(asyncTargetCode.writeRef())));
+    SLANG_CHECK(asyncTargetCode != nullptr);
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())));
+    SLANG_CHECK_ABORT(asyncCode != nullptr);
+    SLANG_CHECK(asyncCode->getBufferSize() == code->getBufferSize());
+    SLANG_CHECK(
+        memcmp(asyncCode->getBufferPointer(), code->getBufferPointer(), code->getBufferSize()) ==
+        0);
+
+    // A cancelled future still becomes ready and runs its callback, whether it got to finish
+    // before the cancellation or not.
+    ComPtr<slang::ICodeGenFuture> cancelledFuture;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linked2->getEntryPointCodeAsync(
+        0,
+        0,
+        &_countCallback,
+        &callbackCount,
+        cancelledFuture.writeRef())));
+    cancelledFuture->cancel();
+    ComPtr<slang::IBlob> cancelledCode;
+    const SlangResult cancelledResult = cancelledFuture->getResult(cancelledCode.writeRef());
+    SLANG_CHECK(cancelledResult == SLANG_OK || cancelledResult == SLANG_E_ABORT);
+    SLANG_CHECK((cancelledResult == SLANG_OK) == (cancelledCode != nullptr));
+
+    // The callback runs after the future is marked ready, so it may still be on its way.
+    while (callbackCount.load() < 3)
+        std::this_thread::yield();
+    SLANG_CHECK(callbackCount == 3);
+}
@@ -0,0 +1,75 @@
+// unit-test-compile-time-budget.cpp
+
+#include "../../source/compiler-core/slang-compile-time-budget.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// A budget far longer than the test takes to run, so that only the pass durations noted below
+// decide whether to degrade, and not the time that actually passes.
+static const Int kLongBudgetMilliseconds = 60 * 60 * 1000;
+
+// Test the decisions of `CompileTimeBudget` against pass durations made up by the test.
+//
+SLANG_UNIT_TEST(compileTimeBudget)
+{
+    // A budget that was never started, or of 0, is disabled, and never degrades.
+    {
+        CompileTimeBudget budget;
+        SLANG_CHECK(!budget.isEnabled());
+        budget.start(0);
+        budget.notePassDuration("simplifyIR", double(kLongBudgetMilliseconds) * 2);
+        SLANG_CHECK(!budget.isEnabled());
+        SLANG_CHECK(!budget.isExceeded());
+        SLANG_CHECK(!budget.shouldDegrade("simplifyIR"));
+        SLANG_CHECK(!budget.wasDegraded());
+    }
+
+    // A pass degrades once running it again for as long as it has taken at most would go over
+    // the budget, and other passes are predicted from their own durations.
+    {
+        CompileTimeBudget budget;
+        budget.start(kLongBudgetMilliseconds);
+        SLANG_CHECK(budget.isEnabled());
+        SLANG_CHECK(budget.getBudgetMilliseconds() == kLongBudgetMilliseconds);
+        SLANG_CHECK(!budget.isExceeded());
+
+        // A pass that hasn't run yet is expected to take no time.
+        SLANG_CHECK(!budget.shouldDegrade("simplifyIR"));
+
+        budget.notePassDuration("simplifyIR", 10.0);
+        SLANG_CHECK(!budget.shouldDegrade("simplifyIR"));
+
+        budget.notePassDuration("simplifyIR", double(kLongBudgetMilliseconds));
+        SLANG_CHECK(budget.shouldDegrade("simplifyIR"));
+        SLANG_CHECK(!budget.shouldDegrade("performHeuristicInlining"));
+
+        // The longest duration is kept, so a shorter run doesn't undo the prediction.
+        budget.notePassDuration("simplifyIR", 1.0);
+        SLANG_CHECK(budget.shouldDegrade("simplifyIR"));
+
+        // Deciding to degrade doesn't by itself count as degrading.
+        SLANG_CHECK(!budget.wasDegraded());
+    }
+
+    // The reduced optimizations are reported once each, in the order they were first reduced.
+    {
+        CompileTimeBudget budget;
+        budget.start(kLongBudgetMilliseconds);
+        budget.noteDegraded(toSlice("simplifyIR"));
+        budget.noteDegraded(toSlice("performHeuristicInlining"));
+        budget.noteDegraded(toSlice("simplifyIR"));
+        SLANG_CHECK(budget.wasDegraded());
+        SLANG_CHECK(
+            budget.getDegradedOptimizations() ==
+            List<String>("simplifyIR", "performHeuristicInlining"));
+
+        // Starting again forgets the pass durations, but not what was reduced, since both
+        // starts contribute to the same result.
+        budget.notePassDuration("simplifyIR", double(kLongBudgetMilliseconds));
+        budget.start(kLongBudgetMilliseconds);
+        SLANG_CHECK(!budget.shouldDegrade("simplifyIR"));
+        SLANG_CHECK(budget.wasDegraded());
+        SLANG_CHECK(budget.getDegradedOptimizations().getCount() == 2);
+    }
+}
@@ -0,0 +1,137 @@
+// unit-test-concurrent-reflection.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+namespace
+{
+
+struct BindingRangeSummary
+{
+    SlangInt bindingRangeCount = -1;
+    SlangInt descriptorSetCount = -1;
+    SlangInt subObjectRangeCount = -1;
+    slang::BindingType firstBindingType = slang::BindingType::Unknown;
+};
+
+static void _summarizeBindingRanges(
+    slang::TypeLayoutReflection* typeLayout,
+    BindingRangeSummary& outSummary)
+{
+    outSummary.bindingRangeCount = typeLayout->getBindingRangeCount();
+    outSummary.descriptorSetCount = typeLayout->getDescriptorSetCount();
+    outSummary.subObjectRangeCount = typeLayout->getSubObjectRangeCount();
+    if (outSummary.bindingRangeCount > 0)
+        outSummary.firstBindingType = typeLayout->getBindingRangeType(0);
+}
+
+} // namespace
+
+// Test that several threads can query the binding ranges of the same type layout at once, and
+// all see the same result.
+//
+SLANG_UNIT_TEST(concurrentReflection)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        struct Material
+        {
+            float4 tint;
+            Texture2D albedo;
+            Texture2D normals[2];
+            SamplerState sampler;
+        }
+
+        ParameterBlock<Material> material;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = material.tint +
+                material.albedo.SampleLevel(material.sampler, float2(0), 0) +
+                material.normals[1].Load(int3(0));
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    auto layout = linked->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+    auto materialLayout = layout->getParameterByIndex(0)->getTypeLayout();
+    SLANG_CHECK_ABORT(materialLayout != nullptr);
+    auto materialElementLayout = materialLayout->getElementTypeLayout();
+    SLANG_CHECK_ABORT(materialElementLayout != nullptr);
+
+    // Nothing has asked for the binding ranges yet, so the threads race to compute them.
+    const int kThreadCount = 8;
+    BindingRangeSummary summaries[kThreadCount];
+    BindingRangeSummary elementSummaries[kThreadCount];
+    std::thread threads[kThreadCount];
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        threads[i] = std::thread(
+            [&, i]()
+            {
+                _summarizeBindingRanges(materialLayout, summaries[i]);
+                _summarizeBindingRanges(materialElementLayout, elementSummaries[i]);
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    BindingRangeSummary expected;
+    _summarizeBindingRanges(materialLayout, expected);
+    BindingRangeSummary expectedElement;
+    _summarizeBindingRanges(materialElementLayout, expectedElement);
+    SLANG_CHECK(expectedElement.bindingRangeCount == 3);
+
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        SLANG_CHECK(summaries[i].bindingRangeCount == expected.bindingRangeCount);
+        SLANG_CHECK(summaries[i].descriptorSetCount == expected.descriptorSetCount);
+        SLANG_CHECK(summaries[i].subObjectRangeCount == expected.subObjectRangeCount);
+        SLANG_CHECK(summaries[i].firstBindingType == expected.firstBindingType);
+
+        SLANG_CHECK(elementSummaries[i].bindingRangeCount == expectedElement.bindingRangeCount);
+        SLANG_CHECK(elementSummaries[i].descriptorSetCount == expectedElement.descriptorSetCount);
+        SLANG_CHECK(
+            elementSummaries[i].subObjectRangeCount == expectedElement.subObjectRangeCount);
+        SLANG_CHECK(elementSummaries[i].firstBindingType == expectedElement.firstBindingType);
+    }
+}
@@ -0,0 +1,131 @@
+// unit-test-concurrent-session.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+namespace
+{
+
+struct ConcurrentSessionResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+};
+
+static void _compileModuleOnSharedSession(
+    slang::ISession* session,
+    int threadIndex,
+    ConcurrentSessionResult& outResult)
+{
+    StringBuilder moduleName;
+    moduleName << "concurrent" << threadIndex;
+    StringBuilder modulePath;
+    modulePath << moduleName << ".slang";
+
+    // Each thread imports the same shared module and writes a value of its own, so that its
+    // code can be told apart from that of the other threads.
+    StringBuilder source;
+    source << "import concurrent_shared;\n"
+              "RWStructuredBuffer<int> outputBuffer;\n"
+              "[shader(\"compute\")]\n"
+              "[numthreads(4, 1, 1)]\n"
+              "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+              "{\n"
+              "    outputBuffer[tid.x] = sharedValue(tid.x) + "
+           << (threadIndex * 100 + 7)
+           << ";\n"
+              "}\n";
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        moduleName.getBuffer(),
+        modulePath.getBuffer(),
+        source.getBuffer(),
+        diagnostics.writeRef());
+    if (!module)
+        return;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return;
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_VOID_ON_FAIL(session->createCompositeComponentType(
+        components,
+        2,
+        composite.writeRef(),
+        diagnostics.writeRef()));
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_RETURN_VOID_ON_FAIL(composite->link(linked.writeRef(), diagnostics.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    outResult.result =
+        linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef());
+    if (SLANG_SUCCEEDED(outResult.result))
+        outResult.code = UnownedStringSlice(
+            (const char*)code->getBufferPointer(),
+            code->getBufferSize());
+}
+
+} // namespace
+
+// Test that several threads can load modules into, link against, and generate code from
+// a single session at the same time.
+//
+SLANG_UNIT_TEST(concurrentSession)
+{
+    static constexpr int kThreadCount = 8;
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto sharedModule = session->loadModuleFromSourceString(
+        "concurrent_shared",
+        "concurrent_shared.slang",
+        "int sharedValue(uint index) { return int(index) * 2; }\n",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(sharedModule != nullptr);
+
+    ConcurrentSessionResult results[kThreadCount];
+    std::thread threads[kThreadCount];
+    for (int threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads[threadIndex] = std::thread(
+            [&, threadIndex]()
+            { _compileModuleOnSharedSession(session, threadIndex, results[threadIndex]); });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(results[threadIndex].result));
+
+        StringBuilder expectedValue;
+        expectedValue << (threadIndex * 100 + 7);
+        SLANG_CHECK(
+            results[threadIndex].code.getUnownedSlice().indexOf(
+                expectedValue.getUnownedSlice()) != -1);
+    }
+}
@@ -67,6 +67,35 @@ SLANG_UNIT_TEST(crypto)
         SLANG_CHECK(digest.toString() == "7a8213edf9976d2e693f27bbc7dc41546bcfcc97");
     }
 
+    // Updates of every size up to a little over a block, so that updates start and end at
+    // every position within a block.
+    {
+        uint8_t data[1000];
+        for (int i = 0; i < SLANG_COUNT_OF(data); ++i)
+        {
+            data[i] = uint8_t(i * 7 + 3);
+        }
+
+        for (size_t updateSize = 1; updateSize <= 70; ++updateSize)
+        {
+            SHA1 sha1;
+            for (size_t offset = 0; offset < sizeof(data); offset += updateSize)
+            {
+                sha1.update(data + offset, Math::Min(updateSize, sizeof(data) - offset));
+            }
+            auto digest = sha1.finalize();
+            SLANG_CHECK(digest.toString() == "4231a8a50a10fa9758db8ec71fdef855b751048a");
+        }
+    }
+
+    // Many blocks in one call to update()
+    {
+        List<char> data = List<char>::makeRepeated('a', 1000000);
+        SLANG_CHECK(
+            SHA1::compute(data.getBuffer(), data.getCount()).toString() ==
+            "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+    }
+
     // compute()
     {
         SLANG_CHECK(
@@ -0,0 +1,155 @@
+// unit-test-dictionary-benchmark.cpp
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-string.h"
+#include "../../tools/platform/performance-counter.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <unordered_map>
+
+using namespace Slang;
+
+namespace
+{
+
+// The keys of the hot maps in the compiler are mostly pointers to arena-allocated nodes,
+// so make keys that are spaced out like those are.
+static List<void*> _makePointerKeys(List<uint64_t>& storage, Index count)
+{
+    storage.setCount(count * 4);
+    List<void*> keys;
+    keys.reserve(count);
+    for (Index i = 0; i < count; i++)
+        keys.add(&storage[i * 4]);
+    return keys;
+}
+
+static List<String> _makeStringKeys(Index count)
+{
+    List<String> keys;
+    keys.reserve(count);
+    for (Index i = 0; i < count; i++)
+        keys.add("_S" + String(i) + "_mangledName" + String(i * 7919));
+    return keys;
+}
+
+// Insert every key, look each one up several times, then remove every other one.
+//
+// Returns the number of keys left, so the work cannot be optimized away.
+//
+template<typename TKey>
+static Index _runDictionaryOperations(const List<TKey>& keys, Index lookupPasses)
+{
+    Dictionary<TKey, Index> dict;
+    for (Index i = 0; i < keys.getCount(); i++)
+        dict.add(keys[i], i);
+
+    Index found = 0;
+    for (Index pass = 0; pass < lookupPasses; pass++)
+    {
+        for (auto& key : keys)
+        {
+            if (auto value = dict.tryGetValue(key))
+                found += (*value >= 0) ? 1 : 0;
+        }
+    }
+    SLANG_CHECK(found == keys.getCount() * lookupPasses);
+
+    for (Index i = 0; i < keys.getCount(); i += 2)
+        dict.remove(keys[i]);
+    return Index(dict.getCount());
+}
+
+} // namespace
+
+// Test that insertion, lookup and removal agree with `std::unordered_map`.
+//
+SLANG_UNIT_TEST(dictionaryOperations)
+{
+    List<String> keys = _makeStringKeys(1000);
+
+    Dictionary<String, Index> dict;
+    std::unordered_map<std::string, Index> reference;
+    for (Index i = 0; i < keys.getCount(); i++)
+    {
+        // Add some keys twice, so both maps have to keep the first value.
+        Index keyIndex = (i * 37) % keys.getCount();
+        bool added = dict.addIfNotExists(keys[keyIndex], i);
+        bool referenceAdded = reference.emplace(keys[keyIndex].getBuffer(), i).second;
+        SLANG_CHECK(added == referenceAdded);
+        if (i % 3 == 0)
+        {
+            Index removeIndex = (i * 11) % keys.getCount();
+            dict.remove(keys[removeIndex]);
+            reference.erase(keys[removeIndex].getBuffer());
+        }
+    }
+
+    SLANG_CHECK(dict.getCount() == reference.size());
+    for (auto& key : keys)
+    {
+        auto value = dict.tryGetValue(key);
+        auto referenceValue = reference.find(key.getBuffer());
+        SLANG_CHECK((value != nullptr) == (referenceValue != reference.end()));
+        if (value && referenceValue != reference.end())
+            SLANG_CHECK(*value == referenceValue->second);
+    }
+}
+
+// Test that maps and sets keyed by `String` find the same entries when searched with a slice
+// or a C string, which doesn't make a `String` for the lookup.
+//
+SLANG_UNIT_TEST(dictionaryStringSliceLookup)
+{
+    List<String> keys = _makeStringKeys(100);
+
+    Dictionary<String, Index> dict;
+    HashSet<String> set;
+    for (Index i = 0; i < keys.getCount(); i += 2)
+    {
+        dict.add(keys[i], i);
+        set.add(keys[i]);
+    }
+
+    for (Index i = 0; i < keys.getCount(); i++)
+    {
+        const bool expected = (i % 2) == 0;
+        UnownedStringSlice slice = keys[i].getUnownedSlice();
+
+        auto value = dict.tryGetValue(slice);
+        SLANG_CHECK((value != nullptr) == expected);
+        if (value)
+            SLANG_CHECK(*value == i);
+        SLANG_CHECK(dict.containsKey(keys[i].getBuffer()) == expected);
+        SLANG_CHECK(set.contains(slice) == expected);
+
+        // A prefix of a key is not the key.
+        SLANG_CHECK(!dict.containsKey(slice.head(slice.getLength() - 1)));
+    }
+    SLANG_CHECK(!dict.containsKey(UnownedStringSlice()));
+    SLANG_CHECK(!dict.containsKey(""));
+}
+
+// Measure insertion, lookup and removal with pointer keys and with string keys.
+//
+// The measured time is reported as the execution time of this test.
+//
+SLANG_UNIT_TEST(dictionaryBenchmark)
+{
+    static const Index kPointerKeyCount = 200000;
+    static const Index kStringKeyCount = 50000;
+    static const Index kLookupPasses = 8;
+
+    List<uint64_t> storage;
+    List<void*> pointerKeys = _makePointerKeys(storage, kPointerKeyCount);
+    List<String> stringKeys = _makeStringKeys(kStringKeyCount);
+
+    auto start = platform::PerformanceCounter::now();
+    Index pointerKeysLeft = _runDictionaryOperations(pointerKeys, kLookupPasses);
+    Index stringKeysLeft = _runDictionaryOperations(stringKeys, kLookupPasses);
+    auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+
+    SLANG_CHECK(pointerKeysLeft == kPointerKeyCount / 2);
+    SLANG_CHECK(stringKeysLeft == kStringKeyCount / 2);
+    getTestReporter()->addExecutionTime(time);
+}
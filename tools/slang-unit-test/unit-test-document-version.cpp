@@ -0,0 +1,130 @@
+// unit-test-document-version.cpp
+
+#include "../../source/compiler-core/slang-document-version.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+struct TextEdit
+{
+    Index startOffset;
+    Index endOffset;
+    const char* replacement;
+};
+
+} // namespace
+
+static bool _areBoundariesEqual(ArrayView<Index> a, ArrayView<Index> b)
+{
+    if (a.getCount() != b.getCount())
+        return false;
+    for (Index i = 0; i < a.getCount(); i++)
+    {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+// Check that `doc` is split into lines, and maps offsets to locations, the same as a document
+// with its text set all at once.
+static void _checkSameAsSetText(DocumentVersion* doc)
+{
+    RefPtr<DocumentVersion> expected = new DocumentVersion();
+    expected->setText(doc->getText());
+
+    SLANG_CHECK_ABORT(doc->getLineCount() == expected->getLineCount());
+    for (Index line = 1; line <= doc->getLineCount(); line++)
+    {
+        auto docLine = doc->getLine(line);
+        auto expectedLine = expected->getLine(line);
+        SLANG_CHECK(docLine == expectedLine);
+        SLANG_CHECK(doc->getLineStart(docLine) == expected->getLineStart(expectedLine));
+        SLANG_CHECK(_areBoundariesEqual(
+            doc->getUTF8Boundaries(line),
+            expected->getUTF8Boundaries(line)));
+        SLANG_CHECK(_areBoundariesEqual(
+            doc->getUTF16Boundaries(line),
+            expected->getUTF16Boundaries(line)));
+    }
+
+    for (Index offset = 0; offset <= doc->getText().getLength(); offset++)
+    {
+        Index line, col, expectedLine, expectedCol;
+        doc->offsetToLineCol(offset, line, col);
+        expected->offsetToLineCol(offset, expectedLine, expectedCol);
+        SLANG_CHECK(line == expectedLine && col == expectedCol);
+        SLANG_CHECK(doc->getOffset(line, col) == expected->getOffset(line, col));
+    }
+}
+
+// Apply `edits` in order to a document holding `text`, checking the document after each.
+static void _checkEdits(const char* text, ConstArrayView<TextEdit> edits)
+{
+    RefPtr<DocumentVersion> doc = new DocumentVersion();
+    doc->setText(text);
+
+    // Find the UTF boundaries up front, so that edits keep those of the lines they don't touch.
+    doc->ensureUTFBoundsAvailable();
+
+    for (auto const& edit : edits)
+    {
+        auto oldText = doc->getText().getUnownedSlice();
+        StringBuilder newText;
+        newText << oldText.head(edit.startOffset) << edit.replacement
+                << oldText.tail(edit.endOffset);
+
+        doc->replaceText(edit.startOffset, edit.endOffset, edit.replacement);
+        SLANG_CHECK_ABORT(doc->getText() == newText);
+        _checkSameAsSetText(doc);
+    }
+}
+
+SLANG_UNIT_TEST(documentVersionReplaceText)
+{
+    // Inserting a line feed after a carriage return joins them into one line break.
+    {
+        const TextEdit edits[] = {{2, 2, "\n"}};
+        _checkEdits("a\rb\rc", makeConstArrayView(edits));
+    }
+
+    // Inserting a carriage return before a line feed does the same.
+    {
+        const TextEdit edits[] = {{1, 1, "\r"}};
+        _checkEdits("a\nb\nc", makeConstArrayView(edits));
+    }
+
+    // Deleting across several lines, then inserting several lines in their place.
+    {
+        const TextEdit edits[] = {{4, 16, ""}, {4, 4, "x\r\ny\nz"}};
+        _checkEdits("abc\ndef\r\nghi\njkl\nmno\n", makeConstArrayView(edits));
+    }
+
+    // Edits at the end of the document, with and without a final line break.
+    {
+        const TextEdit edits[] = {{7, 7, "\nlast"}, {12, 12, "\n"}, {7, 13, ""}};
+        _checkEdits("one\ntwo", makeConstArrayView(edits));
+    }
+
+    // An empty replacement of an empty range changes nothing, and an empty replacement of a
+    // line break joins two lines.
+    {
+        const TextEdit edits[] = {{5, 5, ""}, {3, 4, ""}};
+        _checkEdits("abc\ndef\nghi", makeConstArrayView(edits));
+    }
+
+    // Lines with characters outside of ASCII, before, in and after the edit.
+    {
+        const TextEdit edits[] = {{9, 11, "\xc3\xbc\n\xf0\x9f\x98\x80"}};
+        _checkEdits("\xc3\xa9t\xc3\xa9\n\xe2\x82\xacuro\n\xc3\xa0", makeConstArrayView(edits));
+    }
+
+    // Deleting everything, then typing into the empty document.
+    {
+        const TextEdit edits[] = {{0, 7, ""}, {0, 0, "a\nb"}};
+        _checkEdits("abc\ndef", makeConstArrayView(edits));
+    }
+}
@@ -0,0 +1,98 @@
+// unit-test-entry-point-permutations.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `compileEntryPointPermutations` generates code for every permutation of a
+// generic entry point, and that a permutation that fails does not affect the others.
+//
+SLANG_UNIT_TEST(entryPointPermutations)
+{
+    static constexpr int kPermutationCount = 9;
+    static constexpr int kFailingPermutation = 4;
+
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain<int x>(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = x * 100 + 7;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", userSourceBody, diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType2> entryPoint2;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(entryPoint->queryInterface(
+        slang::IComponentType2::getTypeGuid(),
+        (void**)entryPoint2.writeRef())));
+
+    List<String> exprs;
+    List<slang::SpecializationArg> args;
+    for (int ii = 0; ii < kPermutationCount; ++ii)
+        exprs.add(ii == kFailingPermutation ? String("undefinedValue") : String(ii));
+    for (auto& expr : exprs)
+        args.add(slang::SpecializationArg::fromExpr(expr.getBuffer()));
+
+    slang::IBlob* rawCodes[kPermutationCount] = {};
+    diagnostics.setNull();
+    const auto result = entryPoint2->compileEntryPointPermutations(
+        0,
+        0,
+        args.getBuffer(),
+        1,
+        kPermutationCount,
+        rawCodes,
+        diagnostics.writeRef());
+
+    ComPtr<slang::IBlob> codes[kPermutationCount];
+    for (int ii = 0; ii < kPermutationCount; ++ii)
+        codes[ii].attach(rawCodes[ii]);
+
+    SLANG_CHECK(SLANG_FAILED(result));
+    SLANG_CHECK(diagnostics != nullptr);
+
+    for (int ii = 0; ii < kPermutationCount; ++ii)
+    {
+        if (ii == kFailingPermutation)
+        {
+            SLANG_CHECK(codes[ii] == nullptr);
+            continue;
+        }
+        SLANG_CHECK_ABORT(codes[ii] != nullptr);
+
+        UnownedStringSlice code(
+            (const char*)codes[ii]->getBufferPointer(),
+            codes[ii]->getBufferSize());
+        StringBuilder expectedValue;
+        expectedValue << (ii * 100 + 7);
+        SLANG_CHECK(code.indexOf(expectedValue.getUnownedSlice()) != -1);
+    }
+}
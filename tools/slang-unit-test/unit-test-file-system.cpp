@@ -4,8 +4,10 @@
 #include "../../source/core/slang-deflate-compression-system.h"
 #include "../../source/core/slang-file-system.h"
 #include "../../source/core/slang-io.h"
+#include "../../source/core/slang-job-scheduler.h"
 #include "../../source/core/slang-lz4-compression-system.h"
 #include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-process.h"
 #include "../../source/core/slang-riff-file-system.h"
 #include "../../source/core/slang-zip-file-system.h"
 #include "unit-test/slang-unit-test.h"
@@ -525,6 +527,28 @@ static SlangResult _test(FileSystemType type)
 
         // Check the file systems contents are the same
         SLANG_RETURN_ON_FAIL(_checkEqual(loadedFileSystem, fileSystem));
+
+        // Loading from a blob may reference the blob's contents rather than copying them,
+        // so check that works from a mapped file that outlives any of our references to it.
+        String archiveFileName;
+        SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-archive"), archiveFileName));
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(
+            archiveFileName,
+            archiveBlob->getBufferPointer(),
+            archiveBlob->getBufferSize()));
+
+        ComPtr<ISlangFileSystemExt> mappedFileSystem;
+        {
+            ComPtr<ISlangBlob> mappedBlob;
+            SLANG_RETURN_ON_FAIL(File::mapAllBytes(archiveFileName, mappedBlob));
+            SLANG_CHECK(mappedBlob->getBufferSize() == archiveBlob->getBufferSize());
+            SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(mappedBlob, mappedFileSystem));
+        }
+        const SlangResult mappedResult = _checkEqual(mappedFileSystem, fileSystem);
+
+        mappedFileSystem.setNull();
+        File::remove(archiveFileName);
+        SLANG_RETURN_ON_FAIL(mappedResult);
     }
 
     SLANG_RETURN_ON_FAIL(fileSystem->remove("d/a"));
@@ -575,3 +599,222 @@ SLANG_UNIT_TEST(fileSystem)
         }
     }
 }
+
+SLANG_UNIT_TEST(fileSystemLoadLargeFile)
+{
+    // Large precompiled modules are mapped by the OS file system, and everything else is read.
+    // Check sizes either side of a page boundary, for a module and for a source file, so
+    // that both the mapped and the read paths are covered, and that the contents are always
+    // followed by a zero byte.
+    const size_t sizes[] = {100, 200 * 1024 + 17, 256 * 1024};
+    const char* fileNames[] = {
+        "unit-test-file-system-large.slang-module",
+        "unit-test-file-system-large.slang"};
+    for (auto size : sizes)
+    {
+        for (auto fileNameText : fileNames)
+        {
+            List<Byte> contents;
+            contents.setCount(Index(size));
+            for (Index i = 0; i < Index(size); ++i)
+                contents[i] = Byte('a' + (i % 26));
+
+            const String fileName = fileNameText;
+            SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(fileName, contents.getBuffer(), size)));
+
+            {
+                ComPtr<ISlangBlob> blob;
+                SLANG_CHECK(SLANG_SUCCEEDED(OSFileSystem::getExtSingleton()->loadFile(
+                    fileName.getBuffer(),
+                    blob.writeRef())));
+                SLANG_CHECK(blob && blob->getBufferSize() == size);
+                if (blob && blob->getBufferSize() == size)
+                {
+                    const Byte* data = (const Byte*)blob->getBufferPointer();
+                    SLANG_CHECK(::memcmp(data, contents.getBuffer(), size) == 0);
+                    SLANG_CHECK(data[size] == 0);
+                }
+            }
+
+            File::remove(fileName);
+        }
+    }
+}
+
+SLANG_UNIT_TEST(fileSystemDigestCache)
+{
+    // A digest cache lets a later session work out the hash unique identity of an unchanged
+    // file without hashing it again, and a changed file is still hashed afresh. A file modified
+    // too recently for its modification time to identify its content is always hashed.
+    const String cacheDirectory = "unit-test-file-system-digests";
+    const String fileName = "unit-test-file-system-digest.txt";
+
+    RefPtr<PersistentCache> digestCache;
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        digestCache = new PersistentCache(desc);
+        digestCache->clear();
+    }
+
+    auto getIdentity = [&](String& outIdentity) -> SlangResult
+    {
+        ComPtr<CacheFileSystem> cacheFileSystem(new CacheFileSystem(
+            OSFileSystem::getLoadSingleton(),
+            CacheFileSystem::UniqueIdentityMode::Hash));
+        cacheFileSystem->setDigestCache(digestCache);
+
+        ComPtr<ISlangBlob> identity;
+        SLANG_RETURN_ON_FAIL(
+            cacheFileSystem->getFileUniqueIdentity(fileName.getBuffer(), identity.writeRef()));
+        outIdentity = StringUtil::getString(identity);
+        return SLANG_OK;
+    };
+
+    auto waitUntilNotRecent = [&]()
+    {
+        uint64_t modifiedTime = 0;
+        uint64_t size = 0;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(File::getModifiedTimeAndSize(fileName, modifiedTime, size)));
+        while (File::isModifiedTimeRecent(modifiedTime))
+            Process::sleepCurrentThread(100);
+    };
+
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllText(fileName, "int a;")));
+
+    String recent;
+    SLANG_CHECK(SLANG_SUCCEEDED(getIdentity(recent)));
+    SLANG_CHECK(digestCache->getStats().hitCount == 0);
+
+    waitUntilNotRecent();
+
+    String first;
+    SLANG_CHECK(SLANG_SUCCEEDED(getIdentity(first)));
+    SLANG_CHECK(digestCache->getStats().hitCount == 0);
+    SLANG_CHECK(first == recent);
+
+    String second;
+    SLANG_CHECK(SLANG_SUCCEEDED(getIdentity(second)));
+    SLANG_CHECK(digestCache->getStats().hitCount == 1);
+    SLANG_CHECK(first == second);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllText(fileName, "int abc;")));
+
+    String third;
+    SLANG_CHECK(SLANG_SUCCEEDED(getIdentity(third)));
+    SLANG_CHECK(digestCache->getStats().hitCount == 1);
+    SLANG_CHECK(third != first);
+
+    digestCache->clear();
+    digestCache.setNull();
+    File::remove(fileName);
+    Path::remove(Path::combine(cacheDirectory, "lock"));
+    Path::remove(cacheDirectory);
+}
+
+SLANG_UNIT_TEST(fileSystemRiffBlockCompression)
+{
+    // Files bigger than a block are split into frames, which are compressed and decompressed on
+    // a scheduler, and a range can be loaded by only decompressing the frames it overlaps.
+    ComPtr<ISlangJobScheduler> jobScheduler(new JobScheduler(4));
+
+    List<uint8_t> contents;
+    contents.setCount(100000);
+    for (Index i = 0; i < contents.getCount(); ++i)
+    {
+        contents[i] = uint8_t((i * 7) ^ (i >> 5));
+    }
+
+    ICompressionSystem* compressionSystems[] = {
+        DeflateCompressionSystem::getSingleton(),
+        LZ4CompressionSystem::getSingleton()};
+
+    for (auto compressionSystem : compressionSystems)
+    {
+        ComPtr<RiffFileSystem> fileSystem(new RiffFileSystem(compressionSystem));
+        fileSystem->setCompressionBlockSize(4096);
+        fileSystem->setJobScheduler(jobScheduler);
+
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            fileSystem->saveFile("big.bin", contents.getBuffer(), contents.getCount())));
+
+        ComPtr<ISlangBlob> archiveBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(fileSystem->storeArchive(true, archiveBlob.writeRef())));
+
+        ComPtr<RiffFileSystem> loadedFileSystem(new RiffFileSystem(nullptr));
+        loadedFileSystem->setJobScheduler(jobScheduler);
+        SLANG_CHECK(SLANG_SUCCEEDED(loadedFileSystem->loadArchive(
+            archiveBlob->getBufferPointer(),
+            archiveBlob->getBufferSize())));
+        SLANG_CHECK(loadedFileSystem->getCompressionBlockSize() == 4096);
+
+        ComPtr<ISlangBlob> fileBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(loadedFileSystem->loadFile("big.bin", fileBlob.writeRef())));
+        SLANG_CHECK(
+            fileBlob->getBufferSize() == size_t(contents.getCount()) &&
+            ::memcmp(fileBlob->getBufferPointer(), contents.getBuffer(), contents.getCount()) ==
+                0);
+
+        // A range that starts and ends part way through a block
+        const size_t offset = 5000;
+        const size_t size = 20000;
+        ComPtr<ISlangBlob> rangeBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            loadedFileSystem->loadFileRange("big.bin", offset, size, rangeBlob.writeRef())));
+        SLANG_CHECK(
+            rangeBlob->getBufferSize() == size &&
+            ::memcmp(rangeBlob->getBufferPointer(), contents.getBuffer() + offset, size) == 0);
+
+        SLANG_CHECK(SLANG_FAILED(loadedFileSystem->loadFileRange(
+            "big.bin",
+            contents.getCount(),
+            1,
+            rangeBlob.writeRef())));
+    }
+}
+
+SLANG_UNIT_TEST(fileSystemRiffDecompressAll)
+{
+    // A compressed archive can be rewritten uncompressed, so that when it's loaded from a blob
+    // its files reference the blob's memory rather than a decompressed copy.
+    List<uint8_t> contents;
+    contents.setCount(10000);
+    for (Index i = 0; i < contents.getCount(); ++i)
+    {
+        contents[i] = uint8_t(i % 37);
+    }
+
+    ComPtr<RiffFileSystem> fileSystem(new RiffFileSystem(LZ4CompressionSystem::getSingleton()));
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        fileSystem->saveFile("a.bin", contents.getBuffer(), contents.getCount())));
+
+    ComPtr<ISlangBlob> compressedBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(fileSystem->storeArchive(true, compressedBlob.writeRef())));
+
+    ComPtr<RiffFileSystem> compressedFileSystem(new RiffFileSystem(nullptr));
+    SLANG_CHECK(SLANG_SUCCEEDED(compressedFileSystem->loadArchiveBlob(compressedBlob)));
+    SLANG_CHECK(compressedFileSystem->isCompressed());
+    SLANG_CHECK(SLANG_SUCCEEDED(compressedFileSystem->decompressAll()));
+    SLANG_CHECK(!compressedFileSystem->isCompressed());
+
+    ComPtr<ISlangBlob> uncompressedBlob;
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(compressedFileSystem->storeArchive(true, uncompressedBlob.writeRef())));
+
+    ComPtr<RiffFileSystem> loadedFileSystem(new RiffFileSystem(nullptr));
+    SLANG_CHECK(SLANG_SUCCEEDED(loadedFileSystem->loadArchiveBlob(uncompressedBlob)));
+    SLANG_CHECK(!loadedFileSystem->isCompressed());
+
+    ComPtr<ISlangBlob> fileBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(loadedFileSystem->loadFile("a.bin", fileBlob.writeRef())));
+    SLANG_CHECK(
+        fileBlob->getBufferSize() == size_t(contents.getCount()) &&
+        ::memcmp(fileBlob->getBufferPointer(), contents.getBuffer(), contents.getCount()) == 0);
+
+    // The file is read in place from the archive
+    const uint8_t* archiveBegin = (const uint8_t*)uncompressedBlob->getBufferPointer();
+    const uint8_t* archiveEnd = archiveBegin + uncompressedBlob->getBufferSize();
+    const uint8_t* fileData = (const uint8_t*)fileBlob->getBufferPointer();
+    SLANG_CHECK(fileData >= archiveBegin && fileData < archiveEnd);
+}
@@ -0,0 +1,139 @@
+// unit-test-import-prefetch.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+struct SourceFileDesc
+{
+    const char* path;
+    const char* contents;
+};
+
+// An import graph with dotted and quoted names, a module imported from two others, and an
+// import in a comment of a module that doesn't exist.
+static const SourceFileDesc kSourceFiles[] = {
+    {"main.slang",
+     "import a;\n"
+     "import lib.b;\n"
+     "import \"c.slang\";\n"
+     "// import notThere;\n"
+     "public float mainFn() { return aFn() + bFn() + cFn(); }\n"},
+    {"brokenMain.slang",
+     "import a;\n"
+     "import broken;\n"
+     "public float brokenMainFn() { return aFn() + brokenFn(); }\n"},
+    {"a.slang",
+     "import shared;\n"
+     "public float aFn() { return sharedFn(); }\n"},
+    {"lib/b.slang",
+     "import shared;\n"
+     "public float bFn() { int truncated = 1.5; return sharedFn() + truncated; }\n"},
+    {"c.slang", "public float cFn() { return 3.0; }\n"},
+    {"shared.slang", "public float sharedFn() { return 1.0; }\n"},
+    {"broken.slang",
+     "import shared;\n"
+     "public float brokenFn() { return sharedFn() + undefinedThing; }\n"},
+};
+
+/// What loading a module did: the modules the session ended up with, and the diagnostics.
+struct LoadResult
+{
+    List<String> loadedModuleNames;
+    String diagnostics;
+    bool succeeded = false;
+};
+
+} // namespace
+
+static LoadResult _loadModule(
+    slang::IGlobalSession* globalSession,
+    const String& directory,
+    const char* moduleName)
+{
+    const char* searchPath = directory.getBuffer();
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPaths = &searchPath;
+    sessionDesc.searchPathCount = 1;
+
+    LoadResult result;
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return result;
+
+    ComPtr<slang::IBlob> diagnostics;
+    result.succeeded = session->loadModule(moduleName, diagnostics.writeRef()) != nullptr;
+    if (diagnostics)
+        result.diagnostics = (const char*)diagnostics->getBufferPointer();
+    for (SlangInt i = 0; i < session->getLoadedModuleCount(); ++i)
+        result.loadedModuleNames.add(session->getLoadedModule(i)->getName());
+    return result;
+}
+
+// Test that reading the files of an import graph ahead of time, which is done when the job
+// scheduler has more than one thread, loads the same modules with the same diagnostics as
+// reading each file when it is imported.
+//
+SLANG_UNIT_TEST(importPrefetch)
+{
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/import-prefetch-test" +
+        String(Process::getId()));
+    Path::createDirectory(directory);
+    Path::createDirectory(directory + "/lib");
+    for (auto const& file : kSourceFiles)
+    {
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(File::writeAllText(directory + "/" + file.path, file.contents)));
+    }
+
+    // The files are only read ahead of time with more than one thread.
+    SlangGlobalSessionDesc serialDesc = {};
+    serialDesc.jobThreadCount = 1;
+    ComPtr<slang::IGlobalSession> serialGlobalSession;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(slang_createGlobalSession2(&serialDesc, serialGlobalSession.writeRef())));
+
+    SlangGlobalSessionDesc prefetchDesc = {};
+    prefetchDesc.jobThreadCount = 4;
+    ComPtr<slang::IGlobalSession> prefetchGlobalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        slang_createGlobalSession2(&prefetchDesc, prefetchGlobalSession.writeRef())));
+
+    for (auto moduleName : {"main", "brokenMain"})
+    {
+        auto expected = _loadModule(serialGlobalSession, directory, moduleName);
+        auto actual = _loadModule(prefetchGlobalSession, directory, moduleName);
+
+        SLANG_CHECK(actual.succeeded == expected.succeeded);
+        SLANG_CHECK(actual.loadedModuleNames == expected.loadedModuleNames);
+        SLANG_CHECK(actual.diagnostics == expected.diagnostics);
+    }
+
+    // Make sure both graphs were loaded as intended, so the comparison above means something.
+    auto mainResult = _loadModule(prefetchGlobalSession, directory, "main");
+    SLANG_CHECK(mainResult.succeeded);
+    SLANG_CHECK(mainResult.loadedModuleNames.getCount() == 5);
+    auto brokenResult = _loadModule(prefetchGlobalSession, directory, "brokenMain");
+    SLANG_CHECK(!brokenResult.succeeded);
+    SLANG_CHECK(brokenResult.diagnostics.indexOf("undefinedThing") >= 0);
+
+    for (auto const& file : kSourceFiles)
+        File::remove(directory + "/" + file.path);
+    Path::remove(directory + "/lib");
+    Path::remove(directory);
+}
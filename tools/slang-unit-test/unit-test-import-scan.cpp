@@ -0,0 +1,52 @@
+// unit-test-import-scan.cpp
+
+#include "../../source/compiler-core/slang-import-scan-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static bool _scansTo(const char* text, List<String> const& expectedModuleNames)
+{
+    List<String> moduleNames;
+    ImportScanUtil::scanImportedModuleNames(UnownedStringSlice(text), moduleNames);
+    return moduleNames == expectedModuleNames;
+}
+
+SLANG_UNIT_TEST(importScan)
+{
+    SLANG_CHECK(_scansTo("", List<String>()));
+    SLANG_CHECK(_scansTo("import a;", List<String>("a")));
+    SLANG_CHECK(_scansTo("import a; import b;\nimport c;", List<String>("a", "b", "c")));
+
+    // Dotted names stand for directories, with whitespace and comments allowed around the dots.
+    SLANG_CHECK(_scansTo("import a.b.c;", List<String>("a/b/c")));
+    SLANG_CHECK(_scansTo("import a . /* comment */ b ;", List<String>("a/b")));
+
+    // Quoted names are used as they are.
+    SLANG_CHECK(_scansTo("import \"dir/file.slang\";", List<String>("dir/file.slang")));
+    SLANG_CHECK(_scansTo("import \"unterminated;\nimport next;", List<String>("next")));
+
+    // Imports in comments are skipped.
+    SLANG_CHECK(_scansTo(
+        "// import lineComment;\n/* import blockComment;\n */ import real;",
+        List<String>("real")));
+    SLANG_CHECK(_scansTo("/* import unterminated;", List<String>()));
+
+    // Imports in string and character literals are skipped, including past escaped quotes.
+    SLANG_CHECK(_scansTo(
+        "let s = \"import inString; \\\" import stillInString;\"; import afterString;",
+        List<String>("afterString")));
+    SLANG_CHECK(_scansTo("let c = '\\''; import afterChar;", List<String>("afterChar")));
+
+    // Included files belong to the module including them, so they aren't imports.
+    SLANG_CHECK(_scansTo("__include included; import x;", List<String>("x")));
+    SLANG_CHECK(_scansTo("#include \"header.h\"\nimplementing m;", List<String>()));
+
+    // Only whole `import` keywords followed by a name and a `;` count.
+    SLANG_CHECK(_scansTo("myimport a; import_b c; import;", List<String>()));
+    SLANG_CHECK(_scansTo("import missingSemicolon", List<String>()));
+    SLANG_CHECK(_scansTo("import a b;", List<String>()));
+
+    // The preprocessor isn't run, so disabled code is scanned as well.
+    SLANG_CHECK(_scansTo("#if 0\nimport disabled;\n#endif\n", List<String>("disabled")));
+}
@@ -0,0 +1,110 @@
+// unit-test-invalidate-changed-files.cpp
+
+#include "core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static String _getEntryPointCode(slang::IModule* module)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return String();
+    ComPtr<slang::IComponentType> linkedProgram;
+    entryPoint->link(linkedProgram.writeRef());
+    if (!linkedProgram)
+        return String();
+    ComPtr<ISlangBlob> code;
+    linkedProgram->getEntryPointCode(0, 0, code.writeRef());
+    if (!code)
+        return String();
+    return String(
+        UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+// Editing a file only unloads the modules that depend on it. Loading them again picks up the
+// edit, while the other modules are reused.
+SLANG_UNIT_TEST(invalidateChangedFiles)
+{
+    const char* helperSource = R"(
+        module helper;
+        public int getValue() { return 1234; }
+    )";
+    const char* editedHelperSource = R"(
+        module helper;
+        public int getValue() { return 5678; }
+    )";
+    const char* shaderSource = R"(
+        module shader;
+        import helper;
+        RWStructuredBuffer<int> output;
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            output[0] = getValue();
+        }
+    )";
+    const char* otherSource = R"(
+        module other;
+        public int getOtherValue() { return 42; }
+    )";
+
+    ComPtr<ISlangFileSystemExt> fs = ComPtr<ISlangFileSystemExt>(new MemoryFileSystem());
+    auto& memoryFS = *static_cast<MemoryFileSystem*>(fs.get());
+    memoryFS.createDirectory("root");
+    memoryFS.saveFile("root/helper.slang", helperSource, strlen(helperSource));
+    memoryFS.saveFile("root/shader.slang", shaderSource, strlen(shaderSource));
+    memoryFS.saveFile("root/other.slang", otherSource, strlen(otherSource));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_6_0");
+    const char* searchPaths[] = {"root"};
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.fileSystem = fs;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    slang::IModule* shader = session->loadModule("shader");
+    slang::IModule* other = session->loadModule("other");
+    SLANG_CHECK_ABORT(shader && other);
+    SLANG_CHECK(_getEntryPointCode(shader).indexOf(toSlice("1234")) != -1);
+
+    // Nothing depends on a file that was never loaded.
+    const char* unknownPath = "root/unknown.slang";
+    SlangInt unloadedModuleCount = -1;
+    SLANG_CHECK(session->invalidateChangedFiles(&unknownPath, 1, &unloadedModuleCount) == SLANG_OK);
+    SLANG_CHECK(unloadedModuleCount == 0);
+    SLANG_CHECK(session->loadModule("shader") == shader);
+
+    // The helper and the shader importing it are unloaded, the other module isn't.
+    memoryFS.saveFile("root/helper.slang", editedHelperSource, strlen(editedHelperSource));
+    const char* changedPath = "root/helper.slang";
+    SLANG_CHECK(session->invalidateChangedFiles(&changedPath, 1, &unloadedModuleCount) == SLANG_OK);
+    SLANG_CHECK(unloadedModuleCount == 2);
+    SLANG_CHECK(session->getLoadedModuleCount() == 1);
+
+    slang::IModule* reloadedShader = session->loadModule("shader");
+    SLANG_CHECK_ABORT(reloadedShader != nullptr);
+    SLANG_CHECK(reloadedShader != shader);
+    SLANG_CHECK(session->loadModule("other") == other);
+
+    String code = _getEntryPointCode(reloadedShader);
+    SLANG_CHECK(code.indexOf(toSlice("5678")) != -1);
+    SLANG_CHECK(code.indexOf(toSlice("1234")) == -1);
+
+    SLANG_CHECK(session->invalidateChangedFiles(nullptr, 1, nullptr) == SLANG_E_INVALID_ARG);
+}
@@ -0,0 +1,129 @@
+// unit-test-ir-dedup-benchmark.cpp
+
+#include "../../tools/platform/performance-counter.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Measure a compile dominated by the creation of hoistable types and constants.
+//
+// Every instantiation of the generics below creates new vector, array and struct
+// types, so specialization spends most of its time looking up and interning those
+// insts in the IR deduplication context. The measured time is reported as the
+// execution time of this test.
+
+SLANG_UNIT_TEST(irDeduplicationBenchmark)
+{
+    const char* userSourceBody = R"(
+        struct Pair<T, let N : int>
+        {
+            vector<T, 4> values[N];
+            T scale;
+        }
+
+        T accumulate<T : __BuiltinArithmeticType, let N : int>(Pair<T, N> pair)
+        {
+            T result = T(0);
+            [ForceUnroll]
+            for (int i = 0; i < N; i++)
+                result = result + pair.values[i].x * pair.scale + pair.values[i].w;
+            return result;
+        }
+
+        float run<let N : int>(uint seed)
+        {
+            Pair<float, N> a;
+            Pair<int, N> b;
+            Pair<uint, N> c;
+            [ForceUnroll]
+            for (int i = 0; i < N; i++)
+            {
+                a.values[i] = float4(seed + i);
+                b.values[i] = int4(seed - i);
+                c.values[i] = uint4(seed * i);
+            }
+            a.scale = 2.0f;
+            b.scale = 3;
+            c.scale = 4u;
+            return accumulate(a) + float(accumulate(b)) + float(accumulate(c));
+        }
+
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            float result = 0.0f;
+            result += run<1>(tid.x);
+            result += run<2>(tid.x);
+            result += run<3>(tid.x);
+            result += run<4>(tid.x);
+            result += run<5>(tid.x);
+            result += run<6>(tid.x);
+            result += run<7>(tid.x);
+            result += run<8>(tid.x);
+            result += run<9>(tid.x);
+            result += run<10>(tid.x);
+            result += run<11>(tid.x);
+            result += run<12>(tid.x);
+            result += run<13>(tid.x);
+            result += run<14>(tid.x);
+            result += run<15>(tid.x);
+            result += run<16>(tid.x);
+            outputBuffer[tid.x] = result;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_6_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    auto start = platform::PerformanceCounter::now();
+    for (int pass = 0; pass < 10; pass++)
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "m",
+            "m.slang",
+            userSourceBody,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        module->findEntryPointByName("computeMain", entryPoint.writeRef());
+        SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+        slang::IComponentType* componentTypes[] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> composedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(
+            componentTypes,
+            2,
+            composedProgram.writeRef(),
+            diagnosticBlob.writeRef())));
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef())));
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+    }
+    auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+    getTestReporter()->addExecutionTime(time);
+}
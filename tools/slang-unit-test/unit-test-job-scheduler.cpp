@@ -0,0 +1,176 @@
+// unit-test-job-scheduler.cpp
+
+#include "../../source/core/slang-com-object.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+
+using namespace Slang;
+
+namespace
+{
+
+/// A scheduler that runs every job on the calling thread and counts them.
+class CountingJobScheduler : public ComBaseObject, public ISlangJobScheduler
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    SLANG_NO_THROW SlangInt SLANG_MCALL getThreadCount() SLANG_OVERRIDE { return 1; }
+    SLANG_NO_THROW void SLANG_MCALL runJobs(
+        SlangInt jobCount,
+        SlangInt maxConcurrency,
+        SlangJobFunc func,
+        void* userData) SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(maxConcurrency);
+        for (SlangInt ii = 0; ii < jobCount; ++ii)
+            func(userData, ii);
+        m_jobCount += jobCount;
+    }
+    SLANG_NO_THROW void SLANG_MCALL submitJob(SlangJobFunc func, void* userData) SLANG_OVERRIDE
+    {
+        func(userData, 0);
+        m_jobCount++;
+    }
+
+    std::atomic<SlangInt> m_jobCount{0};
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangJobScheduler::getTypeGuid())
+            return static_cast<ISlangJobScheduler*>(this);
+        return nullptr;
+    }
+};
+
+struct NestedJobContext
+{
+    ISlangJobScheduler* scheduler;
+    std::atomic<int> innerJobCount{0};
+};
+
+static void _innerJob(void* userData, SlangInt)
+{
+    ((NestedJobContext*)userData)->innerJobCount++;
+}
+
+static void _outerJob(void* userData, SlangInt)
+{
+    auto context = (NestedJobContext*)userData;
+    context->scheduler->runJobs(8, 0, &_innerJob, context);
+}
+
+} // namespace
+
+// Test that the built-in job scheduler finishes every job, including jobs run from
+// inside other jobs, and that it has the size given in the global session desc.
+//
+SLANG_UNIT_TEST(jobSchedulerBuiltin)
+{
+    SlangGlobalSessionDesc desc = {};
+    desc.jobThreadCount = 4;
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(slang_createGlobalSession2(&desc, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<ISlangJobScheduler> scheduler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->getJobScheduler(scheduler.writeRef())));
+    SLANG_CHECK(scheduler->getThreadCount() == 4);
+
+    NestedJobContext context;
+    context.scheduler = scheduler;
+    scheduler->runJobs(64, 0, &_outerJob, &context);
+    SLANG_CHECK(context.innerJobCount == 64 * 8);
+
+    context.innerJobCount = 0;
+    scheduler->runJobs(64, 2, &_outerJob, &context);
+    SLANG_CHECK(context.innerJobCount == 64 * 8);
+}
+
+// Test that the compiler runs its parallel work on a scheduler set by the application.
+//
+SLANG_UNIT_TEST(jobSchedulerReplaced)
+{
+    static constexpr int kPermutationCount = 3;
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    auto countingScheduler = new CountingJobScheduler();
+    ComPtr<ISlangJobScheduler> countingSchedulerRef(countingScheduler);
+    globalSession->setJobScheduler(countingScheduler);
+
+    ComPtr<ISlangJobScheduler> scheduler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->getJobScheduler(scheduler.writeRef())));
+    SLANG_CHECK(scheduler == countingSchedulerRef);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain<int x>(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = x;
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType2> entryPoint2;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(entryPoint->queryInterface(
+        slang::IComponentType2::getTypeGuid(),
+        (void**)entryPoint2.writeRef())));
+
+    slang::SpecializationArg args[] = {
+        slang::SpecializationArg::fromExpr("1"),
+        slang::SpecializationArg::fromExpr("2"),
+        slang::SpecializationArg::fromExpr("3")};
+    slang::IBlob* codes[kPermutationCount] = {};
+    SLANG_CHECK(SLANG_SUCCEEDED(entryPoint2->compileEntryPointPermutations(
+        0,
+        0,
+        args,
+        1,
+        kPermutationCount,
+        codes,
+        diagnostics.writeRef())));
+    for (auto code : codes)
+    {
+        SLANG_CHECK(code != nullptr);
+        if (code)
+            code->release();
+    }
+
+    SLANG_CHECK(countingScheduler->m_jobCount == kPermutationCount);
+
+    // Remove the scheduler again, so that the global session goes back to the built-in one.
+    globalSession->setJobScheduler(nullptr);
+    scheduler.setNull();
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->getJobScheduler(scheduler.writeRef())));
+    SLANG_CHECK(scheduler != countingSchedulerRef);
+}
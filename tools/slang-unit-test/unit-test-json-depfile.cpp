@@ -0,0 +1,211 @@
+// unit-test-json-depfile.cpp
+
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../source/core/slang-crypto.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char* kMainSource = R"(
+    import helper;
+    #include "defs.h"
+
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = scale(tid.x) + OFFSET;
+    }
+    )";
+
+static const char* kHelperSource = R"(
+    module helper;
+
+    public float scale(uint x) { return x * 2.0f; }
+    )";
+
+static const char* kDefsSource = "#define OFFSET 1.0f\n";
+static const char* kEditedDefsSource = "#define OFFSET 2.0f\n";
+
+namespace
+{
+
+/// The dependency file written by a compile, parsed.
+struct DependencyFile
+{
+    DependencyFile()
+    {
+        sourceManager.initialize(nullptr, nullptr);
+        container = new JSONContainer(&sourceManager);
+    }
+
+    SlangResult read(const String& path)
+    {
+        SLANG_RETURN_ON_FAIL(File::readAllText(path, contents));
+
+        DiagnosticSink sink(&sourceManager, nullptr);
+        SourceFile* sourceFile =
+            sourceManager.createSourceFileWithString(PathInfo::makeFromString(path), contents);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+        JSONLexer lexer;
+        lexer.init(sourceView, &sink);
+        JSONBuilder builder(container);
+        JSONParser parser;
+        SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+        root = builder.getRootValue();
+        return root.getKind() == JSONValue::Kind::Object ? SLANG_OK : SLANG_FAIL;
+    }
+
+    JSONValue getField(const JSONValue& object, const char* name)
+    {
+        return container->findObjectValue(object, container->getKey(UnownedStringSlice(name)));
+    }
+
+    UnownedStringSlice getStringField(const JSONValue& object, const char* name)
+    {
+        auto value = getField(object, name);
+        return value.getKind() == JSONValue::Kind::String ? container->getString(value)
+                                                          : UnownedStringSlice();
+    }
+
+    /// Find the element of the array `arrayName` whose `keyName` field ends with `suffix`.
+    JSONValue findElement(const char* arrayName, const char* keyName, const char* suffix)
+    {
+        auto array = getField(root, arrayName);
+        if (array.getKind() != JSONValue::Kind::Array)
+            return JSONValue();
+        for (auto element : container->getArray(array))
+        {
+            if (getStringField(element, keyName).endsWith(UnownedStringSlice(suffix)))
+                return element;
+        }
+        return JSONValue();
+    }
+
+    String getDigest(const char* arrayName, const char* keyName, const char* suffix)
+    {
+        auto element = findElement(arrayName, keyName, suffix);
+        return element.isValid() ? String(getStringField(element, "digest")) : String();
+    }
+
+    SourceManager sourceManager;
+    RefPtr<JSONContainer> container;
+    String contents;
+    JSONValue root;
+};
+
+} // namespace
+
+static bool _isSHA1String(UnownedStringSlice text)
+{
+    if (text.getLength() != 40)
+        return false;
+    for (auto c : text)
+    {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+            return false;
+    }
+    return true;
+}
+
+static String _computeSHA1String(const char* text)
+{
+    return SHA1::compute(text, SlangInt(strlen(text))).toString();
+}
+
+// Test the JSON form of `-depfile`: the outputs, the digest of the options, and the digests
+// of every file and module the compile depended on, including imported and included ones.
+//
+SLANG_UNIT_TEST(jsonDependencyFile)
+{
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/json-depfile-test" +
+        String(Process::getId()));
+    Path::createDirectory(directory);
+
+    const String mainPath = directory + "/main.slang";
+    const String helperPath = directory + "/helper.slang";
+    const String defsPath = directory + "/defs.h";
+    const String outputPath = directory + "/main.hlsl";
+    const String depfilePath = directory + "/main.json";
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(mainPath, kMainSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(helperPath, kHelperSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(defsPath, kDefsSource)));
+
+    CommandLine cmdLine;
+    cmdLine.setExecutableLocation(
+        ExecutableLocation(unitTestContext->executableDirectory, "slangc"));
+    cmdLine.addArg(mainPath);
+    for (auto arg : {"-target", "hlsl", "-entry", "computeMain", "-I"})
+        cmdLine.addArg(arg);
+    cmdLine.addArg(directory);
+    cmdLine.addArg("-o");
+    cmdLine.addArg(outputPath);
+    cmdLine.addArg("-depfile");
+    cmdLine.addArg(depfilePath);
+
+    ExecuteResult exeRes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(ProcessUtil::execute(cmdLine, exeRes)));
+    SLANG_CHECK_ABORT(exeRes.resultCode == 0);
+
+    DependencyFile depfile;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(depfile.read(depfilePath)));
+
+    // The outputs.
+    {
+        auto outputs = depfile.getField(depfile.root, "outputs");
+        SLANG_CHECK_ABORT(outputs.getKind() == JSONValue::Kind::Array);
+        auto outputArray = depfile.container->getArray(outputs);
+        SLANG_CHECK(outputArray.getCount() == 1);
+        if (outputArray.getCount() == 1)
+        {
+            SLANG_CHECK(depfile.container->getString(outputArray[0]).endsWith(
+                toSlice("main.hlsl")));
+        }
+    }
+
+    const String optionsDigest = depfile.getStringField(depfile.root, "options");
+    SLANG_CHECK(_isSHA1String(optionsDigest.getUnownedSlice()));
+
+    // Every file the compile read, with the digest of its content: the main file, the
+    // imported module and the included header.
+    SLANG_CHECK(
+        depfile.getDigest("files", "path", "main.slang") == _computeSHA1String(kMainSource));
+    SLANG_CHECK(
+        depfile.getDigest("files", "path", "helper.slang") == _computeSHA1String(kHelperSource));
+    SLANG_CHECK(depfile.getDigest("files", "path", "defs.h") == _computeSHA1String(kDefsSource));
+
+    // Every module the program depends on.
+    const String mainDigest = depfile.getDigest("modules", "name", "main");
+    const String helperDigest = depfile.getDigest("modules", "name", "helper");
+    SLANG_CHECK(_isSHA1String(mainDigest.getUnownedSlice()));
+    SLANG_CHECK(_isSHA1String(helperDigest.getUnownedSlice()));
+
+    // Editing the included header changes the digest of the module including it, and only
+    // that module.
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(defsPath, kEditedDefsSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(ProcessUtil::execute(cmdLine, exeRes)));
+    SLANG_CHECK_ABORT(exeRes.resultCode == 0);
+
+    DependencyFile editedDepfile;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(editedDepfile.read(depfilePath)));
+    const String editedOptionsDigest = editedDepfile.getStringField(editedDepfile.root, "options");
+    SLANG_CHECK(editedOptionsDigest == optionsDigest);
+    SLANG_CHECK(
+        editedDepfile.getDigest("files", "path", "defs.h") ==
+        _computeSHA1String(kEditedDefsSource));
+    SLANG_CHECK(editedDepfile.getDigest("modules", "name", "main") != mainDigest);
+    SLANG_CHECK(editedDepfile.getDigest("modules", "name", "helper") == helperDigest);
+
+    for (auto path : {mainPath, helperPath, defsPath, outputPath, depfilePath})
+        File::remove(path);
+    Path::remove(directory);
+}
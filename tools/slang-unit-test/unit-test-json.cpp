@@ -367,3 +367,54 @@ SLANG_UNIT_TEST(json)
         SLANG_CHECK(values[5].asBool() == true);
     }
 }
+
+SLANG_UNIT_TEST(jsonLongStrings)
+{
+    SLANG_UNUSED(unitTestContext);
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+
+    // String literals are scanned eight bytes at a time. An escaped quote or backslash must be
+    // found wherever it falls in a word, and a string must end at its closing quote even if
+    // that is near the end of the content.
+    for (Index position = 0; position < 20; ++position)
+    {
+        for (const char* escape : {"\\\"", "\\\\", "\\u00e9"})
+        {
+            StringBuilder literal;
+            literal << "\"";
+            for (Index i = 0; i < position; ++i)
+                literal << char('a' + i);
+            literal << escape << "some more text after the escape\"";
+
+            StringBuilder text;
+            text << "[" << literal << ", 1]";
+
+            const Element eles[] = {
+                {JSONTokenType::LBracket, "["},
+                {JSONTokenType::StringLiteral, literal.getBuffer()},
+                {JSONTokenType::Comma, ","},
+                {JSONTokenType::IntegerLiteral, "1"},
+                {JSONTokenType::RBracket, "]"},
+                {JSONTokenType::EndOfFile, ""},
+            };
+
+            List<JSONToken> toks;
+            SLANG_CHECK(SLANG_SUCCEEDED(_lex(text.getBuffer(), &sink, toks)));
+            SLANG_CHECK(_areEqual(&sourceManager, toks, eles, SLANG_COUNT_OF(eles)));
+        }
+
+        // An unterminated string is still an error.
+        StringBuilder text;
+        text << "\"";
+        for (Index i = 0; i < position; ++i)
+            text << char('a' + i);
+
+        DiagnosticSink errorSink(&sourceManager, nullptr);
+        List<JSONToken> toks;
+        SLANG_CHECK(SLANG_FAILED(_lex(text.getBuffer(), &errorSink, toks)));
+        SLANG_CHECK(toks.getLast().type == JSONTokenType::Invalid);
+    }
+}
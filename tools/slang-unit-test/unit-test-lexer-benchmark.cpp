@@ -0,0 +1,88 @@
+// unit-test-lexer-benchmark.cpp
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../tools/platform/performance-counter.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+static TokenList _lexSemanticTokens(SourceManager* sourceManager, NamePool* namePool, String text)
+{
+    SourceFile* sourceFile =
+        sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), text);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    DiagnosticSink sink(sourceManager, nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, sourceManager->getMemoryArena());
+    return lexer.lexAllSemanticTokens();
+}
+
+} // namespace
+
+// Test that the parts of comments, whitespace and identifiers the lexer skips over in bulk
+// still give the same tokens around escaped newlines and non-ASCII characters.
+//
+SLANG_UNIT_TEST(lexerBulkScanning)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    NamePool namePool;
+
+    const char text[] = "a/* x \\\n * / **/b // c \\\n d\n"
+                        "\t        c\xC3\xA9  ident_1x\\\nyz /* \xE2\x82\xAC */ e // \xC3\xA9";
+    const char* const expected[] = {"a", "b", "c\xC3\xA9", "ident_1xyz", "e"};
+
+    TokenList tokens = _lexSemanticTokens(&sourceManager, &namePool, text);
+    SLANG_CHECK_ABORT(tokens.m_tokens.getCount() == Index(SLANG_COUNT_OF(expected)) + 1);
+    for (Index i = 0; i < Index(SLANG_COUNT_OF(expected)); i++)
+    {
+        SLANG_CHECK(tokens.m_tokens[i].type == TokenType::Identifier);
+        SLANG_CHECK(tokens.m_tokens[i].getContent() == UnownedStringSlice(expected[i]));
+    }
+    SLANG_CHECK(tokens.m_tokens.getLast().type == TokenType::EndOfFile);
+}
+
+// Measure lexing a large source made mostly of comments, indentation and identifiers.
+//
+// The measured time is reported as the execution time of this test.
+//
+SLANG_UNIT_TEST(lexerBenchmark)
+{
+    const char chunk[] =
+        "/* A block comment that goes on for a while, as the documentation of generated code\n"
+        " * tends to do, with the odd * and / in it but no end until here. */\n"
+        "// A line comment, followed by some declarations that are indented.\n"
+        "float4 someGeneratedFunctionName(float4 position, float4 vertexColor)\n"
+        "{\n"
+        "        float4 scaledPosition = position * vertexColor;\n"
+        "        return scaledPosition + float4(1.0, 2.0, 3.0, 4.0);\n"
+        "}\n";
+    static const Index kChunkCount = 20000;
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    NamePool namePool;
+
+    const Index tokensPerChunk =
+        _lexSemanticTokens(&sourceManager, &namePool, chunk).m_tokens.getCount() - 1;
+
+    StringBuilder text;
+    for (Index i = 0; i < kChunkCount; i++)
+        text << chunk;
+    String source = text.produceString();
+
+    auto start = platform::PerformanceCounter::now();
+    TokenList tokens = _lexSemanticTokens(&sourceManager, &namePool, source);
+    auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+
+    SLANG_CHECK(tokens.m_tokens.getCount() == kChunkCount * tokensPerChunk + 1);
+    getTestReporter()->addExecutionTime(time);
+}
@@ -0,0 +1,73 @@
+// unit-test-memory-usage.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a session reports the memory held by the modules it loads, and that the global
+// session's totals include it.
+//
+SLANG_UNIT_TEST(memoryUsage)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    SlangMemoryUsage before = {};
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->getMemoryUsage(&before)));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        struct Params
+        {
+            float4 color;
+            float scale;
+        }
+
+        ConstantBuffer<Params> params;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = params.color * params.scale;
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    SlangMemoryUsage after = {};
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->getMemoryUsage(&after)));
+    SLANG_CHECK(after.astBytes > 0);
+    SLANG_CHECK(after.astBytes >= before.astBytes);
+    SLANG_CHECK(after.irBytes > before.irBytes);
+    SLANG_CHECK(after.cachedBlobBytes == 0);
+    SLANG_CHECK(after.otherBytes == 0);
+
+    // The global session counts the arenas of every session, this one included.
+    SlangMemoryUsage total = {};
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->getMemoryUsage(&total)));
+    SLANG_CHECK(total.astBytes >= after.astBytes);
+    SLANG_CHECK(total.irBytes >= after.irBytes);
+    SLANG_CHECK(total.stringPoolBytes >= after.stringPoolBytes);
+
+    SLANG_CHECK(session->getMemoryUsage(nullptr) == SLANG_E_INVALID_ARG);
+    SLANG_CHECK(globalSession->getMemoryUsage(nullptr) == SLANG_E_INVALID_ARG);
+}
@@ -0,0 +1,254 @@
+// unit-test-microbenchmark.cpp
+
+#include "../../source/core/slang-chunked-list.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-free-list.h"
+#include "../../source/core/slang-math.h"
+#include "../../source/core/slang-memory-arena.h"
+#include "../../source/core/slang-offset-container.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+using namespace Slang;
+
+// Microbenchmarks for the core containers.
+//
+// Each benchmark is warmed up, then run a set number of times with a fixed operation count.
+// The min, median, mean, standard deviation and p90 time per operation are reported as an
+// info message, and the total measured time as the execution time of the test.
+//
+// The IR is not exported from the compiler library, so IR primitives are measured through
+// compiles instead, see `unit-test-ir-dedup-benchmark.cpp` and
+// `unit-test-compile-benchmark.cpp`.
+
+namespace
+{
+
+static const Index kWarmupCount = 3;
+static const Index kRepetitionCount = 25;
+static const Index kOperationCount = 10000;
+
+/// One measured run of a benchmark.
+///
+/// A benchmark does its setup, then brackets the operations being measured with
+/// `startTiming` and `stopTiming`, so that setup and teardown are not counted.
+class MicrobenchmarkRun
+{
+public:
+    Index getOperationCount() const { return kOperationCount; }
+
+    void startTiming() { m_startTime = std::chrono::high_resolution_clock::now(); }
+    void stopTiming() { m_elapsed += std::chrono::high_resolution_clock::now() - m_startTime; }
+
+    /// Keep a result of the measured operations alive, so the compiler cannot remove them.
+    void consume(uint64_t value) { m_consumed = m_consumed + value; }
+
+    std::chrono::nanoseconds getElapsed() const { return m_elapsed; }
+
+private:
+    std::chrono::high_resolution_clock::time_point m_startTime;
+    std::chrono::nanoseconds m_elapsed = std::chrono::nanoseconds::zero();
+    volatile uint64_t m_consumed = 0;
+};
+
+struct Microbenchmark
+{
+    const char* name;
+    void (*run)(MicrobenchmarkRun& run);
+};
+
+struct MicrobenchmarkResult
+{
+    double minNanoseconds;
+    double medianNanoseconds;
+    double meanNanoseconds;
+    double standardDeviationNanoseconds;
+    double p90Nanoseconds;
+};
+
+} // namespace
+
+static void _benchmarkListAdd(MicrobenchmarkRun& run)
+{
+    List<Index> list;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        list.add(i);
+    run.stopTiming();
+    run.consume(list.getCount());
+}
+
+static void _benchmarkDictionaryAdd(MicrobenchmarkRun& run)
+{
+    Dictionary<Index, Index> dictionary;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        dictionary.add(i * 7919, i);
+    run.stopTiming();
+    run.consume(dictionary.getCount());
+}
+
+static void _benchmarkDictionaryLookup(MicrobenchmarkRun& run)
+{
+    Dictionary<Index, Index> dictionary;
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        dictionary.add(i * 7919, i);
+
+    // Look up keys that are present and keys that are not, in equal measure.
+    uint64_t found = 0;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+    {
+        if (dictionary.tryGetValue(i * 7919 + (i & 1)))
+            found++;
+    }
+    run.stopTiming();
+    run.consume(found);
+}
+
+static void _benchmarkMemoryArenaAllocate(MicrobenchmarkRun& run)
+{
+    MemoryArena arena(4096);
+    uint64_t total = 0;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        total += uint64_t((size_t)arena.allocate(16 + (i & 31)) & 0xff);
+    run.stopTiming();
+    run.consume(total);
+}
+
+static void _benchmarkChunkedListAdd(MicrobenchmarkRun& run)
+{
+    ChunkedList<Index> list;
+    uint64_t total = 0;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        total += uint64_t(*list.add(i));
+    run.stopTiming();
+    run.consume(total);
+}
+
+static void _benchmarkFreeListAllocateDeallocate(MicrobenchmarkRun& run)
+{
+    FreeList freeList(sizeof(void*) * 4, alignof(void*), 1024);
+    List<void*> allocations;
+    allocations.setCount(run.getOperationCount());
+
+    run.startTiming();
+    for (auto& allocation : allocations)
+        allocation = freeList.allocate();
+    for (auto allocation : allocations)
+        freeList.deallocate(allocation);
+    run.stopTiming();
+    run.consume(allocations.getCount());
+}
+
+static void _benchmarkOffsetContainerAllocate(MicrobenchmarkRun& run)
+{
+    OffsetContainer container;
+    uint64_t total = 0;
+    run.startTiming();
+    for (Index i = 0; i < run.getOperationCount(); ++i)
+        total += uint64_t((size_t)container.allocate(16, 8) & 0xff);
+    run.stopTiming();
+    run.consume(total);
+}
+
+static const Microbenchmark kMicrobenchmarks[] = {
+    {"list-add", _benchmarkListAdd},
+    {"dictionary-add", _benchmarkDictionaryAdd},
+    {"dictionary-lookup", _benchmarkDictionaryLookup},
+    {"memory-arena-allocate", _benchmarkMemoryArenaAllocate},
+    {"chunked-list-add", _benchmarkChunkedListAdd},
+    {"free-list-allocate-deallocate", _benchmarkFreeListAllocateDeallocate},
+    {"offset-container-allocate", _benchmarkOffsetContainerAllocate},
+};
+
+static MicrobenchmarkResult _summarize(List<double>& nanosecondsPerOperation)
+{
+    nanosecondsPerOperation.sort();
+    const Index count = nanosecondsPerOperation.getCount();
+
+    double total = 0;
+    for (auto value : nanosecondsPerOperation)
+        total += value;
+    const double mean = total / double(count);
+
+    double squaredDeviations = 0;
+    for (auto value : nanosecondsPerOperation)
+        squaredDeviations += (value - mean) * (value - mean);
+
+    // Nearest rank percentiles.
+    auto percentile = [&](Index percent)
+    {
+        const Index rank = Math::Clamp((percent * count + 99) / 100, Index(1), count);
+        return nanosecondsPerOperation[rank - 1];
+    };
+
+    MicrobenchmarkResult result;
+    result.minNanoseconds = nanosecondsPerOperation[0];
+    result.medianNanoseconds = percentile(50);
+    result.meanNanoseconds = mean;
+    result.standardDeviationNanoseconds =
+        count > 1 ? sqrt(squaredDeviations / double(count - 1)) : 0.0;
+    result.p90Nanoseconds = percentile(90);
+    return result;
+}
+
+SLANG_UNIT_TEST(coreContainerMicrobenchmarks)
+{
+    char line[256];
+    snprintf(
+        line,
+        sizeof(line),
+        "%-32s %10s %12s %10s %12s %9s\n",
+        "benchmark (ns per operation)",
+        "min",
+        "median",
+        "mean",
+        "stddev",
+        "p90");
+    StringBuilder table;
+    table << line;
+
+    std::chrono::nanoseconds totalElapsed = std::chrono::nanoseconds::zero();
+    for (auto& benchmark : kMicrobenchmarks)
+    {
+        for (Index i = 0; i < kWarmupCount; ++i)
+        {
+            MicrobenchmarkRun run;
+            benchmark.run(run);
+        }
+
+        List<double> nanosecondsPerOperation;
+        for (Index i = 0; i < kRepetitionCount; ++i)
+        {
+            MicrobenchmarkRun run;
+            benchmark.run(run);
+            totalElapsed += run.getElapsed();
+            nanosecondsPerOperation.add(double(run.getElapsed().count()) / double(kOperationCount));
+        }
+
+        auto result = _summarize(nanosecondsPerOperation);
+        SLANG_CHECK(result.minNanoseconds <= result.medianNanoseconds);
+        SLANG_CHECK(result.medianNanoseconds <= result.p90Nanoseconds);
+
+        snprintf(
+            line,
+            sizeof(line),
+            "%-32s %10.3f %12.3f %10.3f %12.3f %9.3f\n",
+            benchmark.name,
+            result.minNanoseconds,
+            result.medianNanoseconds,
+            result.meanNanoseconds,
+            result.standardDeviationNanoseconds,
+            result.p90Nanoseconds);
+        table << line;
+    }
+
+    getTestReporter()->message(TestMessageType::Info, table.getBuffer());
+    getTestReporter()->addExecutionTime(std::chrono::duration<double>(totalElapsed).count());
+}
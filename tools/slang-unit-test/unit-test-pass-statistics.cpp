@@ -0,0 +1,99 @@
+// unit-test-pass-statistics.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `-report-pass-stats` records one statistics entry for each IR pass, adding up
+// its invocations, that the entries are available through `ISlangPassProfiler`, and that
+// they are written to the requested path as JSON.
+//
+SLANG_UNIT_TEST(passStatistics)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String reportPath = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/pass-statistics-test" +
+        String(Process::getId()) + ".json");
+
+    const char* source = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = tid.x * 2.0f;
+        }
+        )";
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_ALLOW_DEPRECATED_BEGIN
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileRequest(request.writeRef())));
+    SLANG_ALLOW_DEPRECATED_END
+
+    const char* args[] = {"-report-pass-stats", reportPath.getBuffer()};
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+    request->addCodeGenTarget(SLANG_HLSL);
+    const int translationUnitIndex =
+        request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "m.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+    ComPtr<ISlangProfiler> profiler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->getCompileTimeProfile(profiler.writeRef(), true)));
+
+    ComPtr<ISlangPassProfiler> passProfiler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(profiler->queryInterface(
+        ISlangPassProfiler::getTypeGuid(),
+        (void**)passProfiler.writeRef())));
+
+    const auto passCount = passProfiler->getPassCount();
+    SLANG_CHECK(passCount != 0);
+
+    uint64_t totalInstsCreated = 0;
+    uint64_t totalInvocationCount = 0;
+    for (uint32_t ii = 0; ii < passCount; ++ii)
+    {
+        SlangPassStatistics statistics = {};
+        SLANG_CHECK(SLANG_SUCCEEDED(passProfiler->getPassStatistics(ii, &statistics)));
+        SLANG_CHECK(statistics.passName != nullptr);
+        SLANG_CHECK(statistics.invocationCount != 0);
+        totalInstsCreated += statistics.instsCreated;
+        totalInvocationCount += statistics.invocationCount;
+
+        // Each pass has a single entry.
+        for (uint32_t jj = 0; jj < ii; ++jj)
+        {
+            SlangPassStatistics earlier = {};
+            passProfiler->getPassStatistics(jj, &earlier);
+            SLANG_CHECK(
+                UnownedStringSlice(earlier.passName) != UnownedStringSlice(statistics.passName));
+        }
+    }
+    SLANG_CHECK(totalInstsCreated != 0);
+    // Some passes, such as simplification, run more than once.
+    SLANG_CHECK(totalInvocationCount > passCount);
+
+    SlangPassStatistics outOfRange = {};
+    SLANG_CHECK(
+        passProfiler->getPassStatistics(uint32_t(passCount), &outOfRange) == SLANG_E_INVALID_ARG);
+
+    String report;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllText(reportPath, report)));
+    File::remove(reportPath);
+
+    SLANG_CHECK(report.getUnownedSlice().indexOf(toSlice("\"passes\"")) != -1);
+    SLANG_CHECK(report.getUnownedSlice().indexOf(toSlice("\"instsCreated\"")) != -1);
+    SLANG_CHECK(report.getUnownedSlice().indexOf(toSlice("\"invocations\"")) != -1);
+}
@@ -0,0 +1,112 @@
+// unit-test-phase-profiler.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that `-report-perf-benchmark` records the time spent in each phase of compilation,
+// tagged by module, and that the phases are available through `ISlangPhaseProfiler` with
+// code generation phases nested in "emit".
+//
+SLANG_UNIT_TEST(phaseProfiler)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const char* source = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = tid.x * 2.0f;
+        }
+        )";
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_ALLOW_DEPRECATED_BEGIN
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileRequest(request.writeRef())));
+    SLANG_ALLOW_DEPRECATED_END
+
+    const char* args[] = {"-report-perf-benchmark"};
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+    request->addCodeGenTarget(SLANG_HLSL);
+    const int translationUnitIndex =
+        request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "phaseTest");
+    request->addTranslationUnitSourceString(translationUnitIndex, "phaseTest.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+    ComPtr<ISlangProfiler> profiler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->getCompileTimeProfile(profiler.writeRef(), true)));
+
+    ComPtr<ISlangPhaseProfiler> phaseProfiler;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(profiler->queryInterface(
+        ISlangPhaseProfiler::getTypeGuid(),
+        (void**)phaseProfiler.writeRef())));
+
+    const auto phaseCount = phaseProfiler->getPhaseInvocationCount();
+    SLANG_CHECK_ABORT(phaseCount != 0);
+
+    auto findPhase = [&](const char* phaseName, const char* moduleName) -> Index
+    {
+        for (uint32_t ii = 0; ii < phaseCount; ++ii)
+        {
+            SlangPhaseStatistics statistics = {};
+            phaseProfiler->getPhaseInvocation(ii, &statistics);
+            if (strcmp(statistics.phaseName, phaseName) == 0 &&
+                strcmp(statistics.moduleName, moduleName) == 0)
+                return Index(ii);
+        }
+        return -1;
+    };
+
+    for (uint32_t ii = 0; ii < phaseCount; ++ii)
+    {
+        SlangPhaseStatistics statistics = {};
+        SLANG_CHECK(SLANG_SUCCEEDED(phaseProfiler->getPhaseInvocation(ii, &statistics)));
+        SLANG_CHECK(statistics.phaseName != nullptr);
+        SLANG_CHECK(statistics.moduleName != nullptr);
+        SLANG_CHECK(statistics.selfDurationMicroseconds <= statistics.durationMicroseconds);
+    }
+
+    // The front end phases are tagged with the module.
+    const Index parseIndex = findPhase("parse", "phaseTest");
+    const Index checkIndex = findPhase("check", "phaseTest");
+    const Index lowerIndex = findPhase("lower", "phaseTest");
+    SLANG_CHECK(findPhase("preprocess", "phaseTest") >= 0);
+    SLANG_CHECK(parseIndex >= 0);
+    SLANG_CHECK(checkIndex > parseIndex);
+    SLANG_CHECK(lowerIndex > checkIndex);
+
+    // Code generation is tagged with the entry point, and nests linking in optimization
+    // in emission.
+    const Index emitIndex = findPhase("emit", "computeMain");
+    const Index optimizeIndex = findPhase("optimize", "computeMain");
+    const Index linkIndex = findPhase("link", "computeMain");
+    SLANG_CHECK_ABORT(emitIndex >= 0 && optimizeIndex > emitIndex && linkIndex > optimizeIndex);
+
+    SlangPhaseStatistics emit = {};
+    SlangPhaseStatistics optimize = {};
+    SlangPhaseStatistics link = {};
+    phaseProfiler->getPhaseInvocation(uint32_t(emitIndex), &emit);
+    phaseProfiler->getPhaseInvocation(uint32_t(optimizeIndex), &optimize);
+    phaseProfiler->getPhaseInvocation(uint32_t(linkIndex), &link);
+    SLANG_CHECK(optimize.depth == emit.depth + 1);
+    SLANG_CHECK(link.depth == optimize.depth + 1);
+    SLANG_CHECK(optimize.durationMicroseconds <= emit.durationMicroseconds);
+    SLANG_CHECK(link.durationMicroseconds <= optimize.durationMicroseconds);
+
+    SlangPhaseStatistics outOfRange = {};
+    SLANG_CHECK(phaseProfiler->getPhaseInvocation(uint32_t(phaseCount), &outOfRange) ==
+                SLANG_E_INVALID_ARG);
+}
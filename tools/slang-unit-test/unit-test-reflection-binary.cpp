@@ -0,0 +1,147 @@
+// unit-test-reflection-binary.cpp
+
+#include "slang-com-ptr.h"
+#include "slang-reflection-binary.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that binary reflection can be read back with the C reader, and matches the reflection
+// API.
+//
+SLANG_UNIT_TEST(reflectionBinary)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        struct Params
+        {
+            float4 color;
+            float scale;
+        }
+
+        ConstantBuffer<Params> params;
+        Texture2D textures[4];
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = params.color * params.scale + textures[1].Load(int3(0));
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    auto layout = linked->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBinary(blob.writeRef())));
+
+    SlangReflectionBinary reflection;
+    SLANG_CHECK_ABORT(
+        slangReflectionBinaryOpen(blob->getBufferPointer(), blob->getBufferSize(), &reflection));
+
+    auto getString = [&](uint32_t offset)
+    { return slangReflectionBinaryGetString(&reflection, offset); };
+
+    auto header = slangReflectionBinaryGetHeader(&reflection);
+    SLANG_CHECK_ABORT(header->parameterCount == layout->getParameterCount());
+
+    for (uint32_t i = 0; i < header->parameterCount; ++i)
+    {
+        auto expected = layout->getParameterByIndex(i);
+        auto param = slangReflectionBinaryGetParameter(&reflection, i);
+        SLANG_CHECK_ABORT(param != nullptr);
+        SLANG_CHECK(strcmp(getString(param->name), expected->getName()) == 0);
+
+        SLANG_CHECK_ABORT(param->bindingCount == expected->getCategoryCount());
+        for (uint32_t j = 0; j < param->bindingCount; ++j)
+        {
+            auto category = SlangParameterCategory(expected->getCategoryByIndex(j));
+            auto binding = slangReflectionBinaryGetBinding(&reflection, param, j);
+            SLANG_CHECK_ABORT(binding != nullptr);
+            SLANG_CHECK(binding->category == uint32_t(category));
+            SLANG_CHECK(binding->index == uint32_t(expected->getOffset(category)));
+            SLANG_CHECK(binding->space == uint32_t(expected->getBindingSpace(category)));
+        }
+    }
+
+    // The constant buffer's element is the struct, with its fields.
+    auto paramsTypeLayout = slangReflectionBinaryGetTypeLayout(
+        &reflection,
+        slangReflectionBinaryGetParameter(&reflection, 0)->typeLayout);
+    SLANG_CHECK_ABORT(paramsTypeLayout != nullptr);
+    SLANG_CHECK(paramsTypeLayout->kind == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+
+    auto structTypeLayout =
+        slangReflectionBinaryGetTypeLayout(&reflection, paramsTypeLayout->elementTypeLayout);
+    SLANG_CHECK_ABORT(structTypeLayout != nullptr);
+    SLANG_CHECK(structTypeLayout->kind == SLANG_TYPE_KIND_STRUCT);
+    SLANG_CHECK(structTypeLayout->fieldCount == 2);
+    SLANG_CHECK(
+        slangReflectionBinaryGetTypeSize(
+            &reflection,
+            structTypeLayout,
+            SLANG_PARAMETER_CATEGORY_UNIFORM) == 20);
+
+    auto scaleField = slangReflectionBinaryGetField(&reflection, structTypeLayout, 1);
+    SLANG_CHECK_ABORT(scaleField != nullptr);
+    SLANG_CHECK(strcmp(getString(scaleField->name), "scale") == 0);
+    SLANG_CHECK(slangReflectionBinaryGetBinding(&reflection, scaleField, 0)->index == 16);
+    SLANG_CHECK(slangReflectionBinaryGetField(&reflection, structTypeLayout, 2) == nullptr);
+
+    // The texture array keeps its element count.
+    auto texturesTypeLayout = slangReflectionBinaryGetTypeLayout(
+        &reflection,
+        slangReflectionBinaryGetParameter(&reflection, 1)->typeLayout);
+    SLANG_CHECK_ABORT(texturesTypeLayout != nullptr);
+    SLANG_CHECK(texturesTypeLayout->kind == SLANG_TYPE_KIND_ARRAY);
+    SLANG_CHECK(texturesTypeLayout->elementCount == 4);
+
+    SLANG_CHECK_ABORT(header->entryPointCount == 1);
+    auto entryPointRecord = slangReflectionBinaryGetEntryPoint(&reflection, 0);
+    SLANG_CHECK_ABORT(entryPointRecord != nullptr);
+    SLANG_CHECK(strcmp(getString(entryPointRecord->name), "computeMain") == 0);
+    SLANG_CHECK(entryPointRecord->stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(entryPointRecord->threadGroupSize[0] == 8);
+    SLANG_CHECK(entryPointRecord->threadGroupSize[1] == 4);
+    SLANG_CHECK(entryPointRecord->threadGroupSize[2] == 1);
+
+    // Data that isn't binary reflection, or is cut short, is rejected.
+    SLANG_CHECK(!slangReflectionBinaryOpen("RIFF", 4, &reflection));
+    SLANG_CHECK(!slangReflectionBinaryOpen(blob->getBufferPointer(), 40, &reflection));
+}
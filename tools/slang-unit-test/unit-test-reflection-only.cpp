@@ -0,0 +1,86 @@
+// unit-test-reflection-only.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a reflection-only session computes layouts, but refuses to generate code.
+//
+SLANG_UNIT_TEST(reflectionOnly)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry option = {};
+    option.name = slang::CompilerOptionName::ReflectionOnly;
+    option.value.kind = slang::CompilerOptionValueKind::Int;
+    option.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &option;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        struct Params
+        {
+            float4 color;
+            float scale;
+        }
+
+        ConstantBuffer<Params> params;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = params.color * params.scale;
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    auto layout = linked->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+    SLANG_CHECK(layout->getParameterCount() == 2);
+    SLANG_CHECK(layout->getEntryPointCount() == 1);
+
+    auto paramsLayout = layout->getParameterByIndex(0)->getTypeLayout()->getElementTypeLayout();
+    SLANG_CHECK_ABORT(paramsLayout != nullptr);
+    SLANG_CHECK(paramsLayout->getFieldCount() == 2);
+    SLANG_CHECK(paramsLayout->getSize() == 20);
+
+    ComPtr<slang::IBlob> code;
+    ComPtr<slang::IBlob> codeDiagnostics;
+    SLANG_CHECK(SLANG_FAILED(
+        linked->getEntryPointCode(0, 0, code.writeRef(), codeDiagnostics.writeRef())));
+    SLANG_CHECK(code == nullptr);
+    SLANG_CHECK(codeDiagnostics != nullptr);
+}
@@ -273,6 +273,52 @@ SLANG_UNIT_TEST(replayContextLoadLatestReplay)
     ctx().setReplayDirectory(".slang-replays");
 }
 
+SLANG_UNIT_TEST(replayContextLoadCompressedReplay)
+{
+    REPLAY_TEST;
+    SLANG_UNUSED(unitTestContext);
+
+    ctx().setReplayDirectory(".slang-replays-test");
+
+    // Use the smallest ring so the recording wraps around it many times.
+    ReplayContext::CaptureOptions options;
+    options.compress = true;
+    options.ringBufferSize = 4096;
+    ctx().setCaptureOptions(options);
+
+    ctx().setMode(Mode::Record);
+    const int32_t valueCount = 20000;
+    for (int32_t i = 0; i < valueCount; ++i)
+    {
+        int32_t value = i;
+        ctx().record(RecordFlag::None, value);
+    }
+    String replayPath(ctx().getCurrentReplayPath());
+
+    // Disabling waits for the writer thread to finish the file.
+    ctx().disable();
+
+    List<uint8_t> contents;
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        File::readAllBytes(Path::combine(replayPath, "stream.bin"), contents)));
+    SLANG_CHECK(ReplayStreamWriter::isCompressed(contents.getBuffer(), size_t(contents.getCount())));
+
+    SLANG_CHECK(SLANG_SUCCEEDED(ctx().loadReplay(replayPath.getBuffer())));
+    bool allMatch = true;
+    for (int32_t i = 0; i < valueCount; ++i)
+    {
+        int32_t value = 0;
+        ctx().record(RecordFlag::None, value);
+        allMatch = allMatch && value == i;
+    }
+    SLANG_CHECK(allMatch);
+    SLANG_CHECK(ctx().getStream().atEnd());
+
+    ctx().reset();
+    ctx().setCaptureOptions(ReplayContext::CaptureOptions());
+    ctx().setReplayDirectory(".slang-replays");
+}
+
 SLANG_UNIT_TEST(replayContextFindLatestFolder)
 {
     REPLAY_TEST;
@@ -358,3 +358,81 @@ SLANG_UNIT_TEST(riff)
     }
 #endif
 }
+
+SLANG_UNIT_TEST(riffChunkIndex)
+{
+    const RIFF::Chunk::Type listType = SLANG_FOUR_CC('l', 'i', 's', 't');
+    const RIFF::Chunk::Type itemType = SLANG_FOUR_CC('i', 't', 'e', 'm');
+    const RIFF::Chunk::Type otherType = SLANG_FOUR_CC('o', 't', 'h', 'r');
+
+    RIFF::Builder riffBuilder;
+    RIFF::BuildCursor cursor(riffBuilder);
+    {
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, listType);
+        auto indexChunk = cursor.addDataChunk(RIFF::ChunkIndex::kType);
+
+        // Items of varying sizes, so that the offsets aren't trivially predictable
+        List<RIFF::ChunkIndex::Child> children;
+        for (Index i = 0; i < 20; ++i)
+        {
+            String name;
+            name << "item" << i;
+
+            SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, itemType);
+            cursor.addData(name.getBuffer(), name.getLength());
+
+            RIFF::ChunkIndex::Child child;
+            child.chunk = cursor.getCurrentChunk();
+            child.nameHash = RIFF::ChunkIndex::getNameHash(name.getUnownedSlice());
+            children.add(child);
+        }
+        cursor.addDataChunk(otherType, "other", 5);
+
+        RIFF::ChunkIndex::write(indexChunk, children.getArrayView());
+    }
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_SUCCEEDED(riffBuilder.writeToBlob(blob.writeRef())));
+
+    auto rootChunk = RIFF::RootChunk::getFromBlob(blob);
+    SLANG_CHECK(rootChunk != nullptr);
+    if (!rootChunk)
+        return;
+
+    SLANG_CHECK(RIFF::ChunkIndex::getEntries(rootChunk).getCount() == 20);
+
+    // Every item can be found through the index
+    for (Index i = 0; i < 20; ++i)
+    {
+        String name;
+        name << "item" << i;
+
+        auto entries = RIFF::ChunkIndex::findEntries(
+            rootChunk,
+            itemType,
+            RIFF::ChunkIndex::getNameHash(name.getUnownedSlice()));
+        SLANG_CHECK(entries.getCount() == 1);
+
+        auto child = as<RIFF::DataChunk>(RIFF::ChunkIndex::getChild(rootChunk, entries[0]));
+        SLANG_CHECK(child != nullptr);
+        SLANG_CHECK(
+            child && UnownedStringSlice((char const*)child->getPayload(),
+                                        child->getPayloadSize()) == name.getUnownedSlice());
+    }
+
+    SLANG_CHECK(
+        RIFF::ChunkIndex::findEntries(
+            rootChunk,
+            itemType,
+            RIFF::ChunkIndex::getNameHash(toSlice("missing")))
+            .getCount() == 0);
+
+    // Iterating the children skips the index
+    Count childCount = 0;
+    for (auto child : RIFF::ChunkIndex::getChildren(rootChunk))
+    {
+        SLANG_CHECK(child->getType() != RIFF::ChunkIndex::kType);
+        childCount++;
+    }
+    SLANG_CHECK(childCount == 21);
+}
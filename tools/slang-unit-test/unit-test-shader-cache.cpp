@@ -0,0 +1,321 @@
+// unit-test-shader-cache.cpp
+
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+struct ShaderCacheTestDirectory
+{
+    ShaderCacheTestDirectory()
+    {
+        path = Path::simplify(
+            Path::getParentDirectory(Path::getExecutablePath()) + "/shader-cache-test" +
+            String(Process::getId()));
+        remove();
+    }
+
+    ~ShaderCacheTestDirectory() { remove(); }
+
+    /// Get the paths of all cache entries, skipping the lock and index files.
+    List<String> getEntryPaths()
+    {
+        struct Context
+        {
+            String const& path;
+            List<String> entries;
+        } context{path, {}};
+
+        OSFileSystem::getMutableSingleton()->enumeratePathContents(
+            path.getBuffer(),
+            [](SlangPathType pathType, const char* fileName, void* userData)
+            {
+                auto context = (Context*)userData;
+                UnownedStringSlice name(fileName);
+                if (pathType == SLANG_PATH_TYPE_FILE && name != toSlice("lock") &&
+                    name != toSlice("index"))
+                {
+                    context->entries.add(context->path + "/" + fileName);
+                }
+            },
+            &context);
+        return context.entries;
+    }
+
+    void remove()
+    {
+        auto fileSystem = OSFileSystem::getMutableSingleton();
+        fileSystem->enumeratePathContents(
+            path.getBuffer(),
+            [](SlangPathType, const char* fileName, void* userData)
+            {
+                auto self = (ShaderCacheTestDirectory*)userData;
+                String filePath = self->path + "/" + fileName;
+                OSFileSystem::getMutableSingleton()->remove(filePath.getBuffer());
+            },
+            this);
+        fileSystem->remove(path.getBuffer());
+    }
+
+    String path;
+};
+
+static const char* kShaderSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 2.0f;
+    }
+    )";
+
+// The same code, with an edit that doesn't change what the entry point does.
+static const char* kEditedShaderSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    // A function the entry point doesn't call.
+    float unused(float x) { return x * 3.0f; }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 2.0f;
+    }
+    )";
+
+// Uses a second parameter, to tell a result's metadata apart from no metadata.
+static const char* kTwoParameterShaderSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+    RWStructuredBuffer<float> unusedBuffer;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 2.0f;
+    }
+    )";
+
+static const String kCacheMarker = "// served from the shader cache";
+
+/// Overwrite the start of the code stored in a cache entry with a marker, so that we can tell
+/// whether a later compile actually came from the cache. The rest of the entry is kept as is.
+static SlangResult _markCachedCode(String const& entryPath, slang::IBlob* code)
+{
+    List<unsigned char> entry;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(entryPath, entry));
+
+    UnownedStringSlice entryText((const char*)entry.getBuffer(), entry.getCount());
+    UnownedStringSlice codeText((const char*)code->getBufferPointer(), code->getBufferSize());
+    const Index codeOffset = entryText.indexOf(codeText);
+    if (codeOffset < 0 || codeText.getLength() < kCacheMarker.getLength())
+        return SLANG_FAIL;
+
+    ::memcpy(entry.getBuffer() + codeOffset, kCacheMarker.getBuffer(), kCacheMarker.getLength());
+    return File::writeAllBytes(entryPath, entry.getBuffer(), entry.getCount());
+}
+
+static ComPtr<slang::IBlob> _compileWithShaderCache(
+    slang::IGlobalSession* globalSession,
+    const char* cacheDirectory,
+    const char* source,
+    slang::IMetadata** outMetadata = nullptr,
+    int compileTimeBudgetMilliseconds = 0,
+    String* outCodeGenDiagnostics = nullptr)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry options[2] = {};
+    options[0].name = slang::CompilerOptionName::ShaderCacheDirectory;
+    options[0].value.kind = slang::CompilerOptionValueKind::String;
+    options[0].value.stringValue0 = cacheDirectory;
+    options[1].name = slang::CompilerOptionName::CompileTimeBudget;
+    options[1].value.kind = slang::CompilerOptionValueKind::Int;
+    options[1].value.intValue0 = compileTimeBudgetMilliseconds;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = options;
+    sessionDesc.compilerOptionEntryCount = compileTimeBudgetMilliseconds ? 2 : 1;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return nullptr;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef());
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> composite;
+    session->createCompositeComponentType(components, 2, composite.writeRef());
+
+    ComPtr<slang::IComponentType> linked;
+    composite->link(linked.writeRef(), diagnostics.writeRef());
+    if (!linked)
+        return nullptr;
+
+    ComPtr<slang::IBlob> code;
+    linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef());
+    if (outCodeGenDiagnostics && diagnostics)
+        *outCodeGenDiagnostics = (const char*)diagnostics->getBufferPointer();
+    if (outMetadata)
+        linked->getEntryPointMetadata(0, 0, outMetadata, diagnostics.writeRef());
+    return code;
+}
+
+} // namespace
+
+// Test that code generated by a session with a shader cache directory is stored
+// in that cache, and that a later session with identical inputs is served from it.
+//
+SLANG_UNIT_TEST(shaderCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ShaderCacheTestDirectory cacheDirectory;
+    const char* cachePath = cacheDirectory.path.getBuffer();
+
+    auto firstCode = _compileWithShaderCache(globalSession, cachePath, kShaderSource);
+    SLANG_CHECK_ABORT(firstCode != nullptr);
+    SLANG_CHECK(firstCode->getBufferSize() != 0);
+
+    // The first compile misses and writes the code under two keys, one computed from the
+    // source files and one from the linked IR.
+    auto entryPaths = cacheDirectory.getEntryPaths();
+    SLANG_CHECK_ABORT(entryPaths.getCount() == 2);
+
+    for (auto& entryPath : entryPaths)
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_markCachedCode(entryPath, firstCode)));
+
+    auto secondCode = _compileWithShaderCache(globalSession, cachePath, kShaderSource);
+    SLANG_CHECK_ABORT(secondCode != nullptr);
+
+    UnownedStringSlice secondText(
+        (const char*)secondCode->getBufferPointer(),
+        secondCode->getBufferSize());
+    SLANG_CHECK(secondText.startsWith(kCacheMarker.getUnownedSlice()));
+    SLANG_CHECK(cacheDirectory.getEntryPaths().getCount() == 2);
+
+    // An edit that leaves the linked IR of the entry point alone misses on the source key,
+    // but is served from the linked IR key, and stored under its own source key.
+    auto editedCode = _compileWithShaderCache(globalSession, cachePath, kEditedShaderSource);
+    SLANG_CHECK_ABORT(editedCode != nullptr);
+
+    UnownedStringSlice editedText(
+        (const char*)editedCode->getBufferPointer(),
+        editedCode->getBufferSize());
+    SLANG_CHECK(editedText.startsWith(kCacheMarker.getUnownedSlice()));
+    SLANG_CHECK(cacheDirectory.getEntryPaths().getCount() == 3);
+}
+
+// Test that a result served from the shader cache has the same metadata as the result the
+// entry was written for.
+//
+SLANG_UNIT_TEST(shaderCacheMetadata)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ShaderCacheTestDirectory cacheDirectory;
+    const char* cachePath = cacheDirectory.path.getBuffer();
+
+    auto checkMetadata = [](slang::IMetadata* metadata)
+    {
+        bool isUsed = false;
+        SLANG_CHECK(SLANG_SUCCEEDED(metadata->isParameterLocationUsed(
+            SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS,
+            0,
+            0,
+            isUsed)));
+        SLANG_CHECK(isUsed);
+
+        isUsed = true;
+        SLANG_CHECK(SLANG_SUCCEEDED(metadata->isParameterLocationUsed(
+            SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS,
+            0,
+            1,
+            isUsed)));
+        SLANG_CHECK(!isUsed);
+    };
+
+    ComPtr<slang::IMetadata> firstMetadata;
+    auto firstCode = _compileWithShaderCache(
+        globalSession,
+        cachePath,
+        kTwoParameterShaderSource,
+        firstMetadata.writeRef());
+    SLANG_CHECK_ABORT(firstCode != nullptr);
+    SLANG_CHECK_ABORT(firstMetadata != nullptr);
+    checkMetadata(firstMetadata);
+
+    for (auto& entryPath : cacheDirectory.getEntryPaths())
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_markCachedCode(entryPath, firstCode)));
+
+    ComPtr<slang::IMetadata> secondMetadata;
+    auto secondCode = _compileWithShaderCache(
+        globalSession,
+        cachePath,
+        kTwoParameterShaderSource,
+        secondMetadata.writeRef());
+    SLANG_CHECK_ABORT(secondCode != nullptr);
+
+    UnownedStringSlice secondText(
+        (const char*)secondCode->getBufferPointer(),
+        secondCode->getBufferSize());
+    SLANG_CHECK(secondText.startsWith(kCacheMarker.getUnownedSlice()));
+
+    SLANG_CHECK_ABORT(secondMetadata != nullptr);
+    checkMetadata(secondMetadata);
+}
+
+// Test that code generated with optimizations reduced to stay within a compile time budget
+// isn't stored in the shader cache, since another compile of the same inputs may not reduce
+// them.
+//
+SLANG_UNIT_TEST(shaderCacheCompileTimeBudget)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ShaderCacheTestDirectory cacheDirectory;
+    const char* cachePath = cacheDirectory.path.getBuffer();
+
+    // Optimizing the IR takes longer than a millisecond, so the simplification passes are
+    // reduced, with a note saying so.
+    String diagnostics;
+    auto degradedCode =
+        _compileWithShaderCache(globalSession, cachePath, kShaderSource, nullptr, 1, &diagnostics);
+    SLANG_CHECK_ABORT(degradedCode != nullptr);
+    SLANG_CHECK(diagnostics.indexOf("compile time budget") >= 0);
+    SLANG_CHECK(cacheDirectory.getEntryPaths().getCount() == 0);
+
+    // The same compile without a budget is stored as usual.
+    auto code = _compileWithShaderCache(globalSession, cachePath, kShaderSource);
+    SLANG_CHECK_ABORT(code != nullptr);
+    SLANG_CHECK(cacheDirectory.getEntryPaths().getCount() == 2);
+}
@@ -0,0 +1,176 @@
+// unit-test-share-checked-modules.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static ComPtr<slang::ISession> _createSharingSession(
+    slang::IGlobalSession* globalSession,
+    const char* searchPath)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry shareOption = {};
+    shareOption.name = slang::CompilerOptionName::ShareCheckedModules;
+    shareOption.value.kind = slang::CompilerOptionValueKind::Int;
+    shareOption.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPaths = &searchPath;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.compilerOptionEntries = &shareOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+static ComPtr<slang::IBlob> _compileSharedModule(
+    slang::IGlobalSession* globalSession,
+    const char* searchPath,
+    const char* entryPointName)
+{
+    auto session = _createSharingSession(globalSession, searchPath);
+    if (!session)
+        return nullptr;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModule("share-checked-module", diagnostics.writeRef());
+    if (!module)
+        return nullptr;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName(entryPointName, entryPoint.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> composite;
+    session->createCompositeComponentType(components, 2, composite.writeRef());
+
+    ComPtr<slang::IComponentType> linked;
+    composite->link(linked.writeRef(), diagnostics.writeRef());
+    if (!linked)
+        return nullptr;
+
+    ComPtr<slang::IBlob> code;
+    linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef());
+    return code;
+}
+
+// Test that a module checked by one session sharing checked modules can be used by
+// another such session, and that a shared module is not used once its source changes.
+//
+SLANG_UNIT_TEST(shareCheckedModules)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String searchPath = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/share-checked-modules-test" +
+        String(Process::getId()));
+    Path::createDirectory(searchPath);
+    const String modulePath = searchPath + "/share-checked-module.slang";
+
+    const char* firstSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void firstMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = tid.x * 2.0f;
+        }
+        )";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(modulePath, firstSource)));
+
+    auto firstCode = _compileSharedModule(globalSession, searchPath.getBuffer(), "firstMain");
+    SLANG_CHECK(firstCode != nullptr);
+
+    // The second session finds the module checked by the first one.
+    auto sharedCode = _compileSharedModule(globalSession, searchPath.getBuffer(), "firstMain");
+    SLANG_CHECK(sharedCode != nullptr);
+
+    // After the source changes the shared module is out of date, so the new
+    // entry point must be found by checking the module again.
+    const char* secondSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void secondMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = tid.x * 3.0f;
+        }
+        )";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(modulePath, secondSource)));
+
+    auto secondCode = _compileSharedModule(globalSession, searchPath.getBuffer(), "secondMain");
+    SLANG_CHECK(secondCode != nullptr);
+
+    File::remove(modulePath);
+    Path::remove(searchPath);
+}
+
+static bool _loadSharedModuleReportsWarning(
+    slang::IGlobalSession* globalSession,
+    const char* searchPath)
+{
+    auto session = _createSharingSession(globalSession, searchPath);
+    if (!session)
+        return false;
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModule("share-checked-warning-module", diagnostics.writeRef());
+    if (!module || !diagnostics)
+        return false;
+    UnownedStringSlice text(
+        (const char*)diagnostics->getBufferPointer(),
+        diagnostics->getBufferSize());
+    return text.indexOf(toSlice("30081")) >= 0;
+}
+
+// Test that the warnings reported while checking a shared module are reported again by a
+// session that reuses it.
+//
+SLANG_UNIT_TEST(shareCheckedModulesReplaysWarnings)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String searchPath = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/share-checked-warnings-test" +
+        String(Process::getId()));
+    Path::createDirectory(searchPath);
+    const String modulePath = searchPath + "/share-checked-warning-module.slang";
+
+    const char* source = R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            int scaled = tid.x * 0.5f;
+            outputBuffer[tid.x] = scaled;
+        }
+        )";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(modulePath, source)));
+
+    SLANG_CHECK(_loadSharedModuleReportsWarning(globalSession, searchPath.getBuffer()));
+    SLANG_CHECK(_loadSharedModuleReportsWarning(globalSession, searchPath.getBuffer()));
+
+    File::remove(modulePath);
+    Path::remove(searchPath);
+}
@@ -0,0 +1,98 @@
+// unit-test-shared-type-layout.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+
+/// Link `module` with the entry point called `name`, and get the layout of the element
+/// type of its first global parameter.
+static slang::TypeLayoutReflection* _getElementTypeLayout(
+    slang::ISession* session,
+    slang::IModule* module,
+    const char* name,
+    ComPtr<slang::IComponentType>& outLinked)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName(name, entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    SLANG_CHECK_ABORT(composite->link(outLinked.writeRef()) == SLANG_OK);
+
+    auto layout = outLinked->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+    SLANG_CHECK_ABORT(layout->getParameterCount() >= 1);
+    return layout->getParameterByIndex(0)->getTypeLayout()->getElementTypeLayout();
+}
+
+} // namespace
+
+// Test that the layout of a plain data struct is shared by programs for the same target.
+//
+SLANG_UNIT_TEST(sharedTypeLayout)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        struct Material
+        {
+            float4 baseColor;
+            float3x3 transform;
+            float roughness[4];
+        }
+
+        StructuredBuffer<Material> materials;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeA(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = materials[tid.x].baseColor;
+        }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeB(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = materials[tid.x].roughness[0];
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IComponentType> linkedA;
+    ComPtr<slang::IComponentType> linkedB;
+    auto layoutA = _getElementTypeLayout(session, module, "computeA", linkedA);
+    auto layoutB = _getElementTypeLayout(session, module, "computeB", linkedB);
+
+    SLANG_CHECK_ABORT(layoutA != nullptr);
+    SLANG_CHECK(layoutA == layoutB);
+    SLANG_CHECK(layoutA->getFieldCount() == 3);
+    SLANG_CHECK(layoutA->getSize() == layoutB->getSize());
+}
@@ -102,6 +102,199 @@ SLANG_UNIT_TEST(slangVM)
     SLANG_CHECK(*returnVal == 100);
 }
 
+SLANG_UNIT_TEST(slangVMSuperInsts)
+{
+    // Loops and branches on int, uint and float compares, and updates through a pointer,
+    // which the interpreter runs as superinstructions.
+    const char* testSource = R"(
+        void accumulate(inout int total, int value)
+        {
+            total += value;
+        }
+        [shader("dispatch")]
+        int dispatchMain(uniform int2 v, out int c)
+        {
+            int acc = 0;
+            uint u = 0;
+            float f = 0.0;
+            for (int i = 0; i < v.x; i++)
+            {
+                if (i != 3)
+                    accumulate(acc, i * v.y);
+                else
+                    acc -= 1;
+                if (u <= 100u)
+                    u += uint(i);
+                if (f <= 10.0)
+                    f += 1.5;
+            }
+            c = acc;
+            return int(u) + int(f);
+        }
+    )";
+
+    ComPtr<slang::IBlob> code;
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_CHECK(
+            slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HOST_VM;
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "super-inst-test",
+            "super-inst-test.slang",
+            testSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK(module->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+        SLANG_CHECK(
+            linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef()) ==
+            SLANG_OK);
+        SLANG_CHECK(code != nullptr);
+    }
+
+    ComPtr<slang::IByteCodeRunner> runner;
+    slang::ByteCodeRunnerDesc runnerDesc = {};
+    SLANG_CHECK(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+    SLANG_CHECK(runner->loadModule(code) == SLANG_OK);
+    int funcIndex = runner->findFunctionByName("dispatchMain");
+    SLANG_CHECK(funcIndex >= 0);
+
+    struct Params
+    {
+        int n;
+        int step;
+        int* result;
+    };
+
+    // Run twice to check that the prepared code can be executed again.
+    for (int run = 0; run < 2; run++)
+    {
+        SLANG_CHECK(runner->selectFunctionByIndex((uint32_t)funcIndex) == SLANG_OK);
+        int result = 0;
+        Params params = {10, 2, &result};
+        SLANG_CHECK(runner->execute(&params, sizeof(params)) == SLANG_OK);
+
+        // 2 * (0 + 1 + ... + 9 - 3) - 1
+        SLANG_CHECK(result == 83);
+
+        // u = 0 + 1 + ... + 9, and f stops growing at 10.5.
+        size_t returnValSize = 0;
+        int* returnVal = (int*)runner->getReturnValue(&returnValSize);
+        SLANG_CHECK(returnValSize == sizeof(int));
+        SLANG_CHECK(*returnVal == 45 + 10);
+    }
+}
+
+SLANG_UNIT_TEST(slangVMExecuteBatch)
+{
+    const char* testSource = R"(
+        [shader("dispatch")]
+        int dispatchMain(uniform int4 a, uniform int4 b)
+        {
+            int4 c = a * b + a;
+            float4 f = float4(c) * 0.5;
+            return c.x + c.y + c.z + c.w + int(f.w);
+        }
+    )";
+
+    ComPtr<slang::IBlob> code;
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_CHECK(
+            slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HOST_VM;
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "batch-test",
+            "batch-test.slang",
+            testSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK(module->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+        SLANG_CHECK(
+            linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef()) ==
+            SLANG_OK);
+        SLANG_CHECK(code != nullptr);
+    }
+
+    ComPtr<slang::IByteCodeRunner> runner;
+    slang::ByteCodeRunnerDesc runnerDesc = {};
+    SLANG_CHECK(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+    SLANG_CHECK(runner->loadModule(code) == SLANG_OK);
+
+    struct Params
+    {
+        int a[4];
+        int b[4];
+    };
+    const uint32_t kInvocationCount = 16;
+
+    // Batch execution needs a selected function.
+    SLANG_CHECK(SLANG_FAILED(
+        runner->executeBatch(kInvocationCount, nullptr, 0, sizeof(Params), nullptr, 0)));
+
+    int funcIndex = runner->findFunctionByName("dispatchMain");
+    SLANG_CHECK(funcIndex >= 0);
+    SLANG_CHECK(runner->selectFunctionByIndex((uint32_t)funcIndex) == SLANG_OK);
+
+    Params params[kInvocationCount];
+    int expected[kInvocationCount];
+    for (uint32_t i = 0; i < kInvocationCount; i++)
+    {
+        int sum = 0;
+        int lastC = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            params[i].a[j] = int(i) + j;
+            params[i].b[j] = j - 1;
+            lastC = params[i].a[j] * params[i].b[j] + params[i].a[j];
+            sum += lastC;
+        }
+        expected[i] = sum + int(float(lastC) * 0.5f);
+    }
+
+    int results[kInvocationCount] = {};
+    SLANG_CHECK(
+        runner->executeBatch(
+            kInvocationCount,
+            params,
+            sizeof(Params),
+            sizeof(Params),
+            results,
+            sizeof(int)) == SLANG_OK);
+    for (uint32_t i = 0; i < kInvocationCount; i++)
+        SLANG_CHECK(results[i] == expected[i]);
+
+    // The function can still be run on its own after a batch.
+    SLANG_CHECK(runner->selectFunctionByIndex((uint32_t)funcIndex) == SLANG_OK);
+    SLANG_CHECK(runner->execute(&params[3], sizeof(Params)) == SLANG_OK);
+    size_t returnValSize = 0;
+    int* returnVal = (int*)runner->getReturnValue(&returnValSize);
+    SLANG_CHECK(returnValSize == sizeof(int));
+    SLANG_CHECK(*returnVal == expected[3]);
+}
+
 struct ExtCallState
 {
     int callCount = 0;
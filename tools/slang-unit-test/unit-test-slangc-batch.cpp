@@ -0,0 +1,113 @@
+// unit-test-slangc-batch.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-escape-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char* kGoodShaderSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 2.0f;
+    }
+    )";
+
+static const char* kBadShaderSource = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        undefinedBuffer[tid.x] = 1.0f;
+    }
+    )";
+
+static void _appendBatchJob(StringBuilder& manifest, List<String> const& args)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    manifest << "[";
+    for (Index i = 0; i < args.getCount(); ++i)
+    {
+        if (i > 0)
+            manifest << ", ";
+        StringEscapeUtil::appendQuoted(handler, args[i].getUnownedSlice(), manifest);
+    }
+    manifest << "]";
+}
+
+// Test that `slangc --batch` runs every job in the manifest, even after one of them fails,
+// and reports the failure in its return code.
+//
+SLANG_UNIT_TEST(slangcBatch)
+{
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/slangc-batch-test" +
+        String(Process::getId()));
+    Path::createDirectory(directory);
+
+    const String badSourcePath = directory + "/bad.slang";
+    const String goodSourcePath = directory + "/good.slang";
+    const String badOutputPath = directory + "/bad.hlsl";
+    const String goodOutputPath = directory + "/good.hlsl";
+    const String manifestPath = directory + "/manifest.json";
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(badSourcePath, kBadShaderSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(goodSourcePath, kGoodShaderSource)));
+
+    // The failing job comes first, so the good job only produces its output if the batch
+    // keeps going after a failure.
+    StringBuilder manifest;
+    manifest << "[\n    ";
+    _appendBatchJob(
+        manifest,
+        List<String>{
+            badSourcePath,
+            "-target",
+            "hlsl",
+            "-entry",
+            "computeMain",
+            "-o",
+            badOutputPath});
+    manifest << ",\n    ";
+    _appendBatchJob(
+        manifest,
+        List<String>{
+            goodSourcePath,
+            "-target",
+            "hlsl",
+            "-entry",
+            "computeMain",
+            "-o",
+            goodOutputPath});
+    manifest << "\n]\n";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(manifestPath, manifest)));
+
+    CommandLine cmdLine;
+    cmdLine.setExecutableLocation(
+        ExecutableLocation(unitTestContext->executableDirectory, "slangc"));
+    cmdLine.addArg("--batch");
+    cmdLine.addArg(manifestPath);
+
+    ExecuteResult exeRes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(ProcessUtil::execute(cmdLine, exeRes)));
+
+    SLANG_CHECK(exeRes.resultCode != 0);
+    SLANG_CHECK(exeRes.standardError.indexOf("undefinedBuffer") >= 0);
+    SLANG_CHECK(exeRes.standardError.indexOf("batch job 0 failed") >= 0);
+    SLANG_CHECK(exeRes.standardError.indexOf("batch job 1 failed") < 0);
+
+    SLANG_CHECK(!File::exists(badOutputPath));
+    String goodOutput;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::readAllText(goodOutputPath, goodOutput)));
+    SLANG_CHECK(goodOutput.indexOf("computeMain") >= 0);
+
+    for (auto path : {badSourcePath, goodSourcePath, badOutputPath, goodOutputPath, manifestPath})
+        File::remove(path);
+    Path::remove(directory);
+}
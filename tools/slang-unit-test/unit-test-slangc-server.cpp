@@ -0,0 +1,158 @@
+// unit-test-slangc-server.cpp
+
+#include "../../source/compiler-core/slang-json-rpc-connection.h"
+#include "../../source/compiler-core/slang-test-server-protocol.h"
+#include "../../source/core/slang-http.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char* kGoodShaderSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = tid.x * 2.0f;
+    }
+    )";
+
+static const char* kBadShaderSource = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        undefinedBuffer[tid.x] = 1.0f;
+    }
+    )";
+
+static const Int kTimeOutInMs = 60 * 1000;
+
+/// Send a compile of `sourcePath` to the server, and read back its result.
+static SlangResult _compileOnServer(
+    JSONRPCConnection* connection,
+    const char* toolName,
+    const String& sourcePath,
+    Int id,
+    TestServerProtocol::ExecutionResult& outResult)
+{
+    TestServerProtocol::ExecuteToolTestArgs args;
+    args.toolName = toolName;
+    args.args = List<String>{sourcePath, "-target", "hlsl", "-entry", "computeMain"};
+    SLANG_RETURN_ON_FAIL(connection->sendCall(
+        TestServerProtocol::ExecuteToolTestArgs::g_methodName,
+        &args,
+        JSONValue::makeInt(id)));
+
+    SLANG_RETURN_ON_FAIL(connection->waitForResult(kTimeOutInMs));
+    if (connection->getMessageType() != JSONRPCMessageType::Result)
+        return SLANG_FAIL;
+    return connection->getMessage(&outResult);
+}
+
+/// Read back the error the server replied with.
+static SlangResult _readErrorCode(JSONRPCConnection* connection, Int& outCode)
+{
+    SLANG_RETURN_ON_FAIL(connection->waitForResult(kTimeOutInMs));
+    if (connection->getMessageType() != JSONRPCMessageType::Error)
+        return SLANG_FAIL;
+    JSONRPCErrorResponse response;
+    SLANG_RETURN_ON_FAIL(connection->getRPC(&response));
+    outCode = response.error.code;
+    return SLANG_OK;
+}
+
+// Test a session with `slangc --server`: compiles that succeed and fail, requests the server
+// can't handle, and shutting it down. The server has to keep serving after every failure.
+//
+SLANG_UNIT_TEST(slangcServer)
+{
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/slangc-server-test" +
+        String(Process::getId()));
+    Path::createDirectory(directory);
+
+    const String badSourcePath = directory + "/bad.slang";
+    const String goodSourcePath = directory + "/good.slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(badSourcePath, kBadShaderSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(goodSourcePath, kGoodShaderSource)));
+
+    CommandLine cmdLine;
+    cmdLine.setExecutableLocation(
+        ExecutableLocation(unitTestContext->executableDirectory, "slangc"));
+    cmdLine.addArg("--server");
+
+    RefPtr<Process> process;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(Process::create(cmdLine, Process::Flag::AttachDebugger, process)));
+
+    RefPtr<BufferedReadStream> readStream(
+        new BufferedReadStream(process->getStream(StdStreamType::Out)));
+    RefPtr<HTTPPacketConnection> packetConnection =
+        new HTTPPacketConnection(readStream, process->getStream(StdStreamType::In));
+    RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        connection->init(packetConnection, JSONRPCConnection::CallStyle::Default, process)));
+
+    // A compile that succeeds replies with the generated code.
+    {
+        TestServerProtocol::ExecutionResult result;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(_compileOnServer(connection, "slangc", goodSourcePath, 1, result)));
+        SLANG_CHECK(result.returnCode == 0);
+        SLANG_CHECK(result.stdOut.indexOf("computeMain") >= 0);
+    }
+
+    // A compile that fails replies with its diagnostics and return code.
+    {
+        TestServerProtocol::ExecutionResult result;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(_compileOnServer(connection, "slangc", badSourcePath, 2, result)));
+        SLANG_CHECK(result.returnCode != 0);
+        SLANG_CHECK(result.stdError.indexOf("undefinedBuffer") >= 0);
+    }
+
+    // A request that isn't JSON.
+    {
+        const UnownedStringSlice malformed = toSlice("{ \"jsonrpc\": \"2.0\", \"method\": ");
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            packetConnection->write(malformed.begin(), size_t(malformed.getLength()))));
+
+        Int code = 0;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_readErrorCode(connection, code)));
+        SLANG_CHECK(code == Int(JSONRPC::ErrorCode::ParseError));
+    }
+
+    // A request for a tool other than slangc.
+    {
+        TestServerProtocol::ExecutionResult result;
+        SLANG_CHECK(SLANG_FAILED(
+            _compileOnServer(connection, "render-test", goodSourcePath, 3, result)));
+        JSONRPCErrorResponse response;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->getRPC(&response)));
+        SLANG_CHECK(response.error.code == Int(JSONRPC::ErrorCode::InvalidParams));
+    }
+
+    // The server still compiles after all of the above.
+    {
+        TestServerProtocol::ExecutionResult result;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(_compileOnServer(connection, "slangc", goodSourcePath, 4, result)));
+        SLANG_CHECK(result.returnCode == 0);
+        SLANG_CHECK(result.stdOut.indexOf("computeMain") >= 0);
+    }
+
+    // Shutting down ends the server cleanly.
+    SLANG_CHECK(SLANG_SUCCEEDED(connection->sendCall(
+        TestServerProtocol::QuitArgs::g_methodName,
+        JSONValue::makeInt(5))));
+    SLANG_CHECK(process->waitForTermination(kTimeOutInMs));
+    SLANG_CHECK(process->getReturnValue() == 0);
+
+    File::remove(badSourcePath);
+    File::remove(goodSourcePath);
+    Path::remove(directory);
+}
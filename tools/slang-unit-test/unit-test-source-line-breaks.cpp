@@ -0,0 +1,65 @@
+// unit-test-source-line-breaks.cpp
+
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/core/slang-string-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// The line break offsets of a source file are found eight bytes at a time. They must match the
+// lines `StringUtil::extractLine` splits the same content into, whatever the mix of line
+// endings and wherever they fall relative to an eight byte boundary.
+
+static void _checkLineBreaks(SourceManager& sourceManager, const String& content)
+{
+    SourceFile* sourceFile =
+        sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), content);
+
+    List<uint32_t> expectedOffsets;
+    UnownedStringSlice text(sourceFile->getContent()), line;
+    const char* begin = text.begin();
+    while (StringUtil::extractLine(text, line))
+        expectedOffsets.add(uint32_t(line.begin() - begin));
+
+    SLANG_CHECK(sourceFile->getLineBreakOffsets() == expectedOffsets);
+    if (expectedOffsets.getCount() == 0)
+        return;
+
+    // Every offset must map to the line containing it, whether looked up in order through a
+    // view or directly on the file.
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+    for (int offset = 0; offset <= int(content.getLength()); offset++)
+    {
+        int lineIndex = sourceFile->calcLineIndexFromOffset(offset);
+        SLANG_CHECK(uint32_t(offset) >= expectedOffsets[lineIndex]);
+        SLANG_CHECK(
+            lineIndex + 1 == expectedOffsets.getCount() ||
+            uint32_t(offset) < expectedOffsets[lineIndex + 1]);
+        SLANG_CHECK(sourceView->calcLineIndexFromOffset(offset) == lineIndex);
+    }
+    for (int offset = int(content.getLength()); offset >= 0; offset -= 7)
+    {
+        SLANG_CHECK(
+            sourceView->calcLineIndexFromOffset(offset) ==
+            sourceFile->calcLineIndexFromOffset(offset));
+    }
+}
+
+SLANG_UNIT_TEST(sourceLineBreaks)
+{
+    SLANG_UNUSED(unitTestContext);
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    _checkLineBreaks(sourceManager, "");
+    _checkLineBreaks(sourceManager, "int x;");
+    _checkLineBreaks(sourceManager, "int x;\n");
+    _checkLineBreaks(sourceManager, "\n\n\n\n\n\n\n\n\n\n");
+    _checkLineBreaks(sourceManager, "a\r\nb\n\rc\rd\n\ne\r\r");
+    _checkLineBreaks(sourceManager, "0123456\r\n0123456\n\r01234567\r");
+    _checkLineBreaks(
+        sourceManager,
+        "float f(float x)\n{\n    return x * x;\n}\r\n\r\n// A longer line of comment text that "
+        "spans several words\n\n");
+}
@@ -0,0 +1,118 @@
+// unit-test-specialization-constant-option.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char* kSpecializationConstantOptionSource = R"(
+    static const int kTapCount = 4;
+    static const float kScale = 0.5;
+
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        float sum = 0;
+        for (int i = 0; i < kTapCount; i++)
+            sum += outputBuffer[i];
+        outputBuffer[tid.x] = sum * kScale;
+    }
+)";
+
+static SlangResult _compileWithSpecializationConstantOption(
+    slang::IGlobalSession* globalSession,
+    SlangCompileTarget format,
+    const char* profile,
+    String& outCode,
+    String& outDiagnostics)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = format;
+    targetDesc.profile = globalSession->findProfile(profile);
+
+    slang::CompilerOptionEntry option = {};
+    option.name = slang::CompilerOptionName::SpecializationConstant;
+    option.value.kind = slang::CompilerOptionValueKind::String;
+    option.value.stringValue0 = "kTapCount";
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &option;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        kSpecializationConstantOptionSource,
+        diagnostics.writeRef());
+    if (diagnostics)
+        outDiagnostics = (const char*)diagnostics->getBufferPointer();
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(
+        session->createCompositeComponentType(components, 2, composite.writeRef()));
+    ComPtr<slang::IComponentType> linked;
+    SLANG_RETURN_ON_FAIL(composite->link(linked.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+    outCode = String(
+        UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+    return SLANG_OK;
+}
+
+// Test that `-specialization-constant` turns a `static const` global into a function constant on
+// Metal, and leaves it alone on a target without specialization constants.
+//
+SLANG_UNIT_TEST(specializationConstantOption)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    {
+        String code;
+        String diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithSpecializationConstantOption(
+            globalSession,
+            SLANG_METAL,
+            "metal",
+            code,
+            diagnostics)));
+
+        // Only the named global becomes a function constant, defaulting to its initializer.
+        auto functionConstantIndex = code.indexOf("[[function_constant(");
+        SLANG_CHECK(functionConstantIndex >= 0);
+        SLANG_CHECK(code.indexOf("[[function_constant(", functionConstantIndex + 1) < 0);
+        SLANG_CHECK(code.indexOf("is_function_constant_defined(") >= 0);
+    }
+
+    {
+        String code;
+        String diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithSpecializationConstantOption(
+            globalSession,
+            SLANG_HLSL,
+            "sm_5_0",
+            code,
+            diagnostics)));
+
+        SLANG_CHECK(diagnostics.indexOf("31228") >= 0);
+        SLANG_CHECK(code.indexOf("cbuffer") < 0);
+    }
+}
@@ -0,0 +1,125 @@
+// unit-test-specialized-parameter-layout.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that specializations of a program share the layouts of parameters that don't depend on
+// specialization, while parameters that do are laid out for each specialization.
+//
+SLANG_UNIT_TEST(specializedParameterLayout)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        interface IFoo
+        {
+            float get();
+        }
+
+        struct A : IFoo
+        {
+            float x;
+            float y;
+            float get() { return x + y; }
+        }
+
+        struct B : IFoo
+        {
+            float x;
+            float get() { return x; }
+        }
+
+        struct Params
+        {
+            float4 color;
+            float scale;
+        }
+
+        type_param T : IFoo;
+
+        ConstantBuffer<Params> params;
+        ConstantBuffer<T> foo;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = params.color * params.scale * foo.get();
+        }
+        )",
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+
+    auto specializeAndLink = [&](const char* typeName) -> ComPtr<slang::IComponentType>
+    {
+        slang::SpecializationArg arg =
+            slang::SpecializationArg::fromType(module->getLayout()->findTypeByName(typeName));
+        ComPtr<slang::IComponentType> specialized;
+        ComPtr<slang::IComponentType> linked;
+        if (SLANG_FAILED(composite->specialize(&arg, 1, specialized.writeRef(), nullptr)) ||
+            SLANG_FAILED(specialized->link(linked.writeRef())))
+        {
+            return nullptr;
+        }
+        return linked;
+    };
+
+    auto linkedA = specializeAndLink("A");
+    auto linkedB = specializeAndLink("B");
+    SLANG_CHECK_ABORT(linkedA && linkedB);
+
+    auto layoutA = linkedA->getLayout(0);
+    auto layoutB = linkedB->getLayout(0);
+    SLANG_CHECK_ABORT(layoutA && layoutB);
+    SLANG_CHECK_ABORT(layoutA->getParameterCount() == 3);
+    SLANG_CHECK_ABORT(layoutB->getParameterCount() == 3);
+
+    // `params` doesn't depend on `T`, so both specializations share its layout.
+    auto paramsA = layoutA->getParameterByIndex(0);
+    auto paramsB = layoutB->getParameterByIndex(0);
+    SLANG_CHECK(paramsA->getTypeLayout() == paramsB->getTypeLayout());
+    SLANG_CHECK(paramsA->getTypeLayout()->getElementTypeLayout()->getSize() == 20);
+
+    // `foo` does, so each specialization lays it out for its own `T`.
+    auto fooA = layoutA->getParameterByIndex(1);
+    auto fooB = layoutB->getParameterByIndex(1);
+    SLANG_CHECK(fooA->getTypeLayout() != fooB->getTypeLayout());
+    SLANG_CHECK(fooA->getTypeLayout()->getElementTypeLayout()->getSize() == 8);
+    SLANG_CHECK(fooB->getTypeLayout()->getElementTypeLayout()->getSize() == 4);
+
+    // Registers are still bound for each specialization.
+    auto category = slang::ParameterCategory::ConstantBuffer;
+    SLANG_CHECK(paramsA->getOffset(category) == paramsB->getOffset(category));
+    SLANG_CHECK(fooA->getOffset(category) != paramsA->getOffset(category));
+    SLANG_CHECK(fooB->getOffset(category) != paramsB->getOffset(category));
+}
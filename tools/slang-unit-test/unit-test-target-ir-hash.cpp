@@ -0,0 +1,111 @@
+// unit-test-target-ir-hash.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+namespace
+{
+
+/// Compile `source` as module "m" at `path` in a new session, and get the IR hash of its
+/// `computeMain` entry point.
+static ComPtr<slang::IBlob> _getTargetIRHash(
+    slang::IGlobalSession* globalSession,
+    const char* path,
+    const char* source)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString("m", path, source, diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(components, 2, composite.writeRef()) == SLANG_OK);
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IComponentType2> linked2;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linked->queryInterface(slang::IComponentType2::getTypeGuid(), (void**)linked2.writeRef())));
+
+    ComPtr<slang::IBlob> hash;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linked2->getTargetIRHash(0, hash.writeRef())));
+    SLANG_CHECK_ABORT(hash && hash->getBufferSize() == 16);
+    return hash;
+}
+
+static bool _isSameHash(slang::IBlob* a, slang::IBlob* b)
+{
+    return a->getBufferSize() == b->getBufferSize() &&
+           memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+} // namespace
+
+// Test that the IR hash of a program doesn't depend on where its source is or how it is laid
+// out, but does change when the code does.
+//
+SLANG_UNIT_TEST(targetIRHash)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const char* source = R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = int(tid.x) * 2;
+        }
+        )";
+
+    const char* movedSource = R"(
+        // The same code, laid out differently.
+        RWStructuredBuffer<int> outputBuffer;
+        [shader("compute")] [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = int(tid.x) * 2; }
+        )";
+
+    const char* changedSource = R"(
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = int(tid.x) * 3;
+        }
+        )";
+
+    auto hash = _getTargetIRHash(globalSession, "a/m.slang", source);
+    auto sameHash = _getTargetIRHash(globalSession, "a/m.slang", source);
+    auto movedHash = _getTargetIRHash(globalSession, "b/m.slang", movedSource);
+    auto changedHash = _getTargetIRHash(globalSession, "a/m.slang", changedSource);
+
+    SLANG_CHECK(_isSameHash(hash, sameHash));
+    SLANG_CHECK(_isSameHash(hash, movedHash));
+    SLANG_CHECK(!_isSameHash(hash, changedHash));
+}
@@ -0,0 +1,65 @@
+// unit-test-trace-events.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that `-trace-events` writes the compile timeline in the Chrome trace event format,
+// with spans for compiler phases, IR passes and profiled functions.
+//
+SLANG_UNIT_TEST(traceEvents)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const String tracePath = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/trace-events-test" +
+        String(Process::getId()) + ".json");
+
+    const char* source = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = tid.x * 2.0f;
+        }
+        )";
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_ALLOW_DEPRECATED_BEGIN
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileRequest(request.writeRef())));
+    SLANG_ALLOW_DEPRECATED_END
+
+    const char* args[] = {"-trace-events", tracePath.getBuffer()};
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+    request->addCodeGenTarget(SLANG_HLSL);
+    const int translationUnitIndex =
+        request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "traceTest");
+    request->addTranslationUnitSourceString(translationUnitIndex, "traceTest.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+    String trace;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllText(tracePath, trace)));
+    File::remove(tracePath);
+
+    auto traceSlice = trace.getUnownedSlice();
+    SLANG_CHECK(traceSlice.indexOf(toSlice("\"traceEvents\"")) != -1);
+    SLANG_CHECK(traceSlice.indexOf(toSlice("\"ph\": \"X\"")) != -1);
+    SLANG_CHECK(traceSlice.indexOf(toSlice("\"cat\": \"function\"")) != -1);
+    SLANG_CHECK(traceSlice.indexOf(toSlice("\"cat\": \"pass\"")) != -1);
+
+    // Phases carry the module they ran on.
+    SLANG_CHECK(traceSlice.indexOf(toSlice("{\"name\": \"parse\", \"cat\": \"phase\"")) != -1);
+    SLANG_CHECK(traceSlice.indexOf(toSlice("\"args\": {\"detail\": \"traceTest\"}")) != -1);
+}
@@ -0,0 +1,98 @@
+// unit-test-uint-set.cpp
+
+#include "../../source/core/slang-uint-set.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// The bulk operations work on whole elements, and sets of different sizes have backing buffers
+// of different lengths. Check each operation against the result of testing every value one at
+// a time, for sets that end before, on and after an element boundary.
+
+static const UInt kMaxValue = 300;
+
+static UIntSet _makeSet(UInt count, UInt step, UInt offset)
+{
+    UIntSet set;
+    for (UInt value = offset; value < count; value += step)
+        set.add(value);
+    return set;
+}
+
+static bool _matches(
+    const UIntSet& set,
+    bool (*predicate)(UInt, const UIntSet&, const UIntSet&),
+    const UIntSet& a,
+    const UIntSet& b)
+{
+    for (UInt value = 0; value < kMaxValue; value++)
+    {
+        if (set.contains(value) != predicate(value, a, b))
+            return false;
+    }
+    return true;
+}
+
+static void _checkSetOperations(const UIntSet& a, const UIntSet& b)
+{
+    auto inUnion = [](UInt v, const UIntSet& x, const UIntSet& y)
+    { return x.contains(v) || y.contains(v); };
+    auto inIntersection = [](UInt v, const UIntSet& x, const UIntSet& y)
+    { return x.contains(v) && y.contains(v); };
+    auto inDifference = [](UInt v, const UIntSet& x, const UIntSet& y)
+    { return x.contains(v) && !y.contains(v); };
+
+    UIntSet result;
+    UIntSet::calcUnion(result, a, b);
+    SLANG_CHECK(_matches(result, inUnion, a, b));
+    UIntSet::calcIntersection(result, a, b);
+    SLANG_CHECK(_matches(result, inIntersection, a, b));
+    UIntSet::calcSubtract(result, a, b);
+    SLANG_CHECK(_matches(result, inDifference, a, b));
+
+    result = a;
+    result.unionWith(b);
+    SLANG_CHECK(_matches(result, inUnion, a, b));
+    result = a;
+    result.intersectWith(b);
+    SLANG_CHECK(_matches(result, inIntersection, a, b));
+    result = a;
+    result.subtractWith(b);
+    SLANG_CHECK(_matches(result, inDifference, a, b));
+
+    Index expectedIntersectionCount = 0;
+    bool expectedContains = true;
+    for (UInt value = 0; value < kMaxValue; value++)
+    {
+        if (inIntersection(value, a, b))
+            expectedIntersectionCount++;
+        if (b.contains(value) && !a.contains(value))
+            expectedContains = false;
+    }
+    SLANG_CHECK(UIntSet::hasIntersection(a, b) == (expectedIntersectionCount != 0));
+    SLANG_CHECK(a.contains(b) == expectedContains);
+
+    UIntSet::calcIntersection(result, a, b);
+    SLANG_CHECK(result.countElements() == expectedIntersectionCount);
+    SLANG_CHECK(result.getElements<UInt>().getCount() == expectedIntersectionCount);
+}
+
+SLANG_UNIT_TEST(uintSetOperations)
+{
+    SLANG_UNUSED(unitTestContext);
+
+    List<UIntSet> sets;
+    sets.add(UIntSet());
+    sets.add(_makeSet(1, 1, 0));
+    sets.add(_makeSet(64, 1, 0));
+    sets.add(_makeSet(65, 2, 1));
+    sets.add(_makeSet(200, 3, 0));
+    sets.add(_makeSet(kMaxValue, 7, 5));
+    sets.add(_makeSet(kMaxValue, 1, 0));
+
+    for (auto& a : sets)
+    {
+        for (auto& b : sets)
+            _checkSetOperations(a, b);
+    }
+}
@@ -665,7 +665,7 @@ SLANG_UNIT_TEST(vtableISlangProfiler)
 }
 
 // ---------------------------------------------------------------------------
-// IGlobalSession : ISlangUnknown  (own slots 3-31)
+// IGlobalSession : ISlangUnknown  (own slots 3-34)
 // ---------------------------------------------------------------------------
 struct IGlobalSessionProbe : IGlobalSession
 {
@@ -841,6 +841,20 @@ struct IGlobalSessionProbe : IGlobalSession
         lastSlot = 31;
         return SLANG_OK;
     }
+    SLANG_NO_THROW void SLANG_MCALL setJobScheduler(ISlangJobScheduler*) SLANG_OVERRIDE
+    {
+        lastSlot = 32;
+    }
+    SLANG_NO_THROW SlangResult SLANG_MCALL getJobScheduler(ISlangJobScheduler**) SLANG_OVERRIDE
+    {
+        lastSlot = 33;
+        return SLANG_OK;
+    }
+    SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(SlangMemoryUsage*) SLANG_OVERRIDE
+    {
+        lastSlot = 34;
+        return SLANG_OK;
+    }
 };
 
 SLANG_UNIT_TEST(vtableIGlobalSession)
@@ -862,6 +876,12 @@ SLANG_UNIT_TEST(vtableIGlobalSession)
     SLANG_CHECK(p.lastSlot == 26); // setSPIRVCoreGrammar
     callSlot(&p, 31);
     SLANG_CHECK(p.lastSlot == 31); // saveBuiltinModule
+    callSlot(&p, 32);
+    SLANG_CHECK(p.lastSlot == 32); // setJobScheduler
+    callSlot(&p, 33);
+    SLANG_CHECK(p.lastSlot == 33); // getJobScheduler
+    callSlot(&p, 34);
+    SLANG_CHECK(p.lastSlot == 34); // getMemoryUsage
 }
 
 // ---------------------------------------------------------------------------
@@ -1204,7 +1224,7 @@ SLANG_UNIT_TEST(vtableIEntryPoint)
 }
 
 // ---------------------------------------------------------------------------
-// IComponentType2 : ISlangUnknown  (own slots 3-5)
+// IComponentType2 : ISlangUnknown  (own slots 3-9)
 // ---------------------------------------------------------------------------
 struct IComponentType2Probe : IComponentType2
 {
@@ -1242,6 +1262,40 @@ struct IComponentType2Probe : IComponentType2
         lastSlot = 5;
         return SLANG_OK;
     }
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileEntryPointPermutations(
+        SlangInt,
+        SlangInt,
+        SpecializationArg const*,
+        SlangInt,
+        SlangInt,
+        IBlob**,
+        IBlob**) SLANG_OVERRIDE
+    {
+        lastSlot = 6;
+        return SLANG_OK;
+    }
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt,
+        SlangInt,
+        CodeGenFutureCallback,
+        void*,
+        ICodeGenFuture**) SLANG_OVERRIDE
+    {
+        lastSlot = 7;
+        return SLANG_OK;
+    }
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    getTargetCodeAsync(SlangInt, CodeGenFutureCallback, void*, ICodeGenFuture**) SLANG_OVERRIDE
+    {
+        lastSlot = 8;
+        return SLANG_OK;
+    }
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    getTargetIRHash(SlangInt, IBlob**, IBlob**) SLANG_OVERRIDE
+    {
+        lastSlot = 9;
+        return SLANG_OK;
+    }
 };
 
 SLANG_UNIT_TEST(vtableIComponentType2)
@@ -1253,10 +1307,18 @@ SLANG_UNIT_TEST(vtableIComponentType2)
     SLANG_CHECK(p.lastSlot == 4); // getEntryPointCompileResult
     callSlot(&p, 5);
     SLANG_CHECK(p.lastSlot == 5); // getTargetHostCallable
+    callSlot(&p, 6);
+    SLANG_CHECK(p.lastSlot == 6); // compileEntryPointPermutations
+    callSlot(&p, 7);
+    SLANG_CHECK(p.lastSlot == 7); // getEntryPointCodeAsync
+    callSlot(&p, 8);
+    SLANG_CHECK(p.lastSlot == 8); // getTargetCodeAsync
+    callSlot(&p, 9);
+    SLANG_CHECK(p.lastSlot == 9); // getTargetIRHash
 }
 
 // ---------------------------------------------------------------------------
-// ISession : ISlangUnknown  (own slots 3-23)
+// ISession : ISlangUnknown  (own slots 3-24)
 // ---------------------------------------------------------------------------
 struct ISessionProbe : ISession
 {
@@ -1405,6 +1467,11 @@ struct ISessionProbe : ISession
         lastSlot = 23;
         return SLANG_OK;
     }
+    SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsage(SlangMemoryUsage*) SLANG_OVERRIDE
+    {
+        lastSlot = 24;
+        return SLANG_OK;
+    }
 };
 
 SLANG_UNIT_TEST(vtableISession)
@@ -1420,6 +1487,8 @@ SLANG_UNIT_TEST(vtableISession)
     SLANG_CHECK(p.lastSlot == 17); // getLoadedModuleCount
     callSlot(&p, 23);
     SLANG_CHECK(p.lastSlot == 23); // getDeclSourceLocation
+    callSlot(&p, 24);
+    SLANG_CHECK(p.lastSlot == 24); // getMemoryUsage
 }
 
 // ---------------------------------------------------------------------------
@@ -1611,7 +1680,7 @@ SLANG_UNIT_TEST(vtableIModule)
 }
 
 // ---------------------------------------------------------------------------
-// IByteCodeRunner : ISlangUnknown  (own slots 3-13)
+// IByteCodeRunner : ISlangUnknown  (own slots 3-14)
 // ---------------------------------------------------------------------------
 struct IByteCodeRunnerProbe : IByteCodeRunner
 {
@@ -1683,6 +1752,12 @@ struct IByteCodeRunnerProbe : IByteCodeRunner
         lastSlot = 13;
         return SLANG_OK;
     }
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    executeBatch(uint32_t, const void*, size_t, size_t, void*, size_t) SLANG_OVERRIDE
+    {
+        lastSlot = 14;
+        return SLANG_OK;
+    }
 };
 
 SLANG_UNIT_TEST(vtableIByteCodeRunner)
@@ -1698,6 +1773,8 @@ SLANG_UNIT_TEST(vtableIByteCodeRunner)
     SLANG_CHECK(p.lastSlot == 10); // getReturnValue
     callSlot(&p, 13);
     SLANG_CHECK(p.lastSlot == 13); // setPrintCallback
+    callSlot(&p, 14);
+    SLANG_CHECK(p.lastSlot == 14); // executeBatch
 }
 
 #endif // SLANG_PTR_IS_64